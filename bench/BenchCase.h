@@ -0,0 +1,143 @@
+﻿#ifndef BENCHCASE_H
+#define BENCHCASE_H
+
+/// @file BenchCase.h
+/// @brief BenchCase のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmTools.h"
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class BenchCase BenchCase.h "BenchCase.h"
+/// @brief ベンチマークの一つの項目を表す基底クラス
+///
+/// run() が計測の対象となる．run() は同じ入力に対して毎回同じ値を
+/// 返さなければならない(BDD のノード数や SAT の結果など)．
+/// この値は JSON 出力に含められ，コミット間で比較する際に
+/// 同じ計算をしていることの確認に用いられる．
+//////////////////////////////////////////////////////////////////////
+class BenchCase
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] category 分類名
+  /// @param[in] name 名前
+  BenchCase(const string& category,
+	    const string& name);
+
+  /// @brief デストラクタ
+  virtual
+  ~BenchCase();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 分類名を返す．
+  const string&
+  category() const;
+
+  /// @brief 名前を返す．
+  const string&
+  name() const;
+
+  /// @brief 計測の前に一度だけ呼ばれる準備用の関数
+  /// @retval true 準備ができた．
+  /// @retval false 準備に失敗した(この項目はスキップされる)．
+  /// @note デフォルトの実装は何もしないで true を返す．
+  virtual
+  bool
+  setup();
+
+  /// @brief 計測の対象となる処理を行う．
+  /// @return 結果を表す値
+  virtual
+  ymuint64
+  run() = 0;
+
+  /// @brief 1回の run() で処理するバイト数を返す．
+  /// @note 0 の場合はスループットを出力しない．
+  /// デフォルトの実装は 0 を返す．
+  virtual
+  ymuint64
+  byte_size() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 分類名
+  string mCategory;
+
+  // 名前
+  string mName;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+inline
+BenchCase::BenchCase(const string& category,
+		     const string& name) :
+  mCategory(category),
+  mName(name)
+{
+}
+
+// @brief デストラクタ
+inline
+BenchCase::~BenchCase()
+{
+}
+
+// @brief 分類名を返す．
+inline
+const string&
+BenchCase::category() const
+{
+  return mCategory;
+}
+
+// @brief 名前を返す．
+inline
+const string&
+BenchCase::name() const
+{
+  return mName;
+}
+
+// @brief 計測の前に一度だけ呼ばれる準備用の関数
+inline
+bool
+BenchCase::setup()
+{
+  return true;
+}
+
+// @brief 1回の run() で処理するバイト数を返す．
+inline
+ymuint64
+BenchCase::byte_size() const
+{
+  return 0;
+}
+
+END_NAMESPACE_YM
+
+#endif // BENCHCASE_H
@@ -0,0 +1,360 @@
+﻿
+/// @file BenchMgr.cc
+/// @brief BenchMgr の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "BenchMgr.h"
+#include "BenchCase.h"
+#include "YmUtils/StopWatch.h"
+
+#if defined(YM_BENCH_USE_GPERFTOOLS)
+#include <gperftools/profiler.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 出力フォーマットの識別子
+// 出力内容を変えた時には番号を上げること．
+const char* kFormat = "ym_bench/1";
+
+// ソート済みの配列の中央値を求める．
+double
+median(const vector<double>& v)
+{
+  ymuint n = v.size();
+  if ( n == 0 ) {
+    return 0.0;
+  }
+  if ( n % 2 == 1 ) {
+    return v[n / 2];
+  }
+  return (v[n / 2 - 1] + v[n / 2]) / 2.0;
+}
+
+// 平均値を求める．
+double
+mean(const vector<double>& v)
+{
+  if ( v.empty() ) {
+    return 0.0;
+  }
+  double sum = 0.0;
+  for (vector<double>::const_iterator p = v.begin();
+       p != v.end(); ++ p) {
+    sum += *p;
+  }
+  return sum / v.size();
+}
+
+// 何も出力しない streambuf
+// 計測中のライブラリが cout に出すメッセージを捨てるのに用いる．
+class NullBuf :
+  public std::streambuf
+{
+protected:
+
+  virtual
+  int
+  overflow(int c)
+  {
+    return c;
+  }
+
+};
+
+#if defined(YM_BENCH_USE_GPERFTOOLS)
+// ファイル名に使えない文字を置き換える．
+string
+file_str(const string& str)
+{
+  string ans(str);
+  for (string::iterator p = ans.begin(); p != ans.end(); ++ p) {
+    char c = *p;
+    if ( c == '/' || c == ' ' || c == ':' ) {
+      *p = '_';
+    }
+  }
+  return ans;
+}
+#endif
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BenchMgr
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BenchMgr::BenchMgr() :
+  mRepeat(5),
+  mProgress(nullptr)
+{
+}
+
+// @brief デストラクタ
+BenchMgr::~BenchMgr()
+{
+  for (vector<BenchCase*>::iterator p = mCaseList.begin();
+       p != mCaseList.end(); ++ p) {
+    delete *p;
+  }
+}
+
+// @brief 項目を登録する．
+void
+BenchMgr::reg_case(BenchCase* bench_case)
+{
+  mCaseList.push_back(bench_case);
+}
+
+// @brief 繰り返し回数を設定する．
+void
+BenchMgr::set_repeat(ymuint repeat)
+{
+  mRepeat = repeat > 0 ? repeat : 1;
+}
+
+// @brief 実行する項目を選ぶパタンを追加する．
+void
+BenchMgr::add_filter(const string& pat)
+{
+  mFilterList.push_back(pat);
+}
+
+// @brief 出力に含めるラベル(コミット名など)を設定する．
+void
+BenchMgr::set_label(const string& label)
+{
+  mLabel = label;
+}
+
+// @brief gperftools のプロファイル出力先を設定する．
+void
+BenchMgr::set_profile(const string& prefix)
+{
+  mProfile = prefix;
+}
+
+// @brief 途中経過を出力するストリームを設定する．
+void
+BenchMgr::set_progress(ostream* s)
+{
+  mProgress = s;
+}
+
+// @brief 項目の一覧を出力する．
+void
+BenchMgr::list_cases(ostream& s) const
+{
+  for (vector<BenchCase*>::const_iterator p = mCaseList.begin();
+       p != mCaseList.end(); ++ p) {
+    const BenchCase* bench_case = *p;
+    if ( match(bench_case) ) {
+      s << bench_case->category() << "/" << bench_case->name() << endl;
+    }
+  }
+}
+
+// @brief 計測を行い，結果を JSON 形式で出力する．
+bool
+BenchMgr::run(ostream& s)
+{
+  s << "{" << endl
+    << "  \"format\": ";
+  put_str(s, kFormat);
+  s << "," << endl
+    << "  \"label\": ";
+  put_str(s, mLabel);
+  s << "," << endl
+    << "  \"repeat\": " << mRepeat << "," << endl
+    << "  \"results\": [";
+
+  bool ok = true;
+  bool first = true;
+  for (vector<BenchCase*>::iterator p = mCaseList.begin();
+       p != mCaseList.end(); ++ p) {
+    BenchCase* bench_case = *p;
+    if ( !match(bench_case) ) {
+      continue;
+    }
+    if ( !first ) {
+      s << ",";
+    }
+    first = false;
+    s << endl;
+    if ( !run_case(bench_case, s) ) {
+      ok = false;
+    }
+  }
+
+  s << endl
+    << "  ]" << endl
+    << "}" << endl;
+
+  return ok;
+}
+
+// @brief gperftools が利用可能な時 true を返す．
+bool
+BenchMgr::profiler_enabled()
+{
+#if defined(YM_BENCH_USE_GPERFTOOLS)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// @brief 項目がパタンに合致する時 true を返す．
+bool
+BenchMgr::match(const BenchCase* bench_case) const
+{
+  if ( mFilterList.empty() ) {
+    return true;
+  }
+  string full_name = bench_case->category() + "/" + bench_case->name();
+  for (vector<string>::const_iterator p = mFilterList.begin();
+       p != mFilterList.end(); ++ p) {
+    if ( full_name.find(*p) != string::npos ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief 項目の計測を行う．
+bool
+BenchMgr::run_case(BenchCase* bench_case,
+		   ostream& s)
+{
+  if ( mProgress ) {
+    *mProgress << bench_case->category() << "/" << bench_case->name()
+	       << " ... " << flush;
+  }
+
+  s << "    {" << endl
+    << "      \"category\": ";
+  put_str(s, bench_case->category());
+  s << "," << endl
+    << "      \"name\": ";
+  put_str(s, bench_case->name());
+  s << "," << endl;
+
+  if ( !bench_case->setup() ) {
+    if ( mProgress ) {
+      *mProgress << "skipped" << endl;
+    }
+    s << "      \"status\": \"skipped\"" << endl
+      << "    }";
+    return true;
+  }
+
+#if defined(YM_BENCH_USE_GPERFTOOLS)
+  if ( mProfile != string() ) {
+    string filename = mProfile + "." + file_str(bench_case->category())
+      + "." + file_str(bench_case->name()) + ".prof";
+    ProfilerStart(filename.c_str());
+  }
+#endif
+
+  vector<double> real_list;
+  vector<double> usr_list;
+  real_list.reserve(mRepeat);
+  usr_list.reserve(mRepeat);
+  ymuint64 value = 0;
+  bool stable = true;
+  NullBuf null_buf;
+  for (ymuint i = 0; i < mRepeat; ++ i) {
+    std::streambuf* cout_buf = cout.rdbuf(&null_buf);
+    StopWatch timer;
+    timer.start();
+    ymuint64 v = bench_case->run();
+    timer.stop();
+    cout.rdbuf(cout_buf);
+    USTime t = timer.time();
+    real_list.push_back(t.real_time());
+    usr_list.push_back(t.usr_time());
+    if ( i == 0 ) {
+      value = v;
+    }
+    else if ( v != value ) {
+      stable = false;
+    }
+  }
+
+#if defined(YM_BENCH_USE_GPERFTOOLS)
+  if ( mProfile != string() ) {
+    ProfilerStop();
+  }
+#endif
+
+  std::sort(real_list.begin(), real_list.end());
+  std::sort(usr_list.begin(), usr_list.end());
+
+  double real_med = median(real_list);
+  if ( mProgress ) {
+    *mProgress << real_med << "s";
+    if ( !stable ) {
+      *mProgress << " (unstable)";
+    }
+    *mProgress << endl;
+  }
+
+  ios::fmtflags save_flags = s.flags();
+  std::streamsize save_prec = s.precision();
+  s << setprecision(6) << fixed;
+  s << "      \"status\": ";
+  put_str(s, stable ? "ok" : "unstable");
+  s << "," << endl
+    << "      \"value\": " << value << "," << endl
+    << "      \"real_min\": " << real_list.front() << "," << endl
+    << "      \"real_median\": " << real_med << "," << endl
+    << "      \"real_mean\": " << mean(real_list) << "," << endl
+    << "      \"usr_min\": " << usr_list.front() << "," << endl
+    << "      \"usr_median\": " << median(usr_list);
+  ymuint64 bytes = bench_case->byte_size();
+  if ( bytes > 0 ) {
+    double mbps = 0.0;
+    if ( real_med > 0.0 ) {
+      mbps = (double(bytes) / (1024.0 * 1024.0)) / real_med;
+    }
+    s << "," << endl
+      << "      \"bytes\": " << bytes << "," << endl
+      << "      \"mb_per_sec\": " << mbps;
+  }
+  s << endl
+    << "    }";
+  s.flags(save_flags);
+  s.precision(save_prec);
+
+  return stable;
+}
+
+// @brief JSON 用に文字列を出力する．
+void
+BenchMgr::put_str(ostream& s,
+		  const string& str)
+{
+  s << '"';
+  for (string::const_iterator p = str.begin(); p != str.end(); ++ p) {
+    char c = *p;
+    switch ( c ) {
+    case '"':  s << "\\\""; break;
+    case '\\': s << "\\\\"; break;
+    case '\n': s << "\\n"; break;
+    case '\t': s << "\\t"; break;
+    default:   s << c; break;
+    }
+  }
+  s << '"';
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,150 @@
+﻿#ifndef BENCHMGR_H
+#define BENCHMGR_H
+
+/// @file BenchMgr.h
+/// @brief BenchMgr のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmTools.h"
+
+
+BEGIN_NAMESPACE_YM
+
+class BenchCase;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BenchMgr BenchMgr.h "BenchMgr.h"
+/// @brief ベンチマークの項目を管理して計測を行うクラス
+///
+/// 各項目は setup() の後で run() を mRepeat 回呼び出し，
+/// それぞれの実行時間の最小値，中央値，平均値を JSON 形式で出力する．
+/// 最小値と中央値はコミット間の比較に用いることを想定している．
+//////////////////////////////////////////////////////////////////////
+class BenchMgr
+{
+public:
+
+  /// @brief コンストラクタ
+  BenchMgr();
+
+  /// @brief デストラクタ
+  /// @note 登録された項目も削除する．
+  ~BenchMgr();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 設定用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 項目を登録する．
+  /// @param[in] bench_case 登録する項目
+  /// @note bench_case の所有権は BenchMgr に移る．
+  void
+  reg_case(BenchCase* bench_case);
+
+  /// @brief 繰り返し回数を設定する．
+  void
+  set_repeat(ymuint repeat);
+
+  /// @brief 実行する項目を選ぶパタンを追加する．
+  /// @param[in] pat パタン
+  /// @note "分類名/名前" が pat を部分文字列として含む項目のみ実行する．
+  /// パタンが一つもない時はすべての項目を実行する．
+  void
+  add_filter(const string& pat);
+
+  /// @brief 出力に含めるラベル(コミット名など)を設定する．
+  void
+  set_label(const string& label);
+
+  /// @brief gperftools のプロファイル出力先を設定する．
+  /// @param[in] prefix ファイル名の先頭部分
+  /// @note 項目ごとに prefix.<分類名>.<名前>.prof に出力する．
+  /// gperftools が有効でない時は何もしない．
+  void
+  set_profile(const string& prefix);
+
+  /// @brief 途中経過を出力するストリームを設定する．
+  /// @note nullptr の時は出力しない．
+  void
+  set_progress(ostream* s);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 実行用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 項目の一覧を出力する．
+  void
+  list_cases(ostream& s) const;
+
+  /// @brief 計測を行い，結果を JSON 形式で出力する．
+  /// @param[in] s 出力先のストリーム
+  /// @return 全ての項目が正常に終わったら true を返す．
+  bool
+  run(ostream& s);
+
+  /// @brief gperftools が利用可能な時 true を返す．
+  static
+  bool
+  profiler_enabled();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 項目がパタンに合致する時 true を返す．
+  bool
+  match(const BenchCase* bench_case) const;
+
+  /// @brief 項目の計測を行う．
+  /// @param[in] bench_case 対象の項目
+  /// @param[in] s JSON の出力先
+  /// @return 正常に終わったら true を返す．
+  bool
+  run_case(BenchCase* bench_case,
+	   ostream& s);
+
+  /// @brief JSON 用に文字列を出力する．
+  static
+  void
+  put_str(ostream& s,
+	  const string& str);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 項目のリスト
+  vector<BenchCase*> mCaseList;
+
+  // 繰り返し回数
+  ymuint32 mRepeat;
+
+  // 項目を選ぶパタンのリスト
+  vector<string> mFilterList;
+
+  // ラベル
+  string mLabel;
+
+  // プロファイル出力先の先頭部分
+  string mProfile;
+
+  // 途中経過の出力先
+  ostream* mProgress;
+
+};
+
+END_NAMESPACE_YM
+
+#endif // BENCHMGR_H
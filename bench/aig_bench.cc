@@ -0,0 +1,263 @@
+﻿
+/// @file aig_bench.cc
+/// @brief AIG の CNF 変換のベンチマーク
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bench.h"
+#include "BenchMgr.h"
+#include "BenchCase.h"
+#include "YmLogic/AigMgr.h"
+#include "YmLogic/AigSatMgr.h"
+#include "YmLogic/SatSolver.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 桁上げ伝搬加算器を作る．
+void
+make_ripple_adder(AigMgr& mgr,
+		  const vector<Aig>& a,
+		  const vector<Aig>& b,
+		  vector<Aig>& s)
+{
+  ymuint n = a.size();
+  s.resize(n);
+  Aig c = mgr.make_zero();
+  for (ymuint i = 0; i < n; ++ i) {
+    Aig p = mgr.make_xor(a[i], b[i]);
+    s[i] = mgr.make_xor(p, c);
+    c = mgr.make_or(mgr.make_and(a[i], b[i]), mgr.make_and(p, c));
+  }
+}
+
+// Kogge-Stone 型の桁上げ先見加算器を作る．
+void
+make_prefix_adder(AigMgr& mgr,
+		  const vector<Aig>& a,
+		  const vector<Aig>& b,
+		  vector<Aig>& s)
+{
+  ymuint n = a.size();
+  vector<Aig> p0(n);
+  vector<Aig> g(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    p0[i] = mgr.make_xor(a[i], b[i]);
+    g[i] = mgr.make_and(a[i], b[i]);
+  }
+  vector<Aig> p(p0);
+  for (ymuint d = 1; d < n; d <<= 1) {
+    vector<Aig> g1(g);
+    vector<Aig> p1(p);
+    for (ymuint i = d; i < n; ++ i) {
+      g1[i] = mgr.make_or(g[i], mgr.make_and(p[i], g[i - d]));
+      p1[i] = mgr.make_and(p[i], p[i - d]);
+    }
+    g.swap(g1);
+    p.swap(p1);
+  }
+  s.resize(n);
+  s[0] = p0[0];
+  for (ymuint i = 1; i < n; ++ i) {
+    s[i] = mgr.make_xor(p0[i], g[i - 1]);
+  }
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// AIG のミタ回路を AigSatMgr で解く項目
+// 結果は SAT の時 1，UNSAT の時 0，それ以外は 2 を上位 32 ビットに，
+// 制約節の数を下位 32 ビットに入れたものとなる．
+//////////////////////////////////////////////////////////////////////
+class AigMiterBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  AigMiterBench(const string& inst_name,
+		ymuint cut_size);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+protected:
+
+  // AigMgr
+  AigMgr mAigMgr;
+
+  // ミタ回路の出力
+  Aig mMiter;
+
+
+private:
+
+  // カットの大きさ
+  ymuint32 mCutSize;
+
+};
+
+AigMiterBench::AigMiterBench(const string& inst_name,
+			     ymuint cut_size) :
+  BenchCase("aig", inst_name + "_" +
+	    (cut_size == 0 ? string("tseitin") : "cut" + std::to_string(cut_size))),
+  mCutSize(cut_size)
+{
+}
+
+ymuint64
+AigMiterBench::run()
+{
+  SatSolver solver;
+  AigSatMgr satmgr(mAigMgr, solver);
+  satmgr.set_cut_size(mCutSize);
+  vector<Bool3> model;
+  Bool3 ans = satmgr.sat(mMiter, model);
+  ymuint64 val = 2;
+  if ( ans == kB3True ) {
+    val = 1;
+  }
+  else if ( ans == kB3False ) {
+    val = 0;
+  }
+  return (val << 32) | solver.clause_num();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// 2種類の加算器の等価性を調べる項目
+//////////////////////////////////////////////////////////////////////
+class AdderMiterBench :
+  public AigMiterBench
+{
+public:
+
+  // コンストラクタ
+  AdderMiterBench(ymuint bit_width,
+		  ymuint cut_size);
+
+  // 計測の前の準備を行う．
+  virtual
+  bool
+  setup();
+
+
+private:
+
+  // ビット幅
+  ymuint32 mBitWidth;
+
+};
+
+AdderMiterBench::AdderMiterBench(ymuint bit_width,
+				 ymuint cut_size) :
+  AigMiterBench("adder" + std::to_string(bit_width), cut_size),
+  mBitWidth(bit_width)
+{
+}
+
+bool
+AdderMiterBench::setup()
+{
+  ymuint n = mBitWidth;
+  vector<Aig> a(n);
+  vector<Aig> b(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    a[i] = mAigMgr.make_input(VarId(i));
+    b[i] = mAigMgr.make_input(VarId(i + n));
+  }
+  vector<Aig> s1;
+  make_ripple_adder(mAigMgr, a, b, s1);
+  vector<Aig> s2;
+  make_prefix_adder(mAigMgr, a, b, s2);
+  vector<Aig> diff_list(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    diff_list[i] = mAigMgr.make_xor(s1[i], s2[i]);
+  }
+  mMiter = mAigMgr.make_or(diff_list);
+  return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// 線形と木状のパリティ回路の等価性を調べる項目
+//////////////////////////////////////////////////////////////////////
+class ParityMiterBench :
+  public AigMiterBench
+{
+public:
+
+  // コンストラクタ
+  ParityMiterBench(ymuint input_num,
+		   ymuint cut_size);
+
+  // 計測の前の準備を行う．
+  virtual
+  bool
+  setup();
+
+
+private:
+
+  // 入力数
+  ymuint32 mInputNum;
+
+};
+
+ParityMiterBench::ParityMiterBench(ymuint input_num,
+				   ymuint cut_size) :
+  AigMiterBench("parity" + std::to_string(input_num), cut_size),
+  mInputNum(input_num)
+{
+}
+
+bool
+ParityMiterBench::setup()
+{
+  ymuint n = mInputNum;
+  vector<Aig> input_list(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    input_list[i] = mAigMgr.make_input(VarId(i));
+  }
+  Aig f1 = input_list[0];
+  for (ymuint i = 1; i < n; ++ i) {
+    f1 = mAigMgr.make_xor(f1, input_list[i]);
+  }
+  vector<Aig> tmp_list(input_list);
+  while ( tmp_list.size() > 1 ) {
+    vector<Aig> next_list;
+    for (ymuint i = 0; i + 1 < tmp_list.size(); i += 2) {
+      next_list.push_back(mAigMgr.make_xor(tmp_list[i], tmp_list[i + 1]));
+    }
+    if ( tmp_list.size() % 2 ) {
+      next_list.push_back(tmp_list.back());
+    }
+    tmp_list.swap(next_list);
+  }
+  mMiter = mAigMgr.make_xor(f1, tmp_list[0]);
+  return true;
+}
+
+END_NONAMESPACE
+
+
+// @brief AIG の項目を登録する．
+void
+reg_aig_bench(BenchMgr& mgr)
+{
+  ymuint cut_size_list[] = { 0, 4, 6 };
+  for (ymuint i = 0; i < 3; ++ i) {
+    mgr.reg_case(new AdderMiterBench(64, cut_size_list[i]));
+    mgr.reg_case(new ParityMiterBench(24, cut_size_list[i]));
+  }
+}
+
+END_NAMESPACE_YM
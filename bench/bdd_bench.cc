@@ -0,0 +1,245 @@
+﻿
+/// @file bdd_bench.cc
+/// @brief BDD のベンチマーク
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bench.h"
+#include "BenchMgr.h"
+#include "BenchCase.h"
+#include "YmLogic/Bdd.h"
+#include "YmLogic/BddMgr.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// BDD の配列の総ノード数を求める．
+ymuint64
+total_size(const vector<Bdd>& bdd_list)
+{
+  ymuint64 n = 0;
+  for (vector<Bdd>::const_iterator p = bdd_list.begin();
+       p != bdd_list.end(); ++ p) {
+    n += p->node_count();
+  }
+  return n;
+}
+
+// 2つのビットベクタの和を作る．
+// ans のサイズは a のサイズ + 1 となる．
+void
+make_sum(BddMgr& mgr,
+	 const vector<Bdd>& a,
+	 const vector<Bdd>& b,
+	 vector<Bdd>& ans)
+{
+  ymuint n = a.size();
+  ans.clear();
+  ans.reserve(n + 1);
+  Bdd c = mgr.make_zero();
+  for (ymuint i = 0; i < n; ++ i) {
+    Bdd x = a[i];
+    Bdd y = b[i];
+    ans.push_back(x ^ y ^ c);
+    c = (x & y) | (c & (x | y));
+  }
+  ans.push_back(c);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// 加算器の出力関数を作る．
+// 変数順は a0 b0 a1 b1 ... の順(線形サイズになる)
+//////////////////////////////////////////////////////////////////////
+class BddAdderBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  BddAdderBench(const string& mgr_type,
+		ymuint bit_num);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+private:
+
+  // BddMgr の種類
+  string mMgrType;
+
+  // ビット数
+  ymuint32 mBitNum;
+
+};
+
+BddAdderBench::BddAdderBench(const string& mgr_type,
+			     ymuint bit_num) :
+  BenchCase("bdd", mgr_type + "/adder" + std::to_string(bit_num)),
+  mMgrType(mgr_type),
+  mBitNum(bit_num)
+{
+}
+
+ymuint64
+BddAdderBench::run()
+{
+  BddMgr mgr(mMgrType, "adder");
+  vector<Bdd> a(mBitNum);
+  vector<Bdd> b(mBitNum);
+  for (ymuint i = 0; i < mBitNum; ++ i) {
+    a[i] = mgr.make_posiliteral(VarId(i * 2 + 0));
+    b[i] = mgr.make_posiliteral(VarId(i * 2 + 1));
+  }
+  vector<Bdd> s;
+  make_sum(mgr, a, b, s);
+  return total_size(s);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// 乗算器の出力関数を作る．
+// 変数順は a0 b0 a1 b1 ... の順(中央のビットは指数サイズになる)
+//////////////////////////////////////////////////////////////////////
+class BddMultBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  BddMultBench(const string& mgr_type,
+	       ymuint bit_num);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+private:
+
+  // BddMgr の種類
+  string mMgrType;
+
+  // ビット数
+  ymuint32 mBitNum;
+
+};
+
+BddMultBench::BddMultBench(const string& mgr_type,
+			   ymuint bit_num) :
+  BenchCase("bdd", mgr_type + "/mult" + std::to_string(bit_num)),
+  mMgrType(mgr_type),
+  mBitNum(bit_num)
+{
+}
+
+ymuint64
+BddMultBench::run()
+{
+  BddMgr mgr(mMgrType, "mult");
+  ymuint n = mBitNum;
+  vector<Bdd> a(n);
+  vector<Bdd> b(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    a[i] = mgr.make_posiliteral(VarId(i * 2 + 0));
+    b[i] = mgr.make_posiliteral(VarId(i * 2 + 1));
+  }
+
+  // シフトと加算で部分積を足していく．
+  vector<Bdd> acc(n * 2, mgr.make_zero());
+  for (ymuint i = 0; i < n; ++ i) {
+    vector<Bdd> pp(n * 2 - 1, mgr.make_zero());
+    vector<Bdd> cur(n * 2 - 1);
+    for (ymuint j = 0; j < n; ++ j) {
+      pp[i + j] = a[j] & b[i];
+    }
+    for (ymuint j = 0; j < n * 2 - 1; ++ j) {
+      cur[j] = acc[j];
+    }
+    vector<Bdd> tmp;
+    make_sum(mgr, cur, pp, tmp);
+    acc.swap(tmp);
+  }
+  acc.resize(n * 2);
+  return total_size(acc);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// 比較器 (a < b) を悪い変数順で作る．
+// 変数順は a0 a1 ... b0 b1 ... の順(指数サイズになる)
+//////////////////////////////////////////////////////////////////////
+class BddCompBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  BddCompBench(const string& mgr_type,
+	       ymuint bit_num);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+private:
+
+  // BddMgr の種類
+  string mMgrType;
+
+  // ビット数
+  ymuint32 mBitNum;
+
+};
+
+BddCompBench::BddCompBench(const string& mgr_type,
+			   ymuint bit_num) :
+  BenchCase("bdd", mgr_type + "/comp" + std::to_string(bit_num)),
+  mMgrType(mgr_type),
+  mBitNum(bit_num)
+{
+}
+
+ymuint64
+BddCompBench::run()
+{
+  BddMgr mgr(mMgrType, "comp");
+  ymuint n = mBitNum;
+  Bdd lt = mgr.make_zero();
+  for (ymuint i = 0; i < n; ++ i) {
+    Bdd x = mgr.make_posiliteral(VarId(i));
+    Bdd y = mgr.make_posiliteral(VarId(i + n));
+    // 下位から見ていき，上位のビットで決まればそちらを優先する．
+    lt = (~x & y) | (~(x ^ y) & lt);
+  }
+  return lt.node_count();
+}
+
+END_NONAMESPACE
+
+
+// @brief BDD の項目を登録する．
+void
+reg_bdd_bench(BenchMgr& mgr)
+{
+  const char* type_list[] = { "bmc", "bmm" };
+  for (ymuint i = 0; i < 2; ++ i) {
+    string type = type_list[i];
+    mgr.reg_case(new BddAdderBench(type, 64));
+    mgr.reg_case(new BddMultBench(type, 8));
+    mgr.reg_case(new BddCompBench(type, 16));
+  }
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,137 @@
+﻿
+/// @file mincov_bench.cc
+/// @brief 最小被覆問題のベンチマーク
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bench.h"
+#include "BenchMgr.h"
+#include "BenchCase.h"
+#include "YmAlgo/MinCov.h"
+#include "YmUtils/RandGen.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// ランダムな行列の最小被覆問題を厳密に解く項目
+// 各行は density の割合で要素を持つ(最低1つは持つ)．
+// 結果は解のコストとなる．
+//////////////////////////////////////////////////////////////////////
+class MinCovBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  MinCovBench(ymuint row_size,
+	      ymuint col_size,
+	      double density,
+	      ymuint32 seed);
+
+  // 計測の前の準備を行う．
+  virtual
+  bool
+  setup();
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+private:
+
+  // 行数
+  ymuint32 mRowSize;
+
+  // 列数
+  ymuint32 mColSize;
+
+  // 要素の密度
+  double mDensity;
+
+  // 乱数の種
+  ymuint32 mSeed;
+
+  // 要素のリスト
+  vector<pair<ymuint32, ymuint32> > mElemList;
+
+  // 列のコストのリスト
+  vector<ymuint32> mCostList;
+
+};
+
+MinCovBench::MinCovBench(ymuint row_size,
+			 ymuint col_size,
+			 double density,
+			 ymuint32 seed) :
+  BenchCase("mincov", "exact_" + std::to_string(row_size)
+	    + "x" + std::to_string(col_size) + "_" + std::to_string(seed)),
+  mRowSize(row_size),
+  mColSize(col_size),
+  mDensity(density),
+  mSeed(seed)
+{
+}
+
+bool
+MinCovBench::setup()
+{
+  RandGen rg;
+  rg.init(mSeed);
+  mElemList.clear();
+  for (ymuint r = 0; r < mRowSize; ++ r) {
+    bool found = false;
+    for (ymuint c = 0; c < mColSize; ++ c) {
+      if ( rg.real1() < mDensity ) {
+	mElemList.push_back(make_pair(r, c));
+	found = true;
+      }
+    }
+    if ( !found ) {
+      mElemList.push_back(make_pair(r, rg.int32() % mColSize));
+    }
+  }
+  mCostList.clear();
+  mCostList.reserve(mColSize);
+  for (ymuint c = 0; c < mColSize; ++ c) {
+    mCostList.push_back(rg.int32() % 4 + 1);
+  }
+  return true;
+}
+
+ymuint64
+MinCovBench::run()
+{
+  MinCov mincov;
+  mincov.set_size(mRowSize, mColSize);
+  for (ymuint c = 0; c < mColSize; ++ c) {
+    mincov.set_col_cost(c, mCostList[c]);
+  }
+  for (vector<pair<ymuint32, ymuint32> >::const_iterator p = mElemList.begin();
+       p != mElemList.end(); ++ p) {
+    mincov.insert_elem(p->first, p->second);
+  }
+  vector<ymuint32> solution;
+  return mincov.exact(solution);
+}
+
+END_NONAMESPACE
+
+
+// @brief 最小被覆問題の項目を登録する．
+void
+reg_mincov_bench(BenchMgr& mgr)
+{
+  for (ymuint32 seed = 1; seed <= 3; ++ seed) {
+    mgr.reg_case(new MinCovBench(200, 120, 0.03, seed));
+  }
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,321 @@
+﻿
+/// @file parser_bench.cc
+/// @brief 各種パーサーのベンチマーク
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bench.h"
+#include "BenchMgr.h"
+#include "BenchCase.h"
+#include "YmNetworks/BNetwork.h"
+#include "YmNetworks/BNetBlifReader.h"
+#include "YmNetworks/BNetIscas89Reader.h"
+#include "YmVerilog/VlMgr.h"
+#include "YmCell/CellLibrary.h"
+#include "YmCell/CellDotlibReader.h"
+#include "YmCell/CellMislibReader.h"
+
+
+BEGIN_NAMESPACE_YM
+
+// @brief ファイルのパス名の最後の要素を取り出す．
+string
+base_name(const string& filename)
+{
+  string::size_type pos = filename.rfind('/');
+  if ( pos == string::npos ) {
+    return filename;
+  }
+  return filename.substr(pos + 1);
+}
+
+
+BEGIN_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// ファイルを読み込む項目の基底クラス
+// 実行時間とファイルサイズからスループットを計算する．
+//////////////////////////////////////////////////////////////////////
+class ParserBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  ParserBench(const string& format,
+	      const string& filename);
+
+  // 計測の前の準備を行う．
+  // ファイルが存在しない時は false を返す．
+  virtual
+  bool
+  setup();
+
+  // 1回の run() で処理するバイト数を返す．
+  virtual
+  ymuint64
+  byte_size() const;
+
+
+protected:
+
+  // ファイル名を返す．
+  const string&
+  filename() const;
+
+
+private:
+
+  // ファイル名
+  string mFileName;
+
+  // ファイルサイズ
+  ymuint64 mSize;
+
+};
+
+ParserBench::ParserBench(const string& format,
+			 const string& filename) :
+  BenchCase("parse", format + "/" + base_name(filename)),
+  mFileName(filename),
+  mSize(0)
+{
+}
+
+bool
+ParserBench::setup()
+{
+  ifstream s(mFileName.c_str(), ios::binary);
+  if ( !s ) {
+    return false;
+  }
+  s.seekg(0, ios::end);
+  mSize = s.tellg();
+  return true;
+}
+
+ymuint64
+ParserBench::byte_size() const
+{
+  return mSize;
+}
+
+const string&
+ParserBench::filename() const
+{
+  return mFileName;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// blif ファイルの読み込みの項目
+// 結果は論理ノード数となる．
+//////////////////////////////////////////////////////////////////////
+class BlifBench :
+  public ParserBench
+{
+public:
+
+  // コンストラクタ
+  BlifBench(const string& filename);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+};
+
+BlifBench::BlifBench(const string& filename) :
+  ParserBench("blif", filename)
+{
+}
+
+ymuint64
+BlifBench::run()
+{
+  BNetwork network;
+  BNetBlifReader reader;
+  if ( !reader(filename(), network) ) {
+    return 0;
+  }
+  return network.logic_node_num();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// iscas89 ファイルの読み込みの項目
+// 結果は論理ノード数となる．
+//////////////////////////////////////////////////////////////////////
+class Iscas89Bench :
+  public ParserBench
+{
+public:
+
+  // コンストラクタ
+  Iscas89Bench(const string& filename);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+};
+
+Iscas89Bench::Iscas89Bench(const string& filename) :
+  ParserBench("iscas89", filename)
+{
+}
+
+ymuint64
+Iscas89Bench::run()
+{
+  BNetwork network;
+  BNetIscas89Reader reader;
+  if ( !reader(filename(), network) ) {
+    return 0;
+  }
+  return network.logic_node_num();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// verilog ファイルの読み込みとエラボレーションの項目
+// 結果はパース木のモジュール数となる．
+//////////////////////////////////////////////////////////////////////
+class VerilogBench :
+  public ParserBench
+{
+public:
+
+  // コンストラクタ
+  VerilogBench(const string& filename);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+};
+
+VerilogBench::VerilogBench(const string& filename) :
+  ParserBench("verilog", filename)
+{
+}
+
+ymuint64
+VerilogBench::run()
+{
+  VlMgr vlmgr;
+  if ( !vlmgr.read_file(filename()) ) {
+    return 0;
+  }
+  if ( vlmgr.elaborate() > 0 ) {
+    return 0;
+  }
+  return vlmgr.pt_module_list().size();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// セルライブラリの読み込みの項目
+// 結果はセル数となる．
+//////////////////////////////////////////////////////////////////////
+class CellLibBench :
+  public ParserBench
+{
+public:
+
+  // コンストラクタ
+  // dotlib が true の時は liberty 形式，false の時は mislib 形式
+  CellLibBench(const string& filename,
+	       bool dotlib);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+private:
+
+  // liberty 形式の時 true
+  bool mDotlib;
+
+};
+
+CellLibBench::CellLibBench(const string& filename,
+			   bool dotlib) :
+  ParserBench(dotlib ? "liberty" : "mislib", filename),
+  mDotlib(dotlib)
+{
+}
+
+ymuint64
+CellLibBench::run()
+{
+  const CellLibrary* library = nullptr;
+  if ( mDotlib ) {
+    CellDotlibReader read;
+    library = read(filename());
+  }
+  else {
+    CellMislibReader read;
+    library = read(filename());
+  }
+  if ( library == nullptr ) {
+    return 0;
+  }
+  ymuint64 n = library->cell_num();
+  delete library;
+  return n;
+}
+
+END_NONAMESPACE
+
+
+// @brief パーサーの項目を登録する．
+void
+reg_parser_bench(BenchMgr& mgr,
+		 const BenchInput& input)
+{
+  // 同梱のテストデータ
+  const char* blif_list[] = { "C6288", "C7552", "des", nullptr };
+  const char* iscas89_list[] = { "s5378", "s15850", nullptr };
+
+  string blif_dir = input.mDataDir + "/libym_networks/tests/bnet/in/";
+  for (ymuint i = 0; blif_list[i] != nullptr; ++ i) {
+    mgr.reg_case(new BlifBench(blif_dir + blif_list[i] + ".blif"));
+  }
+  for (vector<string>::const_iterator p = input.mBlifList.begin();
+       p != input.mBlifList.end(); ++ p) {
+    mgr.reg_case(new BlifBench(*p));
+  }
+
+  string iscas89_dir = input.mDataDir + "/libym_networks/tests/iscas89/in/";
+  for (ymuint i = 0; iscas89_list[i] != nullptr; ++ i) {
+    mgr.reg_case(new Iscas89Bench(iscas89_dir + iscas89_list[i] + ".bench"));
+  }
+  for (vector<string>::const_iterator p = input.mIscas89List.begin();
+       p != input.mIscas89List.end(); ++ p) {
+    mgr.reg_case(new Iscas89Bench(*p));
+  }
+
+  mgr.reg_case(new VerilogBench(input.mDataDir + "/libym_networks/tests/mvn/optest.v"));
+  for (vector<string>::const_iterator p = input.mVerilogList.begin();
+       p != input.mVerilogList.end(); ++ p) {
+    mgr.reg_case(new VerilogBench(*p));
+  }
+
+  mgr.reg_case(new CellLibBench(input.mDataDir + "/libym_cell/tests/misc/mux4.genlib", false));
+  for (vector<string>::const_iterator p = input.mLibertyList.begin();
+       p != input.mLibertyList.end(); ++ p) {
+    mgr.reg_case(new CellLibBench(*p, true));
+  }
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,617 @@
+﻿
+/// @file sat_bench.cc
+/// @brief SAT ソルバのベンチマーク
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bench.h"
+#include "BenchMgr.h"
+#include "BenchCase.h"
+#include "YmLogic/SatSolver.h"
+#include "YmLogic/DimacsLoader.h"
+#include "YmLogic/DimacsParser.h"
+#include "YmLogic/DimacsHandler.h"
+#include "YmLogic/SatDimacsHandler.h"
+#include "YmUtils/FileIDO.h"
+#include "YmUtils/RandGen.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// CNF を表す構造体
+// リテラルは DIMACS 形式の整数で表す．
+//////////////////////////////////////////////////////////////////////
+struct Cnf
+{
+  // 変数の数
+  ymuint32 mVarNum;
+
+  // 節のリスト
+  vector<vector<int> > mClauseList;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// DIMACS ファイルを Cnf に読み込むハンドラ
+//////////////////////////////////////////////////////////////////////
+class CnfHandler :
+  public DimacsHandler
+{
+public:
+
+  // コンストラクタ
+  CnfHandler(Cnf& cnf);
+
+  // p 行の読込み
+  virtual
+  bool
+  read_p(const FileRegion& loc,
+	 ymuint nv,
+	 ymuint nc);
+
+  // clause 行の読込み
+  virtual
+  bool
+  read_clause(const FileRegion& loc,
+	      const vector<int>& lits);
+
+
+private:
+
+  // 対象の CNF
+  Cnf& mCnf;
+
+};
+
+CnfHandler::CnfHandler(Cnf& cnf) :
+  mCnf(cnf)
+{
+  mCnf.mVarNum = 0;
+  mCnf.mClauseList.clear();
+}
+
+bool
+CnfHandler::read_p(const FileRegion& loc,
+		   ymuint nv,
+		   ymuint nc)
+{
+  mCnf.mVarNum = nv;
+  mCnf.mClauseList.reserve(nc);
+  return true;
+}
+
+bool
+CnfHandler::read_clause(const FileRegion& loc,
+			const vector<int>& lits)
+{
+  mCnf.mClauseList.push_back(lits);
+  for (vector<int>::const_iterator p = lits.begin();
+       p != lits.end(); ++ p) {
+    ymuint v = *p > 0 ? *p : - *p;
+    if ( mCnf.mVarNum < v ) {
+      mCnf.mVarNum = v;
+    }
+  }
+  return true;
+}
+
+// DIMACS ファイルを読み込む．
+bool
+read_cnf(const string& filename,
+	 Cnf& cnf)
+{
+  FileIDO ido;
+  if ( !ido.open(filename) ) {
+    return false;
+  }
+  DimacsParser parser;
+  CnfHandler handler(cnf);
+  parser.add_handler(&handler);
+  return parser.read(ido);
+}
+
+// 鳩の巣原理の CNF を作る．
+// hole_num + 1 羽の鳩を hole_num 個の巣に入れる(充足不能)．
+void
+make_php(ymuint hole_num,
+	 Cnf& cnf)
+{
+  ymuint pigeon_num = hole_num + 1;
+  cnf.mVarNum = pigeon_num * hole_num;
+  cnf.mClauseList.clear();
+  for (ymuint i = 0; i < pigeon_num; ++ i) {
+    vector<int> tmp_lits;
+    for (ymuint j = 0; j < hole_num; ++ j) {
+      tmp_lits.push_back(i * hole_num + j + 1);
+    }
+    cnf.mClauseList.push_back(tmp_lits);
+  }
+  for (ymuint j = 0; j < hole_num; ++ j) {
+    for (ymuint i1 = 0; i1 < pigeon_num; ++ i1) {
+      for (ymuint i2 = i1 + 1; i2 < pigeon_num; ++ i2) {
+	vector<int> tmp_lits(2);
+	tmp_lits[0] = - static_cast<int>(i1 * hole_num + j + 1);
+	tmp_lits[1] = - static_cast<int>(i2 * hole_num + j + 1);
+	cnf.mClauseList.push_back(tmp_lits);
+      }
+    }
+  }
+}
+
+// ランダム 3-SAT の CNF を作る．
+// 節数は変数の数の 4.26 倍(相転移点付近)とする．
+void
+make_rand3(ymuint var_num,
+	   ymuint32 seed,
+	   Cnf& cnf)
+{
+  RandGen rg;
+  rg.init(seed);
+  ymuint clause_num = static_cast<ymuint>(var_num * 4.26);
+  cnf.mVarNum = var_num;
+  cnf.mClauseList.clear();
+  cnf.mClauseList.reserve(clause_num);
+  for (ymuint c = 0; c < clause_num; ++ c) {
+    vector<int> tmp_lits;
+    while ( tmp_lits.size() < 3 ) {
+      int v = rg.int32() % var_num + 1;
+      bool dup = false;
+      for (ymuint k = 0; k < tmp_lits.size(); ++ k) {
+	if ( tmp_lits[k] == v || tmp_lits[k] == -v ) {
+	  dup = true;
+	  break;
+	}
+      }
+      if ( dup ) {
+	continue;
+      }
+      if ( rg.int32() & 1 ) {
+	v = -v;
+      }
+      tmp_lits.push_back(v);
+    }
+    cnf.mClauseList.push_back(tmp_lits);
+  }
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// CNF を解く項目
+// 結果は SAT の時 1，UNSAT の時 0，それ以外は 2 となる．
+//////////////////////////////////////////////////////////////////////
+class SatBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  SatBench(const string& sat_type,
+	   const string& sat_name,
+	   const string& inst_name);
+
+  // 計測の前の準備を行う．
+  virtual
+  bool
+  setup();
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+protected:
+
+  // CNF を作る．
+  virtual
+  bool
+  make_cnf(Cnf& cnf) = 0;
+
+
+private:
+
+  // SAT ソルバの種類
+  string mSatType;
+
+  // 対象の CNF
+  Cnf mCnf;
+
+};
+
+SatBench::SatBench(const string& sat_type,
+		   const string& sat_name,
+		   const string& inst_name) :
+  BenchCase("sat", sat_name + "/" + inst_name),
+  mSatType(sat_type)
+{
+}
+
+bool
+SatBench::setup()
+{
+  return make_cnf(mCnf);
+}
+
+ymuint64
+SatBench::run()
+{
+  SatSolver solver(mSatType);
+  vector<VarId> var_list(mCnf.mVarNum);
+  for (ymuint i = 0; i < mCnf.mVarNum; ++ i) {
+    var_list[i] = solver.new_var();
+  }
+  vector<Literal> tmp_lits;
+  for (vector<vector<int> >::const_iterator p = mCnf.mClauseList.begin();
+       p != mCnf.mClauseList.end(); ++ p) {
+    const vector<int>& clause = *p;
+    tmp_lits.clear();
+    for (vector<int>::const_iterator q = clause.begin();
+	 q != clause.end(); ++ q) {
+      int v = *q;
+      if ( v > 0 ) {
+	tmp_lits.push_back(Literal(var_list[v - 1], false));
+      }
+      else {
+	tmp_lits.push_back(Literal(var_list[- v - 1], true));
+      }
+    }
+    solver.add_clause(tmp_lits);
+  }
+
+  vector<Bool3> model;
+  Bool3 ans = solver.solve(model);
+  switch ( ans ) {
+  case kB3True:  return 1;
+  case kB3False: return 0;
+  default:       return 2;
+  }
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// 鳩の巣原理の CNF を解く項目
+//////////////////////////////////////////////////////////////////////
+class PhpSatBench :
+  public SatBench
+{
+public:
+
+  // コンストラクタ
+  PhpSatBench(const string& sat_type,
+	      const string& sat_name,
+	      ymuint hole_num);
+
+
+protected:
+
+  // CNF を作る．
+  virtual
+  bool
+  make_cnf(Cnf& cnf);
+
+
+private:
+
+  // 巣の数
+  ymuint32 mHoleNum;
+
+};
+
+PhpSatBench::PhpSatBench(const string& sat_type,
+			 const string& sat_name,
+			 ymuint hole_num) :
+  SatBench(sat_type, sat_name, "php" + std::to_string(hole_num)),
+  mHoleNum(hole_num)
+{
+}
+
+bool
+PhpSatBench::make_cnf(Cnf& cnf)
+{
+  make_php(mHoleNum, cnf);
+  return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// ランダム 3-SAT の CNF を解く項目
+//////////////////////////////////////////////////////////////////////
+class Rand3SatBench :
+  public SatBench
+{
+public:
+
+  // コンストラクタ
+  Rand3SatBench(const string& sat_type,
+		const string& sat_name,
+		ymuint var_num,
+		ymuint32 seed);
+
+
+protected:
+
+  // CNF を作る．
+  virtual
+  bool
+  make_cnf(Cnf& cnf);
+
+
+private:
+
+  // 変数の数
+  ymuint32 mVarNum;
+
+  // 乱数の種
+  ymuint32 mSeed;
+
+};
+
+Rand3SatBench::Rand3SatBench(const string& sat_type,
+			     const string& sat_name,
+			     ymuint var_num,
+			     ymuint32 seed) :
+  SatBench(sat_type, sat_name,
+	   "rand3_" + std::to_string(var_num) + "_" + std::to_string(seed)),
+  mVarNum(var_num),
+  mSeed(seed)
+{
+}
+
+bool
+Rand3SatBench::make_cnf(Cnf& cnf)
+{
+  make_rand3(mVarNum, mSeed, cnf);
+  return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// DIMACS ファイルの CNF を解く項目
+//////////////////////////////////////////////////////////////////////
+class FileSatBench :
+  public SatBench
+{
+public:
+
+  // コンストラクタ
+  FileSatBench(const string& sat_type,
+	       const string& sat_name,
+	       const string& filename);
+
+
+protected:
+
+  // CNF を作る．
+  virtual
+  bool
+  make_cnf(Cnf& cnf);
+
+
+private:
+
+  // ファイル名
+  string mFileName;
+
+};
+
+FileSatBench::FileSatBench(const string& sat_type,
+			   const string& sat_name,
+			   const string& filename) :
+  SatBench(sat_type, sat_name, base_name(filename)),
+  mFileName(filename)
+{
+}
+
+bool
+FileSatBench::make_cnf(Cnf& cnf)
+{
+  return read_cnf(mFileName, cnf);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// DIMACS ファイルの読み込みの項目
+// 結果は節の数となる．
+//////////////////////////////////////////////////////////////////////
+class DimacsParseBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  // format は項目名の先頭に付ける文字列
+  DimacsParseBench(const string& filename,
+		   const string& format = "dimacs");
+
+  // 計測の前の準備を行う．
+  virtual
+  bool
+  setup();
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+  // 1回の run() で処理するバイト数を返す．
+  virtual
+  ymuint64
+  byte_size() const;
+
+
+protected:
+
+  // ファイル名を返す．
+  const string&
+  filename() const;
+
+
+private:
+
+  // ファイル名
+  string mFileName;
+
+  // ファイルサイズ
+  ymuint64 mSize;
+
+};
+
+DimacsParseBench::DimacsParseBench(const string& filename,
+				   const string& format) :
+  BenchCase("parse", format + "/" + base_name(filename)),
+  mFileName(filename),
+  mSize(0)
+{
+}
+
+bool
+DimacsParseBench::setup()
+{
+  ifstream s(mFileName.c_str(), ios::binary);
+  if ( !s ) {
+    return false;
+  }
+  s.seekg(0, ios::end);
+  mSize = s.tellg();
+  return true;
+}
+
+ymuint64
+DimacsParseBench::run()
+{
+  Cnf cnf;
+  if ( !read_cnf(mFileName, cnf) ) {
+    return 0;
+  }
+  return cnf.mClauseList.size();
+}
+
+ymuint64
+DimacsParseBench::byte_size() const
+{
+  return mSize;
+}
+
+const string&
+DimacsParseBench::filename() const
+{
+  return mFileName;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// DimacsParser と SatDimacsHandler で SAT ソルバに読み込む項目
+// DimacsLoadBench の比較対象
+// 結果は SAT ソルバ上の節の数となる．
+//////////////////////////////////////////////////////////////////////
+class DimacsHandlerBench :
+  public DimacsParseBench
+{
+public:
+
+  // コンストラクタ
+  DimacsHandlerBench(const string& filename);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+};
+
+DimacsHandlerBench::DimacsHandlerBench(const string& filename) :
+  DimacsParseBench(filename, "dimacs_handler")
+{
+}
+
+ymuint64
+DimacsHandlerBench::run()
+{
+  FileIDO ido;
+  if ( !ido.open(filename()) ) {
+    return 0;
+  }
+  SatSolver solver;
+  DimacsParser parser;
+  SatDimacsHandler handler(solver);
+  parser.add_handler(&handler);
+  if ( !parser.read(ido) ) {
+    return 0;
+  }
+  return solver.clause_num();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// DimacsLoader で SAT ソルバに直接読み込む項目
+// 結果は SAT ソルバ上の節の数となる．
+//////////////////////////////////////////////////////////////////////
+class DimacsLoadBench :
+  public DimacsParseBench
+{
+public:
+
+  // コンストラクタ
+  DimacsLoadBench(const string& filename);
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+};
+
+DimacsLoadBench::DimacsLoadBench(const string& filename) :
+  DimacsParseBench(filename, "dimacs_load")
+{
+}
+
+ymuint64
+DimacsLoadBench::run()
+{
+  SatSolver solver;
+  DimacsLoader loader;
+  if ( !loader.load(filename(), solver) ) {
+    return 0;
+  }
+  return solver.clause_num();
+}
+
+END_NONAMESPACE
+
+
+// @brief SAT ソルバの項目を登録する．
+void
+reg_sat_bench(BenchMgr& mgr,
+	      const BenchInput& input)
+{
+  const char* type_list[] = { "", "minisat", "minisat2", "glueminisat2" };
+  const char* name_list[] = { "ymsat", "minisat", "minisat2", "glueminisat2" };
+  for (ymuint i = 0; i < 4; ++ i) {
+    string type = type_list[i];
+    string name = name_list[i];
+    mgr.reg_case(new PhpSatBench(type, name, 7));
+    for (ymuint32 seed = 1; seed <= 3; ++ seed) {
+      mgr.reg_case(new Rand3SatBench(type, name, 200, seed));
+    }
+    for (vector<string>::const_iterator p = input.mCnfList.begin();
+	 p != input.mCnfList.end(); ++ p) {
+      mgr.reg_case(new FileSatBench(type, name, *p));
+    }
+  }
+
+  for (vector<string>::const_iterator p = input.mCnfList.begin();
+       p != input.mCnfList.end(); ++ p) {
+    mgr.reg_case(new DimacsParseBench(*p));
+    mgr.reg_case(new DimacsHandlerBench(*p));
+    mgr.reg_case(new DimacsLoadBench(*p));
+  }
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,161 @@
+﻿
+/// @file sigprob_bench.cc
+/// @brief 信号確率の計算のベンチマーク
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bench.h"
+#include "BenchMgr.h"
+#include "BenchCase.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnPort.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnNodeHandle.h"
+#include "YmNetworks/BdnSigProb.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 全加算器を作る．
+void
+make_full_adder(BdnMgr& mgr,
+		BdnNodeHandle a,
+		BdnNodeHandle b,
+		BdnNodeHandle c,
+		BdnNodeHandle& s,
+		BdnNodeHandle& co)
+{
+  BdnNodeHandle p = mgr.new_xor(a, b);
+  s = mgr.new_xor(p, c);
+  co = mgr.new_or(mgr.new_and(a, b), mgr.new_and(p, c));
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// 配列型乗算器の信号確率を求める項目
+// 結果は出力ノードの信号確率の和を 10^6 倍したものとなる．
+//////////////////////////////////////////////////////////////////////
+class MultSigProbBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  // cut_size が 0 の時はモンテカルロシミュレーションを行う．
+  MultSigProbBench(ymuint bit_width,
+		   ymuint cut_size,
+		   ymuint thread_num);
+
+  // 計測の前の準備を行う．
+  virtual
+  bool
+  setup();
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+private:
+
+  // ビット幅
+  ymuint32 mBitWidth;
+
+  // カットの大きさ
+  ymuint32 mCutSize;
+
+  // スレッド数
+  ymuint32 mThreadNum;
+
+  // 対象のネットワーク
+  BdnMgr mNetwork;
+
+};
+
+MultSigProbBench::MultSigProbBench(ymuint bit_width,
+				   ymuint cut_size,
+				   ymuint thread_num) :
+  BenchCase("sigprob", "mult" + std::to_string(bit_width) + "_" +
+	    (cut_size == 0 ? string("sim") : "cut" + std::to_string(cut_size)) +
+	    "_t" + std::to_string(thread_num)),
+  mBitWidth(bit_width),
+  mCutSize(cut_size),
+  mThreadNum(thread_num)
+{
+}
+
+bool
+MultSigProbBench::setup()
+{
+  ymuint n = mBitWidth;
+  BdnPort* a_port = mNetwork.new_input_port("a", n);
+  BdnPort* b_port = mNetwork.new_input_port("b", n);
+  BdnPort* p_port = mNetwork.new_output_port("p", n * 2);
+  vector<BdnNodeHandle> a(n);
+  vector<BdnNodeHandle> b(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    a[i] = BdnNodeHandle(a_port->_input(i), false);
+    b[i] = BdnNodeHandle(b_port->_input(i), false);
+  }
+
+  // 部分積を桁上げ保存加算器の列で足し合わせる．
+  vector<BdnNodeHandle> sum(n * 2, BdnNodeHandle::make_zero());
+  for (ymuint i = 0; i < n; ++ i) {
+    BdnNodeHandle c = BdnNodeHandle::make_zero();
+    for (ymuint j = 0; j < n; ++ j) {
+      BdnNodeHandle pp = mNetwork.new_and(a[j], b[i]);
+      BdnNodeHandle s;
+      make_full_adder(mNetwork, sum[i + j], pp, c, s, c);
+      sum[i + j] = s;
+    }
+    sum[i + n] = c;
+  }
+  for (ymuint i = 0; i < n * 2; ++ i) {
+    mNetwork.change_output_fanin(p_port->_output(i), sum[i]);
+  }
+  return true;
+}
+
+ymuint64
+MultSigProbBench::run()
+{
+  BdnSigProb sigprob(mNetwork, mThreadNum);
+  if ( mCutSize == 0 ) {
+    sigprob.set_mc_param(1U << 20, 0.001);
+    sigprob.simulate();
+  }
+  else {
+    sigprob.set_cut_param(mCutSize, mCutSize * 4);
+    sigprob.analyze();
+  }
+
+  double total = 0.0;
+  const BdnNodeList& output_list = mNetwork.output_list();
+  for (BdnNodeList::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    total += sigprob.prob(*p);
+  }
+  return static_cast<ymuint64>(total * 1.0e+6 + 0.5);
+}
+
+END_NONAMESPACE
+
+
+// @brief 信号確率の項目を登録する．
+void
+reg_sigprob_bench(BenchMgr& mgr)
+{
+  ymuint cut_size_list[] = { 0, 4, 8 };
+  for (ymuint i = 0; i < 3; ++ i) {
+    mgr.reg_case(new MultSigProbBench(16, cut_size_list[i], 1));
+    mgr.reg_case(new MultSigProbBench(16, cut_size_list[i], 4));
+  }
+}
+
+END_NAMESPACE_YM
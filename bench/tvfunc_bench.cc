@@ -0,0 +1,270 @@
+﻿
+/// @file tvfunc_bench.cc
+/// @brief TvFunc のベンチマーク
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bench.h"
+#include "BenchMgr.h"
+#include "BenchCase.h"
+#include "YmLogic/TvFunc.h"
+#include "YmLogic/NpnMgr.h"
+#include "YmLogic/NpnMap.h"
+#include "YmUtils/RandGen.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// ランダムな関数のリストを作る．
+void
+make_rand_func(ymuint ni,
+	       ymuint func_num,
+	       ymuint32 seed,
+	       vector<TvFunc>& func_list)
+{
+  RandGen rg;
+  rg.init(seed);
+  ymuint nb = 1U << ni;
+  ymuint nblk = (nb + 63) / 64;
+  func_list.clear();
+  func_list.reserve(func_num);
+  for (ymuint i = 0; i < func_num; ++ i) {
+    vector<ymuint64> blocks(nblk);
+    for (ymuint j = 0; j < nblk; ++ j) {
+      blocks[j] = (static_cast<ymuint64>(rg.int32()) << 32) | rg.int32();
+    }
+    func_list.push_back(TvFunc(ni, blocks));
+  }
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// Walsh 係数の計算の項目
+// 結果は全係数の和となる．
+//////////////////////////////////////////////////////////////////////
+class WalshBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  WalshBench(ymuint ni,
+	     ymuint func_num);
+
+  // 計測の前の準備を行う．
+  virtual
+  bool
+  setup();
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+private:
+
+  // 入力数
+  ymuint32 mInputNum;
+
+  // 関数の数
+  ymuint32 mFuncNum;
+
+  // 対象の関数のリスト
+  vector<TvFunc> mFuncList;
+
+};
+
+WalshBench::WalshBench(ymuint ni,
+		       ymuint func_num) :
+  BenchCase("tvfunc", "walsh" + std::to_string(ni)),
+  mInputNum(ni),
+  mFuncNum(func_num)
+{
+}
+
+bool
+WalshBench::setup()
+{
+  make_rand_func(mInputNum, mFuncNum, 1, mFuncList);
+  return true;
+}
+
+ymuint64
+WalshBench::run()
+{
+  ymuint ni = mInputNum;
+  ymint64 sum = 0;
+  for (vector<TvFunc>::const_iterator p = mFuncList.begin();
+       p != mFuncList.end(); ++ p) {
+    const TvFunc& func = *p;
+    sum += func.walsh_0();
+    for (ymuint i = 0; i < ni; ++ i) {
+      VarId var1(i);
+      sum += func.walsh_1(var1);
+      for (ymuint j = i + 1; j < ni; ++ j) {
+	VarId var2(j);
+	sum += func.walsh_2(var1, var2);
+      }
+    }
+  }
+  return static_cast<ymuint64>(sum);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// NPN 同値類の代表関数を求める項目
+// 結果は代表関数のハッシュ値の和となる．
+//////////////////////////////////////////////////////////////////////
+class NpnBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  NpnBench(ymuint ni,
+	   ymuint func_num);
+
+  // 計測の前の準備を行う．
+  virtual
+  bool
+  setup();
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+private:
+
+  // 入力数
+  ymuint32 mInputNum;
+
+  // 関数の数
+  ymuint32 mFuncNum;
+
+  // 対象の関数のリスト
+  vector<TvFunc> mFuncList;
+
+};
+
+NpnBench::NpnBench(ymuint ni,
+		   ymuint func_num) :
+  BenchCase("tvfunc", "npn" + std::to_string(ni)),
+  mInputNum(ni),
+  mFuncNum(func_num)
+{
+}
+
+bool
+NpnBench::setup()
+{
+  make_rand_func(mInputNum, mFuncNum, 2, mFuncList);
+  return true;
+}
+
+ymuint64
+NpnBench::run()
+{
+  NpnMgr npn_mgr;
+  ymuint64 sum = 0;
+  for (vector<TvFunc>::const_iterator p = mFuncList.begin();
+       p != mFuncList.end(); ++ p) {
+    const TvFunc& func = *p;
+    NpnMap map;
+    npn_mgr.cannonical(func, map);
+    TvFunc cfunc = func.xform(map);
+    sum += cfunc.hash();
+  }
+  return sum;
+}
+
+
+
+//////////////////////////////////////////////////////////////////////
+// 非冗長積和形を求める項目
+// 結果はキューブ数の和となる．
+//////////////////////////////////////////////////////////////////////
+class IsopBench :
+  public BenchCase
+{
+public:
+
+  // コンストラクタ
+  IsopBench(ymuint ni,
+	    ymuint func_num);
+
+  // 計測の前の準備を行う．
+  virtual
+  bool
+  setup();
+
+  // 計測の対象となる処理を行う．
+  virtual
+  ymuint64
+  run();
+
+
+private:
+
+  // 入力数
+  ymuint32 mInputNum;
+
+  // 関数の数
+  ymuint32 mFuncNum;
+
+  // 対象の関数のリスト
+  vector<TvFunc> mFuncList;
+
+};
+
+IsopBench::IsopBench(ymuint ni,
+		     ymuint func_num) :
+  BenchCase("tvfunc", "isop" + std::to_string(ni)),
+  mInputNum(ni),
+  mFuncNum(func_num)
+{
+}
+
+bool
+IsopBench::setup()
+{
+  make_rand_func(mInputNum, mFuncNum, 3, mFuncList);
+  return true;
+}
+
+ymuint64
+IsopBench::run()
+{
+  ymuint64 sum = 0;
+  vector<ymuint64> cube_list;
+  for (vector<TvFunc>::const_iterator p = mFuncList.begin();
+       p != mFuncList.end(); ++ p) {
+    const TvFunc& func = *p;
+    (void) isop(func, func, cube_list);
+    sum += cube_list.size();
+  }
+  return sum;
+}
+
+END_NONAMESPACE
+
+
+// @brief TvFunc の項目を登録する．
+void
+reg_tvfunc_bench(BenchMgr& mgr)
+{
+  mgr.reg_case(new WalshBench(10, 2000));
+  mgr.reg_case(new NpnBench(4, 20000));
+  mgr.reg_case(new NpnBench(6, 2000));
+  mgr.reg_case(new IsopBench(6, 20000));
+  mgr.reg_case(new IsopBench(10, 200));
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,197 @@
+﻿
+/// @file ym_bench.cc
+/// @brief ベンチマークのメインプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bench.h"
+#include "BenchMgr.h"
+#include "YmUtils/MsgMgr.h"
+#include "YmUtils/MsgHandler.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+void
+usage(const char* argv0)
+{
+  cerr << "USAGE : " << argv0 << " [options]" << endl
+       << "  -n <num>          repeat count (default: 5)" << endl
+       << "  -f <pattern>      run only cases whose \"category/name\" contains <pattern>" << endl
+       << "  -o <file>         write JSON to <file> (default: stdout)" << endl
+       << "  -q                do not print progress to stderr" << endl
+       << "  --label <str>     label recorded in the output (e.g. commit id)" << endl
+       << "  --profile <pre>   write gperftools profiles to <pre>.<case>.prof" << endl
+       << "  --list            list the cases and exit" << endl
+       << "  --datadir <dir>   top of the source tree holding the bundled data" << endl
+       << "  --cnf <file>      add a DIMACS file" << endl
+       << "  --blif <file>     add a blif file" << endl
+       << "  --iscas89 <file>  add an iscas89 file" << endl
+       << "  --verilog <file>  add a verilog file" << endl
+       << "  --liberty <file>  add a liberty file" << endl;
+}
+
+END_NONAMESPACE
+
+
+int
+ym_bench(int argc,
+	 char** argv)
+{
+  BenchInput input;
+#if defined(YM_BENCH_DATADIR)
+  input.mDataDir = YM_BENCH_DATADIR;
+#else
+  input.mDataDir = ".";
+#endif
+
+  ymuint repeat = 5;
+  vector<string> filter_list;
+  string out_filename;
+  string label;
+  string profile;
+  bool list_only = false;
+  bool quiet = false;
+
+  for (int pos = 1; pos < argc; ++ pos) {
+    const char* opt = argv[pos];
+    // 引数を取るオプション
+    const char* arg = nullptr;
+    if ( strcmp(opt, "-n") == 0 ||
+	 strcmp(opt, "-f") == 0 ||
+	 strcmp(opt, "-o") == 0 ||
+	 strcmp(opt, "--label") == 0 ||
+	 strcmp(opt, "--profile") == 0 ||
+	 strcmp(opt, "--datadir") == 0 ||
+	 strcmp(opt, "--cnf") == 0 ||
+	 strcmp(opt, "--blif") == 0 ||
+	 strcmp(opt, "--iscas89") == 0 ||
+	 strcmp(opt, "--verilog") == 0 ||
+	 strcmp(opt, "--liberty") == 0 ) {
+      if ( pos + 1 >= argc ) {
+	cerr << opt << " : requires an argument" << endl;
+	usage(argv[0]);
+	return 1;
+      }
+      ++ pos;
+      arg = argv[pos];
+    }
+
+    if ( strcmp(opt, "-n") == 0 ) {
+      int n = atoi(arg);
+      if ( n <= 0 ) {
+	cerr << arg << " : illegal repeat count" << endl;
+	return 1;
+      }
+      repeat = n;
+    }
+    else if ( strcmp(opt, "-f") == 0 ) {
+      filter_list.push_back(arg);
+    }
+    else if ( strcmp(opt, "-o") == 0 ) {
+      out_filename = arg;
+    }
+    else if ( strcmp(opt, "-q") == 0 ) {
+      quiet = true;
+    }
+    else if ( strcmp(opt, "--label") == 0 ) {
+      label = arg;
+    }
+    else if ( strcmp(opt, "--profile") == 0 ) {
+      profile = arg;
+    }
+    else if ( strcmp(opt, "--list") == 0 ) {
+      list_only = true;
+    }
+    else if ( strcmp(opt, "--datadir") == 0 ) {
+      input.mDataDir = arg;
+    }
+    else if ( strcmp(opt, "--cnf") == 0 ) {
+      input.mCnfList.push_back(arg);
+    }
+    else if ( strcmp(opt, "--blif") == 0 ) {
+      input.mBlifList.push_back(arg);
+    }
+    else if ( strcmp(opt, "--iscas89") == 0 ) {
+      input.mIscas89List.push_back(arg);
+    }
+    else if ( strcmp(opt, "--verilog") == 0 ) {
+      input.mVerilogList.push_back(arg);
+    }
+    else if ( strcmp(opt, "--liberty") == 0 ) {
+      input.mLibertyList.push_back(arg);
+    }
+    else {
+      cerr << opt << " : illegal option" << endl;
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if ( profile != string() && !BenchMgr::profiler_enabled() ) {
+    cerr << "Warning: gperftools is not available. --profile is ignored." << endl;
+  }
+
+  BenchMgr mgr;
+  reg_aig_bench(mgr);
+  reg_bdd_bench(mgr);
+  reg_sat_bench(mgr, input);
+  reg_tvfunc_bench(mgr);
+  reg_parser_bench(mgr, input);
+  reg_mincov_bench(mgr);
+  reg_sigprob_bench(mgr);
+
+  mgr.set_repeat(repeat);
+  for (vector<string>::iterator p = filter_list.begin();
+       p != filter_list.end(); ++ p) {
+    mgr.add_filter(*p);
+  }
+  mgr.set_label(label);
+  mgr.set_profile(profile);
+
+  if ( list_only ) {
+    mgr.list_cases(cout);
+    return 0;
+  }
+
+  if ( !quiet ) {
+    mgr.set_progress(&cerr);
+  }
+
+  // パーサーのエラーメッセージは JSON と混ざらないように cerr に出す．
+  StreamMsgHandler msg_handler(&cerr);
+  msg_handler.set_mask(kMaskError | kMaskFailure);
+  MsgMgr::reg_handler(&msg_handler);
+
+  bool ok;
+  if ( out_filename != string() ) {
+    ofstream ofs(out_filename.c_str());
+    if ( !ofs ) {
+      cerr << out_filename << " : could not open" << endl;
+      MsgMgr::unreg_handler(&msg_handler);
+      return 2;
+    }
+    ok = mgr.run(ofs);
+  }
+  else {
+    ok = mgr.run(cout);
+  }
+
+  MsgMgr::unreg_handler(&msg_handler);
+
+  return ok ? 0 : 3;
+}
+
+END_NAMESPACE_YM
+
+int
+main(int argc,
+     char** argv)
+{
+  return nsYm::ym_bench(argc, argv);
+}
@@ -0,0 +1,82 @@
+﻿#ifndef YM_BENCH_H
+#define YM_BENCH_H
+
+/// @file ym_bench.h
+/// @brief ym_bench の項目を登録する関数の宣言
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmTools.h"
+
+
+BEGIN_NAMESPACE_YM
+
+class BenchMgr;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BenchInput ym_bench.h "ym_bench.h"
+/// @brief ベンチマークの入力ファイルの情報
+//////////////////////////////////////////////////////////////////////
+struct BenchInput
+{
+  /// @brief 同梱のテストデータのあるディレクトリ(ソースツリーの先頭)
+  string mDataDir;
+
+  /// @brief 追加の DIMACS ファイルのリスト
+  vector<string> mCnfList;
+
+  /// @brief 追加の blif ファイルのリスト
+  vector<string> mBlifList;
+
+  /// @brief 追加の iscas89 ファイルのリスト
+  vector<string> mIscas89List;
+
+  /// @brief 追加の verilog ファイルのリスト
+  vector<string> mVerilogList;
+
+  /// @brief liberty ファイルのリスト
+  vector<string> mLibertyList;
+};
+
+
+/// @brief ファイルのパス名の最後の要素を取り出す．
+/// @note 項目の名前に用いる．
+string
+base_name(const string& filename);
+
+/// @brief AIG の項目を登録する．
+void
+reg_aig_bench(BenchMgr& mgr);
+
+/// @brief BDD の項目を登録する．
+void
+reg_bdd_bench(BenchMgr& mgr);
+
+/// @brief SAT ソルバの項目を登録する．
+void
+reg_sat_bench(BenchMgr& mgr,
+	      const BenchInput& input);
+
+/// @brief TvFunc の項目を登録する．
+void
+reg_tvfunc_bench(BenchMgr& mgr);
+
+/// @brief パーサーの項目を登録する．
+void
+reg_parser_bench(BenchMgr& mgr,
+		 const BenchInput& input);
+
+/// @brief 最小被覆問題の項目を登録する．
+void
+reg_mincov_bench(BenchMgr& mgr);
+
+/// @brief 信号確率の項目を登録する．
+void
+reg_sigprob_bench(BenchMgr& mgr);
+
+END_NAMESPACE_YM
+
+#endif // YM_BENCH_H
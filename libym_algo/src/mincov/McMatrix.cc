@@ -288,7 +288,7 @@ McMatrix::resize(ymuint32 row_size,
     mColHead.clear();
 
     delete [] mDelStack;
-    mDelStack = new ymuint32[row_size + col_size];
+    mDelStack = new ymuint32[row_size + col_size * 2 + 1];
     mStackTop = 0;
   }
 }
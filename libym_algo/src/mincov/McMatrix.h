@@ -345,6 +345,8 @@ private:
   const ymuint32* mCostArray;
 
   // 削除の履歴を覚えておくスタック
+  // 各行と各列の削除に加えて save() のマーカーが積まれるので
+  // サイズは mRowSize + mColSize * 2 + 1
   ymuint32* mDelStack;
 
   // mDelStack のポインタ
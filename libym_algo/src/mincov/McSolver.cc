@@ -50,7 +50,7 @@ McSolver::~McSolver()
   delete mLbCalc;
   delete mSelector;
   delete mMatrix;
-  delete mCostArray;
+  delete [] mCostArray;
 }
 
 // @brief 問題のサイズを設定する．
@@ -61,7 +61,7 @@ McSolver::set_size(ymuint32 row_size,
 		   ymuint32 col_size)
 {
   delete mMatrix;
-  delete mCostArray;
+  delete [] mCostArray;
   mCostArray = new ymuint32[col_size];
   for (ymuint i = 0; i < col_size; ++ i) {
     mCostArray[i] = 1;
@@ -213,6 +213,30 @@ public:
 	 tCellTimingSense sense,
 	 ymuint pos) const = 0;
 
+  /// @brief コーナーごとのタイミング情報の取得
+  /// @param[in] corner コーナー番号 ( 0 <= corner < library->corner_num() )
+  /// @param[in] pos 位置番号 ( 0 <= pos < timing_num() )
+  /// @note corner_timing(0, pos) は timing(pos) と同じものを返す．
+  /// @note タイミング情報の番号はすべてのコーナーで共通となる．
+  virtual
+  const CellTiming*
+  corner_timing(ymuint corner,
+		ymuint pos) const = 0;
+
+  /// @brief 条件に合致するコーナーごとのタイミング情報の取得
+  /// @param[in] corner コーナー番号 ( 0 <= corner < library->corner_num() )
+  /// @param[in] ipos 開始ピン番号 ( 0 <= ipos < input_num2() )
+  /// @param[in] opos 終了ピン番号 ( 0 <= opos < output_num2() )
+  /// @param[in] sense タイミング情報の摘要条件
+  /// @param[in] pos 位置番号 ( 0 <= pos < timing_num(ipos, opos, sense) )
+  virtual
+  const CellTiming*
+  corner_timing(ymuint corner,
+		ymuint ipos,
+		ymuint opos,
+		tCellTimingSense sense,
+		ymuint pos) const = 0;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
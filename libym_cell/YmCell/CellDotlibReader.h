@@ -24,7 +24,10 @@ class CellDotlibReader
 public:
 
   /// @brief コンストラクタ
-  CellDotlibReader();
+  /// @param[in] thread_num cell group の読み込みとセルの分類に用いるスレッド数
+  /// @note 既定値の 1 では逐次的に処理する．
+  /// @note thread_num が 0 の時はハードウェアのスレッド数を用いる．
+  CellDotlibReader(ymuint thread_num = 1);
 
   /// @brief デストラクタ
   ~CellDotlibReader();
@@ -46,6 +49,26 @@ public:
   const CellLibrary*
   operator()(const char* filename);
 
+  /// @brief 複数のコーナーの dotlib ファイルを読み込んでライブラリを生成する．
+  /// @param[in] filename_list コーナーごとのファイル名のリスト
+  /// @return 読み込んで作成したセルライブラリを返す．
+  /// @note セルやピン，論理式などの構造的な情報は先頭のファイルから作り，
+  /// 残りのファイルからはタイミング情報のみを読み込んで共有する．
+  /// @note コーナー名は各ファイルのライブラリ名となる．
+  /// @note セルやタイミング情報の構成が先頭のファイルと異なっていたり，
+  /// エラーが起きたら nullptr を返す．
+  const CellLibrary*
+  operator()(const vector<string>& filename_list);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // cell group の読み込みに用いるスレッド数
+  ymuint32 mThreadNum;
+
 };
 
 END_NAMESPACE_YM_CELL
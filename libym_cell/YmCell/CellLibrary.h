@@ -126,6 +126,19 @@ public:
   string
   leakage_power_unit() const = 0;
 
+  /// @brief コーナー数の取得
+  /// @note 通常のライブラリは 1 となる．
+  /// @note タイミング情報以外はすべてのコーナーで共通となる．
+  virtual
+  ymuint
+  corner_num() const = 0;
+
+  /// @brief コーナー名の取得
+  /// @param[in] corner コーナー番号 ( 0 <= corner < corner_num() )
+  virtual
+  string
+  corner_name(ymuint corner) const = 0;
+
   /// @brief 遅延テーブルのテンプレート数の取得
   virtual
   ymuint
@@ -346,10 +359,33 @@ public:
 
   /// @brief バイナリダンプされた内容を読み込む．
   /// @param[in] s 入力元のストリーム
+  /// @retval true 読み込みが成功した．
+  /// @retval false 形式が異なっていた．
+  /// @note false の場合は内容を変更しない．
   virtual
-  void
+  bool
   restore(IDO& s) = 0;
 
+  /// @brief mmap で読み込むための形式でバイナリダンプする．
+  /// @param[in] s 出力先のストリーム
+  /// @note restore_mapped() で読み込むためにはファイルの先頭から
+  /// 書き出す必要がある．
+  virtual
+  void
+  dump_mapped(ODO& s) const = 0;
+
+  /// @brief dump_mapped() で書き出したファイルを読み込む．
+  /// @param[in] filename ファイル名
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  /// @note タイミング情報とパタングラフは最初に参照された時に読み込まれる．
+  /// そのためファイルはこのオブジェクトが破棄されるまでマップされたままとなる．
+  /// @note 遅延読み込みは排他的に行われるので，読み込んだライブラリを
+  /// 複数のスレッドから同時に参照してもよい．
+  virtual
+  bool
+  restore_mapped(const string& filename) = 0;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -397,6 +433,28 @@ public:
   set_attr(const string& attr_name,
 	   const string& value) = 0;
 
+  /// @brief コーナー数を設定する．
+  /// @param[in] num コーナー数
+  /// @note set_cell_num() よりも前に呼ぶ必要がある．
+  virtual
+  void
+  set_corner_num(ymuint num) = 0;
+
+  /// @brief コーナー名を設定する．
+  /// @param[in] corner コーナー番号 ( 0 <= corner < corner_num() )
+  /// @param[in] name コーナー名
+  virtual
+  void
+  set_corner_name(ymuint corner,
+		  const string& name) = 0;
+
+  /// @brief 以降の new_timing_XXX() でタイミング情報を設定するコーナーを指定する．
+  /// @param[in] corner コーナー番号 ( 0 <= corner < corner_num() )
+  /// @note set_timing() はコーナー 0 のタイミング情報に対して設定する．
+  virtual
+  void
+  set_cur_corner(ymuint corner) = 0;
+
   /// @brief 遅延テーブルのテンプレート数を設定する．
   virtual
   void
@@ -849,10 +907,14 @@ public:
 	   const vector<double>& index_array3 = vector<double>()) = 0;
 
   /// @brief セルのグループ分けを行う．
+  /// @param[in] thread_num NPN同値類の計算に用いるスレッド数
   /// @note 論理セルのパタングラフも作成する．
+  /// @note NPN同値類の計算結果はプロセス内でキャッシュされるので
+  /// 同じ関数のセルを含むライブラリ(コーナー)を繰り返し読む場合には
+  /// 計算し直さない．
   virtual
   void
-  compile() = 0;
+  compile(ymuint thread_num = 1) = 0;
 
 };
 
@@ -0,0 +1,452 @@
+﻿
+/// @file CiLibraryDumpTest.cc
+/// @brief CiLibraryDumpTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmCell/CellDotlibReader.h"
+#include "YmCell/CellLibrary.h"
+#include "YmUtils/StreamIDO.h"
+#include "YmUtils/StreamODO.h"
+#include "YmCell/Cell.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_CELL
+
+BEGIN_NONAMESPACE
+
+// テスト用の liberty ファイルの内容
+const char* kLibraryText =
+  "library (dump_lib) {\n"
+  "  delay_model : table_lookup ;\n"
+  "  time_unit : \"1ns\" ;\n"
+  "  capacitive_load_unit (1,pf) ;\n"
+  "  lu_table_template (t1) {\n"
+  "    variable_1 : input_net_transition ;\n"
+  "    index_1 (\"0.1, 0.2\") ;\n"
+  "  }\n"
+  "  cell (INV) {\n"
+  "    area : 1 ;\n"
+  "    pin (A) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (Y) {\n"
+  "      direction : output ;\n"
+  "      function : \"!A\" ;\n"
+  "      timing () {\n"
+  "        related_pin : \"A\" ;\n"
+  "        timing_sense : non_unate ;\n"
+  "        cell_rise (t1) {\n"
+  "          values (\"0.1, 0.2\") ;\n"
+  "        }\n"
+  "        cell_fall (t1) {\n"
+  "          values (\"0.3, 0.4\") ;\n"
+  "        }\n"
+  "        rise_transition (t1) {\n"
+  "          values (\"0.5, 0.6\") ;\n"
+  "        }\n"
+  "        fall_transition (t1) {\n"
+  "          values (\"0.7, 0.8\") ;\n"
+  "        }\n"
+  "      }\n"
+  "    }\n"
+  "  }\n"
+  "  cell (NAND2) {\n"
+  "    area : 2 ;\n"
+  "    pin (A) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (B) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.02 ;\n"
+  "    }\n"
+  "    pin (Y) {\n"
+  "      direction : output ;\n"
+  "      function : \"!(A*B)\" ;\n"
+  "    }\n"
+  "  }\n"
+  "  cell (XOR2) {\n"
+  "    area : 3 ;\n"
+  "    pin (A) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (B) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.02 ;\n"
+  "    }\n"
+  "    pin (Y) {\n"
+  "      direction : output ;\n"
+  "      function : \"A^B\" ;\n"
+  "    }\n"
+  "  }\n"
+  "}\n";
+
+// タイミング情報を持つインバータを cell_num 個含む liberty ファイルの内容を作る．
+string
+make_inv_library_text(ymuint cell_num)
+{
+  ostringstream buf;
+  buf << "library (inv_lib) {" << endl
+      << "  delay_model : table_lookup ;" << endl
+      << "  time_unit : \"1ns\" ;" << endl
+      << "  capacitive_load_unit (1,pf) ;" << endl
+      << "  lu_table_template (t1) {" << endl
+      << "    variable_1 : input_net_transition ;" << endl
+      << "    index_1 (\"0.1, 0.2\") ;" << endl
+      << "  }" << endl;
+  for (ymuint i = 0; i < cell_num; ++ i) {
+    buf << "  cell (INV" << i << ") {" << endl
+	<< "    area : " << (i + 1) << " ;" << endl
+	<< "    pin (A) {" << endl
+	<< "      direction : input ;" << endl
+	<< "      capacitance : 0.01 ;" << endl
+	<< "    }" << endl
+	<< "    pin (Y) {" << endl
+	<< "      direction : output ;" << endl
+	<< "      function : \"!A\" ;" << endl
+	<< "      timing () {" << endl
+	<< "        related_pin : \"A\" ;" << endl
+	<< "        timing_sense : non_unate ;" << endl
+	<< "        cell_rise (t1) {" << endl
+	<< "          values (\"" << i << ".1, " << i << ".2\") ;" << endl
+	<< "        }" << endl
+	<< "        cell_fall (t1) {" << endl
+	<< "          values (\"" << i << ".3, " << i << ".4\") ;" << endl
+	<< "        }" << endl
+	<< "        rise_transition (t1) {" << endl
+	<< "          values (\"" << i << ".5, " << i << ".6\") ;" << endl
+	<< "        }" << endl
+	<< "        fall_transition (t1) {" << endl
+	<< "          values (\"" << i << ".7, " << i << ".8\") ;" << endl
+	<< "        }" << endl
+	<< "      }" << endl
+	<< "    }" << endl
+	<< "  }" << endl;
+  }
+  buf << "}" << endl;
+  return buf.str();
+}
+
+// liberty ファイルの内容からライブラリを読み込む．
+const CellLibrary*
+read_text(const string& text)
+{
+  string filename = ::testing::TempDir() + "CiLibraryDumpTest.lib";
+  {
+    ofstream ofs(filename.c_str());
+    if ( !ofs ) {
+      return nullptr;
+    }
+    ofs << text;
+  }
+
+  CellDotlibReader read;
+  const CellLibrary* library = read(filename);
+  remove(filename.c_str());
+  return library;
+}
+
+// ライブラリを読み込んでダンプした内容と表示用の文字列を得る．
+// mapped_file が空でなければ dump_mapped() の内容をそこに書き出す．
+bool
+read_library(const string& text,
+	     string& display_str,
+	     string& dump_str,
+	     const string& mapped_file = string())
+{
+  const CellLibrary* library = read_text(text);
+  if ( library == nullptr ) {
+    return false;
+  }
+
+  if ( mapped_file != string() ) {
+    ofstream ofs(mapped_file.c_str(), ios::binary);
+    if ( !ofs ) {
+      delete library;
+      return false;
+    }
+    StreamODO odo(ofs);
+    library->dump_mapped(odo);
+  }
+
+  ostringstream buf1;
+  display_library(buf1, *library);
+  display_str = buf1.str();
+
+  ostringstream buf2;
+  {
+    StreamODO odo(buf2);
+    library->dump(odo);
+  }
+  dump_str = buf2.str();
+
+  delete library;
+  return true;
+}
+
+// ダンプした内容を読み込む．
+bool
+restore_library(const string& dump_str,
+		CellLibrary* library)
+{
+  istringstream buf(dump_str);
+  StreamIDO ido(buf);
+  return library->restore(ido);
+}
+
+// ライブラリを表示した文字列を得る．
+string
+display_str(const CellLibrary* library)
+{
+  ostringstream buf;
+  display_library(buf, *library);
+  return buf.str();
+}
+
+// ライブラリをダンプした内容を得る．
+string
+dump_str(const CellLibrary* library)
+{
+  ostringstream buf;
+  {
+    StreamODO odo(buf);
+    library->dump(odo);
+  }
+  return buf.str();
+}
+
+// ファイルの内容を書き換える．
+void
+write_file(const string& filename,
+	   const string& contents)
+{
+  ofstream ofs(filename.c_str(), ios::binary);
+  ofs << contents;
+}
+
+// ファイルの内容を読み込む．
+string
+read_file(const string& filename)
+{
+  ifstream ifs(filename.c_str(), ios::binary);
+  ostringstream buf;
+  buf << ifs.rdbuf();
+  return buf.str();
+}
+
+// 各セルのタイミング情報を offset 番目のセルから順に参照する．
+// 遅延読み込みを複数のスレッドから同時に起こすために用いる．
+void
+access_timing(const CellLibrary* library,
+	      ymuint offset,
+	      vector<const CellTiming*>* timing_list,
+	      ymuint* pat_num)
+{
+  ymuint nc = library->cell_num();
+  timing_list->clear();
+  timing_list->resize(nc, nullptr);
+  for (ymuint i = 0; i < nc; ++ i) {
+    ymuint cell_id = (i + offset) % nc;
+    const Cell* cell = library->cell(cell_id);
+    if ( cell->timing_num() > 0 ) {
+      (*timing_list)[cell_id] = cell->timing(0);
+    }
+  }
+  *pat_num = library->pg_pat_num();
+}
+
+END_NONAMESPACE
+
+
+TEST(CiLibraryDumpTest, round_trip)
+{
+  string display1;
+  string dump1;
+  ASSERT_TRUE( read_library(kLibraryText, display1, dump1) );
+
+  CellLibrary* library = CellLibrary::new_obj();
+  ASSERT_TRUE( restore_library(dump1, library) );
+  EXPECT_EQ( 3U, library->cell_num() );
+
+  ostringstream buf1;
+  display_library(buf1, *library);
+  EXPECT_EQ( display1, buf1.str() );
+
+  ostringstream buf2;
+  {
+    StreamODO odo(buf2);
+    library->dump(odo);
+  }
+  EXPECT_TRUE( dump1 == buf2.str() );
+
+  delete library;
+}
+
+TEST(CiLibraryDumpTest, bad_version)
+{
+  string display1;
+  string dump1;
+  ASSERT_TRUE( read_library(kLibraryText, display1, dump1) );
+
+  // バージョン番号はマジックナンバーの直後の4バイト
+  ASSERT_LT( 8U, dump1.size() );
+  for (ymuint i = 4; i < 8; ++ i) {
+    string dump2 = dump1;
+    dump2[i] ^= 0x5a;
+    CellLibrary* library = CellLibrary::new_obj();
+    EXPECT_FALSE( restore_library(dump2, library) ) << "byte#" << i;
+    EXPECT_EQ( 0U, library->cell_num() );
+    delete library;
+  }
+}
+
+TEST(CiLibraryDumpTest, bad_magic)
+{
+  string display1;
+  string dump1;
+  ASSERT_TRUE( read_library(kLibraryText, display1, dump1) );
+
+  // マジックナンバーとバージョン番号を持たない古い形式
+  string dump2 = dump1.substr(8);
+  CellLibrary* library = CellLibrary::new_obj();
+  EXPECT_FALSE( restore_library(dump2, library) );
+  EXPECT_EQ( 0U, library->cell_num() );
+  delete library;
+
+  // 空のストリーム
+  library = CellLibrary::new_obj();
+  EXPECT_FALSE( restore_library(string(), library) );
+  EXPECT_EQ( 0U, library->cell_num() );
+  delete library;
+}
+
+TEST(CiLibraryDumpTest, mapped_round_trip)
+{
+  string filename = ::testing::TempDir() + "CiLibraryDumpTest.mapped";
+  string display1;
+  string dump1;
+  ASSERT_TRUE( read_library(kLibraryText, display1, dump1, filename) );
+
+  // 何も参照しないうちにダンプしても内容は変わらない．
+  CellLibrary* library0 = CellLibrary::new_obj();
+  ASSERT_TRUE( library0->restore_mapped(filename) );
+  EXPECT_TRUE( dump1 == dump_str(library0) );
+  delete library0;
+
+  CellLibrary* library = CellLibrary::new_obj();
+  ASSERT_TRUE( library->restore_mapped(filename) );
+  EXPECT_EQ( 3U, library->cell_num() );
+
+  // タイミング情報とパタングラフは参照した時点で読み込まれる．
+  EXPECT_EQ( display1, display_str(library) );
+  EXPECT_TRUE( dump1 == dump_str(library) );
+
+  // 通常の restore() で読み込んだものとも一致する．
+  CellLibrary* library2 = CellLibrary::new_obj();
+  ASSERT_TRUE( restore_library(dump1, library2) );
+  EXPECT_EQ( library2->pg_pat_num(), library->pg_pat_num() );
+  EXPECT_EQ( library2->pg_node_num(), library->pg_node_num() );
+  EXPECT_EQ( library2->pg_edge_num(), library->pg_edge_num() );
+
+  delete library2;
+  delete library;
+  remove(filename.c_str());
+}
+
+TEST(CiLibraryDumpTest, mapped_bad_file)
+{
+  string filename = ::testing::TempDir() + "CiLibraryDumpTest.mapped";
+  string display1;
+  string dump1;
+  ASSERT_TRUE( read_library(kLibraryText, display1, dump1, filename) );
+  string mapped = read_file(filename);
+  ASSERT_LT( 12U, mapped.size() );
+
+  // 存在しないファイル
+  CellLibrary* library = CellLibrary::new_obj();
+  remove(filename.c_str());
+  EXPECT_FALSE( library->restore_mapped(filename) );
+  EXPECT_EQ( 0U, library->cell_num() );
+
+  // マジックナンバー，バージョン番号，セクション数が異なる．
+  for (ymuint i = 0; i < 12; ++ i) {
+    string mapped2 = mapped;
+    mapped2[i] ^= 0x5a;
+    write_file(filename, mapped2);
+    EXPECT_FALSE( library->restore_mapped(filename) ) << "byte#" << i;
+    EXPECT_EQ( 0U, library->cell_num() );
+  }
+
+  // セクションがファイルの外を指している．
+  write_file(filename, mapped.substr(0, mapped.size() - 1));
+  EXPECT_FALSE( library->restore_mapped(filename) );
+  EXPECT_EQ( 0U, library->cell_num() );
+
+  // 通常のダンプ形式
+  write_file(filename, dump1);
+  EXPECT_FALSE( library->restore_mapped(filename) );
+  EXPECT_EQ( 0U, library->cell_num() );
+
+  delete library;
+  remove(filename.c_str());
+}
+
+TEST(CiLibraryDumpTest, mapped_parallel_load)
+{
+  // 複数のスレッドから同時に遅延読み込みを起こしても
+  // 読み込まれる内容は変わらない．
+  const ymuint cell_num = 200;
+  const ymuint thread_num = 8;
+  string text = make_inv_library_text(cell_num);
+  string filename = ::testing::TempDir() + "CiLibraryDumpTest.mapped";
+  string display1;
+  string dump1;
+  ASSERT_TRUE( read_library(text, display1, dump1, filename) );
+
+  for (ymuint r = 0; r < 10; ++ r) {
+    CellLibrary* library = CellLibrary::new_obj();
+    ASSERT_TRUE( library->restore_mapped(filename) );
+    ASSERT_EQ( cell_num, library->cell_num() );
+
+    vector<vector<const CellTiming*> > timing_list(thread_num);
+    vector<ymuint> pat_num(thread_num, 0);
+    vector<std::thread> thread_list;
+    for (ymuint t = 0; t < thread_num; ++ t) {
+      thread_list.push_back(std::thread(access_timing, library,
+					t * cell_num / thread_num,
+					&timing_list[t], &pat_num[t]));
+    }
+    for (ymuint t = 0; t < thread_num; ++ t) {
+      thread_list[t].join();
+    }
+
+    // どのスレッドも同じオブジェクトを得る．
+    for (ymuint t = 0; t < thread_num; ++ t) {
+      for (ymuint i = 0; i < cell_num; ++ i) {
+	ASSERT_TRUE( timing_list[t][i] != nullptr ) << "thread#" << t << ", cell#" << i;
+	EXPECT_EQ( timing_list[0][i], timing_list[t][i] ) << "thread#" << t << ", cell#" << i;
+	EXPECT_EQ( 1U, library->cell(i)->timing_num() );
+      }
+      EXPECT_EQ( pat_num[0], pat_num[t] );
+    }
+    EXPECT_EQ( display1, display_str(library) );
+    EXPECT_TRUE( dump1 == dump_str(library) );
+
+    delete library;
+  }
+
+  remove(filename.c_str());
+}
+
+END_NAMESPACE_YM_CELL
@@ -0,0 +1,300 @@
+
+/// @file CellDotlibCornerTest.cc
+/// @brief 複数コーナーの読み込みのテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmCell/CellDotlibReader.h"
+#include "YmCell/CellLibrary.h"
+#include "YmCell/Cell.h"
+#include "YmCell/CellPin.h"
+#include "YmCell/CellTiming.h"
+#include "YmCell/CellLut.h"
+#include "YmUtils/StreamIDO.h"
+#include "YmUtils/StreamODO.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_YM_CELL
+
+BEGIN_NONAMESPACE
+
+// 先頭のコーナーからの変更点
+enum Variant {
+  // 変更なし
+  kSame,
+  // セル名が異なる．
+  kCellName,
+  // ピン名が異なる．
+  kPinName,
+  // アークの入力ピンが入れ替わっている．
+  kArcSwap,
+  // タイミング情報が足りない．
+  kArcMissing
+};
+
+// タイミング情報の値
+// scale 倍したものをコーナーごとの値とする．
+double
+timing_value(ymuint cell_id,
+	     ymuint timing_id,
+	     ymuint table_id,
+	     ymuint pos,
+	     double scale)
+{
+  return scale * (cell_id * 100 + timing_id * 10 + table_id * 2 + pos + 1);
+}
+
+// タイミング情報を一つ書き出す．
+void
+put_timing(ostream& s,
+	   const char* related_pin,
+	   ymuint cell_id,
+	   ymuint timing_id,
+	   double scale)
+{
+  const char* table_name[] = {
+    "cell_rise", "cell_fall", "rise_transition", "fall_transition"
+  };
+  s << "      timing () {" << endl
+    << "        related_pin : \"" << related_pin << "\" ;" << endl
+    << "        timing_sense : negative_unate ;" << endl;
+  for (ymuint i = 0; i < 4; ++ i) {
+    s << "        " << table_name[i] << " (t1) {" << endl
+      << "          values (\""
+      << timing_value(cell_id, timing_id, i, 0, scale) << ", "
+      << timing_value(cell_id, timing_id, i, 1, scale) << "\") ;" << endl
+      << "        }" << endl;
+  }
+  s << "      }" << endl;
+}
+
+// テスト用の liberty ファイルの内容を作る．
+// INV と NAND2 の2つのセルを持つ．
+string
+make_corner_text(const char* lib_name,
+		 double scale,
+		 Variant variant = kSame)
+{
+  const char* pin_b = (variant == kPinName) ? "C" : "B";
+  ostringstream buf;
+  buf << "library (" << lib_name << ") {" << endl
+      << "  delay_model : table_lookup ;" << endl
+      << "  time_unit : \"1ns\" ;" << endl
+      << "  capacitive_load_unit (1,pf) ;" << endl
+      << "  lu_table_template (t1) {" << endl
+      << "    variable_1 : input_net_transition ;" << endl
+      << "    index_1 (\"0.1, 0.2\") ;" << endl
+      << "  }" << endl
+      << "  cell (" << (variant == kCellName ? "INVX" : "INV") << ") {" << endl
+      << "    area : 1 ;" << endl
+      << "    pin (A) {" << endl
+      << "      direction : input ;" << endl
+      << "      capacitance : 0.01 ;" << endl
+      << "    }" << endl
+      << "    pin (Y) {" << endl
+      << "      direction : output ;" << endl
+      << "      function : \"!A\" ;" << endl;
+  put_timing(buf, "A", 0, 0, scale);
+  buf << "    }" << endl
+      << "  }" << endl
+      << "  cell (NAND2) {" << endl
+      << "    area : 2 ;" << endl
+      << "    pin (A) {" << endl
+      << "      direction : input ;" << endl
+      << "      capacitance : 0.01 ;" << endl
+      << "    }" << endl
+      << "    pin (" << pin_b << ") {" << endl
+      << "      direction : input ;" << endl
+      << "      capacitance : 0.02 ;" << endl
+      << "    }" << endl
+      << "    pin (Y) {" << endl
+      << "      direction : output ;" << endl
+      << "      function : \"!(A*" << pin_b << ")\" ;" << endl;
+  if ( variant == kArcSwap ) {
+    put_timing(buf, pin_b, 1, 0, scale);
+    put_timing(buf, "A", 1, 1, scale);
+  }
+  else {
+    put_timing(buf, "A", 1, 0, scale);
+    if ( variant != kArcMissing ) {
+      put_timing(buf, pin_b, 1, 1, scale);
+    }
+  }
+  buf << "    }" << endl
+      << "  }" << endl
+      << "}" << endl;
+  return buf.str();
+}
+
+// ファイルに書き出す．
+string
+write_lib(const string& name,
+	  const string& text)
+{
+  string filename = ::testing::TempDir() + name;
+  ofstream ofs(filename.c_str());
+  ofs << text;
+  return filename;
+}
+
+// 2つのコーナーのファイルを読み込む．
+const CellLibrary*
+read_corners(Variant variant)
+{
+  vector<string> filename_list(2);
+  filename_list[0] = write_lib("CellDotlibCornerTest_fast.lib",
+			       make_corner_text("fast", 1.0));
+  filename_list[1] = write_lib("CellDotlibCornerTest_slow.lib",
+			       make_corner_text("slow", 2.0, variant));
+  CellDotlibReader read;
+  const CellLibrary* library = read(filename_list);
+  remove(filename_list[0].c_str());
+  remove(filename_list[1].c_str());
+  return library;
+}
+
+// cell_rise の値を取り出す．
+double
+cell_rise(const CellTiming* timing,
+	  ymuint pos)
+{
+  vector<ymuint32> pos_array(1, pos);
+  return timing->cell_rise()->grid_value(pos_array);
+}
+
+// 2つのコーナーのタイミング情報を調べる．
+void
+check_corners(const CellLibrary* library)
+{
+  ASSERT_EQ( 2U, library->corner_num() );
+  EXPECT_EQ( string("fast"), library->corner_name(0) );
+  EXPECT_EQ( string("slow"), library->corner_name(1) );
+  EXPECT_EQ( 2U, library->cell_num() );
+  EXPECT_EQ( 1U, library->lu_table_template_num() );
+
+  const Cell* cell = library->cell("NAND2");
+  ASSERT_TRUE( cell != nullptr );
+  EXPECT_EQ( 3U, cell->pin_num() );
+  EXPECT_EQ( 2U, cell->timing_num() );
+
+  // 入力ごとのアークがそれぞれのファイルの値を持つ．
+  for (ymuint ipos = 0; ipos < 2; ++ ipos) {
+    ASSERT_EQ( 1U, cell->timing_num(ipos, 0, kCellNegaUnate) );
+    const CellTiming* timing0 = cell->timing(ipos, 0, kCellNegaUnate, 0);
+    EXPECT_EQ( timing0, cell->corner_timing(0, ipos, 0, kCellNegaUnate, 0) );
+    const CellTiming* timing1 = cell->corner_timing(1, ipos, 0, kCellNegaUnate, 0);
+    ASSERT_TRUE( timing1 != nullptr );
+    EXPECT_NE( timing0, timing1 );
+    EXPECT_EQ( timing0, cell->corner_timing(0, ipos) );
+    EXPECT_EQ( timing1, cell->corner_timing(1, ipos) );
+    for (ymuint pos = 0; pos < 2; ++ pos) {
+      EXPECT_DOUBLE_EQ( timing_value(1, ipos, 0, pos, 1.0), cell_rise(timing0, pos) );
+      EXPECT_DOUBLE_EQ( timing_value(1, ipos, 0, pos, 2.0), cell_rise(timing1, pos) );
+    }
+
+    // 構造的な情報は共有されている．
+    EXPECT_EQ( timing0->type(), timing1->type() );
+    EXPECT_EQ( timing0->cell_rise()->lut_template(),
+	       timing1->cell_rise()->lut_template() );
+    EXPECT_EQ( library->lu_table_template(0U),
+	       timing1->cell_rise()->lut_template() );
+  }
+}
+
+// ライブラリをダンプした内容を得る．
+string
+dump_str(const CellLibrary* library)
+{
+  ostringstream buf;
+  {
+    StreamODO odo(buf);
+    library->dump(odo);
+  }
+  return buf.str();
+}
+
+END_NONAMESPACE
+
+
+TEST(CellDotlibCornerTest, read)
+{
+  const CellLibrary* library = read_corners(kSame);
+  ASSERT_TRUE( library != nullptr );
+
+  check_corners(library);
+
+  // 論理式とピンは先頭のコーナーのものだけが作られる．
+  const Cell* cell = library->cell("INV");
+  ASSERT_TRUE( cell != nullptr );
+  EXPECT_EQ( 2U, cell->pin_num() );
+  EXPECT_TRUE( cell->pin("A")->is_input() );
+  EXPECT_TRUE( cell->pin("Y")->is_output() );
+  EXPECT_DOUBLE_EQ( timing_value(0, 0, 0, 0, 2.0),
+		    cell_rise(cell->corner_timing(1, 0, 0, kCellNegaUnate, 0), 0) );
+
+  delete library;
+}
+
+TEST(CellDotlibCornerTest, mismatch)
+{
+  Variant variant_list[] = {
+    kCellName, kPinName, kArcSwap, kArcMissing
+  };
+  for (ymuint i = 0; i < 4; ++ i) {
+    const CellLibrary* library = read_corners(variant_list[i]);
+    EXPECT_TRUE( library == nullptr ) << "variant#" << i;
+    delete library;
+  }
+}
+
+TEST(CellDotlibCornerTest, dump)
+{
+  const CellLibrary* library = read_corners(kSame);
+  ASSERT_TRUE( library != nullptr );
+  string dump1 = dump_str(library);
+
+  CellLibrary* library2 = CellLibrary::new_obj();
+  {
+    istringstream buf(dump1);
+    StreamIDO ido(buf);
+    ASSERT_TRUE( library2->restore(ido) );
+  }
+  check_corners(library2);
+  EXPECT_TRUE( dump1 == dump_str(library2) );
+
+  delete library2;
+  delete library;
+}
+
+TEST(CellDotlibCornerTest, dump_mapped)
+{
+  const CellLibrary* library = read_corners(kSame);
+  ASSERT_TRUE( library != nullptr );
+  string dump1 = dump_str(library);
+
+  string filename = ::testing::TempDir() + "CellDotlibCornerTest.mapped";
+  {
+    ofstream ofs(filename.c_str(), ios::binary);
+    ASSERT_TRUE( ofs );
+    StreamODO odo(ofs);
+    library->dump_mapped(odo);
+  }
+
+  CellLibrary* library2 = CellLibrary::new_obj();
+  ASSERT_TRUE( library2->restore_mapped(filename) );
+  check_corners(library2);
+  EXPECT_TRUE( dump1 == dump_str(library2) );
+
+  delete library2;
+  delete library;
+  remove(filename.c_str());
+}
+
+END_NAMESPACE_YM_CELL
@@ -0,0 +1,160 @@
+﻿
+/// @file CellDotlibReaderTest.cc
+/// @brief CellDotlibReaderTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmCell/CellDotlibReader.h"
+#include "YmCell/CellLibrary.h"
+#include "YmUtils/StreamODO.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_YM_CELL
+
+BEGIN_NONAMESPACE
+
+// セルの関数と入力ピン数
+struct FuncDef
+{
+  const char* mFunc;
+  ymuint mInputNum;
+};
+
+const FuncDef kFuncList[] = {
+  { "!A",              1 },
+  { "A",               1 },
+  { "!(A*B)",          2 },
+  { "!(A+B)",          2 },
+  { "A^B",             2 },
+  { "!((A*B)+C)",      3 },
+  { "!((A+B)*C)",      3 },
+  { "(A*B)+(!A*C)",    3 },
+  { "!((A*B)+(C*D))",  4 },
+};
+
+const ymuint kFuncNum = sizeof(kFuncList) / sizeof(FuncDef);
+
+// テスト用の liberty ファイルの内容を作る．
+string
+make_library_text(ymuint cell_num)
+{
+  const char* pin_names = "ABCD";
+  ostringstream buf;
+  buf << "library (test_lib) {" << endl
+      << "  delay_model : table_lookup ;" << endl
+      << "  time_unit : \"1ns\" ;" << endl
+      << "  capacitive_load_unit (1,pf) ;" << endl
+      << "  lu_table_template (t1) {" << endl
+      << "    variable_1 : input_net_transition ;" << endl
+      << "    index_1 (\"0.1, 0.2\") ;" << endl
+      << "  }" << endl;
+  for (ymuint i = 0; i < cell_num; ++ i) {
+    const FuncDef& def = kFuncList[i % kFuncNum];
+    buf << "  cell (C" << i << ") {" << endl
+	<< "    area : " << (i + 1) << " ;" << endl;
+    for (ymuint j = 0; j < def.mInputNum; ++ j) {
+      buf << "    pin (" << pin_names[j] << ") {" << endl
+	  << "      direction : input ;" << endl
+	  << "      capacitance : 0.0" << (j + 1) << " ;" << endl
+	  << "    }" << endl;
+    }
+    buf << "    pin (Y) {" << endl
+	<< "      direction : output ;" << endl
+	<< "      function : \"" << def.mFunc << "\" ;" << endl;
+    for (ymuint j = 0; j < def.mInputNum; ++ j) {
+      buf << "      timing () {" << endl
+	  << "        related_pin : \"" << pin_names[j] << "\" ;" << endl
+	  << "        timing_sense : non_unate ;" << endl
+	  << "        cell_rise (t1) {" << endl
+	  << "          values (\"" << i << ".1, " << i << ".2\") ;" << endl
+	  << "        }" << endl
+	  << "        cell_fall (t1) {" << endl
+	  << "          values (\"" << i << ".3, " << i << ".4\") ;" << endl
+	  << "        }" << endl
+	  << "        rise_transition (t1) {" << endl
+	  << "          values (\"" << i << ".5, " << i << ".6\") ;" << endl
+	  << "        }" << endl
+	  << "        fall_transition (t1) {" << endl
+	  << "          values (\"" << i << ".7, " << i << ".8\") ;" << endl
+	  << "        }" << endl
+	  << "      }" << endl;
+    }
+    buf << "    }" << endl
+	<< "  }" << endl;
+  }
+  buf << "}" << endl;
+  return buf.str();
+}
+
+// ライブラリを読み込んで表示用の文字列とダンプした内容を得る．
+bool
+read_library(const string& filename,
+	     ymuint thread_num,
+	     string& display_str,
+	     string& dump_str,
+	     ymuint& cell_num)
+{
+  CellDotlibReader read(thread_num);
+  const CellLibrary* library = read(filename);
+  if ( library == nullptr ) {
+    return false;
+  }
+
+  cell_num = library->cell_num();
+
+  ostringstream buf1;
+  display_library(buf1, *library);
+  display_str = buf1.str();
+
+  ostringstream buf2;
+  {
+    StreamODO odo(buf2);
+    library->dump(odo);
+  }
+  dump_str = buf2.str();
+
+  delete library;
+  return true;
+}
+
+END_NONAMESPACE
+
+
+TEST(CellDotlibReaderTest, serial_vs_parallel)
+{
+  const ymuint cell_num = 60;
+  string filename = ::testing::TempDir() + "CellDotlibReaderTest.lib";
+  {
+    ofstream ofs(filename.c_str());
+    ASSERT_TRUE( ofs );
+    ofs << make_library_text(cell_num);
+  }
+
+  string display1;
+  string dump1;
+  ymuint cell_num1 = 0;
+  ASSERT_TRUE( read_library(filename, 1, display1, dump1, cell_num1) );
+  EXPECT_EQ( cell_num, cell_num1 );
+
+  ymuint thread_list[] = { 2, 4, 7 };
+  for (ymuint i = 0; i < 3; ++ i) {
+    string display2;
+    string dump2;
+    ymuint cell_num2 = 0;
+    ASSERT_TRUE( read_library(filename, thread_list[i], display2, dump2, cell_num2) );
+    EXPECT_EQ( cell_num1, cell_num2 );
+    EXPECT_EQ( display1, display2 ) << "thread_num = " << thread_list[i];
+    EXPECT_TRUE( dump1 == dump2 ) << "thread_num = " << thread_list[i];
+  }
+
+  remove(filename.c_str());
+}
+
+END_NAMESPACE_YM_CELL
@@ -10,8 +10,10 @@
 
 
 #include "libcomp_nsdef.h"
+#include "LcRepCache.h"
 #include "YmLogic/TvFuncM.h"
 #include "YmUtils/HashMap.h"
+#include <atomic>
 
 
 BEGIN_NAMESPACE_YM_CELL_LIBCOMP
@@ -19,6 +21,9 @@ BEGIN_NAMESPACE_YM_CELL_LIBCOMP
 //////////////////////////////////////////////////////////////////////
 /// @class LcGroupMgr LcGroupMgr.h "LcGroupMgr.h"
 /// @brief セルのグループ分けを行う基底クラス
+///
+/// 代表関数と同位体変換の計算結果は rep_cache に登録され，
+/// 同じシグネチャ関数に対しては再計算を行わない．
 //////////////////////////////////////////////////////////////////////
 class LcGroupMgr
 {
@@ -26,7 +31,9 @@ public:
 
   /// @brief コンストラクタ
   /// @param[in] libcomp 親の LibComp
-  LcGroupMgr(LibComp& libcomp);
+  /// @param[in] rep_cache 代表関数のキャッシュ
+  LcGroupMgr(LibComp& libcomp,
+	     LcRepCache& rep_cache);
 
   /// @brief デストラクタ
   ~LcGroupMgr();
@@ -41,6 +48,23 @@ public:
   void
   clear();
 
+  /// @brief セルのシグネチャ関数を求める．
+  /// @param[in] cell セル
+  /// @param[out] f シグネチャ関数
+  /// @retval true f を求めた．
+  /// @retval false 論理式を持たない出力があるので独立したグループとなる．
+  bool
+  cell_signature(const Cell* cell,
+		 TvFuncM& f);
+
+  /// @brief 代表関数と同位体変換を並列に求めておく．
+  /// @param[in] func_list 関数のリスト
+  /// @param[in] thread_num スレッド数
+  /// @note 結果はキャッシュに登録されて find_group() で用いられる．
+  void
+  prepare(const vector<TvFuncM>& func_list,
+	  ymuint thread_num);
+
   /// @brief セルを追加する．
   /// @param[in] cell セル
   void
@@ -72,6 +96,7 @@ private:
   /// @param[in] f 関数
   /// @param[out] repfunc 代表関数
   /// @param[out] xmap 変換
+  /// @note 複数のスレッドから同時に呼ばれる．
   virtual
   void
   find_repfunc(const TvFuncM& f,
@@ -81,12 +106,42 @@ private:
   /// @brief 同位体変換リストを求める．
   /// @param[in] func 対象の関数
   /// @param[out] idmap_list 同位体変換のリスト
+  /// @note 複数のスレッドから同時に呼ばれる．
   virtual
   void
   find_idmap_list(const TvFuncM& func,
 		  vector<NpnMapM>& idmap_list) = 0;
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief キャッシュを用いて代表関数を求める．
+  /// @param[in] f 関数
+  /// @param[out] repfunc 代表関数
+  /// @param[out] xmap 変換
+  void
+  calc_repfunc(const TvFuncM& f,
+	       TvFuncM& repfunc,
+	       NpnMapM& xmap);
+
+  /// @brief キャッシュを用いて同位体変換リストを求める．
+  /// @param[in] func 対象の関数
+  /// @param[out] idmap_list 同位体変換のリスト
+  void
+  calc_idmap_list(const TvFuncM& func,
+		  vector<NpnMapM>& idmap_list);
+
+  /// @brief prepare() の個々のスレッドで実行される関数
+  /// @param[in] func_list 関数のリスト
+  /// @param[in] next 次に処理する関数の番号
+  void
+  prepare_worker(const vector<TvFuncM>* func_list,
+		 std::atomic<ymuint>* next);
+
+
 protected:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられるクラスメソッド
@@ -108,6 +163,9 @@ private:
   // 親の LibComp
   LibComp& mLibComp;
 
+  // 代表関数のキャッシュ
+  LcRepCache& mRepCache;
+
   // 多出力論理関数をキーとしてグループ番号を保持するハッシュ表
   HashMap<TvFuncM, ymuint> mGroupMap;
 
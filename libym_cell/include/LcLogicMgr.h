@@ -10,7 +10,6 @@
 
 
 #include "LcGroupMgr.h"
-#include "YmLogic/NpnMgr.h"
 
 
 BEGIN_NAMESPACE_YM_CELL_LIBCOMP
@@ -92,9 +91,6 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // NPN同意類を求めるためのオブジェクト
-  NpnMgr mNpnMgr;
-
   // 定義済みの論理グループ
   ymuint32 mLogicGroup[4];
 
@@ -149,6 +149,15 @@ private:
 	    LcPatHandle l_handle,
 	    LcPatHandle r_handle);
 
+  /// @brief (type, l_node, r_node) というノードを返す．
+  /// @param[in] type ノードの種類と枝の極性を表す値
+  /// @param[in] l_node, r_node 左右の子供のノード
+  /// @note なければ新規に作る．
+  LcPatNode*
+  find_node(ymuint32 type,
+	    LcPatNode* l_node,
+	    LcPatNode* r_node);
+
   /// @brief ノードを作る．
   LcPatNode*
   new_node();
@@ -201,6 +210,28 @@ private:
 	   vector<ymuint>& val_list);
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // パタン生成の結果をキャッシュするための関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief パタン生成の手順を符号化する．
+  /// @param[in] pat_list 生成されたパタンのリスト
+  /// @param[out] code 符号化した結果
+  /// @return 符号化できたら true を返す．
+  /// @note mTraceList に記録されたノードの順に生成手順を並べる．
+  bool
+  encode_trace(const vector<LcPatHandle>& pat_list,
+	       vector<ymuint32>& code) const;
+
+  /// @brief encode_trace() で符号化された手順にしたがってパタンを作る．
+  /// @param[in] code 符号化された手順
+  /// @param[out] pat_list 生成されたパタンのリスト
+  void
+  decode_trace(const vector<ymuint32>& code,
+	       vector<LcPatHandle>& pat_list);
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // display() 用の関数
@@ -252,6 +283,10 @@ private:
   // 配列のキーは代表関数番号
   vector<vector<Expr> > mExprList;
 
+  // make_input() と find_node() が返したノードを順に記録したリスト
+  // reg_pat() の中でのみ用いる．
+  vector<LcPatNode*> mTraceList;
+
 };
 
 END_NAMESPACE_YM_CELL_LIBCOMP
@@ -0,0 +1,124 @@
+﻿#ifndef LCREPCACHE_H
+#define LCREPCACHE_H
+
+/// @file LcRepCache.h
+/// @brief LcRepCache のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "libcomp_nsdef.h"
+#include "YmLogic/TvFuncM.h"
+#include "YmLogic/NpnMapM.h"
+#include "YmUtils/HashMap.h"
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_CELL_LIBCOMP
+
+//////////////////////////////////////////////////////////////////////
+/// @class LcRepCache LcRepCache.h "LcRepCache.h"
+/// @brief 代表関数の計算結果を保持するクラス
+///
+/// シグネチャ関数をキーとして代表関数と変換を，代表関数をキーとして
+/// 同位体変換のリストを保持する．
+/// 結果はシグネチャ関数のみで決まるので，ライブラリ(コーナー)が
+/// 異なっても共有できる．
+/// 複数のスレッドから同時に用いることができる．
+//////////////////////////////////////////////////////////////////////
+class LcRepCache
+{
+public:
+
+  /// @brief コンストラクタ
+  LcRepCache();
+
+  /// @brief デストラクタ
+  ~LcRepCache();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 代表関数を探す．
+  /// @param[in] f シグネチャ関数
+  /// @param[out] repfunc 代表関数
+  /// @param[out] xmap f から repfunc への変換
+  /// @retval true 登録されていた．
+  /// @retval false 登録されていなかった．
+  bool
+  find_repfunc(const TvFuncM& f,
+	       TvFuncM& repfunc,
+	       NpnMapM& xmap) const;
+
+  /// @brief 代表関数を登録する．
+  /// @param[in] f シグネチャ関数
+  /// @param[in] repfunc 代表関数
+  /// @param[in] xmap f から repfunc への変換
+  /// @note 既に登録されている時はなにもしない．
+  void
+  reg_repfunc(const TvFuncM& f,
+	      const TvFuncM& repfunc,
+	      const NpnMapM& xmap);
+
+  /// @brief 同位体変換のリストを探す．
+  /// @param[in] repfunc 代表関数
+  /// @param[out] idmap_list 同位体変換のリスト
+  /// @retval true 登録されていた．
+  /// @retval false 登録されていなかった．
+  bool
+  find_idmap_list(const TvFuncM& repfunc,
+		  vector<NpnMapM>& idmap_list) const;
+
+  /// @brief 同位体変換のリストを登録する．
+  /// @param[in] repfunc 代表関数
+  /// @param[in] idmap_list 同位体変換のリスト
+  /// @note 既に登録されている時はなにもしない．
+  void
+  reg_idmap_list(const TvFuncM& repfunc,
+		 const vector<NpnMapM>& idmap_list);
+
+  /// @brief 内容を空にする．
+  void
+  clear();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 代表関数と変換の組
+  struct RepInfo
+  {
+    // 代表関数
+    TvFuncM mRepFunc;
+
+    // 変換
+    NpnMapM mXmap;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 排他制御用のオブジェクト
+  mutable std::mutex mMutex;
+
+  // シグネチャ関数をキーとして代表関数の情報を保持するハッシュ表
+  HashMap<TvFuncM, RepInfo*> mRepMap;
+
+  // 代表関数をキーとして同位体変換のリストを保持するハッシュ表
+  HashMap<TvFuncM, vector<NpnMapM>*> mIdmapMap;
+
+};
+
+END_NAMESPACE_YM_CELL_LIBCOMP
+
+#endif // LCREPCACHE_H
@@ -41,8 +41,11 @@ public:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief セルのグループ化，クラス化を行う．
+  /// @param[in] library 対象のライブラリ
+  /// @param[in] thread_num 代表関数の計算に用いるスレッド数
   void
-  compile(CellLibrary& library);
+  compile(CellLibrary& library,
+	  ymuint thread_num = 1);
 
   /// @brief 論理セルグループの情報を取り出す．
   const LcGroupMgr&
@@ -216,7 +216,11 @@ CellLibrary_init(CellLibraryObject* self,
       return -1;
     }
     CellLibrary* library = CellLibrary::new_obj();
-    library->restore(s);
+    if ( !library->restore(s) ) {
+      delete library;
+      PyErr_SetString(PyExc_ValueError, "Read error");
+      return -1;
+    }
     self->mLibrary = library;
   }
   else {
@@ -98,6 +98,9 @@ CiCell::CiCell(CiLibrary* library,
       mTimingMap[i] = nullptr;
     }
   }
+  mTimingNum = 0;
+  mTimingArray = nullptr;
+  mTimingLoaded = true;
 
   // バス，バンドル関係は未完
 
@@ -314,6 +317,9 @@ CiCell::bundle(const string& name) const
 ymuint
 CiCell::timing_num() const
 {
+  if ( !mTimingLoaded ) {
+    mLibrary->load_timing(mId);
+  }
   return mTimingNum;
 }
 
@@ -322,6 +328,9 @@ CiCell::timing_num() const
 const CellTiming*
 CiCell::timing(ymuint pos) const
 {
+  if ( !mTimingLoaded ) {
+    mLibrary->load_timing(mId);
+  }
   ASSERT_COND( pos < timing_num() );
   return mTimingArray[pos];
 }
@@ -335,6 +344,9 @@ CiCell::timing_num(ymuint ipos,
 		   ymuint opos,
 		   tCellTimingSense sense) const
 {
+  if ( !mTimingLoaded ) {
+    mLibrary->load_timing(mId);
+  }
   ymuint base = (opos * input_num2() + ipos) * 2;
   switch ( sense ) {
   case kCellPosiUnate: base += 0; break;
@@ -360,6 +372,9 @@ CiCell::timing(ymuint ipos,
 	       tCellTimingSense sense,
 	       ymuint pos) const
 {
+  if ( !mTimingLoaded ) {
+    mLibrary->load_timing(mId);
+  }
   ASSERT_COND( pos < timing_num(ipos, opos, sense) );
   ymuint base = (opos * input_num2() + ipos) * 2;
   switch ( sense ) {
@@ -371,6 +386,40 @@ CiCell::timing(ymuint ipos,
   return mTimingMap[base]->mArray[pos];
 }
 
+// @brief コーナーごとのタイミング情報の取得
+// @param[in] corner コーナー番号 ( 0 <= corner < library->corner_num() )
+// @param[in] pos 位置番号 ( 0 <= pos < timing_num() )
+const CellTiming*
+CiCell::corner_timing(ymuint corner,
+		      ymuint pos) const
+{
+  if ( !mTimingLoaded ) {
+    mLibrary->load_timing(mId);
+  }
+  ASSERT_COND( corner < mLibrary->corner_num() );
+  ASSERT_COND( pos < timing_num() );
+  return mTimingArray[corner * mTimingNum + pos];
+}
+
+// @brief 条件に合致するコーナーごとのタイミング情報の取得
+// @param[in] corner コーナー番号 ( 0 <= corner < library->corner_num() )
+// @param[in] ipos 開始ピン番号
+// @param[in] opos 終了ピン番号
+// @param[in] timing_sense タイミング情報の摘要条件
+// @param[in] pos 位置番号 ( 0 <= pos < timing_num(ipos, opos, timing_sense) )
+const CellTiming*
+CiCell::corner_timing(ymuint corner,
+		      ymuint ipos,
+		      ymuint opos,
+		      tCellTimingSense sense,
+		      ymuint pos) const
+{
+  // mTimingMap はコーナー 0 のタイミング情報を持っているので
+  // その番号を用いて対応するタイミング情報を取り出す．
+  const CellTiming* timing0 = timing(ipos, opos, sense, pos);
+  return corner_timing(corner, timing0->id());
+}
+
 // @brief 属している CellGroup を返す．
 const CellGroup*
 CiCell::cell_group() const
@@ -555,6 +604,15 @@ CiCell::clear_preset_var2() const
 // @param[in] s 出力先のストリーム
 void
 CiCell::dump(ODO& s) const
+{
+  dump_header(s);
+  dump_timing(s);
+}
+
+// @brief タイミング情報以外の内容をバイナリダンプする．
+// @param[in] s 出力先のストリーム
+void
+CiCell::dump_header(ODO& s) const
 {
   ymuint8 tid = 0;
   if ( is_logic() ) {
@@ -635,12 +693,26 @@ CiCell::dump(ODO& s) const
   for (ymuint32 itpin = 0; itpin < nit; ++ itpin) {
     internal(itpin)->dump(s);
   }
+}
+
+// @brief タイミング情報をバイナリダンプする．
+// @param[in] s 出力先のストリーム
+void
+CiCell::dump_timing(ODO& s) const
+{
+  ymuint32 ni = input_num();
+  ymuint32 no = output_num();
+  ymuint32 nio = inout_num();
 
   // タイミング情報のダンプ
+  // コーナーごとに同じ数だけ並ぶ．
   ymuint32 nt = timing_num();
   s << nt;
-  for (ymuint i = 0; i < nt; ++ i) {
-    timing(i)->dump(s);
+  ymuint nk = mLibrary->corner_num();
+  for (ymuint k = 0; k < nk; ++ k) {
+    for (ymuint i = 0; i < nt; ++ i) {
+      corner_timing(k, i)->dump(s);
+    }
   }
 
   // ちょっと効率が悪いけど線形探索を用いている．
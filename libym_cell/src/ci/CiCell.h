@@ -14,6 +14,7 @@
 #include "YmUtils/ShString.h"
 #include "YmUtils/Alloc.h"
 #include "YmUtils/ODO.h"
+#include <atomic>
 
 
 BEGIN_NAMESPACE_YM_CELL
@@ -260,6 +261,28 @@ public:
 	 tCellTimingSense sense,
 	 ymuint pos) const;
 
+  /// @brief コーナーごとのタイミング情報の取得
+  /// @param[in] corner コーナー番号 ( 0 <= corner < library->corner_num() )
+  /// @param[in] pos 位置番号 ( 0 <= pos < timing_num() )
+  virtual
+  const CellTiming*
+  corner_timing(ymuint corner,
+		ymuint pos) const;
+
+  /// @brief 条件に合致するコーナーごとのタイミング情報の取得
+  /// @param[in] corner コーナー番号 ( 0 <= corner < library->corner_num() )
+  /// @param[in] ipos 開始ピン番号
+  /// @param[in] opos 終了ピン番号
+  /// @param[in] timing_sense タイミング情報の摘要条件
+  /// @param[in] pos 位置番号 ( 0 <= pos < timing_num(ipos, opos, timing_sense) )
+  virtual
+  const CellTiming*
+  corner_timing(ymuint corner,
+		ymuint ipos,
+		ymuint opos,
+		tCellTimingSense sense,
+		ymuint pos) const;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -409,6 +432,16 @@ public:
   void
   dump(ODO& s) const;
 
+  /// @brief タイミング情報以外の内容をバイナリダンプする．
+  /// @param[in] s 出力先のストリーム
+  void
+  dump_header(ODO& s) const;
+
+  /// @brief タイミング情報をバイナリダンプする．
+  /// @param[in] s 出力先のストリーム
+  void
+  dump_timing(ODO& s) const;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -487,6 +520,11 @@ private:
   // サイズは(入力数＋入出力数) x (出力数+入出力ピン数)  x 2
   CiTimingArray** mTimingMap;
 
+  // タイミング情報を読み込み済みの時 true にするフラグ
+  // CiLibrary::restore_mapped() の時のみ false になりうる．
+  // 複数のスレッドから参照されるので atomic にしておく．
+  std::atomic<bool> mTimingLoaded;
+
   // セルグループ
   const CellGroup* mCellGroup;
 
@@ -32,7 +32,7 @@ CiCellHash::CiCellHash(Alloc& alloc) :
 // @brief デストラクタ
 CiCellHash::~CiCellHash()
 {
-  delete [] mTable;
+  mAlloc.put_memory(sizeof(CiCell*) * mSize, mTable);
 }
 
 // @brief セルを追加する．
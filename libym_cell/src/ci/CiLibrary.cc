@@ -25,6 +25,7 @@
 #include "LcClass.h"
 #include "LcGroup.h"
 #include "LcPatMgr.h"
+#include "YmUtils/StreamODO.h"
 
 
 BEGIN_NAMESPACE_YM_CELL
@@ -55,6 +56,8 @@ CiLibrary::CiLibrary() :
 {
   mTechnology = kCellTechCmos;
   mDelayModel = kCellDelayGenericCmos;
+  mCornerNameArray.resize(1);
+  mCurCorner = 0;
   mLutTemplateNum = 0;
   mLutTemplateArray = nullptr;
   mCellNum = 0;
@@ -63,11 +66,16 @@ CiLibrary::CiLibrary() :
   mGroupArray = nullptr;
   mClassNum = 0;
   mClassArray = nullptr;
+  mMapIDO = nullptr;
+  mTimingPos = 0;
+  mPatPos = 0;
+  mPatLoaded = true;
 }
 
 // @brief デストラクタ
 CiLibrary::~CiLibrary()
 {
+  delete mMapIDO;
 }
 
 // @brief 名前の取得
@@ -177,6 +185,22 @@ CiLibrary::leakage_power_unit() const
   return mLeakagePowerUnit;
 }
 
+// @brief コーナー数の取得
+ymuint
+CiLibrary::corner_num() const
+{
+  return mCornerNameArray.size();
+}
+
+// @brief コーナー名の取得
+// @param[in] corner コーナー番号 ( 0 <= corner < corner_num() )
+string
+CiLibrary::corner_name(ymuint corner) const
+{
+  ASSERT_COND( corner < corner_num() );
+  return mCornerNameArray[corner];
+}
+
 // @brief 遅延テーブルのテンプレート数の取得
 ymuint
 CiLibrary::lu_table_template_num() const
@@ -346,6 +370,7 @@ CiLibrary::simple_latch_class(bool has_clear,
 ymuint
 CiLibrary::pg_pat_num() const
 {
+  load_pat();
   return mPatMgr.pat_num();
 }
 
@@ -354,6 +379,7 @@ CiLibrary::pg_pat_num() const
 const CellPatGraph&
 CiLibrary::pg_pat(ymuint id) const
 {
+  load_pat();
   return mPatMgr.pat(id);
 }
 
@@ -361,6 +387,7 @@ CiLibrary::pg_pat(ymuint id) const
 ymuint
 CiLibrary::pg_max_input() const
 {
+  load_pat();
   return mPatMgr.max_input();
 }
 
@@ -368,6 +395,7 @@ CiLibrary::pg_max_input() const
 ymuint
 CiLibrary::pg_node_num() const
 {
+  load_pat();
   return mPatMgr.node_num();
 }
 
@@ -376,6 +404,7 @@ CiLibrary::pg_node_num() const
 tCellPatType
 CiLibrary::pg_node_type(ymuint id) const
 {
+  load_pat();
   return mPatMgr.node_type(id);
 }
 
@@ -385,6 +414,7 @@ CiLibrary::pg_node_type(ymuint id) const
 ymuint
 CiLibrary::pg_input_id(ymuint id) const
 {
+  load_pat();
   return mPatMgr.input_id(id);
 }
 
@@ -394,6 +424,7 @@ CiLibrary::pg_input_id(ymuint id) const
 ymuint
 CiLibrary::pg_input_node(ymuint input_id) const
 {
+  load_pat();
   return mPatMgr.input_node(input_id);
 }
 
@@ -401,6 +432,7 @@ CiLibrary::pg_input_node(ymuint input_id) const
 ymuint
 CiLibrary::pg_edge_num() const
 {
+  load_pat();
   return mPatMgr.edge_num();
 }
 
@@ -409,6 +441,7 @@ CiLibrary::pg_edge_num() const
 ymuint
 CiLibrary::pg_edge_from(ymuint id) const
 {
+  load_pat();
   return mPatMgr.edge_from(id);
 }
 
@@ -417,6 +450,7 @@ CiLibrary::pg_edge_from(ymuint id) const
 ymuint
 CiLibrary::pg_edge_to(ymuint id) const
 {
+  load_pat();
   return mPatMgr.edge_to(id);
 }
 
@@ -425,6 +459,7 @@ CiLibrary::pg_edge_to(ymuint id) const
 ymuint
 CiLibrary::pg_edge_pos(ymuint id) const
 {
+  load_pat();
   return mPatMgr.edge_pos(id);
 }
 
@@ -433,6 +468,7 @@ CiLibrary::pg_edge_pos(ymuint id) const
 bool
 CiLibrary::pg_edge_inv(ymuint id) const
 {
+  load_pat();
   return mPatMgr.edge_inv(id);
 }
 
@@ -572,6 +608,39 @@ CiLibrary::set_attr(const string& attr_name,
   }
 }
 
+// @brief コーナー数を設定する．
+// @param[in] num コーナー数
+void
+CiLibrary::set_corner_num(ymuint num)
+{
+  // タイミング情報の配列の大きさが変わってしまう．
+  ASSERT_COND( mCellNum == 0 );
+  ASSERT_COND( num > 0 );
+  mCornerNameArray.clear();
+  mCornerNameArray.resize(num);
+  mCurCorner = 0;
+}
+
+// @brief コーナー名を設定する．
+// @param[in] corner コーナー番号 ( 0 <= corner < corner_num() )
+// @param[in] name コーナー名
+void
+CiLibrary::set_corner_name(ymuint corner,
+			   const string& name)
+{
+  ASSERT_COND( corner < corner_num() );
+  mCornerNameArray[corner] = name;
+}
+
+// @brief 以降の new_timing_XXX() でタイミング情報を設定するコーナーを指定する．
+// @param[in] corner コーナー番号 ( 0 <= corner < corner_num() )
+void
+CiLibrary::set_cur_corner(ymuint corner)
+{
+  ASSERT_COND( corner < corner_num() );
+  mCurCorner = corner;
+}
+
 // @brief 遅延テーブルのテンプレート数を設定する．
 void
 CiLibrary::set_lu_table_template_num(ymuint num)
@@ -1122,8 +1191,13 @@ CiLibrary::set_timing_num(ymuint cell_id,
 {
   CiCell* cell = mCellArray[cell_id];
   cell->mTimingNum = timing_num;
-  void* p = mAlloc.get_memory(sizeof(CiTiming*) * timing_num);
-  cell->mTimingArray = new (p) CiTiming*[timing_num];
+  // コーナーごとに timing_num 個ずつ並べる．
+  ymuint n = timing_num * corner_num();
+  void* p = mAlloc.get_memory(sizeof(CiTiming*) * n);
+  cell->mTimingArray = new (p) CiTiming*[n];
+  for (ymuint i = 0; i < n; ++ i) {
+    cell->mTimingArray[i] = nullptr;
+  }
 }
 
 // @brief タイミング情報を作る(ジェネリック遅延モデル)．
@@ -1157,8 +1231,7 @@ CiLibrary::new_timing_generic(ymuint cell_id,
 					     slope_fall,
 					     rise_resistance,
 					     fall_resistance);
-  CiCell* cell = mCellArray[cell_id];
-  cell->mTimingArray[tid] = timing;
+  put_timing(cell_id, tid, timing);
 }
 
 // @brief タイミング情報を作る(折れ線近似)．
@@ -1190,8 +1263,7 @@ CiLibrary::new_timing_piecewise(ymuint cell_id,
 					       slope_fall,
 					       rise_pin_resistance,
 					       fall_pin_resistance);
-  CiCell* cell = mCellArray[cell_id];
-  cell->mTimingArray[tid] = timing;
+  put_timing(cell_id, tid, timing);
 }
 
 // @brief タイミング情報を作る(非線形タイプ1)．
@@ -1217,8 +1289,7 @@ CiLibrary::new_timing_lut1(ymuint cell_id,
 					  cell_fall,
 					  rise_transition,
 					  fall_transition);
-  CiCell* cell = mCellArray[cell_id];
-  cell->mTimingArray[tid] = timing;
+  put_timing(cell_id, tid, timing);
 }
 
 // @brief タイミング情報を作る(非線形タイプ2)．
@@ -1246,8 +1317,7 @@ CiLibrary::new_timing_lut2(ymuint cell_id,
 					  fall_transition,
 					  rise_propagation,
 					  fall_propagation);
-  CiCell* cell = mCellArray[cell_id];
-  cell->mTimingArray[tid] = timing;
+  put_timing(cell_id, tid, timing);
 }
 
 // @brief タイミング情報をセットする．
@@ -1342,13 +1412,14 @@ CiLibrary::new_lut3(const CellLutTemplate* lut_template,
 }
 
 // @brief セルのグループ分けを行う．
+// @param[in] thread_num NPN同値類の計算に用いるスレッド数
 // @note 論理セルのパタングラフも作成する．
 void
-CiLibrary::compile()
+CiLibrary::compile(ymuint thread_num)
 {
   LibComp libcomp;
 
-  libcomp.compile(*this);
+  libcomp.compile(*this, thread_num);
 
   ymuint nc = libcomp.npn_class_num();
   set_class_num(nc);
@@ -1468,10 +1539,153 @@ CiLibrary::add_cell(ymuint id,
   mCellHash.add(cell);
 }
 
-/// @brief 内容をバイナリダンプする．
-/// @param[in] s 出力先のストリーム
+// @brief 現在のコーナーのタイミング情報を設定する．
+// @param[in] cell_id セル番号
+// @param[in] tid タイミングID
+// @param[in] timing タイミング情報
+void
+CiLibrary::put_timing(ymuint cell_id,
+		      ymuint tid,
+		      CiTiming* timing)
+{
+  CiCell* cell = mCellArray[cell_id];
+  ASSERT_COND( tid < cell->mTimingNum );
+  cell->mTimingArray[mCurCorner * cell->mTimingNum + tid] = timing;
+}
+
+BEGIN_NONAMESPACE
+
+// dump() で用いるマジックナンバー
+const ymuint8 kDumpMagic[4] = { 'Y', 'M', 'C', 'D' };
+
+// dump() の形式のバージョン番号
+const ymuint32 kDumpVersion = 1;
+
+END_NONAMESPACE
+
+// @brief 内容をバイナリダンプする．
+// @param[in] s 出力先のストリーム
 void
 CiLibrary::dump(ODO& s) const
+{
+  // マジックナンバーとバージョン番号
+  for (ymuint i = 0; i < 4; ++ i) {
+    s << kDumpMagic[i];
+  }
+  s << kDumpVersion;
+
+  // ライブラリの属性と遅延テーブルのテンプレート
+  dump_header(s);
+
+  // セル数
+  ymuint32 nc = cell_num();
+  s << nc;
+  for (ymuint i = 0; i < nc; ++ i) {
+    // セルの内容をダンプ
+    cell(i)->dump(s);
+  }
+
+  // セルクラスとセルグループ
+  dump_class(s);
+
+  // パタングラフの情報のダンプ
+  // restore_mapped() で読み込んだ場合はまだ読み込まれていないことがある．
+  load_pat();
+  mPatMgr.dump(s);
+}
+
+BEGIN_NONAMESPACE
+
+// dump_mapped() で用いるマジックナンバー
+const ymuint8 kMappedMagic[4] = { 'Y', 'M', 'C', 'L' };
+
+// dump_mapped() の形式のバージョン番号
+const ymuint32 kMappedVersion = 2;
+
+// dump_mapped() の形式のセクション数
+const ymuint32 kMappedSectionNum = 3;
+
+// ヘッダのサイズ
+// マジックナンバー，バージョン番号，セクション数，
+// セクションごとの(位置，サイズ)からなる．
+const ymuint64 kMappedHeaderSize = 4 + 4 + 4 + kMappedSectionNum * (8 + 8);
+
+END_NONAMESPACE
+
+// @brief mmap で読み込むための形式でバイナリダンプする．
+// @param[in] s 出力先のストリーム
+//
+// 以下の3つのセクションからなる．
+// - 0: ライブラリの属性，セル(タイミング情報以外)，セルクラス
+// - 1: セルごとの位置のテーブルとタイミング情報
+// - 2: パタングラフ
+// 位置はすべてファイルの先頭からのバイト数で表す．
+void
+CiLibrary::dump_mapped(ODO& s) const
+{
+  ymuint32 nc = cell_num();
+
+  ostringstream buf0;
+  {
+    StreamODO s0(buf0);
+    dump_header(s0);
+    s0 << nc;
+    for (ymuint i = 0; i < nc; ++ i) {
+      mCellArray[i]->dump_header(s0);
+    }
+    dump_class(s0);
+  }
+
+  // タイミング情報はセルごとに位置を記録しておく．
+  vector<ymuint64> timing_pos(nc);
+  ostringstream tbuf;
+  {
+    StreamODO st(tbuf);
+    ymuint64 base = static_cast<ymuint64>(nc) * 8;
+    for (ymuint i = 0; i < nc; ++ i) {
+      timing_pos[i] = base + tbuf.tellp();
+      mCellArray[i]->dump_timing(st);
+    }
+  }
+
+  load_pat();
+  ostringstream buf2;
+  {
+    StreamODO s2(buf2);
+    mPatMgr.dump(s2);
+  }
+
+  string str0 = buf0.str();
+  string tstr = tbuf.str();
+  string str2 = buf2.str();
+
+  ymuint64 size0 = str0.size();
+  ymuint64 size1 = static_cast<ymuint64>(nc) * 8 + tstr.size();
+  ymuint64 size2 = str2.size();
+  ymuint64 pos0 = kMappedHeaderSize;
+  ymuint64 pos1 = pos0 + size0;
+  ymuint64 pos2 = pos1 + size1;
+
+  for (ymuint i = 0; i < 4; ++ i) {
+    s << kMappedMagic[i];
+  }
+  s << kMappedVersion
+    << kMappedSectionNum
+    << pos0 << size0
+    << pos1 << size1
+    << pos2 << size2;
+
+  s.write(reinterpret_cast<const ymuint8*>(str0.c_str()), size0);
+  for (ymuint i = 0; i < nc; ++ i) {
+    s << timing_pos[i];
+  }
+  s.write(reinterpret_cast<const ymuint8*>(tstr.c_str()), tstr.size());
+  s.write(reinterpret_cast<const ymuint8*>(str2.c_str()), size2);
+}
+
+// @brief ライブラリの属性と LUT テンプレートをダンプする．
+void
+CiLibrary::dump_header(ODO& s) const
 {
   // 名前
   s << name();
@@ -1515,6 +1729,13 @@ CiLibrary::dump(ODO& s) const
   // 電力単位
   s << leakage_power_unit();
 
+  // コーナー
+  ymuint32 nk = corner_num();
+  s << nk;
+  for (ymuint k = 0; k < nk; ++ k) {
+    s << corner_name(k);
+  }
+
   // 遅延テーブルのテンプレート
   ymuint32 ntempl = lu_table_template_num();
   s << ntempl;
@@ -1522,14 +1743,12 @@ CiLibrary::dump(ODO& s) const
     lu_table_template(i)->dump(s);
   }
 
-  // セル数
-  ymuint32 nc = cell_num();
-  s << nc;
-  for (ymuint i = 0; i < nc; ++ i) {
-    // セルの内容をダンプ
-    cell(i)->dump(s);
-  }
+}
 
+// @brief セルクラスとセルグループの情報をダンプする．
+void
+CiLibrary::dump_class(ODO& s) const
+{
   // セルクラスの個数だけダンプする．
   s << mClassNum
     << mGroupNum;
@@ -1557,13 +1776,177 @@ CiLibrary::dump(ODO& s) const
     ymuint32 class_id = mLatchClass[i]->id();
     s << class_id;
   }
+}
 
-  // パタングラフの情報のダンプ
-  mPatMgr.dump(s);
+// @brief バイナリダンプされた内容を読み込む．
+// @param[in] s 入力元のストリーム
+// @retval true 読み込みが成功した．
+// @retval false 形式が異なっていた．
+bool
+CiLibrary::restore(IDO& s)
+{
+  // マジックナンバーとバージョン番号を確かめる．
+  // 異なっていたら何も変更しない．
+  for (ymuint i = 0; i < 4; ++ i) {
+    ymuint8 c = 0;
+    s >> c;
+    if ( c != kDumpMagic[i] ) {
+      return false;
+    }
+  }
+  ymuint32 version = 0;
+  s >> version;
+  if ( version != kDumpVersion ) {
+    return false;
+  }
+
+  // ライブラリの属性と遅延テーブルのテンプレート
+  restore_header(s);
+
+  ymuint32 nc;
+  s >> nc;
+  set_cell_num(nc);
+  for (ymuint cell_id = 0; cell_id < nc; ++ cell_id) {
+    restore_cell(s, cell_id);
+    restore_timing(s, cell_id);
+  }
+
+  // セルクラスとセルグループ
+  restore_class(s);
+
+  // パタングラフの情報の設定
+  mPatMgr.restore(s, mAlloc);
+  mPatLoaded = true;
+
+  return true;
+}
+
+// @brief dump_mapped() で書き出したファイルを読み込む．
+// @param[in] filename ファイル名
+// @retval true 読み込みが成功した．
+// @retval false 読み込みが失敗した．
+bool
+CiLibrary::restore_mapped(const string& filename)
+{
+  MmapIDO* ido = new MmapIDO;
+  if ( !ido->open(filename) ) {
+    delete ido;
+    return false;
+  }
+
+  MmapIDO& s = *ido;
+  if ( s.size() < kMappedHeaderSize ) {
+    delete ido;
+    return false;
+  }
+
+  for (ymuint i = 0; i < 4; ++ i) {
+    ymuint8 c;
+    s >> c;
+    if ( c != kMappedMagic[i] ) {
+      delete ido;
+      return false;
+    }
+  }
+
+  ymuint32 version;
+  ymuint32 nsec;
+  s >> version
+    >> nsec;
+  if ( version != kMappedVersion || nsec != kMappedSectionNum ) {
+    delete ido;
+    return false;
+  }
+
+  ymuint64 pos_array[kMappedSectionNum];
+  for (ymuint i = 0; i < kMappedSectionNum; ++ i) {
+    ymuint64 size;
+    s >> pos_array[i]
+      >> size;
+    if ( pos_array[i] > s.size() || size > s.size() - pos_array[i] ) {
+      delete ido;
+      return false;
+    }
+  }
+
+  // セクション0 はすぐに読み込む．
+  s.seek(pos_array[0]);
+  restore_header(s);
+
+  ymuint32 nc;
+  s >> nc;
+  set_cell_num(nc);
+  for (ymuint cell_id = 0; cell_id < nc; ++ cell_id) {
+    restore_cell(s, cell_id);
+    mCellArray[cell_id]->mTimingLoaded = false;
+  }
+
+  restore_class(s);
+
+  // 残りのセクションは位置だけ覚えておく．
+  delete mMapIDO;
+  mMapIDO = ido;
+  mTimingPos = pos_array[1];
+  mPatPos = pos_array[2];
+  mPatLoaded = false;
+
+  return true;
 }
 
+// @brief セルのタイミング情報を読み込む．
+// @param[in] cell_id セル番号
+// @note restore_mapped() で読み込んだ場合のみ意味を持つ．
 void
-CiLibrary::restore(IDO& s)
+CiLibrary::load_timing(ymuint cell_id)
+{
+  CiCell* cell = mCellArray[cell_id];
+  if ( cell->mTimingLoaded ) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mLoadMutex);
+  if ( cell->mTimingLoaded ) {
+    // 待っている間に他のスレッドが読み込んだ．
+    return;
+  }
+
+  ASSERT_COND( mMapIDO != nullptr );
+
+  MmapIDO& s = *mMapIDO;
+  s.seek(mTimingPos + static_cast<ymuint64>(cell_id) * 8);
+  ymuint64 pos;
+  s >> pos;
+  s.seek(mTimingPos + pos);
+  restore_timing(s, cell_id);
+  cell->mTimingLoaded = true;
+}
+
+// @brief パタングラフの情報を読み込む．
+// @note restore_mapped() で読み込んだ場合のみ意味を持つ．
+void
+CiLibrary::load_pat() const
+{
+  if ( mPatLoaded ) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mLoadMutex);
+  if ( mPatLoaded ) {
+    // 待っている間に他のスレッドが読み込んだ．
+    return;
+  }
+
+  ASSERT_COND( mMapIDO != nullptr );
+
+  CiLibrary* self = const_cast<CiLibrary*>(this);
+  self->mMapIDO->seek(mPatPos);
+  self->mPatMgr.restore(*self->mMapIDO, self->mAlloc);
+  self->mPatLoaded = true;
+}
+
+// @brief ライブラリの属性と LUT テンプレートを読み込む．
+void
+CiLibrary::restore_header(IDO& s)
 {
   string name;
   s >> name;
@@ -1633,335 +2016,367 @@ CiLibrary::restore(IDO& s)
 
   set_attr("leakage_power_unit", leakage_power_unit);
 
+  ymuint32 nk;
+  s >> nk;
+  set_corner_num(nk);
+  for (ymuint k = 0; k < nk; ++ k) {
+    string corner_name;
+    s >> corner_name;
+    set_corner_name(k, corner_name);
+  }
+
   ymuint32 lut_num;
   s >> lut_num;
   set_lu_table_template_num(lut_num);
   for (ymuint i = 0; i < lut_num; ++ i) {
     restore_lut_template(s, i);
   }
+}
 
-  ymuint32 nc;
-  s >> nc;
-  set_cell_num(nc);
+// @brief セルの情報(タイミング情報以外)を読み込む．
+// @param[in] cell_id セル番号
+void
+CiLibrary::restore_cell(IDO& s,
+			ymuint cell_id)
+{
+  ymuint8 type;
+  string name;
+  CellArea area;
+  ymuint32 ni;
+  ymuint32 no;
+  ymuint32 nio;
+  ymuint32 nit;
+  ymuint32 nbus;
+  ymuint32 nbundle;
+  s >> type
+    >> name
+    >> area
+    >> ni
+    >> no
+    >> nio
+    >> nit
+    >> nbus
+    >> nbundle;
+
+  ymuint no2 = no + nio;
+  vector<bool> has_logic(no2);
+  vector<Expr> logic_array(no2);
+  vector<Expr> tristate_array(no2);
+  for (ymuint opos = 0; opos < no2; ++ opos) {
+    bool tmp;
+    s >> tmp
+      >> logic_array[opos]
+      >> tristate_array[opos];
+    has_logic[opos] = tmp;
+  }
+
+  switch ( type ) {
+  case 0: // kLogic
+    new_logic_cell(cell_id, name, area,
+		   ni, no, nio, nbus, nbundle,
+		   has_logic,
+		   logic_array,
+		   tristate_array);
+    break;
 
-  for (ymuint cell_id = 0; cell_id < nc; ++ cell_id) {
-    ymuint8 type;
-    string name;
-    CellArea area;
-    ymuint32 ni;
-    ymuint32 no;
-    ymuint32 nio;
-    ymuint32 nit;
-    ymuint32 nbus;
-    ymuint32 nbundle;
-    s >> type
-      >> name
-      >> area
-      >> ni
-      >> no
-      >> nio
-      >> nit
-      >> nbus
-      >> nbundle;
-
-    ymuint no2 = no + nio;
-    vector<bool> has_logic(no2);
-    vector<Expr> logic_array(no2);
-    vector<Expr> tristate_array(no2);
-    for (ymuint opos = 0; opos < no2; ++ opos) {
-      bool tmp;
-      s >> tmp
-	>> logic_array[opos]
-	>> tristate_array[opos];
-      has_logic[opos] = tmp;
+  case 1: // kFF
+    {
+      Expr next_state;
+      Expr clocked_on;
+      Expr clocked_on_also;
+      Expr clear;
+      Expr preset;
+      ymuint8 clear_preset_var1;
+      ymuint8 clear_preset_var2;
+      s >> next_state
+	>> clocked_on
+	>> clocked_on_also
+	>> clear
+	>> preset
+	>> clear_preset_var1
+	>> clear_preset_var2;
+      new_ff_cell(cell_id, name, area,
+		  ni, no, nio, nbus, nbundle,
+		  has_logic,
+		  logic_array,
+		  tristate_array,
+		  next_state,
+		  clocked_on, clocked_on_also,
+		  clear, preset,
+		  clear_preset_var1,
+		  clear_preset_var2);
     }
+    break;
 
-    switch ( type ) {
-    case 0: // kLogic
-      new_logic_cell(cell_id, name, area,
+  case 2: // kLatch
+    {
+      Expr data_in;
+      Expr enable;
+      Expr enable_also;
+      Expr clear;
+      Expr preset;
+      ymuint8 clear_preset_var1;
+      ymuint8 clear_preset_var2;
+      s >> data_in
+	>> enable
+	>> enable_also
+	>> clear
+	>> preset
+	>> clear_preset_var1
+	>> clear_preset_var2;
+      new_latch_cell(cell_id, name, area,
 		     ni, no, nio, nbus, nbundle,
 		     has_logic,
 		     logic_array,
-		     tristate_array);
+		     tristate_array,
+		     data_in,
+		     enable, enable_also,
+		     clear, preset,
+		     clear_preset_var1,
+		     clear_preset_var2);
+    }
+    break;
+
+  case 3: // kFSM
+    new_fsm_cell(cell_id, name, area,
+		 ni, no, nio, nit, nbus, nbundle,
+		 has_logic,
+		 logic_array,
+		 tristate_array);
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+
+  // 入力ピンの設定
+  for (ymuint iid = 0; iid < ni; ++ iid) {
+    string name;
+    ymuint32 pin_id;
+    CellCapacitance cap;
+    CellCapacitance r_cap;
+    CellCapacitance f_cap;
+    s >> name
+      >> pin_id
+      >> cap
+      >> r_cap
+      >> f_cap;
+    new_cell_input(cell_id, pin_id, iid, name, cap, r_cap, f_cap);
+  }
+
+  // 出力ピンの設定
+  for (ymuint oid = 0; oid < no; ++ oid) {
+    string name;
+    ymuint32 pin_id;
+    CellCapacitance max_f;
+    CellCapacitance min_f;
+    CellCapacitance max_c;
+    CellCapacitance min_c;
+    CellTime max_t;
+    CellTime min_t;
+    s >> name
+      >> pin_id
+      >> max_f
+      >> min_f
+      >> max_c
+      >> min_c
+      >> max_t
+      >> min_t;
+    new_cell_output(cell_id, pin_id, oid, name,
+		    has_logic[oid], logic_array[oid],
+		    tristate_array[oid],
+		    max_f, min_f,
+		    max_c, min_c,
+		    max_t, min_t);
+  }
+
+  // 入出力ピンの設定
+  for (ymuint ioid = 0; ioid < nio; ++ ioid) {
+    string name;
+    ymuint32 pin_id;
+    CellCapacitance cap;
+    CellCapacitance r_cap;
+    CellCapacitance f_cap;
+    CellCapacitance max_f;
+    CellCapacitance min_f;
+    CellCapacitance max_c;
+    CellCapacitance min_c;
+    CellTime max_t;
+    CellTime min_t;
+    s >> name
+      >> pin_id
+      >> cap
+      >> r_cap
+      >> f_cap
+      >> max_f
+      >> min_f
+      >> max_c
+      >> min_c
+      >> max_t
+      >> min_t;
+    new_cell_inout(cell_id, pin_id, ioid + ni, ioid + no, name,
+		   has_logic[ioid], logic_array[ioid],
+		   tristate_array[ioid],
+		   cap, r_cap, f_cap,
+		   max_f, min_f,
+		   max_c, min_c,
+		   max_t, min_t);
+  }
+
+  // 内部ピンの設定
+  for (ymuint itid = 0; itid < nit; ++ itid) {
+    string name;
+    ymuint32 pin_id;
+    s >> name
+      >> pin_id;
+    new_cell_internal(cell_id, pin_id, itid, name);
+  }
+}
+
+// @brief セルのタイミング情報を読み込む．
+// @param[in] cell_id セル番号
+void
+CiLibrary::restore_timing(IDO& s,
+			  ymuint cell_id)
+{
+  const CiCell* cell = mCellArray[cell_id];
+  ymuint ni = cell->input_num();
+  ymuint no = cell->output_num();
+  ymuint nio = cell->inout_num();
+
+  // タイミング情報の生成
+  // コーナーごとに nt 個ずつ並んでいる．
+  ymuint32 nt;
+  s >> nt;
+  set_timing_num(cell_id, nt);
+  ymuint nk = corner_num();
+  for (ymuint i = 0; i < nt * nk; ++ i) {
+    ymuint tid = i % nt;
+    set_cur_corner(i / nt);
+    ymuint8 ttype;
+    ymuint8 tmp;
+    Expr cond;
+    s >> ttype
+      >> tmp
+      >> cond;
+    tCellTimingType timing_type = static_cast<tCellTimingType>(tmp);
+
+    switch ( ttype ) {
+    case 0:
+      {
+	CellTime i_r;
+	CellTime i_f;
+	CellTime s_r;
+	CellTime s_f;
+	CellResistance r_r;
+	CellResistance f_r;
+	s >> i_r
+	  >> i_f
+	  >> s_r
+	  >> s_f
+	  >> r_r
+	  >> f_r;
+	new_timing_generic(cell_id, tid,
+			   timing_type,
+			   cond,
+			   i_r, i_f,
+			   s_r, s_f,
+			   r_r, f_r);
+      }
       break;
 
-    case 1: // kFF
+    case 1:
       {
-	Expr next_state;
-	Expr clocked_on;
-	Expr clocked_on_also;
-	Expr clear;
-	Expr preset;
-	ymuint8 clear_preset_var1;
-	ymuint8 clear_preset_var2;
-	s >> next_state
-	  >> clocked_on
-	  >> clocked_on_also
-	  >> clear
-	  >> preset
-	  >> clear_preset_var1
-	  >> clear_preset_var2;
-	new_ff_cell(cell_id, name, area,
-		    ni, no, nio, nbus, nbundle,
-		    has_logic,
-		    logic_array,
-		    tristate_array,
-		    next_state,
-		    clocked_on, clocked_on_also,
-		    clear, preset,
-		    clear_preset_var1,
-		    clear_preset_var2);
+#if 0
+	CellTime i_r;
+	CellTime i_f;
+	CellTime s_r;
+	CellTime s_f;
+	s >> i_r
+	  >> i_f
+	  >> s_r
+	  >> s_f;
+	new_timing_piecewise(cell_id, tid,
+			     timing_type,
+			     cond,
+			     i_r, i_f,
+			     s_r, s_f);
+#endif
       }
       break;
 
-    case 2: // kLatch
+    case 2:
       {
-	Expr data_in;
-	Expr enable;
-	Expr enable_also;
-	Expr clear;
-	Expr preset;
-	ymuint8 clear_preset_var1;
-	ymuint8 clear_preset_var2;
-	s >> data_in
-	  >> enable
-	  >> enable_also
-	  >> clear
-	  >> preset
-	  >> clear_preset_var1
-	  >> clear_preset_var2;
-	new_latch_cell(cell_id, name, area,
-		       ni, no, nio, nbus, nbundle,
-		       has_logic,
-		       logic_array,
-		       tristate_array,
-		       data_in,
-		       enable, enable_also,
-		       clear, preset,
-		       clear_preset_var1,
-		       clear_preset_var2);
+	CellLut* cell_rise = restore_lut(s);
+	CellLut* cell_fall = restore_lut(s);
+	CellLut* rise_transition = restore_lut(s);
+	CellLut* fall_transition = restore_lut(s);
+	new_timing_lut1(cell_id, tid,
+			timing_type,
+			cond,
+			cell_rise,
+			cell_fall,
+			rise_transition,
+			fall_transition);
       }
       break;
 
-    case 3: // kFSM
-      new_fsm_cell(cell_id, name, area,
-		   ni, no, nio, nit, nbus, nbundle,
-		   has_logic,
-		   logic_array,
-		   tristate_array);
+    case 3:
+      {
+	CellLut* rise_transition = restore_lut(s);
+	CellLut* fall_transition = restore_lut(s);
+	CellLut* rise_propagation = restore_lut(s);
+	CellLut* fall_propagation = restore_lut(s);
+	new_timing_lut1(cell_id, tid,
+			timing_type,
+			cond,
+			rise_transition,
+			fall_transition,
+			rise_propagation,
+			fall_propagation);
+      }
       break;
 
     default:
       ASSERT_NOT_REACHED;
       break;
     }
-
-    // 入力ピンの設定
-    for (ymuint iid = 0; iid < ni; ++ iid) {
-      string name;
-      ymuint32 pin_id;
-      CellCapacitance cap;
-      CellCapacitance r_cap;
-      CellCapacitance f_cap;
-      s >> name
-	>> pin_id
-	>> cap
-	>> r_cap
-	>> f_cap;
-      new_cell_input(cell_id, pin_id, iid, name, cap, r_cap, f_cap);
-    }
-
-    // 出力ピンの設定
-    for (ymuint oid = 0; oid < no; ++ oid) {
-      string name;
-      ymuint32 pin_id;
-      CellCapacitance max_f;
-      CellCapacitance min_f;
-      CellCapacitance max_c;
-      CellCapacitance min_c;
-      CellTime max_t;
-      CellTime min_t;
-      s >> name
-	>> pin_id
-	>> max_f
-	>> min_f
-	>> max_c
-	>> min_c
-	>> max_t
-	>> min_t;
-      new_cell_output(cell_id, pin_id, oid, name,
-		      has_logic[oid], logic_array[oid],
-		      tristate_array[oid],
-		      max_f, min_f,
-		      max_c, min_c,
-		      max_t, min_t);
-    }
-
-    // 入出力ピンの設定
-    for (ymuint ioid = 0; ioid < nio; ++ ioid) {
-      string name;
-      ymuint32 pin_id;
-      CellCapacitance cap;
-      CellCapacitance r_cap;
-      CellCapacitance f_cap;
-      CellCapacitance max_f;
-      CellCapacitance min_f;
-      CellCapacitance max_c;
-      CellCapacitance min_c;
-      CellTime max_t;
-      CellTime min_t;
-      s >> name
-	>> pin_id
-	>> cap
-	>> r_cap
-	>> f_cap
-	>> max_f
-	>> min_f
-	>> max_c
-	>> min_c
-	>> max_t
-	>> min_t;
-      new_cell_inout(cell_id, pin_id, ioid + ni, ioid + no, name,
-		     has_logic[ioid], logic_array[ioid],
-		     tristate_array[ioid],
-		     cap, r_cap, f_cap,
-		     max_f, min_f,
-		     max_c, min_c,
-		     max_t, min_t);
-    }
-
-    // 内部ピンの設定
-    for (ymuint itid = 0; itid < nit; ++ itid) {
-      string name;
-      ymuint32 pin_id;
-      s >> name
-	>> pin_id;
-      new_cell_internal(cell_id, pin_id, itid, name);
-    }
-
-    // タイミング情報の生成
-    ymuint32 nt;
-    s >> nt;
-    set_timing_num(cell_id, nt);
-    for (ymuint tid = 0; tid < nt; ++ tid) {
-      ymuint8 ttype;
-      ymuint8 tmp;
-      Expr cond;
-      s >> ttype
-	>> tmp
-	>> cond;
-      tCellTimingType timing_type = static_cast<tCellTimingType>(tmp);
-
-      switch ( ttype ) {
-      case 0:
-	{
-	  CellTime i_r;
-	  CellTime i_f;
-	  CellTime s_r;
-	  CellTime s_f;
-	  CellResistance r_r;
-	  CellResistance f_r;
-	  s >> i_r
-	    >> i_f
-	    >> s_r
-	    >> s_f
-	    >> r_r
-	    >> f_r;
-	  new_timing_generic(cell_id, tid,
-			     timing_type,
-			     cond,
-			     i_r, i_f,
-			     s_r, s_f,
-			     r_r, f_r);
-	}
-	break;
-
-      case 1:
-	{
-#if 0
-	  CellTime i_r;
-	  CellTime i_f;
-	  CellTime s_r;
-	  CellTime s_f;
-	  s >> i_r
-	    >> i_f
-	    >> s_r
-	    >> s_f;
-	  new_timing_piecewise(cell_id, tid,
-			       timing_type,
-			       cond,
-			       i_r, i_f,
-			       s_r, s_f);
-#endif
-	}
-	break;
-
-      case 2:
-	{
-	  CellLut* cell_rise = restore_lut(s);
-	  CellLut* cell_fall = restore_lut(s);
-	  CellLut* rise_transition = restore_lut(s);
-	  CellLut* fall_transition = restore_lut(s);
-	  new_timing_lut1(cell_id, tid,
-			  timing_type,
-			  cond,
-			  cell_rise,
-			  cell_fall,
-			  rise_transition,
-			  fall_transition);
-	}
-	break;
-
-      case 3:
-	{
-	  CellLut* rise_transition = restore_lut(s);
-	  CellLut* fall_transition = restore_lut(s);
-	  CellLut* rise_propagation = restore_lut(s);
-	  CellLut* fall_propagation = restore_lut(s);
-	  new_timing_lut1(cell_id, tid,
-			  timing_type,
-			  cond,
-			  rise_transition,
-			  fall_transition,
-			  rise_propagation,
-			  fall_propagation);
-	}
-	break;
-
-      default:
-	ASSERT_NOT_REACHED;
-	break;
+  }
+  set_cur_corner(0);
+
+  // タイミング情報の設定
+  for (ymuint ipos = 0; ipos < ni + nio; ++ ipos) {
+    for (ymuint opos = 0; opos < no + nio; ++ opos) {
+      ymuint32 np;
+      s >> np;
+      vector<ymuint> tid_list;
+      tid_list.reserve(np);
+      for (ymuint i = 0; i < np; ++ i) {
+	ymuint32 tid;
+	s >> tid;
+	tid_list.push_back(tid);
       }
-    }
-
-    // タイミング情報の設定
-    for (ymuint ipos = 0; ipos < ni + nio; ++ ipos) {
-      for (ymuint opos = 0; opos < no + nio; ++ opos) {
-	ymuint32 np;
-	s >> np;
-	vector<ymuint> tid_list;
-	tid_list.reserve(np);
-	for (ymuint i = 0; i < np; ++ i) {
-	  ymuint32 tid;
-	  s >> tid;
-	  tid_list.push_back(tid);
-	}
-	set_timing(cell_id, ipos, opos, kCellPosiUnate, tid_list);
-
-	ymuint32 nn;
-	s >> nn;
-	tid_list.clear();
-	tid_list.reserve(nn);
-	for (ymuint i = 0; i < nn; ++ i) {
-	  ymuint32 tid;
-	  s >> tid;
-	  tid_list.push_back(tid);
-	}
-	set_timing(cell_id, ipos, opos, kCellNegaUnate, tid_list);
+      set_timing(cell_id, ipos, opos, kCellPosiUnate, tid_list);
+
+      ymuint32 nn;
+      s >> nn;
+      tid_list.clear();
+      tid_list.reserve(nn);
+      for (ymuint i = 0; i < nn; ++ i) {
+	ymuint32 tid;
+	s >> tid;
+	tid_list.push_back(tid);
       }
+      set_timing(cell_id, ipos, opos, kCellNegaUnate, tid_list);
     }
   }
+}
 
+// @brief セルクラスとセルグループの情報を読み込む．
+void
+CiLibrary::restore_class(IDO& s)
+{
   // セルクラス数とグループ数の取得
   ymuint32 ncc;
   ymuint32 ng;
@@ -1996,9 +2411,6 @@ CiLibrary::restore(IDO& s)
     s >> class_id;
     mLatchClass[i] = &mClassArray[class_id];
   }
-
-  // パタングラフの情報の設定
-  mPatMgr.restore(s, mAlloc);
 }
 
 // @brief ピンの登録
@@ -18,11 +18,14 @@
 #include "YmCell/CellPin.h"
 #include "YmUtils/SimpleAlloc.h"
 #include "YmUtils/ShString.h"
+#include "YmUtils/MmapIDO.h"
 #include "YmLogic/Expr.h"
 #include "CiLutHash.h"
 #include "CiCellHash.h"
 #include "CiPinHash.h"
 #include "CiPatMgr.h"
+#include <atomic>
+#include <mutex>
 
 
 BEGIN_NAMESPACE_YM_CELL
@@ -136,6 +139,17 @@ public:
   string
   leakage_power_unit() const;
 
+  /// @brief コーナー数の取得
+  virtual
+  ymuint
+  corner_num() const;
+
+  /// @brief コーナー名の取得
+  /// @param[in] corner コーナー番号 ( 0 <= corner < corner_num() )
+  virtual
+  string
+  corner_name(ymuint corner) const;
+
   /// @brief 遅延テーブルのテンプレート数の取得
   virtual
   ymuint
@@ -356,10 +370,27 @@ public:
 
   /// @brief バイナリダンプされた内容を読み込む．
   /// @param[in] s 入力元のストリーム
+  /// @retval true 読み込みが成功した．
+  /// @retval false 形式が異なっていた．
+  /// @note false の場合は内容を変更しない．
   virtual
-  void
+  bool
   restore(IDO& s);
 
+  /// @brief mmap で読み込むための形式でバイナリダンプする．
+  /// @param[in] s 出力先のストリーム
+  virtual
+  void
+  dump_mapped(ODO& s) const;
+
+  /// @brief dump_mapped() で書き出したファイルを読み込む．
+  /// @param[in] filename ファイル名
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  virtual
+  bool
+  restore_mapped(const string& filename);
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -407,6 +438,26 @@ public:
   set_attr(const string& attr_name,
 	   const string& value);
 
+  /// @brief コーナー数を設定する．
+  /// @param[in] num コーナー数
+  virtual
+  void
+  set_corner_num(ymuint num);
+
+  /// @brief コーナー名を設定する．
+  /// @param[in] corner コーナー番号 ( 0 <= corner < corner_num() )
+  /// @param[in] name コーナー名
+  virtual
+  void
+  set_corner_name(ymuint corner,
+		  const string& name);
+
+  /// @brief 以降の new_timing_XXX() でタイミング情報を設定するコーナーを指定する．
+  /// @param[in] corner コーナー番号 ( 0 <= corner < corner_num() )
+  virtual
+  void
+  set_cur_corner(ymuint corner);
+
   /// @brief 遅延テーブルのテンプレート数を設定する．
   virtual
   void
@@ -852,10 +903,11 @@ public:
 	   const vector<double>& index_array3 = vector<double>());
 
   /// @brief セルのグループ分けを行う．
+  /// @param[in] thread_num NPN同値類の計算に用いるスレッド数
   /// @note 論理セルのパタングラフも作成する．
   virtual
   void
-  compile();
+  compile(ymuint thread_num = 1);
 
 
 private:
@@ -882,6 +934,15 @@ private:
   add_cell(ymuint id,
 	   CiCell* cell);
 
+  /// @brief 現在のコーナーのタイミング情報を設定する．
+  /// @param[in] cell_id セル番号
+  /// @param[in] tid タイミングID
+  /// @param[in] timing タイミング情報
+  void
+  put_timing(ymuint cell_id,
+	     ymuint tid,
+	     CiTiming* timing);
+
   /// @brief LUT テンプレートを読み込む．
   void
   restore_lut_template(IDO& s,
@@ -892,6 +953,58 @@ private:
   restore_lut(IDO& s);
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 遅延読み込み用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief セルのタイミング情報を読み込む．
+  /// @param[in] cell_id セル番号
+  /// @note restore_mapped() で読み込んだ場合のみ意味を持つ．
+  /// @note 複数のスレッドから同時に呼んでもよい．
+  void
+  load_timing(ymuint cell_id);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // dump/restore の下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ライブラリの属性と LUT テンプレートをダンプする．
+  void
+  dump_header(ODO& s) const;
+
+  /// @brief セルクラスとセルグループの情報をダンプする．
+  void
+  dump_class(ODO& s) const;
+
+  /// @brief ライブラリの属性と LUT テンプレートを読み込む．
+  void
+  restore_header(IDO& s);
+
+  /// @brief セルの情報(タイミング情報以外)を読み込む．
+  /// @param[in] cell_id セル番号
+  void
+  restore_cell(IDO& s,
+	       ymuint cell_id);
+
+  /// @brief セルのタイミング情報を読み込む．
+  /// @param[in] cell_id セル番号
+  void
+  restore_timing(IDO& s,
+		 ymuint cell_id);
+
+  /// @brief セルクラスとセルグループの情報を読み込む．
+  void
+  restore_class(IDO& s);
+
+  /// @brief パタングラフの情報を読み込む．
+  /// @note restore_mapped() で読み込んだ場合のみ意味を持つ．
+  void
+  load_pat() const;
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // ピンハッシュ用の関数
@@ -960,6 +1073,13 @@ private:
   // 遅延モデル
   tCellDelayModel mDelayModel;
 
+  // コーナー名の配列
+  // 要素数がコーナー数となる．
+  vector<string> mCornerNameArray;
+
+  // new_timing_XXX() の対象のコーナー
+  ymuint32 mCurCorner;
+
   // 遅延テンプレート数
   ymuint32 mLutTemplateNum;
 
@@ -1005,6 +1125,23 @@ private:
   // パタングラフを管理するクラス
   CiPatMgr mPatMgr;
 
+  // restore_mapped() で読み込んだファイル
+  MmapIDO* mMapIDO;
+
+  // タイミング情報のセクションの位置
+  ymuint64 mTimingPos;
+
+  // パタングラフのセクションの位置
+  ymuint64 mPatPos;
+
+  // パタングラフを読み込み済みの時 true にするフラグ
+  std::atomic<bool> mPatLoaded;
+
+  // 遅延読み込みを排他的に行うための mutex
+  // mMapIDO の読み出し位置と mAlloc を共有しているので
+  // タイミング情報とパタングラフの読み込みはすべてこれで保護する．
+  mutable std::mutex mLoadMutex;
+
 };
 
 END_NAMESPACE_YM_CELL
@@ -35,6 +35,7 @@
 #include "YmLogic/Expr.h"
 #include "YmLogic/TvFunc.h"
 #include "YmUtils/MsgMgr.h"
+#include <thread>
 
 
 BEGIN_NAMESPACE_YM_DOTLIB
@@ -315,6 +316,171 @@ gen_pin(CellLibrary* library,
   }
 }
 
+// タイミング情報の本体を生成する．
+// 生成できなかった時は false を返す．
+bool
+gen_timing_data(CellLibrary* library,
+		const DotlibTiming& timing_info,
+		const DotlibNode* dt_timing,
+		ymuint cell_id,
+		ymuint timing_id,
+		tCellTimingType timing_type,
+		const Expr& cond)
+{
+  switch ( library->delay_model() ) {
+  case kCellDelayGenericCmos:
+    {
+      CellTime intrinsic_rise(timing_info.intrinsic_rise()->float_value());
+      CellTime intrinsic_fall(timing_info.intrinsic_fall()->float_value());
+      CellTime slope_rise(timing_info.slope_rise()->float_value());
+      CellTime slope_fall(timing_info.slope_fall()->float_value());
+      CellResistance rise_res(timing_info.rise_resistance()->float_value());
+      CellResistance fall_res(timing_info.fall_resistance()->float_value());
+      library->new_timing_generic(cell_id, timing_id,
+				  timing_type, cond,
+				  intrinsic_rise, intrinsic_fall,
+				  slope_rise, slope_fall,
+				  rise_res, fall_res);
+    }
+    break;
+
+  case kCellDelayTableLookup:
+    {
+      const DotlibNode* cr_node = timing_info.cell_rise();
+      const DotlibNode* rt_node = timing_info.rise_transition();
+      const DotlibNode* rp_node = timing_info.rise_propagation();
+
+      CellLut* cr_lut = nullptr;
+      CellLut* rt_lut = nullptr;
+      CellLut* rp_lut = nullptr;
+      if ( cr_node != nullptr ) {
+	if ( rp_node != nullptr ) {
+	  MsgMgr::put_msg(__FILE__, __LINE__,
+			  dt_timing->loc(),
+			  kMsgError,
+			  "DOTLIB_PARSER",
+			  "cell_rise and rise_propagation are mutually exclusive.");
+	  return false;
+	}
+	if ( rt_node == nullptr ) {
+	  MsgMgr::put_msg(__FILE__, __LINE__,
+			  dt_timing->loc(),
+			  kMsgError,
+			  "DOTLIB_PARSER",
+			  "rise_transition is missing.");
+	  return false;
+	}
+	cr_lut = gen_lut(library, cr_node);
+	rt_lut = gen_lut(library, rt_node);
+      }
+      else if ( rp_node != nullptr ) {
+	if ( rt_node == nullptr ) {
+	  MsgMgr::put_msg(__FILE__, __LINE__,
+			  dt_timing->loc(),
+			  kMsgError,
+			  "DOTLIB_PARSER",
+			  "rise_transition is missing.");
+	  return false;
+	}
+	rt_lut = gen_lut(library, rt_node);
+	rp_lut = gen_lut(library, rp_node);
+      }
+      else if ( rt_node != nullptr ) {
+	MsgMgr::put_msg(__FILE__, __LINE__,
+			dt_timing->loc(),
+			kMsgError,
+			"DOTLIB_PARSER",
+			"Either cell_rise or rise_propagation should be present.");
+	return false;
+      }
+
+      const DotlibNode* cf_node = timing_info.cell_fall();
+      const DotlibNode* ft_node = timing_info.fall_transition();
+      const DotlibNode* fp_node = timing_info.fall_propagation();
+
+      CellLut* cf_lut = nullptr;
+      CellLut* ft_lut = nullptr;
+      CellLut* fp_lut = nullptr;
+      if ( cf_node != nullptr ) {
+	if ( fp_node != nullptr ) {
+	  MsgMgr::put_msg(__FILE__, __LINE__,
+			  dt_timing->loc(),
+			  kMsgError,
+			  "DOTLIB_PARSER",
+			  "cell_fall and fall_propagation are mutually exclusive.");
+	  return false;
+	}
+	if ( ft_node == nullptr ) {
+	  MsgMgr::put_msg(__FILE__, __LINE__,
+			  dt_timing->loc(),
+			  kMsgError,
+			  "DOTLIB_PARSER",
+			  "fall_transition is missing.");
+	  return false;
+	}
+	cf_lut = gen_lut(library, cf_node);
+	ft_lut = gen_lut(library, ft_node);
+      }
+      else if ( fp_node != nullptr ) {
+	if ( ft_node == nullptr ) {
+	  MsgMgr::put_msg(__FILE__, __LINE__,
+			  dt_timing->loc(),
+			  kMsgError,
+			  "DOTLIB_PARSER",
+			  "fall_transition is missing.");
+	  return false;
+	}
+	ft_lut = gen_lut(library, ft_node);
+	fp_lut = gen_lut(library, fp_node);
+      }
+      else if ( ft_node != nullptr ) {
+	MsgMgr::put_msg(__FILE__, __LINE__,
+			dt_timing->loc(),
+			kMsgError,
+			"DOTLIB_PARSER",
+			"Either cell_fall or fall_propagation should be present.");
+	return false;
+      }
+
+      if ( cr_lut != nullptr || cf_lut != nullptr ) {
+	if ( fp_lut != nullptr ) {
+	  MsgMgr::put_msg(__FILE__, __LINE__,
+			  dt_timing->loc(),
+			  kMsgError,
+			  "DOTLIB_PARSER",
+			  "cell_rise and fall_propagation are mutually exclusive.");
+	  return false;
+	}
+	library->new_timing_lut1(cell_id, timing_id,
+				 timing_type, cond,
+				 cr_lut, cf_lut,
+				 rt_lut, ft_lut);
+      }
+      else { // cr_lut == nullptr && cf_lut == nullptr
+	library->new_timing_lut2(cell_id, timing_id,
+				 timing_type, cond,
+				 rt_lut, ft_lut,
+				 rp_lut, fp_lut);
+      }
+    }
+    break;
+
+  case kCellDelayPiecewiseCmos:
+    // 未実装
+    break;
+
+  case kCellDelayCmos2:
+    // 未実装
+    break;
+
+  case kCellDelayDcm:
+    // 未実装
+    break;
+  }
+
+  return true;
+}
+
 // タイミング情報を生成する．
 void
 gen_timing(CellLibrary* library,
@@ -342,155 +508,9 @@ gen_timing(CellLibrary* library,
       cond = Expr::make_one();
     }
 
-    switch ( library->delay_model() ) {
-    case kCellDelayGenericCmos:
-      {
-	CellTime intrinsic_rise(timing_info.intrinsic_rise()->float_value());
-	CellTime intrinsic_fall(timing_info.intrinsic_fall()->float_value());
-	CellTime slope_rise(timing_info.slope_rise()->float_value());
-	CellTime slope_fall(timing_info.slope_fall()->float_value());
-	CellResistance rise_res(timing_info.rise_resistance()->float_value());
-	CellResistance fall_res(timing_info.fall_resistance()->float_value());
-	library->new_timing_generic(cell_id, timing_id,
-				    timing_type, cond,
-				    intrinsic_rise, intrinsic_fall,
-				    slope_rise, slope_fall,
-				    rise_res, fall_res);
-      }
-      break;
-
-    case kCellDelayTableLookup:
-      {
-	const DotlibNode* cr_node = timing_info.cell_rise();
-	const DotlibNode* rt_node = timing_info.rise_transition();
-	const DotlibNode* rp_node = timing_info.rise_propagation();
-
-	CellLut* cr_lut = nullptr;
-	CellLut* rt_lut = nullptr;
-	CellLut* rp_lut = nullptr;
-	if ( cr_node != nullptr ) {
-	  if ( rp_node != nullptr ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__,
-			    dt_timing->loc(),
-			    kMsgError,
-			    "DOTLIB_PARSER",
-			    "cell_rise and rise_propagation are mutually exclusive.");
-	    continue;
-	  }
-	  if ( rt_node == nullptr ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__,
-			    dt_timing->loc(),
-			    kMsgError,
-			    "DOTLIB_PARSER",
-			    "rise_transition is missing.");
-	    continue;
-	  }
-	  cr_lut = gen_lut(library, cr_node);
-	  rt_lut = gen_lut(library, rt_node);
-	}
-	else if ( rp_node != nullptr ) {
-	  if ( rt_node == nullptr ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__,
-			    dt_timing->loc(),
-			    kMsgError,
-			    "DOTLIB_PARSER",
-			    "rise_transition is missing.");
-	    continue;
-	  }
-	  rt_lut = gen_lut(library, rt_node);
-	  rp_lut = gen_lut(library, rp_node);
-	}
-	else if ( rt_node != nullptr ) {
-	  MsgMgr::put_msg(__FILE__, __LINE__,
-			  dt_timing->loc(),
-			  kMsgError,
-			  "DOTLIB_PARSER",
-			  "Either cell_rise or rise_propagation should be present.");
-	  continue;
-	}
-
-	const DotlibNode* cf_node = timing_info.cell_fall();
-	const DotlibNode* ft_node = timing_info.fall_transition();
-	const DotlibNode* fp_node = timing_info.fall_propagation();
-
-	CellLut* cf_lut = nullptr;
-	CellLut* ft_lut = nullptr;
-	CellLut* fp_lut = nullptr;
-	if ( cf_node != nullptr ) {
-	  if ( fp_node != nullptr ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__,
-			    dt_timing->loc(),
-			    kMsgError,
-			    "DOTLIB_PARSER",
-			    "cell_fall and fall_propagation are mutually exclusive.");
-	    continue;
-	  }
-	  if ( ft_node == nullptr ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__,
-			    dt_timing->loc(),
-			    kMsgError,
-			    "DOTLIB_PARSER",
-			    "fall_transition is missing.");
-	    continue;
-	  }
-	  cf_lut = gen_lut(library, cf_node);
-	  ft_lut = gen_lut(library, ft_node);
-	}
-	else if ( fp_node != nullptr ) {
-	  if ( ft_node == nullptr ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__,
-			    dt_timing->loc(),
-			    kMsgError,
-			    "DOTLIB_PARSER",
-			    "fall_transition is missing.");
-	    continue;
-	  }
-	  ft_lut = gen_lut(library, ft_node);
-	  fp_lut = gen_lut(library, fp_node);
-	}
-	else if ( ft_node != nullptr ) {
-	  MsgMgr::put_msg(__FILE__, __LINE__,
-			  dt_timing->loc(),
-			  kMsgError,
-			  "DOTLIB_PARSER",
-			  "Either cell_fall or fall_propagation should be present.");
-	  continue;
-	}
-
-	if ( cr_lut != nullptr || cf_lut != nullptr ) {
-	  if ( fp_lut != nullptr ) {
-	    MsgMgr::put_msg(__FILE__, __LINE__,
-			    dt_timing->loc(),
-			    kMsgError,
-			    "DOTLIB_PARSER",
-			    "cell_rise and fall_propagation are mutually exclusive.");
-	    continue;
-	  }
-	  library->new_timing_lut1(cell_id, timing_id,
-				   timing_type, cond,
-				   cr_lut, cf_lut,
-				   rt_lut, ft_lut);
-	}
-	else { // cr_lut == nullptr && cf_lut == nullptr
-	  library->new_timing_lut2(cell_id, timing_id,
-				   timing_type, cond,
-				   rt_lut, ft_lut,
-				   rp_lut, fp_lut);
-	}
-      }
-      break;
-
-    case kCellDelayPiecewiseCmos:
-      // 未実装
-      break;
-
-    case kCellDelayCmos2:
-      // 未実装
-      break;
-
-    case kCellDelayDcm:
-      // 未実装
-      break;
+    if ( !gen_timing_data(library, timing_info, dt_timing,
+			  cell_id, timing_id, timing_type, cond) ) {
+      continue;
     }
 
     tCellTimingSense timing_sense = timing_info.timing_sense();
@@ -548,10 +568,15 @@ gen_timing(CellLibrary* library,
 
 // @brief DotlibNode から CellLibrary を生成する．
 // @param[in] dt_library ライブラリを表すパース木のルート
+// @param[in] corner_num コーナー数
+// @param[in] thread_num セルの分類に用いるスレッド数
 // @return 生成したライブラリを返す．
 // @note 生成が失敗したら nullptr を返す．
-const CellLibrary*
-gen_library(const DotlibNode* dt_library)
+// @note ここではコーナー 0 のタイミング情報のみを設定する．
+CellLibrary*
+gen_library(const DotlibNode* dt_library,
+	    ymuint corner_num,
+	    ymuint thread_num)
 {
   DotlibLibrary library_info;
 
@@ -563,6 +588,11 @@ gen_library(const DotlibNode* dt_library)
   CellLibrary* library = CellLibrary::new_obj();
   library->set_name(library_info.name());
 
+  // コーナーの設定
+  // コーナー名はライブラリ名とする．
+  library->set_corner_num(corner_num);
+  library->set_corner_name(0, library_info.name());
+
   // 'technology' の設定
   library->set_technology(library_info.technology());
 
@@ -985,11 +1015,259 @@ gen_library(const DotlibNode* dt_library)
     ASSERT_COND( timing_id == nt );
   }
 
-  library->compile();
+  library->compile(thread_num);
 
   return library;
 }
 
+// @brief コーナーのピンがコーナー 0 のセルのピンと一致するか調べる．
+// @param[in] cell コーナー 0 のセル
+// @param[in] pin_info コーナーのピン情報
+// @param[out] pin_num ピン数を加算する変数
+bool
+check_corner_pin(const Cell* cell,
+		 const DotlibPin& pin_info,
+		 ymuint& pin_num)
+{
+  for (ymuint i = 0; i < pin_info.num(); ++ i) {
+    const CellPin* pin = cell->pin((const char*)pin_info.name(i));
+    if ( pin == nullptr ) {
+      return false;
+    }
+    bool match = false;
+    switch ( pin_info.direction() ) {
+    case DotlibPin::kInput:    match = pin->is_input(); break;
+    case DotlibPin::kOutput:   match = pin->is_output(); break;
+    case DotlibPin::kInout:    match = pin->is_inout(); break;
+    case DotlibPin::kInternal: match = pin->is_internal(); break;
+    default: break;
+    }
+    if ( !match ) {
+      return false;
+    }
+    ++ pin_num;
+  }
+  return true;
+}
+
+// @brief コーナーのタイミング情報を入力ピンと極性ごとに振り分ける．
+// @param[in] cell コーナー 0 のセル
+// @param[in] timing_info コーナーのタイミング情報
+// @param[in] timing_id タイミング番号
+// @param[out] tid_list (入力番号 * 2 + 極性) ごとのタイミング番号のリスト
+// @note gen_timing() と同じ規則で振り分ける．
+bool
+split_corner_arc(const Cell* cell,
+		 const DotlibTiming& timing_info,
+		 ymuint timing_id,
+		 vector<vector<ymuint> >& tid_list)
+{
+  if ( timing_info.related_pin() == nullptr ) {
+    return false;
+  }
+  string tmp_str = timing_info.related_pin()->string_value();
+  vector<string> pin_name_list;
+  split(tmp_str, pin_name_list);
+  for (vector<string>::const_iterator p = pin_name_list.begin();
+       p != pin_name_list.end(); ++ p) {
+    const CellPin* ipin = cell->pin(*p);
+    if ( ipin == nullptr || !(ipin->is_input() || ipin->is_inout()) ) {
+      return false;
+    }
+    ymuint iid = ipin->input_id();
+    switch ( timing_info.timing_sense() ) {
+    case kCellPosiUnate:
+      tid_list[iid * 2 + 0].push_back(timing_id);
+      break;
+
+    case kCellNegaUnate:
+      tid_list[iid * 2 + 1].push_back(timing_id);
+      break;
+
+    case kCellNonUnate:
+      tid_list[iid * 2 + 0].push_back(timing_id);
+      tid_list[iid * 2 + 1].push_back(timing_id);
+      break;
+
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief コーナーのアークがコーナー 0 のアークと一致するか調べる．
+// @param[in] cell コーナー 0 のセル
+// @param[in] pin_info タイミング情報を持つ出力ピンの情報
+// @param[in] tid_list split_corner_arc() で作ったリスト
+// @note コーナー 0 で登録されているアークだけを比較する．
+// 論理的に依存しない入力のアークはコーナー 0 で捨てられているので
+// 比較できない．
+bool
+check_corner_arc(const Cell* cell,
+		 const DotlibPin& pin_info,
+		 const vector<vector<ymuint> >& tid_list)
+{
+  ymuint ni2 = cell->input_num2();
+  for (ymuint i = 0; i < pin_info.num(); ++ i) {
+    const CellPin* opin = cell->pin((const char*)pin_info.name(i));
+    if ( !(opin->is_output() || opin->is_inout()) ) {
+      // 入力ピンのタイミング情報(setup/hold など)はアークを持たない．
+      continue;
+    }
+    ymuint oid = opin->output_id();
+    for (ymuint iid = 0; iid < ni2; ++ iid) {
+      for (ymuint s = 0; s < 2; ++ s) {
+	tCellTimingSense sense = (s == 0) ? kCellPosiUnate : kCellNegaUnate;
+	ymuint n = cell->timing_num(iid, oid, sense);
+	if ( n == 0 ) {
+	  continue;
+	}
+	const vector<ymuint>& tid_list1 = tid_list[iid * 2 + s];
+	if ( tid_list1.size() != n ) {
+	  return false;
+	}
+	for (ymuint pos = 0; pos < n; ++ pos) {
+	  if ( cell->timing(iid, oid, sense, pos)->id() != tid_list1[pos] ) {
+	    return false;
+	  }
+	}
+      }
+    }
+  }
+  return true;
+}
+
+// @brief DotlibNode からコーナーのタイミング情報を読み込む．
+// @param[in] library 対象のライブラリ
+// @param[in] corner コーナー番号
+// @param[in] dt_library ライブラリを表すパース木のルート
+// @return 読み込みが成功したら true を返す．
+// @note セル，ピン，タイミング情報の構成はコーナー 0 と同じでなければならない．
+// タイミングの条件式などの構造的な情報はコーナー 0 のものを共有する．
+bool
+gen_corner(CellLibrary* library,
+	   ymuint corner,
+	   const DotlibNode* dt_library)
+{
+  DotlibLibrary library_info;
+  if ( !library_info.set_data(dt_library) ) {
+    return false;
+  }
+
+  if ( library_info.delay_model() != library->delay_model() ) {
+    MsgMgr::put_msg(__FILE__, __LINE__,
+		    dt_library->loc(),
+		    kMsgError,
+		    "DOTLIB_PARSER",
+		    "delay_model differs from that of the first corner.");
+    return false;
+  }
+
+  const list<const DotlibNode*>& dt_cell_list = library_info.cell_list();
+  if ( dt_cell_list.size() != library->cell_num() ) {
+    MsgMgr::put_msg(__FILE__, __LINE__,
+		    dt_library->loc(),
+		    kMsgError,
+		    "DOTLIB_PARSER",
+		    "The number of cells differs from that of the first corner.");
+    return false;
+  }
+
+  library->set_corner_name(corner, library_info.name());
+  library->set_cur_corner(corner);
+
+  bool error = false;
+  for (list<const DotlibNode*>::const_iterator p = dt_cell_list.begin();
+       p != dt_cell_list.end() && !error; ++ p) {
+    const DotlibNode* dt_cell = *p;
+
+    DotlibCell cell_info;
+    if ( !cell_info.set_data(dt_cell) ) {
+      error = true;
+      break;
+    }
+
+    const Cell* cell = library->cell((const char*)cell_info.name());
+    if ( cell == nullptr ) {
+      ostringstream buf;
+      buf << cell_info.name()
+	  << ": No such cell in the first corner.";
+      MsgMgr::put_msg(__FILE__, __LINE__,
+		      dt_cell->loc(),
+		      kMsgError,
+		      "DOTLIB_PARSER",
+		      buf.str());
+      error = true;
+      break;
+    }
+    ymuint cell_id = cell->id();
+    ymuint nt = cell->timing_num();
+    ymuint ni2 = cell->input_num2();
+
+    // タイミング情報の番号はピンとタイミングの出現順で決まる．
+    ymuint timing_id = 0;
+    ymuint pin_num = 0;
+    const list<const DotlibNode*>& dt_pin_list = cell_info.pin_list();
+    for (list<const DotlibNode*>::const_iterator q = dt_pin_list.begin();
+	 q != dt_pin_list.end() && !error; ++ q) {
+      DotlibPin pin_info;
+      if ( !pin_info.set_data(*q) ||
+	   !check_corner_pin(cell, pin_info, pin_num) ) {
+	error = true;
+	break;
+      }
+      vector<vector<ymuint> > tid_list(ni2 * 2);
+      const list<const DotlibNode*>& timing_list = pin_info.timing_list();
+      for (list<const DotlibNode*>::const_iterator r = timing_list.begin();
+	   r != timing_list.end(); ++ r, ++ timing_id) {
+	const DotlibNode* dt_timing = *r;
+	DotlibTiming timing_info;
+	if ( timing_id >= nt || !timing_info.set_data(dt_timing) ) {
+	  error = true;
+	  break;
+	}
+	const CellTiming* timing0 = cell->timing(timing_id);
+	if ( timing0 == nullptr ) {
+	  // コーナー 0 でも作られていない．
+	  continue;
+	}
+	if ( timing_info.timing_type() != timing0->type() ||
+	     !split_corner_arc(cell, timing_info, timing_id, tid_list) ) {
+	  error = true;
+	  break;
+	}
+	if ( !gen_timing_data(library, timing_info, dt_timing,
+			      cell_id, timing_id,
+			      timing0->type(), timing0->timing_cond()) ) {
+	  error = true;
+	  break;
+	}
+      }
+      if ( !error && !check_corner_arc(cell, pin_info, tid_list) ) {
+	error = true;
+      }
+    }
+    if ( !error && (timing_id != nt || pin_num != cell->pin_num()) ) {
+      error = true;
+    }
+    if ( error ) {
+      ostringstream buf;
+      buf << cell_info.name()
+	  << ": Pins or timing information do not match the first corner.";
+      MsgMgr::put_msg(__FILE__, __LINE__,
+		      dt_cell->loc(),
+		      kMsgError,
+		      "DOTLIB_PARSER",
+		      buf.str());
+    }
+  }
+
+  library->set_cur_corner(0);
+
+  return !error;
+}
+
 END_NONAMESPACE
 
 END_NAMESPACE_YM_DOTLIB
@@ -1002,8 +1280,16 @@ BEGIN_NAMESPACE_YM_CELL
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-CellDotlibReader::CellDotlibReader()
+// @param[in] thread_num cell group の読み込みとセルの分類に用いるスレッド数
+CellDotlibReader::CellDotlibReader(ymuint thread_num)
 {
+  if ( thread_num == 0 ) {
+    thread_num = std::thread::hardware_concurrency();
+    if ( thread_num == 0 ) {
+      thread_num = 1;
+    }
+  }
+  mThreadNum = thread_num;
 }
 
 // @brief デストラクタ
@@ -1022,10 +1308,10 @@ CellDotlibReader::operator()(const string& filename)
 
   DotlibMgr mgr;
   DotlibParser parser;
-  if ( !parser.read_file(filename, mgr, false) ) {
+  if ( !parser.read_file(filename, mgr, false, true, mThreadNum) ) {
     return nullptr;
   }
-  return gen_library(mgr.root_node());
+  return gen_library(mgr.root_node(), 1, mThreadNum);
 }
 
 // @brief dotlib ファイルを読み込む
@@ -1039,10 +1325,53 @@ CellDotlibReader::operator()(const char* filename)
 
   DotlibMgr mgr;
   DotlibParser parser;
-  if ( !parser.read_file(filename, mgr, false) ) {
+  if ( !parser.read_file(filename, mgr, false, true, mThreadNum) ) {
+    return nullptr;
+  }
+  return gen_library(mgr.root_node(), 1, mThreadNum);
+}
+
+// @brief 複数のコーナーの dotlib ファイルを読み込んでライブラリを生成する．
+// @param[in] filename_list コーナーごとのファイル名のリスト
+// @return 読み込んで作成したセルライブラリを返す．
+// @note エラーが起きたら nullptr を返す．
+const CellLibrary*
+CellDotlibReader::operator()(const vector<string>& filename_list)
+{
+  using namespace nsDotlib;
+
+  ymuint nk = filename_list.size();
+  if ( nk == 0 ) {
     return nullptr;
   }
-  return gen_library(mgr.root_node());
+
+  // 最初のコーナーからすべての構造的な情報を作る．
+  CellLibrary* library = nullptr;
+  {
+    DotlibMgr mgr;
+    DotlibParser parser;
+    if ( !parser.read_file(filename_list[0], mgr, false, true, mThreadNum) ) {
+      return nullptr;
+    }
+    library = gen_library(mgr.root_node(), nk, mThreadNum);
+    if ( library == nullptr ) {
+      return nullptr;
+    }
+  }
+
+  // 残りのコーナーはタイミング情報のみを読み込む．
+  // パース木はコーナーごとに作って捨てる．
+  for (ymuint k = 1; k < nk; ++ k) {
+    DotlibMgr mgr;
+    DotlibParser parser;
+    if ( !parser.read_file(filename_list[k], mgr, false, true, mThreadNum) ||
+	 !gen_corner(library, k, mgr.root_node()) ) {
+      delete library;
+      return nullptr;
+    }
+  }
+
+  return library;
 }
 
 END_NAMESPACE_YM_CELL
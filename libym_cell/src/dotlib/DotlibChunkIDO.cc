@@ -0,0 +1,110 @@
+﻿
+/// @file DotlibChunkIDO.cc
+/// @brief DotlibChunkIDO の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "DotlibChunkIDO.h"
+
+
+BEGIN_NAMESPACE_YM_DOTLIB
+
+//////////////////////////////////////////////////////////////////////
+// クラス DotlibChunkIDO
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] data 先頭のアドレス
+// @param[in] size data のサイズ
+// @param[in] file_info ファイル情報
+DotlibChunkIDO::DotlibChunkIDO(const ymuint8* data,
+			       ymuint64 size,
+			       const FileInfo& file_info) :
+  mFileInfo(file_info),
+  mData(data),
+  mSize(size),
+  mPos(0),
+  mBlankList(nullptr),
+  mBlankPos(0)
+{
+}
+
+// @brief デストラクタ
+DotlibChunkIDO::~DotlibChunkIDO()
+{
+}
+
+// @brief 読み出し可能なら true を返す．
+bool
+DotlibChunkIDO::is_ready() const
+{
+  return mData != nullptr;
+}
+
+// @brief オープン中のファイル情報を得る．
+const FileInfo&
+DotlibChunkIDO::file_info() const
+{
+  return mFileInfo;
+}
+
+// @brief 現在のファイル情報を書き換える．
+// @param[in] file_info 新しいファイル情報
+void
+DotlibChunkIDO::set_file_info(const FileInfo& file_info)
+{
+  mFileInfo = file_info;
+}
+
+// @brief データを読み込む．
+// @param[in] buff 読み込んだデータを格納する領域の先頭アドレス．
+// @param[in] n 読み込むデータサイズ
+// @return 実際に読み込んだ量を返す．
+ymint64
+DotlibChunkIDO::read(ymuint8* buff,
+		     ymuint64 n)
+{
+  if ( mPos + n > mSize ) {
+    n = mSize - mPos;
+  }
+  memcpy(buff, mData + mPos, n);
+
+  if ( mBlankList != nullptr ) {
+    ymuint64 end = mPos + n;
+    while ( mBlankPos < mBlankList->size() ) {
+      const DotlibChunk& chunk = (*mBlankList)[mBlankPos];
+      if ( chunk.mBegin >= end ) {
+	break;
+      }
+      ymuint64 b = chunk.mBegin > mPos ? chunk.mBegin : mPos;
+      ymuint64 e = chunk.mEnd < end ? chunk.mEnd : end;
+      for (ymuint64 i = b; i < e; ++ i) {
+	ymuint8 c = buff[i - mPos];
+	if ( c != '\n' && c != '\r' ) {
+	  buff[i - mPos] = ' ';
+	}
+      }
+      if ( chunk.mEnd > end ) {
+	break;
+      }
+      ++ mBlankPos;
+    }
+  }
+
+  mPos += n;
+  return n;
+}
+
+// @brief 空白に置き換える範囲のリストを設定する．
+// @param[in] blank_list 範囲のリスト
+void
+DotlibChunkIDO::set_blank_list(const vector<DotlibChunk>& blank_list)
+{
+  mBlankList = &blank_list;
+  mBlankPos = 0;
+}
+
+END_NAMESPACE_YM_DOTLIB
@@ -0,0 +1,117 @@
+﻿#ifndef DOTLIBCHUNKIDO_H
+#define DOTLIBCHUNKIDO_H
+
+/// @file DotlibChunkIDO.h
+/// @brief DotlibChunkIDO のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "dotlib_int.h"
+#include "DotlibSplitter.h"
+#include "YmUtils/IDO.h"
+#include "YmUtils/FileInfo.h"
+
+
+BEGIN_NAMESPACE_YM_DOTLIB
+
+//////////////////////////////////////////////////////////////////////
+/// @class DotlibChunkIDO DotlibChunkIDO.h "DotlibChunkIDO.h"
+/// @brief メモリ上のファイルの一部を読み出す IDO
+///
+/// 位置情報を元のファイルと合わせるためにファイル情報は外から与える．
+/// set_blank_list() で指定された範囲は改行文字以外を空白に置き換えて
+/// 読み出す．
+//////////////////////////////////////////////////////////////////////
+class DotlibChunkIDO :
+  public IDO
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] data 先頭のアドレス
+  /// @param[in] size data のサイズ
+  /// @param[in] file_info ファイル情報
+  DotlibChunkIDO(const ymuint8* data,
+		 ymuint64 size,
+		 const FileInfo& file_info);
+
+  /// @brief デストラクタ
+  virtual
+  ~DotlibChunkIDO();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // IDO の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み出し可能なら true を返す．
+  virtual
+  bool
+  is_ready() const;
+
+  /// @brief オープン中のファイル情報を得る．
+  virtual
+  const FileInfo&
+  file_info() const;
+
+  /// @brief 現在のファイル情報を書き換える．
+  /// @param[in] file_info 新しいファイル情報
+  virtual
+  void
+  set_file_info(const FileInfo& file_info);
+
+  /// @brief データを読み込む．
+  /// @param[in] buff 読み込んだデータを格納する領域の先頭アドレス．
+  /// @param[in] n 読み込むデータサイズ
+  /// @return 実際に読み込んだ量を返す．
+  virtual
+  ymint64
+  read(ymuint8* buff,
+       ymuint64 n);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // DotlibChunkIDO の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 空白に置き換える範囲のリストを設定する．
+  /// @param[in] blank_list 範囲のリスト
+  /// @note blank_list は先頭の位置の昇順に並んでいなければならない．
+  /// @note blank_list はこのオブジェクトより長く存在しなければならない．
+  void
+  set_blank_list(const vector<DotlibChunk>& blank_list);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイル情報
+  FileInfo mFileInfo;
+
+  // 先頭のアドレス
+  const ymuint8* mData;
+
+  // サイズ
+  ymuint64 mSize;
+
+  // 現在の読み出し位置
+  ymuint64 mPos;
+
+  // 空白に置き換える範囲のリスト
+  const vector<DotlibChunk>* mBlankList;
+
+  // mBlankList 中の次に調べる位置
+  ymuint32 mBlankPos;
+
+};
+
+END_NAMESPACE_YM_DOTLIB
+
+#endif // DOTLIBCHUNKIDO_H
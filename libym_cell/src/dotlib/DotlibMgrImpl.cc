@@ -28,6 +28,7 @@ DotlibMgrImpl::DotlibMgrImpl() :
 // @brief デストラクタ
 DotlibMgrImpl::~DotlibMgrImpl()
 {
+  clear();
 }
 
 // @brief 初期化する．
@@ -37,6 +38,14 @@ DotlibMgrImpl::clear()
 {
   mAlloc.destroy();
 
+  for (vector<DotlibMgrImpl*>::iterator p = mSubMgrList.begin();
+       p != mSubMgrList.end(); ++ p) {
+    delete *p;
+  }
+  mSubMgrList.clear();
+
+  mRoot = nullptr;
+
   mIntNum = 0;
   mFloatNum = 0;
   mStrNum = 0;
@@ -249,6 +258,26 @@ DotlibMgrImpl::root_node() const
   return mRoot;
 }
 
+// @brief 他のオブジェクトが生成したノードを引き取る．
+// @param[in] src 対象のオブジェクト
+// @note src はこのオブジェクトが破壊される時に一緒に破壊される．
+void
+DotlibMgrImpl::adopt(DotlibMgrImpl* src)
+{
+  mSubMgrList.push_back(src);
+
+  mIntNum += src->mIntNum;
+  mFloatNum += src->mFloatNum;
+  mStrNum += src->mStrNum;
+  mVectNum += src->mVectNum;
+  mVectElemSize += src->mVectElemSize;
+  mOprNum += src->mOprNum;
+  mNotNum += src->mNotNum;
+  mListNum += src->mListNum;
+  mGroupNum += src->mGroupNum;
+  mAttrNum += src->mAttrNum;
+}
+
 // @brief 使用メモリ量の一覧を出力する．
 // @param[in] s 出力先のストリーム
 void
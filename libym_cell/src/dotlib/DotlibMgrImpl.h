@@ -142,6 +142,12 @@ public:
   const DotlibNode*
   root_node() const;
 
+  /// @brief 他のオブジェクトが生成したノードを引き取る．
+  /// @param[in] src 対象のオブジェクト
+  /// @note src はこのオブジェクトが破壊される時に一緒に破壊される．
+  void
+  adopt(DotlibMgrImpl* src);
+
   /// @brief 使用メモリ量の一覧を出力する．
   /// @param[in] s 出力先のストリーム
   void
@@ -159,6 +165,9 @@ private:
   // 根のノード
   DotlibNode* mRoot;
 
+  // adopt() で引き取ったオブジェクトのリスト
+  vector<DotlibMgrImpl*> mSubMgrList;
+
   // 個々の要素の使用数
   ymuint32 mIntNum;
   ymuint32 mFloatNum;
@@ -270,6 +270,17 @@ DotlibNodeImpl::add_attr(DotlibAttr* attr)
   ASSERT_NOT_REACHED;
 }
 
+// @brief attribute のリストを置き換える．
+// @param[in] attr_list 属性のリスト
+// @note is_group() = true の時のみ意味を持つ．
+void
+DotlibNodeImpl::set_attr_list(const vector<DotlibAttr*>& attr_list)
+{
+  dump(cout);
+  cout << endl;
+  ASSERT_NOT_REACHED;
+}
+
 
 //////////////////////////////////////////////////////////////////////
 // クラス DotlibNodeBase
@@ -858,4 +869,20 @@ DotlibGroup::add_attr(DotlibAttr* attr)
   }
 }
 
+// @brief attribute のリストを置き換える．
+// @param[in] attr_list 属性のリスト
+// @note type() が kGroup の時のみ意味を持つ．
+void
+DotlibGroup::set_attr_list(const vector<DotlibAttr*>& attr_list)
+{
+  mAttrTop = nullptr;
+  mAttrTail = nullptr;
+  for (vector<DotlibAttr*>::const_iterator p = attr_list.begin();
+       p != attr_list.end(); ++ p) {
+    DotlibAttr* attr = *p;
+    attr->mNext = nullptr;
+    add_attr(attr);
+  }
+}
+
 END_NAMESPACE_YM_DOTLIB
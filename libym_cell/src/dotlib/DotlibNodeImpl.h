@@ -169,6 +169,13 @@ public:
   void
   add_attr(DotlibAttr* attr);
 
+  /// @brief attribute のリストを置き換える．
+  /// @param[in] attr_list 属性のリスト
+  /// @note is_group() = true の時のみ意味を持つ．
+  virtual
+  void
+  set_attr_list(const vector<DotlibAttr*>& attr_list);
+
 };
 
 
@@ -761,6 +768,13 @@ public:
   void
   add_attr(DotlibAttr* attr);
 
+  /// @brief attribute のリストを置き換える．
+  /// @param[in] attr_list 属性のリスト
+  /// @note type() が kGroup の時のみ意味を持つ．
+  virtual
+  void
+  set_attr_list(const vector<DotlibAttr*>& attr_list);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -35,15 +35,18 @@ DotlibParser::~DotlibParser()
 // @param[in] mgr DotlibNode を管理するオブジェクト
 // @param[in] debug デバッグモード
 // @param[in] allow_no_semi 行末のセミコロンなしを許すかどうか
+// @param[in] thread_num cell group の読み込みに用いるスレッド数
 // @return 読み込みが成功したら true を返す．
 // @note パース木は mgr にセットされる．
 bool
 DotlibParser::read_file(const string& filename,
 			DotlibMgr& mgr,
 			bool debug,
-			bool allow_no_semi)
+			bool allow_no_semi,
+			ymuint thread_num)
 {
-  return mImpl->read_file(filename, mgr.mImpl, debug, allow_no_semi);
+  return mImpl->read_file(filename, mgr.mImpl, debug, allow_no_semi,
+			  thread_num);
 }
 
 END_NAMESPACE_YM_DOTLIB
@@ -39,13 +39,15 @@ public:
   /// @param[in] mgr DotlibNode を管理するオブジェクト
   /// @param[in] debug デバッグモード
   /// @param[in] allow_no_semi 行末のセミコロンなしを許すかどうか
+  /// @param[in] thread_num cell group の読み込みに用いるスレッド数
   /// @return 読み込みが成功したら true を返す．
   /// @note パース木は mgr にセットされる．
   bool
   read_file(const string& filename,
 	    DotlibMgr& mgr,
 	    bool debug,
-	    bool allow_no_semi = true);
+	    bool allow_no_semi = true,
+	    ymuint thread_num = 1);
 
 
 private:
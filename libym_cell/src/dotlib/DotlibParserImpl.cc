@@ -11,10 +11,14 @@
 #include "DotlibMgrImpl.h"
 #include "DotlibHandler.h"
 #include "HandlerFactory.h"
-#include "YmUtils/FileIDO.h"
+#include "GroupHandler.h"
+#include "DotlibAttr.h"
+#include "DotlibChunkIDO.h"
+#include "YmUtils/MmapIDO.h"
 #include "YmUtils/MsgMgr.h"
 #include "YmUtils/ShString.h"
 #include "DotlibNodeImpl.h"
+#include <thread>
 
 
 BEGIN_NAMESPACE_YM_DOTLIB
@@ -39,20 +43,22 @@ DotlibParserImpl::~DotlibParserImpl()
 // @param[in] mgr DotlibNode を管理するオブジェクト
 // @param[in] debug デバッグモード
 // @param[in] allow_no_semi 行末のセミコロンなしを許すかどうか
+// @param[in] thread_num cell group の読み込みに用いるスレッド数
 // @return 読み込みが成功したら true を返す．
 // @note パース木は mgr にセットされる．
 bool
 DotlibParserImpl::read_file(const string& filename,
 			    DotlibMgrImpl* mgr,
 			    bool debug,
-			    bool allow_no_semi)
+			    bool allow_no_semi,
+			    ymuint thread_num)
 {
   mDotlibMgr = mgr;
 
   mDebug = debug;
   mAllowNoSemi = allow_no_semi;
 
-  FileIDO ido;
+  MmapIDO ido;
   if ( !ido.open(filename) ) {
     ostringstream buf;
     buf << filename << ": Could not open.";
@@ -64,6 +70,28 @@ DotlibParserImpl::read_file(const string& filename,
     return false;
   }
 
+  if ( thread_num > 1 && !debug ) {
+    DotlibSplitter splitter;
+    if ( splitter.split(ido.data(), ido.size()) &&
+	 splitter.cell_list().size() > 1 ) {
+      if ( read_parallel(ido.data(), ido.size(), ido.file_info(),
+			 splitter, thread_num) ) {
+	return true;
+      }
+      // 失敗したら最初から読み直す．
+      mDotlibMgr->clear();
+    }
+  }
+
+  return read(ido);
+}
+
+// @brief library group を読み込む．
+// @param[in] ido 入力データ
+// @return 読み込みが成功したら true を返す．
+bool
+DotlibParserImpl::read(IDO& ido)
+{
   mScanner = new DotlibScanner(ido);
 
   bool error = false;
@@ -115,6 +143,215 @@ DotlibParserImpl::read_file(const string& filename,
   return true;
 }
 
+BEGIN_NONAMESPACE
+
+// 属性の位置の比較を行う．
+inline
+bool
+attr_lt(const DotlibAttr* attr1,
+	const DotlibAttr* attr2)
+{
+  const FileRegion& loc1 = attr1->loc();
+  const FileRegion& loc2 = attr2->loc();
+  if ( loc1.start_line() != loc2.start_line() ) {
+    return loc1.start_line() < loc2.start_line();
+  }
+  return loc1.start_column() < loc2.start_column();
+}
+
+END_NONAMESPACE
+
+// @brief cell group を並列に読み込む．
+// @param[in] data ファイルの内容
+// @param[in] size data のサイズ
+// @param[in] file_info ファイル情報
+// @param[in] splitter 分割結果
+// @param[in] thread_num スレッド数
+// @return 読み込みが成功したら true を返す．
+// @note 失敗した時は mDotlibMgr の内容は不定となる．
+//
+// cell group はスレッドごとのパーサーと DotlibMgrImpl で読み込み，
+// 残りの部分(cell group を空白に置き換えたもの)はこのスレッドで
+// 読み込む．最後に cell group の属性を元の順番で library group に
+// 挿入する．
+// 途中でメッセージが出力される場合は失敗とみなす．
+bool
+DotlibParserImpl::read_parallel(const ymuint8* data,
+				ymuint64 size,
+				const FileInfo& file_info,
+				const DotlibSplitter& splitter,
+				ymuint thread_num)
+{
+  const vector<DotlibChunk>& cell_list = splitter.cell_list();
+  ymuint nc = cell_list.size();
+  if ( thread_num > nc ) {
+    thread_num = nc;
+  }
+
+  vector<DotlibAttr*> attr_list(nc, nullptr);
+  std::atomic<ymuint> next(0);
+
+  vector<DotlibParserImpl*> parser_list(thread_num);
+  vector<DotlibMgrImpl*> mgr_list(thread_num);
+  vector<std::thread> thread_list;
+  thread_list.reserve(thread_num);
+  ShString::set_multi_thread(true);
+  for (ymuint i = 0; i < thread_num; ++ i) {
+    DotlibParserImpl* parser = new DotlibParserImpl;
+    DotlibMgrImpl* mgr = new DotlibMgrImpl;
+    parser_list[i] = parser;
+    mgr_list[i] = mgr;
+    thread_list.push_back(std::thread(&DotlibParserImpl::read_chunks,
+				      parser, data, std::cref(file_info),
+				      std::cref(splitter), mgr,
+				      mAllowNoSemi, &next, &attr_list));
+  }
+
+  // cell group 以外の部分を読む．
+  DotlibChunkIDO skeleton(data, size, file_info);
+  skeleton.set_blank_list(cell_list);
+  MsgMgr::set_mute(true);
+  bool stat = read(skeleton) && MsgMgr::muted_num() == 0;
+  MsgMgr::set_mute(false);
+
+  for (ymuint i = 0; i < thread_num; ++ i) {
+    thread_list[i].join();
+  }
+  ShString::set_multi_thread(false);
+
+  for (ymuint i = 0; i < thread_num; ++ i) {
+    delete parser_list[i];
+  }
+
+  if ( stat ) {
+    for (ymuint i = 0; i < nc; ++ i) {
+      if ( attr_list[i] == nullptr ) {
+	stat = false;
+	break;
+      }
+    }
+  }
+
+  if ( !stat ) {
+    for (ymuint i = 0; i < thread_num; ++ i) {
+      delete mgr_list[i];
+    }
+    return false;
+  }
+
+  // library group の属性と cell group の属性を位置の順にマージする．
+  const DotlibNode* root0 = mDotlibMgr->root_node();
+  DotlibNodeImpl* root = static_cast<DotlibNodeImpl*>(const_cast<DotlibNode*>(root0));
+  vector<DotlibAttr*> new_list;
+  ymuint cpos = 0;
+  for (const DotlibAttr* attr = root->attr_top(); attr; attr = attr->next()) {
+    DotlibAttr* attr1 = const_cast<DotlibAttr*>(attr);
+    for ( ; cpos < nc && attr_lt(attr_list[cpos], attr1); ++ cpos) {
+      new_list.push_back(attr_list[cpos]);
+    }
+    new_list.push_back(attr1);
+  }
+  for ( ; cpos < nc; ++ cpos) {
+    new_list.push_back(attr_list[cpos]);
+  }
+  root->set_attr_list(new_list);
+
+  for (ymuint i = 0; i < thread_num; ++ i) {
+    mDotlibMgr->adopt(mgr_list[i]);
+  }
+
+  return true;
+}
+
+// @brief 割り当てられた cell group を読み込む．
+// @param[in] data ファイルの内容
+// @param[in] file_info ファイル情報
+// @param[in] splitter 分割結果
+// @param[in] mgr DotlibNode を管理するオブジェクト
+// @param[in] allow_no_semi 行末のセミコロンなしを許すかどうか
+// @param[inout] next 次に読み込む cell group の番号
+// @param[out] attr_list 読み込んだ cell group の属性を格納するリスト
+void
+DotlibParserImpl::read_chunks(const ymuint8* data,
+			      const FileInfo& file_info,
+			      const DotlibSplitter& splitter,
+			      DotlibMgrImpl* mgr,
+			      bool allow_no_semi,
+			      std::atomic<ymuint>* next,
+			      vector<DotlibAttr*>* attr_list)
+{
+  mDotlibMgr = mgr;
+  mDebug = false;
+  mAllowNoSemi = allow_no_semi;
+
+  MsgMgr::set_mute(true);
+
+  ChunkGroupHandler* root = HandlerFactory::new_library_chunk(*this);
+
+  // define 文はすべてのスレッドで処理する．
+  const vector<DotlibChunk>& define_list = splitter.define_list();
+  bool stat = true;
+  for (ymuint i = 0; i < define_list.size(); ++ i) {
+    if ( !read_chunk(data, file_info, define_list[i], root) ) {
+      stat = false;
+      break;
+    }
+  }
+
+  const vector<DotlibChunk>& cell_list = splitter.cell_list();
+  ymuint nc = cell_list.size();
+  while ( stat ) {
+    ymuint i = (*next) ++;
+    if ( i >= nc ) {
+      break;
+    }
+    if ( !read_chunk(data, file_info, cell_list[i], root) ) {
+      // 失敗したら他のスレッドも止める．
+      *next = nc;
+      break;
+    }
+    (*attr_list)[i] = root->get_attr();
+  }
+
+  delete root;
+
+  MsgMgr::set_mute(false);
+}
+
+// @brief 一つの文を読み込む．
+// @param[in] data ファイルの内容
+// @param[in] file_info ファイル情報
+// @param[in] chunk 文の範囲
+// @param[in] root 文を処理するハンドラ
+// @return 読み込みが成功したら true を返す．
+bool
+DotlibParserImpl::read_chunk(const ymuint8* data,
+			     const FileInfo& file_info,
+			     const DotlibChunk& chunk,
+			     GroupHandler* root)
+{
+  DotlibChunkIDO ido(data + chunk.mBegin, chunk.mEnd - chunk.mBegin, file_info);
+  DotlibScanner scanner(ido);
+  scanner.set_start_loc(chunk.mLine, chunk.mColumn);
+  mScanner = &scanner;
+
+  bool stat = false;
+  FileRegion loc;
+  if ( read_token(loc) == SYMBOL ) {
+    ShString name(cur_string());
+    DotlibHandler* handler = root->find_handler(name);
+    if ( handler != nullptr &&
+	 handler->read_attr(name, loc) &&
+	 read_token(loc) == END ) {
+      stat = true;
+    }
+  }
+
+  mScanner = nullptr;
+
+  return stat && MsgMgr::muted_num() == 0;
+}
+
 // @brief 引数の種類のトークンでなければエラーメッセージを出力する．
 bool
 DotlibParserImpl::expect(tTokenType req_type)
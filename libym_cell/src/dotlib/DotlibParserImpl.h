@@ -11,7 +11,9 @@
 
 #include "dotlib_int.h"
 #include "DotlibScanner.h"
+#include "DotlibSplitter.h"
 #include "YmUtils/FileRegion.h"
+#include <atomic>
 
 
 BEGIN_NAMESPACE_YM_DOTLIB
@@ -38,13 +40,18 @@ public:
   /// @param[in] mgr DotlibNode を管理するオブジェクト
   /// @param[in] debug デバッグモード
   /// @param[in] allow_no_semi 行末のセミコロンなしを許すかどうか
+  /// @param[in] thread_num cell group の読み込みに用いるスレッド数
   /// @return 読み込みが成功したら true を返す．
   /// @note パース木は mgr にセットされる．
+  /// @note thread_num が 2 以上の時は cell group ごとに分割して
+  /// 並列に読み込む．分割できない場合やエラーが起きた場合には
+  /// 通常の方法で読み直すので結果やメッセージは変わらない．
   bool
   read_file(const string& filename,
 	    DotlibMgrImpl* mgr,
 	    bool debug,
-	    bool allow_no_semi = true);
+	    bool allow_no_semi = true,
+	    ymuint thread_num = 1);
 
 
 public:
@@ -91,6 +98,64 @@ public:
   debug();
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief library group を読み込む．
+  /// @param[in] ido 入力データ
+  /// @return 読み込みが成功したら true を返す．
+  bool
+  read(IDO& ido);
+
+  /// @brief cell group を並列に読み込む．
+  /// @param[in] data ファイルの内容
+  /// @param[in] size data のサイズ
+  /// @param[in] file_info ファイル情報
+  /// @param[in] splitter 分割結果
+  /// @param[in] thread_num スレッド数
+  /// @return 読み込みが成功したら true を返す．
+  /// @note 失敗した時は mDotlibMgr の内容は不定となる．
+  bool
+  read_parallel(const ymuint8* data,
+		ymuint64 size,
+		const FileInfo& file_info,
+		const DotlibSplitter& splitter,
+		ymuint thread_num);
+
+  /// @brief 割り当てられた cell group を読み込む．
+  /// @param[in] data ファイルの内容
+  /// @param[in] file_info ファイル情報
+  /// @param[in] splitter 分割結果
+  /// @param[in] mgr DotlibNode を管理するオブジェクト
+  /// @param[in] allow_no_semi 行末のセミコロンなしを許すかどうか
+  /// @param[inout] next 次に読み込む cell group の番号
+  /// @param[out] attr_list 読み込んだ cell group の属性を格納するリスト
+  /// @note 別スレッドで実行される．
+  /// @note 失敗した cell group の要素は nullptr のままとなる．
+  void
+  read_chunks(const ymuint8* data,
+	      const FileInfo& file_info,
+	      const DotlibSplitter& splitter,
+	      DotlibMgrImpl* mgr,
+	      bool allow_no_semi,
+	      std::atomic<ymuint>* next,
+	      vector<DotlibAttr*>* attr_list);
+
+  /// @brief 一つの文を読み込む．
+  /// @param[in] data ファイルの内容
+  /// @param[in] file_info ファイル情報
+  /// @param[in] chunk 文の範囲
+  /// @param[in] root 文を処理するハンドラ
+  /// @return 読み込みが成功したら true を返す．
+  bool
+  read_chunk(const ymuint8* data,
+	     const FileInfo& file_info,
+	     const DotlibChunk& chunk,
+	     GroupHandler* root);
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
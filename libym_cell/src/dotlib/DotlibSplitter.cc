@@ -0,0 +1,297 @@
+﻿
+/// @file DotlibSplitter.cc
+/// @brief DotlibSplitter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "DotlibSplitter.h"
+
+
+BEGIN_NAMESPACE_YM_DOTLIB
+
+BEGIN_NONAMESPACE
+
+// 改行文字の時 true を返す．
+inline
+bool
+is_nl(ymuint8 c)
+{
+  return c == '\n' || c == '\r';
+}
+
+// 改行文字を読み飛ばす．
+// DotlibScanner と同様に "\r\n" は一つの改行とみなす．
+inline
+ymuint64
+skip_nl(const ymuint8* data,
+	ymuint64 size,
+	ymuint64 pos)
+{
+  if ( data[pos] == '\r' && pos + 1 < size && data[pos + 1] == '\n' ) {
+    return pos + 2;
+  }
+  return pos + 1;
+}
+
+// 単語を構成する文字の時 true を返す．
+inline
+bool
+is_word(ymuint8 c)
+{
+  return isalnum(c) || c == '_' || c == '.';
+}
+
+// 読み込み途中の文の種類
+enum tPending {
+  // なし
+  kNone,
+  // cell group の中
+  kCellBody,
+  // cell group の閉じ括弧の後
+  kCellTail,
+  // define 文の中
+  kDefine
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス DotlibSplitter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+DotlibSplitter::DotlibSplitter()
+{
+}
+
+// @brief デストラクタ
+DotlibSplitter::~DotlibSplitter()
+{
+}
+
+// @brief ファイルの内容を分割する．
+// @param[in] data ファイルの内容
+// @param[in] size data のサイズ
+// @return 分割できたら true を返す．
+bool
+DotlibSplitter::split(const ymuint8* data,
+		      ymuint64 size)
+{
+  mCellList.clear();
+  mDefineList.clear();
+
+  ymuint32 line = 1;
+  ymuint64 line_top = 0;
+  ymuint32 depth = 0;
+  ymuint32 paren = 0;
+  bool stmt_top = true;
+  tPending pending = kNone;
+  DotlibChunk chunk;
+
+  ymuint64 pos = 0;
+  while ( pos < size ) {
+    ymuint8 c = data[pos];
+
+    if ( is_nl(c) ) {
+      pos = skip_nl(data, size, pos);
+      ++ line;
+      line_top = pos;
+      if ( pending == kCellTail || pending == kDefine ) {
+	chunk.mEnd = pos;
+	if ( pending == kCellTail ) {
+	  mCellList.push_back(chunk);
+	}
+	else {
+	  mDefineList.push_back(chunk);
+	}
+	pending = kNone;
+      }
+      stmt_top = true;
+      continue;
+    }
+
+    if ( c == ' ' || c == '\t' ) {
+      ++ pos;
+      continue;
+    }
+
+    if ( c == '\\' ) {
+      // 直後の改行は無視される．
+      ++ pos;
+      if ( pos < size && is_nl(data[pos]) ) {
+	pos = skip_nl(data, size, pos);
+	++ line;
+	line_top = pos;
+      }
+      continue;
+    }
+
+    if ( c == '/' && pos + 1 < size && data[pos + 1] == '/' ) {
+      // C++ スタイルのコメントは行末の改行も読み飛ばすので
+      // cell group の閉じ括弧の後にあると文が終わらない．
+      if ( pending == kCellTail ) {
+	return false;
+      }
+      for (pos += 2; pos < size && !is_nl(data[pos]); ++ pos) { }
+      if ( pos < size ) {
+	pos = skip_nl(data, size, pos);
+	++ line;
+	line_top = pos;
+      }
+      continue;
+    }
+
+    if ( c == '/' && pos + 1 < size && data[pos + 1] == '*' ) {
+      // C スタイルのコメント
+      for (pos += 2; ; ) {
+	if ( pos >= size ) {
+	  return false;
+	}
+	if ( data[pos] == '*' && pos + 1 < size && data[pos + 1] == '/' ) {
+	  pos += 2;
+	  break;
+	}
+	if ( is_nl(data[pos]) ) {
+	  pos = skip_nl(data, size, pos);
+	  ++ line;
+	  line_top = pos;
+	}
+	else {
+	  ++ pos;
+	}
+      }
+      continue;
+    }
+
+    if ( pending == kCellTail ) {
+      // 閉じ括弧の後は改行でなければならない．
+      return false;
+    }
+
+    if ( c == '\"' ) {
+      // 次の " までが文字列
+      for (++ pos; ; ) {
+	if ( pos >= size ) {
+	  return false;
+	}
+	ymuint8 c1 = data[pos];
+	if ( c1 == '\"' ) {
+	  ++ pos;
+	  break;
+	}
+	if ( is_nl(c1) ) {
+	  return false;
+	}
+	if ( c1 == '\\' ) {
+	  ++ pos;
+	  if ( pos >= size ) {
+	    return false;
+	  }
+	  if ( is_nl(data[pos]) ) {
+	    pos = skip_nl(data, size, pos);
+	    ++ line;
+	    line_top = pos;
+	    continue;
+	  }
+	}
+	++ pos;
+      }
+      stmt_top = false;
+      continue;
+    }
+
+    if ( is_word(c) ) {
+      ymuint64 begin = pos;
+      for ( ; pos < size && is_word(data[pos]); ++ pos) { }
+      string word(reinterpret_cast<const char*>(data + begin), pos - begin);
+      if ( stmt_top && word == "define" ) {
+	if ( depth != 1 || paren != 0 || pending != kNone ||
+	     !mCellList.empty() ) {
+	  return false;
+	}
+	pending = kDefine;
+	chunk.mBegin = begin;
+	chunk.mLine = line;
+	chunk.mColumn = begin - line_top + 1;
+      }
+      else if ( stmt_top && word == "cell" && depth == 1 && paren == 0 ) {
+	// 直後が '(' の時のみ cell group とみなす．
+	ymuint64 pos1 = pos;
+	for ( ; pos1 < size && (data[pos1] == ' ' || data[pos1] == '\t');
+	      ++ pos1) { }
+	if ( pos1 < size && data[pos1] == '(' ) {
+	  if ( pending != kNone ) {
+	    return false;
+	  }
+	  pending = kCellBody;
+	  chunk.mBegin = begin;
+	  chunk.mLine = line;
+	  chunk.mColumn = begin - line_top + 1;
+	}
+      }
+      stmt_top = false;
+      continue;
+    }
+
+    switch ( c ) {
+    case '{':
+      ++ depth;
+      stmt_top = true;
+      break;
+
+    case '}':
+      if ( depth == 0 ) {
+	return false;
+      }
+      -- depth;
+      if ( pending == kCellBody && depth == 1 ) {
+	pending = kCellTail;
+      }
+      stmt_top = true;
+      break;
+
+    case '(':
+      ++ paren;
+      stmt_top = false;
+      break;
+
+    case ')':
+      if ( paren == 0 ) {
+	return false;
+      }
+      -- paren;
+      stmt_top = false;
+      break;
+
+    case ';':
+      stmt_top = true;
+      break;
+
+    default:
+      stmt_top = false;
+      break;
+    }
+    ++ pos;
+  }
+
+  if ( pending == kCellBody || depth != 0 ) {
+    return false;
+  }
+  if ( pending == kCellTail || pending == kDefine ) {
+    chunk.mEnd = size;
+    if ( pending == kCellTail ) {
+      mCellList.push_back(chunk);
+    }
+    else {
+      mDefineList.push_back(chunk);
+    }
+  }
+
+  return true;
+}
+
+END_NAMESPACE_YM_DOTLIB
@@ -0,0 +1,122 @@
+﻿#ifndef DOTLIBSPLITTER_H
+#define DOTLIBSPLITTER_H
+
+/// @file DotlibSplitter.h
+/// @brief DotlibSplitter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "dotlib_int.h"
+
+
+BEGIN_NAMESPACE_YM_DOTLIB
+
+//////////////////////////////////////////////////////////////////////
+/// @class DotlibChunk DotlibSplitter.h "DotlibSplitter.h"
+/// @brief ファイル中の一つの文の範囲を表す構造体
+///
+/// 範囲は文の先頭のキーワードから行末の改行文字までとなる．
+//////////////////////////////////////////////////////////////////////
+struct DotlibChunk
+{
+  // 先頭の位置
+  ymuint64 mBegin;
+
+  // 末尾の次の位置
+  ymuint64 mEnd;
+
+  // 先頭の行番号
+  ymuint32 mLine;
+
+  // 先頭のコラム位置
+  ymuint32 mColumn;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class DotlibSplitter DotlibSplitter.h "DotlibSplitter.h"
+/// @brief liberty ファイルを cell group ごとに分割するクラス
+///
+/// 括弧の対応だけをみる簡易な走査を行って library group 直下の
+/// cell group の範囲を求める．
+/// 同時に cell group の読み込みに影響する define 文の範囲も求める．
+/// 以下の場合には分割できないものとして split() が false を返す．
+/// - 括弧の対応がとれていない．
+/// - 閉じていない文字列やコメントがある．
+/// - cell group の閉じ括弧の後に改行以外のトークンがある．
+/// - cell group より後ろか library group 以外の場所に define 文がある．
+//////////////////////////////////////////////////////////////////////
+class DotlibSplitter
+{
+public:
+
+  /// @brief コンストラクタ
+  DotlibSplitter();
+
+  /// @brief デストラクタ
+  ~DotlibSplitter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルの内容を分割する．
+  /// @param[in] data ファイルの内容
+  /// @param[in] size data のサイズ
+  /// @return 分割できたら true を返す．
+  bool
+  split(const ymuint8* data,
+	ymuint64 size);
+
+  /// @brief cell group のリストを返す．
+  const vector<DotlibChunk>&
+  cell_list() const;
+
+  /// @brief define 文のリストを返す．
+  const vector<DotlibChunk>&
+  define_list() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // cell group のリスト
+  vector<DotlibChunk> mCellList;
+
+  // define 文のリスト
+  vector<DotlibChunk> mDefineList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief cell group のリストを返す．
+inline
+const vector<DotlibChunk>&
+DotlibSplitter::cell_list() const
+{
+  return mCellList;
+}
+
+// @brief define 文のリストを返す．
+inline
+const vector<DotlibChunk>&
+DotlibSplitter::define_list() const
+{
+  return mDefineList;
+}
+
+END_NAMESPACE_YM_DOTLIB
+
+#endif // DOTLIBSPLITTER_H
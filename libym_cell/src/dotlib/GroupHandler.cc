@@ -489,4 +489,46 @@ Str2IntGroupHandler::check_group_value(const ShString& attr_name,
   return true;
 }
 
+
+//////////////////////////////////////////////////////////////////////
+// クラス ChunkGroupHandler
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] parser パーサー
+ChunkGroupHandler::ChunkGroupHandler(DotlibParserImpl& parser) :
+  GroupHandler(parser),
+  mAttr(nullptr)
+{
+}
+
+// @brief デストラクタ
+ChunkGroupHandler::~ChunkGroupHandler()
+{
+}
+
+// @brief attribute を設定する．
+// @param[in] attr_name 属性名
+// @param[in] value 値
+// @param[in] loc ファイル上の位置
+// @return 設定が失敗したら false を返す．
+bool
+ChunkGroupHandler::add_attr(const ShString& attr_name,
+			    DotlibNodeImpl* value,
+			    const FileRegion& loc)
+{
+  mAttr = mgr()->new_attr(attr_name, value, loc);
+  return true;
+}
+
+// @brief 直前に追加された属性を取り出す．
+// @note 取り出した後は nullptr になる．
+DotlibAttr*
+ChunkGroupHandler::get_attr()
+{
+  DotlibAttr* attr = mAttr;
+  mAttr = nullptr;
+  return attr;
+}
+
 END_NAMESPACE_YM_DOTLIB
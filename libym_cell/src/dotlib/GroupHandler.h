@@ -310,6 +310,66 @@ protected:
 
 };
 
+
+//////////////////////////////////////////////////////////////////////
+/// @class ChunkGroupHandler GroupHandler.h "GroupHadler.h"
+/// @brief 分割された library group の一部を読むためのハンドラ
+///
+/// library group と同じ子供のハンドラを持つが，自身のノードは作らない．
+/// 子供のハンドラから追加された属性は get_attr() で取り出す．
+//////////////////////////////////////////////////////////////////////
+class ChunkGroupHandler :
+  public GroupHandler
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] parser パーサー
+  ChunkGroupHandler(DotlibParserImpl& parser);
+
+  /// @brief デストラクタ
+  virtual
+  ~ChunkGroupHandler();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部から用いられる GroupHandler の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief attribute を設定する．
+  /// @param[in] attr_name 属性名
+  /// @param[in] value 値
+  /// @param[in] loc ファイル上の位置
+  /// @return 設定が失敗したら false を返す．
+  virtual
+  bool
+  add_attr(const ShString& attr_name,
+	   DotlibNodeImpl* value,
+	   const FileRegion& loc);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // ChunkGroupHandler の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 直前に追加された属性を取り出す．
+  /// @note 取り出した後は nullptr になる．
+  DotlibAttr*
+  get_attr();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 直前に追加された属性
+  DotlibAttr* mAttr;
+
+};
+
 END_NAMESPACE_YM_DOTLIB
 
 #endif // GROUPHANDLER_H
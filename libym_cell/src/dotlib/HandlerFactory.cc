@@ -39,7 +39,25 @@ DotlibHandler*
 HandlerFactory::new_library(DotlibParserImpl& parser)
 {
   GroupHandler* handler = new Str1GroupHandler(parser);
+  reg_library_children(handler);
+  return handler;
+}
+
+// @brief 分割された library group の一部を読むためのハンドラを作る．
+// @param[in] parser パーサー
+ChunkGroupHandler*
+HandlerFactory::new_library_chunk(DotlibParserImpl& parser)
+{
+  ChunkGroupHandler* handler = new ChunkGroupHandler(parser);
+  reg_library_children(handler);
+  return handler;
+}
 
+// @brief library group の子供のハンドラを登録する．
+// @param[in] handler 対象のハンドラ
+void
+HandlerFactory::reg_library_children(GroupHandler* handler)
+{
   // simple attributes
   DotlibHandler* simple = new SimpleHandler(handler, false);
   DotlibHandler* str_simple = new StrSimpleHandler(handler, false);
@@ -298,8 +316,6 @@ HandlerFactory::new_library(DotlibParserImpl& parser)
 		       new_wire_load_selection(handler));
   handler->reg_handler("wire_load_table",
 		       new_wire_load_table(handler));
-
-  return handler;
 }
 
 // @brief input_voltage group 用のハンドラを作る．
@@ -41,6 +41,13 @@ public:
   DotlibHandler*
   new_library(DotlibParserImpl& parser);
 
+  /// @brief 分割された library group の一部を読むためのハンドラを作る．
+  /// @param[in] parser パーサー
+  /// @note 子供のハンドラは new_library() と同じものを持つ．
+  static
+  ChunkGroupHandler*
+  new_library_chunk(DotlibParserImpl& parser);
+
   /// @brief input_voltage group 用のハンドラを作る．
   /// @param[in] parent 親のハンドラ
   static
@@ -183,6 +190,18 @@ public:
   GroupHandler*
   new_group(GroupHandler* parent);
 
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief library group の子供のハンドラを登録する．
+  /// @param[in] handler 対象のハンドラ
+  static
+  void
+  reg_library_children(GroupHandler* handler);
+
 };
 
 END_NAMESPACE_YM_DOTLIB
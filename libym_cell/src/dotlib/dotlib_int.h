@@ -76,6 +76,7 @@ operator<<(ostream& s,
 class DotlibParserImpl;
 class DotlibHandler;
 class GroupHandler;
+class ChunkGroupHandler;
 class DotlibMgrImpl;
 class DotlibNodeImpl;
 
@@ -17,6 +17,20 @@
 
 BEGIN_NAMESPACE_YM_CELL_LIBCOMP
 
+BEGIN_NONAMESPACE
+
+// FF用の代表関数のキャッシュ
+// すべての LibComp で共有される．
+LcRepCache&
+ff_rep_cache()
+{
+  static LcRepCache rep_cache;
+  return rep_cache;
+}
+
+END_NONAMESPACE
+
+
 //////////////////////////////////////////////////////////////////////
 // クラスLcFFMgr
 //////////////////////////////////////////////////////////////////////
@@ -24,7 +38,7 @@ BEGIN_NAMESPACE_YM_CELL_LIBCOMP
 // @brief コンストラクタ
 // @param[in] libcomp 親の LibComp
 LcFFMgr::LcFFMgr(LibComp& libcomp) :
-  LcGroupMgr(libcomp)
+  LcGroupMgr(libcomp, ff_rep_cache())
 {
 }
 
@@ -12,8 +12,10 @@
 #include "LcGroup.h"
 #include "LibComp.h"
 #include "YmCell/Cell.h"
+#include "YmUtils/HashSet.h"
 #include "YmUtils/MFSet.h"
 #include "YmUtils/PermGen.h"
+#include <thread>
 
 
 BEGIN_NAMESPACE_YM_CELL_LIBCOMP
@@ -24,8 +26,11 @@ BEGIN_NAMESPACE_YM_CELL_LIBCOMP
 
 // @brief コンストラクタ
 // @param[in] libcomp 親の LibComp
-LcGroupMgr::LcGroupMgr(LibComp& libcomp) :
-  mLibComp(libcomp)
+// @param[in] rep_cache 代表関数のキャッシュ
+LcGroupMgr::LcGroupMgr(LibComp& libcomp,
+		       LcRepCache& rep_cache) :
+  mLibComp(libcomp),
+  mRepCache(rep_cache)
 {
 }
 
@@ -43,11 +48,94 @@ LcGroupMgr::clear()
   mClassMap.clear();
 }
 
+// @brief セルのシグネチャ関数を求める．
+// @param[in] cell セル
+// @param[out] f シグネチャ関数
+// @retval true f を求めた．
+// @retval false 論理式を持たない出力があるので独立したグループとなる．
+bool
+LcGroupMgr::cell_signature(const Cell* cell,
+			   TvFuncM& f)
+{
+  if ( !cell->has_logic() || cell->output_num2() == 0 ) {
+    return false;
+  }
+  gen_signature(cell, f);
+  return true;
+}
+
+// @brief 代表関数と同位体変換を並列に求めておく．
+// @param[in] func_list 関数のリスト
+// @param[in] thread_num スレッド数
+// @note 結果はキャッシュに登録されて find_group() で用いられる．
+void
+LcGroupMgr::prepare(const vector<TvFuncM>& func_list,
+		    ymuint thread_num)
+{
+  // 重複したものとキャッシュに登録済みのものを除く．
+  vector<TvFuncM> todo_list;
+  todo_list.reserve(func_list.size());
+  HashSet<TvFuncM> func_set;
+  for (vector<TvFuncM>::const_iterator p = func_list.begin();
+       p != func_list.end(); ++ p) {
+    const TvFuncM& f = *p;
+    if ( func_set.find(f) ) {
+      continue;
+    }
+    func_set.add(f);
+    TvFuncM repfunc;
+    NpnMapM xmap;
+    if ( mRepCache.find_repfunc(f, repfunc, xmap) ) {
+      continue;
+    }
+    todo_list.push_back(f);
+  }
+
+  ymuint n = thread_num;
+  if ( n > todo_list.size() ) {
+    n = todo_list.size();
+  }
+
+  std::atomic<ymuint> next(0);
+  vector<std::thread> thread_list;
+  thread_list.reserve(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    thread_list.push_back(std::thread(&LcGroupMgr::prepare_worker, this,
+				      &todo_list, &next));
+  }
+  for (vector<std::thread>::iterator p = thread_list.begin();
+       p != thread_list.end(); ++ p) {
+    p->join();
+  }
+}
+
+// @brief prepare() の個々のスレッドで実行される関数
+// @param[in] func_list 関数のリスト
+// @param[in] next 次に処理する関数の番号
+void
+LcGroupMgr::prepare_worker(const vector<TvFuncM>* func_list,
+			   std::atomic<ymuint>* next)
+{
+  for ( ; ; ) {
+    ymuint id = (*next) ++;
+    if ( id >= func_list->size() ) {
+      break;
+    }
+    const TvFuncM& f = (*func_list)[id];
+    TvFuncM repfunc;
+    NpnMapM xmap;
+    calc_repfunc(f, repfunc, xmap);
+    vector<NpnMapM> idmap_list;
+    calc_idmap_list(repfunc, idmap_list);
+  }
+}
+
 // @brief セルを追加する．
 void
 LcGroupMgr::add_cell(Cell* cell)
 {
-  if ( !cell->has_logic() || cell->output_num2() == 0 ) {
+  TvFuncM f;
+  if ( !cell_signature(cell, f) ) {
     // ひとつでも論理式を持たない出力があるセルは独立したグループとなる．
     LcGroup* fgroup = mLibComp.new_group();
     fgroup->add_cell(cell);
@@ -61,10 +149,6 @@ LcGroupMgr::add_cell(Cell* cell)
     fclass->add_group(fgroup, xmap);
   }
   else {
-    // セルのシグネチャ関数を作る．
-    TvFuncM f;
-    gen_signature(cell, f);
-
     // f に対するセルグループを求める．
     LcGroup* fgroup = find_group(f, false);
 
@@ -94,7 +178,7 @@ LcGroupMgr::find_group(const TvFuncM& f,
   // 代表関数を求める．
   TvFuncM repfunc;
   NpnMapM xmap;
-  find_repfunc(f, repfunc, xmap);
+  calc_repfunc(f, repfunc, xmap);
 
   LcClass* fclass = nullptr;
   ymuint fcid;
@@ -104,9 +188,9 @@ LcGroupMgr::find_group(const TvFuncM& f,
   }
   else {
     // まだ登録されていない．
-    LcClass* fclass = mLibComp.new_class(repfunc, builtin);
+    fclass = mLibComp.new_class(repfunc, builtin);
     mClassMap.add(repfunc, fclass->id());
-    find_idmap_list(repfunc, fclass->mIdmapList);
+    calc_idmap_list(repfunc, fclass->mIdmapList);
   }
 
   // グループを追加する．
@@ -115,6 +199,36 @@ LcGroupMgr::find_group(const TvFuncM& f,
   return fgroup;
 }
 
+// @brief キャッシュを用いて代表関数を求める．
+// @param[in] f 関数
+// @param[out] repfunc 代表関数
+// @param[out] xmap 変換
+void
+LcGroupMgr::calc_repfunc(const TvFuncM& f,
+			 TvFuncM& repfunc,
+			 NpnMapM& xmap)
+{
+  if ( mRepCache.find_repfunc(f, repfunc, xmap) ) {
+    return;
+  }
+  find_repfunc(f, repfunc, xmap);
+  mRepCache.reg_repfunc(f, repfunc, xmap);
+}
+
+// @brief キャッシュを用いて同位体変換リストを求める．
+// @param[in] func 対象の関数
+// @param[out] idmap_list 同位体変換のリスト
+void
+LcGroupMgr::calc_idmap_list(const TvFuncM& func,
+			    vector<NpnMapM>& idmap_list)
+{
+  if ( mRepCache.find_idmap_list(func, idmap_list) ) {
+    return;
+  }
+  find_idmap_list(func, idmap_list);
+  mRepCache.reg_idmap_list(func, idmap_list);
+}
+
 
 BEGIN_NONAMESPACE
 
@@ -17,6 +17,20 @@
 
 BEGIN_NAMESPACE_YM_CELL_LIBCOMP
 
+BEGIN_NONAMESPACE
+
+// ラッチ用の代表関数のキャッシュ
+// すべての LibComp で共有される．
+LcRepCache&
+latch_rep_cache()
+{
+  static LcRepCache rep_cache;
+  return rep_cache;
+}
+
+END_NONAMESPACE
+
+
 //////////////////////////////////////////////////////////////////////
 // クラスLcLatchMgr
 //////////////////////////////////////////////////////////////////////
@@ -24,7 +38,7 @@ BEGIN_NAMESPACE_YM_CELL_LIBCOMP
 // @brief コンストラクタ
 // @param[in] libcomp 親の LibComp
 LcLatchMgr::LcLatchMgr(LibComp& libcomp) :
-  LcGroupMgr(libcomp)
+  LcGroupMgr(libcomp, latch_rep_cache())
 {
 }
 
@@ -17,6 +17,20 @@
 
 BEGIN_NAMESPACE_YM_CELL_LIBCOMP
 
+BEGIN_NONAMESPACE
+
+// 論理セル用の代表関数のキャッシュ
+// すべての LibComp で共有される．
+LcRepCache&
+logic_rep_cache()
+{
+  static LcRepCache rep_cache;
+  return rep_cache;
+}
+
+END_NONAMESPACE
+
+
 //////////////////////////////////////////////////////////////////////
 // クラス LcLogicMgr
 //////////////////////////////////////////////////////////////////////
@@ -24,7 +38,7 @@ BEGIN_NAMESPACE_YM_CELL_LIBCOMP
 // @brief コンストラクタ
 // @param[in] libcomp 親の LibComp
 LcLogicMgr::LcLogicMgr(LibComp& libcomp) :
-  LcGroupMgr(libcomp)
+  LcGroupMgr(libcomp, logic_rep_cache())
 {
 }
 
@@ -123,7 +137,9 @@ LcLogicMgr::find_repfunc(const TvFuncM& f,
   if ( no == 1 ) {
     TvFunc f1 = f.output(VarId(0));
     NpnMap xmap1;
-    mNpnMgr.cannonical(f1, xmap1);
+    // 複数のスレッドから呼ばれるので NpnMgr は呼び出しごとに用意する．
+    NpnMgr npnmgr;
+    npnmgr.cannonical(f1, xmap1);
     xmap = NpnMapM(xmap1);
     repfunc = f.xform(xmap);
     { // 一応検証
@@ -158,7 +174,8 @@ LcLogicMgr::find_idmap_list(const TvFuncM& func,
   if ( no == 1 ) {
     NpnMap xmap1;
     TvFunc f1 = func.output(VarId(0));
-    mNpnMgr.cannonical(f1, xmap1);
+    NpnMgr npnmgr;
+    npnmgr.cannonical(f1, xmap1);
     { // 検証
       TvFunc f2 = f1.xform(xmap1);
       if ( f1 != f2 ) {
@@ -170,7 +187,7 @@ LcLogicMgr::find_idmap_list(const TvFuncM& func,
       ASSERT_COND( f1 == f2 );
     }
     vector<NpnMap> tmp_list;
-    mNpnMgr.all_map(tmp_list);
+    npnmgr.all_map(tmp_list);
     idmap_list.reserve(tmp_list.size());
     for (vector<NpnMap>::iterator p = tmp_list.begin();
 	 p != tmp_list.end(); ++ p) {
@@ -16,6 +16,7 @@
 #include "YmUtils/PermGen.h"
 #include "YmUtils/MultiCombiGen.h"
 #include "YmUtils/MultiSetPermGen.h"
+#include <mutex>
 
 
 BEGIN_NONAMESPACE
@@ -25,6 +26,78 @@ END_NONAMESPACE
 
 BEGIN_NAMESPACE_YM_CELL_LIBCOMP
 
+BEGIN_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// パタン生成の結果を保持するクラス
+//
+// 論理式の文字列表現をキーとして LcPatMgr::encode_trace() で
+// 符号化した生成手順を保持する．
+// 生成手順は論理式のみで決まるので，すべての LcPatMgr で共有される．
+//////////////////////////////////////////////////////////////////////
+class LcPatCache
+{
+public:
+
+  // デストラクタ
+  ~LcPatCache()
+  {
+    for (HashMapIterator<string, vector<ymuint32>*> p = mCodeMap.begin();
+	 p != mCodeMap.end(); ++ p) {
+      delete p.value();
+    }
+  }
+
+  // 生成手順を探す．
+  bool
+  find(const string& key,
+       vector<ymuint32>& code)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    vector<ymuint32>* code1;
+    if ( !mCodeMap.find(key, code1) ) {
+      return false;
+    }
+    code = *code1;
+    return true;
+  }
+
+  // 生成手順を登録する．
+  void
+  reg(const string& key,
+      const vector<ymuint32>& code)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    vector<ymuint32>* code1;
+    if ( mCodeMap.find(key, code1) ) {
+      return;
+    }
+    mCodeMap.add(key, new vector<ymuint32>(code));
+  }
+
+
+private:
+
+  // 排他制御用のオブジェクト
+  std::mutex mMutex;
+
+  // 論理式の文字列表現をキーとして生成手順を保持するハッシュ表
+  HashMap<string, vector<ymuint32>*> mCodeMap;
+
+};
+
+// パタン生成の結果のキャッシュを返す．
+LcPatCache&
+pat_cache()
+{
+  static LcPatCache cache;
+  return cache;
+}
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // クラス LcPatMgr
 //////////////////////////////////////////////////////////////////////
@@ -122,8 +195,23 @@ LcPatMgr::reg_pat(const Expr& expr,
     expr_list.push_back(expr);
   }
 
+  // 同じ論理式からパタンを生成したことがあれば
+  // その手順を再現するだけでよい．
+  ostringstream buf;
+  buf << expr;
+  string key = buf.str();
   vector<LcPatHandle> tmp_pat_list;
-  pg_sub(expr, tmp_pat_list);
+  vector<ymuint32> code;
+  mTraceList.clear();
+  if ( pat_cache().find(key, code) ) {
+    decode_trace(code, tmp_pat_list);
+  }
+  else {
+    pg_sub(expr, tmp_pat_list);
+    if ( encode_trace(tmp_pat_list, code) ) {
+      pat_cache().reg(key, code);
+    }
+  }
 
   for (vector<LcPatHandle>::iterator p = tmp_pat_list.begin();
        p != tmp_pat_list.end(); ++ p) {
@@ -457,6 +545,8 @@ LcPatMgr::make_input(VarId var)
   LcPatNode* node = mInputList[id];
   ASSERT_COND( node != nullptr );
 
+  mTraceList.push_back(node);
+
   return node;
 }
 
@@ -502,6 +592,19 @@ LcPatMgr::make_node(const Expr& expr,
     type |= 8U;
   }
 
+  LcPatNode* node = find_node(type, l_node, r_node);
+  return LcPatHandle(node, oinv);
+}
+
+// @brief (type, l_node, r_node) というノードを返す．
+// @param[in] type ノードの種類と枝の極性を表す値
+// @param[in] l_node, r_node 左右の子供のノード
+// @note なければ新規に作る．
+LcPatNode*
+LcPatMgr::find_node(ymuint32 type,
+		    LcPatNode* l_node,
+		    LcPatNode* r_node)
+{
   // (type, l_node, r_node) というノードがすでにあったらそれを使う．
   ymuint pos = hash_func(type, l_node, r_node);
   ymuint idx = pos % mHashSize;
@@ -510,7 +613,8 @@ LcPatMgr::make_node(const Expr& expr,
 	 node->mFanin[0] == l_node &&
 	 node->mFanin[1] == r_node ) {
       // おなじノードがあった．
-      return LcPatHandle(node, oinv);
+      mTraceList.push_back(node);
+      return node;
     }
   }
 
@@ -529,7 +633,116 @@ LcPatMgr::make_node(const Expr& expr,
   node->mLink = mHashTable[idx];
   mHashTable[idx] = node;
 
-  return LcPatHandle(node, oinv);
+  mTraceList.push_back(node);
+
+  return node;
+}
+
+// @brief パタン生成の手順を符号化する．
+// @param[in] pat_list 生成されたパタンのリスト
+// @param[out] code 符号化した結果
+// @note mTraceList に記録されたノードの順に生成手順を並べる．
+//
+// 最初に現れた順にノードを作り直せばノードの生成順も元と
+// 同じになる．
+// 符号化した結果は以下の形式となる．
+// - ノード数 n
+// - n 個のノードの情報 (3語ずつ)
+//   - 入力ノード: 種類 (LcPatNode::kInput)，入力番号，0
+//   - AND/XOR ノード: mType，左右のファンインのノードの位置
+// - パタン数 m
+// - m 個のパタンの根 (ノードの位置 x 2 + 極性)
+// mTraceList に含まれないノードを参照していたら符号化できないので
+// code を空にして false を返す．
+bool
+LcPatMgr::encode_trace(const vector<LcPatHandle>& pat_list,
+		       vector<ymuint32>& code) const
+{
+  // ノード番号をキーにして code 中の位置を保持するハッシュ表
+  HashMap<ymuint, ymuint> pos_map;
+  vector<LcPatNode*> node_list;
+  node_list.reserve(mTraceList.size());
+  for (vector<LcPatNode*>::const_iterator p = mTraceList.begin();
+       p != mTraceList.end(); ++ p) {
+    LcPatNode* node = *p;
+    ymuint pos = 0;
+    if ( pos_map.find(node->id(), pos) ) {
+      continue;
+    }
+    pos_map.add(node->id(), node_list.size());
+    node_list.push_back(node);
+  }
+
+  ymuint n = node_list.size();
+  code.clear();
+  code.reserve(n * 3 + pat_list.size() + 2);
+  code.push_back(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    LcPatNode* node = node_list[i];
+    if ( node->is_input() ) {
+      code.push_back(LcPatNode::kInput);
+      code.push_back(node->input_id());
+      code.push_back(0);
+    }
+    else {
+      ymuint pos0 = 0;
+      ymuint pos1 = 0;
+      if ( !pos_map.find(node->fanin0()->id(), pos0) ||
+	   !pos_map.find(node->fanin1()->id(), pos1) ) {
+	code.clear();
+	return false;
+      }
+      ASSERT_COND( pos0 < i && pos1 < i );
+      code.push_back(node->mType);
+      code.push_back(pos0);
+      code.push_back(pos1);
+    }
+  }
+
+  code.push_back(pat_list.size());
+  for (vector<LcPatHandle>::const_iterator p = pat_list.begin();
+       p != pat_list.end(); ++ p) {
+    LcPatHandle pat = *p;
+    ymuint pos = 0;
+    if ( !pos_map.find(pat.node()->id(), pos) ) {
+      code.clear();
+      return false;
+    }
+    code.push_back((pos << 1) | static_cast<ymuint>(pat.inv()));
+  }
+  return true;
+}
+
+// @brief encode_trace() で符号化された手順にしたがってパタンを作る．
+// @param[in] code 符号化された手順
+// @param[out] pat_list 生成されたパタンのリスト
+void
+LcPatMgr::decode_trace(const vector<ymuint32>& code,
+		       vector<LcPatHandle>& pat_list)
+{
+  ymuint rpos = 0;
+  ymuint n = code[rpos ++];
+  vector<LcPatNode*> node_list(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    ymuint32 type = code[rpos ++];
+    ymuint32 val0 = code[rpos ++];
+    ymuint32 val1 = code[rpos ++];
+    if ( type == LcPatNode::kInput ) {
+      node_list[i] = make_input(VarId(val0));
+    }
+    else {
+      node_list[i] = find_node(type, node_list[val0], node_list[val1]);
+    }
+  }
+
+  ymuint m = code[rpos ++];
+  pat_list.reserve(m);
+  for (ymuint i = 0; i < m; ++ i) {
+    ymuint32 val = code[rpos ++];
+    LcPatNode* node = node_list[val >> 1];
+    bool inv = static_cast<bool>(val & 1U);
+    pat_list.push_back(LcPatHandle(node, inv));
+  }
 }
 
 // @brief ノードを作る．
@@ -601,25 +814,31 @@ BEGIN_NONAMESPACE
 
 // @brief パタングラフを DFS でたどって内容を val_list に入れる．
 // @param[in] node ノード
-// @param[in] vmark 訪れたかどうかの情報を持つ配列
 // @param[out] val_list ノードの情報を格納するリスト
 // @return 最大入力番号+1を返す．
+//
+// 訪れたかどうかは val_list に node->id() * 2 があるかで判断する．
+// パタンのノード数は高々数十なので線形探索で十分である．
+// 全ノード数の大きさのマークを用いるとパタンごとにその初期化が
+// 必要になり，パタン数 x ノード数の時間がかかってしまう．
 ymuint
 dfs(LcPatNode* node,
-    vector<bool>& vmark,
     vector<ymuint>& val_list)
 {
   if ( node->is_input() ) {
     return node->input_id() + 1;
   }
-  if ( vmark[node->id()] ) {
-    return 0;
+  ymuint val = node->id() * 2;
+  for (vector<ymuint>::iterator p = val_list.begin();
+       p != val_list.end(); ++ p) {
+    if ( *p == val ) {
+      return 0;
+    }
   }
-  vmark[node->id()] = true;
-  val_list.push_back(node->id() * 2);
-  ymuint id = dfs(node->fanin(0), vmark, val_list);
-  val_list.push_back(node->id() * 2 + 1);
-  ymuint id1 = dfs(node->fanin(1), vmark, val_list);
+  val_list.push_back(val);
+  ymuint id = dfs(node->fanin(0), val_list);
+  val_list.push_back(val + 1);
+  ymuint id1 = dfs(node->fanin(1), val_list);
   if ( id < id1 ) {
     id = id1;
   }
@@ -638,9 +857,7 @@ LcPatMgr::pat_node_list(ymuint id,
 {
   LcPatHandle root = pat_root(id);
   node_list.clear();
-  node_list.reserve(node_num());
-  vector<bool> vmark(node_num(), false);
-  ymuint max_input =dfs(root.node(), vmark, node_list);
+  ymuint max_input = dfs(root.node(), node_list);
   ymuint32 v = max_input << 1;
   if ( root.inv() ) {
     v |= 1U;
@@ -0,0 +1,130 @@
+﻿
+/// @file LcRepCache.cc
+/// @brief LcRepCache の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "LcRepCache.h"
+
+
+BEGIN_NAMESPACE_YM_CELL_LIBCOMP
+
+//////////////////////////////////////////////////////////////////////
+// クラス LcRepCache
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+LcRepCache::LcRepCache()
+{
+}
+
+// @brief デストラクタ
+LcRepCache::~LcRepCache()
+{
+  clear();
+}
+
+// @brief 代表関数を探す．
+// @param[in] f シグネチャ関数
+// @param[out] repfunc 代表関数
+// @param[out] xmap f から repfunc への変換
+// @retval true 登録されていた．
+// @retval false 登録されていなかった．
+bool
+LcRepCache::find_repfunc(const TvFuncM& f,
+			 TvFuncM& repfunc,
+			 NpnMapM& xmap) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  RepInfo* info;
+  if ( !mRepMap.find(f, info) ) {
+    return false;
+  }
+  repfunc = info->mRepFunc;
+  xmap = info->mXmap;
+  return true;
+}
+
+// @brief 代表関数を登録する．
+// @param[in] f シグネチャ関数
+// @param[in] repfunc 代表関数
+// @param[in] xmap f から repfunc への変換
+// @note 既に登録されている時はなにもしない．
+void
+LcRepCache::reg_repfunc(const TvFuncM& f,
+			const TvFuncM& repfunc,
+			const NpnMapM& xmap)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  RepInfo* info;
+  if ( mRepMap.find(f, info) ) {
+    return;
+  }
+  info = new RepInfo;
+  info->mRepFunc = repfunc;
+  info->mXmap = xmap;
+  mRepMap.add(f, info);
+}
+
+// @brief 同位体変換のリストを探す．
+// @param[in] repfunc 代表関数
+// @param[out] idmap_list 同位体変換のリスト
+// @retval true 登録されていた．
+// @retval false 登録されていなかった．
+bool
+LcRepCache::find_idmap_list(const TvFuncM& repfunc,
+			    vector<NpnMapM>& idmap_list) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  vector<NpnMapM>* list;
+  if ( !mIdmapMap.find(repfunc, list) ) {
+    return false;
+  }
+  idmap_list = *list;
+  return true;
+}
+
+// @brief 同位体変換のリストを登録する．
+// @param[in] repfunc 代表関数
+// @param[in] idmap_list 同位体変換のリスト
+// @note 既に登録されている時はなにもしない．
+void
+LcRepCache::reg_idmap_list(const TvFuncM& repfunc,
+			   const vector<NpnMapM>& idmap_list)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  vector<NpnMapM>* list;
+  if ( mIdmapMap.find(repfunc, list) ) {
+    return;
+  }
+  list = new vector<NpnMapM>(idmap_list);
+  mIdmapMap.add(repfunc, list);
+}
+
+// @brief 内容を空にする．
+void
+LcRepCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  for (HashMapIterator<TvFuncM, RepInfo*> p = mRepMap.begin();
+       p != mRepMap.end(); ++ p) {
+    delete p.value();
+  }
+  mRepMap.clear();
+
+  for (HashMapIterator<TvFuncM, vector<NpnMapM>*> p = mIdmapMap.begin();
+       p != mIdmapMap.end(); ++ p) {
+    delete p.value();
+  }
+  mIdmapMap.clear();
+}
+
+END_NAMESPACE_YM_CELL_LIBCOMP
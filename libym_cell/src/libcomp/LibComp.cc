@@ -17,6 +17,7 @@
 #include "YmCell/CellPin.h"
 #include "YmLogic/Expr.h"
 #include "YmLogic/NpnMap.h"
+#include "YmLogic/TvFuncM.h"
 
 
 BEGIN_NAMESPACE_YM_CELL_LIBCOMP
@@ -46,6 +47,25 @@ xform_expr(const Expr& expr,
   return cexpr;
 }
 
+// パタンを作る対象のセルの時 true を返す．
+bool
+is_pat_target(const Cell* cell)
+{
+  if ( cell->output_num2() != 1 ) {
+    // 出力ピンが複数あるセルは対象外
+    return false;
+  }
+  if ( !cell->has_logic(0) ) {
+    // 論理式を持たないセルも対象外
+    return false;
+  }
+  if ( cell->has_tristate(0) ) {
+    // three_state 属性を持つセルも対象外
+    return false;
+  }
+  return true;
+}
+
 END_NONAMESPACE
 
 
@@ -103,8 +123,11 @@ LibComp::pat_mgr() const
 }
 
 // @brief セルのグループ化，クラス化を行う．
+// @param[in] library 対象のライブラリ
+// @param[in] thread_num 代表関数の計算に用いるスレッド数
 void
-LibComp::compile(CellLibrary& library)
+LibComp::compile(CellLibrary& library,
+		 ymuint thread_num)
 {
   mGroupList.clear();
   mClassList.clear();
@@ -183,6 +206,44 @@ LibComp::compile(CellLibrary& library)
   }
 
   ymuint nc = library.cell_num();
+
+  // 時間のかかる代表関数の計算は先に並列に行っておく．
+  // 結果はキャッシュに登録されて以下の add_cell() と reg_expr() で
+  // 用いられる．
+  // グループ番号とクラス番号がスレッド数によらずに決まるように
+  // グループとクラスの生成はこの後で逐次的に行う．
+  {
+    vector<TvFuncM> logic_list;
+    vector<TvFuncM> ff_list;
+    vector<TvFuncM> latch_list;
+    for (ymuint i = 0; i < nc; ++ i) {
+      const Cell* cell = library.cell(i);
+      TvFuncM f;
+      if ( cell->is_logic() ) {
+	if ( mLogicMgr.cell_signature(cell, f) ) {
+	  logic_list.push_back(f);
+	}
+	if ( is_pat_target(cell) ) {
+	  Expr expr = cell->logic_expr(0);
+	  logic_list.push_back(TvFuncM(expr.make_tv()));
+	}
+      }
+      else if ( cell->is_ff() ) {
+	if ( mFFMgr.cell_signature(cell, f) ) {
+	  ff_list.push_back(f);
+	}
+      }
+      else if ( cell->is_latch() ) {
+	if ( mLatchMgr.cell_signature(cell, f) ) {
+	  latch_list.push_back(f);
+	}
+      }
+    }
+    mLogicMgr.prepare(logic_list, thread_num);
+    mFFMgr.prepare(ff_list, thread_num);
+    mLatchMgr.prepare(latch_list, thread_num);
+  }
+
   for (ymuint i = 0; i < nc; ++ i) {
     Cell* cell = library.cell(i);
 
@@ -190,17 +251,7 @@ LibComp::compile(CellLibrary& library)
       mLogicMgr.add_cell(cell);
 
       // パタンを作る．
-      ymuint no2 = cell->output_num2();
-      if ( no2 != 1 ) {
-	// 出力ピンが複数あるセルは対象外
-	continue;
-      }
-      if ( !cell->has_logic(0) ) {
-	// 論理式を持たないセルも対象外
-	continue;
-      }
-      if ( cell->has_tristate(0) ) {
-	// three_state 属性を持つセルも対象外
+      if ( !is_pat_target(cell) ) {
 	continue;
       }
 
@@ -57,7 +57,12 @@ dump_load_test(const char* in_filename,
     }
 
     library2 = CellLibrary::new_obj();
-    library2->restore(bi);
+    if ( !library2->restore(bi) ) {
+      // エラー
+      cerr << "Illegal format: " << data_filename << endl;
+      delete library2;
+      return false;
+    }
   }
 
   display_library(cout, *library2);
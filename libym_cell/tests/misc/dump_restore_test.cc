@@ -102,7 +102,12 @@ main(int argc,
     }
 
     CellLibrary* library2 = CellLibrary::new_obj();
-    library2->restore(bi);
+    if ( !library2->restore(bi) ) {
+      // エラー
+      cerr << "Illegal format: " << datafile << endl;
+      delete library2;
+      return 3;
+    }
 
     ofstream os2;
     os2.open("dump2.cell", ios::binary);
@@ -1,11 +1,11 @@
-﻿#ifndef YM_YMYMLOGIC_AIGSATMGR_H
-#define YM_YMYMLOGIC_AIGSATMGR_H
+﻿#ifndef YMYMLOGIC_AIGSATMGR_H
+#define YMYMLOGIC_AIGSATMGR_H
 
 /// @file YmLogic/AigSatMgr.h
 /// @brief AigSatMgrのヘッダファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2005-2011 Yusuke Matsunaga
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
 /// All rights reserved.
 
 
@@ -13,13 +13,25 @@
 #include "YmLogic/SatSolver.h"
 
 
-#error "Who need this?"
-
 BEGIN_NAMESPACE_YM_AIG
 
+class AigCutCnf;
+
 //////////////////////////////////////////////////////////////////////
 /// @class AigSatMgr AigSatMgr.h "YmLogic/AigSatMgr.h"
 /// @brief AIG 上の充足可能性判定器
+///
+/// 一つの SatSolver を保持し続け，問い合わせのたびに対象の AIG の
+/// うちまだ CNF になっていない部分だけを追加する．
+/// CNF は極大 AND 木(反転枝と外部入力と既に変数を持つノードを葉とする)
+/// ごとに作る．
+/// 問い合わせは assumption として与えるので，学習節は次の問い合わせ
+/// でもそのまま使われる．
+///
+/// set_cut_size() でカットの大きさを指定すると，小さなカットによる
+/// 技術マッピングで CNF を作る．カットの関数の非冗長積和形の節数を
+/// コストとして被覆を選ぶので，変数と節の数を減らすことができる．
+/// @note 対象の AIG はすべて同じ AigMgr のものでなければならない．
 //////////////////////////////////////////////////////////////////////
 class AigSatMgr
 {
@@ -56,10 +68,59 @@ public:
   /// @retval kB3False 充足不能
   /// @retval kB3True 充足可能
   /// @retval kB3X 不明
+  ///
+  /// model[i] には入力番号 i の値が入る．
+  /// 今までの問い合わせで一度も現れていない入力の値は kB3X となる．
   Bool3
   sat(const vector<Aig>& edge_list,
       vector<Bool3>& model);
 
+  /// @brief edge に対応するリテラルを返す．
+  /// @param[in] edge 対象の AIG ハンドル
+  ///
+  /// 必要ならば edge の TFI の CNF を作る．
+  /// SatSolver に直接制約を加えたい時に用いる．
+  Literal
+  make_literal(Aig edge);
+
+  /// @brief 用いている SAT-solver を返す．
+  SatSolver&
+  solver();
+
+  /// @brief CNF を作る時のカットの大きさを設定する．
+  /// @param[in] cut_size カットの葉の数の最大値 ( 0 or 2 <= cut_size <= 6 )
+  ///
+  /// 0 の時は極大 AND 木ごとに CNF を作る(デフォルト)．
+  /// 既に作られた CNF はそのまま使われる．
+  void
+  set_cut_size(ymuint cut_size);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードに対応する変数を返す．
+  /// @param[in] node 対象のノード(反転属性なし)
+  ///
+  /// 変数を持っていなければ CNF を作る．
+  VarId
+  node_var(Aig node);
+
+  /// @brief mVarMap の大きさを id を含むように調整する．
+  /// @param[in] id ノード番号
+  void
+  resize_map(ymuint id);
+
+  /// @brief 極大 AND 木の葉を求める．
+  /// @param[in] edge 対象の枝
+  /// @param[out] leaf_list 葉のリスト
+  /// @return 葉に定数0が含まれていたら false を返す．
+  bool
+  find_leaves(Aig edge,
+	      vector<Aig>& leaf_list);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -72,8 +133,43 @@ private:
   // SAT-solver
   SatSolver& mSolver;
 
+  // ノードの変数
+  // キーはノード番号
+  // まだ CNF を作っていないノードは kVarIdIllegal
+  vector<VarId> mVarMap;
+
+  // 極大 AND 木を探すときの訪問済みの印
+  // キーはノード番号
+  vector<ymuint32> mMark;
+
+  // mMark の現在の値
+  ymuint32 mCurMark;
+
+  // 変数を割り当てた外部入力のリスト
+  vector<Aig> mInputList;
+
+  // 定数1を表す変数
+  VarId mConstVar;
+
+  // カットによる CNF を作るオブジェクト
+  // 極大 AND 木ごとに作る時は nullptr
+  AigCutCnf* mCutCnf;
+
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 用いている SAT-solver を返す．
+inline
+SatSolver&
+AigSatMgr::solver()
+{
+  return mSolver;
+}
+
 END_NAMESPACE_YM_AIG
 
-#endif // YM_YMYMLOGIC_AIGMGR_H
+#endif // YMYMLOGIC_AIGSATMGR_H
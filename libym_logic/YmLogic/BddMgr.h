@@ -53,6 +53,116 @@ struct BddMgrParam
 };
 
 
+//////////////////////////////////////////////////////////////////////
+/// @class BddTblStats BddMgr.h "YmLogic/BddMgr.h"
+/// @ingroup Bdd
+/// @brief 演算結果テーブル一つ分の統計情報を表す構造体．
+///
+/// 演算結果テーブルはダイレクトマップ方式なので，
+/// 登録時に別のキーのエントリを上書きした回数を衝突回数としている．
+/// @sa BddMgrStats
+//////////////////////////////////////////////////////////////////////
+struct BddTblStats
+{
+  /// @brief テーブル名(演算名)
+  string mName;
+
+  /// @brief テーブルサイズ(セル数)
+  ymuint64 mTableSize;
+
+  /// @brief 使用中のセル数
+  ymuint64 mUsedNum;
+
+  /// @brief 検索回数
+  ymuint64 mLookupNum;
+
+  /// @brief 検索がヒットした回数
+  ymuint64 mHitNum;
+
+  /// @brief 登録回数
+  ymuint64 mInsertNum;
+
+  /// @brief 登録時に別のエントリを上書きした回数
+  ymuint64 mCollisionNum;
+
+  /// @brief テーブルを拡張した回数
+  ymuint64 mResizeNum;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BddNtResizeEvent BddMgr.h "YmLogic/BddMgr.h"
+/// @ingroup Bdd
+/// @brief 節点テーブルのサイズ変更の記録
+/// @sa BddMgrStats
+//////////////////////////////////////////////////////////////////////
+struct BddNtResizeEvent
+{
+  /// @brief 変更前のサイズ
+  ymuint64 mOldSize;
+
+  /// @brief 変更後のサイズ
+  ymuint64 mNewSize;
+
+  /// @brief 変更時のノード数
+  ymuint64 mNodeNum;
+
+  /// @brief 変更時までの GC の回数
+  ymuint64 mGcCount;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BddMgrStats BddMgr.h "YmLogic/BddMgr.h"
+/// @ingroup Bdd
+/// @brief BddMgr の内部の統計情報を表す構造体．
+///
+/// GC の停止時間のヒストグラムは 2 のべき乗(マイクロ秒単位)で
+/// 区切られており，mGcHist[i] は 2^(i-1) 以上 2^i 未満の回数を表す．
+/// (mGcHist[0] は 1 マイクロ秒未満，最後の要素はそれ以上全て)
+/// @sa BddMgr::get_stats()
+//////////////////////////////////////////////////////////////////////
+struct BddMgrStats
+{
+  /// @brief GC 停止時間のヒストグラムの要素数
+  static
+  const ymuint32 kGcHistSize = 32;
+
+  /// @brief 演算結果テーブルごとの統計情報のリスト
+  vector<BddTblStats> mTblList;
+
+  /// @brief 節点テーブルのサイズ
+  ymuint64 mNtSize;
+
+  /// @brief 節点テーブルに登録されているノード数
+  ymuint64 mNodeNum;
+
+  /// @brief GC で回収されるノード数
+  ymuint64 mGarbageNum;
+
+  /// @brief 節点テーブル中の空でないエントリ数
+  ymuint64 mNtUsedNum;
+
+  /// @brief 節点テーブル中の最長の衝突チェインの長さ
+  ymuint64 mNtMaxChain;
+
+  /// @brief 節点テーブルのサイズ変更の記録
+  vector<BddNtResizeEvent> mNtResizeList;
+
+  /// @brief GC の回数
+  ymuint64 mGcNum;
+
+  /// @brief GC の停止時間の合計(マイクロ秒)
+  double mGcTotalTime;
+
+  /// @brief GC の最大停止時間(マイクロ秒)
+  double mGcMaxTime;
+
+  /// @brief GC の停止時間のヒストグラム
+  ymuint64 mGcHist[kGcHistSize];
+};
+
+
 //////////////////////////////////////////////////////////////////////
 /// @class BddMgr BddMgr.h "YmLogic/BddMgr.h"
 /// @ingroup Bdd
@@ -393,6 +503,38 @@ public:
   //////////////////////////////////////////////////////////////////////
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 統計情報
+  /// @{
+
+  /// @brief 内部の統計情報を得る．
+  /// @param[out] stats 結果を格納する変数
+  /// @note 節点テーブルの走査を行うのでそれなりに時間がかかる．
+  void
+  get_stats(BddMgrStats& stats) const;
+
+  /// @brief 内部の統計情報を出力する．
+  /// @param[in] s 出力先のストリーム
+  void
+  print_stats(ostream& s) const;
+
+  /// @brief 統計情報を定期的にログ出力する間隔を設定する．
+  /// @param[in] interval GC の回数
+  /// @note interval 回の GC ごとに print_stats(logstream()) を行う．
+  /// 0 の場合は出力しない(デフォルト)．
+  void
+  set_stats_interval(ymuint interval);
+
+  /// @brief 統計情報のカウンタをクリアする．
+  /// @note テーブルサイズや使用中のセル数などの現在の状態は変わらない．
+  void
+  clear_stats();
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // 非公開関数
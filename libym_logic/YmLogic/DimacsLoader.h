@@ -0,0 +1,225 @@
+﻿#ifndef YMYMLOGIC_DIMACSLOADER_H
+#define YMYMLOGIC_DIMACSLOADER_H
+
+/// @file YmLogic/DimacsLoader.h
+/// @brief DimacsLoader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmLogic/sat_nsdef.h"
+#include "YmLogic/Literal.h"
+#include "YmUtils/IDO.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class DimacsLoader DimacsLoader.h "YmLogic/DimacsLoader.h"
+/// @ingroup SatGroup
+/// @brief DIMACS 形式の CNF ファイルを SatSolver に直接読み込むクラス
+/// @sa DimacsParser
+///
+/// DimacsParser + SatDimacsHandler と同じ結果になるが，
+/// トークン単位のオブジェクトや節ごとの vector を作らずに
+/// 入力バッファから直接整数を読んで SatSolver::add_clause() を呼ぶ．
+/// また，"p cnf" 行の情報で SatSolver::reserve() を一度だけ呼ぶ．
+///
+/// 通常のファイルは mmap して読み込む．
+/// ファイル名が ".gz", ".bz2", ".xz" で終わっている場合には
+/// 対応する伸長を行いながら逐次読み込む．
+//////////////////////////////////////////////////////////////////////
+class DimacsLoader
+{
+public:
+
+  /// @brief コンストラクタ
+  DimacsLoader();
+
+  /// @brief デストラクタ
+  ~DimacsLoader();
+
+
+public:
+
+  /// @brief ファイルを読み込む．
+  /// @param[in] filename ファイル名
+  /// @param[in] solver 節を追加する SAT ソルバ
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  load(const string& filename,
+       SatSolver& solver);
+
+  /// @brief IDO から読み込む．
+  /// @param[in] ido 入力データ
+  /// @param[in] solver 節を追加する SAT ソルバ
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  load(IDO& ido,
+       SatSolver& solver);
+
+  /// @brief "p cnf" 行で宣言された変数の数を返す．
+  ymuint
+  declared_var_num() const;
+
+  /// @brief "p cnf" 行で宣言された節の数を返す．
+  ymuint
+  declared_clause_num() const;
+
+  /// @brief 実際に生成した変数の数を返す．
+  ///
+  /// 宣言よりも大きな番号の変数が現れた場合には宣言よりも大きくなる．
+  ymuint
+  var_num() const;
+
+  /// @brief 実際に読み込んだ節の数を返す．
+  ymuint
+  clause_num() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み込みの本体
+  /// @param[in] file_info エラーメッセージ用のファイル情報
+  /// @param[in] solver 節を追加する SAT ソルバ
+  bool
+  load_sub(const FileInfo& file_info,
+	   SatSolver& solver);
+
+  /// @brief バッファを補充する．
+  /// @return データが残っていなければ false を返す．
+  bool
+  fill();
+
+  /// @brief 次の文字を返す．
+  /// @note 読み出し位置は進めない．
+  /// @note 末尾に達したら EOF を返す．
+  int
+  peek();
+
+  /// @brief 改行以外の空白を読み飛ばす．
+  void
+  skip_blank();
+
+  /// @brief 空白と改行を読み飛ばす．
+  void
+  skip_space();
+
+  /// @brief 行末まで読み飛ばす．
+  void
+  skip_line();
+
+  /// @brief 符号付きの整数を読み込む．
+  /// @param[out] val 読み込んだ値
+  /// @return 数字が現れなかったら false を返す．
+  /// @note 先頭の空白は読み飛ばさない．
+  bool
+  read_int(int& val);
+
+  /// @brief エラーメッセージを出力する．
+  /// @param[in] file_info ファイル情報
+  /// @param[in] label ラベル
+  /// @param[in] msg メッセージ
+  void
+  error(const FileInfo& file_info,
+	const char* label,
+	const char* msg);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 逐次読み込みの時の入力元
+  // mmap したデータを読む時は nullptr
+  IDO* mIdo;
+
+  // 逐次読み込みの時のバッファ
+  vector<ymuint8> mBuff;
+
+  // 現在の読み出し位置
+  const ymuint8* mCur;
+
+  // 読み出し可能な領域の末尾
+  const ymuint8* mEnd;
+
+  // 現在の行番号
+  ymuint mLineNo;
+
+  // 宣言された変数の数
+  ymuint mDecVarNum;
+
+  // 宣言された節の数
+  ymuint mDecClauseNum;
+
+  // 生成した変数の数
+  ymuint mVarNum;
+
+  // 読み込んだ節の数
+  ymuint mClauseNum;
+
+  // 節のリテラルを格納する作業領域
+  // 節ごとに再利用する．
+  vector<Literal> mLits;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief "p cnf" 行で宣言された変数の数を返す．
+inline
+ymuint
+DimacsLoader::declared_var_num() const
+{
+  return mDecVarNum;
+}
+
+// @brief "p cnf" 行で宣言された節の数を返す．
+inline
+ymuint
+DimacsLoader::declared_clause_num() const
+{
+  return mDecClauseNum;
+}
+
+// @brief 実際に生成した変数の数を返す．
+inline
+ymuint
+DimacsLoader::var_num() const
+{
+  return mVarNum;
+}
+
+// @brief 実際に読み込んだ節の数を返す．
+inline
+ymuint
+DimacsLoader::clause_num() const
+{
+  return mClauseNum;
+}
+
+// @brief 次の文字を返す．
+inline
+int
+DimacsLoader::peek()
+{
+  if ( mCur == mEnd && !fill() ) {
+    return EOF;
+  }
+  return *mCur;
+}
+
+END_NAMESPACE_YM_SAT
+
+#endif // YMYMLOGIC_DIMACSLOADER_H
@@ -46,6 +46,7 @@ class ExprNode;
 class Expr
 {
   friend class ExprMgr;
+  friend class ExprCode;
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -0,0 +1,260 @@
+﻿#ifndef YMYMLOGIC_EXPRCODE_H
+#define YMYMLOGIC_EXPRCODE_H
+
+/// @file YmLogic/ExprCode.h
+/// @brief ExprCode のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmLogic/expr_nsdef.h"
+#include "YmUtils/HashMap.h"
+
+
+BEGIN_NAMESPACE_YM
+
+// クラス名の先行宣言
+class TvFunc;
+
+END_NAMESPACE_YM
+
+BEGIN_NAMESPACE_YM_EXPR
+
+class ExprNode;
+
+//////////////////////////////////////////////////////////////////////
+/// @class ExprCode ExprCode.h "YmLogic/ExprCode.h"
+/// @ingroup ExprGroup
+/// @brief 論理式を評価用の命令列に変換したもの
+///
+/// 論理式の DAG をトポロジカル順の 2 項演算(AND/OR/XOR/NOT)の命令列に
+/// 変換する．各命令はレジスタ番号で入出力を指定する．
+/// レジスタの 0 番から input_num() - 1 番までが入力変数に対応し，
+/// それ以降が中間結果用のレジスタとなる．
+/// 中間結果用のレジスタは参照されなくなった時点で再利用される．
+///
+/// 同じ論理式を何度も評価する場合には Expr::eval() の代わりに
+/// 一度だけ変換した ExprCode を保持して用いる．
+/// 複数ワード版の eval() は 1 命令ごとにワード数分のループを回すので
+/// ワード数が大きい時ほど効率がよい．
+/// 何度も呼び出す場合には作業領域を引数にとる版を用いれば
+/// 呼び出しごとのメモリ確保を避けられる．
+/// eval() は内部状態を変更しないので，作業領域をスレッドごとに
+/// 用意すれば複数のスレッドから同時に呼び出してもよい．
+/// @sa Expr
+//////////////////////////////////////////////////////////////////////
+class ExprCode
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  /// @note 定数0を表す．
+  ExprCode();
+
+  /// @brief 論理式を指定したコンストラクタ
+  /// @param[in] expr 対象の論理式
+  explicit
+  ExprCode(const Expr& expr);
+
+  /// @brief デストラクタ
+  ~ExprCode();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 論理式を変換する．
+  /// @param[in] expr 対象の論理式
+  /// @note 以前の内容は破棄される．
+  void
+  compile(const Expr& expr);
+
+  /// @brief 入力数を返す．
+  /// @note 論理式に現れる最大の変数番号 + 1 となる．
+  ymuint
+  input_num() const;
+
+  /// @brief 中間結果用のレジスタ数を返す．
+  ymuint
+  reg_num() const;
+
+  /// @brief 命令数を返す．
+  ymuint
+  instr_num() const;
+
+  /// @brief 値の評価
+  /// @param[in] vals 変数の値割り当て
+  /// @param[in] mask 使用するビットのためのマスク
+  /// @return 評価値
+  /// @note Expr::eval() と同じ結果を返す．
+  ymulong
+  eval(const vector<ymulong>& vals,
+       ymulong mask = ~0UL) const;
+
+  /// @brief 複数ワードの値の評価
+  /// @param[in] vals 変数の値割り当て
+  /// @param[in] wn 1変数あたりのワード数
+  /// @param[out] out 評価値を格納する領域
+  /// @note vals は変数番号 x wn + ワード位置 で参照される．
+  /// 少なくとも input_num() x wn の大きさが必要．
+  /// @note out は wn の大きさが必要．
+  void
+  eval(const ymuint64* vals,
+       ymuint wn,
+       ymuint64* out) const;
+
+  /// @brief 作業領域を指定した複数ワードの値の評価
+  /// @param[in] vals 変数の値割り当て
+  /// @param[in] wn 1変数あたりのワード数
+  /// @param[out] out 評価値を格納する領域
+  /// @param[in] work 中間結果用の作業領域
+  /// @note work は足りない時だけ拡張されるので，同じものを
+  /// 使い回せば 2 回目以降はメモリ確保が起こらない．
+  void
+  eval(const ymuint64* vals,
+       ymuint wn,
+       ymuint64* out,
+       vector<ymuint64>& work) const;
+
+  /// @brief 真理値表の作成
+  /// @param[in] ni 入力数
+  /// @note ni が input_num() より小さい場合には input_num() が用いられる．
+  TvFunc
+  make_tv(ymuint ni = 0) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 命令の種類
+  enum tOpCode {
+    kOpConst0,
+    kOpConst1,
+    kOpNot,
+    kOpAnd,
+    kOpOr,
+    kOpXor
+  };
+
+  /// @brief 命令
+  struct Instr
+  {
+    // 命令の種類
+    ymuint32 mOpCode;
+
+    // 結果を格納するレジスタ
+    ymuint32 mDst;
+
+    // 第1オペランドのレジスタ
+    ymuint32 mSrc1;
+
+    // 第2オペランドのレジスタ
+    ymuint32 mSrc2;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの参照回数を数える．
+  /// @param[in] node 対象のノード
+  /// @param[in] ref_map 参照回数を格納するハッシュ表
+  void
+  count_ref(const ExprNode* node,
+	    HashMap<ympuint, ymuint>& ref_map);
+
+  /// @brief ノードを変換する．
+  /// @param[in] node 対象のノード
+  /// @param[in] ref_map 参照回数を格納するハッシュ表
+  /// @param[in] reg_map 結果のレジスタを格納するハッシュ表
+  /// @return 結果のレジスタ番号を返す．
+  ymuint
+  compile_node(const ExprNode* node,
+	       HashMap<ympuint, ymuint>& ref_map,
+	       HashMap<ympuint, ymuint>& reg_map);
+
+  /// @brief ノードの参照が一つ終わったことを記録する．
+  /// @param[in] node 対象のノード
+  /// @param[in] ref_map 参照回数を格納するハッシュ表
+  /// @param[in] reg_map 結果のレジスタを格納するハッシュ表
+  /// @note 参照回数が 0 になったら中間結果用のレジスタを解放する．
+  void
+  release_node(const ExprNode* node,
+	       HashMap<ympuint, ymuint>& ref_map,
+	       HashMap<ympuint, ymuint>& reg_map);
+
+  /// @brief 中間結果用のレジスタを確保する．
+  ymuint
+  new_reg();
+
+  /// @brief 命令を追加する．
+  void
+  add_instr(tOpCode op,
+	    ymuint dst,
+	    ymuint src1 = 0,
+	    ymuint src2 = 0);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力数
+  ymuint32 mInputNum;
+
+  // 中間結果用のレジスタ数
+  ymuint32 mRegNum;
+
+  // 結果を格納するレジスタ
+  ymuint32 mOutReg;
+
+  // 命令のリスト
+  vector<Instr> mInstrList;
+
+  // 空いている中間結果用のレジスタのリスト
+  // compile() 中のみ用いる．
+  vector<ymuint32> mFreeRegList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 入力数を返す．
+inline
+ymuint
+ExprCode::input_num() const
+{
+  return mInputNum;
+}
+
+// @brief 中間結果用のレジスタ数を返す．
+inline
+ymuint
+ExprCode::reg_num() const
+{
+  return mRegNum;
+}
+
+// @brief 命令数を返す．
+inline
+ymuint
+ExprCode::instr_num() const
+{
+  return mInstrList.size();
+}
+
+END_NAMESPACE_YM_EXPR
+
+#endif // YMYMLOGIC_EXPRCODE_H
@@ -54,11 +54,28 @@ public:
   VarId
   new_var(bool decision = true);
 
+  /// @brief 変数と節の領域をあらかじめ確保する．
+  /// @param[in] var_num これから追加する変数の数
+  /// @param[in] clause_num これから追加する節の数
+  ///
+  /// 単なるヒントなので呼ばなくても動作は変わらない．
+  /// DIMACS ファイルの読み込みのように規模が事前にわかる時に用いる．
+  void
+  reserve(ymuint var_num,
+	  ymuint clause_num);
+
   /// @brief 節を追加する．
   /// @param[in] lits リテラルのベクタ
   void
   add_clause(const vector<Literal>& lits);
 
+  /// @brief 節を追加する．
+  /// @param[in] lit_num リテラル数
+  /// @param[in] lits リテラルの配列
+  void
+  add_clause(ymuint lit_num,
+	     const Literal* lits);
+
   /// @brief 1項の節(リテラル)を追加する．
   void
   add_clause(Literal lit1);
@@ -115,9 +132,14 @@ public:
   /// @brief 探索を中止する．
   ///
   /// 割り込みハンドラや別スレッドから非同期に呼ばれることを仮定している．
+  /// 中止要求は clear_stop() を呼ぶまで取り消されない．
   void
   stop();
 
+  /// @brief stop() による中止要求を取り消す．
+  void
+  clear_stop();
+
   /// @brief 学習節をすべて削除する．
   void
   forget_learnt_clause();
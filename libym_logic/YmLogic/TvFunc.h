@@ -11,6 +11,7 @@
 
 #include "YmLogic/VarId.h"
 #include "YmLogic/npn_nsdef.h"
+#include "YmLogic/expr_nsdef.h"
 #include "YmUtils/HashBase.h"
 #include "YmUtils/IDO.h"
 #include "YmUtils/ODO.h"
@@ -39,6 +40,14 @@ public:
   TvFunc(ymuint ni,
 	 const vector<int>& values);
 
+  /// @brief 入力数と内部表現のブロックを指定したコンストラクタ
+  /// @param[in] ni 入力数
+  /// @param[in] blocks 64 個の真理値を1ワードにまとめたブロックのベクタ
+  /// @note blocks[i] の j ビット目が i x 64 + j 番目の真理値となる．
+  /// @note ni が 6 未満の場合には使われないビットは無視される．
+  TvFunc(ymuint ni,
+	 const vector<ymuint64>& blocks);
+
   /// @brief コピーコンストラクタ
   /// @param[in] src コピー元のソースオブジェクト
   TvFunc(const TvFunc& src);
@@ -264,6 +273,11 @@ public:
   TvFunc
   xform(const NpnMap& npnmap) const;
 
+  /// @brief 非冗長積和形論理式を返す．
+  /// @note isop(*this, *this, cover) の cover と同じものを返す．
+  Expr
+  sop() const;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -307,6 +321,12 @@ public:
   operator&&(const TvFunc& left,
 	     const TvFunc& right);
 
+  friend
+  TvFunc
+  isop(const TvFunc& lower,
+       const TvFunc& upper,
+       vector<ymuint64>& cube_list);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -464,6 +484,35 @@ bool
 operator&&(const TvFunc& left,
 	   const TvFunc& right);
 
+/// @relates TvFunc
+/// @brief 非冗長積和形を求める．
+/// @param[in] lower 下限(on set)
+/// @param[in] upper 上限(on set + don't care set)
+/// @param[out] cube_list 結果のキューブのリスト
+/// @return 結果の積和形の表す関数を返す．
+/// @note Minato-Morreale のアルゴリズムを真理値表の上で直接行う．
+/// @note 各キューブはリテラルごとに1ビットを割り当てたビットベクタで
+/// 表す．変数 varid の肯定リテラルは (varid * 2) ビット目，
+/// 否定リテラルは (varid * 2 + 1) ビット目となる(Literal::index() と同じ)．
+/// そのため入力数は 32 以下でなければならない．
+/// @note lower と upper の入力数は等しく，lower は upper に含まれなければならない．
+/// @note 入力数が 6 以下の時は cube_list への追加以外にメモリ確保を行わない．
+TvFunc
+isop(const TvFunc& lower,
+     const TvFunc& upper,
+     vector<ymuint64>& cube_list);
+
+/// @relates TvFunc
+/// @brief 非冗長積和形を求める．
+/// @param[in] lower 下限(on set)
+/// @param[in] upper 上限(on set + don't care set)
+/// @param[out] cover 結果の式を納める変数
+/// @return cover の表す関数を返す．
+TvFunc
+isop(const TvFunc& lower,
+     const TvFunc& upper,
+     Expr& cover);
+
 /// @relates TvFunc
 /// @brief ストリームに対する出力
 /// @param[in] s 出力先のストリーム
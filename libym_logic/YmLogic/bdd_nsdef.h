@@ -49,6 +49,9 @@ BEGIN_NAMESPACE_YM_BDD
 class Bdd;
 class BddMgr;
 class BddMgrParam;
+class BddTblStats;
+class BddNtResizeEvent;
+class BddMgrStats;
 class BddVarSet;
 class BddLitSet;
 class BddVector;
@@ -61,6 +64,9 @@ BEGIN_NAMESPACE_YM
 using nsBdd::Bdd;
 using nsBdd::BddMgr;
 using nsBdd::BddMgrParam;
+using nsBdd::BddTblStats;
+using nsBdd::BddNtResizeEvent;
+using nsBdd::BddMgrStats;
 using nsBdd::BddVarSet;
 using nsBdd::BddLitSet;
 using nsBdd::BddVector;
@@ -35,6 +35,7 @@ BEGIN_NAMESPACE_YM_EXPR
 //////////////////////////////////////////////////////////////////////
 
 class Expr;
+class ExprCode;
 class ExprWriter;
 
 END_NAMESPACE_YM_EXPR
@@ -43,6 +44,7 @@ END_NAMESPACE_YM_EXPR
 BEGIN_NAMESPACE_YM
 
 using nsExpr::Expr;
+using nsExpr::ExprCode;
 using nsExpr::ExprWriter;
 
 //////////////////////////////////////////////////////////////////////
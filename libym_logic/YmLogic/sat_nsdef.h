@@ -42,6 +42,7 @@ class SatMsgHandler;
 class SatMsgHandlerImpl1;
 
 class DimacsParser;
+class DimacsLoader;
 class DimacsHandler;
 class DimacsVerifier;
 class SatDimacsHandler;
@@ -56,6 +57,7 @@ using nsSat::SatMsgHandler;
 using nsSat::SatMsgHandlerImpl1;
 
 using nsSat::DimacsParser;
+using nsSat::DimacsLoader;
 using nsSat::DimacsHandler;
 using nsSat::DimacsVerifier;
 using nsSat::SatDimacsHandler;
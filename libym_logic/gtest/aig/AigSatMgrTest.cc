@@ -0,0 +1,310 @@
+
+/// @file AigSatMgrTest.cc
+/// @brief AigSatMgrTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmLogic/AigMgr.h"
+#include "YmLogic/AigSatMgr.h"
+#include "YmLogic/SatSolver.h"
+#include "YmUtils/RandGen.h"
+
+
+BEGIN_NAMESPACE_YM
+
+class AigSatMgrTest :
+  public testing::Test
+{
+public:
+
+  // コンストラクタ
+  AigSatMgrTest();
+
+
+public:
+
+  AigMgr mAigMgr;
+
+  SatSolver mSolver;
+
+  AigSatMgr mSatMgr;
+
+};
+
+AigSatMgrTest::AigSatMgrTest() :
+  mSatMgr(mAigMgr, mSolver)
+{
+}
+
+BEGIN_NONAMESPACE
+
+// AIG を評価する．
+// model に値のない入力は 0 とみなす．
+bool
+eval_aig(Aig edge,
+	 const vector<Bool3>& model,
+	 vector<int>& val_map)
+{
+  if ( edge.is_const() ) {
+    return edge.is_one();
+  }
+  ymuint id = edge.node_id();
+  if ( val_map.size() <= id ) {
+    val_map.resize(id + 1, -1);
+  }
+  if ( val_map[id] == -1 ) {
+    bool val;
+    if ( edge.is_input() ) {
+      ymuint iid = edge.input_id().val();
+      val = iid < model.size() && model[iid] == kB3True;
+    }
+    else {
+      val = eval_aig(edge.fanin0(), model, val_map) &&
+	eval_aig(edge.fanin1(), model, val_map);
+    }
+    val_map[id] = val ? 1 : 0;
+  }
+  return static_cast<bool>(val_map[id]) ^ edge.inv();
+}
+
+END_NONAMESPACE
+
+TEST_F(AigSatMgrTest, sat1)
+{
+  Aig a = mAigMgr.make_input(VarId(0));
+  Aig b = mAigMgr.make_input(VarId(1));
+  Aig c = mAigMgr.make_input(VarId(2));
+  Aig f = mAigMgr.make_and(mAigMgr.make_and(a, ~b), c);
+
+  vector<Bool3> model;
+  Bool3 ans = mSatMgr.sat(f, model);
+
+  EXPECT_EQ( kB3True,  ans );
+  ASSERT_EQ( 3, model.size() );
+  EXPECT_EQ( kB3True,  model[0] );
+  EXPECT_EQ( kB3False, model[1] );
+  EXPECT_EQ( kB3True,  model[2] );
+}
+
+TEST_F(AigSatMgrTest, unsat1)
+{
+  Aig a = mAigMgr.make_input(VarId(0));
+  Aig b = mAigMgr.make_input(VarId(1));
+  Aig f = mAigMgr.make_and(a, b);
+
+  vector<Aig> edge_list;
+  edge_list.push_back(f);
+  edge_list.push_back(~a);
+
+  vector<Bool3> model;
+  Bool3 ans = mSatMgr.sat(edge_list, model);
+
+  EXPECT_EQ( kB3False, ans );
+}
+
+TEST_F(AigSatMgrTest, const1)
+{
+  vector<Bool3> model;
+  EXPECT_EQ( kB3False, mSatMgr.sat(mAigMgr.make_zero(), model) );
+  EXPECT_EQ( kB3True,  mSatMgr.sat(mAigMgr.make_one(), model) );
+}
+
+TEST_F(AigSatMgrTest, incremental)
+{
+  Aig a = mAigMgr.make_input(VarId(0));
+  Aig b = mAigMgr.make_input(VarId(1));
+  Aig c = mAigMgr.make_input(VarId(2));
+
+  // (a & b) | (a & c) と a & (b | c) は等価
+  Aig f1 = mAigMgr.make_or(mAigMgr.make_and(a, b), mAigMgr.make_and(a, c));
+  Aig f2 = mAigMgr.make_and(a, mAigMgr.make_or(b, c));
+
+  vector<Bool3> model;
+  EXPECT_EQ( kB3True,  mSatMgr.sat(f1, model) );
+  ymuint nv1 = mSolver.variable_num();
+
+  // 2回目は既に CNF になっている部分は作らない．
+  EXPECT_EQ( kB3True,  mSatMgr.sat(f1, model) );
+  EXPECT_EQ( nv1, mSolver.variable_num() );
+
+  EXPECT_EQ( kB3False, mSatMgr.sat(mAigMgr.make_xor(f1, f2), model) );
+
+  // b & c のノードは f1, f2 のどちらにも現れないので新しく作られる．
+  Aig f3 = mAigMgr.make_and(f2, mAigMgr.make_and(b, c));
+  EXPECT_EQ( kB3True,  mSatMgr.sat(f3, model) );
+  ASSERT_EQ( 3, model.size() );
+  EXPECT_EQ( kB3True,  model[0] );
+  EXPECT_EQ( kB3True,  model[1] );
+  EXPECT_EQ( kB3True,  model[2] );
+
+  EXPECT_EQ( kB3False, mSatMgr.sat(mAigMgr.make_and(f3, ~f1), model) );
+}
+
+TEST_F(AigSatMgrTest, make_literal)
+{
+  Aig a = mAigMgr.make_input(VarId(0));
+  Aig b = mAigMgr.make_input(VarId(1));
+  Aig f = mAigMgr.make_or(a, b);
+
+  // f を常に 0 にする制約を直接加える．
+  Literal lit = mSatMgr.make_literal(f);
+  mSolver.add_clause(~lit);
+
+  vector<Bool3> model;
+  EXPECT_EQ( kB3False, mSatMgr.sat(a, model) );
+  EXPECT_EQ( kB3True,  mSatMgr.sat(~b, model) );
+  ASSERT_EQ( 2, model.size() );
+  EXPECT_EQ( kB3False, model[0] );
+  EXPECT_EQ( kB3False, model[1] );
+}
+
+TEST_F(AigSatMgrTest, cut_sat1)
+{
+  mSatMgr.set_cut_size(4);
+
+  Aig a = mAigMgr.make_input(VarId(0));
+  Aig b = mAigMgr.make_input(VarId(1));
+  Aig c = mAigMgr.make_input(VarId(2));
+  Aig f = mAigMgr.make_and(mAigMgr.make_and(a, ~b), c);
+
+  vector<Bool3> model;
+  Bool3 ans = mSatMgr.sat(f, model);
+
+  EXPECT_EQ( kB3True,  ans );
+  ASSERT_EQ( 3, model.size() );
+  EXPECT_EQ( kB3True,  model[0] );
+  EXPECT_EQ( kB3False, model[1] );
+  EXPECT_EQ( kB3True,  model[2] );
+
+  // 2つの AND は1つのカットにまとめられる．
+  EXPECT_EQ( 4, mSolver.variable_num() );
+}
+
+TEST_F(AigSatMgrTest, cut_incremental)
+{
+  mSatMgr.set_cut_size(4);
+
+  Aig a = mAigMgr.make_input(VarId(0));
+  Aig b = mAigMgr.make_input(VarId(1));
+  Aig c = mAigMgr.make_input(VarId(2));
+
+  Aig f1 = mAigMgr.make_or(mAigMgr.make_and(a, b), mAigMgr.make_and(a, c));
+  Aig f2 = mAigMgr.make_and(a, mAigMgr.make_or(b, c));
+
+  vector<Bool3> model;
+  EXPECT_EQ( kB3True,  mSatMgr.sat(f1, model) );
+  ymuint nv1 = mSolver.variable_num();
+
+  EXPECT_EQ( kB3True,  mSatMgr.sat(f1, model) );
+  EXPECT_EQ( nv1, mSolver.variable_num() );
+
+  EXPECT_EQ( kB3False, mSatMgr.sat(mAigMgr.make_xor(f1, f2), model) );
+
+  // f1 の内部のノードは変数を持たないので make_literal() で新たに作られる．
+  Aig g = mAigMgr.make_and(a, b);
+  Literal lit = mSatMgr.make_literal(g);
+  vector<Literal> assumptions(1, lit);
+  assumptions.push_back(mSatMgr.make_literal(~f1));
+  vector<Bool3> sat_model;
+  EXPECT_EQ( kB3False, mSolver.solve(assumptions, sat_model) );
+}
+
+TEST_F(AigSatMgrTest, cut_parity)
+{
+  // 線形と木状の2通りのパリティ回路の等価性を調べる．
+  const ymuint ni = 16;
+  vector<Aig> input_list(ni);
+  for (ymuint i = 0; i < ni; ++ i) {
+    input_list[i] = mAigMgr.make_input(VarId(i));
+  }
+  Aig f1 = input_list[0];
+  for (ymuint i = 1; i < ni; ++ i) {
+    f1 = mAigMgr.make_xor(f1, input_list[i]);
+  }
+  vector<Aig> tmp_list(input_list);
+  while ( tmp_list.size() > 1 ) {
+    vector<Aig> next_list;
+    for (ymuint i = 0; i + 1 < tmp_list.size(); i += 2) {
+      next_list.push_back(mAigMgr.make_xor(tmp_list[i], tmp_list[i + 1]));
+    }
+    if ( tmp_list.size() % 2 ) {
+      next_list.push_back(tmp_list.back());
+    }
+    tmp_list.swap(next_list);
+  }
+  Aig f2 = tmp_list[0];
+  Aig miter = mAigMgr.make_xor(f1, f2);
+
+  vector<Bool3> model;
+  EXPECT_EQ( kB3False, mSatMgr.sat(miter, model) );
+
+  SatSolver solver2;
+  AigSatMgr satmgr2(mAigMgr, solver2);
+  satmgr2.set_cut_size(4);
+  EXPECT_EQ( kB3False, satmgr2.sat(miter, model) );
+
+  // カットによる CNF の方が変数も節も少ない．
+  EXPECT_LT( solver2.variable_num(), mSolver.variable_num() );
+  EXPECT_LT( solver2.clause_num(), mSolver.clause_num() );
+}
+
+TEST_F(AigSatMgrTest, cut_random)
+{
+  // ランダムな AIG で極大 AND 木による CNF と結果を比べる．
+  RandGen rg;
+  rg.init(1);
+  const ymuint ni = 10;
+  vector<Aig> node_list;
+  for (ymuint i = 0; i < ni; ++ i) {
+    node_list.push_back(mAigMgr.make_input(VarId(i)));
+  }
+  for (ymuint i = 0; i < 300; ++ i) {
+    ymuint n = node_list.size();
+    Aig a = node_list[rg.int32() % n];
+    Aig b = node_list[rg.int32() % n];
+    if ( rg.int32() & 1 ) {
+      a = ~a;
+    }
+    if ( rg.int32() & 1 ) {
+      b = ~b;
+    }
+    node_list.push_back(mAigMgr.make_and(a, b));
+  }
+
+  for (ymuint cut_size = 2; cut_size <= 6; ++ cut_size) {
+    SatSolver solver1;
+    AigSatMgr satmgr1(mAigMgr, solver1);
+    SatSolver solver2;
+    AigSatMgr satmgr2(mAigMgr, solver2);
+    satmgr2.set_cut_size(cut_size);
+    for (ymuint i = 0; i < 100; ++ i) {
+      vector<Aig> edge_list;
+      ymuint ne = rg.int32() % 3 + 1;
+      for (ymuint j = 0; j < ne; ++ j) {
+	Aig edge = node_list[rg.int32() % node_list.size()];
+	if ( rg.int32() & 1 ) {
+	  edge = ~edge;
+	}
+	edge_list.push_back(edge);
+      }
+      vector<Bool3> model1;
+      Bool3 ans1 = satmgr1.sat(edge_list, model1);
+      vector<Bool3> model2;
+      Bool3 ans2 = satmgr2.sat(edge_list, model2);
+      EXPECT_EQ( ans1, ans2 ) << "cut_size = " << cut_size << ", i = " << i;
+      if ( ans2 == kB3True ) {
+	vector<int> val_map;
+	for (ymuint j = 0; j < ne; ++ j) {
+	  EXPECT_TRUE( eval_aig(edge_list[j], model2, val_map) )
+	    << "cut_size = " << cut_size << ", i = " << i;
+	}
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,140 @@
+
+/// @file BddOpTest.cc
+/// @brief BddOpTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmLogic/Bdd.h"
+#include "YmLogic/BddMgr.h"
+#include "YmLogic/BddVarSet.h"
+
+
+BEGIN_NAMESPACE_YM
+
+class BddOpTest :
+  public ::testing::Test
+{
+public:
+
+  BddOpTest() :
+    mMgr("bmc", "BddOpTest")
+  {
+    for (ymuint i = 0; i < kVarNum; ++ i) {
+      mMgr.new_var(VarId(i));
+    }
+  }
+
+  // 変数の割り当てに対する値を求める．
+  // bits の i ビット目が変数 i の値となる．
+  bool
+  eval(const Bdd& f,
+       ymuint bits)
+  {
+    Bdd f1 = f;
+    for (ymuint i = 0; i < kVarNum; ++ i) {
+      f1 = f1.cofactor(VarId(i), ((bits >> i) & 1) == 0);
+    }
+    return f1.is_one();
+  }
+
+  // リテラルを作る．
+  Bdd
+  lit(ymuint var,
+      bool inv)
+  {
+    if ( inv ) {
+      return mMgr.make_negaliteral(VarId(var));
+    }
+    else {
+      return mMgr.make_posiliteral(VarId(var));
+    }
+  }
+
+  static
+  const ymuint kVarNum = 3;
+
+  BddMgr mMgr;
+
+};
+
+TEST_F(BddOpTest, xor_literal)
+{
+  // リテラル同士の XOR を極性の組み合わせごとに調べる．
+  for (ymuint p = 0; p < 4; ++ p) {
+    bool inv0 = (p & 1) != 0;
+    bool inv1 = (p & 2) != 0;
+    Bdd f = lit(0, inv0) ^ lit(1, inv1);
+    Bdd g = ~f;
+    for (ymuint bits = 0; bits < 4; ++ bits) {
+      bool v0 = (bits & 1) != 0;
+      bool v1 = (bits & 2) != 0;
+      bool exp = (v0 ^ inv0) ^ (v1 ^ inv1);
+      EXPECT_EQ( exp, eval(f, bits) );
+      EXPECT_EQ( !exp, eval(g, bits) );
+    }
+  }
+}
+
+TEST_F(BddOpTest, xor_complex)
+{
+  Bdd f = lit(0, false) & lit(1, true);
+  Bdd g = lit(1, false) | lit(2, false);
+  Bdd h = f ^ ~g;
+  for (ymuint bits = 0; bits < 8; ++ bits) {
+    bool v0 = (bits & 1) != 0;
+    bool v1 = (bits & 2) != 0;
+    bool v2 = (bits & 4) != 0;
+    bool exp = (v0 && !v1) ^ !(v1 || v2);
+    EXPECT_EQ( exp, eval(h, bits) );
+  }
+}
+
+TEST_F(BddOpTest, and_exist)
+{
+  Bdd f = lit(0, false) | lit(1, false);
+  Bdd g = lit(1, true) & lit(2, false);
+
+  // 定数0との演算
+  BddVarSet q1(mMgr, VarId(1));
+  EXPECT_TRUE( and_exist(mMgr.make_zero(), f, q1).is_zero() );
+  EXPECT_TRUE( and_exist(f, mMgr.make_zero(), q1).is_zero() );
+
+  // 消去する変数がない場合は AND と等しい．
+  BddVarSet q0(mMgr);
+  EXPECT_EQ( f & g, and_exist(f, g, q0) );
+
+  EXPECT_EQ( (f & g).esmooth(q1), and_exist(f, g, q1) );
+
+  // f, g のサポートに含まれない変数が残る場合
+  VarVector vars;
+  vars.push_back(VarId(0));
+  vars.push_back(VarId(1));
+  BddVarSet q2(mMgr, vars);
+  Bdd h = lit(2, false);
+  EXPECT_EQ( (h & g).esmooth(q2), and_exist(h, g, q2) );
+  EXPECT_EQ( lit(2, false), and_exist(h, g, q2) );
+}
+
+TEST_F(BddOpTest, esmooth)
+{
+  Bdd f = lit(0, false) & lit(2, true);
+
+  // f のサポートより後ろの変数を含む場合
+  VarVector vars;
+  vars.push_back(VarId(0));
+  vars.push_back(VarId(1));
+  BddVarSet q(mMgr, vars);
+  EXPECT_EQ( lit(2, true), f.esmooth(q) );
+
+  VarVector vars2;
+  vars2.push_back(VarId(1));
+  vars2.push_back(VarId(2));
+  BddVarSet q2(mMgr, vars2);
+  EXPECT_EQ( lit(0, false), f.esmooth(q2) );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,150 @@
+
+/// @file BddStatsTest.cc
+/// @brief BddMgr の統計情報のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmLogic/Bdd.h"
+#include "YmLogic/BddMgr.h"
+
+
+BEGIN_NAMESPACE_YM
+
+class BddStatsTest :
+  public ::testing::TestWithParam<const char*>
+{
+public:
+
+  BddStatsTest() :
+    mMgr(GetParam(), "BddStatsTest")
+  {
+    for (ymuint i = 0; i < kVarNum; ++ i) {
+      mMgr.new_var(VarId(i));
+    }
+  }
+
+  // 悪い変数順の関数を作る．
+  // x0 x6 + x1 x7 + ... + x5 x11 はこの変数順ではノード数が指数的に増える．
+  Bdd
+  make_func()
+  {
+    Bdd f = mMgr.make_zero();
+    ymuint n = kVarNum / 2;
+    for (ymuint i = 0; i < n; ++ i) {
+      Bdd x = mMgr.make_posiliteral(VarId(i));
+      Bdd y = mMgr.make_posiliteral(VarId(i + n));
+      f |= x & y;
+    }
+    return f;
+  }
+
+  // 名前 name の演算結果テーブルの統計情報を探す．
+  const BddTblStats*
+  find_tbl(const BddMgrStats& stats,
+	   const string& name)
+  {
+    for (ymuint i = 0; i < stats.mTblList.size(); ++ i) {
+      if ( stats.mTblList[i].mName == name ) {
+	return &stats.mTblList[i];
+      }
+    }
+    return nullptr;
+  }
+
+  static
+  const ymuint kVarNum = 24;
+
+  BddMgr mMgr;
+
+};
+
+TEST_P(BddStatsTest, comp_tbl)
+{
+  Bdd f = make_func();
+  Bdd g = make_func();
+  EXPECT_EQ( f, g );
+
+  BddMgrStats stats;
+  mMgr.get_stats(stats);
+
+  const BddTblStats* and_stats = find_tbl(stats, "and_op");
+  ASSERT_TRUE( and_stats != nullptr );
+  EXPECT_LT( 0U, and_stats->mLookupNum );
+  EXPECT_LT( 0U, and_stats->mInsertNum );
+  // 2回目の計算はテーブルにヒットする．
+  EXPECT_LT( 0U, and_stats->mHitNum );
+  EXPECT_LE( and_stats->mHitNum, and_stats->mLookupNum );
+  EXPECT_LE( and_stats->mCollisionNum, and_stats->mInsertNum );
+  EXPECT_LE( and_stats->mUsedNum, and_stats->mTableSize );
+
+  // 各演算ごとに別の名前が付いている．
+  EXPECT_TRUE( find_tbl(stats, "xor_op") != nullptr );
+  EXPECT_TRUE( find_tbl(stats, "ite_op") != nullptr );
+  EXPECT_TRUE( find_tbl(stats, "ae_op") != nullptr );
+  EXPECT_TRUE( find_tbl(stats, "smooth_op") != nullptr );
+
+  mMgr.clear_stats();
+  mMgr.get_stats(stats);
+  and_stats = find_tbl(stats, "and_op");
+  ASSERT_TRUE( and_stats != nullptr );
+  EXPECT_EQ( 0U, and_stats->mLookupNum );
+  EXPECT_EQ( 0U, and_stats->mHitNum );
+  EXPECT_EQ( 0U, and_stats->mInsertNum );
+  // 現在の状態はクリアされない．
+  EXPECT_LT( 0U, and_stats->mUsedNum );
+}
+
+TEST_P(BddStatsTest, node_table)
+{
+  Bdd f = make_func();
+
+  BddMgrStats stats;
+  mMgr.get_stats(stats);
+  EXPECT_EQ( mMgr.node_num(), stats.mNodeNum );
+  EXPECT_LT( 0U, stats.mNtUsedNum );
+  EXPECT_LE( stats.mNtUsedNum, stats.mNtSize );
+  EXPECT_LE( 1U, stats.mNtMaxChain );
+
+  // 初期サイズでは収まらないので拡張が起きている．
+  ASSERT_LT( 0U, stats.mNtResizeList.size() );
+  const BddNtResizeEvent& ev = stats.mNtResizeList[0];
+  EXPECT_EQ( ev.mOldSize * 2, ev.mNewSize );
+}
+
+TEST_P(BddStatsTest, gc)
+{
+  {
+    Bdd f = make_func();
+  }
+
+  ostringstream log;
+  mMgr.set_logstream(log);
+  mMgr.set_stats_interval(1);
+  mMgr.gc(false);
+  mMgr.unset_logstream();
+
+  BddMgrStats stats;
+  mMgr.get_stats(stats);
+  EXPECT_EQ( 1U, stats.mGcNum );
+  EXPECT_LE( stats.mGcMaxTime, stats.mGcTotalTime );
+  ymuint64 n = 0;
+  for (ymuint i = 0; i < BddMgrStats::kGcHistSize; ++ i) {
+    n += stats.mGcHist[i];
+  }
+  EXPECT_EQ( 1U, n );
+  EXPECT_EQ( 0U, stats.mGarbageNum );
+
+  // 1回の GC ごとに統計情報がログに出力される．
+  EXPECT_NE( string::npos, log.str().find("statistics") );
+  EXPECT_NE( string::npos, log.str().find("and_op") );
+}
+
+INSTANTIATE_TEST_CASE_P(BddMgrType,
+			BddStatsTest,
+			::testing::Values("bmc", "bmm"));
+
+END_NAMESPACE_YM
@@ -0,0 +1,191 @@
+﻿
+/// @file ExprCodeTest.cc
+/// @brief ExprCodeTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmLogic/Expr.h"
+#include "YmLogic/ExprCode.h"
+#include "YmLogic/TvFunc.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 共有部分を持つ論理式を作る．
+// (v0 ^ v1) & ~v2 | (v0 ^ v1) & v3 | ... の形になる．
+Expr
+make_shared_expr(ymuint n)
+{
+  Expr x = Expr::make_posiliteral(VarId(0)) ^ Expr::make_posiliteral(VarId(1));
+  Expr ans = Expr::make_zero();
+  for (ymuint i = 2; i < n; ++ i) {
+    Expr lit = (i % 2) ? Expr::make_posiliteral(VarId(i)) :
+      Expr::make_negaliteral(VarId(i));
+    ans |= x & lit;
+  }
+  return ans;
+}
+
+// 簡単な擬似乱数
+ymulong
+next_rand(ymulong& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// 多くの中間結果が同時に生きている論理式を作る．
+// (v0 & v1) | (v1 & v2) | ... の形の n 入力の OR となる．
+Expr
+make_wide_expr(ymuint n)
+{
+  vector<Expr> and_list;
+  for (ymuint i = 0; i < n; ++ i) {
+    Expr lit0 = Expr::make_posiliteral(VarId(i));
+    Expr lit1 = Expr::make_negaliteral(VarId((i + 1) % n));
+    and_list.push_back(lit0 & lit1);
+  }
+  return Expr::make_or(and_list);
+}
+
+END_NONAMESPACE
+
+TEST(ExprCodeTest, const0)
+{
+  ExprCode code;
+
+  vector<ymulong> vals;
+  EXPECT_EQ( 0UL, code.eval(vals) );
+}
+
+TEST(ExprCodeTest, literal)
+{
+  ExprCode code(Expr::make_negaliteral(VarId(2)));
+
+  EXPECT_EQ( 3, code.input_num() );
+  vector<ymulong> vals(3, 0UL);
+  vals[2] = 0x5UL;
+  EXPECT_EQ( 0xAUL, code.eval(vals, 0xFUL) );
+}
+
+TEST(ExprCodeTest, eval)
+{
+  const ymuint kVarNum = 10;
+
+  Expr expr = make_shared_expr(kVarNum);
+  ExprCode code(expr);
+
+  EXPECT_EQ( kVarNum, code.input_num() );
+  ymulong seed = 88172645463325252UL;
+  for (ymuint c = 0; c < 100; ++ c) {
+    vector<ymulong> vals(kVarNum);
+    for (ymuint i = 0; i < kVarNum; ++ i) {
+      vals[i] = next_rand(seed);
+    }
+    EXPECT_EQ( expr.eval(vals), code.eval(vals) );
+    EXPECT_EQ( expr.eval(vals, 0xFFUL), code.eval(vals, 0xFFUL) );
+  }
+}
+
+TEST(ExprCodeTest, many_regs)
+{
+  // 中間結果用のレジスタがスタック上の領域に収まらない場合
+  const ymuint kVarNum = 100;
+
+  Expr expr = make_wide_expr(kVarNum);
+  ExprCode code(expr);
+
+  EXPECT_LT( 64U, code.reg_num() );
+  ymulong seed = 2463534242UL;
+  for (ymuint c = 0; c < 20; ++ c) {
+    vector<ymulong> vals(kVarNum);
+    for (ymuint i = 0; i < kVarNum; ++ i) {
+      vals[i] = next_rand(seed);
+    }
+    EXPECT_EQ( expr.eval(vals), code.eval(vals) );
+    EXPECT_EQ( expr.eval(vals, 0xFFUL), code.eval(vals, 0xFFUL) );
+  }
+}
+
+TEST(ExprCodeTest, eval_work)
+{
+  // 作業領域を使い回しても結果は変わらない．
+  const ymuint kWordNum = 8;
+  vector<ymuint64> work;
+  ymulong seed = 0x2545F4914F6CDD1DUL;
+  for (ymuint n = 3; n <= 40; ++ n) {
+    Expr expr = (n % 2) ? make_shared_expr(n) : make_wide_expr(n);
+    ExprCode code(expr);
+
+    vector<ymuint64> vals(n * kWordNum);
+    for (ymuint i = 0; i < vals.size(); ++ i) {
+      vals[i] = next_rand(seed);
+    }
+    vector<ymuint64> out1(kWordNum);
+    vector<ymuint64> out2(kWordNum);
+    code.eval(&vals[0], kWordNum, &out1[0]);
+    code.eval(&vals[0], kWordNum, &out2[0], work);
+    for (ymuint w = 0; w < kWordNum; ++ w) {
+      vector<ymulong> vals1(n);
+      for (ymuint i = 0; i < n; ++ i) {
+	vals1[i] = vals[i * kWordNum + w];
+      }
+      EXPECT_EQ( expr.eval(vals1), out1[w] );
+      EXPECT_EQ( out1[w], out2[w] );
+    }
+  }
+  EXPECT_LE( 20U * kWordNum, work.size() );
+}
+
+TEST(ExprCodeTest, expr_make_tv)
+{
+  // Expr::make_tv() も ExprCode を用いる．
+  for (ymuint n = 2; n <= 9; ++ n) {
+    Expr expr = (n % 2) ? make_shared_expr(n) : make_wide_expr(n);
+    for (ymuint ni = n; ni <= n + 2; ++ ni) {
+      TvFunc func = expr.make_tv(ni);
+      EXPECT_EQ( ni, func.input_num() );
+      ymuint np = 1U << ni;
+      for (ymuint p = 0; p < np; ++ p) {
+	vector<ymulong> vals(ni);
+	for (ymuint i = 0; i < ni; ++ i) {
+	  vals[i] = (p >> i) & 1U;
+	}
+	EXPECT_EQ( static_cast<int>(expr.eval(vals, 1UL)), func.value(p) );
+      }
+    }
+  }
+
+  EXPECT_EQ( TvFunc::const_zero(3), Expr::make_zero().make_tv(3) );
+  EXPECT_EQ( TvFunc::const_one(3), Expr::make_one().make_tv(3) );
+  EXPECT_EQ( TvFunc::nega_literal(4, VarId(2)),
+	     Expr::make_negaliteral(VarId(2)).make_tv(4) );
+}
+
+TEST(ExprCodeTest, make_tv)
+{
+  for (ymuint n = 3; n <= 9; ++ n) {
+    Expr expr = make_shared_expr(n);
+    ExprCode code(expr);
+
+    TvFunc func = code.make_tv();
+    ymuint np = 1U << n;
+    for (ymuint p = 0; p < np; ++ p) {
+      vector<ymulong> vals(n);
+      for (ymuint i = 0; i < n; ++ i) {
+	vals[i] = (p >> i) & 1U;
+      }
+      EXPECT_EQ( static_cast<int>(expr.eval(vals, 1UL)), func.value(p) );
+    }
+  }
+}
+
+END_NAMESPACE_YM
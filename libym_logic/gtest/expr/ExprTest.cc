@@ -0,0 +1,137 @@
+﻿
+/// @file ExprTest.cc
+/// @brief ExprTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmLogic/Expr.h"
+
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// v0 & v1 | v2 & v3 | ... の形の論理式を作る．
+Expr
+make_sop(ymuint n)
+{
+  Expr ans = Expr::make_zero();
+  for (ymuint i = 0; i + 1 < n; i += 2) {
+    Expr lit0 = Expr::make_posiliteral(VarId(i));
+    Expr lit1 = Expr::make_negaliteral(VarId(i + 1));
+    ans |= lit0 & lit1;
+  }
+  return ans;
+}
+
+// make_sop() を繰り返し呼んで結果を result に入れる．
+void
+sop_worker(ymuint n,
+	   ymuint count,
+	   Expr* result)
+{
+  for (ymuint i = 0; i < count; ++ i) {
+    *result = make_sop(n);
+  }
+}
+
+// v0 | v1 | ... | v(n - 1) の形の論理式を作る．
+Expr
+make_big_or(ymuint n)
+{
+  ExprVector lit_list;
+  lit_list.reserve(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    lit_list.push_back(Expr::make_posiliteral(VarId(i)));
+  }
+  return Expr::make_or(lit_list);
+}
+
+END_NONAMESPACE
+
+TEST(ExprTest, literal)
+{
+  Expr lit = Expr::make_posiliteral(VarId(3));
+
+  EXPECT_TRUE( lit.is_posiliteral() );
+  EXPECT_EQ( VarId(3), lit.varid() );
+  EXPECT_EQ( 1, lit.litnum() );
+}
+
+TEST(ExprTest, parallel_build)
+{
+  const ymuint kThreadNum = 4;
+  const ymuint kVarNum = 20;
+
+  Expr ref_expr = make_sop(kVarNum);
+  ostringstream ref_buf;
+  ref_buf << ref_expr;
+
+  vector<Expr> result_list(kThreadNum);
+  vector<std::thread> thread_list;
+  for (ymuint i = 0; i < kThreadNum; ++ i) {
+    thread_list.push_back(std::thread(sop_worker, kVarNum, 1000,
+				      &result_list[i]));
+  }
+  for (ymuint i = 0; i < kThreadNum; ++ i) {
+    thread_list[i].join();
+  }
+
+  // 他のスレッドで作った式を使い続けることができる．
+  for (ymuint i = 0; i < kThreadNum; ++ i) {
+    const Expr& expr = result_list[i];
+    EXPECT_TRUE( expr.is_or() );
+    EXPECT_EQ( kVarNum, expr.litnum() );
+    EXPECT_EQ( kVarNum / 2, expr.child_num() );
+    ostringstream buf;
+    buf << expr;
+    EXPECT_EQ( ref_buf.str(), buf.str() );
+    // 別のスレッドで作ったノードどうしでも重複は取り除かれる．
+    Expr expr2 = expr & ref_expr;
+    EXPECT_EQ( kVarNum, expr2.litnum() );
+  }
+}
+
+TEST(ExprTest, free_large_in_other_thread)
+{
+  // 子供の数が多いノードはサイズクラスに収まらず個別に確保される．
+  const ymuint kBigNum = 600;
+  const ymuint kExprNum = 20;
+
+  // リテラルのノードは削除されないので先に作っておく．
+  make_big_or(kBigNum);
+  ymuint used_size0 = Expr::used_size();
+
+  vector<Expr> expr_list(kExprNum);
+  for (ymuint i = 0; i < kExprNum; ++ i) {
+    expr_list[i] = make_big_or(kBigNum);
+  }
+
+  // 別のスレッドで削除する間もこのスレッドで大きなノードの
+  // 生成と削除を続ける．
+  std::thread th([&expr_list]() {
+      for (ymuint i = 0; i < expr_list.size(); ++ i) {
+	expr_list[i] = Expr();
+      }
+    });
+  for (ymuint i = 0; i < kExprNum; ++ i) {
+    Expr expr = make_big_or(kBigNum);
+    EXPECT_EQ( kBigNum, expr.child_num() );
+  }
+  th.join();
+
+  // 削除済みの領域を再利用しても壊れない．
+  for (ymuint i = 0; i < kExprNum; ++ i) {
+    Expr expr = make_big_or(kBigNum);
+    EXPECT_EQ( kBigNum, expr.litnum() );
+  }
+  EXPECT_EQ( used_size0, Expr::used_size() );
+}
+
+END_NAMESPACE_YM
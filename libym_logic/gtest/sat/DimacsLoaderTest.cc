@@ -0,0 +1,285 @@
+
+/// @file DimacsLoaderTest.cc
+/// @brief DimacsLoader のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmLogic/DimacsLoader.h"
+#include "YmLogic/DimacsParser.h"
+#include "YmLogic/SatDimacsHandler.h"
+#include "YmLogic/SatSolver.h"
+#include "YmUtils/FileIDO.h"
+#include "YmUtils/FileODO.h"
+#include "YmUtils/RandGen.h"
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 文字列をファイルに書き出す．
+bool
+write_file(const string& filename,
+	   const string& contents,
+	   CodecType codec_type = kCodecThrough)
+{
+  FileODO odo(codec_type);
+  if ( !odo.open(filename) ) {
+    return false;
+  }
+  odo.write(reinterpret_cast<const ymuint8*>(contents.c_str()), contents.size());
+  odo.close();
+  return true;
+}
+
+// ランダムな 3-SAT 問題を作る．
+string
+make_rand3sat(ymuint var_num,
+	      ymuint clause_num,
+	      ymuint32 seed)
+{
+  RandGen rg;
+  rg.init(seed);
+  ostringstream buf;
+  buf << "c random 3-SAT" << endl
+      << "p cnf " << var_num << " " << clause_num << endl;
+  for (ymuint i = 0; i < clause_num; ++ i) {
+    for (ymuint j = 0; j < 3; ++ j) {
+      int v = rg.int32() % var_num + 1;
+      if ( rg.int32() % 2 ) {
+	v = - v;
+      }
+      buf << v << " ";
+    }
+    buf << "0" << endl;
+  }
+  return buf.str();
+}
+
+END_NONAMESPACE
+
+
+class DimacsLoaderTest :
+  public ::testing::Test
+{
+public:
+
+  // コンストラクタ
+  DimacsLoaderTest();
+
+  // デストラクタ
+  ~DimacsLoaderTest();
+
+  // DimacsParser の結果と比較する．
+  // solve が true の時は SAT 問題を解いた結果も比較する．
+  void
+  check_same(const string& filename,
+	     bool solve);
+
+
+public:
+
+  // テスト用のファイル名
+  string mFileName;
+
+};
+
+DimacsLoaderTest::DimacsLoaderTest() :
+  mFileName("/tmp/DimacsLoaderTest_" + std::to_string(getpid()) + ".cnf")
+{
+}
+
+DimacsLoaderTest::~DimacsLoaderTest()
+{
+  unlink(mFileName.c_str());
+  unlink((mFileName + ".gz").c_str());
+}
+
+// DimacsParser の結果と比較する．
+void
+DimacsLoaderTest::check_same(const string& filename,
+			     bool solve)
+{
+  SatSolver solver1;
+  DimacsLoader loader;
+  ASSERT_TRUE( loader.load(filename, solver1) );
+
+  SatSolver solver2;
+  DimacsParser parser;
+  SatDimacsHandler handler(solver2);
+  parser.add_handler(&handler);
+  FileIDO ido(filename.size() > 3 && filename.substr(filename.size() - 3) == ".gz" ?
+	      kCodecGzip : kCodecThrough);
+  ASSERT_TRUE( ido.open(filename) );
+  ASSERT_TRUE( parser.read(ido) );
+
+  EXPECT_EQ( solver2.variable_num(), solver1.variable_num() );
+  EXPECT_EQ( solver2.clause_num(), solver1.clause_num() );
+  EXPECT_EQ( solver2.literal_num(), solver1.literal_num() );
+
+  if ( solve ) {
+    vector<Bool3> model1;
+    vector<Bool3> model2;
+    EXPECT_EQ( solver2.solve(model2), solver1.solve(model1) );
+  }
+}
+
+TEST_F(DimacsLoaderTest, simple)
+{
+  const char* str =
+    "c simple example\n"
+    "p cnf 3 2\n"
+    "1 -3 0\n"
+    "2 3 -1 0\n";
+  ASSERT_TRUE( write_file(mFileName, str) );
+
+  SatSolver solver;
+  DimacsLoader loader;
+  ASSERT_TRUE( loader.load(mFileName, solver) );
+
+  EXPECT_EQ( 3, loader.declared_var_num() );
+  EXPECT_EQ( 2, loader.declared_clause_num() );
+  EXPECT_EQ( 3, loader.var_num() );
+  EXPECT_EQ( 2, loader.clause_num() );
+  EXPECT_EQ( 3, solver.variable_num() );
+  EXPECT_EQ( 5, solver.literal_num() );
+
+  check_same(mFileName, true);
+}
+
+TEST_F(DimacsLoaderTest, free_format)
+{
+  // 節の途中の改行，CR，'%' による終端，末尾の改行なしを許す．
+  const char* str =
+    "c free format\r\n"
+    "p  cnf 4 3\r\n"
+    "  1 2\n"
+    "  -3 0 4\t-1 0\n"
+    "-2 -4 0\n"
+    "%\n"
+    "0\n";
+  ASSERT_TRUE( write_file(mFileName, str) );
+
+  SatSolver solver;
+  DimacsLoader loader;
+  ASSERT_TRUE( loader.load(mFileName, solver) );
+  EXPECT_EQ( 3, loader.clause_num() );
+  EXPECT_EQ( 7, solver.literal_num() );
+
+  vector<Bool3> model;
+  EXPECT_EQ( kB3True, solver.solve(model) );
+}
+
+TEST_F(DimacsLoaderTest, undeclared_var)
+{
+  // 宣言よりも大きな番号の変数が現れた．
+  const char* str =
+    "p cnf 2 1\n"
+    "1 -5 0";
+  ASSERT_TRUE( write_file(mFileName, str) );
+
+  SatSolver solver;
+  DimacsLoader loader;
+  ASSERT_TRUE( loader.load(mFileName, solver) );
+  EXPECT_EQ( 2, loader.declared_var_num() );
+  EXPECT_EQ( 5, loader.var_num() );
+  EXPECT_EQ( 5, solver.variable_num() );
+}
+
+TEST_F(DimacsLoaderTest, empty_clause)
+{
+  const char* str =
+    "p cnf 1 2\n"
+    "1 0\n"
+    "0\n";
+  ASSERT_TRUE( write_file(mFileName, str) );
+
+  SatSolver solver;
+  DimacsLoader loader;
+  ASSERT_TRUE( loader.load(mFileName, solver) );
+  EXPECT_EQ( 2, loader.clause_num() );
+
+  vector<Bool3> model;
+  EXPECT_EQ( kB3False, solver.solve(model) );
+}
+
+TEST_F(DimacsLoaderTest, errors)
+{
+  const char* str_list[] = {
+    // p 行がない．
+    "1 2 0\n",
+    // 空のファイル
+    "",
+    // p 行の書式が違う．
+    "p dnf 2 1\n1 2 0\n",
+    "p cnf 2\n1 2 0\n",
+    // p 行が重複している．
+    "p cnf 2 1\np cnf 2 1\n1 2 0\n",
+    // 節が 0 で終わっていない．
+    "p cnf 2 1\n1 2\n",
+    // 数字以外の文字
+    "p cnf 2 1\n1 x 0\n",
+    nullptr
+  };
+  for (ymuint i = 0; str_list[i] != nullptr; ++ i) {
+    ASSERT_TRUE( write_file(mFileName, str_list[i]) );
+    SatSolver solver;
+    DimacsLoader loader;
+    EXPECT_FALSE( loader.load(mFileName, solver) ) << str_list[i];
+  }
+
+  SatSolver solver;
+  DimacsLoader loader;
+  EXPECT_FALSE( loader.load(mFileName + ".nonexistent", solver) );
+}
+
+TEST_F(DimacsLoaderTest, rand3sat)
+{
+  for (ymuint32 seed = 1; seed <= 5; ++ seed) {
+    ASSERT_TRUE( write_file(mFileName, make_rand3sat(50, 210, seed)) );
+    check_same(mFileName, true);
+  }
+}
+
+TEST_F(DimacsLoaderTest, stream)
+{
+  // バッファの境界をまたぐ大きさの入力
+  string str = make_rand3sat(2000, 20000, 10);
+  ASSERT_LT( 64 * 1024, str.size() );
+  ASSERT_TRUE( write_file(mFileName, str) );
+
+  SatSolver solver1;
+  DimacsLoader loader1;
+  ASSERT_TRUE( loader1.load(mFileName, solver1) );
+
+  SatSolver solver2;
+  DimacsLoader loader2;
+  FileIDO ido;
+  ASSERT_TRUE( ido.open(mFileName) );
+  ASSERT_TRUE( loader2.load(ido, solver2) );
+
+  EXPECT_EQ( 20000, loader2.clause_num() );
+  EXPECT_EQ( solver1.variable_num(), solver2.variable_num() );
+  EXPECT_EQ( solver1.clause_num(), solver2.clause_num() );
+  EXPECT_EQ( solver1.literal_num(), solver2.literal_num() );
+}
+
+TEST_F(DimacsLoaderTest, gzip)
+{
+  string gz_name = mFileName + ".gz";
+  ASSERT_TRUE( write_file(gz_name, make_rand3sat(2000, 20000, 20), kCodecGzip) );
+
+  SatSolver solver;
+  DimacsLoader loader;
+  ASSERT_TRUE( loader.load(gz_name, solver) );
+  EXPECT_EQ( 20000, loader.clause_num() );
+
+  check_same(gz_name, false);
+}
+
+END_NAMESPACE_YM
@@ -225,6 +225,33 @@ TEST_P(SatSolverTest, solve2)
   EXPECT_EQ( kB3False, model[2] );
 }
 
+TEST_P(SatSolverTest, stop)
+{
+  VarId v1 = mSolver.new_var();
+  VarId v2 = mSolver.new_var();
+  Literal lit1(v1);
+  Literal lit2(v2);
+
+  mSolver.add_clause( lit1,  lit2);
+  mSolver.add_clause(~lit1, ~lit2);
+
+  vector<Literal> assumption;
+  assumption.push_back(lit1);
+
+  // 中止された時に充足不能と答えてはいけない．
+  mSolver.stop();
+  vector<Bool3> model;
+  Bool3 ans = mSolver.solve(assumption, model);
+  EXPECT_NE( kB3False, ans );
+
+  // 中止要求を取り消せば普通に解ける．
+  mSolver.clear_stop();
+  ans = mSolver.solve(assumption, model);
+  EXPECT_EQ( kB3True,  ans );
+  EXPECT_EQ( kB3True,  model[0] );
+  EXPECT_EQ( kB3False, model[1] );
+}
+
 INSTANTIATE_TEST_CASE_P(AllSat, SatSolverTest, testing::Values("", "minisat", "minisat2", "glueminisat2"));
 
 END_NAMESPACE_YM
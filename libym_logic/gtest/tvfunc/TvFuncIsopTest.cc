@@ -0,0 +1,182 @@
+
+/// @file TvFuncIsopTest.cc
+/// @brief TvFunc の isop() のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmLogic/TvFunc.h"
+#include "YmLogic/Expr.h"
+#include "YmUtils/RandGen.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// ランダムな関数を作る．
+TvFunc
+rand_func(RandGen& rg,
+	  ymuint ni)
+{
+  ymuint nblk = ((1U << ni) + 63) / 64;
+  vector<ymuint64> blocks(nblk);
+  for (ymuint i = 0; i < nblk; ++ i) {
+    blocks[i] = (static_cast<ymuint64>(rg.int32()) << 32) | rg.int32();
+  }
+  return TvFunc(ni, blocks);
+}
+
+// キューブの表す関数を作る．
+TvFunc
+cube_func(ymuint ni,
+	  ymuint64 cube)
+{
+  TvFunc ans = TvFunc::const_one(ni);
+  for (ymuint i = 0; i < ni; ++ i) {
+    VarId var(i);
+    if ( cube & (1UL << (i * 2)) ) {
+      ans &= TvFunc::posi_literal(ni, var);
+    }
+    if ( cube & (1UL << (i * 2 + 1)) ) {
+      ans &= TvFunc::nega_literal(ni, var);
+    }
+  }
+  return ans;
+}
+
+END_NONAMESPACE
+
+
+class TvFuncIsopTest :
+  public ::testing::TestWithParam<ymuint>
+{
+public:
+
+  /// @brief 結果が非冗長積和形になっているか調べる．
+  void
+  check_isop(const TvFunc& lower,
+	     const TvFunc& upper);
+
+};
+
+// @brief 結果が非冗長積和形になっているか調べる．
+void
+TvFuncIsopTest::check_isop(const TvFunc& lower,
+			   const TvFunc& upper)
+{
+  ymuint ni = lower.input_num();
+  vector<ymuint64> cube_list;
+  TvFunc f = isop(lower, upper, cube_list);
+
+  // lower <= f <= upper
+  EXPECT_EQ( lower, lower & f );
+  EXPECT_EQ( f, f & upper );
+
+  // f はキューブの和に等しい．
+  vector<TvFunc> cube_func_list;
+  TvFunc sum = TvFunc::const_zero(ni);
+  for (vector<ymuint64>::iterator p = cube_list.begin();
+       p != cube_list.end(); ++ p) {
+    TvFunc cf = cube_func(ni, *p);
+    cube_func_list.push_back(cf);
+    sum |= cf;
+  }
+  EXPECT_EQ( f, sum );
+
+  ymuint nc = cube_list.size();
+  for (ymuint c = 0; c < nc; ++ c) {
+    // キューブを取り除くと lower を覆わなくなる．
+    TvFunc rest = TvFunc::const_zero(ni);
+    for (ymuint c1 = 0; c1 < nc; ++ c1) {
+      if ( c1 != c ) {
+	rest |= cube_func_list[c1];
+      }
+    }
+    EXPECT_NE( lower, lower & rest );
+
+    // リテラルを取り除くと upper からはみ出す(主項になっている)．
+    ymuint64 cube = cube_list[c];
+    for (ymuint b = 0; b < ni * 2; ++ b) {
+      ymuint64 bit = 1UL << b;
+      if ( cube & bit ) {
+	TvFunc cf = cube_func(ni, cube & ~bit);
+	EXPECT_NE( cf, cf & upper );
+      }
+    }
+  }
+
+  // Expr 版も同じ関数を表す．
+  Expr cover;
+  TvFunc f2 = isop(lower, upper, cover);
+  EXPECT_EQ( f, f2 );
+  EXPECT_EQ( f, cover.make_tv(ni) );
+  EXPECT_TRUE( cover.is_sop() );
+  if ( cover.is_one() ) {
+    // 恒真関数は空のキューブ一つからなる．
+    EXPECT_EQ( 1U, nc );
+  }
+  else {
+    EXPECT_EQ( nc, cover.sop_cubenum() );
+  }
+}
+
+TEST_P(TvFuncIsopTest, const_func)
+{
+  ymuint ni = GetParam();
+  TvFunc zero = TvFunc::const_zero(ni);
+  TvFunc one = TvFunc::const_one(ni);
+
+  EXPECT_TRUE( zero.sop().is_zero() );
+  EXPECT_TRUE( one.sop().is_one() );
+  check_isop(zero, one);
+}
+
+TEST_P(TvFuncIsopTest, literal)
+{
+  ymuint ni = GetParam();
+  for (ymuint i = 0; i < ni; ++ i) {
+    VarId var(i);
+    Expr f = TvFunc::posi_literal(ni, var).sop();
+    EXPECT_TRUE( f.is_posiliteral() );
+    EXPECT_EQ( var, f.varid() );
+    Expr g = TvFunc::nega_literal(ni, var).sop();
+    EXPECT_TRUE( g.is_negaliteral() );
+    EXPECT_EQ( var, g.varid() );
+  }
+}
+
+TEST_P(TvFuncIsopTest, random_complete)
+{
+  ymuint ni = GetParam();
+  RandGen rg;
+  rg.init(ni + 1);
+  ymuint n = ni > 10 ? 3 : 20;
+  for (ymuint i = 0; i < n; ++ i) {
+    TvFunc f = rand_func(rg, ni);
+    check_isop(f, f);
+    EXPECT_EQ( f, f.sop().make_tv(ni) );
+  }
+}
+
+TEST_P(TvFuncIsopTest, random_dc)
+{
+  ymuint ni = GetParam();
+  RandGen rg;
+  rg.init(ni + 100);
+  ymuint n = ni > 10 ? 3 : 20;
+  for (ymuint i = 0; i < n; ++ i) {
+    TvFunc f = rand_func(rg, ni);
+    TvFunc dc = rand_func(rg, ni) & rand_func(rg, ni);
+    check_isop(f & ~dc, f | dc);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(TvFuncIsopTest_ni,
+			TvFuncIsopTest,
+			::testing::Values(0, 1, 2, 5, 6, 7, 8, 10, 12));
+
+END_NAMESPACE_YM
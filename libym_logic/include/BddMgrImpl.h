@@ -20,6 +20,7 @@ BEGIN_NAMESPACE_YM_BDD
 
 class BddOp;
 class BddBinOp;
+class CompTbl;
 class BddTriOp;
 class CofOp;
 class XcOp;
@@ -39,6 +40,7 @@ class BddMgrImpl
 {
   friend class Bdd;
   friend class BddOp;
+  friend class CompTbl;
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -600,6 +602,31 @@ public:
   gc_count() const = 0;
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 統計情報
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内部の統計情報を得る．
+  /// @param[out] stats 結果を格納する変数
+  void
+  get_stats(BddMgrStats& stats) const;
+
+  /// @brief 内部の統計情報を出力する．
+  /// @param[in] s 出力先のストリーム
+  void
+  print_stats(ostream& s) const;
+
+  /// @brief 統計情報を定期的にログ出力する間隔を設定する．
+  /// @param[in] interval GC の回数(0 の時は出力しない)
+  void
+  set_stats_interval(ymuint interval);
+
+  /// @brief 統計情報のカウンタをクリアする．
+  void
+  clear_stats();
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // BDDの管理用関数
@@ -686,6 +713,23 @@ protected:
   void
   deactivate(BddEdge e);
 
+  /// @brief 節点テーブルのサイズ変更を記録する．
+  /// @param[in] old_size 変更前のサイズ
+  /// @param[in] new_size 変更後のサイズ
+  void
+  add_nt_resize_event(ymuint64 old_size,
+		      ymuint64 new_size);
+
+  /// @brief 節点テーブルを走査して統計情報を積算する．
+  /// @param[in] table テーブル本体
+  /// @param[in] size テーブルサイズ
+  /// @param[inout] stats 結果を格納する変数
+  /// @note mNtSize, mNtUsedNum, mNtMaxChain を更新する．
+  void
+  scan_nodetable(BddNode** table,
+		 ymuint64 size,
+		 BddMgrStats& stats) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -723,6 +767,13 @@ private:
   void
   _gc(bool shink_nodetable) = 0;
 
+  /// @brief 節点テーブルの統計情報を得る．
+  /// @param[inout] stats 結果を格納する変数
+  /// @note mNtSize, mNtUsedNum, mNtMaxChain を設定する．
+  virtual
+  void
+  nodetable_stats(BddMgrStats& stats) const = 0;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -815,6 +866,32 @@ private:
   // 演算オブジェクトのリスト
   list<BddOp*> mOpList;
 
+  // 演算結果テーブルのリスト
+  list<CompTbl*> mTblList;
+
+
+  //////////////////////////////////////////////////////////////////////
+  // 統計情報用のメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 統計情報をログ出力する GC の間隔
+  ymuint32 mStatsInterval;
+
+  // 時間を計測した GC の回数
+  ymuint64 mGcNum;
+
+  // GC の停止時間の合計(マイクロ秒)
+  double mGcTotalTime;
+
+  // GC の最大停止時間(マイクロ秒)
+  double mGcMaxTime;
+
+  // GC の停止時間のヒストグラム
+  ymuint64 mGcHist[BddMgrStats::kGcHistSize];
+
+  // 節点テーブルのサイズ変更の記録
+  vector<BddNtResizeEvent> mNtResizeList;
+
 
   //////////////////////////////////////////////////////////////////////
   // ログ出力用のメンバ
@@ -0,0 +1,671 @@
+﻿
+/// @file AigCutCnf.cc
+/// @brief AigCutCnf の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "AigCutCnf.h"
+#include "YmLogic/TvFunc.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+BEGIN_NONAMESPACE
+
+// 1つのノードに保持するカット数の上限(自明なカットは含まない)
+const ymuint kCutLimit = 8;
+
+// 各変数の真理値表
+const ymuint64 kVarPat[6] = {
+  0xAAAAAAAAAAAAAAAAULL,
+  0xCCCCCCCCCCCCCCCCULL,
+  0xF0F0F0F0F0F0F0F0ULL,
+  0xFF00FF00FF00FF00ULL,
+  0xFFFF0000FFFF0000ULL,
+  0xFFFFFFFF00000000ULL
+};
+
+// ノード番号からシグネチャを作る．
+inline
+ymuint64
+id_sign(ymuint id)
+{
+  return 1ULL << (id % 64);
+}
+
+// ノード番号の昇順に並べるための比較関数
+struct AigIdLt
+{
+  bool
+  operator()(Aig left,
+	     Aig right) const
+  {
+    return left.node_id() < right.node_id();
+  }
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigCutCnf
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] cut_size カットの葉の数の最大値 ( 2 <= cut_size <= 6 )
+AigCutCnf::AigCutCnf(ymuint cut_size) :
+  mCutSize(cut_size)
+{
+  ASSERT_COND( cut_size >= 2 && cut_size <= 6 );
+}
+
+// @brief デストラクタ
+AigCutCnf::~AigCutCnf()
+{
+}
+
+// @brief CNF を作る．
+// @param[in] root_list 根のリスト
+// @param[in] solver 節を追加する SAT ソルバ
+// @param[inout] var_map ノード番号をキーにした変数の配列
+// @param[inout] input_list 変数を割り当てた外部入力のリスト
+void
+AigCutCnf::encode(const vector<Aig>& root_list,
+		  SatSolver& solver,
+		  vector<VarId>& var_map,
+		  vector<Aig>& input_list)
+{
+  collect_cone(root_list, solver, var_map, input_list);
+
+  ymuint n = mNodeArray.size();
+  if ( n > 0 ) {
+    // 1回目は構造上のファンアウト数で area flow を求める．
+    mCutArray.clear();
+    mCutArray.reserve(n * 4);
+    for (ymuint i = 0; i < n; ++ i) {
+      enum_cuts(i);
+    }
+    select_cover();
+
+    // 2回目は被覆中の参照回数を反映させる．
+    update_flow();
+    select_cover();
+
+    recover_area();
+
+    make_clauses(solver, var_map);
+  }
+
+  for (vector<NodeInfo>::iterator p = mNodeArray.begin();
+       p != mNodeArray.end(); ++ p) {
+    mLocalId[p->mNode.node_id()] = -1;
+  }
+  mNodeArray.clear();
+  mCutArray.clear();
+}
+
+// @brief CNF になっていないノードを集める．
+// @param[in] root_list 根のリスト
+// @param[in] solver 節を追加する SAT ソルバ
+// @param[inout] var_map ノード番号をキーにした変数の配列
+// @param[inout] input_list 変数を割り当てた外部入力のリスト
+void
+AigCutCnf::collect_cone(const vector<Aig>& root_list,
+			SatSolver& solver,
+			vector<VarId>& var_map,
+			vector<Aig>& input_list)
+{
+  if ( mLocalId.size() < var_map.size() ) {
+    mLocalId.resize(var_map.size(), -1);
+  }
+
+  // 深さ優先でたどって AND ノードを集める．
+  // 再帰を用いると深い回路でスタックが溢れるので自前のスタックを使う．
+  vector<Aig> node_list;
+  vector<Aig> stack;
+  for (vector<Aig>::const_iterator p = root_list.begin();
+       p != root_list.end(); ++ p) {
+    Aig root = *p;
+    if ( !root.is_const() ) {
+      stack.push_back(root.normalize());
+    }
+  }
+  while ( !stack.empty() ) {
+    Aig node = stack.back();
+    stack.pop_back();
+    ymuint id = node.node_id();
+    if ( var_map[id] != kVarIdIllegal || mLocalId[id] >= 0 ) {
+      continue;
+    }
+    if ( node.is_input() ) {
+      var_map[id] = solver.new_var();
+      input_list.push_back(node);
+      continue;
+    }
+    // 訪問済みの印として仮の値を入れておく．
+    mLocalId[id] = 0;
+    node_list.push_back(node);
+    stack.push_back(node.fanin0().normalize());
+    stack.push_back(node.fanin1().normalize());
+  }
+
+  // ノード番号はファンインよりも大きいので番号順がトポロジカル順になる．
+  std::sort(node_list.begin(), node_list.end(), AigIdLt());
+
+  ymuint n = node_list.size();
+  mNodeArray.resize(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    NodeInfo& info = mNodeArray[i];
+    info.mNode = node_list[i];
+    info.mCutBegin = 0;
+    info.mCutNum = 0;
+    info.mBest = 0;
+    info.mRoot = false;
+    info.mEstRef = 0.0;
+    info.mFlow = 0.0;
+    info.mMapRef = 0;
+    mLocalId[node_list[i].node_id()] = i;
+  }
+
+  // ファンアウト数の初期値は対象のノード内での参照回数とする．
+  for (ymuint i = 0; i < n; ++ i) {
+    Aig node = mNodeArray[i].mNode;
+    for (ymuint j = 0; j < 2; ++ j) {
+      int pos = mLocalId[node.fanin(j).node_id()];
+      if ( pos >= 0 ) {
+	mNodeArray[pos].mEstRef += 1.0;
+      }
+    }
+  }
+  for (vector<Aig>::const_iterator p = root_list.begin();
+       p != root_list.end(); ++ p) {
+    Aig root = *p;
+    if ( root.is_const() ) {
+      continue;
+    }
+    int pos = mLocalId[root.node_id()];
+    if ( pos >= 0 ) {
+      mNodeArray[pos].mRoot = true;
+      mNodeArray[pos].mEstRef += 1.0;
+    }
+  }
+}
+
+// @brief ノードのカットを列挙する．
+// @param[in] pos mNodeArray 中の位置
+void
+AigCutCnf::enum_cuts(ymuint pos)
+{
+  NodeInfo& info = mNodeArray[pos];
+  Aig edge0 = info.mNode.fanin0();
+  Aig edge1 = info.mNode.fanin1();
+  fanin_cuts(edge0, mFaninCutList[0]);
+  fanin_cuts(edge1, mFaninCutList[1]);
+
+  mTmpCutList.clear();
+  for (vector<Cut>::iterator p0 = mFaninCutList[0].begin();
+       p0 != mFaninCutList[0].end(); ++ p0) {
+    for (vector<Cut>::iterator p1 = mFaninCutList[1].begin();
+	 p1 != mFaninCutList[1].end(); ++ p1) {
+      Cut cut;
+      if ( !merge_cut(*p0, edge0.inv(), *p1, edge1.inv(), cut) ) {
+	continue;
+      }
+
+      // 支配されるカットは捨てる．
+      bool dominated = false;
+      for (ymuint k = 0; k < mTmpCutList.size(); ) {
+	if ( dominates(mTmpCutList[k], cut) ) {
+	  dominated = true;
+	  break;
+	}
+	if ( dominates(cut, mTmpCutList[k]) ) {
+	  mTmpCutList[k] = mTmpCutList.back();
+	  mTmpCutList.pop_back();
+	}
+	else {
+	  ++ k;
+	}
+      }
+      if ( dominated ) {
+	continue;
+      }
+
+      cut.mCost = cut_cost(cut.mTt);
+      cut.mFlow = cut_flow(cut);
+      mTmpCutList.push_back(cut);
+    }
+  }
+
+  // ファンインの自明なカット同士は必ず併合できるので空にはならない．
+  ymuint n = mTmpCutList.size();
+  ASSERT_COND( n > 0 );
+  if ( n > kCutLimit ) {
+    sort_cuts(&mTmpCutList[0], n, kCutLimit);
+    n = kCutLimit;
+  }
+  else {
+    sort_cuts(&mTmpCutList[0], n, n);
+  }
+
+  info.mCutBegin = mCutArray.size();
+  info.mCutNum = n;
+  info.mBest = info.mCutBegin;
+  info.mFlow = mTmpCutList[0].mFlow;
+  mCutArray.insert(mCutArray.end(), mTmpCutList.begin(), mTmpCutList.begin() + n);
+}
+
+// @brief ノードの優先カットを作る．
+// @param[in] edge ファンインの枝
+// @param[out] cut_list カットのリスト
+void
+AigCutCnf::fanin_cuts(Aig edge,
+		      vector<Cut>& cut_list) const
+{
+  cut_list.clear();
+
+  ymuint id = edge.node_id();
+  int pos = mLocalId[id];
+  if ( pos >= 0 ) {
+    const NodeInfo& info = mNodeArray[pos];
+    cut_list.insert(cut_list.end(),
+		    mCutArray.begin() + info.mCutBegin,
+		    mCutArray.begin() + info.mCutBegin + info.mCutNum);
+  }
+
+  // 自明なカット
+  Cut cut;
+  cut.mLeaves[0] = id;
+  cut.mSize = 1;
+  cut.mSign = id_sign(id);
+  cut.mTt = kVarPat[0];
+  cut.mCost = 0;
+  cut.mFlow = 0.0;
+  cut_list.push_back(cut);
+}
+
+// @brief 2つのカットを併合する．
+// @param[in] cut0, cut1 併合するカット
+// @param[in] inv0, inv1 それぞれの関数を反転する時 true にするフラグ
+// @param[out] cut 結果のカット
+// @return 葉の数が mCutSize を越えたら false を返す．
+bool
+AigCutCnf::merge_cut(const Cut& cut0,
+		     bool inv0,
+		     const Cut& cut1,
+		     bool inv1,
+		     Cut& cut) const
+{
+  ymuint i0 = 0;
+  ymuint i1 = 0;
+  ymuint n = 0;
+  while ( i0 < cut0.mSize || i1 < cut1.mSize ) {
+    ymuint32 id;
+    if ( i1 == cut1.mSize ||
+	 (i0 < cut0.mSize && cut0.mLeaves[i0] < cut1.mLeaves[i1]) ) {
+      id = cut0.mLeaves[i0];
+      ++ i0;
+    }
+    else if ( i0 == cut0.mSize || cut1.mLeaves[i1] < cut0.mLeaves[i0] ) {
+      id = cut1.mLeaves[i1];
+      ++ i1;
+    }
+    else {
+      id = cut0.mLeaves[i0];
+      ++ i0;
+      ++ i1;
+    }
+    if ( n == mCutSize ) {
+      return false;
+    }
+    cut.mLeaves[n] = id;
+    ++ n;
+  }
+  cut.mSize = n;
+  cut.mSign = cut0.mSign | cut1.mSign;
+
+  ymuint64 tt0 = expand_tt(cut0, cut);
+  if ( inv0 ) {
+    tt0 = ~tt0;
+  }
+  ymuint64 tt1 = expand_tt(cut1, cut);
+  if ( inv1 ) {
+    tt1 = ~tt1;
+  }
+  cut.mTt = tt0 & tt1;
+  return true;
+}
+
+// @brief a の葉が b の葉に含まれている時 true を返す．
+bool
+AigCutCnf::dominates(const Cut& a,
+		     const Cut& b)
+{
+  if ( a.mSize > b.mSize || (a.mSign & ~b.mSign) != 0ULL ) {
+    return false;
+  }
+  ymuint j = 0;
+  for (ymuint i = 0; i < a.mSize; ++ i) {
+    while ( j < b.mSize && b.mLeaves[j] < a.mLeaves[i] ) {
+      ++ j;
+    }
+    if ( j == b.mSize || b.mLeaves[j] != a.mLeaves[i] ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief 真理値表を葉の多いカットの上に展開する．
+// @param[in] src 元のカット
+// @param[in] dst 展開先のカット(src の葉を全て含む)
+ymuint64
+AigCutCnf::expand_tt(const Cut& src,
+		     const Cut& dst)
+{
+  if ( src.mSize == dst.mSize ) {
+    return src.mTt;
+  }
+
+  // src の各葉の dst 中の位置
+  ymuint pos[6];
+  ymuint j = 0;
+  for (ymuint k = 0; k < dst.mSize && j < src.mSize; ++ k) {
+    if ( dst.mLeaves[k] == src.mLeaves[j] ) {
+      pos[j] = k;
+      ++ j;
+    }
+  }
+  ASSERT_COND( j == src.mSize );
+
+  if ( src.mSize == 1 && src.mTt == kVarPat[0] ) {
+    // 自明なカットは変数そのもの
+    return kVarPat[pos[0]];
+  }
+
+  ymuint nm = 1U << dst.mSize;
+  ymuint64 tt = 0ULL;
+  for (ymuint m = 0; m < nm; ++ m) {
+    ymuint s = 0;
+    for (ymuint k = 0; k < src.mSize; ++ k) {
+      if ( (m >> pos[k]) & 1U ) {
+	s |= (1U << k);
+      }
+    }
+    if ( (src.mTt >> s) & 1ULL ) {
+      tt |= (1ULL << m);
+    }
+  }
+  // 64 ビットに複製する．
+  for (ymuint w = nm; w < 64; w <<= 1) {
+    tt |= (tt << w);
+  }
+  return tt;
+}
+
+// @brief カットを area flow の昇順(同じなら葉の数の昇順)に並べる．
+// @param[in] cut_array カットの配列
+// @param[in] n 要素数
+// @param[in] limit 先頭から並べる個数
+void
+AigCutCnf::sort_cuts(Cut* cut_array,
+		     ymuint n,
+		     ymuint limit)
+{
+  // limit は小さいので選択ソートで十分
+  for (ymuint i = 0; i < limit; ++ i) {
+    ymuint min_pos = i;
+    for (ymuint j = i + 1; j < n; ++ j) {
+      const Cut& c1 = cut_array[j];
+      const Cut& c2 = cut_array[min_pos];
+      if ( c1.mFlow < c2.mFlow ||
+	   (c1.mFlow == c2.mFlow && c1.mSize < c2.mSize) ) {
+	min_pos = j;
+      }
+    }
+    if ( min_pos != i ) {
+      Cut tmp = cut_array[i];
+      cut_array[i] = cut_array[min_pos];
+      cut_array[min_pos] = tmp;
+    }
+  }
+}
+
+// @brief カットの節数を求める．
+// @param[in] tt 真理値表
+//
+// 肯定と否定の非冗長積和形のキューブ数の和となる．
+ymuint
+AigCutCnf::cut_cost(ymuint64 tt)
+{
+  ymuint32 cost;
+  if ( mCostTable.find(tt, cost) ) {
+    return cost;
+  }
+
+  TvFunc f(6, vector<ymuint64>(1, tt));
+  TvFunc nf(6, vector<ymuint64>(1, ~tt));
+  isop(f, f, mCubeList);
+  cost = mCubeList.size();
+  isop(nf, nf, mCubeList);
+  cost += mCubeList.size();
+  mCostTable.add(tt, cost);
+  return cost;
+}
+
+// @brief カットの area flow を求める．
+// @param[in] cut 対象のカット
+double
+AigCutCnf::cut_flow(const Cut& cut) const
+{
+  double flow = cut.mCost;
+  for (ymuint k = 0; k < cut.mSize; ++ k) {
+    int pos = mLocalId[cut.mLeaves[k]];
+    if ( pos >= 0 ) {
+      const NodeInfo& info = mNodeArray[pos];
+      flow += info.mFlow / info.mEstRef;
+    }
+  }
+  return flow;
+}
+
+// @brief 選ばれたカットから被覆中の参照回数を求める．
+void
+AigCutCnf::select_cover()
+{
+  for (vector<NodeInfo>::iterator p = mNodeArray.begin();
+       p != mNodeArray.end(); ++ p) {
+    p->mMapRef = p->mRoot ? 1 : 0;
+  }
+  // 出力側から順に選ばれたカットの葉を参照する．
+  for (ymuint i = mNodeArray.size(); i -- > 0; ) {
+    const NodeInfo& info = mNodeArray[i];
+    if ( info.mMapRef == 0 ) {
+      continue;
+    }
+    const Cut& cut = mCutArray[info.mBest];
+    for (ymuint k = 0; k < cut.mSize; ++ k) {
+      int pos = mLocalId[cut.mLeaves[k]];
+      if ( pos >= 0 ) {
+	++ mNodeArray[pos].mMapRef;
+      }
+    }
+  }
+}
+
+// @brief 各ノードのカットの area flow を求め直す．
+void
+AigCutCnf::update_flow()
+{
+  for (vector<NodeInfo>::iterator p = mNodeArray.begin();
+       p != mNodeArray.end(); ++ p) {
+    NodeInfo& info = *p;
+    info.mEstRef = (info.mEstRef + 2.0 * info.mMapRef) / 3.0;
+    if ( info.mEstRef < 1.0 ) {
+      info.mEstRef = 1.0;
+    }
+  }
+  for (vector<NodeInfo>::iterator p = mNodeArray.begin();
+       p != mNodeArray.end(); ++ p) {
+    NodeInfo& info = *p;
+    Cut* cut_array = &mCutArray[info.mCutBegin];
+    for (ymuint k = 0; k < info.mCutNum; ++ k) {
+      cut_array[k].mFlow = cut_flow(cut_array[k]);
+    }
+    sort_cuts(cut_array, info.mCutNum, info.mCutNum);
+    info.mBest = info.mCutBegin;
+    info.mFlow = cut_array[0].mFlow;
+  }
+}
+
+// @brief exact area で被覆を改善する．
+void
+AigCutCnf::recover_area()
+{
+  for (vector<NodeInfo>::iterator p = mNodeArray.begin();
+       p != mNodeArray.end(); ++ p) {
+    NodeInfo& info = *p;
+    if ( info.mMapRef == 0 ) {
+      continue;
+    }
+    // 自分のカットを外した状態で各カットを加えた時の増分を比べる．
+    cut_deref(mCutArray[info.mBest]);
+    ymuint best = info.mBest;
+    ymuint best_area = 0;
+    for (ymuint k = 0; k < info.mCutNum; ++ k) {
+      const Cut& cut = mCutArray[info.mCutBegin + k];
+      ymuint area = cut_ref(cut);
+      cut_deref(cut);
+      if ( k == 0 || area < best_area ) {
+	best_area = area;
+	best = info.mCutBegin + k;
+      }
+    }
+    info.mBest = best;
+    cut_ref(mCutArray[best]);
+  }
+}
+
+// @brief カットを被覆に加える．
+// @param[in] cut 対象のカット
+// @return 新たに被覆に加わった節数を返す．
+ymuint
+AigCutCnf::cut_ref(const Cut& cut)
+{
+  ymuint area = cut.mCost;
+  mStack.clear();
+  for (ymuint k = 0; k < cut.mSize; ++ k) {
+    int pos = mLocalId[cut.mLeaves[k]];
+    if ( pos >= 0 ) {
+      mStack.push_back(pos);
+    }
+  }
+  while ( !mStack.empty() ) {
+    NodeInfo& info = mNodeArray[mStack.back()];
+    mStack.pop_back();
+    ++ info.mMapRef;
+    if ( info.mMapRef > 1 ) {
+      continue;
+    }
+    const Cut& cut1 = mCutArray[info.mBest];
+    area += cut1.mCost;
+    for (ymuint k = 0; k < cut1.mSize; ++ k) {
+      int pos = mLocalId[cut1.mLeaves[k]];
+      if ( pos >= 0 ) {
+	mStack.push_back(pos);
+      }
+    }
+  }
+  return area;
+}
+
+// @brief カットを被覆から取り除く．
+// @param[in] cut 対象のカット
+// @return 被覆から取り除かれた節数を返す．
+ymuint
+AigCutCnf::cut_deref(const Cut& cut)
+{
+  ymuint area = cut.mCost;
+  mStack.clear();
+  for (ymuint k = 0; k < cut.mSize; ++ k) {
+    int pos = mLocalId[cut.mLeaves[k]];
+    if ( pos >= 0 ) {
+      mStack.push_back(pos);
+    }
+  }
+  while ( !mStack.empty() ) {
+    NodeInfo& info = mNodeArray[mStack.back()];
+    mStack.pop_back();
+    ASSERT_COND( info.mMapRef > 0 );
+    -- info.mMapRef;
+    if ( info.mMapRef > 0 ) {
+      continue;
+    }
+    const Cut& cut1 = mCutArray[info.mBest];
+    area += cut1.mCost;
+    for (ymuint k = 0; k < cut1.mSize; ++ k) {
+      int pos = mLocalId[cut1.mLeaves[k]];
+      if ( pos >= 0 ) {
+	mStack.push_back(pos);
+      }
+    }
+  }
+  return area;
+}
+
+// @brief 選ばれたカットの節を作る．
+// @param[in] solver 節を追加する SAT ソルバ
+// @param[inout] var_map ノード番号をキーにした変数の配列
+void
+AigCutCnf::make_clauses(SatSolver& solver,
+			vector<VarId>& var_map)
+{
+  for (vector<NodeInfo>::iterator p = mNodeArray.begin();
+       p != mNodeArray.end(); ++ p) {
+    const NodeInfo& info = *p;
+    if ( info.mMapRef == 0 ) {
+      continue;
+    }
+    const Cut& cut = mCutArray[info.mBest];
+
+    // 葉はトポロジカル順で先に処理されているので必ず変数を持つ．
+    Literal leaf_lits[6];
+    for (ymuint k = 0; k < cut.mSize; ++ k) {
+      VarId var = var_map[cut.mLeaves[k]];
+      ASSERT_COND( var != kVarIdIllegal );
+      leaf_lits[k] = Literal(var);
+    }
+
+    VarId var = solver.new_var();
+    var_map[info.mNode.node_id()] = var;
+    Literal olit(var);
+
+    // 肯定の積和形の各キューブから (cube -> olit) を，
+    // 否定の積和形の各キューブから (cube -> ~olit) を作る．
+    for (ymuint b = 0; b < 2; ++ b) {
+      ymuint64 tt = b == 0 ? cut.mTt : ~cut.mTt;
+      TvFunc f(6, vector<ymuint64>(1, tt));
+      isop(f, f, mCubeList);
+      for (vector<ymuint64>::iterator q = mCubeList.begin();
+	   q != mCubeList.end(); ++ q) {
+	ymuint64 cube = *q;
+	mTmpLits.clear();
+	for (ymuint k = 0; k < cut.mSize; ++ k) {
+	  if ( cube & (1ULL << (k * 2)) ) {
+	    mTmpLits.push_back(~leaf_lits[k]);
+	  }
+	  if ( cube & (1ULL << (k * 2 + 1)) ) {
+	    mTmpLits.push_back(leaf_lits[k]);
+	  }
+	}
+	mTmpLits.push_back(b == 0 ? olit : ~olit);
+	solver.add_clause(mTmpLits);
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM_AIG
@@ -0,0 +1,275 @@
+﻿#ifndef AIGCUTCNF_H
+#define AIGCUTCNF_H
+
+/// @file AigCutCnf.h
+/// @brief AigCutCnf のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmLogic/Aig.h"
+#include "YmLogic/SatSolver.h"
+#include "YmUtils/HashMap.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigCutCnf AigCutCnf.h "AigCutCnf.h"
+/// @brief カットによる技術マッピングで AIG の CNF を作るクラス
+///
+/// 各ノードの小さなカットを列挙し，カットの関数の真理値表から
+/// 求めた非冗長積和形(肯定と否定の両方)の節数をコストとして
+/// area flow と exact area による被覆を選ぶ．
+/// 選ばれたカットの根にだけ変数を割り当て，カットの関数を
+/// 積和形の節で表すので，2入力 AND ごとの Tseitin 変換よりも
+/// 変数と節が少なくなる．
+///
+/// 既に変数を持つノードは外部入力と同様にカットの葉として扱うので，
+/// 問い合わせごとに新しい部分だけを追加することができる．
+//////////////////////////////////////////////////////////////////////
+class AigCutCnf
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] cut_size カットの葉の数の最大値 ( 2 <= cut_size <= 6 )
+  explicit
+  AigCutCnf(ymuint cut_size);
+
+  /// @brief デストラクタ
+  ~AigCutCnf();
+
+
+public:
+
+  /// @brief CNF を作る．
+  /// @param[in] root_list 根のリスト
+  /// @param[in] solver 節を追加する SAT ソルバ
+  /// @param[inout] var_map ノード番号をキーにした変数の配列
+  /// @param[inout] input_list 変数を割り当てた外部入力のリスト
+  ///
+  /// var_map[id] が kVarIdIllegal でないノードは既に CNF になって
+  /// いるものとみなす．root_list の TFI のうちそれ以外のノードの CNF を
+  /// 作り，カットの根となったノードの変数を var_map に設定する．
+  /// root_list の要素には必ず変数が割り当てられる．
+  /// var_map の大きさは対象のノード番号の最大値よりも大きくなければならない．
+  void
+  encode(const vector<Aig>& root_list,
+	 SatSolver& solver,
+	 vector<VarId>& var_map,
+	 vector<Aig>& input_list);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // カット
+  struct Cut
+  {
+    // 葉のノード番号(昇順)
+    ymuint32 mLeaves[6];
+
+    // 葉の数
+    ymuint32 mSize;
+
+    // 葉の包含関係を調べるためのシグネチャ
+    ymuint64 mSign;
+
+    // 関数の真理値表
+    // i 番目の葉が i 番目の変数となる．
+    // 葉の数が 6 未満の時は 64 ビットに複製してある．
+    ymuint64 mTt;
+
+    // 節数
+    ymuint32 mCost;
+
+    // area flow
+    double mFlow;
+  };
+
+  // 対象の AND ノードの情報
+  struct NodeInfo
+  {
+    // ノード
+    Aig mNode;
+
+    // mCutArray 中のカットの先頭位置
+    ymuint32 mCutBegin;
+
+    // カット数
+    ymuint32 mCutNum;
+
+    // 選ばれたカットの mCutArray 中の位置
+    ymuint32 mBest;
+
+    // 根の時 true にするフラグ
+    bool mRoot;
+
+    // area flow を計算する時のファンアウト数の見積もり
+    double mEstRef;
+
+    // 選ばれたカットの area flow
+    double mFlow;
+
+    // 被覆中の参照回数
+    ymuint32 mMapRef;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief CNF になっていないノードを集める．
+  /// @param[in] root_list 根のリスト
+  /// @param[in] solver 節を追加する SAT ソルバ
+  /// @param[inout] var_map ノード番号をキーにした変数の配列
+  /// @param[inout] input_list 変数を割り当てた外部入力のリスト
+  ///
+  /// 結果は入力側からのトポロジカル順で mNodeArray に入る．
+  /// 変数を持たない外部入力にはここで変数を割り当てる．
+  void
+  collect_cone(const vector<Aig>& root_list,
+	       SatSolver& solver,
+	       vector<VarId>& var_map,
+	       vector<Aig>& input_list);
+
+  /// @brief ノードのカットを列挙する．
+  /// @param[in] pos mNodeArray 中の位置
+  void
+  enum_cuts(ymuint pos);
+
+  /// @brief ノードの優先カットを作る．
+  /// @param[in] edge ファンインの枝
+  /// @param[out] cut_list カットのリスト
+  ///
+  /// 自明なカットも含む．
+  void
+  fanin_cuts(Aig edge,
+	     vector<Cut>& cut_list) const;
+
+  /// @brief 2つのカットを併合する．
+  /// @param[in] cut0, cut1 併合するカット
+  /// @param[in] inv0, inv1 それぞれの関数を反転する時 true にするフラグ
+  /// @param[out] cut 結果のカット
+  /// @return 葉の数が mCutSize を越えたら false を返す．
+  bool
+  merge_cut(const Cut& cut0,
+	    bool inv0,
+	    const Cut& cut1,
+	    bool inv1,
+	    Cut& cut) const;
+
+  /// @brief a の葉が b の葉に含まれている時 true を返す．
+  static
+  bool
+  dominates(const Cut& a,
+	    const Cut& b);
+
+  /// @brief 真理値表を葉の多いカットの上に展開する．
+  /// @param[in] src 元のカット
+  /// @param[in] dst 展開先のカット(src の葉を全て含む)
+  static
+  ymuint64
+  expand_tt(const Cut& src,
+	    const Cut& dst);
+
+  /// @brief カットを area flow の昇順(同じなら葉の数の昇順)に並べる．
+  /// @param[in] cut_array カットの配列
+  /// @param[in] n 要素数
+  /// @param[in] limit 先頭から並べる個数
+  static
+  void
+  sort_cuts(Cut* cut_array,
+	    ymuint n,
+	    ymuint limit);
+
+  /// @brief カットの節数を求める．
+  /// @param[in] tt 真理値表
+  ymuint
+  cut_cost(ymuint64 tt);
+
+  /// @brief カットの area flow を求める．
+  /// @param[in] cut 対象のカット
+  double
+  cut_flow(const Cut& cut) const;
+
+  /// @brief 選ばれたカットから被覆中の参照回数を求める．
+  void
+  select_cover();
+
+  /// @brief 各ノードのカットの area flow を求め直す．
+  void
+  update_flow();
+
+  /// @brief exact area で被覆を改善する．
+  void
+  recover_area();
+
+  /// @brief カットを被覆に加える．
+  /// @param[in] cut 対象のカット
+  /// @return 新たに被覆に加わった節数を返す．
+  ymuint
+  cut_ref(const Cut& cut);
+
+  /// @brief カットを被覆から取り除く．
+  /// @param[in] cut 対象のカット
+  /// @return 被覆から取り除かれた節数を返す．
+  ymuint
+  cut_deref(const Cut& cut);
+
+  /// @brief 選ばれたカットの節を作る．
+  /// @param[in] solver 節を追加する SAT ソルバ
+  /// @param[inout] var_map ノード番号をキーにした変数の配列
+  void
+  make_clauses(SatSolver& solver,
+	       vector<VarId>& var_map);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // カットの葉の数の最大値
+  ymuint32 mCutSize;
+
+  // 真理値表をキーにして節数を保持する表
+  HashMap<ymuint64, ymuint32> mCostTable;
+
+  // ノード番号をキーにして mNodeArray 中の位置を保持する配列
+  // 対象外のノードは -1
+  vector<int> mLocalId;
+
+  // 対象のノードの情報の配列
+  vector<NodeInfo> mNodeArray;
+
+  // 全てのノードのカットを納める配列
+  vector<Cut> mCutArray;
+
+  // カットを列挙する時のファンインのカットのリスト
+  vector<Cut> mFaninCutList[2];
+
+  // カットを列挙する時の作業領域
+  vector<Cut> mTmpCutList;
+
+  // cut_ref()/cut_deref() の作業領域
+  vector<ymuint32> mStack;
+
+  // 節を作る時の作業領域
+  vector<ymuint64> mCubeList;
+
+  // 節を作る時の作業領域
+  vector<Literal> mTmpLits;
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGCUTCNF_H
@@ -19,7 +19,7 @@ BEGIN_NAMESPACE_YM_AIG
 
 // @brief コンストラクタ
 AigMgrImpl::AigMgrImpl() :
-  mAlloc(sizeof(AigNode) * 1024),
+  mAlloc(sizeof(AigNode)),
   mInputNum(0),
   mInputHashTable(nullptr),
   mInputHashSize(0),
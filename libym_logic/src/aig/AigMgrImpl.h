@@ -11,7 +11,7 @@
 
 #include "YmLogic/AigMgr.h"
 #include "AigNode.h"
-#include "YmUtils/SimpleAlloc.h"
+#include "YmUtils/SlabAlloc.h"
 #include "YmUtils/ItvlMgr.h"
 
 
@@ -114,7 +114,7 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // ノードを確保するためのアロケータ
-  SimpleAlloc mAlloc;
+  SlabAlloc mAlloc;
 
   // ID 番号をキーにしたノードの配列
   // 全てのノードのリスト(mInputNodes + mAndNodes)
@@ -1,18 +1,15 @@
 ﻿
-/// @file libaig/AigSatMgr.cc
+/// @file AigSatMgr.cc
 /// @brief AigSatMgr の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// $Id: AigMgr.cc 2274 2009-06-10 07:45:29Z matsunaga $
-///
-/// Copyright (C) 2005-2011 Yusuke Matsunaga
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
 /// All rights reserved.
 
-#if 0
-#include "aig/AigSatMgr.h"
-#include "aig/AigMgr.h"
-#include "aig/AigNode.h"
-#include "AigSatData.h"
+
+#include "YmLogic/AigSatMgr.h"
+#include "YmLogic/AigMgr.h"
+#include "AigCutCnf.h"
 
 
 BEGIN_NAMESPACE_YM_AIG
@@ -22,58 +19,35 @@ BEGIN_NAMESPACE_YM_AIG
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-// @param[in] aitmgr AigMgr
+// @param[in] aigmgr AigMgr
 // @param[in] solver SAT-solver
 AigSatMgr::AigSatMgr(AigMgr& aigmgr,
 		     SatSolver& solver) :
   mAigMgr(aigmgr),
-  mSolver(solver)
+  mSolver(solver),
+  mCurMark(0),
+  mCutCnf(nullptr)
 {
 }
 
 // @brief デストラクタ
 AigSatMgr::~AigSatMgr()
 {
+  delete mCutCnf;
 }
 
-
-BEGIN_NONAMESPACE
-
+// @brief CNF を作る時のカットの大きさを設定する．
+// @param[in] cut_size カットの葉の数の最大値 ( 0 or 2 <= cut_size <= 6 )
 void
-dfs(AigNode* node,
-    vector<AigSatData>& data_array)
+AigSatMgr::set_cut_size(ymuint cut_size)
 {
-  AigSatData& data = data_array[node->node_id()];
-  if ( !data.tfi_mark() ) {
-    data.set_tfi_mark();
-    if ( node->is_and() ) {
-      dfs(node->fanin0(), data_array);
-      dfs(node->fanin1(), data_array);
-    }
+  delete mCutCnf;
+  mCutCnf = nullptr;
+  if ( cut_size > 0 ) {
+    mCutCnf = new AigCutCnf(cut_size);
   }
 }
 
-void
-find_leaves(AigHandle handle,
-	    vector<AigSatData>& data_array,
-	    list<Literal>& leaves)
-{
-  ymuint id = handle.node_id();
-  AigSatData& data = data_array[id];
-  if ( data.root_mark() || handle.node()->is_input() ) {
-    Literal lit(data.varid(), handle.inv() ? kPolNega : kPolPosi);
-    leaves.push_back(lit);
-  }
-  else {
-    AigNode* node = handle.node();
-    find_leaves(node->fanin0_handle(), data_array, leaves);
-    find_leaves(node->fanin1_handle(), data_array, leaves);
-  }
-}
-
-END_NONAMESPACE
-
-
 // @brief SAT 問題を解く．
 // @param[in] edge この出力を1にできるか調べる．
 // @param[out] model 外部入力の割り当てを入れる配列
@@ -81,10 +55,10 @@ END_NONAMESPACE
 // @retval kB3True 充足可能
 // @retval kB3X 不明
 Bool3
-AigSatMgr::sat(AigHandle edge,
+AigSatMgr::sat(Aig edge,
 	       vector<Bool3>& model)
 {
-  vector<AigHandle> edge_list(1);
+  vector<Aig> edge_list(1);
   edge_list[0] = edge;
   return sat(edge_list, model);
 }
@@ -96,98 +70,185 @@ AigSatMgr::sat(AigHandle edge,
 // @retval kB3True 充足可能
 // @retval kB3X 不明
 Bool3
-AigSatMgr::sat(const vector<AigHandle>& edge_list,
+AigSatMgr::sat(const vector<Aig>& edge_list,
 	       vector<Bool3>& model)
 {
-  ymuint n = mAigMgr.node_num();
-  vector<AigSatData> data_array(n);
+  model.clear();
+
+  if ( mCutCnf != nullptr ) {
+    // 全ての出力をまとめてマッピングした方が共有部分の扱いが良くなる．
+    vector<Aig> root_list;
+    root_list.reserve(edge_list.size());
+    for (vector<Aig>::const_iterator p = edge_list.begin();
+	 p != edge_list.end(); ++ p) {
+      Aig edge = *p;
+      if ( !edge.is_const() ) {
+	resize_map(edge.node_id());
+	root_list.push_back(edge);
+      }
+    }
+    mCutCnf->encode(root_list, mSolver, mVarMap, mInputList);
+  }
 
-  // edge_list の TFI に印を付ける．
-  bool have_zero = false;
-  bool all_one = true;
-  for (vector<AigHandle>::const_iterator p = edge_list.begin();
+  // 各出力を assumption にする．
+  // この時点でまだ CNF になっていない部分だけが追加される．
+  vector<Literal> assumptions;
+  assumptions.reserve(edge_list.size());
+  for (vector<Aig>::const_iterator p = edge_list.begin();
        p != edge_list.end(); ++ p) {
-    AigHandle edge = *p;
+    Aig edge = *p;
     if ( edge.is_zero() ) {
       return kB3False;
     }
     if ( !edge.is_one() ) {
-      all_one = false;
-      AigNode* node = edge.node();
-      dfs(node, data_array);
-      data_array[node->node_id()].set_root_mark();
+      assumptions.push_back(make_literal(edge));
     }
   }
-  if ( all_one ) {
-    // TODO: model をどうする．
-    return kB3True;
-  }
 
-  // 極大AND木の根に印をつける．
-  for (ymuint i = 0; i < n; ++ i) {
-    AigNode* aignode = mAigMgr.node(i);
-    if ( data_array[aignode->node_id()].tfi_mark() && aignode->is_and() ) {
-      if ( aignode->fanin0_inv() ) {
-	AigNode* node1 = aignode->fanin0();
-	data_array[node1->node_id()].set_root_mark();
-      }
-      if ( aignode->fanin1_inv() ) {
-	AigNode* node1 = aignode->fanin1();
-	data_array[node1->node_id()].set_root_mark();
+  vector<Bool3> sat_model;
+  Bool3 stat = mSolver.solve(assumptions, sat_model);
+  if ( stat == kB3True ) {
+    // SAT-solver の変数の値を外部入力の値に直す．
+    for (vector<Aig>::iterator p = mInputList.begin();
+	 p != mInputList.end(); ++ p) {
+      Aig input = *p;
+      ymuint id = input.input_id().val();
+      if ( model.size() <= id ) {
+	model.resize(id + 1, kB3X);
       }
+      model[id] = sat_model[mVarMap[input.node_id()].val()];
     }
   }
+  return stat;
+}
 
-  // CNF を作成する．
-  for (ymuint i = 0; i < n; ++ i) {
-    AigNode* aignode = mAigMgr.node(i);
-    AigSatData& data = data_array[aignode->node_id()];
-    if ( data.tfi_mark() && aignode->is_and() ) {
-      if ( data.root_mark() ) {
-	tVarId id = mSolver.new_var();
-	data.set_varid(id);
-	list<Literal> leaves;
-	find_leaves(aignode->fanin0_handle(), data_array, leaves);
-	find_leaves(aignode->fanin1_handle(), data_array, leaves);
-	Literal lito(id, kPolPosi);
-	vector<Literal> tmp_lits;
-	tmp_lits.reserve(leaves.size() + 1);
-	for (list<Literal>::iterator p = leaves.begin();
-	     p != leaves.end(); ++ p) {
-	  Literal lit = *p;
-	  tmp_lits.push_back(~lit);
-	  mSolver.add_clause(lit, ~lito);
-	}
-	tmp_lits.push_back(lito);
-	mSolver.add_clause(tmp_lits);
-      }
+// @brief edge に対応するリテラルを返す．
+// @param[in] edge 対象の AIG ハンドル
+//
+// 必要ならば edge の TFI の CNF を作る．
+Literal
+AigSatMgr::make_literal(Aig edge)
+{
+  if ( edge.is_const() ) {
+    if ( mConstVar == kVarIdIllegal ) {
+      mConstVar = mSolver.new_var();
+      mSolver.add_clause(Literal(mConstVar));
     }
-    else {
-      // 入力ノードにも印を付ける．
-      tVarId id = mSolver.new_var();
-      data.set_varid(id);
+    return Literal(mConstVar, edge.is_zero());
+  }
+  return Literal(node_var(edge.normalize()), edge.inv());
+}
+
+// @brief ノードに対応する変数を返す．
+// @param[in] node 対象のノード(反転属性なし)
+//
+// 変数を持っていなければ CNF を作る．
+VarId
+AigSatMgr::node_var(Aig node)
+{
+  ymuint id = node.node_id();
+  resize_map(id);
+  if ( mVarMap[id] != kVarIdIllegal ) {
+    return mVarMap[id];
+  }
+
+  if ( node.is_input() ) {
+    VarId var = mSolver.new_var();
+    mVarMap[id] = var;
+    mInputList.push_back(node);
+    return var;
+  }
+
+  if ( mCutCnf != nullptr ) {
+    vector<Aig> root_list(1, node);
+    mCutCnf->encode(root_list, mSolver, mVarMap, mInputList);
+    return mVarMap[id];
+  }
+
+  // 極大 AND 木の葉を求める．
+  ++ mCurMark;
+  if ( mCurMark == 0U ) {
+    // 一周したので印を消す．
+    for (vector<ymuint32>::iterator p = mMark.begin();
+	 p != mMark.end(); ++ p) {
+      *p = 0U;
     }
+    mCurMark = 1U;
+  }
+  vector<Aig> leaf_list;
+  bool stat0 = find_leaves(node.fanin0(), leaf_list);
+  bool stat1 = find_leaves(node.fanin1(), leaf_list);
+
+  // 葉の CNF を先に作る．
+  ymuint nl = leaf_list.size();
+  vector<Literal> tmp_lits;
+  tmp_lits.reserve(nl + 1);
+  for (ymuint i = 0; i < nl; ++ i) {
+    Aig leaf = leaf_list[i];
+    VarId var = node_var(leaf.normalize());
+    tmp_lits.push_back(Literal(var, !leaf.inv()));
   }
 
-  cout << "# of variables: " << mSolver.variable_num() << endl;
-  cout << "# of clauses: " << mSolver.clause_num() << endl;
+  VarId var = mSolver.new_var();
+  mVarMap[id] = var;
+  Literal lito(var);
+  if ( !stat0 || !stat1 ) {
+    // 定数0が含まれていたので出力は常に0
+    mSolver.add_clause(~lito);
+    return var;
+  }
+  for (ymuint i = 0; i < nl; ++ i) {
+    mSolver.add_clause(~tmp_lits[i], ~lito);
+  }
+  tmp_lits.push_back(lito);
+  mSolver.add_clause(tmp_lits);
 
-  ymuint ne = edge_list.size();
-  vector<Literal> assumptions;
-  assumptions.reserve(ne);
-  for (ymuint i = 0; i < ne; ++ i) {
-    AigHandle edge = edge_list[i];
-    if ( !edge.is_one() ) {
-      ymuint varid = data_array[edge.node_id()].varid();
-      tPol pol = edge.inv() ? kPolNega : kPolPosi;
-      Literal lit(varid, pol);
-      assumptions.push_back(lit);
+  return var;
+}
+
+// @brief mVarMap の大きさを id を含むように調整する．
+// @param[in] id ノード番号
+void
+AigSatMgr::resize_map(ymuint id)
+{
+  if ( mVarMap.size() <= id ) {
+    ymuint n = mAigMgr.node_num();
+    if ( n <= id ) {
+      n = id + 1;
     }
+    mVarMap.resize(n, kVarIdIllegal);
+    mMark.resize(n, 0U);
   }
+}
 
-  Bool3 stat = mSolver.solve(assumptions, model);
-  return stat;
+// @brief 極大 AND 木の葉を求める．
+// @param[in] edge 対象の枝
+// @param[out] leaf_list 葉のリスト
+// @return 葉に定数0が含まれていたら false を返す．
+bool
+AigSatMgr::find_leaves(Aig edge,
+		       vector<Aig>& leaf_list)
+{
+  if ( edge.is_const() ) {
+    return edge.is_one();
+  }
+
+  ymuint id = edge.node_id();
+  if ( edge.inv() || edge.is_input() || mVarMap[id] != kVarIdIllegal ) {
+    leaf_list.push_back(edge);
+    return true;
+  }
+
+  // 反転していない AND ノードは展開する．
+  // 同じ木の中で再収斂するノードは一度だけ展開すればよい．
+  if ( mMark[id] == mCurMark ) {
+    return true;
+  }
+  mMark[id] = mCurMark;
+  if ( !find_leaves(edge.fanin0(), leaf_list) ) {
+    return false;
+  }
+  return find_leaves(edge.fanin1(), leaf_list);
 }
 
 END_NAMESPACE_YM_AIG
-#endif
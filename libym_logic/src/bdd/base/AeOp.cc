@@ -24,7 +24,7 @@ BEGIN_NAMESPACE_YM_BDD
 AeOp::AeOp(BddMgrImpl* mgr,
 	   BddBinOp* and_op,
 	   BddBinOp* smooth_op) :
-  BddTriOp(mgr, "ite_op"),
+  BddTriOp(mgr, "ae_op"),
   mAndOp(and_op),
   mSmoothOp(smooth_op)
 {
@@ -64,7 +64,7 @@ AeOp::apply_step(BddEdge f,
 {
   if ( f.is_zero() || g.is_zero() ) {
     // どちらかが0なら答は0
-    return f;
+    return BddEdge::make_zero();
   }
   if ( check_reverse(f, g) ) {
     return BddEdge::make_zero();
@@ -86,8 +86,8 @@ AeOp::apply_step(BddEdge f,
     return mSmoothOp->apply(f, s);
   }
   if ( s.is_one() ) {
-    // sが1ならOR演算を呼ぶ．
-    return ~mAndOp->apply(~f, ~g);
+    // sが1ならAND演算を呼ぶ．
+    return mAndOp->apply(f, g);
   }
 
   // f と g は対称なので正規化する．
@@ -111,6 +111,10 @@ AeOp::apply_step(BddEdge f,
 
   while ( s_level < top ) {
     s = s_vp->edge1();
+    if ( s.is_one() ) {
+      // 消去対象の変数が残っていないのでAND演算を呼ぶ．
+      return mAndOp->apply(f, g);
+    }
     s_vp = s.get_node();
     s_level = s_vp->level();
   }
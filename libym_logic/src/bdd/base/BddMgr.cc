@@ -495,4 +495,32 @@ BddMgr::gc_count() const
   return mImpl->gc_count();
 }
 
+// @brief 内部の統計情報を得る．
+void
+BddMgr::get_stats(BddMgrStats& stats) const
+{
+  mImpl->get_stats(stats);
+}
+
+// @brief 内部の統計情報を出力する．
+void
+BddMgr::print_stats(ostream& s) const
+{
+  mImpl->print_stats(s);
+}
+
+// @brief 統計情報を定期的にログ出力する間隔を設定する．
+void
+BddMgr::set_stats_interval(ymuint interval)
+{
+  mImpl->set_stats_interval(interval);
+}
+
+// @brief 統計情報のカウンタをクリアする．
+void
+BddMgr::clear_stats()
+{
+  mImpl->clear_stats();
+}
+
 END_NAMESPACE_YM_BDD
@@ -28,6 +28,8 @@
 #include "SupOp.h"
 #include "SmoothOp.h"
 #include "AeOp.h"
+#include "CompTbl.h"
+#include "YmUtils/StopWatch.h"
 
 
 BEGIN_NAMESPACE_YM_BDD
@@ -187,6 +189,15 @@ BddMgrImpl::BddMgrImpl(const string& name) :
 
   mOverflow = false;
 
+  // 統計情報の初期化
+  mStatsInterval = 0;
+  mGcNum = 0;
+  mGcTotalTime = 0.0;
+  mGcMaxTime = 0.0;
+  for (ymuint i = 0; i < BddMgrStats::kGcHistSize; ++ i) {
+    mGcHist[i] = 0;
+  }
+
   // 演算オブジェクトの生成
   mAndOp = new AndOp(this);
   mXorOp = new XorOp(this);
@@ -630,6 +641,9 @@ BddMgrImpl::disable_gc()
 void
 BddMgrImpl::gc(bool shrink_nodetable)
 {
+  StopWatch timer;
+  timer.start();
+
   for (list<BddOp*>::iterator p = mOpList.begin();
        p != mOpList.end(); ++ p) {
     BddOp* op = *p;
@@ -638,6 +652,194 @@ BddMgrImpl::gc(bool shrink_nodetable)
 
   _gc(shrink_nodetable);
 
+  timer.stop();
+
+  // 停止時間を記録する．
+  double t = timer.time().real_time_usec();
+  ++ mGcNum;
+  mGcTotalTime += t;
+  if ( mGcMaxTime < t ) {
+    mGcMaxTime = t;
+  }
+  ymuint pos = 0;
+  for (double limit = 1.0; t >= limit && pos < BddMgrStats::kGcHistSize - 1;
+       limit *= 2.0) {
+    ++ pos;
+  }
+  ++ mGcHist[pos];
+
+  if ( mStatsInterval > 0 && (mGcNum % mStatsInterval) == 0 ) {
+    print_stats(logstream());
+  }
+}
+
+// @brief 内部の統計情報を得る．
+// @param[out] stats 結果を格納する変数
+void
+BddMgrImpl::get_stats(BddMgrStats& stats) const
+{
+  stats.mTblList.clear();
+  stats.mTblList.reserve(mTblList.size());
+  for (list<CompTbl*>::const_iterator p = mTblList.begin();
+       p != mTblList.end(); ++ p) {
+    const CompTbl* tbl = *p;
+    BddTblStats tstats;
+    tstats.mName = tbl->name();
+    tstats.mTableSize = tbl->table_size();
+    tstats.mUsedNum = tbl->used_num();
+    tstats.mLookupNum = tbl->lookup_num();
+    tstats.mHitNum = tbl->hit_num();
+    tstats.mInsertNum = tbl->insert_num();
+    tstats.mCollisionNum = tbl->collision_num();
+    tstats.mResizeNum = tbl->resize_num();
+    stats.mTblList.push_back(tstats);
+  }
+
+  stats.mNtSize = 0;
+  stats.mNtUsedNum = 0;
+  stats.mNtMaxChain = 0;
+  nodetable_stats(stats);
+  stats.mNodeNum = node_num();
+  stats.mGarbageNum = garbage_num();
+  stats.mNtResizeList = mNtResizeList;
+
+  stats.mGcNum = mGcNum;
+  stats.mGcTotalTime = mGcTotalTime;
+  stats.mGcMaxTime = mGcMaxTime;
+  for (ymuint i = 0; i < BddMgrStats::kGcHistSize; ++ i) {
+    stats.mGcHist[i] = mGcHist[i];
+  }
+}
+
+// @brief 内部の統計情報を出力する．
+// @param[in] s 出力先のストリーム
+void
+BddMgrImpl::print_stats(ostream& s) const
+{
+  BddMgrStats stats;
+  get_stats(stats);
+
+  s << "BddMgr[" << name() << "] statistics" << endl;
+  for (vector<BddTblStats>::const_iterator p = stats.mTblList.begin();
+       p != stats.mTblList.end(); ++ p) {
+    const BddTblStats& tstats = *p;
+    ymuint64 miss_num = tstats.mLookupNum - tstats.mHitNum;
+    s << "  " << tstats.mName << ":"
+      << " lookup = " << tstats.mLookupNum
+      << ", hit = " << tstats.mHitNum
+      << ", miss = " << miss_num
+      << ", insert = " << tstats.mInsertNum
+      << ", collision = " << tstats.mCollisionNum
+      << ", load = " << tstats.mUsedNum << "/" << tstats.mTableSize
+      << ", resize = " << tstats.mResizeNum
+      << endl;
+  }
+
+  double avg_chain = 0.0;
+  if ( stats.mNtUsedNum > 0 ) {
+    avg_chain = double(stats.mNodeNum) / double(stats.mNtUsedNum);
+  }
+  s << "  node-table: size = " << stats.mNtSize
+    << ", nodes = " << stats.mNodeNum
+    << ", garbage = " << stats.mGarbageNum
+    << ", used = " << stats.mNtUsedNum
+    << ", max chain = " << stats.mNtMaxChain
+    << ", avg chain = " << avg_chain
+    << ", resize = " << stats.mNtResizeList.size()
+    << endl;
+
+  s << "  gc: count = " << stats.mGcNum
+    << ", total = " << stats.mGcTotalTime << "us"
+    << ", max = " << stats.mGcMaxTime << "us"
+    << endl;
+  ymuint last = 0;
+  for (ymuint i = 0; i < BddMgrStats::kGcHistSize; ++ i) {
+    if ( stats.mGcHist[i] > 0 ) {
+      last = i + 1;
+    }
+  }
+  for (ymuint i = 0; i < last; ++ i) {
+    s << "    < ";
+    if ( i < BddMgrStats::kGcHistSize - 1 ) {
+      s << (1ULL << i) << "us";
+    }
+    else {
+      s << "inf";
+    }
+    s << ": " << stats.mGcHist[i] << endl;
+  }
+}
+
+// @brief 統計情報を定期的にログ出力する間隔を設定する．
+// @param[in] interval GC の回数(0 の時は出力しない)
+void
+BddMgrImpl::set_stats_interval(ymuint interval)
+{
+  mStatsInterval = interval;
+}
+
+// @brief 統計情報のカウンタをクリアする．
+void
+BddMgrImpl::clear_stats()
+{
+  for (list<CompTbl*>::iterator p = mTblList.begin();
+       p != mTblList.end(); ++ p) {
+    CompTbl* tbl = *p;
+    tbl->clear_stats();
+  }
+  mGcNum = 0;
+  mGcTotalTime = 0.0;
+  mGcMaxTime = 0.0;
+  for (ymuint i = 0; i < BddMgrStats::kGcHistSize; ++ i) {
+    mGcHist[i] = 0;
+  }
+  mNtResizeList.clear();
+}
+
+// @brief 節点テーブルのサイズ変更を記録する．
+// @param[in] old_size 変更前のサイズ
+// @param[in] new_size 変更後のサイズ
+void
+BddMgrImpl::add_nt_resize_event(ymuint64 old_size,
+				ymuint64 new_size)
+{
+  if ( old_size == 0 ) {
+    // 最初の確保は記録しない．
+    return;
+  }
+  BddNtResizeEvent ev;
+  ev.mOldSize = old_size;
+  ev.mNewSize = new_size;
+  ev.mNodeNum = node_num();
+  ev.mGcCount = gc_count();
+  mNtResizeList.push_back(ev);
+}
+
+// @brief 節点テーブルを走査して統計情報を積算する．
+// @param[in] table テーブル本体
+// @param[in] size テーブルサイズ
+// @param[inout] stats 結果を格納する変数
+void
+BddMgrImpl::scan_nodetable(BddNode** table,
+			   ymuint64 size,
+			   BddMgrStats& stats) const
+{
+  stats.mNtSize += size;
+  if ( table == nullptr ) {
+    return;
+  }
+  for (ymuint64 i = 0; i < size; ++ i) {
+    ymuint64 n = 0;
+    for (BddNode* node = table[i]; node; node = node->mLink) {
+      ++ n;
+    }
+    if ( n > 0 ) {
+      ++ stats.mNtUsedNum;
+      if ( stats.mNtMaxChain < n ) {
+	stats.mNtMaxChain = n;
+      }
+    }
+  }
 }
 
 // log用ストリームを設定する．
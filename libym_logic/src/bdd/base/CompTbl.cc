@@ -23,15 +23,22 @@ BEGIN_NAMESPACE_YM_BDD
 CompTbl::CompTbl(BddMgrImpl* mgr,
 		 const char* name) :
   mMgr(mgr),
-  mName(name),
+  mName(name != nullptr ? name : ""),
   mTableSize(0),
-  mMaxSize(0)
+  mMaxSize(0),
+  mLookupNum(0),
+  mHitNum(0),
+  mInsertNum(0),
+  mCollisionNum(0),
+  mResizeNum(0)
 {
+  mMgr->mTblList.push_back(this);
 }
 
 // @brief デストラクタ
 CompTbl::~CompTbl()
 {
+  mMgr->mTblList.remove(this);
 }
 
 // @brief 最大のテーブルサイズを設定する．
@@ -46,11 +53,25 @@ CompTbl::max_size(ymuint64 max_size)
 void
 CompTbl::set_table_size(ymuint64 new_size)
 {
+  if ( mTableSize > 0 ) {
+    ++ mResizeNum;
+  }
   mTableSize = new_size;
   double load_limit = mMgr->rt_load_limit();
   mNextLimit = static_cast<ymuint64>(double(mTableSize) * load_limit);
 }
 
+// @brief 統計情報のカウンタをクリアする．
+void
+CompTbl::clear_stats()
+{
+  mLookupNum = 0;
+  mHitNum = 0;
+  mInsertNum = 0;
+  mCollisionNum = 0;
+  mResizeNum = 0;
+}
+
 // BddMgr からメモリを確保する．
 void*
 CompTbl::allocate(ymuint64 size)
@@ -32,6 +32,7 @@ public:
 	  const char* name);
 
   /// @brief デストラクタ
+  virtual
   ~CompTbl();
 
 
@@ -45,8 +46,9 @@ public:
   name() const;
 
   /// @brief 使用されているセル数を返す．
+  virtual
   ymuint64
-  used_num() const;
+  used_num() const = 0;
 
   /// @brief テーブルサイズを返す．
   ymuint64
@@ -56,6 +58,30 @@ public:
   void
   max_size(ymuint64 max_size);
 
+  /// @brief 検索回数を返す．
+  ymuint64
+  lookup_num() const;
+
+  /// @brief 検索がヒットした回数を返す．
+  ymuint64
+  hit_num() const;
+
+  /// @brief 登録回数を返す．
+  ymuint64
+  insert_num() const;
+
+  /// @brief 登録時に別のエントリを上書きした回数を返す．
+  ymuint64
+  collision_num() const;
+
+  /// @brief テーブルを拡張した回数を返す．
+  ymuint64
+  resize_num() const;
+
+  /// @brief 統計情報のカウンタをクリアする．
+  void
+  clear_stats();
+
 
 protected:
   //////////////////////////////////////////////////////////////////////
@@ -72,6 +98,19 @@ protected:
   bool
   check_tablesize(ymuint64 num) const;
 
+  /// @brief 検索回数を数える．
+  /// @param[in] hit ヒットした時 true
+  void
+  count_lookup(bool hit);
+
+  /// @brief 登録回数を数える．
+  void
+  count_insert();
+
+  /// @brief 衝突回数を数える．
+  void
+  count_collision();
+
   // BddMgr からメモリを確保する．
   void*
   allocate(ymuint64 size);
@@ -107,6 +146,21 @@ private:
   // mUsedNumがこの値を越えたらテーブルを拡張する
   ymuint64 mNextLimit;
 
+  // 検索回数
+  ymuint64 mLookupNum;
+
+  // 検索がヒットした回数
+  ymuint64 mHitNum;
+
+  // 登録回数
+  ymuint64 mInsertNum;
+
+  // 登録時に別のエントリを上書きした回数
+  ymuint64 mCollisionNum;
+
+  // テーブルを拡張した回数
+  ymuint64 mResizeNum;
+
 };
 
 
@@ -138,6 +192,73 @@ CompTbl::check_tablesize(ymuint64 num) const
   return num > mNextLimit && (mMaxSize == 0 || mTableSize < mMaxSize);
 }
 
+// @brief 検索回数を返す．
+inline
+ymuint64
+CompTbl::lookup_num() const
+{
+  return mLookupNum;
+}
+
+// @brief 検索がヒットした回数を返す．
+inline
+ymuint64
+CompTbl::hit_num() const
+{
+  return mHitNum;
+}
+
+// @brief 登録回数を返す．
+inline
+ymuint64
+CompTbl::insert_num() const
+{
+  return mInsertNum;
+}
+
+// @brief 登録時に別のエントリを上書きした回数を返す．
+inline
+ymuint64
+CompTbl::collision_num() const
+{
+  return mCollisionNum;
+}
+
+// @brief テーブルを拡張した回数を返す．
+inline
+ymuint64
+CompTbl::resize_num() const
+{
+  return mResizeNum;
+}
+
+// @brief 検索回数を数える．
+inline
+void
+CompTbl::count_lookup(bool hit)
+{
+  ++ mLookupNum;
+  if ( hit ) {
+    ++ mHitNum;
+  }
+}
+
+// @brief 登録回数を数える．
+inline
+void
+CompTbl::count_insert()
+{
+  ++ mInsertNum;
+}
+
+// @brief 衝突回数を数える．
+inline
+void
+CompTbl::count_collision()
+{
+  ++ mCollisionNum;
+}
+
 END_NAMESPACE_YM_BDD
 
 #endif // COMPTBL_H
@@ -61,6 +61,11 @@ public:
   void
   clear();
 
+  /// @brief 使用されているセル数を返す．
+  virtual
+  ymuint64
+  used_num() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -124,9 +129,11 @@ CompTbl1::get(BddEdge id1)
 {
   Cell* tmp = mTable + hash_func(id1);
   if ( tmp->mKey1 != id1 ) {
+    count_lookup(false);
     return BddEdge::make_error();
   }
   else {
+    count_lookup(true);
     return tmp->mAns;
   }
 }
@@ -146,11 +153,25 @@ CompTbl1::put(BddEdge id1,
     }
   }
   Cell* tmp = mTable + hash_func(id1);
-  if ( tmp->mKey1.is_error() ) ++ mUsedNum;
+  if ( tmp->mKey1.is_error() ) {
+    ++ mUsedNum;
+  }
+  else if ( tmp->mKey1 != id1 ) {
+    count_collision();
+  }
+  count_insert();
   tmp->mKey1 = id1;
   tmp->mAns = ans;
 }
 
+// @brief 使用されているセル数を返す．
+inline
+ymuint64
+CompTbl1::used_num() const
+{
+  return mUsedNum;
+}
+
 END_NAMESPACE_YM_BDD
 
 #endif // COMPTBL1_H
@@ -62,6 +62,11 @@ public:
   void
   clear();
 
+  /// @brief 使用されているセル数を返す．
+  virtual
+  ymuint64
+  used_num() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -131,9 +136,11 @@ CompTbl2::get(BddEdge id1,
 {
   Cell* tmp = mTable + hash_func(id1, id2);
   if ( tmp->mKey1 != id1 || tmp->mKey2 != id2 ) {
+    count_lookup(false);
     return BddEdge::make_error();
   }
   else {
+    count_lookup(true);
     return tmp->mAns;
   }
 }
@@ -154,12 +161,26 @@ CompTbl2::put(BddEdge id1,
     }
   }
   Cell* tmp = mTable + hash_func(id1, id2);
-  if ( tmp->mKey1.is_error() ) ++ mUsedNum;
+  if ( tmp->mKey1.is_error() ) {
+    ++ mUsedNum;
+  }
+  else if ( tmp->mKey1 != id1 || tmp->mKey2 != id2 ) {
+    count_collision();
+  }
+  count_insert();
   tmp->mKey1 = id1;
   tmp->mKey2 = id2;
   tmp->mAns = ans;
 }
 
+// @brief 使用されているセル数を返す．
+inline
+ymuint64
+CompTbl2::used_num() const
+{
+  return mUsedNum;
+}
+
 END_NAMESPACE_YM_BDD
 
 #endif // COMPTBL2_H
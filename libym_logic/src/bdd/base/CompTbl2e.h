@@ -65,6 +65,11 @@ public:
   void
   clear();
 
+  /// @brief 使用されているセル数を返す．
+  virtual
+  ymuint64
+  used_num() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -136,9 +141,11 @@ CompTbl2e::get(BddEdge id1,
 {
   Cell* tmp = mTable + hash_func(id1, id2);
   if ( tmp->mKey1 != id1 || tmp->mKey2 != id2 ) {
+    count_lookup(false);
     return BddEdge::make_error();
   }
   else {
+    count_lookup(true);
     ans_cov = *(tmp->mAnsCov);
     return tmp->mAnsBdd;
   }
@@ -161,7 +168,13 @@ CompTbl2e::put(BddEdge id1,
     }
   }
   Cell* tmp = mTable + hash_func(id1, id2);
-  if ( tmp->mKey1.is_error() ) mUsedNum ++;
+  if ( tmp->mKey1.is_error() ) {
+    ++ mUsedNum;
+  }
+  else if ( tmp->mKey1 != id1 || tmp->mKey2 != id2 ) {
+    count_collision();
+  }
+  count_insert();
   tmp->mKey1 = id1;
   tmp->mKey2 = id2;
   tmp->mAnsBdd = ans_bdd;
@@ -169,6 +182,14 @@ CompTbl2e::put(BddEdge id1,
   tmp->mAnsCov = new Expr(ans_cov);
 }
 
+// @brief 使用されているセル数を返す．
+inline
+ymuint64
+CompTbl2e::used_num() const
+{
+  return mUsedNum;
+}
+
 END_NAMESPACE_YM_BDD
 
 #endif // COMPTBL2E_H
@@ -65,6 +65,11 @@ public:
   void
   clear();
 
+  /// @brief 使用されているセル数を返す．
+  virtual
+  ymuint64
+  used_num() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -139,9 +144,11 @@ CompTbl3::get(BddEdge id1,
 {
   Cell* tmp = mTable + hash_func(id1, id2, id3);
   if ( tmp->mKey1 != id1 || tmp->mKey2 != id2 || tmp->mKey3 != id3 ) {
+    count_lookup(false);
     return BddEdge::make_error();
   }
   else {
+    count_lookup(true);
     return tmp->mAns;
   }
 }
@@ -166,13 +173,27 @@ CompTbl3::put(BddEdge id1,
     }
   }
   Cell* tmp = mTable + hash_func(id1, id2, id3);
-  if ( tmp->mKey1.is_error() ) mUsedNum ++;
+  if ( tmp->mKey1.is_error() ) {
+    ++ mUsedNum;
+  }
+  else if ( tmp->mKey1 != id1 || tmp->mKey2 != id2 || tmp->mKey3 != id3 ) {
+    count_collision();
+  }
+  count_insert();
   tmp->mKey1 = id1;
   tmp->mKey2 = id2;
   tmp->mKey3 = id3;
   tmp->mAns = ans;
 }
 
+// @brief 使用されているセル数を返す．
+inline
+ymuint64
+CompTbl3::used_num() const
+{
+  return mUsedNum;
+}
+
 END_NAMESPACE_YM_BDD
 
 #endif // COMPTBL3_H
@@ -65,6 +65,10 @@ SmoothOp::apply_step(BddEdge e,
   ymuint slevel = snode->level();
   while ( slevel < level ) {
     s = snode->edge1();
+    if ( s.is_one() ) {
+      // 消去対象の変数が残っていない．
+      return e;
+    }
     snode = s.get_node();
     slevel = snode->level();
   }
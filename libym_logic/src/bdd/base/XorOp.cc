@@ -104,22 +104,22 @@ XorOp::apply_step(BddEdge f,
   if ( f_0.is_zero() && f_1.is_one() ) {
     // f が肯定のリテラルで最上位のレベルの場合
     // f_0 と f_1 が異なっているということは f_level == level である．
-    result = new_node(level, ~g_0, g_1);
+    result = new_node(level, g_0, ~g_1);
   }
   else if ( f_0.is_one() && f_1.is_zero() ) {
     // f が否定のリテラルで最上位のレベルの場合
     // f_0 と f_1 が異なっているということは f_level == level である．
-    result = new_node(level, g_0, ~g_1);
+    result = new_node(level, ~g_0, g_1);
   }
   else if ( g_0.is_zero() && g_1.is_one() ) {
     // g が肯定のリテラルで最上位のレベルの場合
     // g_0 と g_1 が異なっているということは g_level == level である．
-    result = new_node(level, ~f_0, f_1);
+    result = new_node(level, f_0, ~f_1);
   }
   else if ( g_0.is_one() && g_1.is_zero() ) {
     // g が否定のリテラルで最上位のレベルの場合
     // g_0 と g_1 が異なっているということは g_level == level である．
-    result = new_node(level, f_0, ~f_1);
+    result = new_node(level, ~f_0, f_1);
   }
   else {
     // 演算結果テーブルを探す．
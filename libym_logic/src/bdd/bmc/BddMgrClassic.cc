@@ -405,6 +405,13 @@ BddMgrClassic::_gc(bool shrink_nodetable)
 	      << endl;
 }
 
+// 節点テーブルの統計情報を得る．
+void
+BddMgrClassic::nodetable_stats(BddMgrStats& stats) const
+{
+  scan_nodetable(mNodeTable, mTableSize, stats);
+}
+
 // 節点テーブルを拡張する
 // メモリアロケーションに失敗したら false を返す．
 bool
@@ -420,6 +427,7 @@ BddMgrClassic::resize(ymuint64 new_size)
 
   ymuint64 old_size = mTableSize;
   BddNode** old_table = mNodeTable;
+  add_nt_resize_event(old_size, new_size);
   mNodeTable = new_table;
   mTableSize = new_size;
   mTableSize_1 = mTableSize - 1;
@@ -424,6 +424,11 @@ private:
   void
   _gc(bool shrink_nodetable);
 
+  // 節点テーブルの統計情報を得る．
+  virtual
+  void
+  nodetable_stats(BddMgrStats& stats) const;
+
   // 演算結果テーブルを登録する．
   void
   add_table(CompTbl* tbl);
@@ -470,6 +470,22 @@ BddMgrModern::_gc(bool shrink_nodetable)
 	      << endl;
 }
 
+// 節点テーブルの統計情報を得る．
+// 変数順の入れ替えが可能な時は変数ごとのテーブルを合計する．
+void
+BddMgrModern::nodetable_stats(BddMgrStats& stats) const
+{
+  if ( is_reorderable() ) {
+    for (ymuint i = 0; i < mVarNum; ++ i) {
+      BmmVar* var = mVarTable[i];
+      scan_nodetable(var->mNodeTable, var->mTableSize, stats);
+    }
+  }
+  else {
+    scan_nodetable(mNodeTable, mTableSize, stats);
+  }
+}
+
 // 節点テーブルを拡張する
 // メモリアロケーションに失敗したら false を返す．
 bool
@@ -485,6 +501,7 @@ BddMgrModern::resize(ymuint64 new_size)
 
   ymuint64 old_size = mTableSize;
   BddNode** old_table = mNodeTable;
+  add_nt_resize_event(old_size, new_size);
   mNodeTable = new_table;
   mTableSize = new_size;
   mTableSize_1 = mTableSize - 1;
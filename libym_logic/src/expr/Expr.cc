@@ -8,6 +8,7 @@
 
 
 #include "YmLogic/Expr.h"
+#include "YmLogic/ExprCode.h"
 
 #include "ExprMgr.h"
 #include "ExprNode.h"
@@ -315,6 +316,9 @@ Expr::eval(const vector<ymulong>& vals,
 }
 
 // @brief 真理値表の作成
+//
+// 命令列に変換して 64 パタンずつまとめて評価する．
+// 共有されている部分式も一度しか計算しない．
 TvFunc
 Expr::make_tv(ymuint ni) const
 {
@@ -322,7 +326,8 @@ Expr::make_tv(ymuint ni) const
   if ( ni < ni2 ) {
     ni = ni2;
   }
-  return root()->make_tv(ni);
+  ExprCode code(*this);
+  return code.make_tv(ni);
 }
 #if 0
   // とりあえずベタなやり方．
@@ -566,49 +571,49 @@ Expr::sop_litnum(VarId varid,
 ymuint
 Expr::used_size()
 {
-  return ExprMgr::the_obj().used_size();
+  return ExprMgr::used_size();
 }
 
 // 現在使用中のノード数を返す．
 ymuint
 Expr::node_num()
 {
-  return ExprMgr::the_obj().node_num();
+  return ExprMgr::node_num();
 }
 
 // @brief used_size() の最大値を返す．
 ymuint
 Expr::max_used_size()
 {
-  return ExprMgr::the_obj().max_used_size();
+  return ExprMgr::max_used_size();
 }
 
 // @brief nodenum() の最大値を返す．
 ymuint
 Expr::max_node_num()
 {
-  return ExprMgr::the_obj().max_node_num();
+  return ExprMgr::max_node_num();
 }
 
 // @brief 実際に確保したメモリ量を返す．
 ymuint
 Expr::allocated_size()
 {
-  return ExprMgr::the_obj().allocated_size();
+  return ExprMgr::allocated_size();
 }
 
 // @brief 実際に確保した回数を返す．
 ymuint
 Expr::allocated_count()
 {
-  return ExprMgr::the_obj().allocated_count();
+  return ExprMgr::allocated_count();
 }
 
 // @brief 内部状態を出力する．
 void
 Expr::print_stats(ostream& s)
 {
-  ExprMgr::the_obj().print_stats(s);
+  ExprMgr::print_stats(s);
 }
 
 // 論理式をパーズしてファクタードフォームを作る．
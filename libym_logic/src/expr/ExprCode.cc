@@ -0,0 +1,391 @@
+﻿
+/// @file ExprCode.cc
+/// @brief ExprCode の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmLogic/ExprCode.h"
+#include "YmLogic/Expr.h"
+#include "YmLogic/TvFunc.h"
+#include "ExprNode.h"
+
+
+BEGIN_NAMESPACE_YM_EXPR
+
+BEGIN_NONAMESPACE
+
+// ブロック内の入力変数のパタン
+const ymuint64 c_var_pat[] = {
+  0xAAAAAAAAAAAAAAAAUL,
+  0xCCCCCCCCCCCCCCCCUL,
+  0xF0F0F0F0F0F0F0F0UL,
+  0xFF00FF00FF00FF00UL,
+  0xFFFF0000FFFF0000UL,
+  0xFFFFFFFF00000000UL
+};
+
+// 単一ワード版の eval() でスタック上に確保する中間結果用のレジスタ数
+const ymuint kLocalRegNum = 64;
+
+// ノードをハッシュ表のキーに変換する．
+inline
+ympuint
+node_key(const ExprNode* node)
+{
+  return reinterpret_cast<ympuint>(node) / sizeof(void*);
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス ExprCode
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+ExprCode::ExprCode() :
+  mInputNum(0),
+  mRegNum(0),
+  mOutReg(0)
+{
+  mOutReg = new_reg();
+  add_instr(kOpConst0, mOutReg);
+}
+
+// @brief 論理式を指定したコンストラクタ
+// @param[in] expr 対象の論理式
+ExprCode::ExprCode(const Expr& expr)
+{
+  compile(expr);
+}
+
+// @brief デストラクタ
+ExprCode::~ExprCode()
+{
+}
+
+// @brief 論理式を変換する．
+// @param[in] expr 対象の論理式
+void
+ExprCode::compile(const Expr& expr)
+{
+  mInputNum = expr.input_size();
+  mRegNum = 0;
+  mInstrList.clear();
+  mFreeRegList.clear();
+
+  const ExprNode* root = expr.root();
+  HashMap<ympuint, ymuint> ref_map;
+  HashMap<ympuint, ymuint> reg_map;
+  count_ref(root, ref_map);
+  mOutReg = compile_node(root, ref_map, reg_map);
+
+  mFreeRegList.clear();
+}
+
+// @brief ノードの参照回数を数える．
+// @param[in] node 対象のノード
+// @param[in] ref_map 参照回数を格納するハッシュ表
+void
+ExprCode::count_ref(const ExprNode* node,
+		    HashMap<ympuint, ymuint>& ref_map)
+{
+  ympuint key = node_key(node);
+  ymuint n;
+  if ( ref_map.find(key, n) ) {
+    ref_map[key] = n + 1;
+    return;
+  }
+  ref_map.add(key, 1);
+
+  if ( node->is_op() ) {
+    ymuint nc = node->child_num();
+    for (ymuint i = 0; i < nc; ++ i) {
+      count_ref(node->child(i), ref_map);
+    }
+  }
+}
+
+// @brief ノードを変換する．
+// @param[in] node 対象のノード
+// @param[in] ref_map 参照回数を格納するハッシュ表
+// @param[in] reg_map 結果のレジスタを格納するハッシュ表
+// @return 結果のレジスタ番号を返す．
+ymuint
+ExprCode::compile_node(const ExprNode* node,
+		       HashMap<ympuint, ymuint>& ref_map,
+		       HashMap<ympuint, ymuint>& reg_map)
+{
+  ympuint key = node_key(node);
+  ymuint reg;
+  if ( reg_map.find(key, reg) ) {
+    // 共有されているノードは一度だけ変換する．
+    return reg;
+  }
+
+  if ( node->is_zero() ) {
+    reg = new_reg();
+    add_instr(kOpConst0, reg);
+  }
+  else if ( node->is_one() ) {
+    reg = new_reg();
+    add_instr(kOpConst1, reg);
+  }
+  else if ( node->is_posiliteral() ) {
+    // 入力用のレジスタをそのまま用いる．
+    reg = node->varid().val();
+  }
+  else if ( node->is_negaliteral() ) {
+    reg = new_reg();
+    add_instr(kOpNot, reg, node->varid().val());
+  }
+  else {
+    tOpCode op = kOpAnd;
+    if ( node->is_or() ) {
+      op = kOpOr;
+    }
+    else if ( node->is_xor() ) {
+      op = kOpXor;
+    }
+
+    ymuint nc = node->child_num();
+    vector<ymuint> src_list(nc);
+    for (ymuint i = 0; i < nc; ++ i) {
+      src_list[i] = compile_node(node->child(i), ref_map, reg_map);
+    }
+
+    // 結果のレジスタはオペランドのレジスタを解放する前に確保するので
+    // オペランドと重なることはない．
+    reg = new_reg();
+    add_instr(op, reg, src_list[0], src_list[1]);
+    for (ymuint i = 2; i < nc; ++ i) {
+      add_instr(op, reg, reg, src_list[i]);
+    }
+
+    for (ymuint i = 0; i < nc; ++ i) {
+      release_node(node->child(i), ref_map, reg_map);
+    }
+  }
+
+  reg_map.add(key, reg);
+  return reg;
+}
+
+// @brief ノードの参照が一つ終わったことを記録する．
+// @param[in] node 対象のノード
+// @param[in] ref_map 参照回数を格納するハッシュ表
+// @param[in] reg_map 結果のレジスタを格納するハッシュ表
+// @note 参照回数が 0 になったら中間結果用のレジスタを解放する．
+void
+ExprCode::release_node(const ExprNode* node,
+		       HashMap<ympuint, ymuint>& ref_map,
+		       HashMap<ympuint, ymuint>& reg_map)
+{
+  ympuint key = node_key(node);
+  ymuint n = ref_map[key] - 1;
+  ref_map[key] = n;
+  if ( n == 0 ) {
+    ymuint reg = reg_map[key];
+    if ( reg >= mInputNum ) {
+      mFreeRegList.push_back(reg);
+    }
+  }
+}
+
+// @brief 中間結果用のレジスタを確保する．
+ymuint
+ExprCode::new_reg()
+{
+  if ( !mFreeRegList.empty() ) {
+    ymuint reg = mFreeRegList.back();
+    mFreeRegList.pop_back();
+    return reg;
+  }
+  ymuint reg = mInputNum + mRegNum;
+  ++ mRegNum;
+  return reg;
+}
+
+// @brief 命令を追加する．
+void
+ExprCode::add_instr(tOpCode op,
+		    ymuint dst,
+		    ymuint src1,
+		    ymuint src2)
+{
+  Instr instr;
+  instr.mOpCode = op;
+  instr.mDst = dst;
+  instr.mSrc1 = src1;
+  instr.mSrc2 = src2;
+  mInstrList.push_back(instr);
+}
+
+// @brief 値の評価
+// @param[in] vals 変数の値割り当て
+// @param[in] mask 使用するビットのためのマスク
+// @return 評価値
+ymulong
+ExprCode::eval(const vector<ymulong>& vals,
+	       ymulong mask) const
+{
+  ASSERT_COND( vals.size() >= mInputNum );
+
+  // 中間結果用のレジスタ
+  // ほとんどの場合はスタック上の領域で足りる．
+  ymulong local_reg[kLocalRegNum];
+  vector<ymulong> heap_reg;
+  ymulong* reg_top = local_reg;
+  if ( mRegNum > kLocalRegNum ) {
+    heap_reg.resize(mRegNum);
+    reg_top = &heap_reg[0];
+  }
+
+  for (vector<Instr>::const_iterator p = mInstrList.begin();
+       p != mInstrList.end(); ++ p) {
+    const Instr& instr = *p;
+    ymulong& dst = reg_top[instr.mDst - mInputNum];
+    ymulong src1 = instr.mSrc1 < mInputNum ?
+      vals[instr.mSrc1] : reg_top[instr.mSrc1 - mInputNum];
+    ymulong src2 = instr.mSrc2 < mInputNum ?
+      vals[instr.mSrc2] : reg_top[instr.mSrc2 - mInputNum];
+    switch ( instr.mOpCode ) {
+    case kOpConst0: dst = 0UL; break;
+    case kOpConst1: dst = mask; break;
+    case kOpNot:    dst = ~src1 & mask; break;
+    case kOpAnd:    dst = src1 & src2; break;
+    case kOpOr:     dst = src1 | src2; break;
+    case kOpXor:    dst = src1 ^ src2; break;
+    default: ASSERT_NOT_REACHED;
+    }
+  }
+
+  return mOutReg < mInputNum ? vals[mOutReg] : reg_top[mOutReg - mInputNum];
+}
+
+// @brief 複数ワードの値の評価
+// @param[in] vals 変数の値割り当て
+// @param[in] wn 1変数あたりのワード数
+// @param[out] out 評価値を格納する領域
+void
+ExprCode::eval(const ymuint64* vals,
+	       ymuint wn,
+	       ymuint64* out) const
+{
+  vector<ymuint64> work;
+  eval(vals, wn, out, work);
+}
+
+// @brief 作業領域を指定した複数ワードの値の評価
+// @param[in] vals 変数の値割り当て
+// @param[in] wn 1変数あたりのワード数
+// @param[out] out 評価値を格納する領域
+// @param[in] work 中間結果用の作業領域
+void
+ExprCode::eval(const ymuint64* vals,
+	       ymuint wn,
+	       ymuint64* out,
+	       vector<ymuint64>& work) const
+{
+  // 中間結果用のレジスタ
+  // 各命令の内側のループは単純な配列演算なので
+  // コンパイラによるベクトル化が期待できる．
+  if ( work.size() < mRegNum * wn ) {
+    work.resize(mRegNum * wn);
+  }
+  ymuint64* work_top = work.empty() ? NULL : &work[0];
+
+  for (vector<Instr>::const_iterator p = mInstrList.begin();
+       p != mInstrList.end(); ++ p) {
+    const Instr& instr = *p;
+    ymuint64* dst = work_top + (instr.mDst - mInputNum) * wn;
+    const ymuint64* src1 = instr.mSrc1 < mInputNum ?
+      vals + instr.mSrc1 * wn : work_top + (instr.mSrc1 - mInputNum) * wn;
+    const ymuint64* src2 = instr.mSrc2 < mInputNum ?
+      vals + instr.mSrc2 * wn : work_top + (instr.mSrc2 - mInputNum) * wn;
+    switch ( instr.mOpCode ) {
+    case kOpConst0:
+      for (ymuint i = 0; i < wn; ++ i) {
+	dst[i] = 0UL;
+      }
+      break;
+
+    case kOpConst1:
+      for (ymuint i = 0; i < wn; ++ i) {
+	dst[i] = ~0UL;
+      }
+      break;
+
+    case kOpNot:
+      for (ymuint i = 0; i < wn; ++ i) {
+	dst[i] = ~src1[i];
+      }
+      break;
+
+    case kOpAnd:
+      for (ymuint i = 0; i < wn; ++ i) {
+	dst[i] = src1[i] & src2[i];
+      }
+      break;
+
+    case kOpOr:
+      for (ymuint i = 0; i < wn; ++ i) {
+	dst[i] = src1[i] | src2[i];
+      }
+      break;
+
+    case kOpXor:
+      for (ymuint i = 0; i < wn; ++ i) {
+	dst[i] = src1[i] ^ src2[i];
+      }
+      break;
+
+    default:
+      ASSERT_NOT_REACHED;
+    }
+  }
+
+  const ymuint64* src = mOutReg < mInputNum ?
+    vals + mOutReg * wn : work_top + (mOutReg - mInputNum) * wn;
+  for (ymuint i = 0; i < wn; ++ i) {
+    out[i] = src[i];
+  }
+}
+
+// @brief 真理値表の作成
+// @param[in] ni 入力数
+TvFunc
+ExprCode::make_tv(ymuint ni) const
+{
+  if ( ni < mInputNum ) {
+    ni = mInputNum;
+  }
+
+  // 1ブロックあたり 64 個の入力パタンを割り当てる．
+  ymuint wn = ni <= 6 ? 1 : (1U << (ni - 6));
+  vector<ymuint64> vals(mInputNum * wn);
+  for (ymuint var = 0; var < mInputNum; ++ var) {
+    ymuint64* dst = &vals[var * wn];
+    if ( var < 6 ) {
+      ymuint64 pat = c_var_pat[var];
+      for (ymuint b = 0; b < wn; ++ b) {
+	dst[b] = pat;
+      }
+    }
+    else {
+      ymuint shift = var - 6;
+      for (ymuint b = 0; b < wn; ++ b) {
+	dst[b] = ((b >> shift) & 1U) ? ~0UL : 0UL;
+      }
+    }
+  }
+
+  vector<ymuint64> out(wn);
+  eval(vals.empty() ? NULL : &vals[0], wn, &out[0]);
+  return TvFunc(ni, out);
+}
+
+END_NAMESPACE_YM_EXPR
@@ -10,31 +10,102 @@
 #include "ExprMgr.h"
 #include "ExprNode.h"
 
+#include "YmUtils/SlabPool.h"
+#include <mutex>
+
 
 BEGIN_NAMESPACE_YM_EXPR
 
+BEGIN_NONAMESPACE
+
+// gMgrList と gFreeMgrList を保護する mutex
+std::mutex gMutex;
+
+// 全てのインスタンスの mNodeAlloc にスラブを供給するプール
+SlabPool gNodePool;
+
+// 生成した全てのインスタンスのリスト
+vector<ExprMgr*> gMgrList;
+
+// どのスレッドにも割り当てられていないインスタンスのリスト
+vector<ExprMgr*> gFreeMgrList;
+
+// 使用中のノード数
+// ノードは生成したスレッドとは別のスレッドで削除されることがあるので
+// インスタンスごとではなく全体で数える．
+std::atomic<ymuint32> gNodeNum(0);
+
+// 使用した最大のノード数
+std::atomic<ymuint32> gMaxNodeNum(0);
+
+// 使用中のメモリ量
+// ノードと同じ理由で全体で数える．
+std::atomic<ymuint64> gUsedSize(0);
+
+// 使用した最大のメモリ量
+std::atomic<ymuint64> gMaxUsedSize(0);
+
+// 最大値を更新する．
+template<typename T>
+inline
+void
+update_max(std::atomic<T>& max_val,
+	   T val)
+{
+  T old_val = max_val.load(std::memory_order_relaxed);
+  while ( old_val < val &&
+	  !max_val.compare_exchange_weak(old_val, val,
+					 std::memory_order_relaxed) ) ;
+}
+
+// スレッドに割り当てられたインスタンスを保持するクラス
+// スレッドの終了時にインスタンスを gFreeMgrList に戻す．
+struct MgrHolder
+{
+  // デストラクタ
+  ~MgrHolder()
+  {
+    if ( mMgr ) {
+      std::lock_guard<std::mutex> lock(gMutex);
+      gFreeMgrList.push_back(mMgr);
+    }
+  }
+
+  // インスタンス
+  ExprMgr* mMgr;
+};
+
+// 現在のスレッドのインスタンス
+thread_local MgrHolder gHolder = { nullptr };
+
+END_NONAMESPACE
+
+
 //////////////////////////////////////////////////////////////////////
 // クラス ExprMgr
 //////////////////////////////////////////////////////////////////////
 
-// 唯一のオブジェクト
-static ExprMgr* mTheObj = nullptr;
-
-// @brief 唯一のインスタンスを返す．
+// @brief 現在のスレッドのインスタンスを返す．
 ExprMgr&
 ExprMgr::the_obj()
 {
-  if ( mTheObj == nullptr ) {
-    mTheObj = new ExprMgr;
+  if ( gHolder.mMgr == nullptr ) {
+    std::lock_guard<std::mutex> lock(gMutex);
+    if ( gFreeMgrList.empty() ) {
+      gHolder.mMgr = new ExprMgr;
+      gMgrList.push_back(gHolder.mMgr);
+    }
+    else {
+      gHolder.mMgr = gFreeMgrList.back();
+      gFreeMgrList.pop_back();
+    }
   }
-  return *mTheObj;
+  return *gHolder.mMgr;
 }
 
 // @brief コンストラクタ
 ExprMgr::ExprMgr() :
-  mNodeAlloc(4096),
-  mNodeNum(0),
-  mMaxNodeNum(0),
+  mNodeAlloc(gNodePool, 4096),
   mStuckNodeNum(0)
 {
 }
@@ -49,8 +120,19 @@ ExprMgr::~ExprMgr()
 void
 ExprMgr::clear_memory()
 {
-  delete mTheObj;
-  mTheObj = nullptr;
+  std::lock_guard<std::mutex> lock(gMutex);
+  for (vector<ExprMgr*>::iterator p = gMgrList.begin();
+       p != gMgrList.end(); ++ p) {
+    delete *p;
+  }
+  gMgrList.clear();
+  gFreeMgrList.clear();
+  gHolder.mMgr = nullptr;
+  gNodePool.trim();
+  gNodeNum = 0;
+  gMaxNodeNum = 0;
+  gUsedSize = 0;
+  gMaxUsedSize = 0;
 }
 
 // 恒偽関数を作る．
@@ -615,55 +697,78 @@ ExprMgr::simplify(const ExprNode* node)
 ymuint
 ExprMgr::used_size()
 {
-  return mNodeAlloc.used_size();
+  return gUsedSize;
 }
 
 // @brief 使用されているノード数を返す．
 ymuint
 ExprMgr::node_num()
 {
-  return mNodeNum;
+  return gNodeNum;
 }
 
 // @brief used_size() の最大値を返す．
 ymuint
 ExprMgr::max_used_size()
 {
-  return mNodeAlloc.max_used_size();
+  return gMaxUsedSize;
 }
 
 // @brief nodenum() の最大値を返す．
 ymuint
 ExprMgr::max_node_num()
 {
-  return mMaxNodeNum;
+  return gMaxNodeNum;
 }
 
 // @brief 実際に確保したメモリ量を返す．
 ymuint
 ExprMgr::allocated_size()
 {
-  return mNodeAlloc.allocated_size();
+  std::lock_guard<std::mutex> lock(gMutex);
+  ymuint size = 0;
+  for (vector<ExprMgr*>::iterator p = gMgrList.begin();
+       p != gMgrList.end(); ++ p) {
+    size += (*p)->mNodeAlloc.allocated_size();
+  }
+  return size;
 }
 
 // @brief 実際に確保した回数を返す．
 ymuint
 ExprMgr::allocated_count()
 {
-  return mNodeAlloc.allocated_count();
+  std::lock_guard<std::mutex> lock(gMutex);
+  ymuint count = 0;
+  for (vector<ExprMgr*>::iterator p = gMgrList.begin();
+       p != gMgrList.end(); ++ p) {
+    count += (*p)->mNodeAlloc.allocated_count();
+  }
+  return count;
 }
 
 // @brief 内部状態を出力する．
 void
 ExprMgr::print_stats(ostream& s)
 {
+  ymuint stuck_num = 0;
+  ymuint mgr_num = 0;
+  {
+    std::lock_guard<std::mutex> lock(gMutex);
+    for (vector<ExprMgr*>::iterator p = gMgrList.begin();
+	 p != gMgrList.end(); ++ p) {
+      stuck_num += (*p)->mStuckNodeNum;
+    }
+    mgr_num = gMgrList.size();
+  }
   s << "maximum used size: " << max_used_size() << endl
     << "maximum node num:  " << max_node_num() << endl
     << "current used size: " << used_size() << endl
     << "current node num:  " << node_num()
-    << " ( " << mStuckNodeNum << " )" << endl
+    << " ( " << stuck_num << " )" << endl
     << "allocated size:    " << allocated_size() << endl
     << "allocated count:   " << allocated_count() << endl
+    << "thread arenas:     " << mgr_num << endl
     << endl;
 }
 
@@ -690,10 +795,7 @@ ExprMgr::make_literals(VarId id)
 ExprNode*
 ExprMgr::alloc_node(tType type)
 {
-  ++ mNodeNum;
-  if ( mMaxNodeNum < mNodeNum ) {
-    mMaxNodeNum = mNodeNum;
-  }
+  update_max(gMaxNodeNum, ++ gNodeNum);
 
   ymuint nc = 0;
   if ( type == kAnd || type == kOr || type == kXor ) {
@@ -701,6 +803,7 @@ ExprMgr::alloc_node(tType type)
   }
 
   ymuint req_size = calc_size(nc);
+  update_max(gMaxUsedSize, gUsedSize += req_size);
   void* p = mNodeAlloc.get_memory(req_size);
   ExprNode* node = new (p) ExprNode;
   node->mRefType = static_cast<ymuint32>(type);
@@ -713,6 +816,8 @@ ExprMgr::alloc_node(tType type)
 }
 
 // ExprNode を削除する．
+// 領域は node を生成したインスタンスではなくこのインスタンスに返される．
+// インスタンスは clear_memory() まで破棄されないので問題はない．
 void
 ExprMgr::free_node(ExprNode* node)
 {
@@ -721,9 +826,10 @@ ExprMgr::free_node(ExprNode* node)
     node->child(i)->dec_ref();
   }
 
-  -- mNodeNum;
+  -- gNodeNum;
 
   ymuint req_size = calc_size(n);
+  gUsedSize -= req_size;
   mNodeAlloc.put_memory(req_size, node);
 }
 
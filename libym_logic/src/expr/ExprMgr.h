@@ -14,7 +14,7 @@
 #include "ExprNode.h"
 #include "ExprNodePtr.h"
 
-#include "YmUtils/FragAlloc.h"
+#include "YmUtils/SlabAlloc.h"
 
 
 BEGIN_NAMESPACE_YM_EXPR
@@ -22,6 +22,13 @@ BEGIN_NAMESPACE_YM_EXPR
 //////////////////////////////////////////////////////////////////////
 /// @class ExprMgr ExprMgr.h "ExprMgr.h"
 /// @brief ExprNode の管理を行うクラス
+///
+/// スレッドごとに一つのインスタンスを持つので異なるスレッドで
+/// 並行して論理式を作ることができる．
+/// スレッドが終了してもインスタンスは破棄されずに次に生成された
+/// スレッドで再利用される．そのためあるスレッドで作った論理式を
+/// 他のスレッドで使い続けても構わない．
+/// 参照回数が0になったノードの領域はそのスレッドのインスタンスに返される．
 //////////////////////////////////////////////////////////////////////
 class ExprMgr
 {
@@ -41,13 +48,14 @@ public:
   // 静的関数
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 唯一のインスタンスを返す．
+  /// @brief 現在のスレッドのインスタンスを返す．
   static
   ExprMgr&
   the_obj();
 
   /// @brief 確保したメモリを開放する．
   /// @note メモリリークチェックのための関数
+  /// @note 他のスレッドが論理式を使っていない時に呼ばなければならない．
   static
   void
   clear_memory();
@@ -166,33 +174,41 @@ public:
 public:
   //////////////////////////////////////////////////////////////////////
   // 統計情報を取り出す関数
+  // いずれも全てのスレッドのインスタンスの合計を返す．
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 使用されているメモリ量を返す．
+  static
   ymuint
   used_size();
 
   /// @brief 使用されているノード数を返す．
+  static
   ymuint
   node_num();
 
   /// @brief used_size() の最大値を返す．
+  static
   ymuint
   max_used_size();
 
   /// @brief nodenum() の最大値を返す．
+  static
   ymuint
   max_node_num();
 
   /// @brief 実際に確保したメモリ量を返す．
+  static
   ymuint
   allocated_size();
 
   /// @brief 実際に確保した回数を返す．
+  static
   ymuint
   allocated_count();
 
   /// @brief 内部状態を出力する．
+  static
   void
   print_stats(ostream& s);
 
@@ -252,7 +268,8 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // ノード用のアロケーター
-  FragAlloc mNodeAlloc;
+  // スラブは全てのインスタンスで共有する．
+  SlabAlloc mNodeAlloc;
 
   // 唯一の定数0ノード
   ExprNodePtr mConst0;
@@ -269,12 +286,6 @@ private:
   // 再帰関数のなかで作業領域として使われるノードの配列
   ExprNodeList mNodeStack;
 
-  // 使用中のノード数
-  ymuint32 mNodeNum;
-
-  // 使用した最大のノード数
-  ymuint32 mMaxNodeNum;
-
   // 絶対に開放されないノード数
   ymuint32 mStuckNodeNum;
 
@@ -10,7 +10,6 @@
 #include "ExprNode.h"
 #include "ExprMgr.h"
 #include "SopLit.h"
-#include "YmLogic/TvFunc.h"
 
 
 BEGIN_NAMESPACE_YM_EXPR
@@ -160,51 +159,6 @@ ExprNode::eval(const vector<ymulong>& vals,
   return 0UL;
 }
 
-// @brief 真理値表を作成する．
-// @param[in] ni 入力数
-TvFunc
-ExprNode::make_tv(ymuint ni) const
-{
-  if ( is_zero() ) {
-    return TvFunc::const_zero(ni);
-  }
-  if ( is_one() ) {
-    return TvFunc::const_one(ni);
-  }
-  if ( is_posiliteral() ) {
-    return TvFunc::posi_literal(ni, varid());
-  }
-  if ( is_negaliteral() ) {
-    return TvFunc::nega_literal(ni, varid());
-  }
-
-  // あとは AND/OR/XOR のみ
-  ymuint nc = child_num();
-  if ( is_and() ) {
-    TvFunc ans = child(0)->make_tv(ni);
-    for (ymuint i = 1; i < nc; ++ i) {
-      ans &= child(i)->make_tv(ni);
-    }
-    return ans;
-  }
-  if ( is_or() ) {
-    TvFunc ans = child(0)->make_tv(ni);
-    for (ymuint i = 1; i < nc; ++ i) {
-      ans |= child(i)->make_tv(ni);
-    }
-    return ans;
-  }
-  if ( is_xor() ) {
-    TvFunc ans = child(0)->make_tv(ni);
-    for (ymuint i = 1; i < nc; ++ i) {
-      ans ^= child(i)->make_tv(ni);
-    }
-    return ans;
-  }
-  ASSERT_NOT_REACHED;
-  return TvFunc();
-}
-
 // 定数,リテラルもしくは子供がリテラルのノードの時に true を返す．
 bool
 ExprNode::is_simple() const
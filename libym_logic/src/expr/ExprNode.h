@@ -12,6 +12,8 @@
 #include "YmLogic/Expr.h"
 #include "expr_types.h"
 
+#include <atomic>
+
 
 BEGIN_NAMESPACE_YM_EXPR
 
@@ -22,6 +24,8 @@ class SopLit;
 /// @brief 論理式を形作るノードのクラス
 /// 効率化のためにコピーはポインタのコピーを用いる．
 /// そのために参照回数を持つ．
+/// 異なるスレッドで同じノードを共有できるように参照回数の操作は
+/// アトミックに行う．
 //////////////////////////////////////////////////////////////////////
 class ExprNode
 {
@@ -106,11 +110,6 @@ public:
   eval(const vector<ymulong>& vals,
        ymulong mask) const;
 
-  /// @brief 真理値表を作成する．
-  /// @param[in] ni 入力数
-  TvFunc
-  make_tv(ymuint ni) const;
-
   /// @brief 定数,リテラルもしくは子供がリテラルのノードの時に true を返す．
   bool
   is_simple() const;
@@ -218,10 +217,6 @@ private:
   ymuint
   ref() const;
 
-  // 参照回数をセットする．
-  void
-  ref(ymuint ref) const;
-
   // 自殺する．
   void
   suicide();
@@ -233,7 +228,8 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // 参照回数＋ノードタイプ(3ビット)
-  ymuint32 mRefType;
+  mutable
+  std::atomic<ymuint32> mRefType;
 
   // 子供の数 もしくは 変数番号
   ymuint32 mNc;
@@ -278,7 +274,7 @@ inline
 tType
 ExprNode::type() const
 {
-  return static_cast<tType>(mRefType & 7U);
+  return static_cast<tType>(mRefType.load(std::memory_order_relaxed) & 7U);
 }
 
 inline
@@ -386,43 +382,37 @@ inline
 ymuint
 ExprNode::ref() const
 {
-  return static_cast<ymuint>(mRefType >> 3);
-}
-
-inline
-void
-ExprNode::ref(ymuint ref) const
-{
-  ExprNode* node = const_cast<ExprNode*>(this);
-  // 昔の参照回数を落とす．
-  node->mRefType &= 7;
-  // ref をセットする．
-  node->mRefType |= (ref << 3);
+  return static_cast<ymuint>(mRefType.load(std::memory_order_relaxed) >> 3);
 }
 
 inline
 void
 ExprNode::inc_ref() const
 {
-  // MAX の時は増やさない．
-  if ( ref() < kRefMax ) {
-    ExprNode* node = const_cast<ExprNode*>(this);
-    node->mRefType += 8;
-  }
+  ymuint32 old_val = mRefType.load(std::memory_order_relaxed);
+  do {
+    // MAX の時は増やさない．
+    if ( (old_val >> 3) >= kRefMax ) {
+      return;
+    }
+  } while ( !mRefType.compare_exchange_weak(old_val, old_val + 8,
+					    std::memory_order_relaxed) );
 }
 
 inline
 void
 ExprNode::dec_ref() const
 {
-  ymuint r = ref();
-  // MAX の時は減らさない．
-  if ( r < kRefMax ) {
-    ExprNode* node = const_cast<ExprNode*>(this);
-    node->mRefType -= 8;
-    if ( r == 1 ) {
-      node->suicide();
+  ymuint32 old_val = mRefType.load(std::memory_order_relaxed);
+  do {
+    // MAX の時は減らさない．
+    if ( (old_val >> 3) >= kRefMax ) {
+      return;
     }
+  } while ( !mRefType.compare_exchange_weak(old_val, old_val - 8,
+					    std::memory_order_acq_rel) );
+  if ( (old_val >> 3) == 1 ) {
+    const_cast<ExprNode*>(this)->suicide();
   }
 }
 
@@ -128,6 +128,13 @@ SatSolverMiniSat::stop()
   // 未実装
 }
 
+// @brief stop() による中止要求を取り消す．
+void
+SatSolverMiniSat::clear_stop()
+{
+  // 未実装
+}
+
 // @brief 学習節をすべて削除する．
 void
 SatSolverMiniSat::forget_learnt_clause()
@@ -85,6 +85,11 @@ public:
   void
   stop();
 
+  /// @brief stop() による中止要求を取り消す．
+  virtual
+  void
+  clear_stop();
+
   /// @brief 学習節をすべて削除する．
   virtual
   void
@@ -70,6 +70,16 @@ SatSolver::new_var(bool decision)
   return id;
 }
 
+// @brief 変数と節の領域をあらかじめ確保する．
+// @param[in] var_num これから追加する変数の数
+// @param[in] clause_num これから追加する節の数
+void
+SatSolver::reserve(ymuint var_num,
+		   ymuint clause_num)
+{
+  mImpl->reserve(var_num, clause_num);
+}
+
 // @brief 節を追加する．
 // @param[in] lits リテラルのベクタ
 void
@@ -88,6 +98,24 @@ SatSolver::add_clause(const vector<Literal>& lits)
   mImpl->add_clause(lits);
 }
 
+// @brief 節を追加する．
+// @param[in] lit_num リテラル数
+// @param[in] lits リテラルの配列
+void
+SatSolver::add_clause(ymuint lit_num,
+		      const Literal* lits)
+{
+  if ( mRecOut ) {
+    *mRecOut << "A";
+    for (ymuint i = 0; i < lit_num; ++ i) {
+      put_lit(lits[i]);
+    }
+    *mRecOut << endl;
+  }
+
+  mImpl->add_clause(lit_num, lits);
+}
+
 // @brief 1項の節を追加する．
 void
 SatSolver::add_clause(Literal lit1)
@@ -219,6 +247,13 @@ SatSolver::stop()
   mImpl->stop();
 }
 
+// @brief stop() による中止要求を取り消す．
+void
+SatSolver::clear_stop()
+{
+  mImpl->clear_stop();
+}
+
 // @brief リテラルを出力する．
 void
 SatSolver::put_lit(Literal lit) const
@@ -317,10 +352,17 @@ SatSolver::timer_on(bool enable)
 //////////////////////////////////////////////////////////////////////
 // クラス SatSolverImpl
 //
-// ここでは add_clause() のバリエーションのデフォルト実装を
-// 提供している．
+// ここでは reserve() と add_clause() のバリエーションの
+// デフォルト実装を提供している．
 //////////////////////////////////////////////////////////////////////
 
+// @brief 変数と節の領域をあらかじめ確保する．
+void
+SatSolverImpl::reserve(ymuint var_num,
+		       ymuint clause_num)
+{
+}
+
 // @brief 1項の節を追加する．
 void
 SatSolverImpl::add_clause(Literal lit1)
@@ -47,6 +47,16 @@ public:
   VarId
   new_var(bool decition) = 0;
 
+  /// @brief 変数と節の領域をあらかじめ確保する．
+  /// @param[in] var_num これから追加する変数の数
+  /// @param[in] clause_num これから追加する節の数
+  ///
+  /// デフォルトの実装はなにもしない．
+  virtual
+  void
+  reserve(ymuint var_num,
+	  ymuint clause_num);
+
   /// @brief 節を追加する．
   /// @param[in] lits リテラルのベクタ
   virtual
@@ -115,6 +125,11 @@ public:
   void
   stop() = 0;
 
+  /// @brief stop() による中止要求を取り消す．
+  virtual
+  void
+  clear_stop() = 0;
+
   /// @brief 学習節をすべて削除する．
   virtual
   void
@@ -0,0 +1,361 @@
+﻿
+/// @file DimacsLoader.cc
+/// @brief DimacsLoader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmLogic/DimacsLoader.h"
+#include "YmLogic/SatSolver.h"
+#include "YmUtils/MmapIDO.h"
+#include "YmUtils/FileIDO.h"
+#include "YmUtils/FileInfo.h"
+#include "YmUtils/MsgMgr.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// 逐次読み込みの時のバッファサイズ
+const ymuint kBuffSize = 64 * 1024;
+
+// filename が suffix で終わっていたら true を返す．
+bool
+has_suffix(const string& filename,
+	   const char* suffix)
+{
+  string s(suffix);
+  if ( filename.size() < s.size() ) {
+    return false;
+  }
+  return filename.compare(filename.size() - s.size(), s.size(), s) == 0;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス DimacsLoader
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+DimacsLoader::DimacsLoader() :
+  mIdo(nullptr),
+  mCur(nullptr),
+  mEnd(nullptr),
+  mLineNo(0),
+  mDecVarNum(0),
+  mDecClauseNum(0),
+  mVarNum(0),
+  mClauseNum(0)
+{
+}
+
+// @brief デストラクタ
+DimacsLoader::~DimacsLoader()
+{
+}
+
+// @brief ファイルを読み込む．
+// @param[in] filename ファイル名
+// @param[in] solver 節を追加する SAT ソルバ
+// @retval true 読み込みが成功した．
+// @retval false 読み込みが失敗した．
+bool
+DimacsLoader::load(const string& filename,
+		   SatSolver& solver)
+{
+  CodecType codec_type = kCodecThrough;
+  if ( has_suffix(filename, ".gz") ) {
+    codec_type = kCodecGzip;
+  }
+  else if ( has_suffix(filename, ".bz2") ) {
+    codec_type = kCodecBzip2;
+  }
+  else if ( has_suffix(filename, ".xz") ) {
+    codec_type = kCodecLzma;
+  }
+
+  if ( codec_type != kCodecThrough ) {
+    FileIDO ido(codec_type);
+    if ( !ido.open(filename) ) {
+      ostringstream buf;
+      buf << filename << " : No such file.";
+      MsgMgr::put_msg(__FILE__, __LINE__,
+		      FileRegion(),
+		      kMsgFailure,
+		      "DIMACS_LOADER",
+		      buf.str());
+      return false;
+    }
+    return load(ido, solver);
+  }
+
+  MmapIDO ido;
+  if ( !ido.open(filename) ) {
+    ostringstream buf;
+    buf << filename << " : No such file.";
+    MsgMgr::put_msg(__FILE__, __LINE__,
+		    FileRegion(),
+		    kMsgFailure,
+		    "DIMACS_LOADER",
+		    buf.str());
+    return false;
+  }
+
+  // ファイル全体を一つのバッファとみなす．
+  mIdo = nullptr;
+  mCur = ido.data();
+  mEnd = mCur + ido.size();
+  return load_sub(ido.file_info(), solver);
+}
+
+// @brief IDO から読み込む．
+// @param[in] ido 入力データ
+// @param[in] solver 節を追加する SAT ソルバ
+// @retval true 読み込みが成功した．
+// @retval false 読み込みが失敗した．
+bool
+DimacsLoader::load(IDO& ido,
+		   SatSolver& solver)
+{
+  mIdo = &ido;
+  mBuff.resize(kBuffSize);
+  mCur = nullptr;
+  mEnd = nullptr;
+  bool stat = load_sub(ido.file_info(), solver);
+  mIdo = nullptr;
+  return stat;
+}
+
+// @brief 読み込みの本体
+// @param[in] file_info エラーメッセージ用のファイル情報
+// @param[in] solver 節を追加する SAT ソルバ
+bool
+DimacsLoader::load_sub(const FileInfo& file_info,
+		       SatSolver& solver)
+{
+  mLineNo = 1;
+  mDecVarNum = 0;
+  mDecClauseNum = 0;
+  mVarNum = 0;
+  mClauseNum = 0;
+  mLits.clear();
+
+  bool p_found = false;
+  for ( ; ; ) {
+    skip_space();
+    int c = peek();
+    if ( c == EOF || c == '%' ) {
+      // '%' は SATLIB のファイルの末尾に付いている終端記号
+      break;
+    }
+
+    if ( c == 'c' ) {
+      skip_line();
+      continue;
+    }
+
+    if ( c == 'p' ) {
+      if ( p_found ) {
+	error(file_info, "ERR01", "duplicated 'p' lines");
+	return false;
+      }
+      // p 行は1行に収まっていなければならない．
+      ++ mCur;
+      skip_blank();
+      // 次は "cnf" のはず．
+      for (const char* q = "cnf"; *q; ++ q, ++ mCur) {
+	if ( peek() != *q ) {
+	  error(file_info, "ERR03",
+		"syntax error \"p cnf <num of vars> <num of clauses>\" expected");
+	  return false;
+	}
+      }
+      int nv;
+      int nc;
+      bool ok = false;
+      skip_blank();
+      if ( read_int(nv) ) {
+	skip_blank();
+	if ( read_int(nc) ) {
+	  skip_blank();
+	  int c1 = peek();
+	  ok = (c1 == '\n' || c1 == EOF) && nv >= 0 && nc >= 0;
+	}
+      }
+      if ( !ok ) {
+	error(file_info, "ERR03",
+	      "syntax error \"p cnf <num of vars> <num of clauses>\" expected");
+	return false;
+      }
+      mDecVarNum = nv;
+      mDecClauseNum = nc;
+      solver.reserve(mDecVarNum, mDecClauseNum);
+      for (ymuint i = 0; i < mDecVarNum; ++ i) {
+	solver.new_var();
+      }
+      mVarNum = mDecVarNum;
+      p_found = true;
+      continue;
+    }
+
+    if ( !p_found ) {
+      error(file_info, "ERR03",
+	    "syntax error \"p cnf <num of vars> <num of clauses>\" expected");
+      return false;
+    }
+
+    // 節の読み込み
+    // 0 が現れるまでリテラルを読む．途中の改行は許す．
+    mLits.clear();
+    for ( ; ; ) {
+      int v;
+      skip_space();
+      if ( !read_int(v) ) {
+	if ( peek() == EOF ) {
+	  error(file_info, "ERR02", "unexpected end-of-file");
+	}
+	else {
+	  error(file_info, "ERR04",
+		"syntax error \"<lit_1> <lit_2> ... <lit_n> 0\" expected");
+	}
+	return false;
+      }
+      if ( v == 0 ) {
+	break;
+      }
+      bool inv = false;
+      ymuint var = v;
+      if ( v < 0 ) {
+	inv = true;
+	var = - v;
+      }
+      // 宣言よりも大きな番号の変数は必要に応じて生成する．
+      for ( ; mVarNum < var; ++ mVarNum) {
+	solver.new_var();
+      }
+      mLits.push_back(Literal(VarId(var - 1), inv));
+    }
+    ymuint n = mLits.size();
+    solver.add_clause(n, n > 0 ? &mLits[0] : nullptr);
+    ++ mClauseNum;
+  }
+
+  if ( !p_found ) {
+    error(file_info, "ERR02", "unexpected end-of-file");
+    return false;
+  }
+
+  return true;
+}
+
+// @brief バッファを補充する．
+// @return データが残っていなければ false を返す．
+bool
+DimacsLoader::fill()
+{
+  if ( mIdo == nullptr ) {
+    return false;
+  }
+  ymint64 n = mIdo->read(&mBuff[0], mBuff.size());
+  if ( n <= 0 ) {
+    return false;
+  }
+  mCur = &mBuff[0];
+  mEnd = mCur + n;
+  return true;
+}
+
+// @brief 改行以外の空白を読み飛ばす．
+void
+DimacsLoader::skip_blank()
+{
+  for ( ; ; ) {
+    int c = peek();
+    if ( c != ' ' && c != '\t' && c != '\r' ) {
+      return;
+    }
+    ++ mCur;
+  }
+}
+
+// @brief 空白と改行を読み飛ばす．
+void
+DimacsLoader::skip_space()
+{
+  for ( ; ; ) {
+    int c = peek();
+    if ( c == '\n' ) {
+      ++ mLineNo;
+    }
+    else if ( c != ' ' && c != '\t' && c != '\r' ) {
+      return;
+    }
+    ++ mCur;
+  }
+}
+
+// @brief 行末まで読み飛ばす．
+void
+DimacsLoader::skip_line()
+{
+  for ( ; ; ) {
+    int c = peek();
+    if ( c == EOF ) {
+      return;
+    }
+    ++ mCur;
+    if ( c == '\n' ) {
+      ++ mLineNo;
+      return;
+    }
+  }
+}
+
+// @brief 符号付きの整数を読み込む．
+// @param[out] val 読み込んだ値
+// @return 数字が現れなかったら false を返す．
+bool
+DimacsLoader::read_int(int& val)
+{
+  int c = peek();
+  bool minus = false;
+  if ( c == '-' ) {
+    minus = true;
+    ++ mCur;
+    c = peek();
+  }
+  if ( c < '0' || '9' < c ) {
+    return false;
+  }
+  int v = 0;
+  do {
+    v = v * 10 + (c - '0');
+    ++ mCur;
+    c = peek();
+  } while ( '0' <= c && c <= '9' );
+  val = minus ? - v : v;
+  return true;
+}
+
+// @brief エラーメッセージを出力する．
+// @param[in] file_info ファイル情報
+// @param[in] label ラベル
+// @param[in] msg メッセージ
+void
+DimacsLoader::error(const FileInfo& file_info,
+		    const char* label,
+		    const char* msg)
+{
+  MsgMgr::put_msg(__FILE__, __LINE__,
+		  FileRegion(FileLoc(file_info, mLineNo, 1)),
+		  kMsgError,
+		  label,
+		  msg);
+}
+
+END_NAMESPACE_YM_SAT
@@ -134,8 +134,10 @@ SatSolverGlueMiniSat2::solve(const vector<Literal>& assumptions,
     Lit lit = literal2lit(l);
     tmp.push(lit);
   }
-  bool ans = mSolver.solve(tmp);
-  if ( ans ) {
+  // 中止された場合を区別するために solveLimited() を用いる．
+  mSolver.budgetOff();
+  lbool ans = mSolver.solveLimited(tmp);
+  if ( ans == l_True ) {
     ymuint n = mSolver.model.size();
     model.resize(n);
     for (ymuint i = 0; i < n; ++ i) {
@@ -152,7 +154,10 @@ SatSolverGlueMiniSat2::solve(const vector<Literal>& assumptions,
     }
     return kB3True;
   }
-  return kB3False;
+  if ( ans == l_False ) {
+    return kB3False;
+  }
+  return kB3X;
 }
 
 // @brief 探索を中止する．
@@ -164,6 +169,13 @@ SatSolverGlueMiniSat2::stop()
   mSolver.interrupt();
 }
 
+// @brief stop() による中止要求を取り消す．
+void
+SatSolverGlueMiniSat2::clear_stop()
+{
+  mSolver.clearInterrupt();
+}
+
 // @brief 学習節をすべて削除する．
 void
 SatSolverGlueMiniSat2::forget_learnt_clause()
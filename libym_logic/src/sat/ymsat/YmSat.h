@@ -10,7 +10,7 @@
 
 
 #include "../SatSolverImpl.h"
-#include "YmUtils/FragAlloc.h"
+#include "YmUtils/SlabAlloc.h"
 #include "YmUtils/RandGen.h"
 #include "YmUtils/StopWatch.h"
 #include "SatClause.h"
@@ -18,6 +18,7 @@
 #include "AssignList.h"
 #include "Watcher.h"
 #include "VarHeap.h"
+#include <atomic>
 
 
 BEGIN_NAMESPACE_YM_SAT
@@ -99,6 +100,14 @@ public:
   VarId
   new_var(bool decision);
 
+  /// @brief 変数と節の領域をあらかじめ確保する．
+  /// @param[in] var_num これから追加する変数の数
+  /// @param[in] clause_num これから追加する節の数
+  virtual
+  void
+  reserve(ymuint var_num,
+	  ymuint clause_num);
+
   /// @brief 節を追加する．
   /// @param[in] lits リテラルのベクタ
   virtual
@@ -167,6 +176,11 @@ public:
   void
   stop();
 
+  /// @brief stop() による中止要求を取り消す．
+  virtual
+  void
+  clear_stop();
+
   /// @brief 学習節をすべて削除する．
   virtual
   void
@@ -474,7 +488,7 @@ private:
   bool mSane;
 
   // SatClause のメモリ領域確保用のアロケータ
-  FragAlloc mAlloc;
+  SlabAlloc mAlloc;
 
   // 制約節のリスト
   // ただし二項節は含まない．
@@ -594,7 +608,8 @@ private:
   ymuint64 mMaxConflict;
 
   // stop() が用いるフラグ
-  bool mGoOn;
+  // 別スレッドから書き換えられるので atomic にしておく．
+  std::atomic<bool> mGoOn;
 
   // メッセージハンドラのリスト
   list<SatMsgHandler*> mMsgHandlerList;
@@ -49,7 +49,8 @@ YmSat::YmSat(const string& option) :
   mPropagationNum(0),
   mConflictLimit(0),
   mLearntLimit(0),
-  mMaxConflict(1024 * 100)
+  mMaxConflict(1024 * 100),
+  mGoOn(true)
 {
   mAnalyzer = SaFactory::gen_analyzer(this, option);
 
@@ -114,6 +115,21 @@ YmSat::new_var(bool decision)
   return VarId(n);
 }
 
+// @brief 変数と節の領域をあらかじめ確保する．
+// @param[in] var_num これから追加する変数の数
+// @param[in] clause_num これから追加する節の数
+//
+// 変数に関する配列は alloc_var() でまとめて確保されるので
+// ここでは節のリストだけを確保しておく．
+void
+YmSat::reserve(ymuint var_num,
+	       ymuint clause_num)
+{
+  mDvarArray.reserve(mVarNum + var_num);
+  mConstrClauseList.reserve(mConstrClauseList.size() + clause_num);
+  mAllConstrClauseList.reserve(mAllConstrClauseList.size() + clause_num);
+}
+
 // @brief 節を追加する．
 // @param[in] lits リテラルのベクタ
 void
@@ -65,8 +65,6 @@ YmSat::solve(const vector<Literal>& assumptions,
     mTimer.start();
   }
 
-  mGoOn = true;
-
   // 変数領域の確保を行う．
   alloc_var();
 
@@ -215,6 +213,13 @@ YmSat::stop()
   mGoOn = false;
 }
 
+// @brief stop() による中止要求を取り消す．
+void
+YmSat::clear_stop()
+{
+  mGoOn = true;
+}
+
 // @brief 探索を行う本体の関数
 // @retval kB3True 充足した．
 // @retval kB3False 充足できないことがわかった．
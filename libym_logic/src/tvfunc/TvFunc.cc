@@ -455,6 +455,22 @@ TvFunc::TvFunc(ymuint ni,
   }
 }
 
+// 入力数と内部表現のブロックを指定したコンストラクタ
+TvFunc::TvFunc(ymuint ni,
+	       const vector<ymuint64>& blocks) :
+  mInputNum(ni),
+  mBlockNum(nblock(ni)),
+  mVector(new ymuint64[mBlockNum])
+{
+  ASSERT_COND( blocks.size() >= mBlockNum );
+  for (ymuint b = 0; b < mBlockNum; ++ b) {
+    mVector[b] = blocks[b];
+  }
+  if ( ni < NIPW ) {
+    mVector[0] &= (1UL << (1U << ni)) - 1UL;
+  }
+}
+
 // コピーコンストラクタ
 TvFunc::TvFunc(const TvFunc& src) :
   mInputNum(src.mInputNum),
@@ -0,0 +1,310 @@
+﻿
+/// @file TvFunc_isop.cc
+/// @brief TvFunc の非冗長積和形を求める関数の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmLogic/TvFunc.h"
+#include "YmLogic/Expr.h"
+
+
+#define NIPW 6
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// コファクターマスク
+const ymuint64 c_masks[] = {
+  0xAAAAAAAAAAAAAAAA,
+  0xCCCCCCCCCCCCCCCC,
+  0xF0F0F0F0F0F0F0F0,
+  0xFF00FF00FF00FF00,
+  0xFFFF0000FFFF0000,
+  0xFFFFFFFF00000000
+};
+
+// 肯定リテラルを表すビット
+inline
+ymuint64
+posi_bit(ymuint var)
+{
+  return 1UL << (var * 2);
+}
+
+// 否定リテラルを表すビット
+inline
+ymuint64
+nega_bit(ymuint var)
+{
+  return 1UL << (var * 2 + 1);
+}
+
+// 1ワードに収まる関数の ISOP を求める．
+// l, u は 6 入力の関数として扱い，var_num 未満の変数のみ分解に用いる．
+// lits は上位の再帰で積まれたリテラルの集合
+// 結果の関数を返す．
+ymuint64
+isop_word(ymuint64 l,
+	  ymuint64 u,
+	  ymuint var_num,
+	  ymuint64 lits,
+	  vector<ymuint64>& cube_list)
+{
+  if ( l == 0UL ) {
+    return 0UL;
+  }
+  if ( u == ~0UL ) {
+    cube_list.push_back(lits);
+    return ~0UL;
+  }
+
+  // l か u が依存している最上位の変数を探す．
+  // l < u なので必ず見つかる．
+  ymuint var = var_num;
+  ymuint64 mask;
+  ymuint64 l0, l1, u0, u1;
+  for ( ; ; ) {
+    ASSERT_COND( var > 0 );
+    -- var;
+    mask = c_masks[var];
+    ymuint s = 1U << var;
+    l0 = l & ~mask; l0 |= l0 << s;
+    l1 = l &  mask; l1 |= l1 >> s;
+    u0 = u & ~mask; u0 |= u0 << s;
+    u1 = u &  mask; u1 |= u1 >> s;
+    if ( l0 != l1 || u0 != u1 ) {
+      break;
+    }
+  }
+
+  ymuint64 c0 = isop_word(l0 & ~u1, u0, var, lits | nega_bit(var), cube_list);
+  ymuint64 c1 = isop_word(l1 & ~u0, u1, var, lits | posi_bit(var), cube_list);
+  ymuint64 c2 = isop_word((l0 & ~c0) | (l1 & ~c1), u0 & u1, var, lits, cube_list);
+  return (c0 & ~mask) | (c1 & mask) | c2;
+}
+
+// 複数ワードにまたがる関数の ISOP を求める．
+// l, u, c は 2^(var_num - 6) ワードの配列
+// work は作業領域で 3 * 2^(var_num - 6) ワード以上の大きさが必要
+// 結果の関数を c に書き込む．
+void
+isop_block(const ymuint64* l,
+	   const ymuint64* u,
+	   ymuint var_num,
+	   ymuint64 lits,
+	   ymuint64* c,
+	   ymuint64* work,
+	   vector<ymuint64>& cube_list)
+{
+  if ( var_num == NIPW ) {
+    c[0] = isop_word(l[0], u[0], NIPW, lits, cube_list);
+    return;
+  }
+
+  ymuint nw = 1U << (var_num - NIPW);
+  bool l_zero = true;
+  bool u_one = true;
+  for (ymuint i = 0; i < nw; ++ i) {
+    if ( l[i] != 0UL ) {
+      l_zero = false;
+    }
+    if ( u[i] != ~0UL ) {
+      u_one = false;
+    }
+  }
+  if ( l_zero ) {
+    for (ymuint i = 0; i < nw; ++ i) {
+      c[i] = 0UL;
+    }
+    return;
+  }
+  if ( u_one ) {
+    cube_list.push_back(lits);
+    for (ymuint i = 0; i < nw; ++ i) {
+      c[i] = ~0UL;
+    }
+    return;
+  }
+
+  // 最上位の変数のコファクターは配列の前半と後半になる．
+  ymuint h = nw / 2;
+  const ymuint64* l0 = l;
+  const ymuint64* l1 = l + h;
+  const ymuint64* u0 = u;
+  const ymuint64* u1 = u + h;
+  ymuint var = var_num - 1;
+
+  bool indep = true;
+  for (ymuint i = 0; i < h; ++ i) {
+    if ( l0[i] != l1[i] || u0[i] != u1[i] ) {
+      indep = false;
+      break;
+    }
+  }
+  if ( indep ) {
+    // var に依存していない．
+    isop_block(l0, u0, var, lits, c, work, cube_list);
+    for (ymuint i = 0; i < h; ++ i) {
+      c[h + i] = c[i];
+    }
+    return;
+  }
+
+  ymuint64* c0 = c;
+  ymuint64* c1 = c + h;
+  ymuint64* tmp_l = work;
+  ymuint64* tmp_u = work + h;
+  ymuint64* c2 = work + h * 2;
+  ymuint64* sub_work = work + h * 3;
+
+  for (ymuint i = 0; i < h; ++ i) {
+    tmp_l[i] = l0[i] & ~u1[i];
+  }
+  isop_block(tmp_l, u0, var, lits | nega_bit(var), c0, sub_work, cube_list);
+
+  for (ymuint i = 0; i < h; ++ i) {
+    tmp_l[i] = l1[i] & ~u0[i];
+  }
+  isop_block(tmp_l, u1, var, lits | posi_bit(var), c1, sub_work, cube_list);
+
+  for (ymuint i = 0; i < h; ++ i) {
+    tmp_l[i] = (l0[i] & ~c0[i]) | (l1[i] & ~c1[i]);
+    tmp_u[i] = u0[i] & u1[i];
+  }
+  isop_block(tmp_l, tmp_u, var, lits, c2, sub_work, cube_list);
+
+  for (ymuint i = 0; i < h; ++ i) {
+    c0[i] |= c2[i];
+    c1[i] |= c2[i];
+  }
+}
+
+// 6 入力未満の関数を 6 入力に拡張する．
+inline
+ymuint64
+expand_word(ymuint64 pat,
+	    ymuint ni)
+{
+  for (ymuint i = ni; i < NIPW; ++ i) {
+    pat |= pat << (1U << i);
+  }
+  return pat;
+}
+
+END_NONAMESPACE
+
+
+// @brief 非冗長積和形を求める．
+// @param[in] lower 下限(on set)
+// @param[in] upper 上限(on set + don't care set)
+// @param[out] cube_list 結果のキューブのリスト
+// @return 結果の積和形の表す関数を返す．
+TvFunc
+isop(const TvFunc& lower,
+     const TvFunc& upper,
+     vector<ymuint64>& cube_list)
+{
+  ASSERT_COND( lower.mInputNum == upper.mInputNum );
+  // キューブは変数ごとに2ビットを使うので 32 入力までしか表せない．
+  ASSERT_COND( lower.mInputNum <= 32 );
+
+  cube_list.clear();
+
+  ymuint ni = lower.mInputNum;
+  TvFunc ans(ni);
+  if ( ni <= NIPW ) {
+    ymuint64 l = expand_word(lower.mVector[0], ni);
+    ymuint64 u = expand_word(upper.mVector[0], ni);
+    ASSERT_COND( (l & ~u) == 0UL );
+    ymuint64 c = isop_word(l, u, ni, 0UL, cube_list);
+    if ( ni < NIPW ) {
+      c &= (1UL << (1U << ni)) - 1UL;
+    }
+    ans.mVector[0] = c;
+  }
+  else {
+    ymuint nw = lower.mBlockNum;
+    for (ymuint i = 0; i < nw; ++ i) {
+      ASSERT_COND( (lower.mVector[i] & ~upper.mVector[i]) == 0UL );
+    }
+    vector<ymuint64> work(nw * 3);
+    isop_block(lower.mVector, upper.mVector, ni, 0UL,
+	       ans.mVector, &work[0], cube_list);
+  }
+  return ans;
+}
+
+// @brief 非冗長積和形を求める．
+// @param[in] lower 下限(on set)
+// @param[in] upper 上限(on set + don't care set)
+// @param[out] cover 結果の式を納める変数
+// @return cover の表す関数を返す．
+TvFunc
+isop(const TvFunc& lower,
+     const TvFunc& upper,
+     Expr& cover)
+{
+  vector<ymuint64> cube_list;
+  TvFunc ans = isop(lower, upper, cube_list);
+
+  ymuint ni = lower.input_num();
+  ExprVector cube_expr_list;
+  cube_expr_list.reserve(cube_list.size());
+  ExprVector lit_list;
+  lit_list.reserve(ni);
+  for (vector<ymuint64>::const_iterator p = cube_list.begin();
+       p != cube_list.end(); ++ p) {
+    ymuint64 lits = *p;
+    if ( lits == 0UL ) {
+      // 空のキューブは恒真関数
+      cover = Expr::make_one();
+      return ans;
+    }
+    lit_list.clear();
+    for (ymuint i = 0; i < ni; ++ i) {
+      VarId var(i);
+      if ( lits & posi_bit(i) ) {
+	lit_list.push_back(Expr::make_posiliteral(var));
+      }
+      else if ( lits & nega_bit(i) ) {
+	lit_list.push_back(Expr::make_negaliteral(var));
+      }
+    }
+    if ( lit_list.size() == 1 ) {
+      cube_expr_list.push_back(lit_list[0]);
+    }
+    else {
+      cube_expr_list.push_back(Expr::make_and(lit_list));
+    }
+  }
+
+  switch ( cube_expr_list.size() ) {
+  case 0:
+    cover = Expr::make_zero();
+    break;
+
+  case 1:
+    cover = cube_expr_list[0];
+    break;
+
+  default:
+    cover = Expr::make_or(cube_expr_list);
+    break;
+  }
+  return ans;
+}
+
+// @brief 非冗長積和形論理式を返す．
+Expr
+TvFunc::sop() const
+{
+  Expr cover;
+  (void) isop(*this, *this, cover);
+  return cover;
+}
+
+END_NAMESPACE_YM
@@ -15,6 +15,8 @@
 #include "YmUtils/NameMgr.h"
 #include "YmUtils/HashFunc.h"
 #include "YmUtils/Binder.h"
+#include "YmUtils/IDO.h"
+#include "YmUtils/ODO.h"
 #include "YmLogic/Expr.h"
 
 // Glossary
@@ -953,6 +955,29 @@ public:
   //////////////////////////////////////////////////////////////////////
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name ダンプ/リストア関係の関数
+  /// @{
+
+  /// @brief 内容をバイナリダンプする．
+  /// @param[in] s 出力先のストリーム
+  void
+  dump(ODO& s) const;
+
+  /// @brief バイナリダンプされた内容を読み込む．
+  /// @param[in] s 入力元のストリーム
+  /// @return 読み込みが成功したら true を返す．
+  /// @note 成功した場合，元の内容は破棄される．
+  /// 内容に矛盾がある場合には元の内容を変えずに false を返す．
+  /// @note ノードの ID 番号は dump() した時と同じになる．
+  bool
+  restore(IDO& s);
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
 protected:
 
   /// @brief 構造が変化した事を記録しておく関数
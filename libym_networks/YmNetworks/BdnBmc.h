@@ -0,0 +1,353 @@
+﻿#ifndef NETWORKS_BDNBMC_H
+#define NETWORKS_BDNBMC_H
+
+/// @file YmNetworks/BdnBmc.h
+/// @brief BdnBmc のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/bdn.h"
+#include "YmLogic/Bool3.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+class BdnUnroller;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BdnBmc BdnBmc.h "YmNetworks/BdnBmc.h"
+/// @brief BdnMgr の順序回路に対する SAT ベースの検証を行うクラス
+///
+/// 検証する性質は「ノード bad の値が 1 になる状態に到達しない」である．
+/// 状態遷移のモデルは BdnReach と同じで，初期状態は set_init() で
+/// 指定する(既定値はすべて 0)．
+///
+/// bmc() は有界モデル検査を行う．時間展開は一つの SAT ソルバに
+/// 1時刻ずつ追加していき，各深さの判定は仮定(assumption)を
+/// 変えるだけで行うので，学習節は以降の深さでもそのまま使われる．
+/// この SAT ソルバは BdnBmc の生存中は保持されるので，
+/// bmc() を続けて呼んだ場合も前回の展開がそのまま使われる．
+///
+/// prove() は単純経路制約付きの k-induction で性質を証明する．
+/// 帰納ステップ用には初期状態の制約を持たない別の SAT ソルバを用いる．
+/// スレッド数を 2 以上にすると BMC と帰納ステップを別スレッドで
+/// 並列に実行し，どちらかで結論が出た時点で他方を中止する．
+//////////////////////////////////////////////////////////////////////
+class BdnBmc
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] sat_type SAT ソルバの種類
+  /// @param[in] sat_option SAT ソルバのオプション
+  /// @note network の構造は BdnBmc の生存中に変更してはいけない．
+  BdnBmc(const BdnMgr& network,
+	 const string& sat_type = string(),
+	 const string& sat_option = string());
+
+  /// @brief デストラクタ
+  ~BdnBmc();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 状態変数と初期状態
+  /// @{
+
+  /// @brief 状態変数の数を得る．
+  ymuint
+  state_num() const;
+
+  /// @brief 外部入力の数を得る．
+  ymuint
+  input_num() const;
+
+  /// @brief 状態変数に対応するノードを得る．
+  /// @param[in] pos 位置番号 ( 0 <= pos < state_num() )
+  /// @note D-FF, ラッチの順に並んだそれぞれの出力ノードとなる．
+  const BdnNode*
+  state_node(ymuint pos) const;
+
+  /// @brief 外部入力ノードを得る．
+  /// @param[in] pos 位置番号 ( 0 <= pos < input_num() )
+  const BdnNode*
+  input_node(ymuint pos) const;
+
+  /// @brief 状態変数の初期値を設定する．
+  /// @param[in] pos 状態変数の位置番号 ( 0 <= pos < state_num() )
+  /// @param[in] val 初期値
+  /// @note kB3X の場合は任意の値をとる．
+  void
+  set_init(ymuint pos,
+	   Bool3 val);
+
+  /// @brief 状態変数の初期値を得る．
+  /// @param[in] pos 状態変数の位置番号 ( 0 <= pos < state_num() )
+  Bool3
+  init(ymuint pos) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 検証
+  /// @{
+
+  /// @brief 有界モデル検査を行う．
+  /// @param[in] bad 不正状態を表すノード
+  /// @param[in] max_depth 調べる深さの上限
+  /// @retval kB3False 反例が見つかった．
+  /// @retval kB3X 深さ max_depth までに反例はなかった．
+  /// @note 深さ d は初期状態から d 回遷移した時刻を表す．
+  Bool3
+  bmc(const BdnNode* bad,
+      ymuint max_depth);
+
+  /// @brief k-induction で性質を証明する．
+  /// @param[in] bad 不正状態を表すノード
+  /// @param[in] max_k k の上限
+  /// @param[in] thread_num スレッド数
+  /// @retval kB3True 性質が証明された．
+  /// @retval kB3False 反例が見つかった．
+  /// @retval kB3X どちらともわからなかった．
+  Bool3
+  prove(const BdnNode* bad,
+	ymuint max_k,
+	ymuint thread_num = 1);
+
+  /// @brief 直前の検証で得られた深さを返す．
+  ///
+  /// - 反例が見つかった場合はその長さ(遷移回数)
+  /// - prove() で証明された場合は k
+  /// - それ以外の場合は反例がないことを確かめた深さの数
+  ymuint
+  depth() const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 反例
+  /// @{
+
+  /// @brief 反例の時刻数を得る．
+  /// @note depth() + 1 となる．反例がない場合は 0 を返す．
+  ymuint
+  cex_frame_num() const;
+
+  /// @brief 反例の初期状態の値を得る．
+  /// @param[in] pos 状態変数の位置番号 ( 0 <= pos < state_num() )
+  Bool3
+  cex_state(ymuint pos) const;
+
+  /// @brief 反例の外部入力の値を得る．
+  /// @param[in] frame 時刻 ( 0 <= frame < cex_frame_num() )
+  /// @param[in] pos 外部入力の位置番号 ( 0 <= pos < input_num() )
+  Bool3
+  cex_input(ymuint frame,
+	    ymuint pos) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // prove_mt() のスレッド間で共有する情報
+  struct MtState;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 深さ depth で bad に到達できるか調べる．
+  /// @retval kB3True 到達できる(反例を記録する)．
+  /// @retval kB3False 到達できない．
+  /// @retval kB3X 中断された．
+  Bool3
+  bmc_step(const BdnNode* bad,
+	   ymuint depth);
+
+  /// @brief 長さ k の帰納ステップを調べる．
+  /// @retval kB3True 帰納ステップが成り立たない．
+  /// @retval kB3False 帰納ステップが成り立つ．
+  /// @retval kB3X 中断された．
+  Bool3
+  ind_step(const BdnNode* bad,
+	   ymuint k);
+
+  /// @brief BMC 用の時間展開を得る．
+  BdnUnroller&
+  bmc_frames();
+
+  /// @brief 帰納ステップ用の時間展開を得る．
+  BdnUnroller&
+  ind_frames();
+
+  /// @brief BMC と帰納ステップを並列に実行する．
+  Bool3
+  prove_mt(const BdnNode* bad,
+	   ymuint max_k);
+
+  /// @brief prove_mt() の BMC 側のスレッドの本体
+  static
+  void
+  bmc_thread(BdnBmc* bmc,
+	     const BdnNode* bad,
+	     ymuint max_k,
+	     MtState* state);
+
+  /// @brief prove_mt() の帰納ステップ側のスレッドの本体
+  static
+  void
+  ind_thread(BdnBmc* bmc,
+	     const BdnNode* bad,
+	     ymuint max_k,
+	     MtState* state);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const BdnMgr& mNetwork;
+
+  // SAT ソルバの種類
+  string mSatType;
+
+  // SAT ソルバのオプション
+  string mSatOption;
+
+  // 状態変数のノードのリスト
+  vector<const BdnNode*> mStateList;
+
+  // 外部入力ノードのリスト
+  vector<const BdnNode*> mInputList;
+
+  // 初期状態のリスト
+  vector<Bool3> mInitList;
+
+  // BMC 用の時間展開
+  BdnUnroller* mBmcFrames;
+
+  // 帰納ステップ用の時間展開
+  BdnUnroller* mIndFrames;
+
+  // 直前の検証で得られた深さ
+  ymuint32 mDepth;
+
+  // 反例が得られている時 true となるフラグ
+  bool mHasCex;
+
+  // 反例の初期状態
+  vector<Bool3> mCexState;
+
+  // 反例の外部入力
+  // キーは 時刻 * input_num() + 位置番号
+  vector<Bool3> mCexInput;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 状態変数の数を得る．
+inline
+ymuint
+BdnBmc::state_num() const
+{
+  return mStateList.size();
+}
+
+// @brief 外部入力の数を得る．
+inline
+ymuint
+BdnBmc::input_num() const
+{
+  return mInputList.size();
+}
+
+// @brief 状態変数に対応するノードを得る．
+inline
+const BdnNode*
+BdnBmc::state_node(ymuint pos) const
+{
+  ASSERT_COND( pos < state_num() );
+  return mStateList[pos];
+}
+
+// @brief 外部入力ノードを得る．
+inline
+const BdnNode*
+BdnBmc::input_node(ymuint pos) const
+{
+  ASSERT_COND( pos < input_num() );
+  return mInputList[pos];
+}
+
+// @brief 状態変数の初期値を得る．
+inline
+Bool3
+BdnBmc::init(ymuint pos) const
+{
+  ASSERT_COND( pos < state_num() );
+  return mInitList[pos];
+}
+
+// @brief 直前の検証で得られた深さを返す．
+inline
+ymuint
+BdnBmc::depth() const
+{
+  return mDepth;
+}
+
+// @brief 反例の時刻数を得る．
+inline
+ymuint
+BdnBmc::cex_frame_num() const
+{
+  return mHasCex ? mDepth + 1 : 0;
+}
+
+// @brief 反例の初期状態の値を得る．
+inline
+Bool3
+BdnBmc::cex_state(ymuint pos) const
+{
+  ASSERT_COND( mHasCex );
+  ASSERT_COND( pos < state_num() );
+  return mCexState[pos];
+}
+
+// @brief 反例の外部入力の値を得る．
+inline
+Bool3
+BdnBmc::cex_input(ymuint frame,
+		  ymuint pos) const
+{
+  ASSERT_COND( frame < cex_frame_num() );
+  ASSERT_COND( pos < input_num() );
+  return mCexInput[frame * input_num() + pos];
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
+
+#endif // NETWORKS_BDNBMC_H
@@ -0,0 +1,454 @@
+﻿#ifndef NETWORKS_BDNFLATGRAPH_H
+#define NETWORKS_BDNFLATGRAPH_H
+
+/// @file YmNetworks/BdnFlatGraph.h
+/// @brief BdnFlatGraph のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/bdn.h"
+#include "YmNetworks/BdnNode.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BdnFlatGraph BdnFlatGraph.h "YmNetworks/BdnFlatGraph.h"
+/// @brief BdnMgr の構造を配列で表したクラス
+///
+/// ノードは 32ビットの番号で表し，以下の順に連続した番号を振る．
+/// - 0                                  : 定数0
+/// - 1 〜 input_num()                   : 入力ノード
+/// - 〜 input_num() + lnode_num()       : 論理ノード(トポロジカル順)
+/// - 〜 node_num() - 1                  : 出力ノード
+///
+/// ファンインはリテラル (ノード番号 << 1) | 反転属性 で表し，
+/// 定数0，定数1 はそれぞれリテラル 0, 1 となる．
+/// ファンイン，レベル，フラグはノード番号をキーにした配列として
+/// 取り出せるので，ノードを順に走査する処理では連続したメモリを
+/// 読むだけでよい．
+/// ファンアウトは CSR 形式で表し，最初に参照された時に作られる．
+///
+/// 元の BdnMgr とは独立したスナップショットなので，BdnMgr を変更した
+/// 場合には set() で作り直す必要がある．
+//////////////////////////////////////////////////////////////////////
+class BdnFlatGraph
+{
+public:
+
+  /// @brief ノードの種類を表すフラグ
+  enum {
+    /// @brief 定数
+    kConst  = 0,
+    /// @brief 入力ノード
+    kInput  = 1,
+    /// @brief AND ノード
+    kAnd    = 2,
+    /// @brief XOR ノード
+    kXor    = 3,
+    /// @brief 出力ノード
+    kOutput = 4
+  };
+
+
+public:
+
+  /// @brief 空のコンストラクタ
+  BdnFlatGraph();
+
+  /// @brief BdnMgr から作るコンストラクタ
+  /// @param[in] network 元のネットワーク
+  explicit
+  BdnFlatGraph(const BdnMgr& network);
+
+  /// @brief デストラクタ
+  ~BdnFlatGraph();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 内容の設定
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief BdnMgr の内容を設定する．
+  /// @param[in] network 元のネットワーク
+  void
+  set(const BdnMgr& network);
+
+  /// @brief 内容をクリアする．
+  void
+  clear();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // リテラルに関する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief リテラルを作る．
+  /// @param[in] id ノード番号
+  /// @param[in] inv 反転属性
+  static
+  ymuint32
+  make_lit(ymuint32 id,
+	   bool inv = false);
+
+  /// @brief リテラルのノード番号を得る．
+  static
+  ymuint32
+  lit_id(ymuint32 lit);
+
+  /// @brief リテラルの反転属性を得る．
+  static
+  bool
+  lit_inv(ymuint32 lit);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 情報の取得
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノード数を得る．
+  /// @note 定数ノードを含む．
+  ymuint
+  node_num() const;
+
+  /// @brief 入力ノード数を得る．
+  ymuint
+  input_num() const;
+
+  /// @brief 論理ノード数を得る．
+  ymuint
+  lnode_num() const;
+
+  /// @brief 出力ノード数を得る．
+  ymuint
+  output_num() const;
+
+  /// @brief 最大段数を得る．
+  ymuint
+  max_level() const;
+
+  /// @brief ノードの種類を得る．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  ymuint
+  type(ymuint id) const;
+
+  /// @brief ファンイン0 のリテラルを得る．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  /// @note 論理ノードと出力ノードの時のみ意味を持つ．
+  ymuint32
+  fanin0(ymuint id) const;
+
+  /// @brief ファンイン1 のリテラルを得る．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  /// @note 論理ノードの時のみ意味を持つ．
+  ymuint32
+  fanin1(ymuint id) const;
+
+  /// @brief レベルを得る．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  ymuint
+  level(ymuint id) const;
+
+  /// @brief 元のノードを得る．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  /// @note 定数ノードの場合は nullptr を返す．
+  const BdnNode*
+  orig_node(ymuint id) const;
+
+  /// @brief 元のノードに対応するノード番号を得る．
+  /// @param[in] node 元のノード
+  ymuint32
+  node_id(const BdnNode* node) const;
+
+  /// @brief ファンアウト数を得る．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  ymuint
+  fanout_num(ymuint id) const;
+
+  /// @brief ファンアウトの配列の先頭を得る．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  /// @note 各要素は (ファンアウト先のノード番号 << 1) | ファンイン番号
+  /// を表す．
+  const ymuint32*
+  fanout_begin(ymuint id) const;
+
+  /// @brief ファンアウトの配列の末尾を得る．
+  /// @param[in] id ノード番号 ( 0 <= id < node_num() )
+  const ymuint32*
+  fanout_end(ymuint id) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 配列の取得
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの種類の配列を得る．
+  const ymuint8*
+  type_array() const;
+
+  /// @brief ファンイン0 の配列を得る．
+  const ymuint32*
+  fanin0_array() const;
+
+  /// @brief ファンイン1 の配列を得る．
+  const ymuint32*
+  fanin1_array() const;
+
+  /// @brief レベルの配列を得る．
+  const ymuint32*
+  level_array() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファンアウトの配列を作る．
+  void
+  build_fanout() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力ノード数
+  ymuint32 mInputNum;
+
+  // 論理ノード数
+  ymuint32 mLnodeNum;
+
+  // 出力ノード数
+  ymuint32 mOutputNum;
+
+  // 最大段数
+  ymuint32 mMaxLevel;
+
+  // ノードの種類の配列
+  vector<ymuint8> mTypeArray;
+
+  // ファンイン0 の配列
+  vector<ymuint32> mFanin0Array;
+
+  // ファンイン1 の配列
+  vector<ymuint32> mFanin1Array;
+
+  // レベルの配列
+  vector<ymuint32> mLevelArray;
+
+  // 元のノードの配列
+  vector<const BdnNode*> mOrigArray;
+
+  // BdnNode の ID 番号をキーにしてノード番号を格納する配列
+  vector<ymuint32> mIdMap;
+
+  // ファンアウトの配列が作られている時 true となるフラグ
+  mutable
+  bool mFanoutValid;
+
+  // 各ノードのファンアウトの先頭位置
+  // サイズは node_num() + 1
+  mutable
+  vector<ymuint32> mFanoutTop;
+
+  // ファンアウトの配列
+  mutable
+  vector<ymuint32> mFanoutArray;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief リテラルを作る．
+inline
+ymuint32
+BdnFlatGraph::make_lit(ymuint32 id,
+		       bool inv)
+{
+  return (id << 1) | static_cast<ymuint32>(inv);
+}
+
+// @brief リテラルのノード番号を得る．
+inline
+ymuint32
+BdnFlatGraph::lit_id(ymuint32 lit)
+{
+  return lit >> 1;
+}
+
+// @brief リテラルの反転属性を得る．
+inline
+bool
+BdnFlatGraph::lit_inv(ymuint32 lit)
+{
+  return static_cast<bool>(lit & 1U);
+}
+
+// @brief ノード数を得る．
+inline
+ymuint
+BdnFlatGraph::node_num() const
+{
+  return mTypeArray.size();
+}
+
+// @brief 入力ノード数を得る．
+inline
+ymuint
+BdnFlatGraph::input_num() const
+{
+  return mInputNum;
+}
+
+// @brief 論理ノード数を得る．
+inline
+ymuint
+BdnFlatGraph::lnode_num() const
+{
+  return mLnodeNum;
+}
+
+// @brief 出力ノード数を得る．
+inline
+ymuint
+BdnFlatGraph::output_num() const
+{
+  return mOutputNum;
+}
+
+// @brief 最大段数を得る．
+inline
+ymuint
+BdnFlatGraph::max_level() const
+{
+  return mMaxLevel;
+}
+
+// @brief ノードの種類を得る．
+inline
+ymuint
+BdnFlatGraph::type(ymuint id) const
+{
+  return mTypeArray[id];
+}
+
+// @brief ファンイン0 のリテラルを得る．
+inline
+ymuint32
+BdnFlatGraph::fanin0(ymuint id) const
+{
+  return mFanin0Array[id];
+}
+
+// @brief ファンイン1 のリテラルを得る．
+inline
+ymuint32
+BdnFlatGraph::fanin1(ymuint id) const
+{
+  return mFanin1Array[id];
+}
+
+// @brief レベルを得る．
+inline
+ymuint
+BdnFlatGraph::level(ymuint id) const
+{
+  return mLevelArray[id];
+}
+
+// @brief 元のノードを得る．
+inline
+const BdnNode*
+BdnFlatGraph::orig_node(ymuint id) const
+{
+  return mOrigArray[id];
+}
+
+// @brief 元のノードに対応するノード番号を得る．
+inline
+ymuint32
+BdnFlatGraph::node_id(const BdnNode* node) const
+{
+  return mIdMap[node->id()];
+}
+
+// @brief ファンアウト数を得る．
+inline
+ymuint
+BdnFlatGraph::fanout_num(ymuint id) const
+{
+  if ( !mFanoutValid ) {
+    build_fanout();
+  }
+  return mFanoutTop[id + 1] - mFanoutTop[id];
+}
+
+// @brief ファンアウトの配列の先頭を得る．
+inline
+const ymuint32*
+BdnFlatGraph::fanout_begin(ymuint id) const
+{
+  if ( !mFanoutValid ) {
+    build_fanout();
+  }
+  return mFanoutArray.data() + mFanoutTop[id];
+}
+
+// @brief ファンアウトの配列の末尾を得る．
+inline
+const ymuint32*
+BdnFlatGraph::fanout_end(ymuint id) const
+{
+  if ( !mFanoutValid ) {
+    build_fanout();
+  }
+  return mFanoutArray.data() + mFanoutTop[id + 1];
+}
+
+// @brief ノードの種類の配列を得る．
+inline
+const ymuint8*
+BdnFlatGraph::type_array() const
+{
+  return &mTypeArray[0];
+}
+
+// @brief ファンイン0 の配列を得る．
+inline
+const ymuint32*
+BdnFlatGraph::fanin0_array() const
+{
+  return &mFanin0Array[0];
+}
+
+// @brief ファンイン1 の配列を得る．
+inline
+const ymuint32*
+BdnFlatGraph::fanin1_array() const
+{
+  return &mFanin1Array[0];
+}
+
+// @brief レベルの配列を得る．
+inline
+const ymuint32*
+BdnFlatGraph::level_array() const
+{
+  return &mLevelArray[0];
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
+
+#endif // NETWORKS_BDNFLATGRAPH_H
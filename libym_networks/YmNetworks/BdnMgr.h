@@ -10,6 +10,8 @@
 
 #include "YmNetworks/bdn.h"
 #include "YmNetworks/BdnNodeHandle.h"
+#include "YmUtils/IDO.h"
+#include "YmUtils/ODO.h"
 
 
 BEGIN_NAMESPACE_YM_NETWORKS_BDN
@@ -489,6 +491,43 @@ public:
   change_xnor(BdnNode* node,
 	      const vector<BdnNodeHandle>& inode_handle_list);
 
+  /// @brief 論理ノードを置き換える．
+  /// @param[in] node 置き換え対象の論理ノード
+  /// @param[in] new_handle 置き換え後のノード+極性
+  /// @param[out] deleted_list 削除されたノードのID番号のリスト
+  /// @note node のファンアウト先を new_handle に付け替えたのち，
+  /// どこにもファンアウトしなくなった論理ノード(node を含む)を削除する．
+  /// @note new_handle の TFI に node が含まれていてはいけない．
+  void
+  replace_logic(BdnNode* node,
+		BdnNodeHandle new_handle,
+		vector<ymuint>& deleted_list);
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name ダンプ/リストア関係の関数
+  /// @{
+
+  /// @brief 内容をバイナリダンプする．
+  /// @param[in] s 出力先のストリーム
+  /// @note ノードの ID 番号も保存される．
+  void
+  dump(ODO& s) const;
+
+  /// @brief バイナリダンプされた内容を読み込む．
+  /// @param[in] s 入力元のストリーム
+  /// @return 読み込みが成功したら true を返す．
+  /// @note 成功した場合，元の内容は破棄される．
+  /// 内容に矛盾がある場合には元の内容を変えずに false を返す．
+  /// @note ノードの ID 番号は dump() した時と同じになる．
+  /// D-FF とラッチの ID 番号は詰めて振り直される．
+  bool
+  restore(IDO& s);
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,408 @@
+﻿#ifndef NETWORKS_BDNREACH_H
+#define NETWORKS_BDNREACH_H
+
+/// @file YmNetworks/BdnReach.h
+/// @brief BdnReach のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/bdn.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnConstNodeHandle.h"
+#include "YmLogic/Bdd.h"
+#include "YmLogic/BddMgr.h"
+#include "YmLogic/BddVarSet.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BdnReachStats BdnReach.h "YmNetworks/BdnReach.h"
+/// @brief BdnReach の1回の反復の統計情報
+//////////////////////////////////////////////////////////////////////
+struct BdnReachStats
+{
+  /// @brief 反復回数(0 から始まる)
+  ymuint32 mIteration;
+
+  /// @brief 像計算に用いたフロンティアのノード数
+  ymuint64 mFrontierSize;
+
+  /// @brief 像計算の途中結果の最大ノード数
+  ymuint64 mPeakSize;
+
+  /// @brief 反復後の到達状態集合のノード数
+  ymuint64 mReachedSize;
+
+  /// @brief 反復後の BddMgr のノード数
+  ymuint64 mMgrSize;
+
+  /// @brief 反復にかかった時間(usec)
+  double mTime;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BdnReach BdnReach.h "YmNetworks/BdnReach.h"
+/// @brief BdnMgr の順序回路上の BDD による到達可能性解析を行うクラス
+///
+/// D-FF とラッチを状態変数とし，1回の遷移ですべての状態変数が
+/// 同時に更新されるものとみなす．
+/// - D-FF の次状態関数は clear ? 0 : preset ? 1 : data とする．
+///   クロックは考慮しない．
+/// - ラッチの次状態関数は clear ? 0 : preset ? 1 : enable ? data : q とする．
+///
+/// BDD の変数は状態変数ごとに現状態と次状態を隣り合わせに確保し，
+/// その後に外部入力の変数を確保する．
+/// - 現状態 : 2 * pos
+/// - 次状態 : 2 * pos + 1
+/// - 外部入力 : 2 * state_num() + pos
+///
+/// 遷移関係は状態変数ごとの部分関係 (y_i == δ_i(x, w)) を
+/// ノード数が cluster_limit() を越えない範囲でまとめたクラスタの積で表し，
+/// 単一の遷移関係は作らない．
+/// 像計算では IWLS95 の手法に従ってクラスタの順序を決め，
+/// 以降のクラスタに現れない変数をその場で消去する．
+/// 前向き探索のフロンティアは generalized cofactor で
+/// 到達済みの状態を don't care として簡単化する．
+//////////////////////////////////////////////////////////////////////
+class BdnReach
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] mgr BDD の管理クラス
+  /// @param[in] cluster_limit クラスタのノード数の上限
+  /// @note mgr の変数番号 0 から 2 * state_num() + input_num() - 1
+  /// までを用いる．
+  /// @note network の構造は BdnReach の生存中に変更してはいけない．
+  BdnReach(const BdnMgr& network,
+	   BddMgr& mgr,
+	   ymuint cluster_limit = 5000);
+
+  /// @brief デストラクタ
+  ~BdnReach();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 変数と関数の取得
+  /// @{
+
+  /// @brief 状態変数の数を得る．
+  ymuint
+  state_num() const;
+
+  /// @brief 外部入力の数を得る．
+  ymuint
+  input_num() const;
+
+  /// @brief 状態変数に対応するノードを得る．
+  /// @param[in] pos 位置番号 ( 0 <= pos < state_num() )
+  /// @note D-FF かラッチの出力ノードとなる．
+  const BdnNode*
+  state_node(ymuint pos) const;
+
+  /// @brief 外部入力ノードを得る．
+  /// @param[in] pos 位置番号 ( 0 <= pos < input_num() )
+  const BdnNode*
+  input_node(ymuint pos) const;
+
+  /// @brief 現状態の変数番号を得る．
+  /// @param[in] pos 状態変数の位置番号 ( 0 <= pos < state_num() )
+  VarId
+  cur_var(ymuint pos) const;
+
+  /// @brief 次状態の変数番号を得る．
+  /// @param[in] pos 状態変数の位置番号 ( 0 <= pos < state_num() )
+  VarId
+  next_var(ymuint pos) const;
+
+  /// @brief 外部入力の変数番号を得る．
+  /// @param[in] pos 外部入力の位置番号 ( 0 <= pos < input_num() )
+  VarId
+  input_var(ymuint pos) const;
+
+  /// @brief ノードの関数を得る．
+  /// @param[in] node 対象のノード
+  /// @return 現状態と外部入力の変数で表した関数を返す．
+  /// @note 出力ノードの場合にはファンインの関数を返す．
+  Bdd
+  node_func(const BdnNode* node) const;
+
+  /// @brief すべての状態変数が 0 の状態を表す BDD を返す．
+  Bdd
+  zero_state() const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 到達可能性解析
+  /// @{
+
+  /// @brief クラスタのノード数の上限を得る．
+  ymuint
+  cluster_limit() const;
+
+  /// @brief クラスタの数を得る．
+  ymuint
+  cluster_num() const;
+
+  /// @brief 像を求める．
+  /// @param[in] from 現状態の集合
+  /// @return from から1回の遷移で到達できる状態の集合(現状態の変数で表す)
+  Bdd
+  image(const Bdd& from);
+
+  /// @brief 逆像を求める．
+  /// @param[in] to 現状態の変数で表した状態の集合
+  /// @return 1回の遷移で to に到達できる状態の集合
+  Bdd
+  preimage(const Bdd& to);
+
+  /// @brief 前向きに到達可能な状態の集合を求める．
+  /// @param[in] init 初期状態の集合
+  /// @param[in] max_iter 反復回数の上限 (0 の時は無制限)
+  /// @return 到達可能な状態の集合
+  Bdd
+  forward(const Bdd& init,
+	  ymuint max_iter = 0);
+
+  /// @brief 後ろ向きに到達可能な状態の集合を求める．
+  /// @param[in] target 目標の状態の集合
+  /// @param[in] max_iter 反復回数の上限 (0 の時は無制限)
+  /// @return target に到達可能な状態の集合(target を含む)
+  Bdd
+  backward(const Bdd& target,
+	   ymuint max_iter = 0);
+
+  /// @brief 不変条件を調べる．
+  /// @param[in] init 初期状態の集合
+  /// @param[in] invariant 不変条件
+  /// @return すべての到達可能な状態で invariant が成り立つ時 true を返す．
+  /// @note invariant は外部入力の変数を含んでいてもよい．その場合には
+  /// すべての入力値で成り立つ必要がある．
+  /// @note 反例が見つかった時点で探索を打ち切る．
+  bool
+  check_invariant(const Bdd& init,
+		  const Bdd& invariant);
+
+  /// @brief 直前の forward()/backward()/check_invariant() の統計情報を得る．
+  const vector<BdnReachStats>&
+  stats_list() const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 像計算の手順
+  struct Schedule
+  {
+    // コンストラクタ
+    Schedule(BddMgr& mgr);
+
+    // 最初に消去する変数の集合
+    BddVarSet mPreVars;
+
+    // クラスタのリスト(適用順)
+    vector<Bdd> mClusterList;
+
+    // 各クラスタを掛けた後に消去する変数の集合
+    vector<BddVarSet> mQuantList;
+
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの関数を計算する．
+  void
+  calc_node_func();
+
+  /// @brief ハンドルの関数を得る．
+  Bdd
+  handle_func(BdnConstNodeHandle handle) const;
+
+  /// @brief 遷移関係のクラスタを作る．
+  void
+  make_clusters();
+
+  /// @brief 像計算の手順を作る．
+  /// @param[in] qvars 消去する変数の集合
+  /// @param[out] schedule 結果を格納する変数
+  void
+  make_schedule(const BddVarSet& qvars,
+		Schedule& schedule);
+
+  /// @brief 手順に従って関係積を計算する．
+  /// @param[in] from 対象の集合
+  /// @param[in] schedule 手順
+  Bdd
+  rel_prod(const Bdd& from,
+	   const Schedule& schedule);
+
+  /// @brief 不動点を求める．
+  /// @param[in] start 開始状態の集合
+  /// @param[in] bad これと交わったら打ち切る状態の集合
+  /// @param[in] fwd 前向きの時 true
+  /// @param[in] max_iter 反復回数の上限
+  Bdd
+  fixpoint(const Bdd& start,
+	   const Bdd& bad,
+	   bool fwd,
+	   ymuint max_iter);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const BdnMgr& mNetwork;
+
+  // BDD の管理クラス
+  BddMgr& mMgr;
+
+  // クラスタのノード数の上限
+  ymuint32 mClusterLimit;
+
+  // 状態変数に対応するノードのリスト
+  vector<const BdnNode*> mStateList;
+
+  // 外部入力ノードのリスト
+  vector<const BdnNode*> mInputList;
+
+  // ノードの関数
+  // キーはノード番号
+  vector<Bdd> mNodeFunc;
+
+  // 遷移関係のクラスタのリスト
+  vector<Bdd> mClusterList;
+
+  // 次状態から現状態への変数の対応表
+  HashMap<VarId, VarId> mNextToCur;
+
+  // 現状態から次状態への変数の対応表
+  HashMap<VarId, VarId> mCurToNext;
+
+  // 像計算の手順
+  Schedule mFwdSchedule;
+
+  // 逆像計算の手順
+  Schedule mBwdSchedule;
+
+  // 像計算の途中結果の最大ノード数
+  ymuint64 mPeakSize;
+
+  // 統計情報のリスト
+  vector<BdnReachStats> mStatsList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 状態変数の数を得る．
+inline
+ymuint
+BdnReach::state_num() const
+{
+  return mStateList.size();
+}
+
+// @brief 外部入力の数を得る．
+inline
+ymuint
+BdnReach::input_num() const
+{
+  return mInputList.size();
+}
+
+// @brief 状態変数に対応するノードを得る．
+inline
+const BdnNode*
+BdnReach::state_node(ymuint pos) const
+{
+  ASSERT_COND( pos < state_num() );
+  return mStateList[pos];
+}
+
+// @brief 外部入力ノードを得る．
+inline
+const BdnNode*
+BdnReach::input_node(ymuint pos) const
+{
+  ASSERT_COND( pos < input_num() );
+  return mInputList[pos];
+}
+
+// @brief 現状態の変数番号を得る．
+inline
+VarId
+BdnReach::cur_var(ymuint pos) const
+{
+  return VarId(pos * 2);
+}
+
+// @brief 次状態の変数番号を得る．
+inline
+VarId
+BdnReach::next_var(ymuint pos) const
+{
+  return VarId(pos * 2 + 1);
+}
+
+// @brief 外部入力の変数番号を得る．
+inline
+VarId
+BdnReach::input_var(ymuint pos) const
+{
+  return VarId(state_num() * 2 + pos);
+}
+
+// @brief クラスタのノード数の上限を得る．
+inline
+ymuint
+BdnReach::cluster_limit() const
+{
+  return mClusterLimit;
+}
+
+// @brief クラスタの数を得る．
+inline
+ymuint
+BdnReach::cluster_num() const
+{
+  return mClusterList.size();
+}
+
+// @brief 直前の forward()/backward()/check_invariant() の統計情報を得る．
+inline
+const vector<BdnReachStats>&
+BdnReach::stats_list() const
+{
+  return mStatsList;
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
+
+#endif // NETWORKS_BDNREACH_H
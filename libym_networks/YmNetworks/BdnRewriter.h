@@ -0,0 +1,64 @@
+﻿#ifndef NETWORKS_BDNREWRITER_H
+#define NETWORKS_BDNREWRITER_H
+
+/// @file YmNetworks/BdnRewriter.h
+/// @brief BdnRewriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/bdn.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+class RwtLib;
+
+//////////////////////////////////////////////////////////////////////
+/// @class BdnRewriter BdnRewriter.h "YmNetworks/BdnRewriter.h"
+/// @brief BdnMgr の論理ノードを書き換えてノード数を削減するクラス
+///
+/// 各論理ノードの4入力以下のカットの関数を NPN 同値類ごとの
+/// 部分グラフで置き換える．
+/// 置き換えはファンアウトを共有しているノードを考慮して
+/// ノード数が減る場合のみ行う．
+/// 部分グラフのライブラリはオブジェクトの寿命の間共有されるので
+/// 複数のネットワークに適用する場合には同じオブジェクトを使うほうがよい．
+//////////////////////////////////////////////////////////////////////
+class BdnRewriter
+{
+public:
+
+  /// @brief コンストラクタ
+  BdnRewriter();
+
+  /// @brief デストラクタ
+  ~BdnRewriter();
+
+
+public:
+
+  /// @brief 書き換えを行う．
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] use_zero 削減量が0の置き換えも行う時 true にする．
+  /// @return 置き換えを行った回数を返す．
+  ymuint
+  operator()(BdnMgr& network,
+	     bool use_zero = false);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 部分グラフのライブラリ
+  RwtLib* mLib;
+
+};
+
+END_NAMESPACE_YM_NETWORKS_BDN
+
+#endif // NETWORKS_BDNREWRITER_H
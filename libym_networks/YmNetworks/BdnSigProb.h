@@ -0,0 +1,188 @@
+﻿#ifndef NETWORKS_BDNSIGPROB_H
+#define NETWORKS_BDNSIGPROB_H
+
+/// @file YmNetworks/BdnSigProb.h
+/// @brief BdnSigProb のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/bdn.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS
+
+class SigProbEngine;
+
+END_NAMESPACE_YM_NETWORKS
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BdnSigProb BdnSigProb.h "YmNetworks/BdnSigProb.h"
+/// @brief BdnMgr の各ノードの信号確率とトグル率を求めるクラス
+///
+/// 信号確率はノードの値が 1 となる確率，トグル率は1サイクルあたりに
+/// 値が変化する確率である．
+/// 入力ノード(D-FF とラッチの出力を含む)の値は独立で，それぞれが
+/// set_input_prob() で指定した信号確率とトグル率を持つ
+/// 1次のマルコフ連鎖に従って変化するものとみなす．
+/// 既定値は信号確率，トグル率ともに 0.5 (時間的にも独立)である．
+///
+/// 計算方法は2通りある．
+/// - simulate() : 64 ビット並列のモンテカルロシミュレーション．
+///   すべてのノードの 95% 信頼区間の半幅が目標値以下になるか，
+///   パタン数が上限に達するまでシミュレーションを続ける．
+/// - analyze() : 各ノードについて葉の数が cut_size 以下の局所カットを求め，
+///   カット内の関数の BDD から確率を求める．
+///   カットの葉は独立とみなすので，カットの外の再収斂は無視される．
+///   BDD の大きさはカットの大きさで抑えられるので大きな回路にも適用できる．
+///
+/// update() は BdnMgr の局所的な変更の後に呼ぶ．
+/// 変更のあったノードを調べ，前回と同じ方法で計算し直す．
+/// analyze() の場合は変更のあったノードの推移的ファンアウトのみを計算する．
+/// simulate() の場合も変更のあったノードの推移的ファンアウトのみを
+/// 前回と同じパタンでシミュレーションし直すので，
+/// 変更の影響を受けないノードの結果は変わらない．
+//////////////////////////////////////////////////////////////////////
+class BdnSigProb
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] thread_num 計算に用いるスレッド数
+  BdnSigProb(const BdnMgr& network,
+	     ymuint thread_num = 1);
+
+  /// @brief デストラクタ
+  ~BdnSigProb();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 条件の設定
+  /// @{
+
+  /// @brief 入力の信号確率とトグル率を設定する．
+  /// @param[in] node 対象の入力ノード
+  /// @param[in] prob 値が 1 となる確率
+  /// @param[in] toggle トグル率
+  /// @note toggle は 2 * min(prob, 1 - prob) 以下に丸められる．
+  void
+  set_input_prob(const BdnNode* node,
+		 double prob,
+		 double toggle);
+
+  /// @brief モンテカルロシミュレーションのパラメータを設定する．
+  /// @param[in] max_pattern パタン数の上限
+  /// @param[in] max_error 95% 信頼区間の半幅の目標値
+  /// @param[in] seed 乱数の種
+  /// @note 既定値は 2^20, 0.005, 1 である．
+  void
+  set_mc_param(ymuint64 max_pattern,
+	       double max_error,
+	       ymuint32 seed = 1);
+
+  /// @brief 局所カットのパラメータを設定する．
+  /// @param[in] cut_size カットの葉の数の上限
+  /// @param[in] cone_size カット内のノード数の上限
+  /// @note 既定値は 8, 32 である．
+  void
+  set_cut_param(ymuint cut_size,
+		ymuint cone_size);
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 計算と結果の取得
+  /// @{
+
+  /// @brief モンテカルロシミュレーションで求める．
+  void
+  simulate();
+
+  /// @brief 局所カットの BDD を用いて解析的に求める．
+  void
+  analyze();
+
+  /// @brief ネットワークの変更を反映して計算し直す．
+  /// @note 一度も計算していない場合には analyze() を行う．
+  void
+  update();
+
+  /// @brief シミュレーションしたパタン数を返す．
+  /// @note analyze() の結果の場合は 0 を返す．
+  ymuint64
+  pattern_num() const;
+
+  /// @brief 信号確率を得る．
+  /// @param[in] node 対象のノード
+  double
+  prob(const BdnNode* node) const;
+
+  /// @brief トグル率を得る．
+  /// @param[in] node 対象のノード
+  double
+  toggle(const BdnNode* node) const;
+
+  /// @brief 信号確率の 95% 信頼区間の半幅を得る．
+  /// @param[in] node 対象のノード
+  /// @note analyze() の結果の場合は 0 を返す．
+  double
+  prob_error(const BdnNode* node) const;
+
+  /// @brief トグル率の 95% 信頼区間の半幅を得る．
+  /// @param[in] node 対象のノード
+  /// @note analyze() の結果の場合は 0 を返す．
+  double
+  toggle_error(const BdnNode* node) const;
+
+  /// @brief 結果を出力する．
+  /// @param[in] s 出力先のストリーム
+  /// @note 1行に1ノードずつ，ノード番号の順に
+  /// "ノード番号 種類 信号確率 トグル率 [信号確率の誤差 トグル率の誤差]"
+  /// を出力する．誤差は simulate() の結果の場合のみ出力する．
+  void
+  dump(ostream& s) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ネットワークの構造を読み込む．
+  /// @note 前回から変化のあったノードのみを SigProbEngine に設定する．
+  void
+  scan();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const BdnMgr& mNetwork;
+
+  // 計算の本体
+  SigProbEngine* mEngine;
+
+  // 前回読み込んだノードの構造
+  // キーはノード番号 x 3 で，種類とファンインのハンドルを表す．
+  vector<ymuint64> mSignature;
+
+};
+
+END_NAMESPACE_YM_NETWORKS_BDN
+
+#endif // NETWORKS_BDNSIGPROB_H
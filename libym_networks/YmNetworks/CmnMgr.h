@@ -11,6 +11,8 @@
 
 #include "YmNetworks/cmn.h"
 #include "YmCell/cell_nsdef.h"
+#include "YmUtils/IDO.h"
+#include "YmUtils/ODO.h"
 
 
 BEGIN_NAMESPACE_YM_NETWORKS_CMN
@@ -254,6 +256,34 @@ public:
   //////////////////////////////////////////////////////////////////////
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name ダンプ/リストア関係の関数
+  /// @{
+
+  /// @brief 内容をバイナリダンプする．
+  /// @param[in] s 出力先のストリーム
+  /// @note セルはセル番号で記録される．
+  void
+  dump(ODO& s) const;
+
+  /// @brief バイナリダンプされた内容を読み込む．
+  /// @param[in] s 入力元のストリーム
+  /// @param[in] library セルの取得に用いるセルライブラリ
+  /// @return 読み込みが成功したら true を返す．
+  /// @note library は dump() した時と同じでなければならない．
+  /// @note 成功した場合，元の内容は破棄される．
+  /// 内容に矛盾がある場合には元の内容を変えずに false を返す．
+  /// @note ノードの ID 番号は dump() した時と同じになる．
+  /// D-FF とラッチの ID 番号は詰めて振り直される．
+  bool
+  restore(IDO& s,
+	  const CellLibrary& library);
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -0,0 +1,368 @@
+﻿#ifndef NETWORKS_CMNSTA_H
+#define NETWORKS_CMNSTA_H
+
+/// @file YmNetworks/CmnSta.h
+/// @brief CmnSta のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/cmn.h"
+#include "YmCell/cell_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_CMN
+
+class CmnStaPool;
+
+//////////////////////////////////////////////////////////////////////
+/// @class CmnStaPath CmnSta.h "YmNetworks/CmnSta.h"
+/// @brief CmnSta で求めたクリティカルパスを表す構造体
+//////////////////////////////////////////////////////////////////////
+struct CmnStaPath
+{
+  /// @brief スラック
+  double mSlack;
+
+  /// @brief 経路上のノードのリスト
+  /// @note 入力ノードから出力ノードの順に並ぶ．
+  vector<const CmnNode*> mNodeList;
+
+  /// @brief 各ノードの出力の遷移
+  /// @note true が立ち上がり，false が立ち下がりを表す．
+  vector<bool> mRiseList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class CmnSta CmnSta.h "YmNetworks/CmnSta.h"
+/// @brief CmnMgr 上の静的タイミング解析を行うクラス
+///
+/// 各セルの遅延と出力の遷移時間は CellTiming の cell_rise/cell_fall,
+/// rise_transition/fall_transition の表を入力の遷移時間と負荷容量で
+/// 引いて求める．表がない場合には generic CMOS モデルを用いる．
+/// 負荷容量はファンアウト先のピン容量と配線容量の和で，配線容量は
+/// ファンアウト数から求める(wire load モデル)．
+/// 外部出力の負荷容量は set_output_load() で指定する．
+///
+/// D-FF やラッチの出力は外部入力と同様に扱い，clock-to-Q の遅延は
+/// 考慮しない．
+///
+/// set_cell() でノードのセルを置き換えた後の update() は影響を
+/// 受ける範囲のみを計算し直す．
+///
+/// thread_num が 2 以上の場合，ノード数の多いレベルは並列に処理する．
+/// スレッドは最初に必要になった時に作り，CmnSta が破棄されるまで
+/// 使い回す．
+/// restore_mapped() で読み込んだライブラリのタイミング情報は
+/// 計算中に読み込まれるが，その読み込みは排他的に行われる．
+//////////////////////////////////////////////////////////////////////
+class CmnSta
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] thread_num 計算に用いるスレッド数
+  /// @note network の構造は CmnSta の生存中に変更してはいけない．
+  CmnSta(const CmnMgr& network,
+	 ymuint thread_num = 1);
+
+  /// @brief デストラクタ
+  ~CmnSta();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 条件の設定
+  /// @{
+
+  /// @brief 入力の到着時刻を設定する．
+  /// @param[in] node 対象の入力ノード
+  /// @param[in] rise 立ち上がりの到着時刻
+  /// @param[in] fall 立ち下がりの到着時刻
+  void
+  set_input_arrival(const CmnNode* node,
+		    double rise,
+		    double fall);
+
+  /// @brief 入力の遷移時間を設定する．
+  /// @param[in] node 対象の入力ノード
+  /// @param[in] rise 立ち上がりの遷移時間
+  /// @param[in] fall 立ち下がりの遷移時間
+  void
+  set_input_transition(const CmnNode* node,
+		       double rise,
+		       double fall);
+
+  /// @brief 出力の負荷容量を設定する．
+  /// @param[in] node 対象の出力ノード
+  /// @param[in] load 負荷容量
+  /// @note ピン容量に加算される．
+  void
+  set_output_load(const CmnNode* node,
+		  double load);
+
+  /// @brief 出力の要求時刻を設定する．
+  /// @param[in] node 対象の出力ノード
+  /// @param[in] rise 立ち上がりの要求時刻
+  /// @param[in] fall 立ち下がりの要求時刻
+  void
+  set_output_required(const CmnNode* node,
+		      double rise,
+		      double fall);
+
+  /// @brief 個別に設定されていない出力の要求時刻を設定する．
+  /// @param[in] required 要求時刻
+  /// @note 設定しない場合には最大の到着時刻を用いる．
+  void
+  set_default_required(double required);
+
+  /// @brief wire load モデルを設定する．
+  /// @param[in] cap_list ファンアウト数ごとの配線容量のリスト
+  /// @param[in] slope cap_list の範囲を超えた時の1ファンアウトあたりの増分
+  /// @note cap_list[i] がファンアウト数 i の時の配線容量となる．
+  /// @note cap_list が空の時は配線容量を 0 とみなす(lumped-C モデル)．
+  void
+  set_wire_load(const vector<double>& cap_list,
+		double slope);
+
+  /// @brief ノードのセルを置き換える．
+  /// @param[in] node 対象の論理ノード
+  /// @param[in] cell 新しいセル
+  /// @note cell は元のセルとピン構成が同じでなければならない．
+  /// @note ネットワーク自体は変更しない．
+  void
+  set_cell(const CmnNode* node,
+	   const Cell* cell);
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 計算と結果の取得
+  /// @{
+
+  /// @brief タイミングを計算する．
+  /// @note 前回の計算以降に set_cell() しか行っていない場合には
+  /// 変化のあった部分のみを計算し直す．
+  void
+  update();
+
+  /// @brief ノードのセルを得る．
+  /// @param[in] node 対象のノード
+  const Cell*
+  cell(const CmnNode* node) const;
+
+  /// @brief 到着時刻を得る．
+  /// @param[in] node 対象のノード
+  /// @param[in] rise 立ち上がりの時 true とするフラグ
+  double
+  arrival(const CmnNode* node,
+	  bool rise) const;
+
+  /// @brief 要求時刻を得る．
+  /// @param[in] node 対象のノード
+  /// @param[in] rise 立ち上がりの時 true とするフラグ
+  double
+  required(const CmnNode* node,
+	   bool rise) const;
+
+  /// @brief スラックを得る．
+  /// @param[in] node 対象のノード
+  /// @param[in] rise 立ち上がりの時 true とするフラグ
+  double
+  slack(const CmnNode* node,
+	bool rise) const;
+
+  /// @brief 遷移時間を得る．
+  /// @param[in] node 対象のノード
+  /// @param[in] rise 立ち上がりの時 true とするフラグ
+  double
+  transition(const CmnNode* node,
+	     bool rise) const;
+
+  /// @brief 負荷容量を得る．
+  /// @param[in] node 対象のノード
+  double
+  load(const CmnNode* node) const;
+
+  /// @brief 最小のスラックを得る．
+  double
+  worst_slack() const;
+
+  /// @brief スラックの小さい順に経路を求める．
+  /// @param[in] n 求める経路数の上限
+  /// @param[out] path_list 結果の経路を格納するリスト
+  void
+  critical_paths(ymuint n,
+		 vector<CmnStaPath>& path_list) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief すべてを計算し直す．
+  void
+  full_update();
+
+  /// @brief 変化のあった部分のみ計算し直す．
+  void
+  incr_update();
+
+  /// @brief 負荷容量を計算する．
+  /// @param[in] node 対象のノード
+  void
+  calc_load(const CmnNode* node);
+
+  /// @brief 到着時刻と遷移時間を計算する．
+  /// @param[in] node 対象のノード
+  /// @return 値が変化したら true を返す．
+  bool
+  calc_arrival(const CmnNode* node);
+
+  /// @brief 要求時刻を計算する．
+  /// @param[in] node 対象のノード
+  /// @return 値が変化したら true を返す．
+  bool
+  calc_required(const CmnNode* node);
+
+  /// @brief 出力の要求時刻の既定値を求める．
+  double
+  calc_default_required() const;
+
+  /// @brief ノードのリストに対して関数を並列に適用する．
+  /// @param[in] node_list ノードのリスト
+  /// @param[in] func 適用する関数
+  void
+  parallel_apply(const vector<const CmnNode*>& node_list,
+		 bool (CmnSta::*func)(const CmnNode*));
+
+  /// @brief アークの遅延を得る．
+  /// @param[in] node 対象の論理ノード
+  /// @param[in] ipos ファンイン番号
+  /// @param[in] irise 入力が立ち上がりの時 true
+  /// @param[in] orise 出力が立ち上がりの時 true
+  double&
+  arc_delay(const CmnNode* node,
+	    ymuint ipos,
+	    bool irise,
+	    bool orise);
+
+  /// @brief アークの遅延を得る．
+  double
+  arc_delay(const CmnNode* node,
+	    ymuint ipos,
+	    bool irise,
+	    bool orise) const;
+
+  /// @brief 配線容量を得る．
+  /// @param[in] fanout_num ファンアウト数
+  double
+  wire_cap(ymuint fanout_num) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const CmnMgr& mNetwork;
+
+  // スレッド数
+  ymuint32 mThreadNum;
+
+  // レベルごとのノードのリスト
+  // 0 番目は入力ノード，最後は出力ノード
+  vector<vector<const CmnNode*> > mLevelList;
+
+  // ノードのレベル
+  // キーはノード番号
+  vector<ymuint32> mLevel;
+
+  // ノードのセル
+  // キーはノード番号
+  vector<const Cell*> mCellArray;
+
+  // アークの遅延を収める配列の先頭位置
+  // キーはノード番号
+  vector<ymuint32> mArcTop;
+
+  // アークの遅延を収める配列
+  // 1つのファンインあたり (入力の遷移) x (出力の遷移) の 4 要素を使う．
+  vector<double> mArcDelay;
+
+  // 入力の到着時刻
+  // キーはノード番号 x 2 + 遷移(0: 立ち上がり, 1: 立ち下がり)
+  vector<double> mInputArrival;
+
+  // 入力の遷移時間
+  // キーは mInputArrival と同じ
+  vector<double> mInputTransition;
+
+  // 出力の負荷容量
+  // キーはノード番号
+  vector<double> mOutputLoad;
+
+  // 出力の要求時刻
+  // キーは mInputArrival と同じ
+  // 設定されていない場合は NaN
+  vector<double> mOutputRequired;
+
+  // 要求時刻の既定値
+  double mDefaultRequired;
+
+  // mDefaultRequired が設定されている時 true となるフラグ
+  bool mHasDefaultRequired;
+
+  // 実際に用いた要求時刻の既定値
+  double mCurDefaultRequired;
+
+  // 配線容量のリスト
+  vector<double> mWireCapList;
+
+  // 配線容量の増分
+  double mWireSlope;
+
+  // 到着時刻
+  // キーは mInputArrival と同じ
+  vector<double> mArrival;
+
+  // 遷移時間
+  // キーは mInputArrival と同じ
+  vector<double> mTransition;
+
+  // 要求時刻
+  // キーは mInputArrival と同じ
+  vector<double> mRequired;
+
+  // 負荷容量
+  // キーはノード番号
+  vector<double> mLoad;
+
+  // すべて計算し直す必要がある時 true となるフラグ
+  bool mAllDirty;
+
+  // set_cell() で変更されたノードのリスト
+  vector<const CmnNode*> mChangedList;
+
+  // parallel_apply() で用いるスレッドプール
+  // 最初に必要になった時に作る．
+  CmnStaPool* mPool;
+
+};
+
+END_NAMESPACE_YM_NETWORKS_CMN
+
+#endif // NETWORKS_CMNSTA_H
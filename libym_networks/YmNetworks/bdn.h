@@ -127,6 +127,17 @@ class BdnDumper;
 class BdnBlifWriter;
 class BdnVerilogWriter;
 
+class BdnRewriter;
+
+class BdnFlatGraph;
+
+class BdnReach;
+struct BdnReachStats;
+
+class BdnBmc;
+
+class BdnSigProb;
+
 /// @brief 枝のリスト
 /// @ingroup BdnGroup
 typedef list<BdnEdge*> BdnEdgeList;
@@ -184,6 +195,15 @@ using nsNetworks::nsBdn::BdnDumper;
 using nsNetworks::nsBdn::BdnBlifWriter;
 using nsNetworks::nsBdn::BdnVerilogWriter;
 
+using nsNetworks::nsBdn::BdnRewriter;
+
+using nsNetworks::nsBdn::BdnReach;
+using nsNetworks::nsBdn::BdnReachStats;
+
+using nsNetworks::nsBdn::BdnBmc;
+
+using nsNetworks::nsBdn::BdnSigProb;
+
 END_NAMESPACE_YM
 
 #endif // NETWORKS_BDN_H
@@ -91,6 +91,11 @@ class CmnDumper;
 class CmnBlifWriter;
 class CmnVerilogWriter;
 
+class CmnSta;
+struct CmnStaPath;
+
+class CmnSigProb;
+
 /// @brief 枝のリスト
 /// @ingroup CmnGroup
 typedef list<CmnEdge*> CmnEdgeList;
@@ -0,0 +1,221 @@
+﻿
+/// @file BdnBmcTest.cc
+/// @brief BdnBmcTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnPort.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnNodeHandle.h"
+#include "YmNetworks/BdnDff.h"
+#include "YmNetworks/BdnBmc.h"
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+// カウンタのビット数
+const ymuint kBitNum = 3;
+
+// イネーブル付きの kBitNum ビットカウンタを作る．
+// wrap が 0 でない時は値が wrap の時に 0 に戻る．
+// 全ビットが 1 となる状態を表すノードを返す．
+const BdnNode*
+make_counter(BdnMgr& network,
+	     ymuint wrap)
+{
+  BdnPort* en_port = network.new_input_port("en", 1);
+  BdnNodeHandle en(en_port->_input(0), false);
+
+  vector<BdnDff*> dff_list(kBitNum);
+  vector<BdnNodeHandle> val(kBitNum);
+  for (ymuint i = 0; i < kBitNum; ++ i) {
+    ostringstream buf;
+    buf << "c" << i;
+    dff_list[i] = network.new_dff(buf.str());
+    val[i] = BdnNodeHandle(dff_list[i]->_output(), false);
+  }
+
+  // 値が wrap で en が 1 の時 1 になる信号
+  BdnNodeHandle reset = BdnNodeHandle::make_zero();
+  if ( wrap > 0 ) {
+    reset = en;
+    for (ymuint i = 0; i < kBitNum; ++ i) {
+      BdnNodeHandle lit = ((wrap >> i) & 1U) ? val[i] : ~val[i];
+      reset = network.new_and(reset, lit);
+    }
+  }
+
+  BdnNodeHandle carry = en;
+  for (ymuint i = 0; i < kBitNum; ++ i) {
+    BdnNodeHandle next = network.new_xor(val[i], carry);
+    carry = network.new_and(val[i], carry);
+    if ( wrap > 0 ) {
+      next = network.new_and(next, ~reset);
+    }
+    network.change_output_fanin(dff_list[i]->_input(), next);
+  }
+
+  BdnNodeHandle bad = val[0];
+  for (ymuint i = 1; i < kBitNum; ++ i) {
+    bad = network.new_and(bad, val[i]);
+  }
+  BdnPort* o_port = network.new_output_port("bad", 1);
+  network.change_output_fanin(o_port->_output(0), bad);
+  return bad.node();
+}
+
+// 反例をシミュレーションして最後の時刻で bad になることを確かめる．
+void
+check_cex(const BdnBmc& bmc)
+{
+  ymuint nf = bmc.cex_frame_num();
+  ASSERT_EQ( bmc.depth() + 1, nf );
+  ymuint val = 0;
+  for (ymuint i = 0; i < kBitNum; ++ i) {
+    if ( bmc.cex_state(i) == kB3True ) {
+      val |= (1U << i);
+    }
+  }
+  ymuint mask = (1U << kBitNum) - 1;
+  for (ymuint t = 0; t < nf; ++ t) {
+    EXPECT_EQ( t == nf - 1, val == mask ) << "t = " << t;
+    if ( bmc.cex_input(t, 0) == kB3True ) {
+      val = (val + 1) & mask;
+    }
+  }
+}
+
+END_NONAMESPACE
+
+
+TEST(BdnBmcTest, bmc_unsafe)
+{
+  BdnMgr network;
+  const BdnNode* bad = make_counter(network, 0);
+  BdnBmc bmc(network);
+  ASSERT_EQ( kBitNum, bmc.state_num() );
+  ASSERT_EQ( 1U, bmc.input_num() );
+
+  // 深さ 6 までは到達しない．
+  EXPECT_EQ( kB3X, bmc.bmc(bad, 6) );
+  EXPECT_EQ( 7U, bmc.depth() );
+
+  EXPECT_EQ( kB3False, bmc.bmc(bad, 10) );
+  EXPECT_EQ( 7U, bmc.depth() );
+  check_cex(bmc);
+}
+
+TEST(BdnBmcTest, bmc_safe)
+{
+  BdnMgr network;
+  const BdnNode* bad = make_counter(network, 5);
+  BdnBmc bmc(network);
+
+  EXPECT_EQ( kB3X, bmc.bmc(bad, 12) );
+  EXPECT_EQ( 13U, bmc.depth() );
+}
+
+TEST(BdnBmcTest, prove_unsafe)
+{
+  BdnMgr network;
+  const BdnNode* bad = make_counter(network, 0);
+  BdnBmc bmc(network);
+
+  EXPECT_EQ( kB3False, bmc.prove(bad, 20) );
+  EXPECT_EQ( 7U, bmc.depth() );
+  check_cex(bmc);
+}
+
+TEST(BdnBmcTest, prove_safe)
+{
+  BdnMgr network;
+  const BdnNode* bad = make_counter(network, 5);
+  BdnBmc bmc(network);
+
+  EXPECT_EQ( kB3True, bmc.prove(bad, 20) );
+  EXPECT_EQ( 2U, bmc.depth() );
+  EXPECT_EQ( 0U, bmc.cex_frame_num() );
+}
+
+TEST(BdnBmcTest, prove_init_x)
+{
+  // 初期状態が任意なら bad は深さ 0 で到達できる．
+  BdnMgr network;
+  const BdnNode* bad = make_counter(network, 5);
+  BdnBmc bmc(network);
+  for (ymuint i = 0; i < kBitNum; ++ i) {
+    bmc.set_init(i, kB3X);
+  }
+
+  EXPECT_EQ( kB3False, bmc.prove(bad, 20) );
+  EXPECT_EQ( 0U, bmc.depth() );
+  check_cex(bmc);
+}
+
+TEST(BdnBmcTest, prove_mt_unsafe)
+{
+  BdnMgr network;
+  const BdnNode* bad = make_counter(network, 0);
+  for (ymuint i = 0; i < 10; ++ i) {
+    BdnBmc bmc(network);
+    EXPECT_EQ( kB3False, bmc.prove(bad, 20, 2) );
+    EXPECT_EQ( 7U, bmc.depth() );
+    check_cex(bmc);
+  }
+}
+
+TEST(BdnBmcTest, prove_mt_safe)
+{
+  BdnMgr network;
+  const BdnNode* bad = make_counter(network, 5);
+  for (ymuint i = 0; i < 10; ++ i) {
+    BdnBmc bmc(network);
+    EXPECT_EQ( kB3True, bmc.prove(bad, 20, 2) );
+    EXPECT_EQ( 2U, bmc.depth() );
+  }
+}
+
+TEST(BdnBmcTest, reuse_after_prove_mt)
+{
+  // prove_mt() で中断された SAT ソルバを続けて使っても
+  // 正しい結果が得られる．
+  BdnMgr network;
+  const BdnNode* bad = make_counter(network, 5);
+  for (ymuint i = 0; i < 10; ++ i) {
+    BdnBmc bmc(network);
+    EXPECT_EQ( kB3True, bmc.prove(bad, 20, 2) );
+    EXPECT_EQ( kB3True, bmc.prove(bad, 20) );
+    EXPECT_EQ( 2U, bmc.depth() );
+    EXPECT_EQ( kB3X, bmc.bmc(bad, 12) );
+    EXPECT_EQ( 13U, bmc.depth() );
+    EXPECT_EQ( kB3True, bmc.prove(bad, 20, 2) );
+  }
+}
+
+TEST(BdnBmcTest, reuse_after_prove_mt_minisat)
+{
+  // MiniSat 系の中止要求は取り消すまで残っている．
+  const char* sat_type_list[] = { "minisat2", "glueminisat2" };
+  BdnMgr network;
+  const BdnNode* bad = make_counter(network, 5);
+  for (ymuint j = 0; j < 2; ++ j) {
+    for (ymuint i = 0; i < 5; ++ i) {
+      BdnBmc bmc(network, sat_type_list[j]);
+      EXPECT_EQ( kB3True, bmc.prove(bad, 20, 2) ) << sat_type_list[j];
+      EXPECT_EQ( kB3True, bmc.prove(bad, 20) ) << sat_type_list[j];
+      EXPECT_EQ( 2U, bmc.depth() ) << sat_type_list[j];
+      EXPECT_EQ( kB3X, bmc.bmc(bad, 12) ) << sat_type_list[j];
+      EXPECT_EQ( 13U, bmc.depth() ) << sat_type_list[j];
+    }
+  }
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
@@ -0,0 +1,211 @@
+﻿
+/// @file BdnFlatGraphTest.cc
+/// @brief BdnFlatGraphTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnPort.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnNodeHandle.h"
+#include "YmNetworks/BdnFlatGraph.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+// 簡単な擬似乱数
+ymuint64
+next_rand(ymuint64& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// ランダムなネットワークを作る．
+// 定数に接続した出力も1つ作る．
+void
+make_network(BdnMgr& network,
+	     ymuint input_num,
+	     ymuint gate_num,
+	     ymuint output_num,
+	     ymuint64 seed)
+{
+  BdnPort* i_port = network.new_input_port("i", input_num);
+  BdnPort* o_port = network.new_output_port("o", output_num + 1);
+  vector<BdnNodeHandle> pool;
+  for (ymuint i = 0; i < input_num; ++ i) {
+    pool.push_back(BdnNodeHandle(i_port->_input(i), false));
+  }
+  for (ymuint i = 0; i < gate_num; ++ i) {
+    BdnNodeHandle h0 = pool[next_rand(seed) % pool.size()];
+    BdnNodeHandle h1 = pool[next_rand(seed) % pool.size()];
+    if ( next_rand(seed) & 1ULL ) {
+      h0 = ~h0;
+    }
+    BdnNodeHandle h = (next_rand(seed) % 3) ? network.new_and(h0, h1) :
+      network.new_xor(h0, h1);
+    pool.push_back(h);
+  }
+  for (ymuint i = 0; i < output_num; ++ i) {
+    BdnNodeHandle h = pool[pool.size() - 1 - (next_rand(seed) % (gate_num / 2))];
+    network.change_output_fanin(o_port->_output(i), h);
+  }
+  network.change_output_fanin(o_port->_output(output_num), BdnNodeHandle::make_one());
+}
+
+// 元のノードのファンインに対応するリテラルを作る．
+ymuint32
+orig_lit(const BdnFlatGraph& graph,
+	 const BdnNode* inode,
+	 bool inv)
+{
+  ymuint32 id = (inode != nullptr) ? graph.node_id(inode) : 0U;
+  return BdnFlatGraph::make_lit(id, inv);
+}
+
+// 段数を計算する．
+ymuint
+calc_level(const BdnFlatGraph& graph,
+	   ymuint id)
+{
+  if ( graph.type(id) != BdnFlatGraph::kAnd && graph.type(id) != BdnFlatGraph::kXor ) {
+    return 0;
+  }
+  ymuint l0 = graph.level(BdnFlatGraph::lit_id(graph.fanin0(id)));
+  ymuint l1 = graph.level(BdnFlatGraph::lit_id(graph.fanin1(id)));
+  return (l0 > l1 ? l0 : l1) + 1;
+}
+
+END_NONAMESPACE
+
+
+TEST(BdnFlatGraphTest, empty)
+{
+  BdnFlatGraph graph;
+
+  EXPECT_EQ( 1U, graph.node_num() );
+  EXPECT_EQ( 0U, graph.input_num() );
+  EXPECT_EQ( 0U, graph.lnode_num() );
+  EXPECT_EQ( 0U, graph.output_num() );
+  EXPECT_EQ( static_cast<ymuint>(BdnFlatGraph::kConst), graph.type(0) );
+  EXPECT_EQ( 0U, graph.fanout_num(0) );
+}
+
+TEST(BdnFlatGraphTest, literal)
+{
+  EXPECT_EQ( 10U, BdnFlatGraph::make_lit(5) );
+  EXPECT_EQ( 11U, BdnFlatGraph::make_lit(5, true) );
+  EXPECT_EQ( 5U, BdnFlatGraph::lit_id(11U) );
+  EXPECT_TRUE( BdnFlatGraph::lit_inv(11U) );
+  EXPECT_FALSE( BdnFlatGraph::lit_inv(10U) );
+}
+
+TEST(BdnFlatGraphTest, structure)
+{
+  BdnMgr network;
+  make_network(network, 16, 500, 10, 0x123456789abcdefULL);
+
+  BdnFlatGraph graph(network);
+  ymuint ni = network.input_num();
+  ymuint nl = network.lnode_num();
+  ymuint no = network.output_num();
+  ASSERT_EQ( ni, graph.input_num() );
+  ASSERT_EQ( nl, graph.lnode_num() );
+  ASSERT_EQ( no, graph.output_num() );
+  ASSERT_EQ( 1 + ni + nl + no, graph.node_num() );
+
+  ymuint max_level = 0;
+  for (ymuint id = 0; id < graph.node_num(); ++ id) {
+    ymuint type = graph.type(id);
+    if ( id == 0 ) {
+      EXPECT_EQ( static_cast<ymuint>(BdnFlatGraph::kConst), type );
+      EXPECT_EQ( nullptr, graph.orig_node(id) );
+      continue;
+    }
+    const BdnNode* node = graph.orig_node(id);
+    ASSERT_TRUE( node != nullptr );
+    EXPECT_EQ( id, graph.node_id(node) );
+    if ( id <= ni ) {
+      EXPECT_EQ( static_cast<ymuint>(BdnFlatGraph::kInput), type );
+      EXPECT_TRUE( node->is_input() );
+    }
+    else if ( id <= ni + nl ) {
+      EXPECT_TRUE( node->is_logic() );
+      ymuint exp_type = node->is_xor() ? BdnFlatGraph::kXor : BdnFlatGraph::kAnd;
+      EXPECT_EQ( exp_type, type );
+      EXPECT_EQ( orig_lit(graph, node->fanin0(), node->fanin0_inv()), graph.fanin0(id) );
+      EXPECT_EQ( orig_lit(graph, node->fanin1(), node->fanin1_inv()), graph.fanin1(id) );
+      // ファンインは必ず前にある．
+      EXPECT_LT( BdnFlatGraph::lit_id(graph.fanin0(id)), id );
+      EXPECT_LT( BdnFlatGraph::lit_id(graph.fanin1(id)), id );
+      EXPECT_EQ( calc_level(graph, id), graph.level(id) );
+      if ( max_level < graph.level(id) ) {
+	max_level = graph.level(id);
+      }
+    }
+    else {
+      EXPECT_EQ( static_cast<ymuint>(BdnFlatGraph::kOutput), type );
+      EXPECT_TRUE( node->is_output() );
+      EXPECT_EQ( orig_lit(graph, node->output_fanin(), node->output_fanin_inv()),
+		 graph.fanin0(id) );
+    }
+  }
+  EXPECT_EQ( max_level, graph.max_level() );
+
+  // 定数1 に接続した出力
+  EXPECT_EQ( 1U, graph.fanin0(graph.node_num() - 1) );
+
+  // 配列版の関数も同じ内容を返す．
+  for (ymuint id = 0; id < graph.node_num(); ++ id) {
+    EXPECT_EQ( graph.type(id), static_cast<ymuint>(graph.type_array()[id]) );
+    EXPECT_EQ( graph.fanin0(id), graph.fanin0_array()[id] );
+    EXPECT_EQ( graph.fanin1(id), graph.fanin1_array()[id] );
+    EXPECT_EQ( graph.level(id), graph.level_array()[id] );
+  }
+}
+
+TEST(BdnFlatGraphTest, fanout)
+{
+  BdnMgr network;
+  make_network(network, 12, 300, 8, 0xfedcba987654321ULL);
+
+  BdnFlatGraph graph(network);
+
+  // ファンアウトを数え直す．
+  vector<ymuint> count(graph.node_num(), 0);
+  for (ymuint id = 0; id < graph.node_num(); ++ id) {
+    ymuint type = graph.type(id);
+    if ( type == BdnFlatGraph::kAnd || type == BdnFlatGraph::kXor ) {
+      ++ count[BdnFlatGraph::lit_id(graph.fanin0(id))];
+      ++ count[BdnFlatGraph::lit_id(graph.fanin1(id))];
+    }
+    else if ( type == BdnFlatGraph::kOutput ) {
+      ++ count[BdnFlatGraph::lit_id(graph.fanin0(id))];
+    }
+  }
+
+  for (ymuint id = 0; id < graph.node_num(); ++ id) {
+    ASSERT_EQ( count[id], graph.fanout_num(id) );
+    ASSERT_EQ( count[id], static_cast<ymuint>(graph.fanout_end(id) - graph.fanout_begin(id)) );
+    for (const ymuint32* p = graph.fanout_begin(id); p != graph.fanout_end(id); ++ p) {
+      ymuint oid = *p >> 1;
+      ymuint ipos = *p & 1U;
+      ymuint32 flit = (ipos == 0) ? graph.fanin0(oid) : graph.fanin1(oid);
+      EXPECT_EQ( id, BdnFlatGraph::lit_id(flit) );
+    }
+    if ( id > 0 && id <= graph.input_num() + graph.lnode_num() ) {
+      // 元のノードとファンアウト数が一致する．
+      EXPECT_EQ( graph.orig_node(id)->fanout_num(), graph.fanout_num(id) );
+    }
+  }
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
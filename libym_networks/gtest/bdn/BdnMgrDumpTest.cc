@@ -0,0 +1,360 @@
+﻿
+/// @file BdnMgrDumpTest.cc
+/// @brief BdnMgrDumpTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnPort.h"
+#include "YmNetworks/BdnDff.h"
+#include "YmNetworks/BdnLatch.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnNodeHandle.h"
+#include "YmUtils/StreamIDO.h"
+#include "YmUtils/StreamODO.h"
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+// 簡単な擬似乱数
+ymuint64
+next_rand(ymuint64& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// D-FF とラッチと双方向ポートを含むランダムなネットワークを作る．
+// 途中で clean_up() を呼んで ID 番号に隙間を作る．
+// 定数0 と定数1 に接続した出力も作る．
+void
+make_network(BdnMgr& network,
+	     ymuint64 seed)
+{
+  network.set_name("dump_test");
+  BdnPort* i_port = network.new_input_port("i", 8);
+  BdnPort* o_port = network.new_output_port("o", 6);
+  vector<ymuint> iovect(4);
+  iovect[0] = 1;
+  iovect[1] = 2;
+  iovect[2] = 3;
+  iovect[3] = 0;
+  BdnPort* io_port = network.new_port("io", iovect);
+  BdnDff* dff_list[3];
+  dff_list[0] = network.new_dff("ff0");
+  dff_list[1] = network.new_dff("ff1");
+  dff_list[2] = network.new_dff("ff2");
+  BdnLatch* latch_list[2];
+  latch_list[0] = network.new_latch("l0");
+  latch_list[1] = network.new_latch("l1");
+
+  vector<BdnNodeHandle> pool;
+  for (ymuint i = 0; i < 8; ++ i) {
+    pool.push_back(BdnNodeHandle(i_port->_input(i), false));
+  }
+  pool.push_back(BdnNodeHandle(io_port->_input(0), false));
+  pool.push_back(BdnNodeHandle(io_port->_input(2), false));
+  for (ymuint i = 0; i < 3; ++ i) {
+    pool.push_back(BdnNodeHandle(dff_list[i]->_output(), false));
+  }
+  for (ymuint i = 0; i < 2; ++ i) {
+    pool.push_back(BdnNodeHandle(latch_list[i]->_output(), false));
+  }
+
+  // どこからも使われないノードも混ぜておく．
+  for (ymuint i = 0; i < 200; ++ i) {
+    BdnNodeHandle h0 = pool[next_rand(seed) % pool.size()];
+    BdnNodeHandle h1 = pool[next_rand(seed) % pool.size()];
+    if ( next_rand(seed) & 1ULL ) {
+      h0 = ~h0;
+    }
+    BdnNodeHandle h = (next_rand(seed) % 3) ? network.new_and(h0, h1) :
+      network.new_xor(h0, h1);
+    if ( next_rand(seed) % 4 ) {
+      pool.push_back(h);
+    }
+  }
+
+  vector<BdnNode*> onode_list;
+  for (ymuint i = 0; i < 4; ++ i) {
+    onode_list.push_back(o_port->_output(i));
+  }
+  onode_list.push_back(io_port->_output(1));
+  onode_list.push_back(io_port->_output(2));
+  for (ymuint i = 0; i < 3; ++ i) {
+    onode_list.push_back(dff_list[i]->_input());
+    onode_list.push_back(dff_list[i]->_clock());
+  }
+  onode_list.push_back(dff_list[0]->_clear());
+  onode_list.push_back(dff_list[2]->_preset());
+  for (ymuint i = 0; i < 2; ++ i) {
+    onode_list.push_back(latch_list[i]->_input());
+    onode_list.push_back(latch_list[i]->_enable());
+  }
+  for (ymuint i = 0; i < onode_list.size(); ++ i) {
+    BdnNodeHandle h = pool[pool.size() - 1 - (next_rand(seed) % 100)];
+    if ( next_rand(seed) & 1ULL ) {
+      h = ~h;
+    }
+    network.change_output_fanin(onode_list[i], h);
+  }
+  network.change_output_fanin(o_port->_output(4), BdnNodeHandle::make_zero());
+  network.change_output_fanin(o_port->_output(5), BdnNodeHandle::make_one());
+
+  network.clean_up();
+}
+
+// ハンドルの内容を ID 番号と極性の組で表す．
+ymuint
+handle_code(const BdnNode* node,
+	    bool inv)
+{
+  ymuint id = (node != nullptr) ? node->id() + 1 : 0U;
+  return (id << 1) | (inv ? 1U : 0U);
+}
+
+// ノードの ID 番号を返す．
+// nullptr の場合は -1 を返す．
+int
+node_id(const BdnNode* node)
+{
+  return (node != nullptr) ? static_cast<int>(node->id()) : -1;
+}
+
+// 二つのネットワークの構造が ID 番号まで含めて等しいか調べる．
+void
+check_same(const BdnMgr& src,
+	   const BdnMgr& dst)
+{
+  EXPECT_EQ( src.name(), dst.name() );
+  ASSERT_EQ( src.port_num(), dst.port_num() );
+  ASSERT_EQ( src.dff_num(), dst.dff_num() );
+  ASSERT_EQ( src.latch_num(), dst.latch_num() );
+  ASSERT_EQ( src.input_num(), dst.input_num() );
+  ASSERT_EQ( src.output_num(), dst.output_num() );
+  ASSERT_EQ( src.lnode_num(), dst.lnode_num() );
+
+  for (ymuint i = 0; i < src.port_num(); ++ i) {
+    const BdnPort* src_port = src.port(i);
+    const BdnPort* dst_port = dst.port(i);
+    EXPECT_EQ( src_port->name(), dst_port->name() );
+    ASSERT_EQ( src_port->bit_width(), dst_port->bit_width() );
+    for (ymuint j = 0; j < src_port->bit_width(); ++ j) {
+      EXPECT_EQ( node_id(src_port->input(j)), node_id(dst_port->input(j)) );
+      EXPECT_EQ( node_id(src_port->output(j)), node_id(dst_port->output(j)) );
+    }
+  }
+
+  const BdnDffList& src_dff_list = src.dff_list();
+  const BdnDffList& dst_dff_list = dst.dff_list();
+  BdnDffList::const_iterator q = dst_dff_list.begin();
+  for (BdnDffList::const_iterator p = src_dff_list.begin();
+       p != src_dff_list.end(); ++ p, ++ q) {
+    const BdnDff* src_dff = *p;
+    const BdnDff* dst_dff = *q;
+    EXPECT_EQ( src_dff->name(), dst_dff->name() );
+    EXPECT_EQ( node_id(src_dff->output()), node_id(dst_dff->output()) );
+    EXPECT_EQ( node_id(src_dff->input()), node_id(dst_dff->input()) );
+    EXPECT_EQ( node_id(src_dff->clock()), node_id(dst_dff->clock()) );
+    EXPECT_EQ( node_id(src_dff->clear()), node_id(dst_dff->clear()) );
+    EXPECT_EQ( node_id(src_dff->preset()), node_id(dst_dff->preset()) );
+  }
+
+  const BdnLatchList& src_latch_list = src.latch_list();
+  const BdnLatchList& dst_latch_list = dst.latch_list();
+  BdnLatchList::const_iterator r = dst_latch_list.begin();
+  for (BdnLatchList::const_iterator p = src_latch_list.begin();
+       p != src_latch_list.end(); ++ p, ++ r) {
+    const BdnLatch* src_latch = *p;
+    const BdnLatch* dst_latch = *r;
+    EXPECT_EQ( src_latch->name(), dst_latch->name() );
+    EXPECT_EQ( node_id(src_latch->output()), node_id(dst_latch->output()) );
+    EXPECT_EQ( node_id(src_latch->input()), node_id(dst_latch->input()) );
+    EXPECT_EQ( node_id(src_latch->enable()), node_id(dst_latch->enable()) );
+    EXPECT_EQ( node_id(src_latch->clear()), node_id(dst_latch->clear()) );
+    EXPECT_EQ( node_id(src_latch->preset()), node_id(dst_latch->preset()) );
+  }
+
+  const BdnNodeList& lnode_list = src.lnode_list();
+  for (BdnNodeList::const_iterator p = lnode_list.begin();
+       p != lnode_list.end(); ++ p) {
+    const BdnNode* src_node = *p;
+    ASSERT_LT( src_node->id(), dst.max_node_id() );
+    const BdnNode* dst_node = dst.node(src_node->id());
+    ASSERT_TRUE( dst_node != nullptr );
+    ASSERT_TRUE( dst_node->is_logic() );
+    EXPECT_EQ( src_node->is_xor(), dst_node->is_xor() );
+    EXPECT_EQ( handle_code(src_node->fanin0(), src_node->fanin0_inv()),
+	       handle_code(dst_node->fanin0(), dst_node->fanin0_inv()) );
+    EXPECT_EQ( handle_code(src_node->fanin1(), src_node->fanin1_inv()),
+	       handle_code(dst_node->fanin1(), dst_node->fanin1_inv()) );
+    EXPECT_EQ( src_node->fanout_num(), dst_node->fanout_num() );
+  }
+
+  const BdnNodeList& output_list = src.output_list();
+  for (BdnNodeList::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    const BdnNode* src_node = *p;
+    ASSERT_LT( src_node->id(), dst.max_node_id() );
+    const BdnNode* dst_node = dst.node(src_node->id());
+    ASSERT_TRUE( dst_node != nullptr );
+    ASSERT_TRUE( dst_node->is_output() );
+    EXPECT_EQ( handle_code(src_node->output_fanin(), src_node->output_fanin_inv()),
+	       handle_code(dst_node->output_fanin(), dst_node->output_fanin_inv()) );
+  }
+}
+
+// ダンプした内容を返す．
+string
+dump_network(const BdnMgr& network)
+{
+  ostringstream buf;
+  {
+    StreamODO odo(buf);
+    network.dump(odo);
+  }
+  return buf.str();
+}
+
+// 文字列から読み込む．
+bool
+restore_network(BdnMgr& network,
+		const string& data)
+{
+  istringstream buf(data);
+  StreamIDO ido(buf);
+  return network.restore(ido);
+}
+
+// ダンプした内容のうち名前の部分の大きさを返す．
+// 名前は 64ビットの長さに続けて文字列が書かれる．
+ymuint
+header_size(const BdnMgr& network)
+{
+  ymuint size = 8 + network.name().size() + 4 * 4;
+  for (ymuint i = 0; i < network.port_num(); ++ i) {
+    size += 8 + network.port(i)->name().size();
+  }
+  const BdnDffList& dff_list = network.dff_list();
+  for (BdnDffList::const_iterator p = dff_list.begin();
+       p != dff_list.end(); ++ p) {
+    size += 8 + (*p)->name().size();
+  }
+  const BdnLatchList& latch_list = network.latch_list();
+  for (BdnLatchList::const_iterator p = latch_list.begin();
+       p != latch_list.end(); ++ p) {
+    size += 8 + (*p)->name().size();
+  }
+  return size;
+}
+
+END_NONAMESPACE
+
+
+TEST(BdnMgrDumpTest, round_trip)
+{
+  BdnMgr network;
+  make_network(network, 0x123456789abcdefULL);
+  // clean_up() で ID 番号に隙間ができていることを確かめておく．
+  ymuint n = network.input_num() + network.output_num() + network.lnode_num();
+  ASSERT_LT( n, network.max_node_id() );
+
+  string data = dump_network(network);
+
+  BdnMgr network2;
+  make_network(network2, 0xfedcba987654321ULL);
+  ASSERT_TRUE( restore_network(network2, data) );
+  check_same(network, network2);
+
+  // 読み込んだネットワークは普通に変更できる．
+  // 構造ハッシュも作り直されている．
+  BdnNodeHandle h0(network2.input_list().front(), false);
+  BdnNodeHandle h1(network2.input_list().back(), true);
+  BdnNodeHandle h = network2.new_and(h0, h1);
+  EXPECT_EQ( h, network2.new_and(h1, h0) );
+  EXPECT_EQ( h, network2.find_and(h0, h1) );
+
+  // もう一度ダンプしても同じ構造になる．
+  BdnMgr network3;
+  ASSERT_TRUE( restore_network(network3, dump_network(network2)) );
+  check_same(network2, network3);
+}
+
+TEST(BdnMgrDumpTest, empty)
+{
+  BdnMgr network;
+  BdnMgr network2;
+  make_network(network2, 0x123456789abcdefULL);
+  ASSERT_TRUE( restore_network(network2, dump_network(network)) );
+  check_same(network, network2);
+  EXPECT_EQ( 0U, network2.lnode_num() );
+}
+
+TEST(BdnMgrDumpTest, truncated)
+{
+  BdnMgr network;
+  make_network(network, 0x123456789abcdefULL);
+  string data = dump_network(network);
+  ymuint hsize = header_size(network);
+  ASSERT_LT( hsize, data.size() );
+
+  // 元のネットワークと比べるために同じものを二つ作っておく．
+  // コピーコンストラクタは ID 番号を保存しないので使えない．
+  BdnMgr orig;
+  make_network(orig, 0x0f1e2d3c4b5a6978ULL);
+  BdnMgr network2;
+  make_network(network2, 0x0f1e2d3c4b5a6978ULL);
+  for (ymuint size = hsize; size < data.size(); ++ size) {
+    EXPECT_FALSE( restore_network(network2, data.substr(0, size)) ) << "size = " << size;
+  }
+  // 失敗した場合は元の内容が残る．
+  check_same(orig, network2);
+}
+
+TEST(BdnMgrDumpTest, corrupt)
+{
+  BdnMgr network;
+  make_network(network, 0x123456789abcdefULL);
+  string data = dump_network(network);
+  ymuint hsize = header_size(network);
+
+  // 最後の出力のファンインを存在しないノードにする．
+  {
+    string data2 = data;
+    for (ymuint i = 0; i < 4; ++ i) {
+      data2[data2.size() - 1 - i] = static_cast<char>(0x7f);
+    }
+    BdnMgr network2;
+    make_network(network2, 0x123456789abcdefULL);
+    EXPECT_FALSE( restore_network(network2, data2) );
+    check_same(network, network2);
+  }
+
+  // ブロックの部分のバイトを一つずつ壊しても異常終了しない．
+  // 読み込みに失敗した場合は元の内容が残る．
+  BdnMgr orig;
+  make_network(orig, 0x0f1e2d3c4b5a6978ULL);
+  ymuint nfail = 0;
+  for (ymuint pos = hsize; pos < data.size(); ++ pos) {
+    string data2 = data;
+    data2[pos] ^= static_cast<char>(0xa5);
+    BdnMgr network2;
+    make_network(network2, 0x0f1e2d3c4b5a6978ULL);
+    if ( !restore_network(network2, data2) ) {
+      check_same(orig, network2);
+      ++ nfail;
+    }
+  }
+  EXPECT_LT( 0U, nfail );
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
@@ -0,0 +1,81 @@
+﻿
+/// @file BdnMgrTest.cc
+/// @brief BdnMgrTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnPort.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnNodeHandle.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+// 鎖の長さ
+// 再帰的に削除するとスタックがあふれる程度の長さにしておく．
+const ymuint kChainLen = 50000;
+
+// 入力数
+// ファンアウト数が大きくなりすぎないように鎖の各段の入力を散らす．
+const ymuint kInputNum = 1024;
+
+// 入力 0 から始まる長い鎖を作る．
+// 鎖の各段は入力 0 以外の入力との AND か XOR になっている．
+BdnNodeHandle
+make_chain(BdnMgr& network,
+	   BdnPort* i_port)
+{
+  BdnNodeHandle h(i_port->_input(0), false);
+  for (ymuint i = 0; i < kChainLen; ++ i) {
+    BdnNodeHandle h1(i_port->_input(1 + (i % (kInputNum - 1))), (i % 3) == 0);
+    h = (i % 5) ? network.new_and(h, h1) : network.new_xor(h, h1);
+  }
+  return h;
+}
+
+END_NONAMESPACE
+
+
+TEST(BdnMgrTest, clean_up_long_chain)
+{
+  BdnMgr network;
+  BdnPort* i_port = network.new_input_port("i", kInputNum);
+  BdnPort* o_port = network.new_output_port("o", 1);
+  BdnNodeHandle h = make_chain(network, i_port);
+  network.change_output_fanin(o_port->_output(0), h);
+  ASSERT_EQ( kChainLen, network.lnode_num() );
+
+  // 出力を付け替えると鎖全体がファンアウトを失う．
+  network.change_output_fanin(o_port->_output(0),
+			      BdnNodeHandle(i_port->_input(0), false));
+  network.clean_up();
+  EXPECT_EQ( 0U, network.lnode_num() );
+}
+
+TEST(BdnMgrTest, replace_logic_long_chain)
+{
+  BdnMgr network;
+  BdnPort* i_port = network.new_input_port("i", kInputNum);
+  BdnPort* o_port = network.new_output_port("o", 1);
+  BdnNodeHandle h = make_chain(network, i_port);
+  BdnNodeHandle top = network.new_and(h, BdnNodeHandle(i_port->_input(1), false));
+  network.change_output_fanin(o_port->_output(0), top);
+  ASSERT_EQ( kChainLen + 1, network.lnode_num() );
+
+  // 鎖の先頭を入力で置き換えると鎖全体が削除される．
+  vector<ymuint> deleted_list;
+  network.replace_logic(h.node(), BdnNodeHandle(i_port->_input(0), false),
+			deleted_list);
+  EXPECT_EQ( kChainLen, deleted_list.size() );
+  EXPECT_EQ( 1U, network.lnode_num() );
+  EXPECT_EQ( i_port->_input(0), top.node()->fanin0() );
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
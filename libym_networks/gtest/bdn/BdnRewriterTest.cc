@@ -0,0 +1,244 @@
+﻿
+/// @file BdnRewriterTest.cc
+/// @brief BdnRewriterTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnPort.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnNodeHandle.h"
+#include "YmNetworks/BdnConstNodeHandle.h"
+#include "YmNetworks/BdnRewriter.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+// 入力数
+// 全パタンをシミュレーションするので 2^kInputNum / 64 ワードを用いる．
+const ymuint kInputNum = 10;
+const ymuint kWordNum = (1U << kInputNum) / 64;
+
+// 簡単な擬似乱数
+ymuint64
+next_rand(ymuint64& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// ハンドルの値を返す．
+// 定数に接続しているファンインはノードが nullptr で極性だけを持つ．
+ymuint64
+handle_val(BdnConstNodeHandle handle,
+	   const vector<ymuint64>& val_array,
+	   ymuint w)
+{
+  if ( handle.is_zero() ) {
+    return 0ULL;
+  }
+  if ( handle.is_one() ) {
+    return ~0ULL;
+  }
+  const BdnNode* node = handle.node();
+  if ( node == nullptr ) {
+    return handle.inv() ? ~0ULL : 0ULL;
+  }
+  ymuint64 val = val_array[node->id() * kWordNum + w];
+  if ( handle.inv() ) {
+    val = ~val;
+  }
+  return val;
+}
+
+// 全パタンでシミュレーションして出力の値を得る．
+// 結果は出力番号 x kWordNum + ワード番号 の位置に格納される．
+void
+simulate(const BdnMgr& network,
+	 vector<ymuint64>& output_vals)
+{
+  vector<ymuint64> val_array(network.max_node_id() * kWordNum, 0ULL);
+
+  const BdnNodeList& input_list = network.input_list();
+  ymuint ipos = 0;
+  for (BdnNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p, ++ ipos) {
+    ymuint id = (*p)->id();
+    for (ymuint w = 0; w < kWordNum; ++ w) {
+      ymuint64 val = 0ULL;
+      for (ymuint b = 0; b < 64; ++ b) {
+	ymuint pat = w * 64 + b;
+	if ( (pat >> ipos) & 1U ) {
+	  val |= (1ULL << b);
+	}
+      }
+      val_array[id * kWordNum + w] = val;
+    }
+  }
+
+  vector<const BdnNode*> node_list;
+  network.sort(node_list);
+  for (vector<const BdnNode*>::iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    const BdnNode* node = *p;
+    for (ymuint w = 0; w < kWordNum; ++ w) {
+      ymuint64 val0 = handle_val(node->fanin_handle(0), val_array, w);
+      ymuint64 val1 = handle_val(node->fanin_handle(1), val_array, w);
+      val_array[node->id() * kWordNum + w] = node->is_xor() ? val0 ^ val1 : val0 & val1;
+    }
+  }
+
+  const BdnNodeList& output_list = network.output_list();
+  output_vals.clear();
+  output_vals.reserve(output_list.size() * kWordNum);
+  for (BdnNodeList::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    const BdnNode* onode = *p;
+    for (ymuint w = 0; w < kWordNum; ++ w) {
+      output_vals.push_back(handle_val(onode->output_fanin_handle(), val_array, w));
+    }
+  }
+}
+
+// ランダムなネットワークを作る．
+void
+make_random_network(BdnMgr& network,
+		    ymuint gate_num,
+		    ymuint output_num,
+		    ymuint64 seed)
+{
+  BdnPort* i_port = network.new_input_port("i", kInputNum);
+  BdnPort* o_port = network.new_output_port("o", output_num);
+  vector<BdnNodeHandle> pool;
+  for (ymuint i = 0; i < kInputNum; ++ i) {
+    pool.push_back(BdnNodeHandle(i_port->_input(i), false));
+  }
+  for (ymuint i = 0; i < gate_num; ++ i) {
+    // 最近作られたノードを選びやすくして段数を稼ぐ．
+    ymuint n = pool.size();
+    ymuint r = next_rand(seed) % 8;
+    ymuint pos0 = (r < 4) ? n - 1 - (next_rand(seed) % (n < 8 ? n : 8)) :
+      next_rand(seed) % n;
+    ymuint pos1 = next_rand(seed) % n;
+    BdnNodeHandle h0 = pool[pos0];
+    BdnNodeHandle h1 = pool[pos1];
+    if ( next_rand(seed) & 1ULL ) {
+      h0 = ~h0;
+    }
+    if ( next_rand(seed) & 1ULL ) {
+      h1 = ~h1;
+    }
+    BdnNodeHandle h;
+    switch ( next_rand(seed) % 3 ) {
+    case 0: h = network.new_and(h0, h1); break;
+    case 1: h = network.new_or(h0, h1); break;
+    case 2: h = network.new_xor(h0, h1); break;
+    }
+    pool.push_back(h);
+  }
+  for (ymuint i = 0; i < output_num; ++ i) {
+    BdnNodeHandle h = pool[pool.size() - 1 - (next_rand(seed) % (gate_num / 2))];
+    network.change_output_fanin(o_port->_output(i), h);
+  }
+}
+
+// 全加算器を作る．
+void
+make_full_adder(BdnMgr& network,
+		BdnNodeHandle a,
+		BdnNodeHandle b,
+		BdnNodeHandle c,
+		BdnNodeHandle& s,
+		BdnNodeHandle& co)
+{
+  s = network.new_xor(network.new_xor(a, b), c);
+  // 多数決関数を冗長な形で作っておく．
+  co = network.new_or(network.new_or(network.new_and(a, b),
+				     network.new_and(a, c)),
+		      network.new_and(b, c));
+}
+
+// 書き換えの前後で出力の関数が等しいことを確かめる．
+// 置き換えの回数を count に加える．
+void
+check_rewrite(BdnMgr& network,
+	      bool use_zero,
+	      ymuint& count)
+{
+  vector<ymuint64> vals0;
+  simulate(network, vals0);
+  ymuint lnode_num0 = network.lnode_num();
+
+  BdnRewriter rewriter;
+  count += rewriter(network, use_zero);
+
+  vector<ymuint64> vals1;
+  simulate(network, vals1);
+  ASSERT_EQ( vals0.size(), vals1.size() );
+  for (ymuint i = 0; i < vals0.size(); ++ i) {
+    EXPECT_EQ( vals0[i], vals1[i] ) << "output#" << (i / kWordNum)
+				    << ", word#" << (i % kWordNum);
+  }
+  EXPECT_LE( network.lnode_num(), lnode_num0 );
+}
+
+END_NONAMESPACE
+
+
+TEST(BdnRewriterTest, random)
+{
+  ymuint count = 0;
+  for (ymuint i = 0; i < 20; ++ i) {
+    BdnMgr network;
+    make_random_network(network, 200, 8, 0x9e3779b97f4a7c15ULL + i * 7919);
+    check_rewrite(network, false, count);
+  }
+  EXPECT_LT( 0U, count );
+}
+
+TEST(BdnRewriterTest, random_zero)
+{
+  ymuint count = 0;
+  for (ymuint i = 0; i < 20; ++ i) {
+    BdnMgr network;
+    make_random_network(network, 200, 8, 0x2545f4914f6cdd1dULL + i * 7919);
+    check_rewrite(network, true, count);
+  }
+  EXPECT_LT( 0U, count );
+}
+
+TEST(BdnRewriterTest, adder)
+{
+  // 5ビットの加算器
+  const ymuint n = kInputNum / 2;
+  BdnMgr network;
+  BdnPort* a_port = network.new_input_port("a", n);
+  BdnPort* b_port = network.new_input_port("b", n);
+  BdnPort* s_port = network.new_output_port("s", n + 1);
+  BdnNodeHandle c = BdnNodeHandle::make_zero();
+  for (ymuint i = 0; i < n; ++ i) {
+    BdnNodeHandle a(a_port->_input(i), false);
+    BdnNodeHandle b(b_port->_input(i), false);
+    BdnNodeHandle s;
+    make_full_adder(network, a, b, c, s, c);
+    network.change_output_fanin(s_port->_output(i), s);
+  }
+  network.change_output_fanin(s_port->_output(n), c);
+
+  ymuint lnode_num0 = network.lnode_num();
+  ymuint count = 0;
+  check_rewrite(network, false, count);
+  EXPECT_LT( 0U, count );
+  // 冗長な多数決関数は必ず小さくなる．
+  EXPECT_LT( network.lnode_num(), lnode_num0 );
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
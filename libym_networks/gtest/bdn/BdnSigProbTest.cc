@@ -0,0 +1,423 @@
+﻿
+/// @file BdnSigProbTest.cc
+/// @brief BdnSigProbTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnPort.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnNodeHandle.h"
+#include "YmNetworks/BdnSigProb.h"
+#include <cmath>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+// 入力数
+// 全パタンを列挙するので 2^kInputNum / 64 ワードを用いる．
+const ymuint kInputNum = 8;
+const ymuint kPatNum = 1U << kInputNum;
+const ymuint kWordNum = kPatNum / 64;
+
+// 簡単な擬似乱数
+ymuint64
+next_rand(ymuint64& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// 調べるノードと全パタンでの値
+struct NodeInfo
+{
+  BdnNode* mNode;
+
+  vector<ymuint64> mVals;
+
+  // 入力 0 か 1 に依存する時 true
+  bool mDep01;
+};
+
+// ハンドルと全パタンでの値
+struct HandleInfo
+{
+  BdnNodeHandle mHandle;
+
+  vector<ymuint64> mVals;
+
+  bool mDep01;
+};
+
+// ハンドルの指すノードを NodeInfo として登録する．
+void
+add_node(const HandleInfo& h,
+	 vector<NodeInfo>& node_list)
+{
+  NodeInfo info;
+  info.mNode = h.mHandle.node();
+  info.mVals = h.mVals;
+  if ( h.mHandle.inv() ) {
+    for (ymuint w = 0; w < kWordNum; ++ w) {
+      info.mVals[w] = ~info.mVals[w];
+    }
+  }
+  info.mDep01 = h.mDep01;
+  node_list.push_back(info);
+}
+
+// 木構造のネットワークを作る．
+// 出力は根，途中のノード，定数1，定数0 の4つ．
+// 入力，論理ノード，出力ノードを node_list に入れる．
+// 入力 0 と 1 を入力とする論理ノードを first_gate に入れる．
+void
+make_tree(BdnMgr& network,
+	  ymuint64 seed,
+	  vector<NodeInfo>& node_list,
+	  BdnNode*& first_gate)
+{
+  BdnPort* i_port = network.new_input_port("i", kInputNum);
+  BdnPort* o_port = network.new_output_port("o", 4);
+
+  vector<HandleInfo> queue;
+  for (ymuint i = 0; i < kInputNum; ++ i) {
+    HandleInfo h;
+    h.mHandle = BdnNodeHandle(i_port->_input(i), false);
+    h.mVals.resize(kWordNum, 0ULL);
+    for (ymuint p = 0; p < kPatNum; ++ p) {
+      if ( (p >> i) & 1U ) {
+	h.mVals[p / 64] |= (1ULL << (p % 64));
+      }
+    }
+    h.mDep01 = (i < 2);
+    add_node(h, node_list);
+    queue.push_back(h);
+  }
+
+  // 先頭の2つを組み合わせたノードを末尾に加えていく．
+  vector<HandleInfo> gate_list;
+  for (ymuint rpos = 0; rpos + 1 < queue.size(); rpos += 2) {
+    HandleInfo h0 = queue[rpos];
+    HandleInfo h1 = queue[rpos + 1];
+    if ( next_rand(seed) & 1ULL ) {
+      h0.mHandle = ~h0.mHandle;
+      for (ymuint w = 0; w < kWordNum; ++ w) {
+	h0.mVals[w] = ~h0.mVals[w];
+      }
+    }
+    HandleInfo h;
+    h.mVals.resize(kWordNum);
+    h.mDep01 = h0.mDep01 || h1.mDep01;
+    switch ( next_rand(seed) % 3 ) {
+    case 0:
+      h.mHandle = network.new_and(h0.mHandle, h1.mHandle);
+      for (ymuint w = 0; w < kWordNum; ++ w) {
+	h.mVals[w] = h0.mVals[w] & h1.mVals[w];
+      }
+      break;
+
+    case 1:
+      h.mHandle = network.new_or(h0.mHandle, h1.mHandle);
+      for (ymuint w = 0; w < kWordNum; ++ w) {
+	h.mVals[w] = h0.mVals[w] | h1.mVals[w];
+      }
+      break;
+
+    case 2:
+      h.mHandle = network.new_xor(h0.mHandle, h1.mHandle);
+      for (ymuint w = 0; w < kWordNum; ++ w) {
+	h.mVals[w] = h0.mVals[w] ^ h1.mVals[w];
+      }
+      break;
+    }
+    if ( rpos == 0 ) {
+      first_gate = h.mHandle.node();
+    }
+    add_node(h, node_list);
+    queue.push_back(h);
+    gate_list.push_back(h);
+  }
+
+  HandleInfo root = queue.back();
+  HandleInfo mid = gate_list[gate_list.size() / 2 - 1];
+  HandleInfo one;
+  one.mHandle = BdnNodeHandle::make_one();
+  one.mVals.resize(kWordNum, ~0ULL);
+  one.mDep01 = false;
+  HandleInfo zero;
+  zero.mHandle = BdnNodeHandle::make_zero();
+  zero.mVals.resize(kWordNum, 0ULL);
+  zero.mDep01 = false;
+  HandleInfo o_list[] = { root, mid, one, zero };
+  for (ymuint i = 0; i < 4; ++ i) {
+    BdnNode* onode = o_port->_output(i);
+    network.change_output_fanin(onode, o_list[i].mHandle);
+    HandleInfo h = o_list[i];
+    h.mHandle = BdnNodeHandle(onode, false);
+    add_node(h, node_list);
+  }
+}
+
+// 入力の信号確率とトグル率を設定する．
+// toggle_ratio はトグル率の上限に対する割合
+void
+set_input_prob(BdnSigProb& sp,
+	       const vector<NodeInfo>& node_list,
+	       double toggle_ratio,
+	       vector<double>& prob_list,
+	       vector<double>& toggle_list)
+{
+  prob_list.resize(kInputNum);
+  toggle_list.resize(kInputNum);
+  for (ymuint i = 0; i < kInputNum; ++ i) {
+    double p = 0.1 + 0.1 * i;
+    double max_toggle = 2.0 * (p < 0.5 ? p : 1.0 - p);
+    prob_list[i] = p;
+    toggle_list[i] = max_toggle * toggle_ratio;
+    sp.set_input_prob(node_list[i].mNode, prob_list[i], toggle_list[i]);
+  }
+}
+
+// 連続する2時刻の入力パタンの組の確率を求める．
+// weight[a * kPatNum + b] は時刻 t の値が a，t + 1 の値が b となる確率
+void
+calc_weight(const vector<double>& prob_list,
+	    const vector<double>& toggle_list,
+	    vector<double>& weight)
+{
+  weight.resize(kPatNum * kPatNum);
+  for (ymuint a = 0; a < kPatNum; ++ a) {
+    for (ymuint b = 0; b < kPatNum; ++ b) {
+      double w = 1.0;
+      for (ymuint i = 0; i < kInputNum; ++ i) {
+	double p = prob_list[i];
+	double rise = toggle_list[i] / (2.0 * (1.0 - p));
+	double fall = toggle_list[i] / (2.0 * p);
+	bool va = (a >> i) & 1U;
+	bool vb = (b >> i) & 1U;
+	if ( va ) {
+	  w *= p * (vb ? 1.0 - fall : fall);
+	}
+	else {
+	  w *= (1.0 - p) * (vb ? rise : 1.0 - rise);
+	}
+      }
+      weight[a * kPatNum + b] = w;
+    }
+  }
+}
+
+// 全パタンの値から厳密な信号確率とトグル率を求める．
+void
+exact_value(const vector<ymuint64>& vals,
+	    const vector<double>& weight,
+	    double& prob,
+	    double& toggle)
+{
+  prob = 0.0;
+  toggle = 0.0;
+  for (ymuint a = 0; a < kPatNum; ++ a) {
+    bool fa = (vals[a / 64] >> (a % 64)) & 1ULL;
+    for (ymuint b = 0; b < kPatNum; ++ b) {
+      bool fb = (vals[b / 64] >> (b % 64)) & 1ULL;
+      double w = weight[a * kPatNum + b];
+      if ( fa ) {
+	prob += w;
+      }
+      if ( fa != fb ) {
+	toggle += w;
+      }
+    }
+  }
+}
+
+END_NONAMESPACE
+
+
+TEST(BdnSigProbTest, analyze_tree)
+{
+  // 木構造ではカットの葉が独立なので解析結果は厳密な値と一致する．
+  ymuint cut_param[][2] = { { 8, 32 }, { 4, 3 }, { 2, 1 } };
+  for (ymuint c = 0; c < 3; ++ c) {
+    BdnMgr network;
+    vector<NodeInfo> node_list;
+    BdnNode* first_gate = nullptr;
+    make_tree(network, 0x123456789abcdefULL + c, node_list, first_gate);
+
+    BdnSigProb sp(network);
+    vector<double> prob_list;
+    vector<double> toggle_list;
+    set_input_prob(sp, node_list, 0.4, prob_list, toggle_list);
+    sp.set_cut_param(cut_param[c][0], cut_param[c][1]);
+    sp.analyze();
+    EXPECT_EQ( 0U, sp.pattern_num() );
+
+    vector<double> weight;
+    calc_weight(prob_list, toggle_list, weight);
+    for (ymuint i = 0; i < node_list.size(); ++ i) {
+      const NodeInfo& info = node_list[i];
+      double prob;
+      double toggle;
+      exact_value(info.mVals, weight, prob, toggle);
+      EXPECT_NEAR( prob, sp.prob(info.mNode), 1.0e-9 )
+	<< "cut#" << c << ", node#" << info.mNode->id();
+      EXPECT_NEAR( toggle, sp.toggle(info.mNode), 1.0e-9 )
+	<< "cut#" << c << ", node#" << info.mNode->id();
+      EXPECT_EQ( 0.0, sp.prob_error(info.mNode) );
+    }
+  }
+}
+
+TEST(BdnSigProbTest, const_output)
+{
+  // 定数に接続した出力
+  BdnMgr network;
+  vector<NodeInfo> node_list;
+  BdnNode* first_gate = nullptr;
+  make_tree(network, 0x2545f4914f6cdd1dULL, node_list, first_gate);
+  const BdnNode* one = node_list[node_list.size() - 2].mNode;
+  const BdnNode* zero = node_list[node_list.size() - 1].mNode;
+
+  BdnSigProb sp(network);
+  sp.analyze();
+  EXPECT_EQ( 1.0, sp.prob(one) );
+  EXPECT_EQ( 0.0, sp.toggle(one) );
+  EXPECT_EQ( 0.0, sp.prob(zero) );
+  EXPECT_EQ( 0.0, sp.toggle(zero) );
+
+  sp.simulate();
+  EXPECT_EQ( 1.0, sp.prob(one) );
+  EXPECT_EQ( 0.0, sp.toggle(one) );
+  EXPECT_EQ( 0.0, sp.prob(zero) );
+  EXPECT_EQ( 0.0, sp.toggle(zero) );
+}
+
+TEST(BdnSigProbTest, simulate_bound)
+{
+  // 入力のトグル率を小さくして時間的な相関を強くしても
+  // 信頼区間が真の値を含む．
+  ymuint thread_list[] = { 1, 3 };
+  for (ymuint t = 0; t < 2; ++ t) {
+    BdnMgr network;
+    vector<NodeInfo> node_list;
+    BdnNode* first_gate = nullptr;
+    make_tree(network, 0x9e3779b97f4a7c15ULL, node_list, first_gate);
+
+    BdnSigProb sp(network, thread_list[t]);
+    vector<double> prob_list;
+    vector<double> toggle_list;
+    set_input_prob(sp, node_list, 0.1, prob_list, toggle_list);
+    sp.set_mc_param(1U << 20, 0.01, 3);
+    sp.simulate();
+    ymuint64 n = sp.pattern_num();
+    EXPECT_LT( 0U, n );
+
+    vector<double> weight;
+    calc_weight(prob_list, toggle_list, weight);
+    ymuint count = 0;
+    for (ymuint i = 0; i < node_list.size(); ++ i) {
+      const NodeInfo& info = node_list[i];
+      double prob;
+      double toggle;
+      exact_value(info.mVals, weight, prob, toggle);
+      double prob_error = sp.prob_error(info.mNode);
+      double toggle_error = sp.toggle_error(info.mNode);
+      EXPECT_LE( fabs(prob - sp.prob(info.mNode)), prob_error * 2.0 )
+	<< "node#" << info.mNode->id();
+      EXPECT_LE( fabs(toggle - sp.toggle(info.mNode)), toggle_error * 2.0 )
+	<< "node#" << info.mNode->id();
+      if ( fabs(prob - sp.prob(info.mNode)) <= prob_error ) {
+	++ count;
+      }
+      if ( fabs(toggle - sp.toggle(info.mNode)) <= toggle_error ) {
+	++ count;
+      }
+    }
+    // ほとんどは 95% 信頼区間に入る．
+    EXPECT_LE( node_list.size() * 2 * 8, count * 10 );
+
+    // 入力の値は強く相関しているので，独立な標本とみなした場合よりも
+    // 信頼区間が十分に広くなる．
+    for (ymuint i = 0; i < kInputNum; ++ i) {
+      double p = prob_list[i];
+      double naive = 1.96 * sqrt(p * (1.0 - p) / n);
+      EXPECT_LT( naive * 2.0, sp.prob_error(node_list[i].mNode) ) << "input#" << i;
+    }
+  }
+}
+
+TEST(BdnSigProbTest, update_sim)
+{
+  // update() は変更の影響を受けるノードのみを計算し直し，
+  // その結果は最初から計算し直した場合と一致する．
+  BdnMgr network;
+  vector<NodeInfo> node_list;
+  BdnNode* first_gate = nullptr;
+  make_tree(network, 0xfedcba987654321ULL, node_list, first_gate);
+
+  BdnSigProb sp(network, 2);
+  vector<double> prob_list;
+  vector<double> toggle_list;
+  set_input_prob(sp, node_list, 0.5, prob_list, toggle_list);
+  sp.set_mc_param(1U << 16, 0.0, 7);
+  sp.simulate();
+  ymuint64 n = sp.pattern_num();
+
+  vector<double> prob0(node_list.size());
+  vector<double> toggle0(node_list.size());
+  vector<double> error0(node_list.size());
+  for (ymuint i = 0; i < node_list.size(); ++ i) {
+    const BdnNode* node = node_list[i].mNode;
+    prob0[i] = sp.prob(node);
+    toggle0[i] = sp.toggle(node);
+    error0[i] = sp.prob_error(node);
+  }
+
+  // 入力 0 と 1 の論理ノードを変更する．
+  BdnNodeHandle h0(node_list[0].mNode, false);
+  BdnNodeHandle h1(node_list[1].mNode, true);
+  if ( first_gate->is_xor() ) {
+    network.change_and(first_gate, h0, h1);
+  }
+  else {
+    network.change_xor(first_gate, h0, h1);
+  }
+  sp.update();
+  EXPECT_EQ( n, sp.pattern_num() );
+
+  BdnSigProb sp2(network, 2);
+  set_input_prob(sp2, node_list, 0.5, prob_list, toggle_list);
+  sp2.set_mc_param(1U << 16, 0.0, 7);
+  sp2.simulate();
+  EXPECT_EQ( n, sp2.pattern_num() );
+
+  ymuint changed = 0;
+  for (ymuint i = 0; i < node_list.size(); ++ i) {
+    const NodeInfo& info = node_list[i];
+    const BdnNode* node = info.mNode;
+    EXPECT_EQ( sp2.prob(node), sp.prob(node) ) << "node#" << node->id();
+    EXPECT_EQ( sp2.toggle(node), sp.toggle(node) ) << "node#" << node->id();
+    EXPECT_EQ( sp2.prob_error(node), sp.prob_error(node) ) << "node#" << node->id();
+    EXPECT_EQ( sp2.toggle_error(node), sp.toggle_error(node) ) << "node#" << node->id();
+    if ( !info.mDep01 || node->is_input() ) {
+      // 影響を受けないノード
+      EXPECT_EQ( prob0[i], sp.prob(node) ) << "node#" << node->id();
+      EXPECT_EQ( toggle0[i], sp.toggle(node) ) << "node#" << node->id();
+      EXPECT_EQ( error0[i], sp.prob_error(node) ) << "node#" << node->id();
+    }
+    else if ( prob0[i] != sp.prob(node) ) {
+      ++ changed;
+    }
+  }
+  EXPECT_LT( 0U, changed );
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
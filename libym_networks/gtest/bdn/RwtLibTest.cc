@@ -0,0 +1,167 @@
+
+/// @file RwtLibTest.cc
+/// @brief RwtLibTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "RwtLib.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+// 真理値表のマスク
+const ymuint kAllMask = 0xFFFFU;
+
+// 各変数の値が1となるビットのマスク
+const ymuint kVarMask[] = {
+  0xAAAAU, 0xCCCCU, 0xF0F0U, 0xFF00U
+};
+
+// リテラルの真理値表を得る．
+ymuint
+lit_func(ymuint lit,
+	 const vector<ymuint>& func_array)
+{
+  ymuint func = func_array[lit >> 1];
+  if ( lit & 1U ) {
+    func ^= kAllMask;
+  }
+  return func;
+}
+
+// 対応付けられた部分グラフの関数を計算する．
+ymuint
+match_func(const RwtMatch& match)
+{
+  const RwtGraph* graph = match.mGraph;
+  ymuint n = graph->node_num();
+  vector<ymuint> func_array(5 + n);
+  func_array[0] = 0U;
+  for (ymuint j = 0; j < 4; ++ j) {
+    ymuint func = kVarMask[match.mLeafPos[j]];
+    if ( match.mLeafInv[j] ) {
+      func ^= kAllMask;
+    }
+    func_array[j + 1] = func;
+  }
+  for (ymuint i = 0; i < n; ++ i) {
+    ymuint func0 = lit_func(graph->fanin(i, 0), func_array);
+    ymuint func1 = lit_func(graph->fanin(i, 1), func_array);
+    func_array[i + 5] = graph->is_xor(i) ? (func0 ^ func1) : (func0 & func1);
+  }
+  ymuint func = lit_func(graph->output(), func_array);
+  if ( match.mOutputInv ) {
+    func ^= kAllMask;
+  }
+  return func;
+}
+
+// 関数に対応する部分グラフのノード数を返す．
+ymuint
+node_num(RwtLib& lib,
+	 ymuint func)
+{
+  RwtMatch match;
+  lib.match(func, match);
+  return match.mGraph->node_num();
+}
+
+END_NONAMESPACE
+
+
+TEST(RwtLibTest, all_functions)
+{
+  RwtLib lib;
+
+  // 部分グラフは最初にすべて作られている．
+  EXPECT_EQ( 222U, lib.graph_num() );
+
+  // すべての関数について部分グラフが元の関数を実現している．
+  for (ymuint func = 0; func <= kAllMask; ++ func) {
+    RwtMatch match;
+    lib.match(func, match);
+    ASSERT_TRUE( match.mGraph != nullptr );
+    EXPECT_EQ( func, match_func(match) ) << "func = " << func;
+  }
+  EXPECT_EQ( 222U, lib.graph_num() );
+}
+
+TEST(RwtLibTest, node_num)
+{
+  RwtLib lib;
+
+  // ノード数ごとの NPN 同値類の数は4入力関数の最小回路の数に一致する．
+  const ymuint expected[] = { 2, 2, 5, 20, 34, 75, 72, 12 };
+  vector<ymuint> count(8, 0);
+  vector<const RwtGraph*> graph_list;
+  for (ymuint func = 0; func <= kAllMask; ++ func) {
+    RwtMatch match;
+    lib.match(func, match);
+    const RwtGraph* graph = match.mGraph;
+    if ( find(graph_list.begin(), graph_list.end(), graph) != graph_list.end() ) {
+      continue;
+    }
+    graph_list.push_back(graph);
+    ymuint n = graph->node_num();
+    ASSERT_LT( n, 8U );
+    ++ count[n];
+  }
+  for (ymuint i = 0; i < 8; ++ i) {
+    EXPECT_EQ( expected[i], count[i] ) << "node_num = " << i;
+  }
+
+  // よく知られた関数
+  ymuint x0 = kVarMask[0];
+  ymuint x1 = kVarMask[1];
+  ymuint x2 = kVarMask[2];
+  ymuint x3 = kVarMask[3];
+  EXPECT_EQ( 3U, node_num(lib, x0 & x1 & x2 & x3) );
+  EXPECT_EQ( 3U, node_num(lib, x0 ^ x1 ^ x2 ^ x3) );
+  EXPECT_EQ( 3U, node_num(lib, (x0 & x1) | (~x0 & x2 & kAllMask)) );
+  EXPECT_EQ( 4U, node_num(lib, (x0 & x1) | (x0 & x2) | (x1 & x2)) );
+}
+
+TEST(RwtLibTest, order)
+{
+  // 参照の順序によらず同じ部分グラフが得られる．
+  RwtLib lib1;
+  RwtLib lib2;
+  for (ymuint i = 0; i <= kAllMask; ++ i) {
+    ymuint func1 = i;
+    ymuint func2 = kAllMask - i;
+    RwtMatch match1;
+    lib1.match(func1, match1);
+    RwtMatch match2;
+    lib2.match(func2, match2);
+    EXPECT_EQ( func1, match_func(match1) );
+    EXPECT_EQ( func2, match_func(match2) );
+  }
+  for (ymuint func = 0; func <= kAllMask; ++ func) {
+    RwtMatch match1;
+    lib1.match(func, match1);
+    RwtMatch match2;
+    lib2.match(func, match2);
+    const RwtGraph* graph1 = match1.mGraph;
+    const RwtGraph* graph2 = match2.mGraph;
+    ASSERT_EQ( graph1->node_num(), graph2->node_num() );
+    for (ymuint i = 0; i < graph1->node_num(); ++ i) {
+      EXPECT_EQ( graph1->is_xor(i), graph2->is_xor(i) );
+      EXPECT_EQ( graph1->fanin(i, 0), graph2->fanin(i, 0) );
+      EXPECT_EQ( graph1->fanin(i, 1), graph2->fanin(i, 1) );
+    }
+    EXPECT_EQ( graph1->output(), graph2->output() );
+    for (ymuint j = 0; j < 4; ++ j) {
+      EXPECT_EQ( match1.mLeafPos[j], match2.mLeafPos[j] );
+      EXPECT_EQ( match1.mLeafInv[j], match2.mLeafInv[j] );
+    }
+    EXPECT_EQ( match1.mOutputInv, match2.mOutputInv );
+  }
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
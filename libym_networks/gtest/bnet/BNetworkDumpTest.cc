@@ -0,0 +1,313 @@
+﻿
+/// @file BNetworkDumpTest.cc
+/// @brief BNetworkDumpTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/BNetwork.h"
+#include "YmNetworks/BNetManip.h"
+#include "YmUtils/StreamIDO.h"
+#include "YmUtils/StreamODO.h"
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BNET
+
+BEGIN_NONAMESPACE
+
+// 簡単な擬似乱数
+ymuint64
+next_rand(ymuint64& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// ni 入力のランダムな論理式を作る．
+// すべての変数が一回以上現れる．
+Expr
+make_expr(ymuint ni,
+	  ymuint64& seed)
+{
+  Expr expr = Expr::make_literal(VarId(0), (next_rand(seed) & 1ULL) != 0);
+  for (ymuint i = 1; i < ni; ++ i) {
+    Expr lit = Expr::make_literal(VarId(i), (next_rand(seed) & 1ULL) != 0);
+    switch ( next_rand(seed) % 3 ) {
+    case 0: expr = expr & lit; break;
+    case 1: expr = expr | lit; break;
+    case 2: expr = expr ^ lit; break;
+    }
+  }
+  return expr;
+}
+
+// ラッチを含むランダムなネットワークを作る．
+// 途中でノードを削除して ID 番号に隙間を作る．
+void
+make_network(BNetwork& network,
+	     ymuint64 seed)
+{
+  BNetManip manip(&network);
+
+  network.set_model_name("dump_test");
+  network.change_name_rule("[", "]");
+
+  vector<BNode*> pool;
+  for (ymuint i = 0; i < 6; ++ i) {
+    ostringstream buf;
+    buf << "i" << i;
+    pool.push_back(manip.new_input(buf.str()));
+  }
+  vector<BNode*> latch_list;
+  for (ymuint i = 0; i < 3; ++ i) {
+    ostringstream buf;
+    buf << "l" << i;
+    BNode* latch = manip.new_latch(buf.str());
+    latch_list.push_back(latch);
+    pool.push_back(latch);
+  }
+
+  vector<BNode*> dummy_list;
+  for (ymuint i = 0; i < 60; ++ i) {
+    // 名前のないノードも作る．
+    BNode* node = (i % 4 == 0) ? manip.new_logic() : manip.new_logic("");
+    if ( i % 5 == 0 ) {
+      // 後で削除する．
+      dummy_list.push_back(node);
+      continue;
+    }
+    ymuint ni = (next_rand(seed) % 4) + 1;
+    BNodeVector fanins;
+    while ( fanins.size() < ni ) {
+      BNode* inode = pool[next_rand(seed) % pool.size()];
+      bool found = false;
+      for (ymuint j = 0; j < fanins.size(); ++ j) {
+	if ( fanins[j] == inode ) {
+	  found = true;
+	  break;
+	}
+      }
+      if ( !found ) {
+	fanins.push_back(inode);
+      }
+    }
+    ASSERT_TRUE( manip.change_logic(node, make_expr(ni, seed), fanins) );
+    pool.push_back(node);
+  }
+  // 定数ノード
+  BNode* c0 = manip.new_logic("c0");
+  ASSERT_TRUE( manip.change_logic(c0, Expr::make_zero(), BNodeVector()) );
+  pool.push_back(c0);
+
+  for (ymuint i = 0; i < dummy_list.size(); ++ i) {
+    manip.delete_node(dummy_list[i]);
+  }
+
+  for (ymuint i = 0; i < 3; ++ i) {
+    BNode* inode = pool[pool.size() - 1 - (next_rand(seed) % 20)];
+    ASSERT_TRUE( manip.change_latch(latch_list[i], inode, i) );
+  }
+  for (ymuint i = 0; i < 5; ++ i) {
+    ostringstream buf;
+    buf << "o" << i;
+    BNode* onode = manip.new_output(buf.str());
+    BNode* inode = (i == 4) ? c0 : pool[pool.size() - 1 - (next_rand(seed) % 20)];
+    ASSERT_TRUE( manip.change_output(onode, inode) );
+  }
+  // 外部入力と同名の外部出力
+  BNode* onode = manip.new_output("i0");
+  ASSERT_TRUE( manip.change_output(onode, pool[0]) );
+}
+
+// 二つのネットワークの構造が ID 番号まで含めて等しいか調べる．
+void
+check_same(const BNetwork& src,
+	   const BNetwork& dst)
+{
+  EXPECT_EQ( string(src.model_name()), string(dst.model_name()) );
+  string src_prefix;
+  string src_suffix;
+  src.name_rule(src_prefix, src_suffix);
+  string dst_prefix;
+  string dst_suffix;
+  dst.name_rule(dst_prefix, dst_suffix);
+  EXPECT_EQ( src_prefix, dst_prefix );
+  EXPECT_EQ( src_suffix, dst_suffix );
+  ASSERT_EQ( src.node_num(), dst.node_num() );
+  ASSERT_EQ( src.input_num(), dst.input_num() );
+  ASSERT_EQ( src.output_num(), dst.output_num() );
+  ASSERT_EQ( src.logic_node_num(), dst.logic_node_num() );
+  ASSERT_EQ( src.latch_node_num(), dst.latch_node_num() );
+
+  for (BNodeList::const_iterator p = src.nodes_begin();
+       p != src.nodes_end(); ++ p) {
+    const BNode* src_node = *p;
+    ASSERT_LT( src_node->id(), dst.max_node_id() );
+    const BNode* dst_node = dst.node(src_node->id());
+    ASSERT_TRUE( dst_node != nullptr );
+    EXPECT_EQ( src_node->type(), dst_node->type() );
+    EXPECT_EQ( string(src.node_name(src_node)), string(dst.node_name(dst_node)) );
+    ASSERT_EQ( src_node->fanin_num(), dst_node->fanin_num() );
+    for (ymuint i = 0; i < src_node->fanin_num(); ++ i) {
+      EXPECT_EQ( src_node->fanin(i)->id(), dst_node->fanin(i)->id() );
+    }
+    EXPECT_EQ( src_node->fanout_num(), dst_node->fanout_num() );
+    if ( src_node->is_logic() ) {
+      EXPECT_TRUE( compare_type(src_node->func(), dst_node->func()) )
+	<< "id = " << src_node->id();
+    }
+    if ( src_node->is_latch() ) {
+      EXPECT_EQ( src_node->reset_value(), dst_node->reset_value() );
+    }
+  }
+}
+
+// ダンプした内容を返す．
+string
+dump_network(const BNetwork& network)
+{
+  ostringstream buf;
+  {
+    StreamODO odo(buf);
+    network.dump(odo);
+  }
+  return buf.str();
+}
+
+// 文字列から読み込む．
+bool
+restore_network(BNetwork& network,
+		const string& data)
+{
+  istringstream buf(data);
+  StreamIDO ido(buf);
+  return network.restore(ido);
+}
+
+// ダンプした内容のうち名前の部分の大きさを返す．
+// 名前は 64ビットの長さに続けて文字列が書かれる．
+ymuint
+header_size(const BNetwork& network)
+{
+  string prefix;
+  string suffix;
+  network.name_rule(prefix, suffix);
+  ymuint size = 8 * 3 + string(network.model_name()).size() + prefix.size() + suffix.size() + 4 * 2;
+  for (BNodeList::const_iterator p = network.nodes_begin();
+       p != network.nodes_end(); ++ p) {
+    size += 8 + string(network.node_name(*p)).size();
+  }
+  return size;
+}
+
+END_NONAMESPACE
+
+
+TEST(BNetworkDumpTest, round_trip)
+{
+  BNetwork network;
+  make_network(network, 0x123456789abcdefULL);
+  // ノードの削除で ID 番号に隙間ができていることを確かめておく．
+  ASSERT_LT( network.node_num(), network.max_node_id() );
+
+  string data = dump_network(network);
+
+  BNetwork network2;
+  make_network(network2, 0xfedcba987654321ULL);
+  ASSERT_TRUE( restore_network(network2, data) );
+  check_same(network, network2);
+
+  // 名前で検索できる．
+  EXPECT_EQ( network.find_node("l1")->id(), network2.find_node("l1")->id() );
+  EXPECT_EQ( network.find_ponode("i0")->id(), network2.find_ponode("i0")->id() );
+
+  // もう一度ダンプしても同じ内容になる．
+  EXPECT_TRUE( data == dump_network(network2) );
+}
+
+TEST(BNetworkDumpTest, empty)
+{
+  BNetwork network;
+  BNetwork network2;
+  make_network(network2, 0x123456789abcdefULL);
+  ASSERT_TRUE( restore_network(network2, dump_network(network)) );
+  check_same(network, network2);
+  EXPECT_EQ( 0U, network2.node_num() );
+}
+
+TEST(BNetworkDumpTest, truncated)
+{
+  BNetwork network;
+  make_network(network, 0x123456789abcdefULL);
+  string data = dump_network(network);
+  ymuint hsize = header_size(network);
+  ASSERT_LT( hsize, data.size() );
+
+  // 元のネットワークと比べるために同じものを二つ作っておく．
+  BNetwork orig;
+  make_network(orig, 0x0f1e2d3c4b5a6978ULL);
+  BNetwork network2;
+  make_network(network2, 0x0f1e2d3c4b5a6978ULL);
+  for (ymuint size = hsize; size < data.size(); ++ size) {
+    EXPECT_FALSE( restore_network(network2, data.substr(0, size)) ) << "size = " << size;
+  }
+  // 失敗した場合は元の内容が残る．
+  check_same(orig, network2);
+}
+
+TEST(BNetworkDumpTest, corrupt)
+{
+  BNetwork network;
+  make_network(network, 0x123456789abcdefULL);
+  string data = dump_network(network);
+  ymuint hsize = header_size(network);
+
+  // 最後の外部出力のファンインを存在しないノードにする．
+  {
+    string data2 = data;
+    for (ymuint i = 0; i < 4; ++ i) {
+      data2[data2.size() - 1 - i] = static_cast<char>(0x7f);
+    }
+    BNetwork network2;
+    make_network(network2, 0x123456789abcdefULL);
+    EXPECT_FALSE( restore_network(network2, data2) );
+    check_same(network, network2);
+  }
+
+  // 外部入力の名前を重複させる．
+  {
+    string data2 = data;
+    string::size_type pos = data2.find("i1");
+    ASSERT_NE( string::npos, pos );
+    data2[pos + 1] = '0';
+    BNetwork network2;
+    make_network(network2, 0x123456789abcdefULL);
+    EXPECT_FALSE( restore_network(network2, data2) );
+    check_same(network, network2);
+  }
+
+  // ブロックの部分のバイトを一つずつ壊しても異常終了しない．
+  // 読み込みに失敗した場合は元の内容が残る．
+  BNetwork orig;
+  make_network(orig, 0x0f1e2d3c4b5a6978ULL);
+  ymuint nfail = 0;
+  for (ymuint pos = hsize; pos < data.size(); ++ pos) {
+    string data2 = data;
+    data2[pos] ^= static_cast<char>(0xa5);
+    BNetwork network2;
+    make_network(network2, 0x0f1e2d3c4b5a6978ULL);
+    if ( !restore_network(network2, data2) ) {
+      check_same(orig, network2);
+      ++ nfail;
+    }
+  }
+  EXPECT_LT( 0U, nfail );
+}
+
+END_NAMESPACE_YM_NETWORKS_BNET
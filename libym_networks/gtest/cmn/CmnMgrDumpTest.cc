@@ -0,0 +1,460 @@
+﻿
+/// @file CmnMgrDumpTest.cc
+/// @brief CmnMgrDumpTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/CmnMgr.h"
+#include "YmNetworks/CmnPort.h"
+#include "YmNetworks/CmnDff.h"
+#include "YmNetworks/CmnLatch.h"
+#include "YmNetworks/CmnNode.h"
+#include "YmNetworks/CmnDffCell.h"
+#include "YmNetworks/CmnLatchCell.h"
+#include "YmCell/CellDotlibReader.h"
+#include "YmCell/CellLibrary.h"
+#include "YmCell/Cell.h"
+#include "YmCell/CellFFInfo.h"
+#include "YmCell/CellLatchInfo.h"
+#include "YmUtils/StreamIDO.h"
+#include "YmUtils/StreamODO.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_CMN
+
+BEGIN_NONAMESPACE
+
+// テスト用のセルライブラリ
+// ピンの順番は CellFFInfo/CellLatchInfo の設定に合わせてある．
+const char* kLibraryText =
+  "library (test_lib) {\n"
+  "  cell (INV) {\n"
+  "    area : 1 ;\n"
+  "    pin (A) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (Y) {\n"
+  "      direction : output ;\n"
+  "      function : \"!A\" ;\n"
+  "    }\n"
+  "  }\n"
+  "  cell (AND2) {\n"
+  "    area : 2 ;\n"
+  "    pin (A) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (B) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (Y) {\n"
+  "      direction : output ;\n"
+  "      function : \"A*B\" ;\n"
+  "    }\n"
+  "  }\n"
+  "  cell (DFFR) {\n"
+  "    area : 5 ;\n"
+  "    ff (IQ, IQN) {\n"
+  "      next_state : \"D\" ;\n"
+  "      clocked_on : \"CK\" ;\n"
+  "      clear : \"!RN\" ;\n"
+  "    }\n"
+  "    pin (D) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (CK) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (RN) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (Q) {\n"
+  "      direction : output ;\n"
+  "      function : \"IQ\" ;\n"
+  "    }\n"
+  "    pin (QN) {\n"
+  "      direction : output ;\n"
+  "      function : \"IQN\" ;\n"
+  "    }\n"
+  "  }\n"
+  "  cell (LATCH) {\n"
+  "    area : 4 ;\n"
+  "    latch (IQ, IQN) {\n"
+  "      data_in : \"D\" ;\n"
+  "      enable : \"G\" ;\n"
+  "    }\n"
+  "    pin (D) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (G) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (Q) {\n"
+  "      direction : output ;\n"
+  "      function : \"IQ\" ;\n"
+  "    }\n"
+  "    pin (QN) {\n"
+  "      direction : output ;\n"
+  "      function : \"IQN\" ;\n"
+  "    }\n"
+  "  }\n"
+  "}\n";
+
+// 簡単な擬似乱数
+ymuint64
+next_rand(ymuint64& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// テスト用のセルライブラリを読み込む．
+const CellLibrary*
+read_library()
+{
+  string filename = ::testing::TempDir() + "CmnMgrDumpTest.lib";
+  {
+    ofstream ofs(filename.c_str());
+    ofs << kLibraryText;
+  }
+  CellDotlibReader read;
+  const CellLibrary* library = read(filename);
+  remove(filename.c_str());
+  return library;
+}
+
+// D-FF とラッチと双方向ポートを含むランダムなネットワークを作る．
+// 出力の一つはファンインを持たない．
+void
+make_network(CmnMgr& network,
+	     const CellLibrary& library,
+	     ymuint64 seed)
+{
+  const Cell* inv_cell = library.cell("INV");
+  const Cell* and_cell = library.cell("AND2");
+
+  // D(0), CK(1, positive), RN(2, low), Q(3), QN(4)
+  ymuint ff_pos[] = { 0, 1 | (1U << 3), 2 | (2U << 3), 0, 3, 4 };
+  const CmnDffCell* dff_cell = network.reg_dff_cell(library.cell("DFFR"),
+						    CellFFInfo(ff_pos));
+  // D(0), G(1, high), Q(2)
+  ymuint latch_pos[] = { 0, 1 | (1U << 3), 0, 0, 2 };
+  const CmnLatchCell* latch_cell = network.reg_latch_cell(library.cell("LATCH"),
+							  CellLatchInfo(latch_pos));
+
+  network.set_name("dump_test");
+  CmnPort* i_port = network.new_input_port("i", 6);
+  CmnPort* o_port = network.new_output_port("o", 4);
+  vector<ymuint> iovect(3);
+  iovect[0] = 1;
+  iovect[1] = 3;
+  iovect[2] = 2;
+  CmnPort* io_port = network.new_port("io", iovect);
+  CmnDff* dff_list[2];
+  dff_list[0] = network.new_dff(dff_cell, "ff0");
+  dff_list[1] = network.new_dff(dff_cell, "ff1");
+  CmnLatch* latch = network.new_latch(latch_cell, "l0");
+
+  vector<CmnNode*> pool;
+  for (ymuint i = 0; i < 6; ++ i) {
+    pool.push_back(i_port->_input(i));
+  }
+  pool.push_back(io_port->_input(0));
+  pool.push_back(io_port->_input(1));
+  for (ymuint i = 0; i < 2; ++ i) {
+    pool.push_back(dff_list[i]->_output1());
+    pool.push_back(dff_list[i]->_output2());
+  }
+  pool.push_back(latch->_output1());
+
+  for (ymuint i = 0; i < 80; ++ i) {
+    vector<CmnNode*> inodes;
+    const Cell* cell = nullptr;
+    inodes.push_back(pool[next_rand(seed) % pool.size()]);
+    if ( next_rand(seed) % 3 ) {
+      inodes.push_back(pool[next_rand(seed) % pool.size()]);
+      cell = and_cell;
+    }
+    else {
+      cell = inv_cell;
+    }
+    pool.push_back(network.new_logic(inodes, cell));
+  }
+
+  vector<CmnNode*> onode_list;
+  for (ymuint i = 0; i < 3; ++ i) {
+    onode_list.push_back(o_port->_output(i));
+  }
+  onode_list.push_back(io_port->_output(1));
+  onode_list.push_back(io_port->_output(2));
+  for (ymuint i = 0; i < 2; ++ i) {
+    onode_list.push_back(dff_list[i]->_input());
+    onode_list.push_back(dff_list[i]->_clock());
+    onode_list.push_back(dff_list[i]->_clear());
+  }
+  onode_list.push_back(latch->_input());
+  onode_list.push_back(latch->_enable());
+  for (ymuint i = 0; i < onode_list.size(); ++ i) {
+    CmnNode* inode = pool[pool.size() - 1 - (next_rand(seed) % 40)];
+    network.set_output_fanin(onode_list[i], inode);
+  }
+}
+
+// ノードの ID 番号を返す．
+// nullptr の場合は -1 を返す．
+int
+node_id(const CmnNode* node)
+{
+  return (node != nullptr) ? static_cast<int>(node->id()) : -1;
+}
+
+// セルの ID 番号を返す．
+// nullptr の場合は -1 を返す．
+int
+cell_id(const Cell* cell)
+{
+  return (cell != nullptr) ? static_cast<int>(cell->id()) : -1;
+}
+
+// 二つのネットワークの構造が ID 番号まで含めて等しいか調べる．
+void
+check_same(const CmnMgr& src,
+	   const CmnMgr& dst)
+{
+  EXPECT_EQ( src.name(), dst.name() );
+  ASSERT_EQ( src.port_num(), dst.port_num() );
+  ASSERT_EQ( src.dff_num(), dst.dff_num() );
+  ASSERT_EQ( src.latch_num(), dst.latch_num() );
+  ASSERT_EQ( src.input_num(), dst.input_num() );
+  ASSERT_EQ( src.output_num(), dst.output_num() );
+  ASSERT_EQ( src.logic_num(), dst.logic_num() );
+
+  for (ymuint i = 0; i < src.port_num(); ++ i) {
+    const CmnPort* src_port = src.port(i);
+    const CmnPort* dst_port = dst.port(i);
+    EXPECT_EQ( src_port->name(), dst_port->name() );
+    ASSERT_EQ( src_port->bit_width(), dst_port->bit_width() );
+    for (ymuint j = 0; j < src_port->bit_width(); ++ j) {
+      EXPECT_EQ( node_id(src_port->input(j)), node_id(dst_port->input(j)) );
+      EXPECT_EQ( node_id(src_port->output(j)), node_id(dst_port->output(j)) );
+    }
+  }
+
+  const CmnDffList& src_dff_list = src.dff_list();
+  const CmnDffList& dst_dff_list = dst.dff_list();
+  CmnDffList::const_iterator q = dst_dff_list.begin();
+  for (CmnDffList::const_iterator p = src_dff_list.begin();
+       p != src_dff_list.end(); ++ p, ++ q) {
+    const CmnDff* src_dff = *p;
+    const CmnDff* dst_dff = *q;
+    EXPECT_EQ( src_dff->name(), dst_dff->name() );
+    EXPECT_EQ( src_dff->cell()->cell(), dst_dff->cell()->cell() );
+    EXPECT_EQ( src_dff->cell()->clear_sense(), dst_dff->cell()->clear_sense() );
+    EXPECT_EQ( node_id(src_dff->output1()), node_id(dst_dff->output1()) );
+    EXPECT_EQ( node_id(src_dff->output2()), node_id(dst_dff->output2()) );
+    EXPECT_EQ( node_id(src_dff->input()), node_id(dst_dff->input()) );
+    EXPECT_EQ( node_id(src_dff->clock()), node_id(dst_dff->clock()) );
+    EXPECT_EQ( node_id(src_dff->clear()), node_id(dst_dff->clear()) );
+    EXPECT_EQ( node_id(src_dff->preset()), node_id(dst_dff->preset()) );
+  }
+
+  const CmnLatchList& src_latch_list = src.latch_list();
+  const CmnLatchList& dst_latch_list = dst.latch_list();
+  CmnLatchList::const_iterator r = dst_latch_list.begin();
+  for (CmnLatchList::const_iterator p = src_latch_list.begin();
+       p != src_latch_list.end(); ++ p, ++ r) {
+    const CmnLatch* src_latch = *p;
+    const CmnLatch* dst_latch = *r;
+    EXPECT_EQ( src_latch->name(), dst_latch->name() );
+    EXPECT_EQ( src_latch->cell()->cell(), dst_latch->cell()->cell() );
+    EXPECT_EQ( node_id(src_latch->output1()), node_id(dst_latch->output1()) );
+    EXPECT_EQ( node_id(src_latch->output2()), node_id(dst_latch->output2()) );
+    EXPECT_EQ( node_id(src_latch->input()), node_id(dst_latch->input()) );
+    EXPECT_EQ( node_id(src_latch->enable()), node_id(dst_latch->enable()) );
+    EXPECT_EQ( node_id(src_latch->clear()), node_id(dst_latch->clear()) );
+    EXPECT_EQ( node_id(src_latch->preset()), node_id(dst_latch->preset()) );
+  }
+
+  const CmnNodeList& logic_list = src.logic_list();
+  for (CmnNodeList::const_iterator p = logic_list.begin();
+       p != logic_list.end(); ++ p) {
+    const CmnNode* src_node = *p;
+    ASSERT_LT( src_node->id(), dst.max_node_id() );
+    const CmnNode* dst_node = dst.node(src_node->id());
+    ASSERT_TRUE( dst_node != nullptr );
+    ASSERT_TRUE( dst_node->is_logic() );
+    EXPECT_EQ( cell_id(src_node->cell()), cell_id(dst_node->cell()) );
+    ASSERT_EQ( src_node->fanin_num(), dst_node->fanin_num() );
+    for (ymuint i = 0; i < src_node->fanin_num(); ++ i) {
+      EXPECT_EQ( node_id(src_node->fanin(i)), node_id(dst_node->fanin(i)) );
+    }
+    EXPECT_EQ( src_node->fanout_num(), dst_node->fanout_num() );
+  }
+
+  const CmnNodeList& output_list = src.output_list();
+  for (CmnNodeList::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    const CmnNode* src_node = *p;
+    ASSERT_LT( src_node->id(), dst.max_node_id() );
+    const CmnNode* dst_node = dst.node(src_node->id());
+    ASSERT_TRUE( dst_node != nullptr );
+    ASSERT_TRUE( dst_node->is_output() );
+    EXPECT_EQ( node_id(src_node->fanin(0)), node_id(dst_node->fanin(0)) );
+  }
+}
+
+// ダンプした内容を返す．
+string
+dump_network(const CmnMgr& network)
+{
+  ostringstream buf;
+  {
+    StreamODO odo(buf);
+    network.dump(odo);
+  }
+  return buf.str();
+}
+
+// 文字列から読み込む．
+bool
+restore_network(CmnMgr& network,
+		const CellLibrary& library,
+		const string& data)
+{
+  istringstream buf(data);
+  StreamIDO ido(buf);
+  return network.restore(ido, library);
+}
+
+// ダンプした内容のうち名前とセルの部分の大きさを返す．
+// 名前は 64ビットの長さに続けて文字列が書かれる．
+// D-FF とラッチはさらにセル番号とピン情報を 32ビットずつ用いる．
+ymuint
+header_size(const CmnMgr& network)
+{
+  ymuint size = 8 + network.name().size() + 4 * 4;
+  for (ymuint i = 0; i < network.port_num(); ++ i) {
+    size += 8 + network.port(i)->name().size();
+  }
+  const CmnDffList& dff_list = network.dff_list();
+  for (CmnDffList::const_iterator p = dff_list.begin();
+       p != dff_list.end(); ++ p) {
+    size += 8 + (*p)->name().size() + 4 * 2;
+  }
+  const CmnLatchList& latch_list = network.latch_list();
+  for (CmnLatchList::const_iterator p = latch_list.begin();
+       p != latch_list.end(); ++ p) {
+    size += 8 + (*p)->name().size() + 4 * 2;
+  }
+  return size;
+}
+
+END_NONAMESPACE
+
+
+TEST(CmnMgrDumpTest, round_trip)
+{
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  CmnMgr network;
+  make_network(network, *library, 0x123456789abcdefULL);
+  string data = dump_network(network);
+
+  CmnMgr network2;
+  make_network(network2, *library, 0xfedcba987654321ULL);
+  ASSERT_TRUE( restore_network(network2, *library, data) );
+  check_same(network, network2);
+
+  // もう一度ダンプしても同じ構造になる．
+  CmnMgr network3;
+  ASSERT_TRUE( restore_network(network3, *library, dump_network(network2)) );
+  check_same(network2, network3);
+
+  delete library;
+}
+
+TEST(CmnMgrDumpTest, truncated)
+{
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  CmnMgr network;
+  make_network(network, *library, 0x123456789abcdefULL);
+  string data = dump_network(network);
+  ymuint hsize = header_size(network);
+  ASSERT_LT( hsize, data.size() );
+
+  // 元のネットワークと比べるために同じものを二つ作っておく．
+  CmnMgr orig;
+  make_network(orig, *library, 0x0f1e2d3c4b5a6978ULL);
+  CmnMgr network2;
+  make_network(network2, *library, 0x0f1e2d3c4b5a6978ULL);
+  for (ymuint size = hsize; size < data.size(); ++ size) {
+    EXPECT_FALSE( restore_network(network2, *library, data.substr(0, size)) ) << "size = " << size;
+  }
+  // 失敗した場合は元の内容が残る．
+  check_same(orig, network2);
+
+  delete library;
+}
+
+TEST(CmnMgrDumpTest, corrupt)
+{
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  CmnMgr network;
+  make_network(network, *library, 0x123456789abcdefULL);
+  string data = dump_network(network);
+  ymuint hsize = header_size(network);
+
+  // 最後の出力のファンインを存在しないノードにする．
+  {
+    string data2 = data;
+    for (ymuint i = 0; i < 4; ++ i) {
+      data2[data2.size() - 1 - i] = static_cast<char>(0x7f);
+    }
+    CmnMgr network2;
+    make_network(network2, *library, 0x123456789abcdefULL);
+    EXPECT_FALSE( restore_network(network2, *library, data2) );
+    check_same(network, network2);
+  }
+
+  // ブロックの部分のバイトを一つずつ壊しても異常終了しない．
+  // 読み込みに失敗した場合は元の内容が残る．
+  CmnMgr orig;
+  make_network(orig, *library, 0x0f1e2d3c4b5a6978ULL);
+  ymuint nfail = 0;
+  for (ymuint pos = hsize; pos < data.size(); ++ pos) {
+    string data2 = data;
+    data2[pos] ^= static_cast<char>(0xa5);
+    CmnMgr network2;
+    make_network(network2, *library, 0x0f1e2d3c4b5a6978ULL);
+    if ( !restore_network(network2, *library, data2) ) {
+      check_same(orig, network2);
+      ++ nfail;
+    }
+  }
+  EXPECT_LT( 0U, nfail );
+
+  delete library;
+}
+
+END_NAMESPACE_YM_NETWORKS_CMN
@@ -0,0 +1,412 @@
+﻿/// @file CmnSigProbTest.cc
+/// @brief CmnSigProbTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/CmnMgr.h"
+#include "YmNetworks/CmnPort.h"
+#include "YmNetworks/CmnNode.h"
+#include "YmNetworks/CmnSigProb.h"
+#include "YmCell/CellDotlibReader.h"
+#include "YmCell/CellLibrary.h"
+#include "YmCell/Cell.h"
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_CMN
+
+BEGIN_NONAMESPACE
+
+// 入力数
+// 全パタンを列挙するので 2^kInputNum / 64 ワードを用いる．
+const ymuint kInputNum = 8;
+const ymuint kPatNum = 1U << kInputNum;
+const ymuint kWordNum = kPatNum / 64;
+
+// テスト用のセルライブラリ
+const char* kLibraryText =
+  "library (test_lib) {\n"
+  "  cell (INV) {\n"
+  "    area : 1 ;\n"
+  "    pin (A) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (Y) {\n"
+  "      direction : output ;\n"
+  "      function : \"!A\" ;\n"
+  "    }\n"
+  "  }\n"
+  "  cell (AND2) {\n"
+  "    area : 2 ;\n"
+  "    pin (A) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (B) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (Y) {\n"
+  "      direction : output ;\n"
+  "      function : \"A*B\" ;\n"
+  "    }\n"
+  "  }\n"
+  "  cell (OR2) {\n"
+  "    area : 2 ;\n"
+  "    pin (A) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (B) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (Y) {\n"
+  "      direction : output ;\n"
+  "      function : \"A+B\" ;\n"
+  "    }\n"
+  "  }\n"
+  "  cell (XOR2) {\n"
+  "    area : 3 ;\n"
+  "    pin (A) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (B) {\n"
+  "      direction : input ;\n"
+  "      capacitance : 0.01 ;\n"
+  "    }\n"
+  "    pin (Y) {\n"
+  "      direction : output ;\n"
+  "      function : \"A^B\" ;\n"
+  "    }\n"
+  "  }\n"
+  "}\n";
+
+// 簡単な擬似乱数
+ymuint64
+next_rand(ymuint64& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// テスト用のセルライブラリを読み込む．
+const CellLibrary*
+read_library()
+{
+  string filename = ::testing::TempDir() + "CmnSigProbTest.lib";
+  {
+    ofstream ofs(filename.c_str());
+    ofs << kLibraryText;
+  }
+  CellDotlibReader read;
+  const CellLibrary* library = read(filename);
+  remove(filename.c_str());
+  return library;
+}
+
+// 調べるノードと全パタンでの値
+struct NodeInfo
+{
+  CmnNode* mNode;
+
+  vector<ymuint64> mVals;
+
+  // 入力 0 か 1 に依存する時 true
+  bool mDep01;
+};
+
+// 木構造のネットワークを作る．
+// 出力は根と途中のノードの2つ．
+// 入力，論理ノード，出力ノードを node_list に入れる．
+// 入力 0 と 1 を入力とする2入力の論理ノードを first_gate に入れる．
+void
+make_tree(CmnMgr& network,
+	  const CellLibrary& library,
+	  ymuint64 seed,
+	  vector<NodeInfo>& node_list,
+	  CmnNode*& first_gate)
+{
+  const Cell* inv_cell = library.cell("INV");
+  const Cell* cell_list[] = {
+    library.cell("AND2"),
+    library.cell("OR2"),
+    library.cell("XOR2")
+  };
+
+  CmnPort* i_port = network.new_input_port("i", kInputNum);
+  CmnPort* o_port = network.new_output_port("o", 2);
+
+  vector<NodeInfo> queue;
+  for (ymuint i = 0; i < kInputNum; ++ i) {
+    NodeInfo info;
+    info.mNode = i_port->_input(i);
+    info.mVals.resize(kWordNum, 0ULL);
+    for (ymuint p = 0; p < kPatNum; ++ p) {
+      if ( (p >> i) & 1U ) {
+	info.mVals[p / 64] |= (1ULL << (p % 64));
+      }
+    }
+    info.mDep01 = (i < 2);
+    node_list.push_back(info);
+    queue.push_back(info);
+  }
+
+  // 先頭の2つを組み合わせたノードを末尾に加えていく．
+  vector<NodeInfo> gate_list;
+  for (ymuint rpos = 0; rpos + 1 < queue.size(); rpos += 2) {
+    NodeInfo info0 = queue[rpos];
+    NodeInfo info1 = queue[rpos + 1];
+    if ( rpos > 0 && (next_rand(seed) & 1ULL) ) {
+      // インバータを挟む．
+      vector<CmnNode*> inodes(1, info0.mNode);
+      info0.mNode = network.new_logic(inodes, inv_cell);
+      for (ymuint w = 0; w < kWordNum; ++ w) {
+	info0.mVals[w] = ~info0.mVals[w];
+      }
+      node_list.push_back(info0);
+    }
+    vector<CmnNode*> inodes(2);
+    inodes[0] = info0.mNode;
+    inodes[1] = info1.mNode;
+    ymuint type = next_rand(seed) % 3;
+    NodeInfo info;
+    info.mNode = network.new_logic(inodes, cell_list[type]);
+    info.mVals.resize(kWordNum);
+    info.mDep01 = info0.mDep01 || info1.mDep01;
+    for (ymuint w = 0; w < kWordNum; ++ w) {
+      switch ( type ) {
+      case 0: info.mVals[w] = info0.mVals[w] & info1.mVals[w]; break;
+      case 1: info.mVals[w] = info0.mVals[w] | info1.mVals[w]; break;
+      case 2: info.mVals[w] = info0.mVals[w] ^ info1.mVals[w]; break;
+      }
+    }
+    if ( rpos == 0 ) {
+      first_gate = info.mNode;
+    }
+    node_list.push_back(info);
+    queue.push_back(info);
+    gate_list.push_back(info);
+  }
+
+  NodeInfo o_list[] = { queue.back(), gate_list[gate_list.size() / 2 - 1] };
+  for (ymuint i = 0; i < 2; ++ i) {
+    CmnNode* onode = o_port->_output(i);
+    network.set_output_fanin(onode, o_list[i].mNode);
+    NodeInfo info = o_list[i];
+    info.mNode = onode;
+    node_list.push_back(info);
+  }
+}
+
+// 入力の信号確率とトグル率を設定する．
+// toggle_ratio はトグル率の上限に対する割合
+void
+set_input_prob(CmnSigProb& sp,
+	       const vector<NodeInfo>& node_list,
+	       double toggle_ratio,
+	       vector<double>& prob_list,
+	       vector<double>& toggle_list)
+{
+  prob_list.resize(kInputNum);
+  toggle_list.resize(kInputNum);
+  for (ymuint i = 0; i < kInputNum; ++ i) {
+    double p = 0.8 - 0.08 * i;
+    double max_toggle = 2.0 * (p < 0.5 ? p : 1.0 - p);
+    prob_list[i] = p;
+    toggle_list[i] = max_toggle * toggle_ratio;
+    sp.set_input_prob(node_list[i].mNode, prob_list[i], toggle_list[i]);
+  }
+}
+
+// 全パタンの値から厳密な信号確率とトグル率を求める．
+// 入力ごとの1次のマルコフ連鎖の積で連続する2時刻のパタンの確率を計算する．
+void
+exact_value(const vector<ymuint64>& vals,
+	    const vector<double>& prob_list,
+	    const vector<double>& toggle_list,
+	    double& prob,
+	    double& toggle)
+{
+  prob = 0.0;
+  toggle = 0.0;
+  for (ymuint a = 0; a < kPatNum; ++ a) {
+    bool fa = (vals[a / 64] >> (a % 64)) & 1ULL;
+    for (ymuint b = 0; b < kPatNum; ++ b) {
+      bool fb = (vals[b / 64] >> (b % 64)) & 1ULL;
+      if ( !fa && fa == fb ) {
+	continue;
+      }
+      double w = 1.0;
+      for (ymuint i = 0; i < kInputNum; ++ i) {
+	double p = prob_list[i];
+	double rise = toggle_list[i] / (2.0 * (1.0 - p));
+	double fall = toggle_list[i] / (2.0 * p);
+	bool va = (a >> i) & 1U;
+	bool vb = (b >> i) & 1U;
+	if ( va ) {
+	  w *= p * (vb ? 1.0 - fall : fall);
+	}
+	else {
+	  w *= (1.0 - p) * (vb ? rise : 1.0 - rise);
+	}
+      }
+      if ( fa ) {
+	prob += w;
+      }
+      if ( fa != fb ) {
+	toggle += w;
+      }
+    }
+  }
+}
+
+END_NONAMESPACE
+
+
+TEST(CmnSigProbTest, analyze_tree)
+{
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  // 木構造ではカットの葉が独立なので解析結果は厳密な値と一致する．
+  ymuint cut_param[][2] = { { 8, 32 }, { 2, 1 } };
+  for (ymuint c = 0; c < 2; ++ c) {
+    CmnMgr network;
+    vector<NodeInfo> node_list;
+    CmnNode* first_gate = nullptr;
+    make_tree(network, *library, 0x123456789abcdefULL + c, node_list, first_gate);
+
+    CmnSigProb sp(network);
+    vector<double> prob_list;
+    vector<double> toggle_list;
+    set_input_prob(sp, node_list, 0.3, prob_list, toggle_list);
+    sp.set_cut_param(cut_param[c][0], cut_param[c][1]);
+    sp.analyze();
+
+    for (ymuint i = 0; i < node_list.size(); ++ i) {
+      const NodeInfo& info = node_list[i];
+      double prob;
+      double toggle;
+      exact_value(info.mVals, prob_list, toggle_list, prob, toggle);
+      EXPECT_NEAR( prob, sp.prob(info.mNode), 1.0e-9 )
+	<< "cut#" << c << ", node#" << info.mNode->id();
+      EXPECT_NEAR( toggle, sp.toggle(info.mNode), 1.0e-9 )
+	<< "cut#" << c << ", node#" << info.mNode->id();
+    }
+  }
+
+  delete library;
+}
+
+TEST(CmnSigProbTest, simulate_bound)
+{
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  // 時間的な相関が強い入力でも信頼区間が真の値を含む．
+  ymuint thread_list[] = { 1, 2 };
+  for (ymuint t = 0; t < 2; ++ t) {
+    CmnMgr network;
+    vector<NodeInfo> node_list;
+    CmnNode* first_gate = nullptr;
+    make_tree(network, *library, 0x9e3779b97f4a7c15ULL, node_list, first_gate);
+
+    CmnSigProb sp(network, thread_list[t]);
+    vector<double> prob_list;
+    vector<double> toggle_list;
+    set_input_prob(sp, node_list, 0.1, prob_list, toggle_list);
+    sp.set_mc_param(1U << 20, 0.01, 11);
+    sp.simulate();
+    EXPECT_LT( 0U, sp.pattern_num() );
+
+    for (ymuint i = 0; i < node_list.size(); ++ i) {
+      const NodeInfo& info = node_list[i];
+      double prob;
+      double toggle;
+      exact_value(info.mVals, prob_list, toggle_list, prob, toggle);
+      EXPECT_LE( fabs(prob - sp.prob(info.mNode)), sp.prob_error(info.mNode) * 2.0 )
+	<< "node#" << info.mNode->id();
+      EXPECT_LE( fabs(toggle - sp.toggle(info.mNode)), sp.toggle_error(info.mNode) * 2.0 )
+	<< "node#" << info.mNode->id();
+    }
+  }
+
+  delete library;
+}
+
+TEST(CmnSigProbTest, update_sim)
+{
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  // set_cell() の後の update() は影響を受けるノードのみを計算し直し，
+  // その結果は最初から計算し直した場合と一致する．
+  {
+    CmnMgr network;
+    vector<NodeInfo> node_list;
+    CmnNode* first_gate = nullptr;
+    make_tree(network, *library, 0xfedcba987654321ULL, node_list, first_gate);
+    const Cell* new_cell = (first_gate->cell() == library->cell("XOR2")) ?
+      library->cell("AND2") : library->cell("XOR2");
+
+    CmnSigProb sp(network, 2);
+    vector<double> prob_list;
+    vector<double> toggle_list;
+    set_input_prob(sp, node_list, 0.5, prob_list, toggle_list);
+    sp.set_mc_param(1U << 16, 0.0, 7);
+    sp.simulate();
+    ymuint64 n = sp.pattern_num();
+
+    vector<double> prob0(node_list.size());
+    vector<double> toggle0(node_list.size());
+    for (ymuint i = 0; i < node_list.size(); ++ i) {
+      prob0[i] = sp.prob(node_list[i].mNode);
+      toggle0[i] = sp.toggle(node_list[i].mNode);
+    }
+
+    sp.set_cell(first_gate, new_cell);
+    sp.update();
+    EXPECT_EQ( n, sp.pattern_num() );
+
+    CmnSigProb sp2(network, 2);
+    set_input_prob(sp2, node_list, 0.5, prob_list, toggle_list);
+    sp2.set_mc_param(1U << 16, 0.0, 7);
+    sp2.set_cell(first_gate, new_cell);
+    sp2.simulate();
+    EXPECT_EQ( n, sp2.pattern_num() );
+
+    ymuint changed = 0;
+    for (ymuint i = 0; i < node_list.size(); ++ i) {
+      const NodeInfo& info = node_list[i];
+      const CmnNode* node = info.mNode;
+      EXPECT_EQ( sp2.prob(node), sp.prob(node) ) << "node#" << node->id();
+      EXPECT_EQ( sp2.toggle(node), sp.toggle(node) ) << "node#" << node->id();
+      EXPECT_EQ( sp2.prob_error(node), sp.prob_error(node) ) << "node#" << node->id();
+      EXPECT_EQ( sp2.toggle_error(node), sp.toggle_error(node) ) << "node#" << node->id();
+      if ( !info.mDep01 || node->is_input() ) {
+	// 影響を受けないノード
+	EXPECT_EQ( prob0[i], sp.prob(node) ) << "node#" << node->id();
+	EXPECT_EQ( toggle0[i], sp.toggle(node) ) << "node#" << node->id();
+      }
+      else if ( prob0[i] != sp.prob(node) ) {
+	++ changed;
+      }
+    }
+    EXPECT_LT( 0U, changed );
+  }
+
+  delete library;
+}
+
+END_NAMESPACE_YM_NETWORKS_CMN
@@ -0,0 +1,742 @@
+﻿/// @file CmnStaTest.cc
+/// @brief CmnStaTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmNetworks/CmnMgr.h"
+#include "YmNetworks/CmnPort.h"
+#include "YmNetworks/CmnNode.h"
+#include "YmNetworks/CmnSta.h"
+#include "YmCell/CellDotlibReader.h"
+#include "YmCell/CellLibrary.h"
+#include "YmCell/Cell.h"
+#include "YmUtils/StreamODO.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_CMN
+
+BEGIN_NONAMESPACE
+
+// 遅延や遷移時間を入力の遷移時間 s と負荷容量 l の1次式
+// c[0] + c[1] * s + c[2] * l で表す．
+// 表の補間はこの形の式では厳密になるので，期待値を手で計算できる．
+struct ArcDef
+{
+  double mRise[3];
+
+  double mFall[3];
+
+  double mRiseTransition[3];
+
+  double mFallTransition[3];
+};
+
+// セルの定義
+struct CellDef
+{
+  const char* mName;
+
+  const char* mFunc;
+
+  // タイミングセンス
+  const char* mSense;
+
+  ymuint mInputNum;
+
+  double mCap[2];
+
+  ArcDef mArc[2];
+};
+
+const CellDef kCellList[] = {
+  { "INV", "!A", "negative_unate", 1, { 0.01, 0.0 },
+    { { { 0.10, 0.20, 1.00 }, { 0.08, 0.10, 0.80 },
+	{ 0.05, 0.10, 2.00 }, { 0.04, 0.10, 1.50 } } } },
+  { "INVX2", "!A", "negative_unate", 1, { 0.02, 0.0 },
+    { { { 0.10, 0.20, 0.50 }, { 0.08, 0.10, 0.40 },
+	{ 0.05, 0.10, 1.00 }, { 0.04, 0.10, 0.75 } } } },
+  { "NAND2", "!(A*B)", "negative_unate", 2, { 0.01, 0.02 },
+    { { { 0.12, 0.20, 1.20 }, { 0.10, 0.15, 1.00 },
+	{ 0.06, 0.10, 2.20 }, { 0.05, 0.10, 1.80 } },
+      { { 0.14, 0.25, 1.20 }, { 0.11, 0.15, 1.10 },
+	{ 0.06, 0.10, 2.20 }, { 0.05, 0.10, 1.80 } } } },
+  { "XOR2", "A^B", "non_unate", 2, { 0.01, 0.01 },
+    { { { 0.20, 0.20, 1.00 }, { 0.18, 0.20, 0.90 },
+	{ 0.10, 0.10, 2.00 }, { 0.09, 0.10, 1.90 } },
+      { { 0.22, 0.20, 1.00 }, { 0.19, 0.20, 0.90 },
+	{ 0.10, 0.10, 2.00 }, { 0.09, 0.10, 1.90 } } } },
+};
+
+const ymuint kCellNum = sizeof(kCellList) / sizeof(CellDef);
+
+enum {
+  kInv = 0,
+  kInvX2 = 1,
+  kNand2 = 2,
+  kXor2 = 3
+};
+
+// 1次式の値を求める．
+double
+lin(const double* c,
+    double s,
+    double l)
+{
+  return c[0] + c[1] * s + c[2] * l;
+}
+
+// 1次式を 2x2 の表として書き出す．
+void
+put_table(ostream& s,
+	  const char* name,
+	  const double* c)
+{
+  s << "        " << name << " (t2) {" << endl
+    << "          values (\"" << c[0] << ", " << (c[0] + c[2]) << "\", \""
+    << (c[0] + c[1]) << ", " << (c[0] + c[1] + c[2]) << "\") ;" << endl
+    << "        }" << endl;
+}
+
+// テスト用の liberty ファイルの内容を作る．
+string
+make_library_text()
+{
+  const char* pin_names = "AB";
+  ostringstream buf;
+  buf << "library (sta_lib) {" << endl
+      << "  delay_model : table_lookup ;" << endl
+      << "  time_unit : \"1ns\" ;" << endl
+      << "  capacitive_load_unit (1,pf) ;" << endl
+      << "  lu_table_template (t2) {" << endl
+      << "    variable_1 : input_net_transition ;" << endl
+      << "    variable_2 : total_output_net_capacitance ;" << endl
+      << "    index_1 (\"0.0, 1.0\") ;" << endl
+      << "    index_2 (\"0.0, 1.0\") ;" << endl
+      << "  }" << endl;
+  for (ymuint i = 0; i < kCellNum; ++ i) {
+    const CellDef& def = kCellList[i];
+    buf << "  cell (" << def.mName << ") {" << endl
+	<< "    area : " << (i + 1) << " ;" << endl;
+    for (ymuint j = 0; j < def.mInputNum; ++ j) {
+      buf << "    pin (" << pin_names[j] << ") {" << endl
+	  << "      direction : input ;" << endl
+	  << "      capacitance : " << def.mCap[j] << " ;" << endl
+	  << "    }" << endl;
+    }
+    buf << "    pin (Y) {" << endl
+	<< "      direction : output ;" << endl
+	<< "      function : \"" << def.mFunc << "\" ;" << endl;
+    for (ymuint j = 0; j < def.mInputNum; ++ j) {
+      const ArcDef& arc = def.mArc[j];
+      buf << "      timing () {" << endl
+	  << "        related_pin : \"" << pin_names[j] << "\" ;" << endl
+	  << "        timing_sense : " << def.mSense << " ;" << endl;
+      put_table(buf, "cell_rise", arc.mRise);
+      put_table(buf, "cell_fall", arc.mFall);
+      put_table(buf, "rise_transition", arc.mRiseTransition);
+      put_table(buf, "fall_transition", arc.mFallTransition);
+      buf << "      }" << endl;
+    }
+    buf << "    }" << endl
+	<< "  }" << endl;
+  }
+  buf << "}" << endl;
+  return buf.str();
+}
+
+// テスト用のセルライブラリを読み込む．
+const CellLibrary*
+read_library()
+{
+  string filename = ::testing::TempDir() + "CmnStaTest.lib";
+  {
+    ofstream ofs(filename.c_str());
+    ofs << make_library_text();
+  }
+  CellDotlibReader read;
+  const CellLibrary* library = read(filename);
+  remove(filename.c_str());
+  return library;
+}
+
+// 簡単な擬似乱数
+ymuint64
+next_rand(ymuint64& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// ノードの到着時刻と遷移時間
+// 0 が立ち上がり，1 が立ち下がり
+struct Timing
+{
+  double mArr[2];
+
+  double mSlew[2];
+};
+
+// 入力の遷移 i から出力の遷移 o へのアークがある時 true を返す．
+bool
+has_arc(const CellDef& def,
+	ymuint i,
+	ymuint o)
+{
+  if ( def.mSense == string("negative_unate") ) {
+    return i != o;
+  }
+  return true;
+}
+
+// アークの遅延
+double
+arc_delay(const ArcDef& arc,
+	  ymuint o,
+	  double slew,
+	  double load)
+{
+  return lin(o == 0 ? arc.mRise : arc.mFall, slew, load);
+}
+
+// アークの出力の遷移時間
+double
+arc_slew(const ArcDef& arc,
+	 ymuint o,
+	 double slew,
+	 double load)
+{
+  return lin(o == 0 ? arc.mRiseTransition : arc.mFallTransition, slew, load);
+}
+
+// セルの出力の到着時刻と遷移時間を求める．
+// 到着時刻はアークごとの最大値，遷移時間もアークごとの最大値とする．
+Timing
+cell_timing(const CellDef& def,
+	    const Timing* in_list,
+	    double load)
+{
+  Timing out;
+  for (ymuint o = 0; o < 2; ++ o) {
+    out.mArr[o] = -1.0e100;
+    out.mSlew[o] = 0.0;
+    for (ymuint j = 0; j < def.mInputNum; ++ j) {
+      for (ymuint i = 0; i < 2; ++ i) {
+	if ( !has_arc(def, i, o) ) {
+	  continue;
+	}
+	const Timing& in = in_list[j];
+	double arr = in.mArr[i] + arc_delay(def.mArc[j], o, in.mSlew[i], load);
+	double slew = arc_slew(def.mArc[j], o, in.mSlew[i], load);
+	if ( out.mArr[o] < arr ) {
+	  out.mArr[o] = arr;
+	}
+	if ( out.mSlew[o] < slew ) {
+	  out.mSlew[o] = slew;
+	}
+      }
+    }
+  }
+  return out;
+}
+
+// ファンアウト先のセルのアークを通した要求時刻を req に反映させる．
+void
+back_required(const CellDef& def,
+	      ymuint ipos,
+	      const Timing& in,
+	      double load,
+	      const double* oreq,
+	      double* req)
+{
+  for (ymuint i = 0; i < 2; ++ i) {
+    for (ymuint o = 0; o < 2; ++ o) {
+      if ( !has_arc(def, i, o) ) {
+	continue;
+      }
+      double t = oreq[o] - arc_delay(def.mArc[ipos], o, in.mSlew[i], load);
+      if ( req[i] > t ) {
+	req[i] = t;
+      }
+    }
+  }
+}
+
+// 手計算用の小さな回路
+//
+//  n1 = INV(a)
+//  n2 = NAND2(n1, b)
+//  n3 = INV(n2)
+//  n4 = XOR2(n3, c)
+//  y = n4, z = n2
+struct SmallCircuit
+{
+  // a, b, c, n1, n2, n3, n4, y, z の順
+  const CmnNode* mNodeList[9];
+};
+
+const ymuint kA = 0;
+const ymuint kB = 1;
+const ymuint kC = 2;
+const ymuint kN1 = 3;
+const ymuint kN2 = 4;
+const ymuint kN3 = 5;
+const ymuint kN4 = 6;
+const ymuint kY = 7;
+const ymuint kZ = 8;
+
+// 小さな回路を作る．
+void
+make_small(CmnMgr& network,
+	   const CellLibrary& library,
+	   SmallCircuit& circuit)
+{
+  CmnPort* i_port = network.new_input_port("i", 3);
+  CmnPort* o_port = network.new_output_port("o", 2);
+  CmnNode* a = i_port->_input(0);
+  CmnNode* b = i_port->_input(1);
+  CmnNode* c = i_port->_input(2);
+  vector<CmnNode*> inodes(1, a);
+  CmnNode* n1 = network.new_logic(inodes, library.cell("INV"));
+  inodes.clear();
+  inodes.push_back(n1);
+  inodes.push_back(b);
+  CmnNode* n2 = network.new_logic(inodes, library.cell("NAND2"));
+  inodes.clear();
+  inodes.push_back(n2);
+  CmnNode* n3 = network.new_logic(inodes, library.cell("INV"));
+  inodes.clear();
+  inodes.push_back(n3);
+  inodes.push_back(c);
+  CmnNode* n4 = network.new_logic(inodes, library.cell("XOR2"));
+  CmnNode* y = o_port->_output(0);
+  CmnNode* z = o_port->_output(1);
+  network.set_output_fanin(y, n4);
+  network.set_output_fanin(z, n2);
+
+  circuit.mNodeList[kA] = a;
+  circuit.mNodeList[kB] = b;
+  circuit.mNodeList[kC] = c;
+  circuit.mNodeList[kN1] = n1;
+  circuit.mNodeList[kN2] = n2;
+  circuit.mNodeList[kN3] = n3;
+  circuit.mNodeList[kN4] = n4;
+  circuit.mNodeList[kY] = y;
+  circuit.mNodeList[kZ] = z;
+}
+
+// 小さな回路の条件を設定する．
+void
+set_small_cond(CmnSta& sta,
+	       const SmallCircuit& circuit)
+{
+  const CmnNode* const* nl = circuit.mNodeList;
+  sta.set_input_arrival(nl[kA], 0.0, 0.0);
+  sta.set_input_arrival(nl[kB], 0.2, 0.1);
+  sta.set_input_arrival(nl[kC], 0.5, 0.6);
+  sta.set_input_transition(nl[kA], 0.1, 0.2);
+  sta.set_input_transition(nl[kB], 0.3, 0.3);
+  sta.set_input_transition(nl[kC], 0.05, 0.15);
+  sta.set_output_load(nl[kY], 0.05);
+  sta.set_output_load(nl[kZ], 0.1);
+  sta.set_output_required(nl[kZ], 1.0, 1.2);
+  sta.set_default_required(3.0);
+  vector<double> cap_list(3);
+  cap_list[0] = 0.0;
+  cap_list[1] = 0.01;
+  cap_list[2] = 0.02;
+  sta.set_wire_load(cap_list, 0.01);
+}
+
+// 小さな回路の期待値
+struct SmallExpected
+{
+  double mLoad[9];
+
+  Timing mTiming[9];
+
+  double mReq[9][2];
+};
+
+// 小さな回路の期待値を手計算する．
+// n1 と n3 のセルは cell1, cell3 とする．
+void
+calc_small(ymuint cell1,
+	   ymuint cell3,
+	   SmallExpected& exp)
+{
+  const CellDef& inv1 = kCellList[cell1];
+  const CellDef& inv3 = kCellList[cell3];
+  const CellDef& nand2 = kCellList[kNand2];
+  const CellDef& xor2 = kCellList[kXor2];
+
+  // 負荷容量 = 配線容量 + ファンアウト先のピン容量(+ 出力の負荷)
+  double* L = exp.mLoad;
+  L[kA] = 0.01 + inv1.mCap[0];
+  L[kB] = 0.01 + nand2.mCap[1];
+  L[kC] = 0.01 + xor2.mCap[1];
+  L[kN1] = 0.01 + nand2.mCap[0];
+  L[kN2] = 0.02 + inv3.mCap[0] + 0.1;
+  L[kN3] = 0.01 + xor2.mCap[0];
+  L[kN4] = 0.01 + 0.05;
+  L[kY] = 0.0;
+  L[kZ] = 0.0;
+
+  // 到着時刻と遷移時間
+  Timing* T = exp.mTiming;
+  Timing a = { { 0.0, 0.0 }, { 0.1, 0.2 } };
+  Timing b = { { 0.2, 0.1 }, { 0.3, 0.3 } };
+  Timing c = { { 0.5, 0.6 }, { 0.05, 0.15 } };
+  T[kA] = a;
+  T[kB] = b;
+  T[kC] = c;
+  T[kN1] = cell_timing(inv1, &T[kA], L[kN1]);
+  Timing in2[] = { T[kN1], T[kB] };
+  T[kN2] = cell_timing(nand2, in2, L[kN2]);
+  T[kN3] = cell_timing(inv3, &T[kN2], L[kN3]);
+  Timing in4[] = { T[kN3], T[kC] };
+  T[kN4] = cell_timing(xor2, in4, L[kN4]);
+  T[kY] = T[kN4];
+  T[kZ] = T[kN2];
+
+  // 要求時刻
+  double (*R)[2] = exp.mReq;
+  for (ymuint i = 0; i < 9; ++ i) {
+    R[i][0] = R[i][1] = 1.0e100;
+  }
+  R[kY][0] = R[kY][1] = 3.0;
+  R[kZ][0] = 1.0;
+  R[kZ][1] = 1.2;
+  R[kN4][0] = R[kY][0];
+  R[kN4][1] = R[kY][1];
+  back_required(xor2, 0, T[kN3], L[kN4], R[kN4], R[kN3]);
+  back_required(xor2, 1, T[kC], L[kN4], R[kN4], R[kC]);
+  R[kN2][0] = R[kZ][0];
+  R[kN2][1] = R[kZ][1];
+  back_required(inv3, 0, T[kN2], L[kN3], R[kN3], R[kN2]);
+  back_required(nand2, 0, T[kN1], L[kN2], R[kN2], R[kN1]);
+  back_required(nand2, 1, T[kB], L[kN2], R[kN2], R[kB]);
+  back_required(inv1, 0, T[kA], L[kN1], R[kN1], R[kA]);
+}
+
+// 小さな回路の結果を確かめる．
+void
+check_small(const CmnSta& sta,
+	    const SmallCircuit& circuit,
+	    const SmallExpected& exp)
+{
+  const double kEps = 1.0e-9;
+  for (ymuint i = 0; i < 9; ++ i) {
+    const CmnNode* node = circuit.mNodeList[i];
+    if ( i < kY ) {
+      EXPECT_NEAR( exp.mLoad[i], sta.load(node), kEps ) << "node#" << i;
+    }
+    for (ymuint o = 0; o < 2; ++ o) {
+      bool rise = (o == 0);
+      EXPECT_NEAR( exp.mTiming[i].mArr[o], sta.arrival(node, rise), kEps )
+	<< "node#" << i << ", rise = " << rise;
+      EXPECT_NEAR( exp.mTiming[i].mSlew[o], sta.transition(node, rise), kEps )
+	<< "node#" << i << ", rise = " << rise;
+      EXPECT_NEAR( exp.mReq[i][o], sta.required(node, rise), kEps )
+	<< "node#" << i << ", rise = " << rise;
+      EXPECT_NEAR( exp.mReq[i][o] - exp.mTiming[i].mArr[o], sta.slack(node, rise), kEps )
+	<< "node#" << i << ", rise = " << rise;
+    }
+  }
+
+  double worst = 1.0e100;
+  for (ymuint i = kY; i <= kZ; ++ i) {
+    for (ymuint o = 0; o < 2; ++ o) {
+      double s = exp.mReq[i][o] - exp.mTiming[i].mArr[o];
+      if ( worst > s ) {
+	worst = s;
+      }
+    }
+  }
+  EXPECT_NEAR( worst, sta.worst_slack(), kEps );
+
+  vector<CmnStaPath> path_list;
+  sta.critical_paths(1, path_list);
+  ASSERT_EQ( 1U, path_list.size() );
+  const CmnStaPath& path = path_list[0];
+  EXPECT_NEAR( worst, path.mSlack, kEps );
+  ASSERT_LE( 2U, path.mNodeList.size() );
+  EXPECT_TRUE( path.mNodeList.front()->is_input() );
+  EXPECT_TRUE( path.mNodeList.back()->is_output() );
+  EXPECT_EQ( path.mNodeList.size(), path.mRiseList.size() );
+}
+
+// ランダムな回路を作る．
+// 並列処理が起こるように1つのレベルに十分な数のノードを作る．
+void
+make_random(CmnMgr& network,
+	    const CellLibrary& library,
+	    ymuint64 seed)
+{
+  const ymuint ni = 600;
+  const ymuint ng = 3000;
+  const ymuint no = 100;
+  CmnPort* i_port = network.new_input_port("i", ni);
+  CmnPort* o_port = network.new_output_port("o", no);
+  vector<CmnNode*> pool;
+  for (ymuint i = 0; i < ni; ++ i) {
+    pool.push_back(i_port->_input(i));
+  }
+  for (ymuint i = 0; i < ng; ++ i) {
+    const CellDef& def = kCellList[next_rand(seed) % kCellNum];
+    vector<CmnNode*> inodes;
+    for (ymuint j = 0; j < def.mInputNum; ++ j) {
+      inodes.push_back(pool[next_rand(seed) % pool.size()]);
+    }
+    pool.push_back(network.new_logic(inodes, library.cell(def.mName)));
+  }
+  for (ymuint i = 0; i < no; ++ i) {
+    CmnNode* inode = pool[pool.size() - 1 - (next_rand(seed) % (ng / 2))];
+    network.set_output_fanin(o_port->_output(i), inode);
+  }
+}
+
+// ランダムな回路の条件を設定する．
+void
+set_random_cond(CmnSta& sta,
+		const CmnMgr& network,
+		ymuint64 seed)
+{
+  const CmnNodeList& input_list = network.input_list();
+  for (CmnNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    double r = (next_rand(seed) % 100) * 0.01;
+    double f = (next_rand(seed) % 100) * 0.01;
+    sta.set_input_arrival(*p, r, f);
+    sta.set_input_transition(*p, r * 0.2, f * 0.2);
+  }
+  vector<double> cap_list(4);
+  for (ymuint i = 0; i < 4; ++ i) {
+    cap_list[i] = 0.005 * i;
+  }
+  sta.set_wire_load(cap_list, 0.002);
+}
+
+// ノードのリストを得る．
+void
+all_nodes(const CmnMgr& network,
+	  vector<const CmnNode*>& node_list)
+{
+  node_list.clear();
+  const CmnNodeList& input_list = network.input_list();
+  for (CmnNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    node_list.push_back(*p);
+  }
+  vector<const CmnNode*> logic_list;
+  network.sort(logic_list);
+  node_list.insert(node_list.end(), logic_list.begin(), logic_list.end());
+  const CmnNodeList& output_list = network.output_list();
+  for (CmnNodeList::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    node_list.push_back(*p);
+  }
+}
+
+// 二つの結果が等しいことを確かめる．
+// node_list1 と node_list2 は対応するノードのリスト
+void
+check_same(const CmnSta& sta1,
+	   const vector<const CmnNode*>& node_list1,
+	   const CmnSta& sta2,
+	   const vector<const CmnNode*>& node_list2)
+{
+  ASSERT_EQ( node_list1.size(), node_list2.size() );
+  for (ymuint i = 0; i < node_list1.size(); ++ i) {
+    const CmnNode* node1 = node_list1[i];
+    const CmnNode* node2 = node_list2[i];
+    ASSERT_EQ( node1->id(), node2->id() );
+    EXPECT_DOUBLE_EQ( sta1.load(node1), sta2.load(node2) ) << "node#" << node1->id();
+    for (ymuint o = 0; o < 2; ++ o) {
+      bool rise = (o == 0);
+      EXPECT_DOUBLE_EQ( sta1.arrival(node1, rise), sta2.arrival(node2, rise) )
+	<< "node#" << node1->id();
+      EXPECT_DOUBLE_EQ( sta1.transition(node1, rise), sta2.transition(node2, rise) )
+	<< "node#" << node1->id();
+      EXPECT_DOUBLE_EQ( sta1.required(node1, rise), sta2.required(node2, rise) )
+	<< "node#" << node1->id();
+    }
+  }
+}
+
+END_NONAMESPACE
+
+
+TEST(CmnStaTest, small_circuit)
+{
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  {
+    CmnMgr network;
+    SmallCircuit circuit;
+    make_small(network, *library, circuit);
+
+    CmnSta sta(network);
+    set_small_cond(sta, circuit);
+    sta.update();
+
+    SmallExpected exp;
+    calc_small(kInv, kInv, exp);
+    check_small(sta, circuit, exp);
+  }
+
+  delete library;
+}
+
+TEST(CmnStaTest, small_incr_update)
+{
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  {
+    CmnMgr network;
+    SmallCircuit circuit;
+    make_small(network, *library, circuit);
+
+    CmnSta sta(network);
+    set_small_cond(sta, circuit);
+    sta.update();
+
+    // n1 と n3 のインバータを大きくする．
+    const Cell* inv2 = library->cell("INVX2");
+    sta.set_cell(circuit.mNodeList[kN1], inv2);
+    sta.set_cell(circuit.mNodeList[kN3], inv2);
+    sta.update();
+    EXPECT_EQ( inv2, sta.cell(circuit.mNodeList[kN1]) );
+
+    SmallExpected exp;
+    calc_small(kInvX2, kInvX2, exp);
+    check_small(sta, circuit, exp);
+
+    // 元に戻す．
+    const Cell* inv = library->cell("INV");
+    sta.set_cell(circuit.mNodeList[kN1], inv);
+    sta.update();
+    calc_small(kInv, kInvX2, exp);
+    check_small(sta, circuit, exp);
+  }
+
+  delete library;
+}
+
+TEST(CmnStaTest, random_incr_update)
+{
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  {
+    CmnMgr network;
+    make_random(network, *library, 0x123456789abcdefULL);
+    vector<const CmnNode*> node_list;
+    all_nodes(network, node_list);
+    const CmnNodeList& logic_list = network.logic_list();
+    vector<const CmnNode*> inv_list;
+    for (CmnNodeList::const_iterator p = logic_list.begin();
+	 p != logic_list.end(); ++ p) {
+      if ( (*p)->fanin_num() == 1 ) {
+	inv_list.push_back(*p);
+      }
+    }
+    ASSERT_FALSE( inv_list.empty() );
+
+    CmnSta sta(network, 4);
+    set_random_cond(sta, network, 0x2545f4914f6cdd1dULL);
+    sta.update();
+
+    // 1スレッドで計算した結果と一致する．
+    {
+      CmnSta sta1(network, 1);
+      set_random_cond(sta1, network, 0x2545f4914f6cdd1dULL);
+      sta1.update();
+      check_same(sta, node_list, sta1, node_list);
+    }
+
+    // インバータのサイズを変えながら update() を繰り返す．
+    // 差分の計算の結果は最初から計算し直した結果と一致する．
+    const Cell* inv_cell[] = { library->cell("INV"), library->cell("INVX2") };
+    vector<const Cell*> cur_cell(network.max_node_id(), nullptr);
+    ymuint64 seed = 0xfedcba987654321ULL;
+    for (ymuint r = 0; r < 10; ++ r) {
+      for (ymuint k = 0; k < 5; ++ k) {
+	const CmnNode* node = inv_list[next_rand(seed) % inv_list.size()];
+	const Cell* cell = inv_cell[next_rand(seed) % 2];
+	sta.set_cell(node, cell);
+	cur_cell[node->id()] = cell;
+      }
+      sta.update();
+
+      CmnSta sta2(network, 4);
+      set_random_cond(sta2, network, 0x2545f4914f6cdd1dULL);
+      for (ymuint i = 0; i < cur_cell.size(); ++ i) {
+	if ( cur_cell[i] != nullptr ) {
+	  sta2.set_cell(network.node(i), cur_cell[i]);
+	}
+      }
+      sta2.update();
+      check_same(sta, node_list, sta2, node_list);
+    }
+  }
+
+  delete library;
+}
+
+TEST(CmnStaTest, mapped_library)
+{
+  // restore_mapped() で読み込んだライブラリではタイミング情報が
+  // 並列処理の中で読み込まれる．
+  const CellLibrary* library = read_library();
+  ASSERT_TRUE( library != nullptr );
+
+  string filename = ::testing::TempDir() + "CmnStaTest.mapped";
+  {
+    ofstream ofs(filename.c_str(), ios::binary);
+    StreamODO odo(ofs);
+    library->dump_mapped(odo);
+  }
+
+  for (ymuint r = 0; r < 5; ++ r) {
+    CellLibrary* library2 = CellLibrary::new_obj();
+    ASSERT_TRUE( library2->restore_mapped(filename) );
+
+    {
+      CmnMgr network1;
+      make_random(network1, *library, 0x9e3779b97f4a7c15ULL);
+      vector<const CmnNode*> node_list1;
+      all_nodes(network1, node_list1);
+      CmnSta sta1(network1, 1);
+      set_random_cond(sta1, network1, 0x123456789ULL);
+      sta1.update();
+
+      CmnMgr network2;
+      make_random(network2, *library2, 0x9e3779b97f4a7c15ULL);
+      vector<const CmnNode*> node_list2;
+      all_nodes(network2, node_list2);
+      CmnSta sta2(network2, 8);
+      set_random_cond(sta2, network2, 0x123456789ULL);
+      sta2.update();
+
+      check_same(sta1, node_list1, sta2, node_list2);
+    }
+
+    delete library2;
+  }
+  remove(filename.c_str());
+
+  delete library;
+}
+
+END_NAMESPACE_YM_NETWORKS_CMN
@@ -0,0 +1,180 @@
+﻿#ifndef BLOCKIO_H
+#define BLOCKIO_H
+
+/// @file BlockIO.h
+/// @brief ymuint32 の配列をまとめて読み書きする関数
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmTools.h"
+#include "YmUtils/IDO.h"
+#include "YmUtils/ODO.h"
+
+
+BEGIN_NAMESPACE_YM
+
+/// @brief ymuint32 の配列を一つのブロックとして書き出す．
+/// @param[in] s 出力先のストリーム
+/// @param[in] block 書き出す配列
+///
+/// 要素数に続けて各要素をリトルエンディアンで書き出す．
+/// 要素ごとに ODO を呼び出さずに一回の write() で済ませる．
+inline
+void
+dump_block(ODO& s,
+	   const vector<ymuint32>& block)
+{
+  ymuint32 n = block.size();
+  s << n;
+  if ( n == 0 ) {
+    return;
+  }
+  vector<ymuint8> buff(n * 4);
+  for (ymuint i = 0; i < n; ++ i) {
+    ymuint32 val = block[i];
+    buff[i * 4 + 0] = val & 255U; val >>= 8;
+    buff[i * 4 + 1] = val & 255U; val >>= 8;
+    buff[i * 4 + 2] = val & 255U; val >>= 8;
+    buff[i * 4 + 3] = val & 255U;
+  }
+  s.write(&buff[0], n * 4);
+}
+
+/// @brief dump_block() で書き出した配列を読み込む．
+/// @param[in] s 入力元のストリーム
+/// @param[out] block 読み込んだ配列を格納する変数
+/// @return 読み込みが成功したら true を返す．
+inline
+bool
+restore_block(IDO& s,
+	      vector<ymuint32>& block)
+{
+  ymuint32 n;
+  s >> n;
+  block.clear();
+  if ( n == 0 ) {
+    return true;
+  }
+  // read() は一度に全部を読めるとは限らない．
+  // 壊れたデータで巨大な領域を確保しないように少しずつ広げながら読む．
+  const ymuint64 kChunkSize = 1U << 16;
+  ymuint64 size = static_cast<ymuint64>(n) * 4;
+  vector<ymuint8> buff;
+  for (ymuint64 pos = 0; pos < size; ) {
+    if ( pos == buff.size() ) {
+      ymuint64 new_size = pos + kChunkSize;
+      buff.resize(new_size < size ? new_size : size);
+    }
+    ymint64 rsize = s.read(&buff[pos], buff.size() - pos);
+    if ( rsize <= 0 ) {
+      return false;
+    }
+    pos += rsize;
+  }
+  block.resize(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    block[i] =
+      static_cast<ymuint32>(buff[i * 4 + 0]) |
+      (static_cast<ymuint32>(buff[i * 4 + 1]) << 8) |
+      (static_cast<ymuint32>(buff[i * 4 + 2]) << 16) |
+      (static_cast<ymuint32>(buff[i * 4 + 3]) << 24);
+  }
+  return true;
+}
+
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class BlockIdChecker BlockIO.h "BlockIO.h"
+/// @brief restore() で読み込んだ ID 番号の整合性を調べるクラス
+///
+/// restore() はノードを生成する順に ID 番号を並べた配列を用いる．
+/// 各 ID 番号に生成されるノードの種類を記録しておき，ファンインなどが
+/// 存在するノードを指しているかを調べられるようにする．
+/// 種類は 0 が未使用で，それ以外の値の意味は使う側で決める．
+//////////////////////////////////////////////////////////////////////
+class BlockIdChecker
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] id_block ノードを生成する順の ID 番号の配列
+  /// @param[in] max_id ID 番号の上限
+  ///
+  /// max_id 以上の ID 番号は set_next() でエラーとなる．
+  BlockIdChecker(const vector<ymuint32>& id_block,
+		 ymuint32 max_id) :
+    mIdBlock(id_block),
+    mPos(0)
+  {
+    // 配列の大きさは実際に現れる ID 番号で決める．
+    ymuint32 n = 0;
+    for (ymuint i = 0; i < id_block.size(); ++ i) {
+      ymuint32 id = id_block[i];
+      if ( id < max_id && n <= id ) {
+	n = id + 1;
+      }
+    }
+    mKindArray.resize(n, 0U);
+  }
+
+  /// @brief 次に生成されるノードの種類を設定する．
+  /// @param[in] kind 種類 ( 0 以外 )
+  /// @return ID 番号が足りないか範囲外か重複していたら false を返す．
+  bool
+  set_next(ymuint8 kind)
+  {
+    if ( mPos >= mIdBlock.size() ) {
+      return false;
+    }
+    ymuint32 id = mIdBlock[mPos];
+    ++ mPos;
+    if ( id >= mKindArray.size() || mKindArray[id] != 0U ) {
+      return false;
+    }
+    mKindArray[id] = kind;
+    return true;
+  }
+
+  /// @brief ID 番号のノードの種類を返す．
+  /// @param[in] id ID 番号
+  /// @note 範囲外の場合や未使用の場合は 0 を返す．
+  ymuint8
+  kind(ymuint32 id) const
+  {
+    if ( id >= mKindArray.size() ) {
+      return 0U;
+    }
+    return mKindArray[id];
+  }
+
+  /// @brief すべての ID 番号を使い切っていたら true を返す．
+  bool
+  is_end() const
+  {
+    return mPos == mIdBlock.size();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードを生成する順の ID 番号の配列
+  const vector<ymuint32>& mIdBlock;
+
+  // mIdBlock 中の次の位置
+  ymuint mPos;
+
+  // ID 番号ごとのノードの種類
+  vector<ymuint8> mKindArray;
+
+};
+
+END_NAMESPACE_YM
+
+#endif // BLOCKIO_H
@@ -0,0 +1,232 @@
+﻿#ifndef RWTLIB_H
+#define RWTLIB_H
+
+/// @file RwtLib.h
+/// @brief RwtLib のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/bdn.h"
+#include "YmLogic/NpnMgr.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+/// @class RwtGraph RwtLib.h "RwtLib.h"
+/// @brief 4入力関数を実現する部分グラフを表すクラス
+///
+/// 各ノードは AND か XOR で，ファンインはリテラル番号で表す．
+/// リテラル番号は (インデックス << 1) | 反転属性 で
+/// インデックスの意味は以下のとおり
+/// - 0      : 定数0
+/// - 1 〜 4 : 入力0 〜 入力3
+/// - 5 〜   : ノード0 〜
+//////////////////////////////////////////////////////////////////////
+class RwtGraph
+{
+  friend class RwtLib;
+
+public:
+
+  /// @brief ノード数を得る．
+  ymuint
+  node_num() const;
+
+  /// @brief ノードが XOR の時 true を返す．
+  /// @param[in] pos ノード番号 ( 0 <= pos < node_num() )
+  bool
+  is_xor(ymuint pos) const;
+
+  /// @brief ノードのファンインのリテラルを得る．
+  /// @param[in] pos ノード番号 ( 0 <= pos < node_num() )
+  /// @param[in] fpos ファンイン番号 ( 0 or 1 )
+  ymuint
+  fanin(ymuint pos,
+	ymuint fpos) const;
+
+  /// @brief 出力のリテラルを得る．
+  ymuint
+  output() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードの情報を収める配列
+  // 1ノードあたり3要素 (XORフラグ，ファンイン0，ファンイン1) を使う．
+  vector<ymuint32> mNodeArray;
+
+  // 出力のリテラル
+  ymuint32 mOutput;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class RwtMatch RwtLib.h "RwtLib.h"
+/// @brief 4入力関数と RwtGraph の対応を表す構造体
+///
+/// RwtGraph の入力 j には葉 mLeafPos[j] の mLeafInv[j] を与え，
+/// 出力を mOutputInv で反転すると元の関数になる．
+//////////////////////////////////////////////////////////////////////
+struct RwtMatch
+{
+  // 部分グラフ
+  const RwtGraph* mGraph;
+
+  // 部分グラフの入力に対応する葉の位置
+  ymuint8 mLeafPos[4];
+
+  // 部分グラフの入力に対応する葉の極性
+  bool mLeafInv[4];
+
+  // 出力の極性
+  bool mOutputInv;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class RwtLib RwtLib.h "RwtLib.h"
+/// @brief 4入力の NPN 同値類ごとの部分グラフを管理するクラス
+///
+/// 真理値表は16ビットの整数で表し，ビット位置の i ビットめが
+/// 入力 i の値に対応する．
+/// 222個の NPN 同値類すべてについて AND/XOR ノード数が最小の部分グラフを
+/// rwtgen で求めたテーブル(rwt_table)を持っており，コンストラクタで
+/// NpnMgr の代表関数に対する部分グラフに変換しておく．
+/// そのため結果は参照の順序によらない．
+//////////////////////////////////////////////////////////////////////
+class RwtLib
+{
+public:
+
+  /// @brief コンストラクタ
+  RwtLib();
+
+  /// @brief デストラクタ
+  ~RwtLib();
+
+
+public:
+
+  /// @brief 関数に対応する部分グラフを求める．
+  /// @param[in] func 対象の関数の真理値表
+  /// @param[out] match 結果を格納する構造体
+  void
+  match(ymuint func,
+	RwtMatch& match);
+
+  /// @brief 部分グラフの数を返す．
+  ymuint
+  graph_num() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief NPN 正規化を行う．
+  /// @param[in] func 対象の関数の真理値表
+  /// @return 正規化の結果をパックしたものを返す．
+  ymuint32
+  cannonical(ymuint func);
+
+  /// @brief テーブルの部分グラフを代表関数に対する部分グラフに変換する．
+  /// @param[in] table テーブル上の部分グラフの先頭
+  /// @return 次の部分グラフの先頭を返す．
+  const ymuint16*
+  load_graph(const ymuint16* table);
+
+  /// @brief ノードをグラフに追加する．
+  /// @param[in] is_xor XOR の時 true にするフラグ
+  /// @param[in] lit0, lit1 ファンインのリテラル
+  /// @param[in] graph 対象のグラフ
+  /// @return 出力のリテラルを返す．
+  /// @note 同じノードがすでにあればそれを返す．
+  ymuint
+  new_node(bool is_xor,
+	   ymuint lit0,
+	   ymuint lit1,
+	   RwtGraph* graph);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // NPN 正規化を行うオブジェクト
+  NpnMgr mNpnMgr;
+
+  // 正規化の結果のキャッシュ
+  // 真理値表をキーにする．
+  vector<ymuint32> mNpnCache;
+
+  // 代表関数をキーにして部分グラフを収める配列
+  vector<RwtGraph*> mGraphArray;
+
+  // 部分グラフ数
+  ymuint32 mGraphNum;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ノード数を得る．
+inline
+ymuint
+RwtGraph::node_num() const
+{
+  return mNodeArray.size() / 3;
+}
+
+// @brief ノードが XOR の時 true を返す．
+// @param[in] pos ノード番号 ( 0 <= pos < node_num() )
+inline
+bool
+RwtGraph::is_xor(ymuint pos) const
+{
+  return static_cast<bool>(mNodeArray[pos * 3 + 0]);
+}
+
+// @brief ノードのファンインのリテラルを得る．
+// @param[in] pos ノード番号 ( 0 <= pos < node_num() )
+// @param[in] fpos ファンイン番号 ( 0 or 1 )
+inline
+ymuint
+RwtGraph::fanin(ymuint pos,
+		ymuint fpos) const
+{
+  return mNodeArray[pos * 3 + 1 + (fpos & 1U)];
+}
+
+// @brief 出力のリテラルを得る．
+inline
+ymuint
+RwtGraph::output() const
+{
+  return mOutput;
+}
+
+// @brief 部分グラフの数を返す．
+inline
+ymuint
+RwtLib::graph_num() const
+{
+  return mGraphNum;
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
+
+#endif // RWTLIB_H
@@ -0,0 +1,366 @@
+﻿
+/// @file BdnBmc.cc
+/// @brief BdnBmc の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/BdnBmc.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnDff.h"
+#include "YmNetworks/BdnLatch.h"
+#include "BdnUnroller.h"
+#include <thread>
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+// prove_mt() のスレッド間で共有する情報
+//////////////////////////////////////////////////////////////////////
+struct BdnBmc::MtState
+{
+  // 以下のメンバを保護する mutex
+  std::mutex mMutex;
+
+  // 結論が出た時 true となるフラグ
+  bool mDone;
+
+  // 結論
+  Bool3 mResult;
+
+  // BMC で反例がないことを確かめた深さの数
+  ymuint32 mBmcDepth;
+
+  // 帰納ステップが成り立った k (0 の時はまだ)
+  ymuint32 mIndK;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BdnBmc
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] sat_type SAT ソルバの種類
+// @param[in] sat_option SAT ソルバのオプション
+BdnBmc::BdnBmc(const BdnMgr& network,
+	       const string& sat_type,
+	       const string& sat_option) :
+  mNetwork(network),
+  mSatType(sat_type),
+  mSatOption(sat_option),
+  mBmcFrames(nullptr),
+  mIndFrames(nullptr),
+  mDepth(0),
+  mHasCex(false)
+{
+  // 状態変数は BdnReach と同じく D-FF, ラッチの順に並べる．
+  const BdnDffList& dff_list = mNetwork.dff_list();
+  for (BdnDffList::const_iterator p = dff_list.begin();
+       p != dff_list.end(); ++ p) {
+    const BdnDff* dff = *p;
+    mStateList.push_back(dff->output());
+  }
+  const BdnLatchList& latch_list = mNetwork.latch_list();
+  for (BdnLatchList::const_iterator p = latch_list.begin();
+       p != latch_list.end(); ++ p) {
+    const BdnLatch* latch = *p;
+    mStateList.push_back(latch->output());
+  }
+
+  const BdnNodeList& input_list = mNetwork.input_list();
+  for (BdnNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    const BdnNode* node = *p;
+    if ( node->input_type() == BdnNode::kPRIMARY_INPUT ) {
+      mInputList.push_back(node);
+    }
+  }
+
+  mInitList.resize(mStateList.size(), kB3False);
+}
+
+// @brief デストラクタ
+BdnBmc::~BdnBmc()
+{
+  delete mBmcFrames;
+  delete mIndFrames;
+}
+
+// @brief 状態変数の初期値を設定する．
+// @param[in] pos 状態変数の位置番号 ( 0 <= pos < state_num() )
+// @param[in] val 初期値
+void
+BdnBmc::set_init(ymuint pos,
+		 Bool3 val)
+{
+  ASSERT_COND( pos < state_num() );
+  if ( mInitList[pos] != val ) {
+    mInitList[pos] = val;
+    // 初期状態の制約は節として追加済みなので作り直す．
+    delete mBmcFrames;
+    mBmcFrames = nullptr;
+  }
+}
+
+// @brief 有界モデル検査を行う．
+// @param[in] bad 不正状態を表すノード
+// @param[in] max_depth 調べる深さの上限
+Bool3
+BdnBmc::bmc(const BdnNode* bad,
+	    ymuint max_depth)
+{
+  mDepth = 0;
+  mHasCex = false;
+  for (ymuint d = 0; d <= max_depth; ++ d) {
+    // 以前の prove() で中止されたままになっていることがあるので
+    // 毎回取り消しておく．
+    bmc_frames().clear_stop();
+    Bool3 stat = bmc_step(bad, d);
+    if ( stat == kB3True ) {
+      return kB3False;
+    }
+    if ( stat == kB3X ) {
+      break;
+    }
+    mDepth = d + 1;
+  }
+  return kB3X;
+}
+
+// @brief k-induction で性質を証明する．
+// @param[in] bad 不正状態を表すノード
+// @param[in] max_k k の上限
+// @param[in] thread_num スレッド数
+Bool3
+BdnBmc::prove(const BdnNode* bad,
+	      ymuint max_k,
+	      ymuint thread_num)
+{
+  mDepth = 0;
+  mHasCex = false;
+
+  if ( thread_num >= 2 ) {
+    return prove_mt(bad, max_k);
+  }
+
+  // 深さ k までに反例がなく，長さ k + 1 の帰納ステップが成り立てば
+  // 証明できたことになる．
+  for (ymuint k = 0; k < max_k; ++ k) {
+    bmc_frames().clear_stop();
+    Bool3 stat = bmc_step(bad, k);
+    if ( stat == kB3True ) {
+      return kB3False;
+    }
+    if ( stat == kB3X ) {
+      return kB3X;
+    }
+    mDepth = k + 1;
+
+    ind_frames().clear_stop();
+    stat = ind_step(bad, k + 1);
+    if ( stat == kB3False ) {
+      return kB3True;
+    }
+    if ( stat == kB3X ) {
+      return kB3X;
+    }
+  }
+  return kB3X;
+}
+
+// @brief 深さ depth で bad に到達できるか調べる．
+Bool3
+BdnBmc::bmc_step(const BdnNode* bad,
+		 ymuint depth)
+{
+  BdnUnroller& frames = bmc_frames();
+  while ( frames.frame_num() <= depth ) {
+    frames.add_frame();
+  }
+
+  vector<Literal> assumptions(1, frames.node_lit(depth, bad));
+  Bool3 stat = frames.solve(assumptions);
+  if ( stat == kB3True ) {
+    // 反例を記録する．
+    mDepth = depth;
+    mHasCex = true;
+    ymuint ns = state_num();
+    mCexState.resize(ns);
+    for (ymuint i = 0; i < ns; ++ i) {
+      mCexState[i] = frames.lit_val(frames.state_lit(0, i));
+    }
+    ymuint ni = input_num();
+    mCexInput.resize((depth + 1) * ni);
+    for (ymuint t = 0; t <= depth; ++ t) {
+      for (ymuint i = 0; i < ni; ++ i) {
+	mCexInput[t * ni + i] = frames.lit_val(frames.input_lit(t, i));
+      }
+    }
+  }
+  return stat;
+}
+
+// @brief 長さ k の帰納ステップを調べる．
+//
+// 時刻 0 から k - 1 までは bad でなく，時刻 k で bad となる
+// 単純経路があるかを調べる．
+Bool3
+BdnBmc::ind_step(const BdnNode* bad,
+		 ymuint k)
+{
+  BdnUnroller& frames = ind_frames();
+  while ( frames.frame_num() <= k ) {
+    ymuint t = frames.frame_num();
+    frames.add_frame();
+    // 単純経路制約は性質によらないので節として追加する．
+    for (ymuint t0 = 0; t0 < t; ++ t0) {
+      frames.add_distinct(t0, t);
+    }
+  }
+
+  vector<Literal> assumptions;
+  assumptions.reserve(k + 1);
+  for (ymuint t = 0; t < k; ++ t) {
+    assumptions.push_back(~frames.node_lit(t, bad));
+  }
+  assumptions.push_back(frames.node_lit(k, bad));
+  return frames.solve(assumptions);
+}
+
+// @brief BMC 用の時間展開を得る．
+BdnUnroller&
+BdnBmc::bmc_frames()
+{
+  if ( mBmcFrames == nullptr ) {
+    mBmcFrames = new BdnUnroller(mNetwork, mStateList, mInputList,
+				 mInitList, mSatType, mSatOption);
+  }
+  return *mBmcFrames;
+}
+
+// @brief 帰納ステップ用の時間展開を得る．
+BdnUnroller&
+BdnBmc::ind_frames()
+{
+  if ( mIndFrames == nullptr ) {
+    mIndFrames = new BdnUnroller(mNetwork, mStateList, mInputList,
+				 vector<Bool3>(), mSatType, mSatOption);
+  }
+  return *mIndFrames;
+}
+
+// @brief BMC と帰納ステップを並列に実行する．
+Bool3
+BdnBmc::prove_mt(const BdnNode* bad,
+		 ymuint max_k)
+{
+  // スレッドを起動する前に作っておく．
+  bmc_frames();
+  ind_frames();
+
+  MtState state;
+  state.mDone = false;
+  state.mResult = kB3X;
+  state.mBmcDepth = 0;
+  state.mIndK = 0;
+
+  std::thread ind(ind_thread, this, bad, max_k, &state);
+  bmc_thread(this, bad, max_k, &state);
+  ind.join();
+
+  if ( state.mResult == kB3True ) {
+    mDepth = state.mIndK;
+  }
+  else if ( state.mResult == kB3X ) {
+    mDepth = state.mBmcDepth;
+  }
+  return state.mResult;
+}
+
+// @brief prove_mt() の BMC 側のスレッドの本体
+void
+BdnBmc::bmc_thread(BdnBmc* bmc,
+		   const BdnNode* bad,
+		   ymuint max_k,
+		   MtState* state)
+{
+  for (ymuint d = 0; d < max_k; ++ d) {
+    {
+      std::lock_guard<std::mutex> lock(state->mMutex);
+      if ( state->mDone ) {
+	return;
+      }
+      // stop() は mutex の中で呼ばれるので，ここで取り消しても
+      // 中止要求を取りこぼすことはない．
+      bmc->mBmcFrames->clear_stop();
+    }
+
+    Bool3 stat = bmc->bmc_step(bad, d);
+
+    std::lock_guard<std::mutex> lock(state->mMutex);
+    if ( state->mDone || stat == kB3X ) {
+      return;
+    }
+    if ( stat == kB3True ) {
+      // 反例が見つかった．
+      state->mDone = true;
+      state->mResult = kB3False;
+      bmc->mIndFrames->stop();
+      return;
+    }
+    state->mBmcDepth = d + 1;
+    if ( state->mIndK > 0 && state->mBmcDepth >= state->mIndK ) {
+      // 帰納ステップはすでに成り立っている．
+      state->mDone = true;
+      state->mResult = kB3True;
+      return;
+    }
+  }
+}
+
+// @brief prove_mt() の帰納ステップ側のスレッドの本体
+void
+BdnBmc::ind_thread(BdnBmc* bmc,
+		   const BdnNode* bad,
+		   ymuint max_k,
+		   MtState* state)
+{
+  for (ymuint k = 1; k <= max_k; ++ k) {
+    {
+      std::lock_guard<std::mutex> lock(state->mMutex);
+      if ( state->mDone ) {
+	return;
+      }
+      bmc->mIndFrames->clear_stop();
+    }
+
+    Bool3 stat = bmc->ind_step(bad, k);
+
+    std::lock_guard<std::mutex> lock(state->mMutex);
+    if ( state->mDone || stat == kB3X ) {
+      return;
+    }
+    if ( stat == kB3False ) {
+      // 帰納ステップが成り立った．
+      // 深さ k - 1 までの BMC が終わっていれば証明できたことになる．
+      // そうでなければ BMC 側が追いつくのを待つ．
+      state->mIndK = k;
+      if ( state->mBmcDepth >= k ) {
+	state->mDone = true;
+	state->mResult = kB3True;
+	bmc->mBmcFrames->stop();
+      }
+      return;
+    }
+  }
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
@@ -0,0 +1,180 @@
+﻿
+/// @file BdnFlatGraph.cc
+/// @brief BdnFlatGraph の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/BdnFlatGraph.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnNode.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BdnFlatGraph
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+BdnFlatGraph::BdnFlatGraph()
+{
+  clear();
+}
+
+// @brief BdnMgr から作るコンストラクタ
+// @param[in] network 元のネットワーク
+BdnFlatGraph::BdnFlatGraph(const BdnMgr& network)
+{
+  set(network);
+}
+
+// @brief デストラクタ
+BdnFlatGraph::~BdnFlatGraph()
+{
+}
+
+// @brief 内容をクリアする．
+void
+BdnFlatGraph::clear()
+{
+  mInputNum = 0;
+  mLnodeNum = 0;
+  mOutputNum = 0;
+  mMaxLevel = 0;
+
+  // 定数ノードだけは常に存在する．
+  mTypeArray.assign(1, kConst);
+  mFanin0Array.assign(1, 0U);
+  mFanin1Array.assign(1, 0U);
+  mLevelArray.assign(1, 0U);
+  mOrigArray.assign(1, nullptr);
+  mIdMap.clear();
+
+  mFanoutValid = false;
+  mFanoutTop.clear();
+  mFanoutArray.clear();
+}
+
+// @brief BdnMgr の内容を設定する．
+// @param[in] network 元のネットワーク
+void
+BdnFlatGraph::set(const BdnMgr& network)
+{
+  clear();
+
+  vector<const BdnNode*> node_list;
+  network.sort(node_list);
+
+  mInputNum = network.input_num();
+  mLnodeNum = node_list.size();
+  mOutputNum = network.output_num();
+
+  ymuint n = 1 + mInputNum + mLnodeNum + mOutputNum;
+  mTypeArray.resize(n, kConst);
+  mFanin0Array.resize(n, 0U);
+  mFanin1Array.resize(n, 0U);
+  mLevelArray.resize(n, 0U);
+  mOrigArray.resize(n, nullptr);
+  mIdMap.resize(network.max_node_id(), 0U);
+
+  ymuint32 id = 1;
+  const BdnNodeList& input_list = network.input_list();
+  for (BdnNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p, ++ id) {
+    const BdnNode* node = *p;
+    mTypeArray[id] = kInput;
+    mOrigArray[id] = node;
+    mIdMap[node->id()] = id;
+  }
+
+  for (vector<const BdnNode*>::iterator p = node_list.begin();
+       p != node_list.end(); ++ p, ++ id) {
+    const BdnNode* node = *p;
+    ymuint32 id0 = mIdMap[node->fanin0()->id()];
+    ymuint32 id1 = mIdMap[node->fanin1()->id()];
+    ymuint32 level = mLevelArray[id0];
+    if ( level < mLevelArray[id1] ) {
+      level = mLevelArray[id1];
+    }
+    ++ level;
+    if ( mMaxLevel < level ) {
+      mMaxLevel = level;
+    }
+    mTypeArray[id] = node->is_xor() ? kXor : kAnd;
+    mFanin0Array[id] = make_lit(id0, node->fanin0_inv());
+    mFanin1Array[id] = make_lit(id1, node->fanin1_inv());
+    mLevelArray[id] = level;
+    mOrigArray[id] = node;
+    mIdMap[node->id()] = id;
+  }
+
+  const BdnNodeList& output_list = network.output_list();
+  for (BdnNodeList::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p, ++ id) {
+    const BdnNode* node = *p;
+    const BdnNode* inode = node->output_fanin();
+    ymuint32 iid = inode ? mIdMap[inode->id()] : 0U;
+    mTypeArray[id] = kOutput;
+    mFanin0Array[id] = make_lit(iid, node->output_fanin_inv());
+    mLevelArray[id] = mLevelArray[iid];
+    mOrigArray[id] = node;
+    mIdMap[node->id()] = id;
+  }
+  ASSERT_COND( id == n );
+}
+
+// @brief ファンアウトの配列を作る．
+void
+BdnFlatGraph::build_fanout() const
+{
+  ymuint n = node_num();
+
+  // まずファンアウト数を数える．
+  mFanoutTop.clear();
+  mFanoutTop.resize(n + 1, 0U);
+  for (ymuint id = 0; id < n; ++ id) {
+    switch ( mTypeArray[id] ) {
+    case kAnd:
+    case kXor:
+      ++ mFanoutTop[lit_id(mFanin1Array[id]) + 1];
+      // わざと次に続く
+
+    case kOutput:
+      ++ mFanoutTop[lit_id(mFanin0Array[id]) + 1];
+      break;
+
+    default:
+      break;
+    }
+  }
+  for (ymuint id = 0; id < n; ++ id) {
+    mFanoutTop[id + 1] += mFanoutTop[id];
+  }
+
+  // 次に中身を詰める．
+  mFanoutArray.resize(mFanoutTop[n]);
+  vector<ymuint32> pos_array(mFanoutTop.begin(), mFanoutTop.end() - 1);
+  for (ymuint id = 0; id < n; ++ id) {
+    switch ( mTypeArray[id] ) {
+    case kAnd:
+    case kXor:
+      mFanoutArray[pos_array[lit_id(mFanin0Array[id])] ++] = (id << 1) | 0U;
+      mFanoutArray[pos_array[lit_id(mFanin1Array[id])] ++] = (id << 1) | 1U;
+      break;
+
+    case kOutput:
+      mFanoutArray[pos_array[lit_id(mFanin0Array[id])] ++] = (id << 1) | 0U;
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  mFanoutValid = true;
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
@@ -668,4 +668,33 @@ BdnMgr::change_xnor(BdnNode* node,
   mImpl->change_logic(node, ~new_handle);
 }
 
+// @brief 論理ノードを置き換える．
+// @param[in] node 置き換え対象の論理ノード
+// @param[in] new_handle 置き換え後のノード+極性
+// @param[out] deleted_list 削除されたノードのID番号のリスト
+void
+BdnMgr::replace_logic(BdnNode* node,
+		      BdnNodeHandle new_handle,
+		      vector<ymuint>& deleted_list)
+{
+  mImpl->replace_logic(node, new_handle, deleted_list);
+}
+
+// @brief 内容をバイナリダンプする．
+// @param[in] s 出力先のストリーム
+void
+BdnMgr::dump(ODO& s) const
+{
+  mImpl->dump(s);
+}
+
+// @brief バイナリダンプされた内容を読み込む．
+// @param[in] s 入力元のストリーム
+// @return 読み込みが成功したら true を返す．
+bool
+BdnMgr::restore(IDO& s)
+{
+  return mImpl->restore(s);
+}
+
 END_NAMESPACE_YM_NETWORKS_BDN
@@ -14,6 +14,7 @@
 #include "YmNetworks/BdnNode.h"
 #include "YmNetworks/BdnNodeHandle.h"
 #include "BdnAuxData.h"
+#include "BlockIO.h"
 
 
 BEGIN_NAMESPACE_YM_NETWORKS_BDN
@@ -27,7 +28,8 @@ BdnMgrImpl::BdnMgrImpl() :
   mAlloc(4096),
   mHashTable(nullptr),
   mHashSize(0),
-  mLevel(0U)
+  mLevel(0U),
+  mRestorePos(0)
 {
   alloc_table(1024);
 }
@@ -360,7 +362,63 @@ BdnMgrImpl::set_name(const char* name)
 void
 BdnMgrImpl::clean_up()
 {
-#warning "TODO: 未完"
+  // 最初にファンアウトを持たないノードを集めておき，
+  // それぞれから delete_dangling() でファンインをたどって削除する．
+  // 削除によってファンアウトを失ったファンインもそこで削除される．
+  vector<BdnNode*> node_list;
+  node_list.reserve(lnode_num());
+  for (BdnNodeList::iterator p = mLnodeList.begin();
+       p != mLnodeList.end(); ++ p) {
+    BdnNode* node = *p;
+    if ( node->fanout_num() == 0 ) {
+      node_list.push_back(node);
+    }
+  }
+
+  vector<ymuint> deleted_list;
+  for (vector<BdnNode*>::iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    delete_dangling(*p, deleted_list);
+  }
+}
+
+// @brief ファンアウトを持たない論理ノードとその先のファンインを削除する．
+// @param[in] node 対象のノード
+// @param[out] deleted_list 削除されたノードのID番号を追加するリスト
+// @note node がファンアウトを持つ場合や論理ノードでない場合には何もしない．
+void
+BdnMgrImpl::delete_dangling(BdnNode* node,
+			    vector<ymuint>& deleted_list)
+{
+  // 長い鎖を削除してもスタックがあふれないように
+  // 再帰ではなく作業リストを用いる．
+  vector<BdnNode*> work_list;
+  work_list.push_back(node);
+  while ( !work_list.empty() ) {
+    BdnNode* node = work_list.back();
+    work_list.pop_back();
+    if ( node == nullptr || !node->is_logic() || node->fanout_num() > 0 ) {
+      continue;
+    }
+    int id = static_cast<int>(node->id());
+    if ( mNodeItvlMgr.check(id, id) ) {
+      // すでに削除されている．
+      continue;
+    }
+
+    BdnNode* inode0 = node->fanin0();
+    BdnNode* inode1 = node->fanin1();
+
+    unlink_node(node);
+    connect(nullptr, node, 0);
+    connect(nullptr, node, 1);
+    delete_node(node);
+    deleted_list.push_back(node->id());
+
+    // 再帰版と同じく fanin0 側から先にたどる．
+    work_list.push_back(inode1);
+    work_list.push_back(inode0);
+  }
 }
 
 // @brief ポートを作る．
@@ -636,6 +694,20 @@ BdnMgrImpl::make_tree(BdnNode* node,
 void
 BdnMgrImpl::change_logic(BdnNode* node ,
 			 BdnNodeHandle new_handle)
+{
+  change_logic(node, new_handle, nullptr);
+}
+
+// @brief 論理ノードの内容を変更する．
+// @param[in] node 変更対象の論理ノード
+// @param[in] new_handle 設定する新しいハンドル
+// @param[out] dangling_list ファンアウトを持たなくなったノードを追加するリスト
+// @note node のファンアウト先の情報を書き換える．
+// @note dangling_list が nullptr の場合には記録しない．
+void
+BdnMgrImpl::change_logic(BdnNode* node ,
+			 BdnNodeHandle new_handle,
+			 vector<BdnNode*>* dangling_list)
 {
   if ( new_handle == BdnNodeHandle(node, false) ) {
     // 変化なし
@@ -656,24 +728,60 @@ BdnMgrImpl::change_logic(BdnNode* node ,
   for (vector<BdnEdge*>::iterator p = tmp_list.begin();
        p != tmp_list.end(); ++ p) {
     BdnEdge* edge = *p;
+    if ( edge->from() != node ) {
+      // 先の変更でファンインの順番が入れ替わった．
+      continue;
+    }
     BdnNode* onode = edge->to();
     if ( onode->is_logic() ) {
-      BdnNodeHandle inode1_handle(onode->fanin0());
-      BdnNodeHandle inode2_handle(onode->fanin1());
+      // ファンインの枝の極性はそのまま引き継ぐ．
+      BdnNodeHandle inode1_handle = onode->fanin_handle(0);
+      BdnNodeHandle inode2_handle = onode->fanin_handle(1);
       if ( edge->pos() == 0 ) {
-	inode1_handle = new_handle;
+	inode1_handle = onode->fanin_inv(0) ? ~new_handle : new_handle;
       }
       else {
-	inode2_handle = new_handle;
+	inode2_handle = onode->fanin_inv(1) ? ~new_handle : new_handle;
       }
       BdnNodeHandle new_oh = set_logic(onode, onode->is_xor(),
 				       inode1_handle, inode2_handle);
-      change_logic(onode, new_oh);
+      change_logic(onode, new_oh, dangling_list);
     }
     else if ( onode->is_output() ) {
-      change_output_fanin(onode, new_handle);
+      if ( onode->output_fanin_inv() ) {
+	change_output_fanin(onode, ~new_handle);
+      }
+      else {
+	change_output_fanin(onode, new_handle);
+      }
     }
   }
+  if ( dangling_list ) {
+    // node はどこにもファンアウトしていない可能性がある．
+    dangling_list->push_back(node);
+  }
+}
+
+// @brief 論理ノードを置き換える．
+// @param[in] node 置き換え対象の論理ノード
+// @param[in] new_handle 置き換え後のノード+極性
+// @param[out] deleted_list 削除されたノードのID番号のリスト
+// @note node のファンアウト先を new_handle に付け替えたのち，
+// どこにもファンアウトしなくなった論理ノードを削除する．
+void
+BdnMgrImpl::replace_logic(BdnNode* node,
+			  BdnNodeHandle new_handle,
+			  vector<ymuint>& deleted_list)
+{
+  deleted_list.clear();
+
+  vector<BdnNode*> dangling_list;
+  change_logic(node, new_handle, &dangling_list);
+
+  for (vector<BdnNode*>::iterator p = dangling_list.begin();
+       p != dangling_list.end(); ++ p) {
+    delete_dangling(*p, deleted_list);
+  }
 }
 
 // @brief 出力ノードの内容を変更する
@@ -800,19 +908,7 @@ BdnMgrImpl::set_logic(BdnNode* node,
   }
   else {
     // ハッシュ表から取り除く
-    ymuint pos0 = hash_func(node->_fcode(), node->fanin0(), node->fanin1());
-    ymuint idx0 = pos0 % mHashSize;
-    BdnNode* prev = mHashTable[idx0];
-    if ( prev == node ) {
-      mHashTable[idx0] = node->mLink;
-    }
-    for (BdnNode* node0 = 0; (node0 = prev->mLink); prev = node0) {
-      if ( node0 == node ) {
-	prev->mLink = node->mLink;
-	break;
-      }
-    }
-    // エラーチェック(node0 == nullptr) はしていない．
+    unlink_node(node);
   }
 
   node->set_logic_type(fcode);
@@ -826,6 +922,27 @@ BdnMgrImpl::set_logic(BdnNode* node,
   return BdnNodeHandle(node, oinv);
 }
 
+// @brief 論理ノードをハッシュ表から取り除く．
+// @param[in] node 対象のノード
+void
+BdnMgrImpl::unlink_node(BdnNode* node)
+{
+  ymuint pos0 = hash_func(node->_fcode(), node->fanin0(), node->fanin1());
+  ymuint idx0 = pos0 % mHashSize;
+  BdnNode* prev = mHashTable[idx0];
+  if ( prev == node ) {
+    mHashTable[idx0] = node->mLink;
+    return;
+  }
+  for (BdnNode* node0 = 0; (node0 = prev->mLink); prev = node0) {
+    if ( node0 == node ) {
+      prev->mLink = node->mLink;
+      break;
+    }
+  }
+  // エラーチェック(node0 == nullptr) はしていない．
+}
+
 // from を to の pos 番目のファンインとする．
 // to の pos 番目にすでに接続があった場合には自動的に削除される．
 void
@@ -883,11 +1000,11 @@ BdnMgrImpl::is_trivial(bool is_xor,
     }
     else if ( inode1_handle == inode2_handle ) {
       // 2つの入力が同一だった．
-      return inode1_handle;
+      return BdnNodeHandle::make_zero();
     }
     else if ( inode1_handle == ~inode2_handle ) {
       // 2つの入力が極性違いだった．
-      return BdnNodeHandle::make_zero();
+      return BdnNodeHandle::make_one();
     }
   }
   else {
@@ -1002,20 +1119,26 @@ BdnNode*
 BdnMgrImpl::alloc_node()
 {
   // 空いているIDを探してノード配列へ登録
-  int id = mNodeItvlMgr.avail_num();
+  // restore() 中はダンプ時の ID を用いる．
+  int id;
+  if ( mRestorePos < mRestoreIdList.size() ) {
+    id = mRestoreIdList[mRestorePos];
+    ++ mRestorePos;
+  }
+  else {
+    id = mNodeItvlMgr.avail_num();
+  }
   ASSERT_COND( id >= 0 );
   mNodeItvlMgr.erase(id);
 
   ymuint uid = static_cast<ymuint>(id);
-  if ( mNodeArray.size() == uid ) {
+  while ( mNodeArray.size() <= uid ) {
+    // 使われていない ID のノードも作っておく．
     void* p = mAlloc.get_memory(sizeof(BdnNode));
     BdnNode* node = new (p) BdnNode();
-    node->mId = uid;
+    node->mId = mNodeArray.size();
     mNodeArray.push_back(node);
   }
-  else {
-    ASSERT_COND( mNodeArray.size() > uid );
-  }
   BdnNode* node = mNodeArray[uid];
 
   node->mFlags = 0U;
@@ -1121,4 +1244,341 @@ BdnMgrImpl::alloc_table(ymuint req_size)
   mNextLimit = static_cast<ymuint32>(mHashSize * 1.8);
 }
 
+// @brief 内容をバイナリダンプする．
+// @param[in] s 出力先のストリーム
+//
+// ノードの ID 番号はそのまま保存される．
+// restore() で ID 番号の範囲を調べられるように max_node_id() も書き出す．
+// 名前は先頭にまとめて書き出し，ノードの情報は ymuint32 の配列に
+// まとめてから dump_block() で書き出す．
+void
+BdnMgrImpl::dump(ODO& s) const
+{
+  // 名前の表
+  ymuint32 np = port_num();
+  ymuint32 nd = dff_num();
+  ymuint32 nl = latch_num();
+  ymuint32 max_id = max_node_id();
+  s << mName
+    << np
+    << nd
+    << nl
+    << max_id;
+  for (ymuint i = 0; i < np; ++ i) {
+    s << mPortArray[i]->name();
+  }
+  for (BdnDffList::const_iterator p = mDffList.begin();
+       p != mDffList.end(); ++ p) {
+    s << (*p)->name();
+  }
+  for (BdnLatchList::const_iterator p = mLatchList.begin();
+       p != mLatchList.end(); ++ p) {
+    s << (*p)->name();
+  }
+
+  // ポートの構成と restore() 時にノードを生成する順の ID 番号
+  vector<ymuint32> port_block;
+  vector<ymuint32> id_block;
+  id_block.reserve(mNodeArray.size());
+  for (ymuint i = 0; i < np; ++ i) {
+    const BdnPort* port = mPortArray[i];
+    ymuint bw = port->bit_width();
+    port_block.push_back(bw);
+    for (ymuint j = 0; j < bw; ++ j) {
+      const BdnNode* input = port->input(j);
+      const BdnNode* output = port->output(j);
+      ymuint32 val = 0U;
+      if ( input ) {
+	val |= 1U;
+	id_block.push_back(input->id());
+      }
+      if ( output ) {
+	val |= 2U;
+	id_block.push_back(output->id());
+      }
+      port_block.push_back(val);
+    }
+  }
+  for (BdnDffList::const_iterator p = mDffList.begin();
+       p != mDffList.end(); ++ p) {
+    const BdnDff* dff = *p;
+    id_block.push_back(dff->output()->id());
+    id_block.push_back(dff->input()->id());
+    id_block.push_back(dff->clock()->id());
+    id_block.push_back(dff->clear()->id());
+    id_block.push_back(dff->preset()->id());
+  }
+  for (BdnLatchList::const_iterator p = mLatchList.begin();
+       p != mLatchList.end(); ++ p) {
+    const BdnLatch* latch = *p;
+    id_block.push_back(latch->output()->id());
+    id_block.push_back(latch->input()->id());
+    id_block.push_back(latch->enable()->id());
+    id_block.push_back(latch->clear()->id());
+    id_block.push_back(latch->preset()->id());
+  }
+
+  // 論理ノードはトポロジカル順に (機能コード, ファンイン0, ファンイン1)
+  vector<const BdnNode*> node_list;
+  sort(node_list);
+  vector<ymuint32> logic_block;
+  logic_block.reserve(node_list.size() * 3);
+  for (vector<const BdnNode*>::iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    const BdnNode* node = *p;
+    id_block.push_back(node->id());
+    logic_block.push_back(node->_fcode());
+    logic_block.push_back(node->fanin0()->id());
+    logic_block.push_back(node->fanin1()->id());
+  }
+
+  // 出力ノードは (ID番号, (ファンイン + 1) * 2 + 極性)
+  // ファンインがない(定数の)場合は 0 か 1 となる．
+  vector<ymuint32> output_block;
+  output_block.reserve(output_num() * 2);
+  for (BdnNodeList::const_iterator p = mOutputList.begin();
+       p != mOutputList.end(); ++ p) {
+    const BdnNode* node = *p;
+    const BdnNode* inode = node->output_fanin();
+    ymuint32 val = node->output_fanin_inv() ? 1U : 0U;
+    if ( inode ) {
+      val |= (inode->id() + 1) << 1;
+    }
+    output_block.push_back(node->id());
+    output_block.push_back(val);
+  }
+
+  dump_block(s, port_block);
+  dump_block(s, id_block);
+  dump_block(s, logic_block);
+  dump_block(s, output_block);
+}
+
+BEGIN_NONAMESPACE
+
+// restore() で用いるノードの種類
+const ymuint8 kInputKind = 1U;
+const ymuint8 kOutputKind = 2U;
+const ymuint8 kLogicKind = 3U;
+
+// ファンインとして使えるノードのとき true を返す．
+inline
+bool
+is_fanin_kind(ymuint8 kind)
+{
+  return kind == kInputKind || kind == kLogicKind;
+}
+
+// restore() で読み込んだブロックの内容が正しいか調べる．
+// ID 番号の重複や過不足，max_id 以上の ID 番号，存在しないノードや
+// 出力ノードを指すファンイン，ブロックの大きさの不整合があれば
+// false を返す．
+bool
+check_blocks(ymuint np,
+	     ymuint nd,
+	     ymuint nl,
+	     ymuint max_id,
+	     const vector<ymuint32>& port_block,
+	     const vector<ymuint32>& id_block,
+	     const vector<ymuint32>& logic_block,
+	     const vector<ymuint32>& output_block)
+{
+  BlockIdChecker checker(id_block, max_id);
+
+  ymuint rpos = 0;
+  ymuint n = port_block.size();
+  for (ymuint i = 0; i < np; ++ i) {
+    if ( rpos >= n ) {
+      return false;
+    }
+    ymuint bw = port_block[rpos];
+    ++ rpos;
+    if ( bw > n - rpos ) {
+      return false;
+    }
+    for (ymuint j = 0; j < bw; ++ j) {
+      ymuint32 val = port_block[rpos];
+      ++ rpos;
+      if ( val > 3U ) {
+	return false;
+      }
+      if ( (val & 1U) && !checker.set_next(kInputKind) ) {
+	return false;
+      }
+      if ( (val & 2U) && !checker.set_next(kOutputKind) ) {
+	return false;
+      }
+    }
+  }
+  if ( rpos != n ) {
+    return false;
+  }
+
+  // D-FF とラッチは出力(入力ノード)と4つの入力(出力ノード)を持つ．
+  for (ymuint i = 0; i < nd + nl; ++ i) {
+    if ( !checker.set_next(kInputKind) ) {
+      return false;
+    }
+    for (ymuint j = 0; j < 4; ++ j) {
+      if ( !checker.set_next(kOutputKind) ) {
+	return false;
+      }
+    }
+  }
+
+  // 論理ノードのファンインは先に生成されていなければならない．
+  if ( logic_block.size() % 3 != 0 ) {
+    return false;
+  }
+  for (ymuint pos = 0; pos < logic_block.size(); pos += 3) {
+    if ( logic_block[pos + 0] > 7U ||
+	 !is_fanin_kind(checker.kind(logic_block[pos + 1])) ||
+	 !is_fanin_kind(checker.kind(logic_block[pos + 2])) ||
+	 !checker.set_next(kLogicKind) ) {
+      return false;
+    }
+  }
+  if ( !checker.is_end() ) {
+    return false;
+  }
+
+  if ( output_block.size() % 2 != 0 ) {
+    return false;
+  }
+  for (ymuint pos = 0; pos < output_block.size(); pos += 2) {
+    if ( checker.kind(output_block[pos]) != kOutputKind ) {
+      return false;
+    }
+    ymuint32 val = output_block[pos + 1];
+    if ( (val >> 1) > 0U && !is_fanin_kind(checker.kind((val >> 1) - 1)) ) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+END_NONAMESPACE
+
+// @brief バイナリダンプされた内容を読み込む．
+// @param[in] s 入力元のストリーム
+// @return 読み込みが成功したら true を返す．
+// @note 内容に矛盾があった場合には false を返す．
+// その場合，もとの内容は変更されない．
+bool
+BdnMgrImpl::restore(IDO& s)
+{
+  string name;
+  ymuint32 np;
+  ymuint32 nd;
+  ymuint32 nl;
+  ymuint32 max_id;
+  s >> name
+    >> np
+    >> nd
+    >> nl
+    >> max_id;
+  vector<string> name_list;
+  for (ymuint i = 0; i < np + nd + nl; ++ i) {
+    string tmp_name;
+    s >> tmp_name;
+    name_list.push_back(tmp_name);
+  }
+
+  vector<ymuint32> port_block;
+  vector<ymuint32> id_block;
+  vector<ymuint32> logic_block;
+  vector<ymuint32> output_block;
+  if ( !restore_block(s, port_block) ||
+       !restore_block(s, id_block) ||
+       !restore_block(s, logic_block) ||
+       !restore_block(s, output_block) ) {
+    return false;
+  }
+  if ( !check_blocks(np, nd, nl, max_id,
+		     port_block, id_block, logic_block, output_block) ) {
+    return false;
+  }
+
+  // clear() は接続を外さないのでここで外しておく．
+  for (BdnNodeList::iterator p = mLnodeList.begin();
+       p != mLnodeList.end(); ++ p) {
+    BdnNode* node = *p;
+    connect(nullptr, node, 0);
+    connect(nullptr, node, 1);
+  }
+  for (BdnNodeList::iterator p = mOutputList.begin();
+       p != mOutputList.end(); ++ p) {
+    connect(nullptr, *p, 0);
+  }
+  clear();
+  for (ymuint i = 0; i < mHashSize; ++ i) {
+    mHashTable[i] = nullptr;
+  }
+
+  mRestoreIdList.swap(id_block);
+  mRestorePos = 0;
+
+  set_name(name.c_str());
+
+  // ポート，D-FF，ラッチの生成
+  // ノードの ID 番号は alloc_node() が mRestoreIdList から取り出す．
+  ymuint rpos = 0;
+  for (ymuint i = 0; i < np; ++ i) {
+    ymuint bw = port_block[rpos];
+    ++ rpos;
+    vector<ymuint> iovect(bw);
+    for (ymuint j = 0; j < bw; ++ j) {
+      iovect[j] = port_block[rpos];
+      ++ rpos;
+    }
+    new_port(name_list[i].c_str(), iovect);
+  }
+  for (ymuint i = 0; i < nd; ++ i) {
+    new_dff(name_list[np + i].c_str());
+  }
+  for (ymuint i = 0; i < nl; ++ i) {
+    new_latch(name_list[np + nd + i].c_str());
+  }
+
+  // 論理ノードの生成
+  // 構造ハッシュによる併合は行わずにそのまま登録する．
+  ymuint nlogic = logic_block.size() / 3;
+  for (ymuint i = 0; i < nlogic; ++ i) {
+    ymuint fcode = logic_block[i * 3 + 0];
+    BdnNode* inode1 = mNodeArray[logic_block[i * 3 + 1]];
+    BdnNode* inode2 = mNodeArray[logic_block[i * 3 + 2]];
+
+    BdnNode* node = alloc_node();
+    mLnodeList.push_back(node);
+    if ( lnode_num() >= mNextLimit ) {
+      alloc_table(mHashSize * 2);
+    }
+
+    node->set_logic_type(fcode);
+    connect(inode1, node, 0);
+    connect(inode2, node, 1);
+
+    ymuint idx = hash_func(fcode, inode1, inode2) % mHashSize;
+    node->mLink = mHashTable[idx];
+    mHashTable[idx] = node;
+  }
+  ASSERT_COND( mRestorePos == mRestoreIdList.size() );
+  mRestoreIdList.clear();
+  mRestorePos = 0;
+
+  // 出力ノードのファンインの設定
+  ymuint nout = output_block.size() / 2;
+  for (ymuint i = 0; i < nout; ++ i) {
+    BdnNode* node = mNodeArray[output_block[i * 2 + 0]];
+    ymuint32 val = output_block[i * 2 + 1];
+    node->set_output_fanin_inv(static_cast<bool>(val & 1U));
+    if ( (val >> 1) > 0U ) {
+      connect(mNodeArray[(val >> 1) - 1], node, 0);
+    }
+  }
+
+  return true;
+}
+
 END_NAMESPACE_YM_NETWORKS_BDN
@@ -12,6 +12,8 @@
 #include "YmNetworks/BdnNodeHandle.h"
 #include "YmUtils/SimpleAlloc.h"
 #include "YmUtils/ItvlMgr.h"
+#include "YmUtils/IDO.h"
+#include "YmUtils/ODO.h"
 
 
 BEGIN_NAMESPACE_YM_NETWORKS_BDN
@@ -265,6 +267,17 @@ public:
   change_logic(BdnNode* node ,
 	       BdnNodeHandle new_handle);
 
+  /// @brief 論理ノードを置き換える．
+  /// @param[in] node 置き換え対象の論理ノード
+  /// @param[in] new_handle 置き換え後のノード+極性
+  /// @param[out] deleted_list 削除されたノードのID番号のリスト
+  /// @note node のファンアウト先を new_handle に付け替えたのち，
+  /// どこにもファンアウトしなくなった論理ノードを削除する．
+  void
+  replace_logic(BdnNode* node,
+		BdnNodeHandle new_handle,
+		vector<ymuint>& deleted_list);
+
   /// @brief 出力ノードのファンインを変更する
   /// @param[in] node 変更対象の出力ノード
   /// @param[in] inode_handle ファンインのノード+極性
@@ -287,6 +300,17 @@ public:
   void
   copy(const BdnMgr& src);
 
+  /// @brief 内容をバイナリダンプする．
+  /// @param[in] s 出力先のストリーム
+  void
+  dump(ODO& s) const;
+
+  /// @brief バイナリダンプされた内容を読み込む．
+  /// @param[in] s 入力元のストリーム
+  /// @return 読み込みが成功したら true を返す．
+  bool
+  restore(IDO& s);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -309,6 +333,30 @@ private:
 	    ymuint num,
 	    const vector<BdnNodeHandle>& node_list);
 
+  /// @brief 論理ノードの内容を変更する．
+  /// @param[in] node 変更対象の論理ノード
+  /// @param[in] new_handle 設定する新しいハンドル
+  /// @param[out] dangling_list ファンアウトを持たなくなったノードを追加するリスト
+  /// @note node のファンアウト先の情報を書き換える．
+  /// @note dangling_list が nullptr の場合には記録しない．
+  void
+  change_logic(BdnNode* node ,
+	       BdnNodeHandle new_handle,
+	       vector<BdnNode*>* dangling_list);
+
+  /// @brief ファンアウトを持たない論理ノードとその先のファンインを削除する．
+  /// @param[in] node 対象のノード
+  /// @param[out] deleted_list 削除されたノードのID番号を追加するリスト
+  /// @note node がファンアウトを持つ場合や論理ノードでない場合には何もしない．
+  void
+  delete_dangling(BdnNode* node,
+		  vector<ymuint>& deleted_list);
+
+  /// @brief 論理ノードをハッシュ表から取り除く．
+  /// @param[in] node 対象のノード
+  void
+  unlink_node(BdnNode* node);
+
   /// @brief 論理ノードの内容を設定する．
   /// @param[in] node 設定するノード
   /// @param[in] is_xor XOR の時 true にするフラグ(false なら AND)
@@ -453,6 +501,12 @@ private:
   mutable
   ymuint32 mLevel;
 
+  // restore() 中に alloc_node() が割り当てる ID 番号のリスト
+  vector<ymuint32> mRestoreIdList;
+
+  // mRestoreIdList 中の次の位置
+  ymuint32 mRestorePos;
+
 private:
   //////////////////////////////////////////////////////////////////////
   // 機能コード用の定数
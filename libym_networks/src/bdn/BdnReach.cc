@@ -0,0 +1,458 @@
+﻿
+/// @file BdnReach.cc
+/// @brief BdnReach の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/BdnReach.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnDff.h"
+#include "YmNetworks/BdnLatch.h"
+#include "YmUtils/StopWatch.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BdnReach
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] mgr BDD の管理クラス
+// @param[in] cluster_limit クラスタのノード数の上限
+BdnReach::BdnReach(const BdnMgr& network,
+		   BddMgr& mgr,
+		   ymuint cluster_limit) :
+  mNetwork(network),
+  mMgr(mgr),
+  mClusterLimit(cluster_limit),
+  mFwdSchedule(mgr),
+  mBwdSchedule(mgr),
+  mPeakSize(0)
+{
+  // 状態変数は D-FF, ラッチの順に並べる．
+  const BdnDffList& dff_list = mNetwork.dff_list();
+  for (BdnDffList::const_iterator p = dff_list.begin();
+       p != dff_list.end(); ++ p) {
+    const BdnDff* dff = *p;
+    mStateList.push_back(dff->output());
+  }
+  const BdnLatchList& latch_list = mNetwork.latch_list();
+  for (BdnLatchList::const_iterator p = latch_list.begin();
+       p != latch_list.end(); ++ p) {
+    const BdnLatch* latch = *p;
+    mStateList.push_back(latch->output());
+  }
+
+  const BdnNodeList& input_list = mNetwork.input_list();
+  for (BdnNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    const BdnNode* node = *p;
+    if ( node->input_type() == BdnNode::kPRIMARY_INPUT ) {
+      mInputList.push_back(node);
+    }
+  }
+
+  // 変数を確保する．
+  ymuint ns = state_num();
+  ymuint ni = input_num();
+  for (ymuint i = 0; i < ns; ++ i) {
+    mMgr.new_var(cur_var(i));
+    mMgr.new_var(next_var(i));
+    mNextToCur.add(next_var(i), cur_var(i));
+    mCurToNext.add(cur_var(i), next_var(i));
+  }
+  for (ymuint i = 0; i < ni; ++ i) {
+    mMgr.new_var(input_var(i));
+  }
+
+  calc_node_func();
+  make_clusters();
+
+  VarVector cur_vars;
+  VarVector next_vars;
+  cur_vars.reserve(ns + ni);
+  next_vars.reserve(ns + ni);
+  for (ymuint i = 0; i < ns; ++ i) {
+    cur_vars.push_back(cur_var(i));
+    next_vars.push_back(next_var(i));
+  }
+  for (ymuint i = 0; i < ni; ++ i) {
+    cur_vars.push_back(input_var(i));
+    next_vars.push_back(input_var(i));
+  }
+  make_schedule(BddVarSet(mMgr, cur_vars), mFwdSchedule);
+  make_schedule(BddVarSet(mMgr, next_vars), mBwdSchedule);
+}
+
+// @brief デストラクタ
+BdnReach::~BdnReach()
+{
+}
+
+// @brief ノードの関数を得る．
+// @param[in] node 対象のノード
+// @return 現状態と外部入力の変数で表した関数を返す．
+// @note 出力ノードの場合にはファンインの関数を返す．
+Bdd
+BdnReach::node_func(const BdnNode* node) const
+{
+  if ( node->is_output() ) {
+    return handle_func(node->output_fanin_handle());
+  }
+  return mNodeFunc[node->id()];
+}
+
+// @brief すべての状態変数が 0 の状態を表す BDD を返す．
+Bdd
+BdnReach::zero_state() const
+{
+  Bdd ans = mMgr.make_one();
+  ymuint ns = state_num();
+  for (ymuint i = 0; i < ns; ++ i) {
+    ans &= mMgr.make_negaliteral(cur_var(i));
+  }
+  return ans;
+}
+
+// @brief 像を求める．
+// @param[in] from 現状態の集合
+// @return from から1回の遷移で到達できる状態の集合(現状態の変数で表す)
+Bdd
+BdnReach::image(const Bdd& from)
+{
+  Bdd ans = rel_prod(from, mFwdSchedule);
+  return ans.remap_var(mNextToCur);
+}
+
+// @brief 逆像を求める．
+// @param[in] to 現状態の変数で表した状態の集合
+// @return 1回の遷移で to に到達できる状態の集合
+Bdd
+BdnReach::preimage(const Bdd& to)
+{
+  Bdd to1 = to.remap_var(mCurToNext);
+  return rel_prod(to1, mBwdSchedule);
+}
+
+// @brief 前向きに到達可能な状態の集合を求める．
+// @param[in] init 初期状態の集合
+// @param[in] max_iter 反復回数の上限 (0 の時は無制限)
+// @return 到達可能な状態の集合
+Bdd
+BdnReach::forward(const Bdd& init,
+		  ymuint max_iter)
+{
+  return fixpoint(init, mMgr.make_zero(), true, max_iter);
+}
+
+// @brief 後ろ向きに到達可能な状態の集合を求める．
+// @param[in] target 目標の状態の集合
+// @param[in] max_iter 反復回数の上限 (0 の時は無制限)
+// @return target に到達可能な状態の集合(target を含む)
+Bdd
+BdnReach::backward(const Bdd& target,
+		   ymuint max_iter)
+{
+  return fixpoint(target, mMgr.make_zero(), false, max_iter);
+}
+
+// @brief 不変条件を調べる．
+// @param[in] init 初期状態の集合
+// @param[in] invariant 不変条件
+// @return すべての到達可能な状態で invariant が成り立つ時 true を返す．
+bool
+BdnReach::check_invariant(const Bdd& init,
+			  const Bdd& invariant)
+{
+  // いずれかの入力値で invariant を満たさない状態の集合
+  VarVector input_vars;
+  input_vars.reserve(input_num());
+  for (ymuint i = 0; i < input_num(); ++ i) {
+    input_vars.push_back(input_var(i));
+  }
+  Bdd bad = (~invariant).esmooth(BddVarSet(mMgr, input_vars));
+
+  Bdd reached = fixpoint(init, bad, true, 0);
+  return (reached & bad).is_zero();
+}
+
+// @brief ノードの関数を計算する．
+void
+BdnReach::calc_node_func()
+{
+  mNodeFunc.clear();
+  mNodeFunc.resize(mNetwork.max_node_id(), mMgr.make_zero());
+
+  ymuint ns = state_num();
+  for (ymuint i = 0; i < ns; ++ i) {
+    const BdnNode* node = mStateList[i];
+    mNodeFunc[node->id()] = mMgr.make_posiliteral(cur_var(i));
+  }
+  ymuint ni = input_num();
+  for (ymuint i = 0; i < ni; ++ i) {
+    const BdnNode* node = mInputList[i];
+    mNodeFunc[node->id()] = mMgr.make_posiliteral(input_var(i));
+  }
+
+  vector<const BdnNode*> node_list;
+  mNetwork.sort(node_list);
+  for (vector<const BdnNode*>::iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    const BdnNode* node = *p;
+    Bdd f0 = handle_func(node->fanin_handle(0));
+    Bdd f1 = handle_func(node->fanin_handle(1));
+    if ( node->is_xor() ) {
+      mNodeFunc[node->id()] = f0 ^ f1;
+    }
+    else {
+      mNodeFunc[node->id()] = f0 & f1;
+    }
+  }
+}
+
+// @brief ハンドルの関数を得る．
+Bdd
+BdnReach::handle_func(BdnConstNodeHandle handle) const
+{
+  if ( handle.is_one() ) {
+    return mMgr.make_one();
+  }
+  const BdnNode* node = handle.node();
+  if ( node == nullptr ) {
+    // 定数0か未接続
+    return mMgr.make_zero();
+  }
+  Bdd f = mNodeFunc[node->id()];
+  if ( handle.inv() ) {
+    f = ~f;
+  }
+  return f;
+}
+
+
+BEGIN_NONAMESPACE
+
+// 非同期のクリア/プリセット信号の関数を得る．
+// 信号がない場合には定数0を返す．
+Bdd
+async_func(const BdnReach& reach,
+	   BddMgr& mgr,
+	   const BdnNode* node)
+{
+  if ( node == nullptr ) {
+    return mgr.make_zero();
+  }
+  return reach.node_func(node);
+}
+
+END_NONAMESPACE
+
+
+// @brief 遷移関係のクラスタを作る．
+void
+BdnReach::make_clusters()
+{
+  mClusterList.clear();
+
+  ymuint ns = state_num();
+  Bdd cluster = mMgr.make_one();
+  for (ymuint i = 0; i < ns; ++ i) {
+    const BdnNode* node = mStateList[i];
+    Bdd q = mMgr.make_posiliteral(cur_var(i));
+    Bdd delta;
+    Bdd clr;
+    Bdd pre;
+    const BdnDff* dff = node->dff();
+    if ( dff != nullptr ) {
+      delta = node_func(dff->input());
+      clr = async_func(*this, mMgr, dff->clear());
+      pre = async_func(*this, mMgr, dff->preset());
+    }
+    else {
+      const BdnLatch* latch = node->latch();
+      ASSERT_COND( latch != nullptr );
+      delta = node_func(latch->input());
+      const BdnNode* enable = latch->enable();
+      if ( enable != nullptr && enable->output_fanin() != nullptr ) {
+	delta = ite_op(node_func(enable), delta, q);
+      }
+      clr = async_func(*this, mMgr, latch->clear());
+      pre = async_func(*this, mMgr, latch->preset());
+    }
+    delta = ~clr & (pre | delta);
+
+    // y_i == δ_i の部分関係
+    Bdd part = ~(mMgr.make_posiliteral(next_var(i)) ^ delta);
+
+    // 上限を越えない限り直前のクラスタにまとめる．
+    Bdd tmp = cluster & part;
+    if ( cluster.is_one() || tmp.node_count() <= mClusterLimit ) {
+      cluster = tmp;
+    }
+    else {
+      mClusterList.push_back(cluster);
+      cluster = part;
+    }
+  }
+  if ( !cluster.is_one() ) {
+    mClusterList.push_back(cluster);
+  }
+}
+
+// @brief 像計算の手順を作る．
+// @param[in] qvars 消去する変数の集合
+// @param[out] schedule 結果を格納する変数
+//
+// IWLS95 の手法にならい，まだ選ばれていないクラスタのうち
+// 「そのクラスタにしか現れない変数の数 / 消去対象の変数の数」
+// が最大のものを順に選ぶ．
+void
+BdnReach::make_schedule(const BddVarSet& qvars,
+			Schedule& schedule)
+{
+  ymuint nc = mClusterList.size();
+
+  // 各クラスタのサポートのうち消去対象のもの
+  vector<BddVarSet> supp_list;
+  supp_list.reserve(nc);
+  BddVarSet all_supp(mMgr);
+  for (ymuint i = 0; i < nc; ++ i) {
+    BddVarSet supp = mClusterList[i].support() * qvars;
+    supp_list.push_back(supp);
+    all_supp += supp;
+  }
+
+  // どのクラスタにも現れない変数は最初に消去できる．
+  schedule.mPreVars = qvars - all_supp;
+  schedule.mClusterList.clear();
+  schedule.mQuantList.clear();
+
+  vector<bool> selected(nc, false);
+  for (ymuint n = 0; n < nc; ++ n) {
+    ymuint best = nc;
+    double best_val = -1.0;
+    ymuint64 best_size = 0;
+    BddVarSet best_vars(mMgr);
+    for (ymuint i = 0; i < nc; ++ i) {
+      if ( selected[i] ) {
+	continue;
+      }
+      // 他の未選択のクラスタに現れない変数はこのクラスタの直後に消去できる．
+      BddVarSet others(mMgr);
+      for (ymuint j = 0; j < nc; ++ j) {
+	if ( j != i && !selected[j] ) {
+	  others += supp_list[j];
+	}
+      }
+      BddVarSet vars = supp_list[i] - others;
+      ymuint supp_size = supp_list[i].size();
+      double val = supp_size > 0 ? double(vars.size()) / double(supp_size) : 0.0;
+      ymuint64 size = mClusterList[i].node_count();
+      if ( val > best_val || (val == best_val && size < best_size) ) {
+	best = i;
+	best_val = val;
+	best_size = size;
+	best_vars = vars;
+      }
+    }
+    ASSERT_COND( best < nc );
+    selected[best] = true;
+    schedule.mClusterList.push_back(mClusterList[best]);
+    schedule.mQuantList.push_back(best_vars);
+  }
+}
+
+// @brief 手順に従って関係積を計算する．
+// @param[in] from 対象の集合
+// @param[in] schedule 手順
+Bdd
+BdnReach::rel_prod(const Bdd& from,
+		   const Schedule& schedule)
+{
+  Bdd ans = from;
+  if ( !schedule.mPreVars.empty() ) {
+    ans = ans.esmooth(schedule.mPreVars);
+  }
+  ymuint nc = schedule.mClusterList.size();
+  for (ymuint i = 0; i < nc; ++ i) {
+    ans = and_exist(ans, schedule.mClusterList[i], schedule.mQuantList[i]);
+    ymuint64 size = ans.node_count();
+    if ( mPeakSize < size ) {
+      mPeakSize = size;
+    }
+  }
+  return ans;
+}
+
+// @brief 不動点を求める．
+// @param[in] start 開始状態の集合
+// @param[in] bad これと交わったら打ち切る状態の集合
+// @param[in] fwd 前向きの時 true
+// @param[in] max_iter 反復回数の上限
+Bdd
+BdnReach::fixpoint(const Bdd& start,
+		   const Bdd& bad,
+		   bool fwd,
+		   ymuint max_iter)
+{
+  mStatsList.clear();
+
+  Bdd reached = start;
+  Bdd frontier = start;
+  if ( !(reached & bad).is_zero() ) {
+    return reached;
+  }
+  for (ymuint iter = 0; max_iter == 0 || iter < max_iter; ++ iter) {
+    StopWatch timer;
+    timer.start();
+    mPeakSize = 0;
+
+    // 到達済みでフロンティアに含まれない状態は don't care なので
+    // generalized cofactor で簡単化できる場合には置き換える．
+    Bdd from = frontier;
+    if ( frontier != reached ) {
+      Bdd from1 = frontier / (frontier | ~reached);
+      if ( from1.node_count() < from.node_count() ) {
+	from = from1;
+      }
+    }
+    ymuint64 frontier_size = from.node_count();
+
+    Bdd next = fwd ? image(from) : preimage(from);
+    frontier = next & ~reached;
+    reached |= frontier;
+
+    timer.stop();
+    BdnReachStats stats;
+    stats.mIteration = iter;
+    stats.mFrontierSize = frontier_size;
+    stats.mPeakSize = mPeakSize;
+    stats.mReachedSize = reached.node_count();
+    stats.mMgrSize = mMgr.node_num();
+    stats.mTime = timer.time().real_time_usec();
+    mStatsList.push_back(stats);
+
+    if ( frontier.is_zero() || !(frontier & bad).is_zero() ) {
+      break;
+    }
+  }
+  return reached;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BdnReach::Schedule
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BdnReach::Schedule::Schedule(BddMgr& mgr) :
+  mPreVars(mgr)
+{
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
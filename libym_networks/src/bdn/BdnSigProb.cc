@@ -0,0 +1,298 @@
+﻿
+/// @file BdnSigProb.cc
+/// @brief BdnSigProb の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/BdnSigProb.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnConstNodeHandle.h"
+#include "../sigprob/SigProbEngine.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+// ノードの種類を表す値
+const ymuint64 kSigNone = 0;
+const ymuint64 kSigInput = 1;
+const ymuint64 kSigAnd = 2;
+const ymuint64 kSigXor = 3;
+const ymuint64 kSigOutput = 4;
+
+// ハンドルが定数の時 true を返す．
+// 定数に接続しているファンインはノードが nullptr で極性が値を表す．
+bool
+handle_const(BdnConstNodeHandle handle,
+	     bool& val)
+{
+  if ( handle.is_zero() ) {
+    val = false;
+    return true;
+  }
+  if ( handle.is_one() ) {
+    val = true;
+    return true;
+  }
+  if ( handle.node() == nullptr ) {
+    val = handle.inv();
+    return true;
+  }
+  return false;
+}
+
+// ハンドルを整数に符号化する．
+ymuint64
+handle_sig(BdnConstNodeHandle handle)
+{
+  bool val;
+  if ( handle_const(handle, val) ) {
+    return val ? 1 : 0;
+  }
+  const BdnNode* node = handle.node();
+  return (static_cast<ymuint64>(node->id() + 1) << 1) | (handle.inv() ? 1 : 0);
+}
+
+// ハンドルに対応する論理式を作る．
+// 定数でない場合は fanin_list にノード番号を追加し，
+// その位置を変数番号とするリテラルを返す．
+Expr
+handle_expr(BdnConstNodeHandle handle,
+	    vector<ymuint>& fanin_list)
+{
+  bool val;
+  if ( handle_const(handle, val) ) {
+    return val ? Expr::make_one() : Expr::make_zero();
+  }
+  VarId var(fanin_list.size());
+  fanin_list.push_back(handle.node()->id());
+  return Expr::make_literal(var, handle.inv());
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BdnSigProb
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] thread_num 計算に用いるスレッド数
+BdnSigProb::BdnSigProb(const BdnMgr& network,
+		       ymuint thread_num) :
+  mNetwork(network),
+  mEngine(new SigProbEngine(thread_num))
+{
+  scan();
+}
+
+// @brief デストラクタ
+BdnSigProb::~BdnSigProb()
+{
+  delete mEngine;
+}
+
+// @brief 入力の信号確率とトグル率を設定する．
+// @param[in] node 対象の入力ノード
+// @param[in] prob 値が 1 となる確率
+// @param[in] toggle トグル率
+void
+BdnSigProb::set_input_prob(const BdnNode* node,
+			   double prob,
+			   double toggle)
+{
+  ASSERT_COND( node->is_input() );
+  if ( node->id() * 3 >= mSignature.size() ) {
+    // 後から追加されたノード
+    scan();
+  }
+  mEngine->set_input_prob(node->id(), prob, toggle);
+}
+
+// @brief モンテカルロシミュレーションのパラメータを設定する．
+// @param[in] max_pattern パタン数の上限
+// @param[in] max_error 95% 信頼区間の半幅の目標値
+// @param[in] seed 乱数の種
+void
+BdnSigProb::set_mc_param(ymuint64 max_pattern,
+			 double max_error,
+			 ymuint32 seed)
+{
+  mEngine->set_mc_param(max_pattern, max_error, seed);
+}
+
+// @brief 局所カットのパラメータを設定する．
+// @param[in] cut_size カットの葉の数の上限
+// @param[in] cone_size カット内のノード数の上限
+void
+BdnSigProb::set_cut_param(ymuint cut_size,
+			  ymuint cone_size)
+{
+  mEngine->set_cut_param(cut_size, cone_size);
+}
+
+// @brief モンテカルロシミュレーションで求める．
+void
+BdnSigProb::simulate()
+{
+  scan();
+  mEngine->simulate();
+}
+
+// @brief 局所カットの BDD を用いて解析的に求める．
+void
+BdnSigProb::analyze()
+{
+  scan();
+  mEngine->analyze();
+}
+
+// @brief ネットワークの変更を反映して計算し直す．
+void
+BdnSigProb::update()
+{
+  scan();
+  mEngine->update();
+}
+
+// @brief シミュレーションしたパタン数を返す．
+ymuint64
+BdnSigProb::pattern_num() const
+{
+  return mEngine->pattern_num();
+}
+
+// @brief 信号確率を得る．
+// @param[in] node 対象のノード
+double
+BdnSigProb::prob(const BdnNode* node) const
+{
+  return mEngine->prob(node->id());
+}
+
+// @brief トグル率を得る．
+// @param[in] node 対象のノード
+double
+BdnSigProb::toggle(const BdnNode* node) const
+{
+  return mEngine->toggle(node->id());
+}
+
+// @brief 信号確率の 95% 信頼区間の半幅を得る．
+// @param[in] node 対象のノード
+double
+BdnSigProb::prob_error(const BdnNode* node) const
+{
+  return mEngine->prob_error(node->id());
+}
+
+// @brief トグル率の 95% 信頼区間の半幅を得る．
+// @param[in] node 対象のノード
+double
+BdnSigProb::toggle_error(const BdnNode* node) const
+{
+  return mEngine->toggle_error(node->id());
+}
+
+// @brief 結果を出力する．
+// @param[in] s 出力先のストリーム
+void
+BdnSigProb::dump(ostream& s) const
+{
+  bool simulated = mEngine->is_simulated();
+  ymuint n = mSignature.size() / 3;
+  for (ymuint id = 0; id < n; ++ id) {
+    const char* type_str = nullptr;
+    switch ( mSignature[id * 3] ) {
+    case kSigInput:  type_str = "input"; break;
+    case kSigAnd:    type_str = "and"; break;
+    case kSigXor:    type_str = "xor"; break;
+    case kSigOutput: type_str = "output"; break;
+    default: break;
+    }
+    if ( type_str == nullptr ) {
+      continue;
+    }
+    s << id << " " << type_str
+      << " " << mEngine->prob(id)
+      << " " << mEngine->toggle(id);
+    if ( simulated ) {
+      s << " " << mEngine->prob_error(id)
+	<< " " << mEngine->toggle_error(id);
+    }
+    s << endl;
+  }
+}
+
+// @brief ネットワークの構造を読み込む．
+void
+BdnSigProb::scan()
+{
+  ymuint n = mNetwork.max_node_id();
+  mEngine->resize(n);
+  mSignature.resize(n * 3, kSigNone);
+
+  vector<ymuint> fanin_list;
+  for (ymuint id = 0; id < n; ++ id) {
+    const BdnNode* node = mNetwork.node(id);
+    ymuint64 sig[3] = { kSigNone, 0, 0 };
+    if ( node != nullptr ) {
+      if ( node->is_input() ) {
+	sig[0] = kSigInput;
+      }
+      else if ( node->is_logic() ) {
+	sig[0] = node->is_xor() ? kSigXor : kSigAnd;
+	sig[1] = handle_sig(node->fanin_handle(0));
+	sig[2] = handle_sig(node->fanin_handle(1));
+      }
+      else if ( node->is_output() ) {
+	sig[0] = kSigOutput;
+	sig[1] = handle_sig(node->output_fanin_handle());
+      }
+    }
+    ymuint64* old_sig = &mSignature[id * 3];
+    if ( old_sig[0] == sig[0] && old_sig[1] == sig[1] && old_sig[2] == sig[2] ) {
+      continue;
+    }
+    old_sig[0] = sig[0];
+    old_sig[1] = sig[1];
+    old_sig[2] = sig[2];
+
+    switch ( sig[0] ) {
+    case kSigNone:
+      mEngine->set_none(id);
+      break;
+
+    case kSigInput:
+      mEngine->set_input(id);
+      break;
+
+    case kSigAnd:
+    case kSigXor:
+      {
+	fanin_list.clear();
+	Expr expr0 = handle_expr(node->fanin_handle(0), fanin_list);
+	Expr expr1 = handle_expr(node->fanin_handle(1), fanin_list);
+	Expr func = sig[0] == kSigXor ? expr0 ^ expr1 : expr0 & expr1;
+	mEngine->set_logic(id, fanin_list, func);
+      }
+      break;
+
+    case kSigOutput:
+      {
+	fanin_list.clear();
+	Expr func = handle_expr(node->output_fanin_handle(), fanin_list);
+	mEngine->set_logic(id, fanin_list, func);
+      }
+      break;
+    }
+  }
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
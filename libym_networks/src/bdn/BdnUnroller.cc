@@ -0,0 +1,294 @@
+﻿
+/// @file BdnUnroller.cc
+/// @brief BdnUnroller の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "BdnUnroller.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnDff.h"
+#include "YmNetworks/BdnLatch.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BdnUnroller
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] state_list 状態変数に対応するノード(D-FF/ラッチの出力)のリスト
+// @param[in] input_list 外部入力ノードのリスト
+// @param[in] init_list 初期状態のリスト
+// @param[in] sat_type SAT ソルバの種類
+// @param[in] sat_option SAT ソルバのオプション
+BdnUnroller::BdnUnroller(const BdnMgr& network,
+			 const vector<const BdnNode*>& state_list,
+			 const vector<const BdnNode*>& input_list,
+			 const vector<Bool3>& init_list,
+			 const string& sat_type,
+			 const string& sat_option) :
+  mNetwork(network),
+  mStateList(state_list),
+  mInputList(input_list),
+  mInitList(init_list),
+  mGraph(network),
+  mSolver(sat_type, sat_option)
+{
+  VarId var = mSolver.new_var();
+  mOne = Literal(var);
+  mSolver.add_clause(mOne);
+}
+
+// @brief デストラクタ
+BdnUnroller::~BdnUnroller()
+{
+}
+
+// @brief 1時刻分を展開する．
+void
+BdnUnroller::add_frame()
+{
+  ymuint frame = frame_num();
+  mLitMapList.push_back(vector<Literal>(mGraph.node_num()));
+  vector<Literal>& lit_map = mLitMapList.back();
+  lit_map[0] = ~mOne;
+
+  ymuint ns = mStateList.size();
+  if ( frame == 0 ) {
+    for (ymuint i = 0; i < ns; ++ i) {
+      Literal lit(mSolver.new_var());
+      lit_map[mGraph.node_id(mStateList[i])] = lit;
+      if ( !mInitList.empty() && mInitList[i] != kB3X ) {
+	mSolver.add_clause(mInitList[i] == kB3True ? lit : ~lit);
+      }
+    }
+  }
+  else {
+    // 前の時刻の次状態関数がこの時刻の状態となる．
+    const vector<Literal>& prev_map = mLitMapList[frame - 1];
+    for (ymuint i = 0; i < ns; ++ i) {
+      lit_map[mGraph.node_id(mStateList[i])] = make_next(prev_map, i);
+    }
+  }
+
+  for (vector<const BdnNode*>::iterator p = mInputList.begin();
+       p != mInputList.end(); ++ p) {
+    const BdnNode* node = *p;
+    lit_map[mGraph.node_id(node)] = Literal(mSolver.new_var());
+  }
+
+  // 論理ノードはトポロジカル順に連続した番号を持つ．
+  const ymuint8* type_array = mGraph.type_array();
+  const ymuint32* fanin0_array = mGraph.fanin0_array();
+  const ymuint32* fanin1_array = mGraph.fanin1_array();
+  ymuint start = mGraph.input_num() + 1;
+  ymuint end = start + mGraph.lnode_num();
+  for (ymuint id = start; id < end; ++ id) {
+    Literal lit0 = flat_lit(lit_map, fanin0_array[id]);
+    Literal lit1 = flat_lit(lit_map, fanin1_array[id]);
+    if ( type_array[id] == BdnFlatGraph::kXor ) {
+      lit_map[id] = make_xor(lit0, lit1);
+    }
+    else {
+      lit_map[id] = make_and(lit0, lit1);
+    }
+  }
+}
+
+// @brief ノードの出力のリテラルを得る．
+// @param[in] frame 時刻 ( 0 <= frame < frame_num() )
+// @param[in] node 対象のノード
+Literal
+BdnUnroller::node_lit(ymuint frame,
+		      const BdnNode* node) const
+{
+  ASSERT_COND( frame < frame_num() );
+  const vector<Literal>& lit_map = mLitMapList[frame];
+  ymuint id = mGraph.node_id(node);
+  if ( node->is_output() ) {
+    return flat_lit(lit_map, mGraph.fanin0(id));
+  }
+  return lit_map[id];
+}
+
+// @brief 2つの時刻の状態が異なるという制約を加える．
+// @param[in] frame1, frame2 時刻
+void
+BdnUnroller::add_distinct(ymuint frame1,
+			  ymuint frame2)
+{
+  // d_i -> (s1_i != s2_i) となる d_i を作り，
+  // いずれかの d_i が 1 という節を加える．
+  ymuint ns = mStateList.size();
+  vector<Literal> tmp_lits;
+  tmp_lits.reserve(ns);
+  for (ymuint i = 0; i < ns; ++ i) {
+    Literal lit1 = state_lit(frame1, i);
+    Literal lit2 = state_lit(frame2, i);
+    if ( lit1 == lit2 ) {
+      continue;
+    }
+    if ( lit1 == ~lit2 ) {
+      // 常に異なる．
+      return;
+    }
+    Literal dlit(mSolver.new_var());
+    mSolver.add_clause(~dlit, lit1, lit2);
+    mSolver.add_clause(~dlit, ~lit1, ~lit2);
+    tmp_lits.push_back(dlit);
+  }
+  if ( tmp_lits.empty() ) {
+    // 常に等しいので充足不能となる．
+    mSolver.add_clause(~mOne);
+  }
+  else {
+    mSolver.add_clause(tmp_lits);
+  }
+}
+
+// @brief SAT 問題を解く．
+// @param[in] assumptions 仮定
+Bool3
+BdnUnroller::solve(const vector<Literal>& assumptions)
+{
+  return mSolver.solve(assumptions, mModel);
+}
+
+// @brief 直前の solve() で得られた割り当てでのリテラルの値を得る．
+Bool3
+BdnUnroller::lit_val(Literal lit) const
+{
+  ymuint id = lit.varid().val();
+  if ( id >= mModel.size() ) {
+    return kB3X;
+  }
+  Bool3 val = mModel[id];
+  if ( lit.is_negative() ) {
+    val = ~val;
+  }
+  return val;
+}
+
+// @brief 出力ノードのリテラルを得る．
+Literal
+BdnUnroller::output_lit(const vector<Literal>& lit_map,
+			const BdnNode* node) const
+{
+  if ( node == nullptr ) {
+    return ~mOne;
+  }
+  return flat_lit(lit_map, mGraph.fanin0(mGraph.node_id(node)));
+}
+
+// @brief 状態変数の次状態のリテラルを作る．
+// @param[in] lit_map 現時刻のノードのリテラルの配列
+// @param[in] pos 状態変数の位置番号
+Literal
+BdnUnroller::make_next(const vector<Literal>& lit_map,
+		       ymuint pos)
+{
+  const BdnNode* node = mStateList[pos];
+  Literal q = lit_map[mGraph.node_id(node)];
+  Literal data;
+  Literal clr;
+  Literal pre;
+  const BdnDff* dff = node->dff();
+  if ( dff != nullptr ) {
+    data = output_lit(lit_map, dff->input());
+    clr = output_lit(lit_map, dff->clear());
+    pre = output_lit(lit_map, dff->preset());
+  }
+  else {
+    const BdnLatch* latch = node->latch();
+    ASSERT_COND( latch != nullptr );
+    data = output_lit(lit_map, latch->input());
+    const BdnNode* enable = latch->enable();
+    if ( enable != nullptr && enable->output_fanin() != nullptr ) {
+      data = make_ite(output_lit(lit_map, enable), data, q);
+    }
+    clr = output_lit(lit_map, latch->clear());
+    pre = output_lit(lit_map, latch->preset());
+  }
+  // ~clr & (pre | data)
+  Literal tmp = ~make_and(~pre, ~data);
+  return make_and(~clr, tmp);
+}
+
+// @brief AND のリテラルを作る．
+Literal
+BdnUnroller::make_and(Literal lit1,
+		      Literal lit2)
+{
+  if ( lit1 == ~mOne || lit2 == ~mOne || lit1 == ~lit2 ) {
+    return ~mOne;
+  }
+  if ( lit1 == mOne || lit1 == lit2 ) {
+    return lit2;
+  }
+  if ( lit2 == mOne ) {
+    return lit1;
+  }
+  Literal olit(mSolver.new_var());
+  mSolver.add_clause(~olit, lit1);
+  mSolver.add_clause(~olit, lit2);
+  mSolver.add_clause(olit, ~lit1, ~lit2);
+  return olit;
+}
+
+// @brief XOR のリテラルを作る．
+Literal
+BdnUnroller::make_xor(Literal lit1,
+		      Literal lit2)
+{
+  if ( lit1 == ~mOne ) {
+    return lit2;
+  }
+  if ( lit1 == mOne ) {
+    return ~lit2;
+  }
+  if ( lit2 == ~mOne ) {
+    return lit1;
+  }
+  if ( lit2 == mOne ) {
+    return ~lit1;
+  }
+  if ( lit1 == lit2 ) {
+    return ~mOne;
+  }
+  if ( lit1 == ~lit2 ) {
+    return mOne;
+  }
+  Literal olit(mSolver.new_var());
+  mSolver.add_clause(~olit, lit1, lit2);
+  mSolver.add_clause(~olit, ~lit1, ~lit2);
+  mSolver.add_clause(olit, ~lit1, lit2);
+  mSolver.add_clause(olit, lit1, ~lit2);
+  return olit;
+}
+
+// @brief ITE のリテラルを作る．
+Literal
+BdnUnroller::make_ite(Literal c,
+		      Literal t,
+		      Literal e)
+{
+  if ( c == mOne || t == e ) {
+    return t;
+  }
+  if ( c == ~mOne ) {
+    return e;
+  }
+  Literal olit(mSolver.new_var());
+  mSolver.add_clause(~c, ~t, olit);
+  mSolver.add_clause(~c, t, ~olit);
+  mSolver.add_clause(c, ~e, olit);
+  mSolver.add_clause(c, e, ~olit);
+  return olit;
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
@@ -0,0 +1,262 @@
+﻿#ifndef BDNUNROLLER_H
+#define BDNUNROLLER_H
+
+/// @file BdnUnroller.h
+/// @brief BdnUnroller のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/bdn.h"
+#include "YmNetworks/BdnNode.h"
+#include "YmNetworks/BdnFlatGraph.h"
+#include "YmLogic/SatSolver.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BdnUnroller BdnUnroller.h "BdnUnroller.h"
+/// @brief BdnMgr の時間展開を SAT ソルバ上に作るクラス
+///
+/// add_frame() を呼ぶたびに1時刻分の CNF を同じ SAT ソルバに追加する．
+/// すでに追加した節は変更しないので学習節はそのまま次の時刻でも使える．
+/// 時刻 t + 1 の状態変数は時刻 t の次状態関数のリテラルそのものとなる．
+/// 次状態関数は BdnReach と同じく clear ? 0 : preset ? 1 : data
+/// (ラッチの場合は data の代わりに enable ? data : q) とする．
+///
+/// 時刻ごとに同じ構造をたどるので，BdnMgr を一度 BdnFlatGraph に
+/// 変換しておき，時刻ごとのリテラルの配列もそのノード番号で引く．
+/// 定数0 のノードにも ~mOne を割り当てておくので，
+/// ファンインのリテラルは定数かどうかを区別せずに引ける．
+//////////////////////////////////////////////////////////////////////
+class BdnUnroller
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] state_list 状態変数に対応するノード(D-FF/ラッチの出力)のリスト
+  /// @param[in] input_list 外部入力ノードのリスト
+  /// @param[in] init_list 初期状態のリスト
+  /// @param[in] sat_type SAT ソルバの種類
+  /// @param[in] sat_option SAT ソルバのオプション
+  /// @note init_list が空の時は時刻 0 の状態を制約しない．
+  /// そうでなければ kB3X 以外の値を持つ状態変数を固定する．
+  BdnUnroller(const BdnMgr& network,
+	      const vector<const BdnNode*>& state_list,
+	      const vector<const BdnNode*>& input_list,
+	      const vector<Bool3>& init_list,
+	      const string& sat_type,
+	      const string& sat_option);
+
+  /// @brief デストラクタ
+  ~BdnUnroller();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 展開済みの時刻数を得る．
+  ymuint
+  frame_num() const;
+
+  /// @brief 1時刻分を展開する．
+  void
+  add_frame();
+
+  /// @brief ノードの出力のリテラルを得る．
+  /// @param[in] frame 時刻 ( 0 <= frame < frame_num() )
+  /// @param[in] node 対象のノード
+  /// @note 出力ノードの場合にはファンインのリテラルを返す．
+  Literal
+  node_lit(ymuint frame,
+	   const BdnNode* node) const;
+
+  /// @brief 状態変数のリテラルを得る．
+  /// @param[in] frame 時刻 ( 0 <= frame < frame_num() )
+  /// @param[in] pos 状態変数の位置番号
+  Literal
+  state_lit(ymuint frame,
+	    ymuint pos) const;
+
+  /// @brief 外部入力のリテラルを得る．
+  /// @param[in] frame 時刻 ( 0 <= frame < frame_num() )
+  /// @param[in] pos 外部入力の位置番号
+  Literal
+  input_lit(ymuint frame,
+	    ymuint pos) const;
+
+  /// @brief 2つの時刻の状態が異なるという制約を加える．
+  /// @param[in] frame1, frame2 時刻
+  void
+  add_distinct(ymuint frame1,
+	       ymuint frame2);
+
+  /// @brief SAT 問題を解く．
+  /// @param[in] assumptions 仮定
+  /// @return 結果を返す．
+  /// @note 充足した時の割り当ては lit_val() で得られる．
+  Bool3
+  solve(const vector<Literal>& assumptions);
+
+  /// @brief 直前の solve() で得られた割り当てでのリテラルの値を得る．
+  Bool3
+  lit_val(Literal lit) const;
+
+  /// @brief 探索を中止する．
+  /// @note 別スレッドから呼ばれることを仮定している．
+  void
+  stop();
+
+  /// @brief stop() による中止要求を取り消す．
+  void
+  clear_stop();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief BdnFlatGraph のリテラルに対応する SAT のリテラルを得る．
+  /// @param[in] lit_map 同じ時刻のノードのリテラルの配列
+  /// @param[in] flit BdnFlatGraph のリテラル
+  Literal
+  flat_lit(const vector<Literal>& lit_map,
+	   ymuint32 flit) const;
+
+  /// @brief 出力ノードのリテラルを得る．
+  /// @note ノードがない場合は定数0を返す．
+  Literal
+  output_lit(const vector<Literal>& lit_map,
+	     const BdnNode* node) const;
+
+  /// @brief 状態変数の次状態のリテラルを作る．
+  /// @param[in] lit_map 現時刻のノードのリテラルの配列
+  /// @param[in] pos 状態変数の位置番号
+  Literal
+  make_next(const vector<Literal>& lit_map,
+	    ymuint pos);
+
+  /// @brief AND のリテラルを作る．
+  Literal
+  make_and(Literal lit1,
+	   Literal lit2);
+
+  /// @brief XOR のリテラルを作る．
+  Literal
+  make_xor(Literal lit1,
+	   Literal lit2);
+
+  /// @brief ITE のリテラルを作る．
+  Literal
+  make_ite(Literal c,
+	   Literal t,
+	   Literal e);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const BdnMgr& mNetwork;
+
+  // 状態変数のノードのリスト
+  vector<const BdnNode*> mStateList;
+
+  // 外部入力ノードのリスト
+  vector<const BdnNode*> mInputList;
+
+  // 初期状態のリスト
+  vector<Bool3> mInitList;
+
+  // 配列で表したネットワークの構造
+  BdnFlatGraph mGraph;
+
+  // SAT ソルバ
+  SatSolver mSolver;
+
+  // 定数1のリテラル
+  Literal mOne;
+
+  // 時刻ごとのノードのリテラルの配列
+  // キーは mGraph のノード番号
+  vector<vector<Literal> > mLitMapList;
+
+  // 直前の solve() の結果の割り当て
+  vector<Bool3> mModel;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 展開済みの時刻数を得る．
+inline
+ymuint
+BdnUnroller::frame_num() const
+{
+  return mLitMapList.size();
+}
+
+// @brief 状態変数のリテラルを得る．
+inline
+Literal
+BdnUnroller::state_lit(ymuint frame,
+		       ymuint pos) const
+{
+  ASSERT_COND( frame < frame_num() );
+  return mLitMapList[frame][mGraph.node_id(mStateList[pos])];
+}
+
+// @brief 外部入力のリテラルを得る．
+inline
+Literal
+BdnUnroller::input_lit(ymuint frame,
+		       ymuint pos) const
+{
+  ASSERT_COND( frame < frame_num() );
+  return mLitMapList[frame][mGraph.node_id(mInputList[pos])];
+}
+
+// @brief BdnFlatGraph のリテラルに対応する SAT のリテラルを得る．
+inline
+Literal
+BdnUnroller::flat_lit(const vector<Literal>& lit_map,
+		      ymuint32 flit) const
+{
+  Literal lit = lit_map[BdnFlatGraph::lit_id(flit)];
+  if ( BdnFlatGraph::lit_inv(flit) ) {
+    lit = ~lit;
+  }
+  return lit;
+}
+
+// @brief 探索を中止する．
+inline
+void
+BdnUnroller::stop()
+{
+  mSolver.stop();
+}
+
+// @brief stop() による中止要求を取り消す．
+inline
+void
+BdnUnroller::clear_stop()
+{
+  mSolver.clear_stop();
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
+
+#endif // BDNUNROLLER_H
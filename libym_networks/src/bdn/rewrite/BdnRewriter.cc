@@ -0,0 +1,45 @@
+﻿
+/// @file BdnRewriter.cc
+/// @brief BdnRewriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/BdnRewriter.h"
+#include "RwtLib.h"
+#include "RwtMgr.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BdnRewriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BdnRewriter::BdnRewriter() :
+  mLib(new RwtLib)
+{
+}
+
+// @brief デストラクタ
+BdnRewriter::~BdnRewriter()
+{
+  delete mLib;
+}
+
+// @brief 書き換えを行う．
+// @param[in] network 対象のネットワーク
+// @param[in] use_zero 削減量が0の置き換えも行う時 true にする．
+// @return 置き換えを行った回数を返す．
+ymuint
+BdnRewriter::operator()(BdnMgr& network,
+			bool use_zero)
+{
+  RwtMgr mgr(network, *mLib);
+  return mgr.rewrite(use_zero);
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
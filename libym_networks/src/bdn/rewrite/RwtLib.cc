@@ -0,0 +1,260 @@
+﻿
+/// @file RwtLib.cc
+/// @brief RwtLib の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "RwtLib.h"
+#include "YmLogic/TvFunc.h"
+#include "YmLogic/NpnMap.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+#include "rwt_table"
+
+// 真理値表のマスク
+const ymuint kAllMask = 0xFFFFU;
+
+// 未設定のキャッシュ
+const ymuint32 kNoCache = 0xFFFFFFFFU;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス RwtLib
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+RwtLib::RwtLib() :
+  mNpnCache(kAllMask + 1, kNoCache),
+  mGraphArray(kAllMask + 1, nullptr),
+  mGraphNum(0)
+{
+  const ymuint16* table = rwt_table;
+  for (ymuint i = 0; i < rwt_num; ++ i) {
+    table = load_graph(table);
+  }
+  ASSERT_COND( table == rwt_table + sizeof(rwt_table) / sizeof(ymuint16) );
+}
+
+// @brief デストラクタ
+RwtLib::~RwtLib()
+{
+  for (vector<RwtGraph*>::iterator p = mGraphArray.begin();
+       p != mGraphArray.end(); ++ p) {
+    delete *p;
+  }
+}
+
+// @brief 関数に対応する部分グラフを求める．
+// @param[in] func 対象の関数の真理値表
+// @param[out] match 結果を格納する構造体
+void
+RwtLib::match(ymuint func,
+	      RwtMatch& match)
+{
+  func &= kAllMask;
+  ymuint32 data = mNpnCache[func];
+  if ( data == kNoCache ) {
+    data = cannonical(func);
+    mNpnCache[func] = data;
+  }
+
+  ymuint cfunc = data & kAllMask;
+  RwtGraph* graph = mGraphArray[cfunc];
+  ASSERT_COND( graph != nullptr );
+
+  match.mGraph = graph;
+  for (ymuint i = 0; i < 4; ++ i) {
+    ymuint j = (data >> (16 + i * 2)) & 3U;
+    match.mLeafPos[j] = i;
+    match.mLeafInv[j] = static_cast<bool>((data >> (24 + i)) & 1U);
+  }
+  match.mOutputInv = static_cast<bool>((data >> 28) & 1U);
+}
+
+// @brief NPN 正規化を行う．
+// @param[in] func 対象の関数の真理値表
+// @return 正規化の結果をパックしたものを返す．
+//
+// 結果は以下の形式でパックされる．
+// - 0 〜 15 : 代表関数の真理値表
+// - 16 〜 23 : 入力 i の代表関数での位置 (2ビットずつ)
+// - 24 〜 27 : 入力 i の反転属性
+// - 28 : 出力の反転属性
+ymuint32
+RwtLib::cannonical(ymuint func)
+{
+  vector<int> values(16);
+  for (ymuint p = 0; p < 16; ++ p) {
+    values[p] = (func >> p) & 1U;
+  }
+  TvFunc tv(4, values);
+  NpnMap cmap;
+  mNpnMgr.cannonical(tv, cmap);
+
+  // 関数が依存していない入力は写像が定義されていない場合があるので
+  // 空いている位置を割り当てる．
+  ymuint pos[4];
+  bool inv[4];
+  bool used[4] = { false, false, false, false };
+  bool valid[4];
+  for (ymuint i = 0; i < 4; ++ i) {
+    NpnVmap vmap = cmap.imap(VarId(i));
+    valid[i] = !vmap.is_invalid();
+    if ( valid[i] ) {
+      pos[i] = vmap.var().val();
+      inv[i] = vmap.inv();
+      used[pos[i]] = true;
+    }
+  }
+  for (ymuint i = 0; i < 4; ++ i) {
+    if ( !valid[i] ) {
+      ymuint j = 0;
+      for ( ; used[j]; ++ j) ;
+      pos[i] = j;
+      inv[i] = false;
+      used[j] = true;
+    }
+  }
+  bool oinv = cmap.oinv();
+
+  // 代表関数の真理値表は写像から直接計算する．
+  ymuint cfunc = 0U;
+  for (ymuint p = 0; p < 16; ++ p) {
+    ymuint q = 0U;
+    for (ymuint i = 0; i < 4; ++ i) {
+      ymuint v = ((p >> pos[i]) & 1U) ^ static_cast<ymuint>(inv[i]);
+      q |= (v << i);
+    }
+    ymuint v = ((func >> q) & 1U) ^ static_cast<ymuint>(oinv);
+    cfunc |= (v << p);
+  }
+
+  ymuint32 data = cfunc;
+  for (ymuint i = 0; i < 4; ++ i) {
+    data |= (pos[i] << (16 + i * 2));
+    if ( inv[i] ) {
+      data |= (1U << (24 + i));
+    }
+  }
+  if ( oinv ) {
+    data |= (1U << 28);
+  }
+  return data;
+}
+
+// @brief テーブルの部分グラフを代表関数に対する部分グラフに変換する．
+// @param[in] table テーブル上の部分グラフの先頭
+// @return 次の部分グラフの先頭を返す．
+//
+// テーブルの代表関数と NpnMgr の代表関数は異なるので，
+// cannonical() の変換に合わせて入力と出力のリテラルを付け替える．
+const ymuint16*
+RwtLib::load_graph(const ymuint16* table)
+{
+  ymuint func = table[0];
+  ymuint node_num = table[1];
+  ymuint olit = table[2];
+  table += 3;
+
+  ymuint32 data = cannonical(func);
+  mNpnCache[func] = data;
+  ymuint cfunc = data & kAllMask;
+  ASSERT_COND( mGraphArray[cfunc] == nullptr );
+
+  // テーブル上のインデックスごとの変換後のリテラル
+  vector<ymuint> lit_map(5 + node_num);
+  lit_map[0] = 0U;
+  for (ymuint i = 0; i < 4; ++ i) {
+    ymuint pos = (data >> (16 + i * 2)) & 3U;
+    ymuint inv = (data >> (24 + i)) & 1U;
+    lit_map[i + 1] = ((pos + 1) << 1) ^ inv;
+  }
+
+  RwtGraph* graph = new RwtGraph;
+  for (ymuint i = 0; i < node_num; ++ i) {
+    bool is_xor = static_cast<bool>(table[0]);
+    ymuint lit0 = lit_map[table[1] >> 1] ^ (table[1] & 1U);
+    ymuint lit1 = lit_map[table[2] >> 1] ^ (table[2] & 1U);
+    lit_map[i + 5] = new_node(is_xor, lit0, lit1, graph);
+    table += 3;
+  }
+  ymuint oinv = (data >> 28) & 1U;
+  graph->mOutput = lit_map[olit >> 1] ^ (olit & 1U) ^ oinv;
+
+  mGraphArray[cfunc] = graph;
+  ++ mGraphNum;
+
+  return table;
+}
+
+// @brief ノードをグラフに追加する．
+// @param[in] is_xor XOR の時 true にするフラグ
+// @param[in] lit0, lit1 ファンインのリテラル
+// @param[in] graph 対象のグラフ
+// @return 出力のリテラルを返す．
+// @note 同じノードがすでにあればそれを返す．
+ymuint
+RwtLib::new_node(bool is_xor,
+		 ymuint lit0,
+		 ymuint lit1,
+		 RwtGraph* graph)
+{
+  if ( lit0 > lit1 ) {
+    ymuint tmp = lit0;
+    lit0 = lit1;
+    lit1 = tmp;
+  }
+
+  ymuint oinv = 0U;
+  if ( is_xor ) {
+    // XOR の反転属性は出力に移す．
+    oinv = (lit0 ^ lit1) & 1U;
+    lit0 &= ~1U;
+    lit1 &= ~1U;
+    if ( lit0 == 0U ) {
+      return lit1 ^ oinv;
+    }
+    if ( lit0 == lit1 ) {
+      return oinv;
+    }
+  }
+  else {
+    if ( lit0 == 0U ) {
+      return 0U;
+    }
+    if ( lit0 == 1U ) {
+      return lit1;
+    }
+    if ( lit0 == lit1 ) {
+      return lit0;
+    }
+    if ( lit0 == (lit1 ^ 1U) ) {
+      return 0U;
+    }
+  }
+
+  ymuint n = graph->node_num();
+  for (ymuint i = 0; i < n; ++ i) {
+    if ( graph->is_xor(i) == is_xor &&
+	 graph->fanin(i, 0) == lit0 &&
+	 graph->fanin(i, 1) == lit1 ) {
+      return ((i + 5) << 1) ^ oinv;
+    }
+  }
+
+  graph->mNodeArray.push_back(static_cast<ymuint32>(is_xor));
+  graph->mNodeArray.push_back(lit0);
+  graph->mNodeArray.push_back(lit1);
+  return ((n + 5) << 1) ^ oinv;
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
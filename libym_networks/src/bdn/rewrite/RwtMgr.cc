@@ -0,0 +1,544 @@
+﻿
+/// @file RwtMgr.cc
+/// @brief RwtMgr の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "RwtMgr.h"
+#include "YmNetworks/BdnMgr.h"
+#include "YmNetworks/BdnNode.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+BEGIN_NONAMESPACE
+
+// 1つのノードに記録するカットの最大数
+const ymuint kMaxCut = 8;
+
+// 葉の参照回数の初期値
+const ymuint32 kLeafRef = 0xFFFFFFFFU;
+
+// カットの関数を葉の位置に合わせて変換する．
+// @param[in] cut 元のカット
+// @param[in] leaf_list 新しい葉のリスト
+// @param[in] leaf_num 新しい葉の数
+ymuint
+expand_func(const RwtCut& cut,
+	    BdnNode* const leaf_list[],
+	    ymuint leaf_num)
+{
+  ymuint pos[4];
+  for (ymuint i = 0; i < cut.mLeafNum; ++ i) {
+    for (ymuint j = 0; j < leaf_num; ++ j) {
+      if ( leaf_list[j] == cut.mLeaf[i] ) {
+	pos[i] = j;
+	break;
+      }
+    }
+  }
+
+  ymuint func = 0U;
+  for (ymuint p = 0; p < 16; ++ p) {
+    ymuint q = 0U;
+    for (ymuint i = 0; i < cut.mLeafNum; ++ i) {
+      if ( (p >> pos[i]) & 1U ) {
+	q |= (1U << i);
+      }
+    }
+    if ( (cut.mFunc >> q) & 1U ) {
+      func |= (1U << p);
+    }
+  }
+  return func;
+}
+
+// 部分グラフのリテラルに対応するハンドルを得る．
+inline
+BdnNodeHandle
+lit_handle(ymuint lit,
+	   const vector<BdnNodeHandle>& leaf_handle_list,
+	   const vector<BdnNodeHandle>& node_handle_list)
+{
+  ymuint idx = lit >> 1;
+  BdnNodeHandle h;
+  if ( idx == 0 ) {
+    h = BdnNodeHandle::make_zero();
+  }
+  else if ( idx <= 4 ) {
+    h = leaf_handle_list[idx - 1];
+  }
+  else {
+    h = node_handle_list[idx - 5];
+  }
+  if ( lit & 1U ) {
+    h = ~h;
+  }
+  return h;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス RwtMgr
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] lib 部分グラフのライブラリ
+RwtMgr::RwtMgr(BdnMgr& network,
+	       RwtLib& lib) :
+  mNetwork(network),
+  mLib(lib),
+  mStamp(0)
+{
+}
+
+// @brief デストラクタ
+RwtMgr::~RwtMgr()
+{
+}
+
+// @brief 書き換えを行う．
+// @param[in] use_zero 削減量が0の置き換えも行う時 true にする．
+// @return 置き換えを行った回数を返す．
+ymuint
+RwtMgr::rewrite(bool use_zero)
+{
+  mNetwork.clean_up();
+
+  resize(mNetwork.max_node_id());
+
+  vector<BdnNode*> node_list;
+  mNetwork._sort(node_list);
+  vector<ymuint32> gen_list;
+  gen_list.reserve(node_list.size());
+  for (vector<BdnNode*>::iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    BdnNode* node = *p;
+    gen_list.push_back(mGen[node->id()]);
+  }
+
+  ymuint count = 0;
+  vector<ymuint> deleted_list;
+  for (ymuint i = 0; i < node_list.size(); ++ i) {
+    BdnNode* node = node_list[i];
+    if ( mGen[node->id()] != gen_list[i] ) {
+      // すでに削除されている．
+      continue;
+    }
+
+    // 後の処理で mCutArray が変更される可能性があるのでコピーしておく．
+    vector<RwtCut> tmp_list = cut_list(node);
+
+    int best_gain = -1;
+    RwtCut best_cut;
+    RwtMatch best_match;
+    for (vector<RwtCut>::iterator p = tmp_list.begin();
+	 p != tmp_list.end(); ++ p) {
+      const RwtCut& cut = *p;
+      if ( !check_cut(cut) ) {
+	continue;
+      }
+      RwtMatch match;
+      mLib.match(cut.mFunc, match);
+      int msize = mffc_size(node, cut);
+      int added = count_added(node, cut, match);
+      if ( added < 0 ) {
+	continue;
+      }
+      int gain = msize - added;
+      if ( best_gain < gain ) {
+	best_gain = gain;
+	best_cut = cut;
+	best_match = match;
+      }
+    }
+
+    if ( best_gain > 0 || (use_zero && best_gain == 0) ) {
+      BdnNodeHandle new_handle = build(best_cut, best_match);
+      if ( new_handle.node() == node ) {
+	continue;
+      }
+      mNetwork.replace_logic(node, new_handle, deleted_list);
+      resize(mNetwork.max_node_id());
+      for (vector<ymuint>::iterator p = deleted_list.begin();
+	   p != deleted_list.end(); ++ p) {
+	ymuint id = *p;
+	++ mGen[id];
+	mCutValid[id] = false;
+	mCutArray[id].clear();
+      }
+      ++ count;
+    }
+  }
+
+  return count;
+}
+
+// @brief ID 番号に関する配列を確保する．
+// @param[in] id ID 番号
+void
+RwtMgr::resize(ymuint id)
+{
+  if ( mGen.size() < id ) {
+    mGen.resize(id, 0U);
+    mCutArray.resize(id);
+    mCutValid.resize(id, false);
+    mRefArray.resize(id, 0U);
+    mRefStamp.resize(id, 0U);
+    mMffcMark.resize(id, 0U);
+  }
+}
+
+// @brief ノードのカットのリストを得る．
+// @param[in] node 対象のノード
+// @note 自明なカットは含まない．
+const vector<RwtCut>&
+RwtMgr::cut_list(BdnNode* node)
+{
+  ymuint id = node->id();
+  resize(id + 1);
+  if ( !mCutValid[id] ) {
+    // enum_cuts() の中で mCutArray が変更される可能性があるので
+    // 別のリストに求めてからコピーする．
+    vector<RwtCut> tmp_list;
+    enum_cuts(node, tmp_list);
+    mCutArray[id].swap(tmp_list);
+    mCutValid[id] = true;
+  }
+  return mCutArray[id];
+}
+
+// @brief ノードのカットを列挙する．
+// @param[in] node 対象の論理ノード
+// @param[out] cut_list 結果を格納するリスト
+void
+RwtMgr::enum_cuts(BdnNode* node,
+		  vector<RwtCut>& cut_list)
+{
+  cut_list.clear();
+
+  vector<RwtCut> cut_list0;
+  fanin_cuts(node->fanin0(), cut_list0);
+  vector<RwtCut> cut_list1;
+  fanin_cuts(node->fanin1(), cut_list1);
+
+  ymuint inv0 = node->fanin0_inv() ? 0xFFFFU : 0U;
+  ymuint inv1 = node->fanin1_inv() ? 0xFFFFU : 0U;
+  bool is_xor = node->is_xor();
+
+  for (vector<RwtCut>::iterator p0 = cut_list0.begin();
+       p0 != cut_list0.end(); ++ p0) {
+    const RwtCut& cut0 = *p0;
+    for (vector<RwtCut>::iterator p1 = cut_list1.begin();
+	 p1 != cut_list1.end(); ++ p1) {
+      const RwtCut& cut1 = *p1;
+
+      // 葉をID番号の順にマージする．
+      RwtCut cut;
+      ymuint n = 0;
+      ymuint i0 = 0;
+      ymuint i1 = 0;
+      bool ok = true;
+      while ( i0 < cut0.mLeafNum || i1 < cut1.mLeafNum ) {
+	if ( n == 4 ) {
+	  ok = false;
+	  break;
+	}
+	if ( i1 == cut1.mLeafNum ||
+	     (i0 < cut0.mLeafNum &&
+	      cut0.mLeaf[i0]->id() < cut1.mLeaf[i1]->id()) ) {
+	  cut.mLeaf[n] = cut0.mLeaf[i0];
+	  cut.mLeafGen[n] = cut0.mLeafGen[i0];
+	  ++ i0;
+	}
+	else if ( i0 == cut0.mLeafNum ||
+		  cut1.mLeaf[i1]->id() < cut0.mLeaf[i0]->id() ) {
+	  cut.mLeaf[n] = cut1.mLeaf[i1];
+	  cut.mLeafGen[n] = cut1.mLeafGen[i1];
+	  ++ i1;
+	}
+	else {
+	  cut.mLeaf[n] = cut0.mLeaf[i0];
+	  cut.mLeafGen[n] = cut0.mLeafGen[i0];
+	  ++ i0;
+	  ++ i1;
+	}
+	++ n;
+      }
+      if ( !ok ) {
+	continue;
+      }
+      cut.mLeafNum = n;
+
+      // 同じ葉を持つカットがあれば捨てる．
+      bool found = false;
+      for (vector<RwtCut>::iterator p = cut_list.begin();
+	   p != cut_list.end(); ++ p) {
+	const RwtCut& cut2 = *p;
+	if ( cut2.mLeafNum != n ) {
+	  continue;
+	}
+	bool diff = false;
+	for (ymuint i = 0; i < n; ++ i) {
+	  if ( cut2.mLeaf[i] != cut.mLeaf[i] ) {
+	    diff = true;
+	    break;
+	  }
+	}
+	if ( !diff ) {
+	  found = true;
+	  break;
+	}
+      }
+      if ( found ) {
+	continue;
+      }
+
+      ymuint func0 = expand_func(cut0, cut.mLeaf, n) ^ inv0;
+      ymuint func1 = expand_func(cut1, cut.mLeaf, n) ^ inv1;
+      cut.mFunc = is_xor ? (func0 ^ func1) : (func0 & func1);
+
+      cut_list.push_back(cut);
+      if ( cut_list.size() == kMaxCut ) {
+	return;
+      }
+    }
+  }
+}
+
+// @brief ファンインのカットのリストを作る．
+// @param[in] node 対象のノード
+// @param[out] cut_list 結果を格納するリスト
+// @note 自明なカットも含む．
+void
+RwtMgr::fanin_cuts(BdnNode* node,
+		   vector<RwtCut>& cut_list)
+{
+  resize(node->id() + 1);
+
+  RwtCut cut;
+  cut.mLeafNum = 1;
+  cut.mLeaf[0] = node;
+  cut.mLeafGen[0] = mGen[node->id()];
+  cut.mFunc = 0xAAAAU;
+  cut_list.push_back(cut);
+
+  if ( node->is_logic() ) {
+    const vector<RwtCut>& src_list = this->cut_list(node);
+    for (vector<RwtCut>::const_iterator p = src_list.begin();
+	 p != src_list.end(); ++ p) {
+      if ( check_cut(*p) ) {
+	cut_list.push_back(*p);
+      }
+    }
+  }
+}
+
+// @brief カットの葉が削除されていないか調べる．
+bool
+RwtMgr::check_cut(const RwtCut& cut) const
+{
+  for (ymuint i = 0; i < cut.mLeafNum; ++ i) {
+    if ( mGen[cut.mLeaf[i]->id()] != cut.mLeafGen[i] ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief ノードの MFFC のサイズを求める．
+// @param[in] node 根のノード
+// @param[in] cut カット
+// @note MFFC に含まれるノードには mMffcMark に mStamp を設定する．
+ymuint
+RwtMgr::mffc_size(BdnNode* node,
+		  const RwtCut& cut)
+{
+  ++ mStamp;
+
+  // 葉は MFFC に含めない．
+  for (ymuint i = 0; i < cut.mLeafNum; ++ i) {
+    ymuint id = cut.mLeaf[i]->id();
+    mRefStamp[id] = mStamp;
+    mRefArray[id] = kLeafRef;
+  }
+
+  return deref(node);
+}
+
+// @brief mffc_size() の下請け関数
+ymuint
+RwtMgr::deref(BdnNode* node)
+{
+  mMffcMark[node->id()] = mStamp;
+  ymuint count = 1;
+  for (ymuint i = 0; i < 2; ++ i) {
+    BdnNode* inode = node->fanin(i);
+    if ( !inode->is_logic() ) {
+      continue;
+    }
+    ymuint id = inode->id();
+    if ( mRefStamp[id] != mStamp ) {
+      mRefStamp[id] = mStamp;
+      mRefArray[id] = inode->fanout_num();
+    }
+    if ( mRefArray[id] == kLeafRef ) {
+      continue;
+    }
+    -- mRefArray[id];
+    if ( mRefArray[id] == 0 ) {
+      count += deref(inode);
+    }
+  }
+  return count;
+}
+
+// @brief 置き換えによって増えるノード数を数える．
+// @param[in] node 根のノード
+// @param[in] cut カット
+// @param[in] match 部分グラフとの対応
+// @return 増えるノード数を返す．
+// @note 置き換えられない場合には -1 を返す．
+int
+RwtMgr::count_added(BdnNode* node,
+		    const RwtCut& cut,
+		    const RwtMatch& match)
+{
+  vector<BdnNodeHandle> leaf_handle_list;
+  leaf_handles(cut, match, leaf_handle_list);
+
+  const RwtGraph* graph = match.mGraph;
+  vector<bool> mark_list;
+  mark_graph(graph, mark_list);
+
+  ymuint n = graph->node_num();
+  // まだ存在しないノードはエラーハンドルで表す．
+  vector<BdnNodeHandle> node_handle_list(n);
+  int added = 0;
+  for (ymuint i = 0; i < n; ++ i) {
+    if ( !mark_list[i] ) {
+      continue;
+    }
+    BdnNodeHandle h0 = lit_handle(graph->fanin(i, 0),
+				  leaf_handle_list, node_handle_list);
+    BdnNodeHandle h1 = lit_handle(graph->fanin(i, 1),
+				  leaf_handle_list, node_handle_list);
+    if ( h0.is_error() || h1.is_error() ) {
+      ++ added;
+      continue;
+    }
+    BdnNodeHandle h = graph->is_xor(i) ? mNetwork.find_xor(h0, h1) :
+					 mNetwork.find_and(h0, h1);
+    if ( h.is_error() ) {
+      ++ added;
+      continue;
+    }
+    BdnNode* node1 = h.node();
+    if ( node1 == node ) {
+      // 自分自身が現れたら置き換えは無意味
+      return -1;
+    }
+    if ( node1 != nullptr && mMffcMark[node1->id()] == mStamp ) {
+      // MFFC 内のノードは削除されずに残る．
+      ++ added;
+    }
+    node_handle_list[i] = h;
+  }
+
+  return added;
+}
+
+// @brief 部分グラフを実際に作る．
+// @param[in] cut カット
+// @param[in] match 部分グラフとの対応
+// @return 出力のハンドルを返す．
+BdnNodeHandle
+RwtMgr::build(const RwtCut& cut,
+	      const RwtMatch& match)
+{
+  vector<BdnNodeHandle> leaf_handle_list;
+  leaf_handles(cut, match, leaf_handle_list);
+
+  const RwtGraph* graph = match.mGraph;
+  vector<bool> mark_list;
+  mark_graph(graph, mark_list);
+
+  ymuint n = graph->node_num();
+  vector<BdnNodeHandle> node_handle_list(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    if ( !mark_list[i] ) {
+      continue;
+    }
+    BdnNodeHandle h0 = lit_handle(graph->fanin(i, 0),
+				  leaf_handle_list, node_handle_list);
+    BdnNodeHandle h1 = lit_handle(graph->fanin(i, 1),
+				  leaf_handle_list, node_handle_list);
+    node_handle_list[i] = graph->is_xor(i) ? mNetwork.new_xor(h0, h1) :
+					     mNetwork.new_and(h0, h1);
+  }
+
+  BdnNodeHandle ans = lit_handle(graph->output(),
+				 leaf_handle_list, node_handle_list);
+  if ( match.mOutputInv ) {
+    ans = ~ans;
+  }
+  return ans;
+}
+
+// @brief 部分グラフの入力に対応するハンドルを得る．
+// @param[in] cut カット
+// @param[in] match 部分グラフとの対応
+// @param[out] handle_list 結果を格納するリスト
+void
+RwtMgr::leaf_handles(const RwtCut& cut,
+		     const RwtMatch& match,
+		     vector<BdnNodeHandle>& handle_list)
+{
+  handle_list.clear();
+  handle_list.resize(4);
+  for (ymuint j = 0; j < 4; ++ j) {
+    ymuint pos = match.mLeafPos[j];
+    if ( pos < cut.mLeafNum ) {
+      handle_list[j] = BdnNodeHandle(cut.mLeaf[pos], match.mLeafInv[j]);
+    }
+    else {
+      // 関数が依存していない入力
+      handle_list[j] = BdnNodeHandle::make_zero();
+    }
+  }
+}
+
+// @brief 部分グラフの出力から到達可能なノードに印をつける．
+// @param[in] graph 部分グラフ
+// @param[out] mark_list 結果を格納するリスト
+void
+RwtMgr::mark_graph(const RwtGraph* graph,
+		   vector<bool>& mark_list)
+{
+  ymuint n = graph->node_num();
+  mark_list.clear();
+  mark_list.resize(n, false);
+  ymuint oidx = graph->output() >> 1;
+  if ( oidx >= 5 ) {
+    mark_list[oidx - 5] = true;
+  }
+  for (ymuint i = n; i -- > 0; ) {
+    if ( !mark_list[i] ) {
+      continue;
+    }
+    for (ymuint j = 0; j < 2; ++ j) {
+      ymuint idx = graph->fanin(i, j) >> 1;
+      if ( idx >= 5 ) {
+	mark_list[idx - 5] = true;
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM_NETWORKS_BDN
@@ -0,0 +1,194 @@
+﻿#ifndef RWTMGR_H
+#define RWTMGR_H
+
+/// @file RwtMgr.h
+/// @brief RwtMgr のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/bdn.h"
+#include "YmNetworks/BdnNodeHandle.h"
+#include "RwtLib.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_BDN
+
+//////////////////////////////////////////////////////////////////////
+/// @class RwtCut RwtMgr.h "RwtMgr.h"
+/// @brief 4入力以下のカットを表す構造体
+///
+/// 葉は ID 番号の昇順に並べる．
+/// 葉が削除されたかどうかは世代番号で判定する．
+//////////////////////////////////////////////////////////////////////
+struct RwtCut
+{
+  // 葉の数
+  ymuint mLeafNum;
+
+  // 葉のノード
+  BdnNode* mLeaf[4];
+
+  // 葉の世代番号
+  ymuint32 mLeafGen[4];
+
+  // 葉を入力とする関数の真理値表
+  ymuint mFunc;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class RwtMgr RwtMgr.h "RwtMgr.h"
+/// @brief BdnMgr に対して書き換えを行うクラス
+///
+/// 各ノードの4入力カットの関数を RwtLib の部分グラフで置き換え，
+/// 共有されているノードを考慮したうえでノード数が減る場合のみ
+/// 置き換えを行う．
+//////////////////////////////////////////////////////////////////////
+class RwtMgr
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] lib 部分グラフのライブラリ
+  RwtMgr(BdnMgr& network,
+	 RwtLib& lib);
+
+  /// @brief デストラクタ
+  ~RwtMgr();
+
+
+public:
+
+  /// @brief 書き換えを行う．
+  /// @param[in] use_zero 削減量が0の置き換えも行う時 true にする．
+  /// @return 置き換えを行った回数を返す．
+  ymuint
+  rewrite(bool use_zero);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ID 番号に関する配列を確保する．
+  /// @param[in] id ID 番号
+  void
+  resize(ymuint id);
+
+  /// @brief ノードのカットのリストを得る．
+  /// @param[in] node 対象のノード
+  /// @note 自明なカットは含まない．
+  const vector<RwtCut>&
+  cut_list(BdnNode* node);
+
+  /// @brief ノードのカットを列挙する．
+  /// @param[in] node 対象の論理ノード
+  /// @param[out] cut_list 結果を格納するリスト
+  void
+  enum_cuts(BdnNode* node,
+	    vector<RwtCut>& cut_list);
+
+  /// @brief ファンインのカットのリストを作る．
+  /// @param[in] node 対象のノード
+  /// @param[out] cut_list 結果を格納するリスト
+  /// @note 自明なカットも含む．
+  void
+  fanin_cuts(BdnNode* node,
+	     vector<RwtCut>& cut_list);
+
+  /// @brief カットの葉が削除されていないか調べる．
+  bool
+  check_cut(const RwtCut& cut) const;
+
+  /// @brief ノードの MFFC のサイズを求める．
+  /// @param[in] node 根のノード
+  /// @param[in] cut カット
+  /// @note MFFC に含まれるノードには mMffcMark に mStamp を設定する．
+  ymuint
+  mffc_size(BdnNode* node,
+	    const RwtCut& cut);
+
+  /// @brief mffc_size() の下請け関数
+  ymuint
+  deref(BdnNode* node);
+
+  /// @brief 置き換えによって増えるノード数を数える．
+  /// @param[in] node 根のノード
+  /// @param[in] cut カット
+  /// @param[in] match 部分グラフとの対応
+  /// @return 増えるノード数を返す．
+  /// @note 置き換えられない場合には -1 を返す．
+  int
+  count_added(BdnNode* node,
+	      const RwtCut& cut,
+	      const RwtMatch& match);
+
+  /// @brief 部分グラフを実際に作る．
+  /// @param[in] cut カット
+  /// @param[in] match 部分グラフとの対応
+  /// @return 出力のハンドルを返す．
+  BdnNodeHandle
+  build(const RwtCut& cut,
+	const RwtMatch& match);
+
+  /// @brief 部分グラフの入力に対応するハンドルを得る．
+  /// @param[in] cut カット
+  /// @param[in] match 部分グラフとの対応
+  /// @param[out] handle_list 結果を格納するリスト
+  void
+  leaf_handles(const RwtCut& cut,
+	       const RwtMatch& match,
+	       vector<BdnNodeHandle>& handle_list);
+
+  /// @brief 部分グラフの出力から到達可能なノードに印をつける．
+  /// @param[in] graph 部分グラフ
+  /// @param[out] mark_list 結果を格納するリスト
+  void
+  mark_graph(const RwtGraph* graph,
+	     vector<bool>& mark_list);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  BdnMgr& mNetwork;
+
+  // 部分グラフのライブラリ
+  RwtLib& mLib;
+
+  // ID 番号ごとの世代番号
+  // ノードが削除されるたびに1増える．
+  vector<ymuint32> mGen;
+
+  // ID 番号ごとのカットのリスト
+  vector<vector<RwtCut> > mCutArray;
+
+  // mCutArray が有効な時 true となる配列
+  vector<bool> mCutValid;
+
+  // MFFC を求める際の参照回数
+  vector<ymuint32> mRefArray;
+
+  // mRefArray が有効な時に mStamp が入る配列
+  vector<ymuint32> mRefStamp;
+
+  // MFFC に含まれる時に mStamp が入る配列
+  vector<ymuint32> mMffcMark;
+
+  // 作業用のスタンプ
+  ymuint32 mStamp;
+
+};
+
+END_NAMESPACE_YM_NETWORKS_BDN
+
+#endif // RWTMGR_H
@@ -0,0 +1,396 @@
+
+/// @file rwtgen.cc
+/// @brief RwtLib.cc の部分グラフのテーブル(rwt_table)を作るプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 4入力の NPN 同値類ごとに AND/XOR ノード数が最小の部分グラフを
+/// 全探索で求めて標準出力に書き出す．
+/// 単体でコンパイルできる．
+///   g++ -std=c++11 -O2 -o rwtgen rwtgen.cc
+///   ./rwtgen > rwt_table
+
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+
+
+using namespace std;
+
+typedef unsigned int ymuint;
+
+// 真理値表のマスク
+const ymuint kAllMask = 0xFFFFU;
+
+// 各変数の値が1となるビットのマスク
+const ymuint kVarMask[] = {
+  0xAAAAU, 0xCCCCU, 0xF0F0U, 0xFF00U
+};
+
+// 探索するノード数の上限
+// 4入力関数はすべて7ノード以下で実現できる．
+const ymuint kMaxNode = 7;
+
+// ノードの種類
+// 関数は出力の極性を正規化(0番めのビットを0に)したもので扱う．
+// - 0: a & b
+// - 1: a & ~b
+// - 2: ~a & b
+// - 3: a | b (~(~a & ~b))
+// - 4: a ^ b
+const ymuint kOpNum = 5;
+
+// 出力の極性を正規化する．
+inline
+ymuint
+normalize(ymuint func)
+{
+  return (func & 1U) ? (func ^ kAllMask) : func;
+}
+
+// ノードの関数を計算する．
+inline
+ymuint
+calc_op(ymuint op,
+	ymuint a,
+	ymuint b)
+{
+  switch ( op ) {
+  case 0: return a & b;
+  case 1: return a & ~b & kAllMask;
+  case 2: return ~a & b & kAllMask;
+  case 3: return a | b;
+  case 4: return a ^ b;
+  }
+  return 0U;
+}
+
+// 入力の置換と反転，出力の反転を行った関数を求める．
+// 変換後の関数の入力 i は元の関数の入力 perm[i] に対応する．
+ymuint
+xform(ymuint func,
+      const ymuint perm[],
+      ymuint imask,
+      ymuint oinv)
+{
+  ymuint ans = 0U;
+  for (ymuint p = 0; p < 16; ++ p) {
+    ymuint q = 0U;
+    for (ymuint i = 0; i < 4; ++ i) {
+      ymuint v = ((p >> i) ^ (imask >> i)) & 1U;
+      q |= (v << perm[i]);
+    }
+    ans |= (((func >> q) ^ oinv) & 1U) << p;
+  }
+  return ans;
+}
+
+//////////////////////////////////////////////////////////////////////
+// 最小の部分グラフを探すクラス
+//
+// 信号番号 0 〜 3 が入力，4 以降がノードを表す．
+// ノードは位相順に並べ，互いに依存しない隣り合うノードは
+// (ファンイン0, ファンイン1, 種類) の辞書順に並べたものだけを考える．
+// また，最後のノード以外はどこかで使われていなければならない．
+//////////////////////////////////////////////////////////////////////
+class Searcher
+{
+public:
+
+  // 関数 func を node_num 個のノードで実現できるか調べる．
+  bool
+  search(ymuint func,
+	 ymuint node_num)
+  {
+    mTarget = func;
+    mNodeNum = node_num;
+    mFunc.assign(4 + node_num, 0U);
+    mOp.assign(node_num, 0U);
+    mFanin0.assign(node_num, 0U);
+    mFanin1.assign(node_num, 0U);
+    mRef.assign(4 + node_num, 0U);
+    for (ymuint i = 0; i < 4; ++ i) {
+      mFunc[i] = kVarMask[i];
+    }
+    return dfs(0, 0);
+  }
+
+  // 見つかったノードの種類
+  ymuint
+  op(ymuint pos) const
+  {
+    return mOp[pos];
+  }
+
+  // 見つかったノードのファンイン
+  ymuint
+  fanin(ymuint pos,
+	ymuint fpos) const
+  {
+    return fpos == 0 ? mFanin0[pos] : mFanin1[pos];
+  }
+
+
+private:
+
+  // pos 番めのノードを決める．
+  // unused はまだ使われていないノード数
+  bool
+  dfs(ymuint pos,
+      ymuint unused)
+  {
+    ymuint nsig = 4 + pos;
+    ymuint rest = mNodeNum - pos;
+    if ( rest == 1 ) {
+      return last(unused);
+    }
+    for (ymuint a = 0; a < nsig; ++ a) {
+      for (ymuint b = a + 1; b < nsig; ++ b) {
+	for (ymuint op = 0; op < kOpNum; ++ op) {
+	  if ( pos > 0 ) {
+	    // 直前のノードを使わない場合は辞書順に並べる．
+	    ymuint prev = nsig - 1;
+	    if ( a != prev && b != prev ) {
+	      if ( a < mFanin0[pos - 1] ) {
+		continue;
+	      }
+	      if ( a == mFanin0[pos - 1] ) {
+		if ( b < mFanin1[pos - 1] ) {
+		  continue;
+		}
+		if ( b == mFanin1[pos - 1] && op <= mOp[pos - 1] ) {
+		  continue;
+		}
+	      }
+	    }
+	  }
+	  ymuint func = calc_op(op, mFunc[a], mFunc[b]);
+	  if ( func == 0U || func == mTarget || defined(func, nsig) ) {
+	    continue;
+	  }
+	  ymuint unused1 = unused + 1;
+	  if ( a >= 4 && mRef[a] == 0 ) {
+	    -- unused1;
+	  }
+	  if ( b >= 4 && mRef[b] == 0 ) {
+	    -- unused1;
+	  }
+	  if ( unused1 > rest ) {
+	    // 残りのノードで使い切れない．
+	    continue;
+	  }
+	  mFunc[nsig] = func;
+	  mOp[pos] = op;
+	  mFanin0[pos] = a;
+	  mFanin1[pos] = b;
+	  ++ mRef[a];
+	  ++ mRef[b];
+	  bool found = dfs(pos + 1, unused1);
+	  -- mRef[a];
+	  -- mRef[b];
+	  if ( found ) {
+	    return true;
+	  }
+	}
+      }
+    }
+    return false;
+  }
+
+  // 最後のノードを決める．
+  bool
+  last(ymuint unused)
+  {
+    ymuint pos = mNodeNum - 1;
+    ymuint nsig = 4 + pos;
+    for (ymuint a = 0; a < nsig; ++ a) {
+      for (ymuint b = a + 1; b < nsig; ++ b) {
+	// 使われていないノードはすべてファンインにならなければならない．
+	ymuint n = 0;
+	if ( a >= 4 && mRef[a] == 0 ) {
+	  ++ n;
+	}
+	if ( b >= 4 && mRef[b] == 0 ) {
+	  ++ n;
+	}
+	if ( n != unused ) {
+	  continue;
+	}
+	for (ymuint op = 0; op < kOpNum; ++ op) {
+	  if ( calc_op(op, mFunc[a], mFunc[b]) == mTarget ) {
+	    mOp[pos] = op;
+	    mFanin0[pos] = a;
+	    mFanin1[pos] = b;
+	    return true;
+	  }
+	}
+      }
+    }
+    return false;
+  }
+
+  // func がすでに作られていたら true を返す．
+  bool
+  defined(ymuint func,
+	  ymuint nsig) const
+  {
+    for (ymuint i = 0; i < nsig; ++ i) {
+      if ( mFunc[i] == func ) {
+	return true;
+      }
+    }
+    return false;
+  }
+
+  // 対象の関数(正規化されている)
+  ymuint mTarget;
+
+  // ノード数
+  ymuint mNodeNum;
+
+  // 信号ごとの関数(正規化されている)
+  vector<ymuint> mFunc;
+
+  // ノードごとの種類
+  vector<ymuint> mOp;
+
+  // ノードごとのファンイン0
+  vector<ymuint> mFanin0;
+
+  // ノードごとのファンイン1
+  vector<ymuint> mFanin1;
+
+  // 信号ごとの参照回数
+  vector<ymuint> mRef;
+
+};
+
+
+int
+main(int argc,
+     char** argv)
+{
+  // NPN 同値類の代表関数(同値類の中で最小の真理値表)を求める．
+  vector<bool> done(kAllMask + 1, false);
+  vector<ymuint> rep_list;
+  for (ymuint func = 0; func <= kAllMask; ++ func) {
+    if ( done[func] ) {
+      continue;
+    }
+    rep_list.push_back(func);
+    ymuint perm[4] = { 0, 1, 2, 3 };
+    do {
+      for (ymuint imask = 0; imask < 16; ++ imask) {
+	for (ymuint oinv = 0; oinv < 2; ++ oinv) {
+	  done[xform(func, perm, imask, oinv)] = true;
+	}
+      }
+    } while ( next_permutation(perm, perm + 4) );
+  }
+
+  vector<ymuint> data;
+  vector<ymuint> cost_num(kMaxNode + 1, 0);
+  for (vector<ymuint>::iterator p = rep_list.begin();
+       p != rep_list.end(); ++ p) {
+    ymuint func = *p;
+    ymuint nfunc = normalize(func);
+    ymuint oinv = func & 1U;
+
+    // 信号番号ごとのリテラル
+    // リテラルの形式は RwtGraph と同じ
+    vector<ymuint> lit(4 + kMaxNode);
+    for (ymuint i = 0; i < 4; ++ i) {
+      lit[i] = (i + 1) << 1;
+    }
+
+    ymuint node_num = 0;
+    ymuint olit = 0U;
+    vector<ymuint> node_data;
+    ymuint var = 0;
+    for ( ; var < 4 && nfunc != kVarMask[var]; ++ var) ;
+    if ( nfunc == 0U ) {
+      olit = 0U;
+    }
+    else if ( var < 4 ) {
+      olit = lit[var];
+    }
+    else {
+      Searcher searcher;
+      for (node_num = 1; node_num <= kMaxNode; ++ node_num) {
+	if ( searcher.search(nfunc, node_num) ) {
+	  break;
+	}
+      }
+      if ( node_num > kMaxNode ) {
+	cerr << "Error: no graph for " << hex << func << endl;
+	return 1;
+      }
+      for (ymuint i = 0; i < node_num; ++ i) {
+	ymuint op = searcher.op(i);
+	ymuint lit0 = lit[searcher.fanin(i, 0)];
+	ymuint lit1 = lit[searcher.fanin(i, 1)];
+	ymuint olit1 = (i + 5) << 1;
+	switch ( op ) {
+	case 1: lit1 ^= 1U; break;
+	case 2: lit0 ^= 1U; break;
+	case 3: lit0 ^= 1U; lit1 ^= 1U; olit1 ^= 1U; break;
+	}
+	node_data.push_back(op == 4 ? 1U : 0U);
+	node_data.push_back(lit0);
+	node_data.push_back(lit1);
+	lit[4 + i] = olit1;
+      }
+      olit = lit[4 + node_num - 1];
+    }
+    ++ cost_num[node_num];
+
+    data.push_back(func);
+    data.push_back(node_num);
+    data.push_back(olit ^ oinv);
+    data.insert(data.end(), node_data.begin(), node_data.end());
+  }
+
+  cout << "// rwtgen で生成した．" << endl
+       << "// 4入力の NPN 同値類ごとの最小の部分グラフ" << endl
+       << "// ノード数ごとの同値類の数:";
+  for (ymuint i = 0; i <= kMaxNode; ++ i) {
+    cout << " " << cost_num[i];
+  }
+  cout << endl
+       << "// 1つの部分グラフは以下の要素からなる．" << endl
+       << "// - 代表関数の真理値表" << endl
+       << "// - ノード数" << endl
+       << "// - 出力のリテラル" << endl
+       << "// - ノードごとの (XORフラグ, ファンイン0, ファンイン1)" << endl
+       << "const ymuint rwt_num = " << rep_list.size() << ";" << endl
+       << "const ymuint16 rwt_table[] = {" << endl;
+  ymuint pos = 0;
+  for (ymuint i = 0; i < rep_list.size(); ++ i) {
+    ymuint node_num = data[pos + 1];
+    ymuint n = 3 + node_num * 3;
+    cout << "\t";
+    for (ymuint j = 0; j < n; ++ j) {
+      if ( j == 0 ) {
+	cout << "0x" << hex << setw(4) << setfill('0') << data[pos] << dec;
+      }
+      else {
+	cout << data[pos + j];
+      }
+      if ( i < rep_list.size() - 1 || j < n - 1 ) {
+	cout << ",";
+	if ( j < n - 1 ) {
+	  cout << " ";
+	}
+      }
+    }
+    cout << endl;
+    pos += n;
+  }
+  cout << "};" << endl;
+
+  return 0;
+}
@@ -9,8 +9,10 @@
 
 #include "YmNetworks/BNetwork.h"
 #include "YmNetworks/BNetManip.h"
+#include "YmUtils/HashSet.h"
 #include "StrBNodeMap.h"
 #include "BNodeMgr.h"
+#include "BlockIO.h"
 
 
 BEGIN_NAMESPACE_YM_NETWORKS_BNET
@@ -333,6 +335,415 @@ BNetwork::copy(const BNetwork& src)
   }
 }
 
+BEGIN_NONAMESPACE
+
+// 論理式を前置記法の符号列に変換する．
+// 0: 定数0, 1: 定数1, 2: 肯定リテラル, 3: 否定リテラル
+// 4: AND, 5: OR, 6: XOR
+// リテラルの後ろには変数番号が，AND/OR/XOR の後ろには子供の数と
+// 子供の符号列が続く．
+void
+dump_expr(const Expr& expr,
+	  vector<ymuint32>& block)
+{
+  if ( expr.is_zero() ) {
+    block.push_back(0U);
+  }
+  else if ( expr.is_one() ) {
+    block.push_back(1U);
+  }
+  else if ( expr.is_posiliteral() ) {
+    block.push_back(2U);
+    block.push_back(expr.varid().val());
+  }
+  else if ( expr.is_negaliteral() ) {
+    block.push_back(3U);
+    block.push_back(expr.varid().val());
+  }
+  else {
+    if ( expr.is_and() ) {
+      block.push_back(4U);
+    }
+    else if ( expr.is_or() ) {
+      block.push_back(5U);
+    }
+    else {
+      ASSERT_COND( expr.is_xor() );
+      block.push_back(6U);
+    }
+    ymuint n = expr.child_num();
+    block.push_back(n);
+    for (ymuint i = 0; i < n; ++ i) {
+      dump_expr(expr.child(i), block);
+    }
+  }
+}
+
+// dump_expr() で作った符号列を論理式に戻す．
+// pos は読み出し位置で，読んだ分だけ進められる．
+// ni はファンイン数で，変数番号はこれより小さくなければならない．
+// 符号列が壊れていたら false を返す．
+bool
+restore_expr(const vector<ymuint32>& block,
+	     ymuint& pos,
+	     ymuint ni,
+	     Expr& expr)
+{
+  ymuint n = block.size();
+  if ( pos >= n ) {
+    return false;
+  }
+  ymuint32 code = block[pos];
+  ++ pos;
+  switch ( code ) {
+  case 0U:
+    expr = Expr::make_zero();
+    return true;
+
+  case 1U:
+    expr = Expr::make_one();
+    return true;
+
+  case 2U:
+  case 3U:
+    {
+      if ( pos >= n || block[pos] >= ni ) {
+	return false;
+      }
+      VarId var(block[pos]);
+      ++ pos;
+      if ( code == 2U ) {
+	expr = Expr::make_posiliteral(var);
+      }
+      else {
+	expr = Expr::make_negaliteral(var);
+      }
+    }
+    return true;
+
+  case 4U:
+  case 5U:
+  case 6U:
+    break;
+
+  default:
+    return false;
+  }
+
+  // 子供は少なくとも1語を使う．
+  if ( pos >= n || block[pos] > n - pos - 1 ) {
+    return false;
+  }
+  ymuint nc = block[pos];
+  ++ pos;
+  ExprVector chd_list(nc);
+  for (ymuint i = 0; i < nc; ++ i) {
+    if ( !restore_expr(block, pos, ni, chd_list[i]) ) {
+      return false;
+    }
+  }
+  if ( code == 4U ) {
+    expr = Expr::make_and(chd_list);
+  }
+  else if ( code == 5U ) {
+    expr = Expr::make_or(chd_list);
+  }
+  else {
+    expr = Expr::make_xor(chd_list);
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
+// @brief 内容をバイナリダンプする．
+// @param[in] s 出力先のストリーム
+//
+// 名前は ID 番号順に先頭にまとめて書き出す．
+// ノードの情報は ID 番号順に ymuint32 の配列にまとめてから
+// dump_block() で書き出す．各ノードの情報は
+// (型 + 1, 型ごとの情報) で，使われていない ID は 0 となる．
+// - 外部出力: ファンインの ID
+// - 論理ノード: ファンイン数，ファンインの ID, 論理式の符号列
+// - latch ノード: ファンインの ID, リセット値
+void
+BNetwork::dump(ODO& s) const
+{
+  string prefix;
+  string suffix;
+  name_rule(prefix, suffix);
+  s << model_name()
+    << prefix
+    << suffix;
+
+  ymuint32 n = mNodeVector.size();
+  ymuint32 nn = node_num();
+  s << n
+    << nn;
+  vector<bool> used(n, false);
+  for (BNodeList::const_iterator p = mNodeList.begin();
+       p != mNodeList.end(); ++ p) {
+    used[(*p)->id()] = true;
+  }
+
+  vector<ymuint32> node_block;
+  node_block.reserve(n * 2);
+  for (ymuint id = 0; id < n; ++ id) {
+    if ( !used[id] ) {
+      node_block.push_back(0U);
+      continue;
+    }
+    BNode* node = mNodeVector[id];
+    s << node_name(node);
+    node_block.push_back(static_cast<ymuint32>(node->type()) + 1);
+    switch ( node->type() ) {
+    case BNode::kPI:
+      break;
+
+    case BNode::kPO:
+      node_block.push_back(node->fanin(0)->id());
+      break;
+
+    case BNode::kLO:
+      {
+	ymuint ni = node->fanin_num();
+	node_block.push_back(ni);
+	for (ymuint i = 0; i < ni; ++ i) {
+	  node_block.push_back(node->fanin(i)->id());
+	}
+	dump_expr(node->func(), node_block);
+      }
+      break;
+
+    case BNode::kFF:
+      node_block.push_back(node->fanin(0)->id());
+      node_block.push_back(static_cast<ymuint32>(node->reset_value()));
+      break;
+    }
+  }
+  dump_block(s, node_block);
+}
+
+// @brief バイナリダンプされた内容を読み込む．
+// @param[in] s 入力元のストリーム
+// @return 読み込みが成功したら true を返す．
+// @note 内容に矛盾があった場合には false を返す．
+// その場合，もとの内容は変更されない．
+bool
+BNetwork::restore(IDO& s)
+{
+  string model_name;
+  string prefix;
+  string suffix;
+  ymuint32 n;
+  ymuint32 nn;
+  s >> model_name
+    >> prefix
+    >> suffix
+    >> n
+    >> nn;
+  vector<string> name_list;
+  for (ymuint i = 0; i < nn; ++ i) {
+    string tmp_name;
+    s >> tmp_name;
+    name_list.push_back(tmp_name);
+  }
+  vector<ymuint32> node_block;
+  if ( !restore_block(s, node_block) ) {
+    return false;
+  }
+
+  // 内容を調べながら各ノードの情報の位置と論理式を求める．
+  // 使われていない ID は 1語，それ以外は少なくとも 2語を使う．
+  ymuint bsize = node_block.size();
+  if ( n > bsize ) {
+    return false;
+  }
+  vector<ymuint> pos_list(n, 0);
+  vector<Expr> expr_list(n);
+  ymuint rpos = 0;
+  ymuint nused = 0;
+  for (ymuint id = 0; id < n; ++ id) {
+    if ( rpos >= bsize ) {
+      return false;
+    }
+    ymuint32 type = node_block[rpos];
+    pos_list[id] = rpos;
+    ++ rpos;
+    if ( type == 0U ) {
+      continue;
+    }
+    ++ nused;
+    switch ( type ) {
+    case BNode::kPI + 1:
+      break;
+
+    case BNode::kPO + 1:
+      rpos += 1;
+      break;
+
+    case BNode::kFF + 1:
+      rpos += 2;
+      break;
+
+    case BNode::kLO + 1:
+      {
+	if ( rpos >= bsize || node_block[rpos] > bsize - rpos - 1 ) {
+	  return false;
+	}
+	ymuint ni = node_block[rpos];
+	rpos += ni + 1;
+	if ( !restore_expr(node_block, rpos, ni, expr_list[id]) ) {
+	  return false;
+	}
+      }
+      break;
+
+    default:
+      return false;
+    }
+    if ( rpos > bsize ) {
+      return false;
+    }
+  }
+  if ( rpos != bsize || nused != nn ) {
+    return false;
+  }
+
+  // ファンインは出力ノード以外の使われているノードでなければならない．
+  for (ymuint id = 0; id < n; ++ id) {
+    ymuint rpos = pos_list[id];
+    ymuint32 type = node_block[rpos];
+    ++ rpos;
+    ymuint ni = 0;
+    switch ( type ) {
+    case BNode::kPO + 1:
+      ni = 1;
+      break;
+
+    case BNode::kFF + 1:
+      if ( node_block[rpos + 1] > 3U ) {
+	return false;
+      }
+      ni = 1;
+      break;
+
+    case BNode::kLO + 1:
+      ni = node_block[rpos];
+      ++ rpos;
+      break;
+
+    default:
+      break;
+    }
+    for (ymuint i = 0; i < ni; ++ i) {
+      ymuint32 iid = node_block[rpos + i];
+      if ( iid >= n ) {
+	return false;
+      }
+      ymuint32 itype = node_block[pos_list[iid]];
+      if ( itype == 0U || itype == BNode::kPO + 1 ) {
+	return false;
+      }
+    }
+  }
+
+  // 名前は空であってはならず，外部出力とそれ以外の中でそれぞれ
+  // 重複してはならない．
+  HashSet<string> po_name_set;
+  HashSet<string> name_set;
+  ymuint name_pos = 0;
+  for (ymuint id = 0; id < n; ++ id) {
+    ymuint32 type = node_block[pos_list[id]];
+    if ( type == 0U ) {
+      continue;
+    }
+    const string& name = name_list[name_pos];
+    ++ name_pos;
+    HashSet<string>& name_set1 = (type == BNode::kPO + 1) ? po_name_set : name_set;
+    if ( name.empty() || name_set1.find(name) ) {
+      return false;
+    }
+    name_set1.add(name);
+  }
+
+  clear();
+
+  set_model_name(model_name);
+  change_name_rule(prefix, suffix);
+
+  // 使われていない ID を先に取り除いておけば new_node() が
+  // ID 番号の順に呼ばれる限り同じ ID 番号が割り当てられる．
+  // clear() は ID 0 を取り除いているので戻しておく．
+  mItvlMgr.add(0);
+  vector<int> free_list;
+  for (ymuint id = 0; id < n; ++ id) {
+    if ( node_block[pos_list[id]] == 0U ) {
+      free_list.push_back(id);
+      mItvlMgr.erase(id);
+    }
+  }
+
+  BNetManip manip(this);
+
+  name_pos = 0;
+  for (ymuint id = 0; id < n; ++ id) {
+    ymuint32 type = node_block[pos_list[id]];
+    if ( type == 0U ) {
+      continue;
+    }
+    BNode* node = new_node(static_cast<BNode::tType>(type - 1),
+			   name_list[name_pos].c_str());
+    ++ name_pos;
+    if ( node == nullptr ) {
+      clear();
+      return false;
+    }
+    ASSERT_COND( node->id() == id );
+  }
+  for (vector<int>::iterator p = free_list.begin();
+       p != free_list.end(); ++ p) {
+    mItvlMgr.add(*p);
+  }
+
+  // ファンインと論理式の設定
+  BNodeVector fanins;
+  for (ymuint id = 0; id < n; ++ id) {
+    ymuint rpos = pos_list[id];
+    ymuint32 type = node_block[rpos];
+    ++ rpos;
+    BNode* node = mNodeVector[id];
+    switch ( type ) {
+    case BNode::kPO + 1:
+      manip.change_output(node, mNodeVector[node_block[rpos]]);
+      break;
+
+    case BNode::kLO + 1:
+      {
+	ymuint ni = node_block[rpos];
+	++ rpos;
+	fanins.resize(ni);
+	for (ymuint i = 0; i < ni; ++ i) {
+	  fanins[i] = mNodeVector[node_block[rpos]];
+	  ++ rpos;
+	}
+	manip.change_logic(node, expr_list[id], fanins, false);
+      }
+      break;
+
+    case BNode::kFF + 1:
+      manip.change_latch(node, mNodeVector[node_block[rpos]],
+			 static_cast<int>(node_block[rpos + 1]));
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  return true;
+}
+
 // @brief 全てのノードの論理式を簡単化する．
 void
 BNetwork::lexp_simplify()
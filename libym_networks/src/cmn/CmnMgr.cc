@@ -331,4 +331,23 @@ CmnMgr::reg_latch_cell(const Cell* cell,
   return mImpl->reg_latch_cell(cell, pin_info);
 }
 
+// @brief 内容をバイナリダンプする．
+// @param[in] s 出力先のストリーム
+void
+CmnMgr::dump(ODO& s) const
+{
+  mImpl->dump(s);
+}
+
+// @brief バイナリダンプされた内容を読み込む．
+// @param[in] s 入力元のストリーム
+// @param[in] library セルの取得に用いるセルライブラリ
+// @return 読み込みが成功したら true を返す．
+bool
+CmnMgr::restore(IDO& s,
+		const CellLibrary& library)
+{
+  return mImpl->restore(s, library);
+}
+
 END_NAMESPACE_YM_NETWORKS_CMN
@@ -16,6 +16,8 @@
 #include "YmNetworks/CmnEdge.h"
 #include "YmNetworks/CmnDffCell.h"
 #include "YmNetworks/CmnLatchCell.h"
+#include "YmCell/Cell.h"
+#include "YmCell/CellLibrary.h"
 
 #include "CmnNodePI.h"
 #include "CmnNodeDffOut.h"
@@ -24,6 +26,7 @@
 #include "CmnNodeDffIn.h"
 #include "CmnNodeLatchIn.h"
 #include "CmnNodeLogic.h"
+#include "BlockIO.h"
 
 
 BEGIN_NAMESPACE_YM_NETWORKS_CMN
@@ -34,7 +37,8 @@ BEGIN_NAMESPACE_YM_NETWORKS_CMN
 
 // コンストラクタ
 CmnMgrImpl::CmnMgrImpl() :
-  mAlloc(4096)
+  mAlloc(4096),
+  mRestorePos(0)
 {
 }
 
@@ -457,7 +461,7 @@ CmnMgrImpl::new_latch(const CmnLatchCell* cell,
   mLatchItvlMgr.erase(id);
   ymuint uid = static_cast<ymuint>(id);
   latch->mId = uid;
-  if ( mLatchArray.size() < uid ) {
+  if ( mLatchArray.size() <= uid ) {
     mLatchArray.resize(uid + 1, nullptr);
   }
   mLatchArray[uid] = latch;
@@ -551,6 +555,414 @@ CmnMgrImpl::set_output_fanin(CmnNode* output,
   connect(fanin, output, 0);
 }
 
+// @brief 内容をバイナリダンプする．
+// @param[in] s 出力先のストリーム
+//
+// 形式は BdnMgrImpl::dump() と同様で，名前とセルの情報を先頭に
+// まとめて書き出したのちノードの情報を dump_block() で書き出す．
+// セルはセル番号で記録する．
+void
+CmnMgrImpl::dump(ODO& s) const
+{
+  // 名前とセルの表
+  ymuint32 np = port_num();
+  ymuint32 nd = dff_num();
+  ymuint32 nl = latch_num();
+  ymuint32 max_id = max_node_id();
+  s << mName
+    << np
+    << nd
+    << nl
+    << max_id;
+  for (ymuint i = 0; i < np; ++ i) {
+    s << mPortArray[i]->name();
+  }
+  for (CmnDffList::const_iterator p = mDffList.begin();
+       p != mDffList.end(); ++ p) {
+    const CmnDff* dff = *p;
+    const CmnDffCell* dff_cell = dff->cell();
+    ymuint32 cell_id = dff_cell->cell()->id();
+    s << dff->name()
+      << cell_id
+      << dff_cell->mPinInfo;
+  }
+  for (CmnLatchList::const_iterator p = mLatchList.begin();
+       p != mLatchList.end(); ++ p) {
+    const CmnLatch* latch = *p;
+    const CmnLatchCell* latch_cell = latch->cell();
+    ymuint32 cell_id = latch_cell->cell()->id();
+    s << latch->name()
+      << cell_id
+      << latch_cell->mPinInfo;
+  }
+
+  // ポートの構成と restore() 時にノードを生成する順の ID 番号
+  vector<ymuint32> port_block;
+  vector<ymuint32> id_block;
+  id_block.reserve(mNodeArray.size());
+  for (ymuint i = 0; i < np; ++ i) {
+    const CmnPort* port = mPortArray[i];
+    ymuint nb = port->bit_width();
+    port_block.push_back(nb);
+    for (ymuint b = 0; b < nb; ++ b) {
+      const CmnNode* input = port->input(b);
+      const CmnNode* output = port->output(b);
+      ymuint32 pat = 0U;
+      if ( input ) {
+	pat |= 1U;
+	id_block.push_back(input->id());
+      }
+      if ( output ) {
+	pat |= 2U;
+	id_block.push_back(output->id());
+      }
+      port_block.push_back(pat);
+    }
+  }
+  for (CmnDffList::const_iterator p = mDffList.begin();
+       p != mDffList.end(); ++ p) {
+    const CmnDff* dff = *p;
+    id_block.push_back(dff->output1()->id());
+    id_block.push_back(dff->output2()->id());
+    id_block.push_back(dff->input()->id());
+    id_block.push_back(dff->clock()->id());
+    if ( dff->clear() ) {
+      id_block.push_back(dff->clear()->id());
+    }
+    if ( dff->preset() ) {
+      id_block.push_back(dff->preset()->id());
+    }
+  }
+  for (CmnLatchList::const_iterator p = mLatchList.begin();
+       p != mLatchList.end(); ++ p) {
+    const CmnLatch* latch = *p;
+    id_block.push_back(latch->output1()->id());
+    id_block.push_back(latch->output2()->id());
+    id_block.push_back(latch->input()->id());
+    id_block.push_back(latch->enable()->id());
+    if ( latch->clear() ) {
+      id_block.push_back(latch->clear()->id());
+    }
+    if ( latch->preset() ) {
+      id_block.push_back(latch->preset()->id());
+    }
+  }
+
+  // 論理ノードはトポロジカル順に (セル番号 + 1, ファンイン数, ファンイン)
+  // セルがない場合のセル番号 + 1 は 0 となる．
+  vector<const CmnNode*> node_list;
+  sort(node_list);
+  vector<ymuint32> logic_block;
+  for (vector<const CmnNode*>::iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    id_block.push_back(node->id());
+    const Cell* cell = node->cell();
+    logic_block.push_back(cell ? cell->id() + 1 : 0U);
+    ymuint ni = node->fanin_num();
+    logic_block.push_back(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      logic_block.push_back(node->fanin(i)->id());
+    }
+  }
+
+  // 出力ノードは (ID番号, ファンイン + 1)
+  vector<ymuint32> output_block;
+  output_block.reserve(output_num() * 2);
+  for (CmnNodeList::const_iterator p = mOutputList.begin();
+       p != mOutputList.end(); ++ p) {
+    const CmnNode* node = *p;
+    const CmnNode* inode = node->fanin(0);
+    output_block.push_back(node->id());
+    output_block.push_back(inode ? inode->id() + 1 : 0U);
+  }
+
+  dump_block(s, port_block);
+  dump_block(s, id_block);
+  dump_block(s, logic_block);
+  dump_block(s, output_block);
+}
+
+BEGIN_NONAMESPACE
+
+// restore() で用いるノードの種類
+const ymuint8 kInputKind = 1U;
+const ymuint8 kOutputKind = 2U;
+const ymuint8 kLogicKind = 3U;
+
+// ファンインとして使えるノードのとき true を返す．
+inline
+bool
+is_fanin_kind(ymuint8 kind)
+{
+  return kind == kInputKind || kind == kLogicKind;
+}
+
+// D-FF かラッチのノードの種類を設定する．
+// 2つの出力(入力ノード)と，データ，クロック(イネーブル)および
+// 必要ならクリアとプリセットの入力(出力ノード)を持つ．
+bool
+set_ff_kind(BlockIdChecker& checker,
+	    bool has_clear,
+	    bool has_preset)
+{
+  ymuint no = 2;
+  if ( has_clear ) {
+    ++ no;
+  }
+  if ( has_preset ) {
+    ++ no;
+  }
+  if ( !checker.set_next(kInputKind) ||
+       !checker.set_next(kInputKind) ) {
+    return false;
+  }
+  for (ymuint i = 0; i < no; ++ i) {
+    if ( !checker.set_next(kOutputKind) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// restore() で読み込んだブロックの内容が正しいか調べる．
+// ID 番号の重複や過不足，max_id 以上の ID 番号，存在しないノードや
+// 出力ノードを指すファンイン，論理セル以外のセル，ブロックの大きさの
+// 不整合があれば false を返す．
+bool
+check_blocks(ymuint np,
+	     ymuint max_id,
+	     const vector<const CmnDffCell*>& dff_cell_list,
+	     const vector<const CmnLatchCell*>& latch_cell_list,
+	     const CellLibrary& library,
+	     const vector<ymuint32>& port_block,
+	     const vector<ymuint32>& id_block,
+	     const vector<ymuint32>& logic_block,
+	     const vector<ymuint32>& output_block)
+{
+  BlockIdChecker checker(id_block, max_id);
+
+  ymuint rpos = 0;
+  ymuint n = port_block.size();
+  for (ymuint i = 0; i < np; ++ i) {
+    if ( rpos >= n ) {
+      return false;
+    }
+    ymuint nb = port_block[rpos];
+    ++ rpos;
+    if ( nb > n - rpos ) {
+      return false;
+    }
+    for (ymuint b = 0; b < nb; ++ b) {
+      ymuint32 pat = port_block[rpos];
+      ++ rpos;
+      if ( pat > 3U ) {
+	return false;
+      }
+      if ( (pat & 1U) && !checker.set_next(kInputKind) ) {
+	return false;
+      }
+      if ( (pat & 2U) && !checker.set_next(kOutputKind) ) {
+	return false;
+      }
+    }
+  }
+  if ( rpos != n ) {
+    return false;
+  }
+
+  for (ymuint i = 0; i < dff_cell_list.size(); ++ i) {
+    const CmnDffCell* dff_cell = dff_cell_list[i];
+    if ( !set_ff_kind(checker, dff_cell->has_clear(), dff_cell->has_preset()) ) {
+      return false;
+    }
+  }
+  for (ymuint i = 0; i < latch_cell_list.size(); ++ i) {
+    const CmnLatchCell* latch_cell = latch_cell_list[i];
+    if ( !set_ff_kind(checker, latch_cell->has_clear(), latch_cell->has_preset()) ) {
+      return false;
+    }
+  }
+
+  // 論理ノードのファンインは先に生成されていなければならない．
+  ymuint nc = library.cell_num();
+  n = logic_block.size();
+  for (rpos = 0; rpos < n; ) {
+    if ( n - rpos < 2 ) {
+      return false;
+    }
+    ymuint32 cell_code = logic_block[rpos];
+    ymuint ni = logic_block[rpos + 1];
+    rpos += 2;
+    if ( cell_code > nc ||
+	 ( cell_code > 0 && !library.cell(cell_code - 1)->is_logic() ) ||
+	 ni > n - rpos ) {
+      return false;
+    }
+    for (ymuint i = 0; i < ni; ++ i) {
+      if ( !is_fanin_kind(checker.kind(logic_block[rpos])) ) {
+	return false;
+      }
+      ++ rpos;
+    }
+    if ( !checker.set_next(kLogicKind) ) {
+      return false;
+    }
+  }
+  if ( !checker.is_end() ) {
+    return false;
+  }
+
+  if ( output_block.size() % 2 != 0 ) {
+    return false;
+  }
+  for (ymuint pos = 0; pos < output_block.size(); pos += 2) {
+    if ( checker.kind(output_block[pos]) != kOutputKind ) {
+      return false;
+    }
+    ymuint32 val = output_block[pos + 1];
+    if ( val > 0U && !is_fanin_kind(checker.kind(val - 1)) ) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+END_NONAMESPACE
+
+// @brief バイナリダンプされた内容を読み込む．
+// @param[in] s 入力元のストリーム
+// @param[in] library セルの取得に用いるセルライブラリ
+// @return 読み込みが成功したら true を返す．
+// @note 内容に矛盾があった場合には false を返す．
+// その場合，もとの内容は変更されない．
+bool
+CmnMgrImpl::restore(IDO& s,
+		    const CellLibrary& library)
+{
+  ymuint nc = library.cell_num();
+
+  string name;
+  ymuint32 np;
+  ymuint32 nd;
+  ymuint32 nl;
+  ymuint32 max_id;
+  s >> name
+    >> np
+    >> nd
+    >> nl
+    >> max_id;
+  vector<string> port_name_list;
+  for (ymuint i = 0; i < np; ++ i) {
+    string tmp_name;
+    s >> tmp_name;
+    port_name_list.push_back(tmp_name);
+  }
+  vector<string> dff_name_list;
+  vector<const CmnDffCell*> dff_cell_list;
+  for (ymuint i = 0; i < nd; ++ i) {
+    string tmp_name;
+    ymuint32 cell_id;
+    CellFFInfo pin_info;
+    s >> tmp_name
+      >> cell_id
+      >> pin_info;
+    if ( cell_id >= nc || !library.cell(cell_id)->is_ff() ) {
+      return false;
+    }
+    dff_name_list.push_back(tmp_name);
+    dff_cell_list.push_back(reg_dff_cell(library.cell(cell_id), pin_info));
+  }
+  vector<string> latch_name_list;
+  vector<const CmnLatchCell*> latch_cell_list;
+  for (ymuint i = 0; i < nl; ++ i) {
+    string tmp_name;
+    ymuint32 cell_id;
+    CellLatchInfo pin_info;
+    s >> tmp_name
+      >> cell_id
+      >> pin_info;
+    if ( cell_id >= nc || !library.cell(cell_id)->is_latch() ) {
+      return false;
+    }
+    latch_name_list.push_back(tmp_name);
+    latch_cell_list.push_back(reg_latch_cell(library.cell(cell_id), pin_info));
+  }
+
+  vector<ymuint32> port_block;
+  vector<ymuint32> id_block;
+  vector<ymuint32> logic_block;
+  vector<ymuint32> output_block;
+  if ( !restore_block(s, port_block) ||
+       !restore_block(s, id_block) ||
+       !restore_block(s, logic_block) ||
+       !restore_block(s, output_block) ) {
+    return false;
+  }
+  if ( !check_blocks(np, max_id, dff_cell_list, latch_cell_list, library,
+		     port_block, id_block, logic_block, output_block) ) {
+    return false;
+  }
+
+  clear();
+
+  mRestoreIdList.swap(id_block);
+  mRestorePos = 0;
+
+  set_name(name);
+
+  // ポート，D-FF，ラッチの生成
+  // ノードの ID 番号は reg_node() が mRestoreIdList から取り出す．
+  ymuint rpos = 0;
+  for (ymuint i = 0; i < np; ++ i) {
+    ymuint nb = port_block[rpos];
+    ++ rpos;
+    vector<ymuint> iovect(nb);
+    for (ymuint b = 0; b < nb; ++ b) {
+      iovect[b] = port_block[rpos];
+      ++ rpos;
+    }
+    new_port(port_name_list[i], iovect);
+  }
+  for (ymuint i = 0; i < nd; ++ i) {
+    new_dff(dff_cell_list[i], dff_name_list[i]);
+  }
+  for (ymuint i = 0; i < nl; ++ i) {
+    new_latch(latch_cell_list[i], latch_name_list[i]);
+  }
+
+  // 論理ノードの生成
+  rpos = 0;
+  vector<CmnNode*> inodes;
+  while ( rpos < logic_block.size() ) {
+    ymuint32 cell_code = logic_block[rpos];
+    ymuint ni = logic_block[rpos + 1];
+    rpos += 2;
+    inodes.resize(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      inodes[i] = mNodeArray[logic_block[rpos]];
+      ++ rpos;
+    }
+    const Cell* cell = cell_code > 0 ? library.cell(cell_code - 1) : nullptr;
+    new_logic(inodes, cell);
+  }
+  ASSERT_COND( mRestorePos == mRestoreIdList.size() );
+  mRestoreIdList.clear();
+  mRestorePos = 0;
+
+  // 出力ノードのファンインの設定
+  ymuint nout = output_block.size() / 2;
+  for (ymuint i = 0; i < nout; ++ i) {
+    ymuint32 val = output_block[i * 2 + 1];
+    if ( val > 0U ) {
+      connect(mNodeArray[val - 1], mNodeArray[output_block[i * 2 + 0]], 0);
+    }
+  }
+
+  return true;
+}
+
 // @brief D-FFセルを登録する．
 // @param[in] cell 対象のセル．
 // @param[in] pin_info ピン情報
@@ -642,7 +1054,15 @@ CmnMgrImpl::reg_output(CmnNode* node)
 void
 CmnMgrImpl::reg_node(CmnNode* node)
 {
-  int id = mNodeItvlMgr.avail_num();
+  // restore() 中はダンプ時の ID を用いる．
+  int id;
+  if ( mRestorePos < mRestoreIdList.size() ) {
+    id = mRestoreIdList[mRestorePos];
+    ++ mRestorePos;
+  }
+  else {
+    id = mNodeItvlMgr.avail_num();
+  }
   mNodeItvlMgr.erase(id);
   node->mId = id;
   if ( mNodeArray.size() <= node->id() ) {
@@ -731,7 +1151,13 @@ CmnMgrImpl::connect(CmnNode* from,
 CmnDff::CmnDff(const string& name,
 	       const CmnDffCell* cell) :
   mName(name),
-  mCell(cell)
+  mCell(cell),
+  mOutput1(nullptr),
+  mOutput2(nullptr),
+  mInput(nullptr),
+  mClock(nullptr),
+  mClear(nullptr),
+  mPreset(nullptr)
 {
 }
 
@@ -751,6 +1177,12 @@ CmnDff::~CmnDff()
 CmnLatch::CmnLatch(const string& name,
 		   const CmnLatchCell* cell) :
   mName(name),
+  mOutput1(nullptr),
+  mOutput2(nullptr),
+  mInput(nullptr),
+  mEnable(nullptr),
+  mClear(nullptr),
+  mPreset(nullptr),
   mCell(cell)
 {
 }
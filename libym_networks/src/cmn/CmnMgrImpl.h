@@ -16,6 +16,8 @@
 #include "YmUtils/HashMap.h"
 #include "YmUtils/DlList.h"
 #include "YmUtils/ItvlMgr.h"
+#include "YmUtils/IDO.h"
+#include "YmUtils/ODO.h"
 
 
 BEGIN_NAMESPACE_YM_NETWORKS_CMN
@@ -228,6 +230,28 @@ public:
   //////////////////////////////////////////////////////////////////////
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name ダンプ/リストア関係の関数
+  /// @{
+
+  /// @brief 内容をバイナリダンプする．
+  /// @param[in] s 出力先のストリーム
+  void
+  dump(ODO& s) const;
+
+  /// @brief バイナリダンプされた内容を読み込む．
+  /// @param[in] s 入力元のストリーム
+  /// @param[in] library セルの取得に用いるセルライブラリ
+  /// @return 読み込みが成功したら true を返す．
+  bool
+  restore(IDO& s,
+	  const CellLibrary& library);
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // プライベートメンバ関数
@@ -344,6 +368,12 @@ private:
   // cell のアドレスをキーにして CmnLatchCell を記憶するハッシュ表
   HashMap<const Cell*, const CmnLatchCell*> mLatchCellMap;
 
+  // restore() 中に reg_node() が割り当てる ID 番号のリスト
+  vector<ymuint32> mRestoreIdList;
+
+  // mRestoreIdList 中の次の位置
+  ymuint32 mRestorePos;
+
 };
 
 
@@ -0,0 +1,230 @@
+﻿
+/// @file CmnSigProb.cc
+/// @brief CmnSigProb の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/CmnSigProb.h"
+#include "YmNetworks/CmnMgr.h"
+#include "YmNetworks/CmnNode.h"
+#include "YmCell/Cell.h"
+#include "../sigprob/SigProbEngine.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_CMN
+
+//////////////////////////////////////////////////////////////////////
+// クラス CmnSigProb
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] thread_num 計算に用いるスレッド数
+CmnSigProb::CmnSigProb(const CmnMgr& network,
+		       ymuint thread_num) :
+  mNetwork(network),
+  mEngine(new SigProbEngine(thread_num))
+{
+  ymuint n = network.max_node_id();
+  mEngine->resize(n);
+  mCellArray.resize(n, nullptr);
+
+  const CmnNodeList& input_list = network.input_list();
+  for (CmnNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    mEngine->set_input((*p)->id());
+  }
+
+  const CmnNodeList& logic_list = network.logic_list();
+  for (CmnNodeList::const_iterator p = logic_list.begin();
+       p != logic_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    mCellArray[node->id()] = node->cell();
+    set_logic(node);
+  }
+
+  // 出力ノードはファンインの値をそのまま出力する．
+  vector<ymuint> fanin_list(1);
+  Expr func = Expr::make_posiliteral(VarId(0));
+  const CmnNodeList& output_list = network.output_list();
+  for (CmnNodeList::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    fanin_list[0] = node->fanin(0)->id();
+    mEngine->set_logic(node->id(), fanin_list, func);
+  }
+}
+
+// @brief デストラクタ
+CmnSigProb::~CmnSigProb()
+{
+  delete mEngine;
+}
+
+// @brief 入力の信号確率とトグル率を設定する．
+// @param[in] node 対象の入力ノード
+// @param[in] prob 値が 1 となる確率
+// @param[in] toggle トグル率
+void
+CmnSigProb::set_input_prob(const CmnNode* node,
+			   double prob,
+			   double toggle)
+{
+  ASSERT_COND( node->is_input() );
+  mEngine->set_input_prob(node->id(), prob, toggle);
+}
+
+// @brief モンテカルロシミュレーションのパラメータを設定する．
+// @param[in] max_pattern パタン数の上限
+// @param[in] max_error 95% 信頼区間の半幅の目標値
+// @param[in] seed 乱数の種
+void
+CmnSigProb::set_mc_param(ymuint64 max_pattern,
+			 double max_error,
+			 ymuint32 seed)
+{
+  mEngine->set_mc_param(max_pattern, max_error, seed);
+}
+
+// @brief 局所カットのパラメータを設定する．
+// @param[in] cut_size カットの葉の数の上限
+// @param[in] cone_size カット内のノード数の上限
+void
+CmnSigProb::set_cut_param(ymuint cut_size,
+			  ymuint cone_size)
+{
+  mEngine->set_cut_param(cut_size, cone_size);
+}
+
+// @brief ノードのセルを置き換える．
+// @param[in] node 対象の論理ノード
+// @param[in] cell 新しいセル
+void
+CmnSigProb::set_cell(const CmnNode* node,
+		     const Cell* cell)
+{
+  ASSERT_COND( node->is_logic() );
+  ASSERT_COND( cell->input_num() == node->fanin_num() );
+  if ( mCellArray[node->id()] == cell ) {
+    return;
+  }
+  mCellArray[node->id()] = cell;
+  set_logic(node);
+}
+
+// @brief モンテカルロシミュレーションで求める．
+void
+CmnSigProb::simulate()
+{
+  mEngine->simulate();
+}
+
+// @brief 局所カットの BDD を用いて解析的に求める．
+void
+CmnSigProb::analyze()
+{
+  mEngine->analyze();
+}
+
+// @brief 変更を反映して計算し直す．
+void
+CmnSigProb::update()
+{
+  mEngine->update();
+}
+
+// @brief シミュレーションしたパタン数を返す．
+ymuint64
+CmnSigProb::pattern_num() const
+{
+  return mEngine->pattern_num();
+}
+
+// @brief 信号確率を得る．
+// @param[in] node 対象のノード
+double
+CmnSigProb::prob(const CmnNode* node) const
+{
+  return mEngine->prob(node->id());
+}
+
+// @brief トグル率を得る．
+// @param[in] node 対象のノード
+double
+CmnSigProb::toggle(const CmnNode* node) const
+{
+  return mEngine->toggle(node->id());
+}
+
+// @brief 信号確率の 95% 信頼区間の半幅を得る．
+// @param[in] node 対象のノード
+double
+CmnSigProb::prob_error(const CmnNode* node) const
+{
+  return mEngine->prob_error(node->id());
+}
+
+// @brief トグル率の 95% 信頼区間の半幅を得る．
+// @param[in] node 対象のノード
+double
+CmnSigProb::toggle_error(const CmnNode* node) const
+{
+  return mEngine->toggle_error(node->id());
+}
+
+// @brief 結果を出力する．
+// @param[in] s 出力先のストリーム
+void
+CmnSigProb::dump(ostream& s) const
+{
+  bool simulated = mEngine->is_simulated();
+  ymuint n = mNetwork.max_node_id();
+  for (ymuint id = 0; id < n; ++ id) {
+    const CmnNode* node = mNetwork.node(id);
+    if ( node == nullptr ) {
+      continue;
+    }
+    s << id << " ";
+    if ( node->is_input() ) {
+      s << "input";
+    }
+    else if ( node->is_output() ) {
+      s << "output";
+    }
+    else {
+      s << mCellArray[id]->name();
+    }
+    s << " " << mEngine->prob(id)
+      << " " << mEngine->toggle(id);
+    if ( simulated ) {
+      s << " " << mEngine->prob_error(id)
+	<< " " << mEngine->toggle_error(id);
+    }
+    s << endl;
+  }
+}
+
+// @brief 論理ノードを SigProbEngine に設定する．
+// @param[in] node 対象の論理ノード
+void
+CmnSigProb::set_logic(const CmnNode* node)
+{
+  const Cell* cell = mCellArray[node->id()];
+  if ( !cell->has_logic(0) ) {
+    // 関数のわからないセルの出力は自由な入力とみなす．
+    mEngine->set_input(node->id());
+    return;
+  }
+
+  ymuint ni = node->fanin_num();
+  vector<ymuint> fanin_list(ni);
+  for (ymuint i = 0; i < ni; ++ i) {
+    fanin_list[i] = node->fanin(i)->id();
+  }
+  mEngine->set_logic(node->id(), fanin_list, cell->logic_expr(0));
+}
+
+END_NAMESPACE_YM_NETWORKS_CMN
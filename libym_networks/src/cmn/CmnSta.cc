@@ -0,0 +1,1111 @@
+﻿
+/// @file CmnSta.cc
+/// @brief CmnSta の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/CmnSta.h"
+#include "YmNetworks/CmnMgr.h"
+#include "YmNetworks/CmnNode.h"
+#include "YmNetworks/CmnEdge.h"
+#include "YmNetworks/CmnDff.h"
+#include "YmNetworks/CmnDffCell.h"
+#include "YmNetworks/CmnLatch.h"
+#include "YmNetworks/CmnLatchCell.h"
+#include "YmCell/Cell.h"
+#include "YmCell/CellPin.h"
+#include "YmCell/CellTiming.h"
+#include "YmCell/CellLut.h"
+#include "YmCell/CellTime.h"
+#include "YmCell/CellResistance.h"
+#include "YmCell/CellCapacitance.h"
+#include <cfloat>
+#include <cmath>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS_CMN
+
+BEGIN_NONAMESPACE
+
+// アークがないことを表す値
+const double kNoArc = -DBL_MAX;
+
+// 並列に処理するノード数の下限
+const ymuint kParallelThreshold = 256;
+
+// 表を引く．
+double
+lut_value(const CellLut* lut,
+	  double islew,
+	  double load)
+{
+  ymuint d = lut->dimension();
+  vector<double> val_array(d, 0.0);
+  for (ymuint i = 0; i < d; ++ i) {
+    switch ( lut->variable_type(i) ) {
+    case kCellVarInputNetTransition:
+      val_array[i] = islew;
+      break;
+
+    case kCellVarTotalOutputNetCapacitance:
+      val_array[i] = load;
+      break;
+
+    default:
+      break;
+    }
+  }
+  return lut->value(val_array);
+}
+
+// タイミング情報から遅延と出力の遷移時間を求める．
+void
+calc_timing(const CellTiming* timing,
+	    bool rise,
+	    double islew,
+	    double load,
+	    double& delay,
+	    double& slew)
+{
+  const CellLut* dlut = rise ? timing->cell_rise() : timing->cell_fall();
+  if ( dlut != nullptr ) {
+    delay = lut_value(dlut, islew, load);
+  }
+  else {
+    // generic CMOS モデル
+    CellTime intrinsic = rise ? timing->intrinsic_rise() : timing->intrinsic_fall();
+    CellResistance r = rise ? timing->rise_resistance() : timing->fall_resistance();
+    delay = intrinsic.value() + r.value() * load;
+  }
+
+  const CellLut* tlut = rise ? timing->rise_transition() : timing->fall_transition();
+  if ( tlut != nullptr ) {
+    slew = lut_value(tlut, islew, load);
+  }
+  else {
+    slew = 0.0;
+  }
+}
+
+// タイミング情報が出力の遷移に適用できる時 true を返す．
+bool
+check_type(const CellTiming* timing,
+	   bool rise)
+{
+  switch ( timing->type() ) {
+  case kCellTimingCombinational:
+    return true;
+
+  case kCellTimingCombinationalRise:
+    return rise;
+
+  case kCellTimingCombinationalFall:
+    return !rise;
+
+  default:
+    break;
+  }
+  return false;
+}
+
+// 出力ノードのピン容量を得る．
+double
+pin_cap(const CmnNode* node)
+{
+  const Cell* cell = nullptr;
+  ymuint pos = 0;
+  switch ( node->output_type() ) {
+  case CmnNode::kPRIMARY_OUTPUT:
+    return 0.0;
+
+  case CmnNode::kDFF_DATA:
+    cell = node->dff()->cell()->cell();
+    pos = node->dff()->cell()->data_pos();
+    break;
+
+  case CmnNode::kDFF_CLOCK:
+    cell = node->dff()->cell()->cell();
+    pos = node->dff()->cell()->clock_pos();
+    break;
+
+  case CmnNode::kDFF_CLEAR:
+    cell = node->dff()->cell()->cell();
+    pos = node->dff()->cell()->clear_pos();
+    break;
+
+  case CmnNode::kDFF_PRESET:
+    cell = node->dff()->cell()->cell();
+    pos = node->dff()->cell()->preset_pos();
+    break;
+
+  case CmnNode::kLATCH_DATA:
+    cell = node->latch()->cell()->cell();
+    pos = node->latch()->cell()->data_pos();
+    break;
+
+  case CmnNode::kLATCH_ENABLE:
+    cell = node->latch()->cell()->cell();
+    pos = node->latch()->cell()->enable_pos();
+    break;
+
+  case CmnNode::kLATCH_CLEAR:
+    cell = node->latch()->cell()->cell();
+    pos = node->latch()->cell()->clear_pos();
+    break;
+
+  case CmnNode::kLATCH_PRESET:
+    cell = node->latch()->cell()->cell();
+    pos = node->latch()->cell()->preset_pos();
+    break;
+  }
+  return cell->pin(pos)->capacitance().value();
+}
+
+// node_list[begin] から node_list[end - 1] に func を適用する．
+void
+apply_range(CmnSta* sta,
+	    bool (CmnSta::*func)(const CmnNode*),
+	    const vector<const CmnNode*>* node_list,
+	    ymuint begin,
+	    ymuint end)
+{
+  for (ymuint i = begin; i < end; ++ i) {
+    (sta->*func)((*node_list)[i]);
+  }
+}
+
+// critical_paths() で用いる探索の要素
+struct PathEntry
+{
+  // ノード
+  const CmnNode* mNode;
+
+  // 遷移
+  bool mRise;
+
+  // このノードから出力までの遅延
+  double mSuffix;
+
+  // 出力の要求時刻
+  double mRequired;
+
+  // 出力側の要素の番号(-1 なら出力)
+  int mParent;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CmnStaPool
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+// @class CmnStaPool
+// @brief CmnSta::parallel_apply() で用いるスレッドプール
+//
+// レベルごとにスレッドを作り直すと，寸法最適化のように update() を
+// 繰り返し呼ぶ場合にスレッドの生成のコストが無視できなくなるので，
+// 作ったスレッドは CmnSta が破棄されるまで使い回す．
+//////////////////////////////////////////////////////////////////////
+class CmnStaPool
+{
+public:
+
+  // コンストラクタ
+  // thread_num - 1 個のスレッドを起動する．
+  CmnStaPool(CmnSta* sta,
+	     ymuint thread_num);
+
+  // デストラクタ
+  // すべてのスレッドを終了させる．
+  ~CmnStaPool();
+
+
+public:
+
+  // node_list を thread_num 個に分けて func を適用する．
+  // 先頭の部分は呼び出したスレッドで処理する．
+  // すべて終わるまで戻らない．
+  void
+  run(const vector<const CmnNode*>& node_list,
+      bool (CmnSta::*func)(const CmnNode*));
+
+
+private:
+
+  // t 番目のスレッドの処理
+  void
+  worker(ymuint t);
+
+
+private:
+
+  // 対象の CmnSta
+  CmnSta* mSta;
+
+  // 呼び出したスレッドを含めたスレッド数
+  ymuint mThreadNum;
+
+  // スレッドのリスト
+  vector<std::thread> mThreadList;
+
+  // 以下のメンバを保護する mutex
+  std::mutex mMutex;
+
+  // 仕事の開始を知らせる条件変数
+  std::condition_variable mStartCond;
+
+  // 仕事の終了を知らせる条件変数
+  std::condition_variable mDoneCond;
+
+  // 仕事の世代番号
+  ymuint64 mGeneration;
+
+  // 処理の終わっていないスレッド数
+  ymuint mRemainNum;
+
+  // スレッドを終了させる時 true にするフラグ
+  bool mQuit;
+
+  // 現在の仕事の対象のノードのリスト
+  const vector<const CmnNode*>* mNodeList;
+
+  // 現在の仕事で適用する関数
+  bool (CmnSta::*mFunc)(const CmnNode*);
+
+};
+
+// @brief コンストラクタ
+CmnStaPool::CmnStaPool(CmnSta* sta,
+		       ymuint thread_num) :
+  mSta(sta),
+  mThreadNum(thread_num),
+  mGeneration(0),
+  mRemainNum(0),
+  mQuit(false),
+  mNodeList(nullptr),
+  mFunc(nullptr)
+{
+  mThreadList.reserve(thread_num - 1);
+  for (ymuint t = 1; t < thread_num; ++ t) {
+    mThreadList.push_back(std::thread(&CmnStaPool::worker, this, t));
+  }
+}
+
+// @brief デストラクタ
+CmnStaPool::~CmnStaPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQuit = true;
+  }
+  mStartCond.notify_all();
+  for (vector<std::thread>::iterator p = mThreadList.begin();
+       p != mThreadList.end(); ++ p) {
+    p->join();
+  }
+}
+
+// @brief node_list を thread_num 個に分けて func を適用する．
+void
+CmnStaPool::run(const vector<const CmnNode*>& node_list,
+		bool (CmnSta::*func)(const CmnNode*))
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mNodeList = &node_list;
+    mFunc = func;
+    mRemainNum = mThreadNum - 1;
+    ++ mGeneration;
+  }
+  mStartCond.notify_all();
+
+  apply_range(mSta, func, &node_list, 0, node_list.size() / mThreadNum);
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  while ( mRemainNum > 0 ) {
+    mDoneCond.wait(lock);
+  }
+}
+
+// @brief t 番目のスレッドの処理
+void
+CmnStaPool::worker(ymuint t)
+{
+  ymuint64 generation = 0;
+  for ( ; ; ) {
+    const vector<const CmnNode*>* node_list;
+    bool (CmnSta::*func)(const CmnNode*);
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      while ( !mQuit && mGeneration == generation ) {
+	mStartCond.wait(lock);
+      }
+      if ( mQuit ) {
+	return;
+      }
+      generation = mGeneration;
+      node_list = mNodeList;
+      func = mFunc;
+    }
+
+    ymuint n = node_list->size();
+    apply_range(mSta, func, node_list,
+		n * t / mThreadNum, n * (t + 1) / mThreadNum);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    -- mRemainNum;
+    if ( mRemainNum == 0 ) {
+      mDoneCond.notify_one();
+    }
+  }
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CmnSta
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] thread_num 計算に用いるスレッド数
+CmnSta::CmnSta(const CmnMgr& network,
+	       ymuint thread_num) :
+  mNetwork(network),
+  mThreadNum(thread_num),
+  mDefaultRequired(0.0),
+  mHasDefaultRequired(false),
+  mCurDefaultRequired(0.0),
+  mWireSlope(0.0),
+  mAllDirty(true),
+  mPool(nullptr)
+{
+  ymuint n = network.max_node_id();
+  mLevel.resize(n, 0);
+  mCellArray.resize(n, nullptr);
+  mArcTop.resize(n, 0);
+  mInputArrival.resize(n * 2, 0.0);
+  mInputTransition.resize(n * 2, 0.0);
+  mOutputLoad.resize(n, 0.0);
+  mOutputRequired.resize(n * 2, NAN);
+  mArrival.resize(n * 2, 0.0);
+  mTransition.resize(n * 2, 0.0);
+  mRequired.resize(n * 2, 0.0);
+  mLoad.resize(n, 0.0);
+
+  // レベル分けを行う．
+  mLevelList.push_back(vector<const CmnNode*>());
+  const CmnNodeList& input_list = network.input_list();
+  for (CmnNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    mLevelList[0].push_back(node);
+  }
+
+  vector<const CmnNode*> node_list;
+  network.sort(node_list);
+  ymuint arc_size = 0;
+  for (vector<const CmnNode*>::iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    ymuint ni = node->fanin_num();
+    ymuint level = 1;
+    for (ymuint i = 0; i < ni; ++ i) {
+      ymuint level1 = mLevel[node->fanin(i)->id()] + 1;
+      if ( level < level1 ) {
+	level = level1;
+      }
+    }
+    mLevel[node->id()] = level;
+    if ( mLevelList.size() <= level ) {
+      mLevelList.resize(level + 1);
+    }
+    mLevelList[level].push_back(node);
+    mCellArray[node->id()] = node->cell();
+    mArcTop[node->id()] = arc_size;
+    arc_size += ni * 4;
+  }
+  mArcDelay.resize(arc_size, kNoArc);
+
+  ymuint olevel = mLevelList.size();
+  mLevelList.push_back(vector<const CmnNode*>());
+  const CmnNodeList& output_list = network.output_list();
+  for (CmnNodeList::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    mLevel[node->id()] = olevel;
+    mLevelList[olevel].push_back(node);
+  }
+}
+
+// @brief デストラクタ
+CmnSta::~CmnSta()
+{
+  delete mPool;
+}
+
+// @brief 入力の到着時刻を設定する．
+// @param[in] node 対象の入力ノード
+// @param[in] rise 立ち上がりの到着時刻
+// @param[in] fall 立ち下がりの到着時刻
+void
+CmnSta::set_input_arrival(const CmnNode* node,
+			  double rise,
+			  double fall)
+{
+  ASSERT_COND( node->is_input() );
+  mInputArrival[node->id() * 2 + 0] = rise;
+  mInputArrival[node->id() * 2 + 1] = fall;
+  mAllDirty = true;
+}
+
+// @brief 入力の遷移時間を設定する．
+// @param[in] node 対象の入力ノード
+// @param[in] rise 立ち上がりの遷移時間
+// @param[in] fall 立ち下がりの遷移時間
+void
+CmnSta::set_input_transition(const CmnNode* node,
+			     double rise,
+			     double fall)
+{
+  ASSERT_COND( node->is_input() );
+  mInputTransition[node->id() * 2 + 0] = rise;
+  mInputTransition[node->id() * 2 + 1] = fall;
+  mAllDirty = true;
+}
+
+// @brief 出力の負荷容量を設定する．
+// @param[in] node 対象の出力ノード
+// @param[in] load 負荷容量
+void
+CmnSta::set_output_load(const CmnNode* node,
+			double load)
+{
+  ASSERT_COND( node->is_output() );
+  mOutputLoad[node->id()] = load;
+  mAllDirty = true;
+}
+
+// @brief 出力の要求時刻を設定する．
+// @param[in] node 対象の出力ノード
+// @param[in] rise 立ち上がりの要求時刻
+// @param[in] fall 立ち下がりの要求時刻
+void
+CmnSta::set_output_required(const CmnNode* node,
+			    double rise,
+			    double fall)
+{
+  ASSERT_COND( node->is_output() );
+  mOutputRequired[node->id() * 2 + 0] = rise;
+  mOutputRequired[node->id() * 2 + 1] = fall;
+  mAllDirty = true;
+}
+
+// @brief 個別に設定されていない出力の要求時刻を設定する．
+// @param[in] required 要求時刻
+void
+CmnSta::set_default_required(double required)
+{
+  mDefaultRequired = required;
+  mHasDefaultRequired = true;
+  mAllDirty = true;
+}
+
+// @brief wire load モデルを設定する．
+// @param[in] cap_list ファンアウト数ごとの配線容量のリスト
+// @param[in] slope cap_list の範囲を超えた時の1ファンアウトあたりの増分
+void
+CmnSta::set_wire_load(const vector<double>& cap_list,
+		      double slope)
+{
+  mWireCapList = cap_list;
+  mWireSlope = slope;
+  mAllDirty = true;
+}
+
+// @brief ノードのセルを置き換える．
+// @param[in] node 対象の論理ノード
+// @param[in] cell 新しいセル
+void
+CmnSta::set_cell(const CmnNode* node,
+		 const Cell* cell)
+{
+  ASSERT_COND( node->is_logic() );
+  ASSERT_COND( cell->input_num() == node->fanin_num() );
+  mCellArray[node->id()] = cell;
+  if ( !mAllDirty ) {
+    mChangedList.push_back(node);
+  }
+}
+
+// @brief タイミングを計算する．
+void
+CmnSta::update()
+{
+  if ( mAllDirty ) {
+    full_update();
+  }
+  else if ( !mChangedList.empty() ) {
+    incr_update();
+  }
+  mAllDirty = false;
+  mChangedList.clear();
+}
+
+// @brief ノードのセルを得る．
+// @param[in] node 対象のノード
+const Cell*
+CmnSta::cell(const CmnNode* node) const
+{
+  return mCellArray[node->id()];
+}
+
+// @brief 到着時刻を得る．
+// @param[in] node 対象のノード
+// @param[in] rise 立ち上がりの時 true とするフラグ
+double
+CmnSta::arrival(const CmnNode* node,
+		bool rise) const
+{
+  return mArrival[node->id() * 2 + (rise ? 0 : 1)];
+}
+
+// @brief 要求時刻を得る．
+// @param[in] node 対象のノード
+// @param[in] rise 立ち上がりの時 true とするフラグ
+double
+CmnSta::required(const CmnNode* node,
+		 bool rise) const
+{
+  return mRequired[node->id() * 2 + (rise ? 0 : 1)];
+}
+
+// @brief スラックを得る．
+// @param[in] node 対象のノード
+// @param[in] rise 立ち上がりの時 true とするフラグ
+double
+CmnSta::slack(const CmnNode* node,
+	      bool rise) const
+{
+  return required(node, rise) - arrival(node, rise);
+}
+
+// @brief 遷移時間を得る．
+// @param[in] node 対象のノード
+// @param[in] rise 立ち上がりの時 true とするフラグ
+double
+CmnSta::transition(const CmnNode* node,
+		   bool rise) const
+{
+  return mTransition[node->id() * 2 + (rise ? 0 : 1)];
+}
+
+// @brief 負荷容量を得る．
+// @param[in] node 対象のノード
+double
+CmnSta::load(const CmnNode* node) const
+{
+  return mLoad[node->id()];
+}
+
+// @brief 最小のスラックを得る．
+double
+CmnSta::worst_slack() const
+{
+  double ans = DBL_MAX;
+  const vector<const CmnNode*>& output_list = mLevelList.back();
+  for (vector<const CmnNode*>::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    for (ymuint o = 0; o < 2; ++ o) {
+      double s = slack(node, o == 0);
+      if ( ans > s ) {
+	ans = s;
+      }
+    }
+  }
+  return ans;
+}
+
+// @brief スラックの小さい順に経路を求める．
+// @param[in] n 求める経路数の上限
+// @param[out] path_list 結果の経路を格納するリスト
+//
+// 出力から入力に向かって部分経路を延ばしていく最良優先探索を行う．
+// 部分経路の評価値は (延ばした先のノードの到着時刻) + (部分経路の遅延)
+// - (出力の要求時刻) で，これは部分経路を含む経路のスラックの最小値
+// (の符号を反転したもの)に等しいので，入力に達した順に経路を取り出せば
+// スラックの小さい順になる．
+void
+CmnSta::critical_paths(ymuint n,
+		       vector<CmnStaPath>& path_list) const
+{
+  path_list.clear();
+
+  vector<PathEntry> entry_list;
+  std::priority_queue<pair<double, ymuint> > queue;
+
+  const vector<const CmnNode*>& output_list = mLevelList.back();
+  for (vector<const CmnNode*>::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    for (ymuint o = 0; o < 2; ++ o) {
+      PathEntry entry;
+      entry.mNode = node;
+      entry.mRise = (o == 0);
+      entry.mSuffix = 0.0;
+      entry.mRequired = required(node, entry.mRise);
+      entry.mParent = -1;
+      double key = arrival(node, entry.mRise) - entry.mRequired;
+      queue.push(make_pair(key, entry_list.size()));
+      entry_list.push_back(entry);
+    }
+  }
+
+  while ( path_list.size() < n && !queue.empty() ) {
+    ymuint idx = queue.top().second;
+    queue.pop();
+    PathEntry entry = entry_list[idx];
+    const CmnNode* node = entry.mNode;
+    if ( node->is_input() ) {
+      path_list.push_back(CmnStaPath());
+      CmnStaPath& path = path_list.back();
+      path.mSlack = entry.mRequired - (arrival(node, entry.mRise) + entry.mSuffix);
+      for (int pos = idx; pos >= 0; pos = entry_list[pos].mParent) {
+	path.mNodeList.push_back(entry_list[pos].mNode);
+	path.mRiseList.push_back(entry_list[pos].mRise);
+      }
+      continue;
+    }
+
+    if ( node->is_output() ) {
+      PathEntry entry1 = entry;
+      entry1.mNode = node->fanin(0);
+      entry1.mParent = idx;
+      double key = arrival(entry1.mNode, entry1.mRise) + entry1.mSuffix - entry1.mRequired;
+      queue.push(make_pair(key, entry_list.size()));
+      entry_list.push_back(entry1);
+      continue;
+    }
+
+    ymuint ni = node->fanin_num();
+    for (ymuint ipos = 0; ipos < ni; ++ ipos) {
+      for (ymuint i = 0; i < 2; ++ i) {
+	double d = arc_delay(node, ipos, i == 0, entry.mRise);
+	if ( d == kNoArc ) {
+	  continue;
+	}
+	PathEntry entry1;
+	entry1.mNode = node->fanin(ipos);
+	entry1.mRise = (i == 0);
+	entry1.mSuffix = entry.mSuffix + d;
+	entry1.mRequired = entry.mRequired;
+	entry1.mParent = idx;
+	double key = arrival(entry1.mNode, entry1.mRise) + entry1.mSuffix - entry1.mRequired;
+	queue.push(make_pair(key, entry_list.size()));
+	entry_list.push_back(entry1);
+      }
+    }
+  }
+}
+
+// @brief すべてを計算し直す．
+void
+CmnSta::full_update()
+{
+  for (vector<vector<const CmnNode*> >::iterator p = mLevelList.begin();
+       p != mLevelList.end(); ++ p) {
+    const vector<const CmnNode*>& node_list = *p;
+    for (vector<const CmnNode*>::const_iterator q = node_list.begin();
+	 q != node_list.end(); ++ q) {
+      calc_load(*q);
+    }
+  }
+
+  for (vector<vector<const CmnNode*> >::iterator p = mLevelList.begin();
+       p != mLevelList.end(); ++ p) {
+    parallel_apply(*p, &CmnSta::calc_arrival);
+  }
+
+  mCurDefaultRequired = calc_default_required();
+
+  for (vector<vector<const CmnNode*> >::reverse_iterator p = mLevelList.rbegin();
+       p != mLevelList.rend(); ++ p) {
+    parallel_apply(*p, &CmnSta::calc_required);
+  }
+}
+
+// @brief 変化のあった部分のみ計算し直す．
+void
+CmnSta::incr_update()
+{
+  ymuint nl = mLevelList.size();
+  vector<vector<const CmnNode*> > queue(nl);
+  vector<bool> mark(mLevel.size(), false);
+
+  // セルの変わったノードとそのファンインは負荷容量から計算し直す．
+  for (vector<const CmnNode*>::iterator p = mChangedList.begin();
+       p != mChangedList.end(); ++ p) {
+    const CmnNode* node = *p;
+    if ( !mark[node->id()] ) {
+      mark[node->id()] = true;
+      queue[mLevel[node->id()]].push_back(node);
+    }
+    ymuint ni = node->fanin_num();
+    for (ymuint i = 0; i < ni; ++ i) {
+      const CmnNode* inode = node->fanin(i);
+      calc_load(inode);
+      if ( !mark[inode->id()] ) {
+	mark[inode->id()] = true;
+	queue[mLevel[inode->id()]].push_back(inode);
+      }
+    }
+  }
+
+  // 到着時刻が変化したノードのファンアウトに伝搬させる．
+  vector<const CmnNode*> touched_list;
+  for (ymuint l = 0; l < nl; ++ l) {
+    const vector<const CmnNode*>& node_list = queue[l];
+    for (vector<const CmnNode*>::const_iterator p = node_list.begin();
+	 p != node_list.end(); ++ p) {
+      const CmnNode* node = *p;
+      mark[node->id()] = false;
+      touched_list.push_back(node);
+      if ( !calc_arrival(node) ) {
+	continue;
+      }
+      const CmnFanoutList& fo_list = node->fanout_list();
+      for (CmnFanoutList::const_iterator q = fo_list.begin();
+	   q != fo_list.end(); ++ q) {
+	const CmnNode* onode = (*q)->to();
+	if ( !mark[onode->id()] ) {
+	  mark[onode->id()] = true;
+	  queue[mLevel[onode->id()]].push_back(onode);
+	}
+      }
+    }
+    queue[l].clear();
+  }
+
+  double def_req = calc_default_required();
+  if ( def_req != mCurDefaultRequired ) {
+    // すべての出力の要求時刻が変わる．
+    mCurDefaultRequired = def_req;
+    for (vector<vector<const CmnNode*> >::reverse_iterator p = mLevelList.rbegin();
+	 p != mLevelList.rend(); ++ p) {
+      parallel_apply(*p, &CmnSta::calc_required);
+    }
+    return;
+  }
+
+  // 計算し直したノードはアークの遅延が変わっているので
+  // そのファンインから要求時刻を計算し直す．
+  for (vector<const CmnNode*>::iterator p = touched_list.begin();
+       p != touched_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    if ( !mark[node->id()] ) {
+      mark[node->id()] = true;
+      queue[mLevel[node->id()]].push_back(node);
+    }
+    ymuint ni = node->fanin_num();
+    for (ymuint i = 0; i < ni; ++ i) {
+      const CmnNode* inode = node->fanin(i);
+      if ( !mark[inode->id()] ) {
+	mark[inode->id()] = true;
+	queue[mLevel[inode->id()]].push_back(inode);
+      }
+    }
+  }
+  for (ymuint l = nl; l -- > 0; ) {
+    const vector<const CmnNode*>& node_list = queue[l];
+    for (vector<const CmnNode*>::const_iterator p = node_list.begin();
+	 p != node_list.end(); ++ p) {
+      const CmnNode* node = *p;
+      mark[node->id()] = false;
+      if ( !calc_required(node) ) {
+	continue;
+      }
+      ymuint ni = node->fanin_num();
+      for (ymuint i = 0; i < ni; ++ i) {
+	const CmnNode* inode = node->fanin(i);
+	if ( !mark[inode->id()] ) {
+	  mark[inode->id()] = true;
+	  queue[mLevel[inode->id()]].push_back(inode);
+	}
+      }
+    }
+  }
+}
+
+// @brief 負荷容量を計算する．
+// @param[in] node 対象のノード
+void
+CmnSta::calc_load(const CmnNode* node)
+{
+  double load = wire_cap(node->fanout_num());
+  const CmnFanoutList& fo_list = node->fanout_list();
+  for (CmnFanoutList::const_iterator p = fo_list.begin();
+       p != fo_list.end(); ++ p) {
+    const CmnEdge* edge = *p;
+    const CmnNode* onode = edge->to();
+    if ( onode->is_logic() ) {
+      const Cell* cell = mCellArray[onode->id()];
+      load += cell->input(edge->to_pos())->capacitance().value();
+    }
+    else {
+      load += mOutputLoad[onode->id()] + pin_cap(onode);
+    }
+  }
+  mLoad[node->id()] = load;
+}
+
+// @brief 到着時刻と遷移時間を計算する．
+// @param[in] node 対象のノード
+// @return 値が変化したら true を返す．
+bool
+CmnSta::calc_arrival(const CmnNode* node)
+{
+  ymuint id = node->id();
+  double arr[2];
+  double slew[2];
+  if ( node->is_input() ) {
+    for (ymuint o = 0; o < 2; ++ o) {
+      arr[o] = mInputArrival[id * 2 + o];
+      slew[o] = mInputTransition[id * 2 + o];
+    }
+  }
+  else if ( node->is_output() ) {
+    ymuint iid = node->fanin(0)->id();
+    for (ymuint o = 0; o < 2; ++ o) {
+      arr[o] = mArrival[iid * 2 + o];
+      slew[o] = mTransition[iid * 2 + o];
+    }
+  }
+  else {
+    const Cell* cell = mCellArray[id];
+    double load = mLoad[id];
+    ymuint ni = node->fanin_num();
+    double* arc = &mArcDelay[mArcTop[id]];
+    for (ymuint i = 0; i < ni * 4; ++ i) {
+      arc[i] = kNoArc;
+    }
+    for (ymuint o = 0; o < 2; ++ o) {
+      arr[o] = -DBL_MAX;
+      slew[o] = 0.0;
+    }
+    // non_unate のタイミング情報は正と負の両方に登録されている．
+    const tCellTimingSense sense_list[] = {
+      kCellPosiUnate, kCellNegaUnate
+    };
+    for (ymuint ipos = 0; ipos < ni; ++ ipos) {
+      ymuint iid = node->fanin(ipos)->id();
+      for (ymuint s = 0; s < 2; ++ s) {
+	tCellTimingSense sense = sense_list[s];
+	ymuint nt = cell->timing_num(ipos, 0, sense);
+	for (ymuint k = 0; k < nt; ++ k) {
+	  const CellTiming* timing = cell->timing(ipos, 0, sense, k);
+	  for (ymuint o = 0; o < 2; ++ o) {
+	    if ( !check_type(timing, o == 0) ) {
+	      continue;
+	    }
+	    for (ymuint i = 0; i < 2; ++ i) {
+	      if ( sense == kCellPosiUnate && i != o ) {
+		continue;
+	      }
+	      if ( sense == kCellNegaUnate && i == o ) {
+		continue;
+	      }
+	      double delay;
+	      double oslew;
+	      calc_timing(timing, o == 0, mTransition[iid * 2 + i], load,
+			  delay, oslew);
+	      double& d = arc[(ipos * 2 + i) * 2 + o];
+	      if ( d < delay ) {
+		d = delay;
+	      }
+	      double t = mArrival[iid * 2 + i] + delay;
+	      if ( arr[o] < t ) {
+		arr[o] = t;
+	      }
+	      if ( slew[o] < oslew ) {
+		slew[o] = oslew;
+	      }
+	    }
+	  }
+	}
+      }
+    }
+    for (ymuint o = 0; o < 2; ++ o) {
+      if ( arr[o] == -DBL_MAX ) {
+	// 定数セル
+	arr[o] = 0.0;
+      }
+    }
+  }
+
+  bool changed = false;
+  for (ymuint o = 0; o < 2; ++ o) {
+    if ( mArrival[id * 2 + o] != arr[o] ) {
+      mArrival[id * 2 + o] = arr[o];
+      changed = true;
+    }
+    if ( mTransition[id * 2 + o] != slew[o] ) {
+      mTransition[id * 2 + o] = slew[o];
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+// @brief 要求時刻を計算する．
+// @param[in] node 対象のノード
+// @return 値が変化したら true を返す．
+bool
+CmnSta::calc_required(const CmnNode* node)
+{
+  ymuint id = node->id();
+  double req[2];
+  if ( node->is_output() ) {
+    for (ymuint o = 0; o < 2; ++ o) {
+      req[o] = mOutputRequired[id * 2 + o];
+      if ( std::isnan(req[o]) ) {
+	req[o] = mCurDefaultRequired;
+      }
+    }
+  }
+  else {
+    req[0] = req[1] = DBL_MAX;
+    const CmnFanoutList& fo_list = node->fanout_list();
+    for (CmnFanoutList::const_iterator p = fo_list.begin();
+	 p != fo_list.end(); ++ p) {
+      const CmnEdge* edge = *p;
+      const CmnNode* onode = edge->to();
+      ymuint oid = onode->id();
+      if ( onode->is_output() ) {
+	for (ymuint o = 0; o < 2; ++ o) {
+	  if ( req[o] > mRequired[oid * 2 + o] ) {
+	    req[o] = mRequired[oid * 2 + o];
+	  }
+	}
+	continue;
+      }
+      ymuint ipos = edge->to_pos();
+      for (ymuint i = 0; i < 2; ++ i) {
+	for (ymuint o = 0; o < 2; ++ o) {
+	  double d = arc_delay(onode, ipos, i == 0, o == 0);
+	  if ( d == kNoArc ) {
+	    continue;
+	  }
+	  double t = mRequired[oid * 2 + o] - d;
+	  if ( req[i] > t ) {
+	    req[i] = t;
+	  }
+	}
+      }
+    }
+  }
+
+  bool changed = false;
+  for (ymuint o = 0; o < 2; ++ o) {
+    if ( mRequired[id * 2 + o] != req[o] ) {
+      mRequired[id * 2 + o] = req[o];
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+// @brief 出力の要求時刻の既定値を求める．
+double
+CmnSta::calc_default_required() const
+{
+  if ( mHasDefaultRequired ) {
+    return mDefaultRequired;
+  }
+
+  double ans = 0.0;
+  const vector<const CmnNode*>& output_list = mLevelList.back();
+  for (vector<const CmnNode*>::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    const CmnNode* node = *p;
+    for (ymuint o = 0; o < 2; ++ o) {
+      double t = mArrival[node->id() * 2 + o];
+      if ( ans < t ) {
+	ans = t;
+      }
+    }
+  }
+  return ans;
+}
+
+// @brief ノードのリストに対して関数を並列に適用する．
+// @param[in] node_list ノードのリスト
+// @param[in] func 適用する関数
+// @note 同じレベルのノードは互いに依存しないので並列に処理できる．
+void
+CmnSta::parallel_apply(const vector<const CmnNode*>& node_list,
+		       bool (CmnSta::*func)(const CmnNode*))
+{
+  ymuint n = node_list.size();
+  if ( mThreadNum <= 1 || n < kParallelThreshold ) {
+    apply_range(this, func, &node_list, 0, n);
+    return;
+  }
+
+  if ( mPool == nullptr ) {
+    mPool = new CmnStaPool(this, mThreadNum);
+  }
+  mPool->run(node_list, func);
+}
+
+// @brief アークの遅延を得る．
+// @param[in] node 対象の論理ノード
+// @param[in] ipos ファンイン番号
+// @param[in] irise 入力が立ち上がりの時 true
+// @param[in] orise 出力が立ち上がりの時 true
+double&
+CmnSta::arc_delay(const CmnNode* node,
+		  ymuint ipos,
+		  bool irise,
+		  bool orise)
+{
+  ymuint idx = (ipos * 2 + (irise ? 0 : 1)) * 2 + (orise ? 0 : 1);
+  return mArcDelay[mArcTop[node->id()] + idx];
+}
+
+// @brief アークの遅延を得る．
+double
+CmnSta::arc_delay(const CmnNode* node,
+		  ymuint ipos,
+		  bool irise,
+		  bool orise) const
+{
+  ymuint idx = (ipos * 2 + (irise ? 0 : 1)) * 2 + (orise ? 0 : 1);
+  return mArcDelay[mArcTop[node->id()] + idx];
+}
+
+// @brief 配線容量を得る．
+// @param[in] fanout_num ファンアウト数
+double
+CmnSta::wire_cap(ymuint fanout_num) const
+{
+  ymuint n = mWireCapList.size();
+  if ( n == 0 ) {
+    return 0.0;
+  }
+  if ( fanout_num < n ) {
+    return mWireCapList[fanout_num];
+  }
+  return mWireCapList[n - 1] + mWireSlope * (fanout_num - n + 1);
+}
+
+END_NAMESPACE_YM_NETWORKS_CMN
@@ -0,0 +1,1281 @@
+﻿
+/// @file SigProbEngine.cc
+/// @brief SigProbEngine の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SigProbEngine.h"
+#include "YmLogic/VarId.h"
+#include "YmUtils/HashMap.h"
+#include <cmath>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_NETWORKS
+
+BEGIN_NONAMESPACE
+
+// 1ブロックあたりのワード数
+const ymuint kBlockWords = 32;
+
+// 1回の反復でスレッドごとに処理するブロック数
+const ymuint kRoundBlocks = 4;
+
+// 信頼区間を求めるためのレーンのグループ数
+// 4ビットずつのグループに分ける．
+// 1ブロックの集計は8ビットに収まる必要があるので
+// kBlockWords * 4 は 256 未満でなければならない．
+const ymuint kGroupNum = 16;
+
+// 95% 信頼区間に対応する正規分布の分位点
+const double kZ = 1.96;
+
+// 並列に処理するノード数の下限
+const ymuint kParallelThreshold = 64;
+
+// 確率を表す整数の分母
+const ymuint32 kProbDenom = 1U << 16;
+
+// 確率を kProbDenom 単位の整数に変換する．
+inline
+ymuint32
+prob_to_thr(double p)
+{
+  return static_cast<ymuint32>(p * kProbDenom + 0.5);
+}
+
+// 乱数の種を混ぜ合わせる．(splitmix64)
+inline
+ymuint64
+mix_seed(ymuint64 x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// 一様な 64 ビットの乱数を作る．(xorshift64*)
+inline
+ymuint64
+next_rand(ymuint64& state)
+{
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 0x2545f4914f6cdd1dULL;
+}
+
+// 各ビットが thr / kProbDenom の確率で 1 となるワードを作る．
+// thr の下位のビットから順に，ビットが 1 なら OR，0 なら AND で
+// 一様な乱数と組み合わせる．
+ymuint64
+rand_word(ymuint64& rand_state,
+	  ymuint32 thr)
+{
+  if ( thr == 0 ) {
+    return 0ULL;
+  }
+  if ( thr >= kProbDenom ) {
+    return ~0ULL;
+  }
+  ymuint i = 0;
+  while ( ((thr >> i) & 1U) == 0 ) {
+    ++ i;
+  }
+  ymuint64 ans = 0ULL;
+  for ( ; i < 16; ++ i) {
+    ymuint64 r = next_rand(rand_state);
+    if ( (thr >> i) & 1U ) {
+      ans |= r;
+    }
+    else {
+      ans &= r;
+    }
+  }
+  return ans;
+}
+
+// 4ビットごとの 1 の数をバイト単位で加える．
+// 偶数番目の4ビットの数を acc0 に，奇数番目の4ビットの数を acc1 に加える．
+inline
+void
+add_group_count(ymuint64 v,
+		ymuint64& acc0,
+		ymuint64& acc1)
+{
+  v = v - ((v >> 1) & 0x5555555555555555ULL);
+  v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+  acc0 += v & 0x0F0F0F0F0F0F0F0FULL;
+  acc1 += (v >> 4) & 0x0F0F0F0F0F0F0F0FULL;
+}
+
+// add_group_count() で求めた値をグループごとの数に加える．
+inline
+void
+put_group_count(ymuint64 acc0,
+		ymuint64 acc1,
+		ymuint64* count_array)
+{
+  for (ymuint i = 0; i < 8; ++ i) {
+    count_array[i * 2 + 0] += (acc0 >> (i * 8)) & 0xFFULL;
+    count_array[i * 2 + 1] += (acc1 >> (i * 8)) & 0xFFULL;
+  }
+}
+
+// Wilson のスコア区間の半幅を求める．
+// 標本が独立な場合の値なので，信頼区間の下限として用いる．
+double
+ci_half(double p,
+	double n)
+{
+  double z2 = kZ * kZ;
+  return kZ * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / (1.0 + z2 / n);
+}
+
+// 自由度 dof の t 分布の 97.5% 点を求める．
+// Cornish-Fisher 展開による近似を用いる．
+double
+t_quantile(ymuint dof)
+{
+  double z = kZ;
+  double z3 = z * z * z;
+  double z5 = z3 * z * z;
+  double d = dof;
+  return z + (z3 + z) / (4.0 * d) + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * d * d);
+}
+
+// グループごとの値の平均の信頼区間の半幅を求める．
+// count_list : グループごとの数
+// m : グループあたりのパタン数
+// mean : 全体の平均
+double
+group_half(const vector<ymuint64>& count_list,
+	   double m,
+	   double mean)
+{
+  ymuint ng = count_list.size();
+  double sum2 = 0.0;
+  for (vector<ymuint64>::const_iterator p = count_list.begin();
+       p != count_list.end(); ++ p) {
+    double d = *p / m - mean;
+    sum2 += d * d;
+  }
+  return t_quantile(ng - 1) * sqrt(sum2 / ((ng - 1) * static_cast<double>(ng)));
+}
+
+// 要素が含まれていたら true を返す．
+inline
+bool
+contains(const vector<ymuint32>& id_list,
+	 ymuint32 id)
+{
+  for (vector<ymuint32>::const_iterator p = id_list.begin();
+       p != id_list.end(); ++ p) {
+    if ( *p == id ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// 論理式の変数 i を input_list[i] に置き換えた BDD を作る．
+Bdd
+expr_to_bdd(BddMgr& mgr,
+	    const Expr& expr,
+	    const vector<Bdd>& input_list)
+{
+  if ( expr.is_zero() ) {
+    return mgr.make_zero();
+  }
+  if ( expr.is_one() ) {
+    return mgr.make_one();
+  }
+  if ( expr.is_literal() ) {
+    Bdd f = input_list[expr.varid().val()];
+    if ( expr.is_posiliteral() ) {
+      return f;
+    }
+    return ~f;
+  }
+
+  ymuint nc = expr.child_num();
+  Bdd f = expr_to_bdd(mgr, expr.child(0), input_list);
+  for (ymuint i = 1; i < nc; ++ i) {
+    Bdd g = expr_to_bdd(mgr, expr.child(i), input_list);
+    if ( expr.is_and() ) {
+      f &= g;
+    }
+    else if ( expr.is_or() ) {
+      f |= g;
+    }
+    else {
+      ASSERT_COND( expr.is_xor() );
+      f ^= g;
+    }
+  }
+  return f;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// 葉の変数に確率を割り当てて BDD の確率を求めるクラス
+// 葉 i の現時刻の値が変数 2i，次の時刻の値が変数 2i + 1 となる．
+// 異なる葉どうしは独立で，同じ葉の2つの時刻の値は
+// 遷移確率で結ばれているものとする．
+//////////////////////////////////////////////////////////////////////
+class ProbCalc
+{
+public:
+
+  // コンストラクタ
+  // prob_list : 葉の信号確率のリスト
+  // rise_list : 葉が 0 の時に次の時刻に 1 となる確率のリスト
+  // fall_list : 葉が 1 の時に次の時刻に 0 となる確率のリスト
+  ProbCalc(const vector<double>& prob_list,
+	   const vector<double>& rise_list,
+	   const vector<double>& fall_list);
+
+  // 現時刻の変数のみに依存する関数の確率を求める．
+  double
+  prob(const Bdd& f);
+
+  // 両方の時刻の変数に依存する関数の確率を求める．
+  double
+  pair_prob(const Bdd& f);
+
+
+private:
+
+  // 葉 i の現時刻の値を展開した後の関数の確率を求める．
+  // q は次の時刻の値が 1 となる条件付き確率
+  double
+  pair_cond(const Bdd& f,
+	    ymuint i,
+	    double q);
+
+
+private:
+
+  // 信号確率のリスト
+  const vector<double>& mProbList;
+
+  // 立ち上がりの遷移確率のリスト
+  const vector<double>& mRiseList;
+
+  // 立ち下がりの遷移確率のリスト
+  const vector<double>& mFallList;
+
+  // prob() の結果を保持するハッシュ表
+  HashMap<Bdd, double> mProbTable;
+
+  // pair_prob() の結果を保持するハッシュ表
+  HashMap<Bdd, double> mPairTable;
+
+};
+
+// コンストラクタ
+ProbCalc::ProbCalc(const vector<double>& prob_list,
+		   const vector<double>& rise_list,
+		   const vector<double>& fall_list) :
+  mProbList(prob_list),
+  mRiseList(rise_list),
+  mFallList(fall_list)
+{
+}
+
+// 現時刻の変数のみに依存する関数の確率を求める．
+double
+ProbCalc::prob(const Bdd& f)
+{
+  if ( f.is_zero() ) {
+    return 0.0;
+  }
+  if ( f.is_one() ) {
+    return 1.0;
+  }
+  double ans;
+  if ( mProbTable.find(f, ans) ) {
+    return ans;
+  }
+  double p = mProbList[f.root_var().val() / 2];
+  ans = p * prob(f.edge1()) + (1.0 - p) * prob(f.edge0());
+  mProbTable.add(f, ans);
+  return ans;
+}
+
+// 両方の時刻の変数に依存する関数の確率を求める．
+double
+ProbCalc::pair_prob(const Bdd& f)
+{
+  if ( f.is_zero() ) {
+    return 0.0;
+  }
+  if ( f.is_one() ) {
+    return 1.0;
+  }
+  double ans;
+  if ( mPairTable.find(f, ans) ) {
+    return ans;
+  }
+  ymuint v = f.root_var().val();
+  ymuint i = v / 2;
+  double p = mProbList[i];
+  if ( v % 2 == 0 ) {
+    // 現時刻の値で展開した後は次の時刻の値を条件付き確率で展開する．
+    ans = p * pair_cond(f.edge1(), i, 1.0 - mFallList[i])
+      + (1.0 - p) * pair_cond(f.edge0(), i, mRiseList[i]);
+  }
+  else {
+    // 現時刻の値に依存しない場合は周辺確率で展開する．
+    ans = p * pair_prob(f.edge1()) + (1.0 - p) * pair_prob(f.edge0());
+  }
+  mPairTable.add(f, ans);
+  return ans;
+}
+
+// 葉 i の現時刻の値を展開した後の関数の確率を求める．
+double
+ProbCalc::pair_cond(const Bdd& f,
+		    ymuint i,
+		    double q)
+{
+  if ( f.root_var() == VarId(i * 2 + 1) ) {
+    return q * pair_prob(f.edge1()) + (1.0 - q) * pair_prob(f.edge0());
+  }
+  return pair_prob(f);
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SigProbEngine
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] thread_num 計算に用いるスレッド数
+SigProbEngine::SigProbEngine(ymuint thread_num) :
+  mThreadNum(thread_num > 0 ? thread_num : 1),
+  mStructDirty(true),
+  mMaxPattern(1ULL << 20),
+  mMaxError(0.005),
+  mSeed(1),
+  mCutSize(8),
+  mConeSize(32),
+  mLastMode(kModeNone),
+  mAllDirty(true),
+  mPatternNum(0)
+{
+}
+
+// @brief デストラクタ
+SigProbEngine::~SigProbEngine()
+{
+  for (vector<SimState*>::iterator p = mSimStateList.begin();
+       p != mSimStateList.end(); ++ p) {
+    delete *p;
+  }
+  for (vector<BddMgr*>::iterator p = mBddMgrList.begin();
+       p != mBddMgrList.end(); ++ p) {
+    delete *p;
+  }
+}
+
+// @brief ノード番号の最大値 + 1 を設定する．
+// @param[in] node_num ノード番号の最大値 + 1
+void
+SigProbEngine::resize(ymuint node_num)
+{
+  ymuint old_num = mNodeArray.size();
+  if ( node_num == old_num ) {
+    return;
+  }
+  mNodeArray.resize(node_num);
+  for (ymuint id = old_num; id < node_num; ++ id) {
+    mNodeArray[id].mType = kNone;
+    mNodeArray[id].mLevel = 0;
+  }
+  mInputProb.resize(node_num, 0.5);
+  mInputToggle.resize(node_num, 0.5);
+  mChanged.resize(node_num, false);
+  mProb.resize(node_num, 0.0);
+  mToggle.resize(node_num, 0.0);
+  mProbError.resize(node_num, 0.0);
+  mToggleError.resize(node_num, 0.0);
+  mStructDirty = true;
+  if ( node_num < old_num ) {
+    mAllDirty = true;
+  }
+}
+
+// @brief ノードを削除する．
+// @param[in] id ノード番号
+void
+SigProbEngine::set_none(ymuint id)
+{
+  ASSERT_COND( id < mNodeArray.size() );
+  Node& node = mNodeArray[id];
+  if ( node.mType == kNone ) {
+    return;
+  }
+  node.mType = kNone;
+  node.mFaninList.clear();
+  node.mFunc = Expr();
+  node.mCode.compile(node.mFunc);
+  mProb[id] = 0.0;
+  mToggle[id] = 0.0;
+  mProbError[id] = 0.0;
+  mToggleError[id] = 0.0;
+  mChanged[id] = true;
+  mStructDirty = true;
+}
+
+// @brief 入力ノードを設定する．
+// @param[in] id ノード番号
+void
+SigProbEngine::set_input(ymuint id)
+{
+  ASSERT_COND( id < mNodeArray.size() );
+  Node& node = mNodeArray[id];
+  if ( node.mType == kInput ) {
+    return;
+  }
+  node.mType = kInput;
+  node.mFaninList.clear();
+  node.mFunc = Expr();
+  node.mCode.compile(node.mFunc);
+  mChanged[id] = true;
+  mStructDirty = true;
+}
+
+// @brief 論理ノードを設定する．
+// @param[in] id ノード番号
+// @param[in] fanin_list ファンインのノード番号のリスト
+// @param[in] func 関数を表す論理式
+void
+SigProbEngine::set_logic(ymuint id,
+			 const vector<ymuint>& fanin_list,
+			 const Expr& func)
+{
+  ASSERT_COND( id < mNodeArray.size() );
+  ASSERT_COND( func.input_size() <= fanin_list.size() );
+  Node& node = mNodeArray[id];
+  node.mType = kLogic;
+  node.mFaninList.clear();
+  node.mFaninList.reserve(fanin_list.size());
+  for (vector<ymuint>::const_iterator p = fanin_list.begin();
+       p != fanin_list.end(); ++ p) {
+    node.mFaninList.push_back(*p);
+  }
+  node.mFunc = func;
+  node.mCode.compile(func);
+  mChanged[id] = true;
+  mStructDirty = true;
+}
+
+// @brief 入力の信号確率とトグル率を設定する．
+// @param[in] id 入力ノードのノード番号
+// @param[in] prob 値が 1 となる確率
+// @param[in] toggle トグル率
+void
+SigProbEngine::set_input_prob(ymuint id,
+			      double prob,
+			      double toggle)
+{
+  ASSERT_COND( id < mNodeArray.size() );
+  mInputProb[id] = prob;
+  mInputToggle[id] = toggle;
+  mChanged[id] = true;
+}
+
+// @brief モンテカルロシミュレーションのパラメータを設定する．
+// @param[in] max_pattern パタン数の上限
+// @param[in] max_error 95% 信頼区間の半幅の目標値
+// @param[in] seed 乱数の種
+void
+SigProbEngine::set_mc_param(ymuint64 max_pattern,
+			    double max_error,
+			    ymuint32 seed)
+{
+  mMaxPattern = max_pattern;
+  mMaxError = max_error;
+  mSeed = seed;
+  mAllDirty = true;
+}
+
+// @brief 局所カットのパラメータを設定する．
+// @param[in] cut_size カットの葉の数の上限
+// @param[in] cone_size カット内のノード数の上限
+void
+SigProbEngine::set_cut_param(ymuint cut_size,
+			     ymuint cone_size)
+{
+  mCutSize = cut_size;
+  mConeSize = cone_size > 0 ? cone_size : 1;
+  mAllDirty = true;
+}
+
+// @brief モンテカルロシミュレーションで求める．
+void
+SigProbEngine::simulate()
+{
+  if ( mStructDirty ) {
+    levelize();
+  }
+
+  // すべてのノードをシミュレーションして集計する．
+  mSimList = mLevelList;
+  mCountList.clear();
+  for (vector<vector<ymuint32> >::const_iterator p = mLevelList.begin();
+       p != mLevelList.end(); ++ p) {
+    mCountList.insert(mCountList.end(), p->begin(), p->end());
+  }
+
+  init_sim_param();
+  for (vector<SimState*>::iterator p = mSimStateList.begin();
+       p != mSimStateList.end(); ++ p) {
+    delete *p;
+  }
+  mSimStateList.clear();
+  mSimStateList.reserve(mThreadNum);
+  for (ymuint t = 0; t < mThreadNum; ++ t) {
+    SimState* state = new SimState;
+    init_state(state, t);
+    mSimStateList.push_back(state);
+  }
+
+  // 各スレッドが同じ数のブロックを処理するので
+  // 結果はスレッド数と乱数の種のみで決まる．
+  ymuint nt = mThreadNum;
+  ymuint64 round_pattern = static_cast<ymuint64>(nt) * kRoundBlocks * kBlockWords * 64;
+  mPatternNum = 0;
+  for ( ; ; ) {
+    run_sim(kRoundBlocks);
+    mPatternNum += round_pattern;
+
+    double error = gather_sim();
+    if ( error <= mMaxError || mPatternNum >= mMaxPattern ) {
+      break;
+    }
+  }
+
+  mLastMode = kModeSim;
+  mAllDirty = false;
+  mChanged.assign(mChanged.size(), false);
+}
+
+// @brief 局所カットの BDD を用いて解析的に求める．
+void
+SigProbEngine::analyze()
+{
+  mAllDirty = true;
+  analyze_marked();
+}
+
+// @brief 前回と同じ方法で計算し直す．
+void
+SigProbEngine::update()
+{
+  switch ( mLastMode ) {
+  case kModeSim:
+    if ( mStructDirty ) {
+      levelize();
+    }
+    if ( mAllDirty ) {
+      simulate();
+    }
+    else {
+      vector<bool> mark;
+      if ( mark_tfo(mark) ) {
+	update_sim(mark);
+      }
+      mChanged.assign(mChanged.size(), false);
+    }
+    break;
+
+  case kModeAnalyze:
+    analyze_marked();
+    break;
+
+  default:
+    analyze();
+    break;
+  }
+}
+
+// @brief レベル分けを行う．
+void
+SigProbEngine::levelize()
+{
+  ymuint n = mNodeArray.size();
+  vector<vector<ymuint32> > fanout_list(n);
+  vector<ymuint32> ref_count(n, 0);
+  vector<ymuint32> queue;
+  queue.reserve(n);
+  mLevelList.clear();
+  mLevelList.push_back(vector<ymuint32>());
+  for (ymuint id = 0; id < n; ++ id) {
+    Node& node = mNodeArray[id];
+    node.mLevel = 0;
+    if ( node.mType == kInput ) {
+      mLevelList[0].push_back(id);
+      queue.push_back(id);
+    }
+    else if ( node.mType == kLogic ) {
+      for (vector<ymuint32>::iterator p = node.mFaninList.begin();
+	   p != node.mFaninList.end(); ++ p) {
+	ASSERT_COND( mNodeArray[*p].mType != kNone );
+	fanout_list[*p].push_back(id);
+      }
+      ref_count[id] = node.mFaninList.size();
+      if ( ref_count[id] == 0 ) {
+	// 定数ノード
+	node.mLevel = 1;
+	queue.push_back(id);
+      }
+    }
+  }
+
+  for (ymuint rpos = 0; rpos < queue.size(); ++ rpos) {
+    ymuint id = queue[rpos];
+    ymuint level = mNodeArray[id].mLevel;
+    if ( level > 0 ) {
+      if ( mLevelList.size() <= level ) {
+	mLevelList.resize(level + 1);
+      }
+      mLevelList[level].push_back(id);
+    }
+    for (vector<ymuint32>::iterator p = fanout_list[id].begin();
+	 p != fanout_list[id].end(); ++ p) {
+      Node& onode = mNodeArray[*p];
+      if ( onode.mLevel < level + 1 ) {
+	onode.mLevel = level + 1;
+      }
+      -- ref_count[*p];
+      if ( ref_count[*p] == 0 ) {
+	queue.push_back(*p);
+      }
+    }
+  }
+
+  mStructDirty = false;
+}
+
+// @brief 変更されたノードの推移的ファンアウトを求める．
+// @param[out] mark 対象のノードに true を立てる配列
+// @return 対象のノードがあれば true を返す．
+bool
+SigProbEngine::mark_tfo(vector<bool>& mark) const
+{
+  mark.clear();
+  mark.resize(mNodeArray.size(), mAllDirty);
+  if ( mAllDirty ) {
+    return true;
+  }
+
+  bool found = false;
+  for (vector<vector<ymuint32> >::const_iterator p = mLevelList.begin();
+       p != mLevelList.end(); ++ p) {
+    const vector<ymuint32>& node_list = *p;
+    for (vector<ymuint32>::const_iterator q = node_list.begin();
+	 q != node_list.end(); ++ q) {
+      ymuint id = *q;
+      bool changed = mChanged[id];
+      const vector<ymuint32>& fanin_list = mNodeArray[id].mFaninList;
+      for (vector<ymuint32>::const_iterator r = fanin_list.begin();
+	   !changed && r != fanin_list.end(); ++ r) {
+	changed = mark[*r];
+      }
+      if ( changed ) {
+	mark[id] = true;
+	found = true;
+      }
+    }
+  }
+  return found;
+}
+
+// @brief 入力の遷移確率を求める．
+void
+SigProbEngine::init_sim_param()
+{
+  ymuint n = mNodeArray.size();
+  mProbThr.clear();
+  mProbThr.resize(n, 0);
+  mRiseThr.clear();
+  mRiseThr.resize(n, 0);
+  mFallThr.clear();
+  mFallThr.resize(n, 0);
+  const vector<ymuint32>& input_list = mLevelList[0];
+  for (vector<ymuint32>::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    ymuint id = *p;
+    double prob;
+    double toggle;
+    input_param(id, prob, toggle);
+    mProbThr[id] = prob_to_thr(prob);
+    if ( prob < 1.0 ) {
+      mRiseThr[id] = prob_to_thr(toggle / (2.0 * (1.0 - prob)));
+    }
+    if ( prob > 0.0 ) {
+      mFallThr[id] = prob_to_thr(toggle / (2.0 * prob));
+    }
+  }
+}
+
+// @brief スレッドの状態を初期化する．
+// @param[in] state スレッドの状態
+// @param[in] thread_id スレッド番号
+void
+SigProbEngine::init_state(SimState* state,
+			  ymuint thread_id)
+{
+  ymuint n = mNodeArray.size();
+  state->mRandState.resize(n, 0ULL);
+  state->mVal.resize(n * kBlockWords, 0ULL);
+  state->mLast.resize(n, 0ULL);
+  state->mOneCount.resize(n * kGroupNum, 0ULL);
+  state->mToggleCount.resize(n * kGroupNum, 0ULL);
+
+  // 乱数の状態は種とスレッド番号とノード番号のみで決める．
+  // 最初の時刻の値は定常分布に従って作る．
+  ymuint64 seed = mix_seed(mix_seed(mSeed) + thread_id);
+  const vector<ymuint32>& input_list = mSimList[0];
+  for (vector<ymuint32>::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    ymuint id = *p;
+    ymuint64 rand_state = mix_seed(seed + id);
+    if ( rand_state == 0ULL ) {
+      rand_state = 1ULL;
+    }
+    state->mLast[id] = rand_word(rand_state, mProbThr[id]);
+    state->mRandState[id] = rand_state;
+  }
+  for (ymuint level = 1; level < mSimList.size(); ++ level) {
+    const vector<ymuint32>& node_list = mSimList[level];
+    for (vector<ymuint32>::const_iterator p = node_list.begin();
+	 p != node_list.end(); ++ p) {
+      eval_node(state, *p, &state->mLast[0], 1);
+    }
+  }
+
+  for (vector<ymuint32>::const_iterator p = mCountList.begin();
+       p != mCountList.end(); ++ p) {
+    ymuint64* one_count = &state->mOneCount[*p * kGroupNum];
+    ymuint64* toggle_count = &state->mToggleCount[*p * kGroupNum];
+    for (ymuint g = 0; g < kGroupNum; ++ g) {
+      one_count[g] = 0ULL;
+      toggle_count[g] = 0ULL;
+    }
+  }
+}
+
+// @brief 全スレッドでシミュレーションを行う．
+// @param[in] block_num スレッドごとのブロック数
+void
+SigProbEngine::run_sim(ymuint block_num)
+{
+  ymuint nt = mSimStateList.size();
+  if ( nt == 1 ) {
+    sim_blocks(mSimStateList[0], block_num);
+    return;
+  }
+
+  vector<std::thread> thread_list;
+  thread_list.reserve(nt - 1);
+  for (ymuint t = 1; t < nt; ++ t) {
+    thread_list.push_back(std::thread(&SigProbEngine::sim_blocks, this,
+				      mSimStateList[t], block_num));
+  }
+  sim_blocks(mSimStateList[0], block_num);
+  for (ymuint t = 0; t < nt - 1; ++ t) {
+    thread_list[t].join();
+  }
+}
+
+// @brief 変更のあったノードの推移的ファンアウトをシミュレーションし直す．
+// @param[in] mark 対象のノードに true を立てた配列
+void
+SigProbEngine::update_sim(const vector<bool>& mark)
+{
+  ASSERT_COND( mark.size() == mNodeArray.size() );
+
+  // 対象のノードの値を求めるには推移的ファンインの値も必要となる．
+  vector<bool> need(mark);
+  for (ymuint level = mLevelList.size(); level -- > 1; ) {
+    const vector<ymuint32>& node_list = mLevelList[level];
+    for (vector<ymuint32>::const_iterator p = node_list.begin();
+	 p != node_list.end(); ++ p) {
+      if ( need[*p] ) {
+	const vector<ymuint32>& fanin_list = mNodeArray[*p].mFaninList;
+	for (vector<ymuint32>::const_iterator q = fanin_list.begin();
+	     q != fanin_list.end(); ++ q) {
+	  need[*q] = true;
+	}
+      }
+    }
+  }
+
+  mSimList.clear();
+  mSimList.resize(mLevelList.size());
+  mCountList.clear();
+  for (ymuint level = 0; level < mLevelList.size(); ++ level) {
+    const vector<ymuint32>& node_list = mLevelList[level];
+    for (vector<ymuint32>::const_iterator p = node_list.begin();
+	 p != node_list.end(); ++ p) {
+      ymuint id = *p;
+      if ( need[id] ) {
+	mSimList[level].push_back(id);
+      }
+      if ( mark[id] ) {
+	mCountList.push_back(id);
+      }
+    }
+  }
+
+  // 入力ごとの乱数列は他のノードによらないので，
+  // 同じパタン数をシミュレーションすれば前回と同じパタンとなる．
+  init_sim_param();
+  for (ymuint t = 0; t < mSimStateList.size(); ++ t) {
+    init_state(mSimStateList[t], t);
+  }
+  ymuint64 block_pattern = static_cast<ymuint64>(mSimStateList.size()) * kBlockWords * 64;
+  run_sim(mPatternNum / block_pattern);
+  gather_sim();
+}
+
+// @brief 1つのスレッドのシミュレーションを行う．
+// @param[in] state スレッドの状態
+// @param[in] block_num ブロック数
+void
+SigProbEngine::sim_blocks(SimState* state,
+			  ymuint block_num)
+{
+  ymuint64* val_top = &state->mVal[0];
+  for (ymuint b = 0; b < block_num; ++ b) {
+    const vector<ymuint32>& input_list = mSimList[0];
+    for (vector<ymuint32>::const_iterator p = input_list.begin();
+	 p != input_list.end(); ++ p) {
+      ymuint id = *p;
+      ymuint64* dst = val_top + id * kBlockWords;
+      ymuint64 prev = state->mLast[id];
+      ymuint64& rand_state = state->mRandState[id];
+      for (ymuint w = 0; w < kBlockWords; ++ w) {
+	prev = input_word(rand_state, id, prev);
+	dst[w] = prev;
+      }
+    }
+
+    for (ymuint level = 1; level < mSimList.size(); ++ level) {
+      const vector<ymuint32>& node_list = mSimList[level];
+      for (vector<ymuint32>::const_iterator p = node_list.begin();
+	   p != node_list.end(); ++ p) {
+	eval_node(state, *p, val_top, kBlockWords);
+      }
+    }
+
+    // グループごとに 1 の数と直前の時刻から変化した数を数える．
+    for (vector<ymuint32>::const_iterator p = mCountList.begin();
+	 p != mCountList.end(); ++ p) {
+      ymuint id = *p;
+      const ymuint64* src = val_top + id * kBlockWords;
+      ymuint64 prev = state->mLast[id];
+      ymuint64 one_acc0 = 0ULL;
+      ymuint64 one_acc1 = 0ULL;
+      ymuint64 toggle_acc0 = 0ULL;
+      ymuint64 toggle_acc1 = 0ULL;
+      for (ymuint w = 0; w < kBlockWords; ++ w) {
+	ymuint64 cur = src[w];
+	add_group_count(cur, one_acc0, one_acc1);
+	add_group_count(cur ^ prev, toggle_acc0, toggle_acc1);
+	prev = cur;
+      }
+      put_group_count(one_acc0, one_acc1, &state->mOneCount[id * kGroupNum]);
+      put_group_count(toggle_acc0, toggle_acc1, &state->mToggleCount[id * kGroupNum]);
+    }
+
+    // 集計しないノードも次のブロックのために最後の値を覚えておく．
+    for (vector<vector<ymuint32> >::const_iterator p = mSimList.begin();
+	 p != mSimList.end(); ++ p) {
+      const vector<ymuint32>& node_list = *p;
+      for (vector<ymuint32>::const_iterator q = node_list.begin();
+	   q != node_list.end(); ++ q) {
+	ymuint id = *q;
+	state->mLast[id] = val_top[id * kBlockWords + kBlockWords - 1];
+      }
+    }
+  }
+}
+
+// @brief 入力の1ワード分の値を作る．
+// @param[in] rand_state 入力の乱数の状態
+// @param[in] id 入力ノードのノード番号
+// @param[in] prev 直前の時刻の値
+ymuint64
+SigProbEngine::input_word(ymuint64& rand_state,
+			  ymuint id,
+			  ymuint64 prev) const
+{
+  ymuint64 rise = rand_word(rand_state, mRiseThr[id]);
+  ymuint64 fall = rand_word(rand_state, mFallThr[id]);
+  return (prev & ~fall) | (~prev & rise);
+}
+
+// @brief 論理ノードの値を計算する．
+// @param[in] state スレッドの状態
+// @param[in] id ノード番号
+// @param[in] val_top 値の配列
+// @param[in] wn ワード数
+void
+SigProbEngine::eval_node(SimState* state,
+			 ymuint id,
+			 ymuint64* val_top,
+			 ymuint wn)
+{
+  const Node& node = mNodeArray[id];
+  ymuint ni = node.mFaninList.size();
+  vector<ymuint64>& fanin_val = state->mFaninVal;
+  if ( fanin_val.size() < ni * wn ) {
+    fanin_val.resize(ni * wn);
+  }
+  for (ymuint i = 0; i < ni; ++ i) {
+    const ymuint64* src = val_top + node.mFaninList[i] * wn;
+    ymuint64* dst = &fanin_val[i * wn];
+    for (ymuint w = 0; w < wn; ++ w) {
+      dst[w] = src[w];
+    }
+  }
+  const ymuint64* vals = fanin_val.empty() ? nullptr : &fanin_val[0];
+  node.mCode.eval(vals, wn, val_top + id * wn, state->mWork);
+}
+
+// @brief mCountList のノードのシミュレーション結果を集計する．
+// @return 信頼区間の半幅の最大値を返す．
+//
+// 同じレーンの値は時間的に相関しているので，パタンを独立な標本とみなすと
+// 信頼区間を過小に見積もることになる．
+// レーンのグループ(スレッドごとに kGroupNum 個)は互いに独立なので，
+// グループごとの平均のばらつきから信頼区間を求める．
+// ただし，独立な標本とみなした場合の値より小さくはしない．
+double
+SigProbEngine::gather_sim()
+{
+  ymuint nt = mSimStateList.size();
+  ymuint ng = nt * kGroupNum;
+  double n = static_cast<double>(mPatternNum);
+  double m = n / ng;
+  vector<ymuint64> one_list(ng);
+  vector<ymuint64> toggle_list(ng);
+  double max_error = 0.0;
+  for (vector<ymuint32>::const_iterator p = mCountList.begin();
+       p != mCountList.end(); ++ p) {
+    ymuint id = *p;
+    ymuint64 one_count = 0;
+    ymuint64 toggle_count = 0;
+    for (ymuint t = 0; t < nt; ++ t) {
+      const SimState* state = mSimStateList[t];
+      for (ymuint g = 0; g < kGroupNum; ++ g) {
+	ymuint64 c1 = state->mOneCount[id * kGroupNum + g];
+	ymuint64 c2 = state->mToggleCount[id * kGroupNum + g];
+	one_list[t * kGroupNum + g] = c1;
+	toggle_list[t * kGroupNum + g] = c2;
+	one_count += c1;
+	toggle_count += c2;
+      }
+    }
+    double prob = one_count / n;
+    double toggle = toggle_count / n;
+    mProb[id] = prob;
+    mToggle[id] = toggle;
+    mProbError[id] = std::max(group_half(one_list, m, prob), ci_half(prob, n));
+    mToggleError[id] = std::max(group_half(toggle_list, m, toggle), ci_half(toggle, n));
+    if ( max_error < mProbError[id] ) {
+      max_error = mProbError[id];
+    }
+    if ( max_error < mToggleError[id] ) {
+      max_error = mToggleError[id];
+    }
+  }
+  return max_error;
+}
+
+// @brief 変更のあったノードの推移的ファンアウトを解析する．
+void
+SigProbEngine::analyze_marked()
+{
+  if ( mStructDirty ) {
+    levelize();
+  }
+
+  // 直前の結果がシミュレーションの場合はすべて計算し直す．
+  if ( mLastMode != kModeAnalyze ) {
+    mAllDirty = true;
+  }
+
+  vector<bool> mark;
+  if ( mark_tfo(mark) ) {
+    if ( mBddMgrList.empty() ) {
+      for (ymuint t = 0; t < mThreadNum; ++ t) {
+	ostringstream buf;
+	buf << "sigprob#" << t;
+	mBddMgrList.push_back(new BddMgr("bmc", buf.str()));
+      }
+    }
+
+    // レベルごとに変更のあったノードを並列に処理する．
+    vector<ymuint32> node_list;
+    for (vector<vector<ymuint32> >::const_iterator p = mLevelList.begin();
+	 p != mLevelList.end(); ++ p) {
+      const vector<ymuint32>& level_list = *p;
+      node_list.clear();
+      for (vector<ymuint32>::const_iterator q = level_list.begin();
+	   q != level_list.end(); ++ q) {
+	if ( mark[*q] ) {
+	  node_list.push_back(*q);
+	}
+      }
+      analyze_list(node_list);
+    }
+  }
+
+  mPatternNum = 0;
+  mLastMode = kModeAnalyze;
+  mAllDirty = false;
+  mChanged.assign(mChanged.size(), false);
+}
+
+// @brief ノードのリストを並列に解析する．
+// @param[in] node_list ノードのリスト
+void
+SigProbEngine::analyze_list(const vector<ymuint32>& node_list)
+{
+  ymuint n = node_list.size();
+  if ( mThreadNum <= 1 || n < kParallelThreshold ) {
+    analyze_range(&node_list, 0, n, mBddMgrList[0]);
+    return;
+  }
+
+  ymuint nt = mThreadNum;
+  vector<std::thread> thread_list;
+  thread_list.reserve(nt - 1);
+  for (ymuint t = 1; t < nt; ++ t) {
+    ymuint begin = n * t / nt;
+    ymuint end = n * (t + 1) / nt;
+    thread_list.push_back(std::thread(&SigProbEngine::analyze_range, this,
+				      &node_list, begin, end, mBddMgrList[t]));
+  }
+  analyze_range(&node_list, 0, n / nt, mBddMgrList[0]);
+  for (ymuint t = 0; t < nt - 1; ++ t) {
+    thread_list[t].join();
+  }
+}
+
+// @brief ノードのリストの一部を解析する．
+// @param[in] node_list ノードのリスト
+// @param[in] begin 開始位置
+// @param[in] end 終了位置
+// @param[in] mgr 用いる BddMgr
+void
+SigProbEngine::analyze_range(const vector<ymuint32>* node_list,
+			     ymuint begin,
+			     ymuint end,
+			     BddMgr* mgr)
+{
+  for (ymuint i = begin; i < end; ++ i) {
+    analyze_node((*node_list)[i], *mgr);
+  }
+}
+
+// @brief 1つのノードを解析する．
+// @param[in] id ノード番号
+// @param[in] mgr 用いる BddMgr
+void
+SigProbEngine::analyze_node(ymuint id,
+			    BddMgr& mgr)
+{
+  mProbError[id] = 0.0;
+  mToggleError[id] = 0.0;
+
+  const Node& node = mNodeArray[id];
+  if ( node.mType == kInput ) {
+    input_param(id, mProb[id], mToggle[id]);
+    return;
+  }
+
+  vector<ymuint32> leaf_list;
+  vector<ymuint32> cone_list;
+  find_cut(id, leaf_list, cone_list);
+
+  // 葉の現時刻の値を変数 2i とし，カット内の関数を根に向かって作る．
+  ymuint nl = leaf_list.size();
+  vector<ymuint32> id_list(leaf_list);
+  id_list.insert(id_list.end(), cone_list.begin(), cone_list.end());
+  vector<Bdd> func_list;
+  func_list.reserve(id_list.size());
+  vector<double> prob_list(nl);
+  vector<double> rise_list(nl, 0.0);
+  vector<double> fall_list(nl, 0.0);
+  HashMap<VarId, VarId> next_map;
+  for (ymuint i = 0; i < nl; ++ i) {
+    ymuint leaf = leaf_list[i];
+    func_list.push_back(mgr.make_posiliteral(VarId(i * 2)));
+    next_map.add(VarId(i * 2), VarId(i * 2 + 1));
+
+    // 葉の値は前の段の結果を用いる．
+    double prob = mProb[leaf];
+    double toggle = mToggle[leaf];
+    prob_list[i] = prob;
+    if ( prob < 1.0 ) {
+      rise_list[i] = toggle / (2.0 * (1.0 - prob));
+      if ( rise_list[i] > 1.0 ) {
+	rise_list[i] = 1.0;
+      }
+    }
+    if ( prob > 0.0 ) {
+      fall_list[i] = toggle / (2.0 * prob);
+      if ( fall_list[i] > 1.0 ) {
+	fall_list[i] = 1.0;
+      }
+    }
+  }
+  for (vector<ymuint32>::iterator p = cone_list.begin();
+       p != cone_list.end(); ++ p) {
+    const Node& cnode = mNodeArray[*p];
+    ymuint ni = cnode.mFaninList.size();
+    vector<Bdd> input_list(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      ymuint fanin = cnode.mFaninList[i];
+      ymuint pos = 0;
+      while ( id_list[pos] != fanin ) {
+	++ pos;
+      }
+      ASSERT_COND( pos < func_list.size() );
+      input_list[i] = func_list[pos];
+    }
+    func_list.push_back(expr_to_bdd(mgr, cnode.mFunc, input_list));
+  }
+  Bdd f = func_list.back();
+
+  ProbCalc calc(prob_list, rise_list, fall_list);
+  mProb[id] = calc.prob(f);
+
+  // 次の時刻の関数との排他的論理和が 1 となる確率がトグル率となる．
+  Bdd next_f = f.remap_var(next_map);
+  mToggle[id] = calc.pair_prob(f ^ next_f);
+}
+
+// @brief 局所カットを求める．
+// @param[in] id 根のノード番号
+// @param[out] leaf_list 葉のノード番号のリスト
+// @param[out] cone_list カット内のノード番号のリスト
+void
+SigProbEngine::find_cut(ymuint id,
+			vector<ymuint32>& leaf_list,
+			vector<ymuint32>& cone_list) const
+{
+  leaf_list.clear();
+  cone_list.clear();
+  cone_list.push_back(id);
+  const vector<ymuint32>& fanin_list = mNodeArray[id].mFaninList;
+  for (vector<ymuint32>::const_iterator p = fanin_list.begin();
+       p != fanin_list.end(); ++ p) {
+    if ( !contains(leaf_list, *p) ) {
+      leaf_list.push_back(*p);
+    }
+  }
+
+  // 新たに加わる葉の数が少なく，レベルの高い葉から順に展開する．
+  // 新たな葉が増えない展開はカット内の再収斂を取り込むことになる．
+  while ( cone_list.size() < mConeSize ) {
+    ymuint best_pos = leaf_list.size();
+    ymuint best_cost = 0;
+    ymuint best_level = 0;
+    for (ymuint pos = 0; pos < leaf_list.size(); ++ pos) {
+      const Node& leaf = mNodeArray[leaf_list[pos]];
+      if ( leaf.mType != kLogic ) {
+	continue;
+      }
+      ymuint cost = 0;
+      const vector<ymuint32>& fanin_list1 = leaf.mFaninList;
+      for (ymuint i = 0; i < fanin_list1.size(); ++ i) {
+	ymuint32 fanin = fanin_list1[i];
+	bool found = contains(leaf_list, fanin) || contains(cone_list, fanin);
+	for (ymuint j = 0; !found && j < i; ++ j) {
+	  found = (fanin_list1[j] == fanin);
+	}
+	if ( !found ) {
+	  ++ cost;
+	}
+      }
+      if ( leaf_list.size() - 1 + cost > mCutSize ) {
+	continue;
+      }
+      if ( best_pos == leaf_list.size() ||
+	   best_cost > cost ||
+	   (best_cost == cost && best_level < leaf.mLevel) ) {
+	best_pos = pos;
+	best_cost = cost;
+	best_level = leaf.mLevel;
+      }
+    }
+    if ( best_pos == leaf_list.size() ) {
+      break;
+    }
+
+    ymuint32 expand_id = leaf_list[best_pos];
+    leaf_list.erase(leaf_list.begin() + best_pos);
+    cone_list.push_back(expand_id);
+    const vector<ymuint32>& fanin_list1 = mNodeArray[expand_id].mFaninList;
+    for (vector<ymuint32>::const_iterator p = fanin_list1.begin();
+	 p != fanin_list1.end(); ++ p) {
+      if ( !contains(leaf_list, *p) && !contains(cone_list, *p) ) {
+	leaf_list.push_back(*p);
+      }
+    }
+  }
+
+  // ファンインが先に来るようにレベルの低い順に並べる．
+  vector<pair<ymuint32, ymuint32> > tmp_list;
+  tmp_list.reserve(cone_list.size());
+  for (vector<ymuint32>::iterator p = cone_list.begin();
+       p != cone_list.end(); ++ p) {
+    tmp_list.push_back(make_pair(mNodeArray[*p].mLevel, *p));
+  }
+  std::sort(tmp_list.begin(), tmp_list.end());
+  for (ymuint i = 0; i < tmp_list.size(); ++ i) {
+    cone_list[i] = tmp_list[i].second;
+  }
+}
+
+// @brief 入力の信号確率とトグル率を丸めて返す．
+// @param[in] id 入力ノードのノード番号
+// @param[out] prob 信号確率
+// @param[out] toggle トグル率
+void
+SigProbEngine::input_param(ymuint id,
+			   double& prob,
+			   double& toggle) const
+{
+  prob = mInputProb[id];
+  if ( prob < 0.0 ) {
+    prob = 0.0;
+  }
+  if ( prob > 1.0 ) {
+    prob = 1.0;
+  }
+  double max_toggle = 2.0 * (prob < 0.5 ? prob : 1.0 - prob);
+  toggle = mInputToggle[id];
+  if ( toggle < 0.0 ) {
+    toggle = 0.0;
+  }
+  if ( toggle > max_toggle ) {
+    toggle = max_toggle;
+  }
+}
+
+END_NAMESPACE_YM_NETWORKS
@@ -0,0 +1,515 @@
+﻿#ifndef SIGPROBENGINE_H
+#define SIGPROBENGINE_H
+
+/// @file SigProbEngine.h
+/// @brief SigProbEngine のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmNetworks/networks_nsdef.h"
+#include "YmLogic/Expr.h"
+#include "YmLogic/ExprCode.h"
+#include "YmLogic/Bdd.h"
+#include "YmLogic/BddMgr.h"
+
+
+BEGIN_NAMESPACE_YM_NETWORKS
+
+//////////////////////////////////////////////////////////////////////
+/// @class SigProbEngine SigProbEngine.h "SigProbEngine.h"
+/// @brief 信号確率とトグル率の計算を行うクラス
+///
+/// BdnSigProb と CmnSigProb の共通の実装で，ノード番号をキーにした
+/// 抽象的なネットワークを対象とする．
+/// 各ノードは入力ノードか論理ノードで，論理ノードの関数は
+/// ファンイン番号を変数番号とする論理式で表す．
+///
+/// トグル率は1サイクルあたりに値が変化する確率で，
+/// 入力ノードは1次のマルコフ連鎖に従って変化するものとみなす．
+/// - simulate() は 64 ビット並列のモンテカルロシミュレーションを行う．
+///   各ビットが独立なマルコフ連鎖となり，連続するワードが
+///   連続する時刻の値となる．
+///   同じビットの値は時間的に相関しているので，4ビットずつのグループを
+///   独立な標本とみなし，グループ間のばらつきから信頼区間を求める．
+///   入力ごとに独立な乱数列を用いるので，ある入力の値は
+///   他のノードの変更の影響を受けない．
+/// - analyze() は各ノードについて葉の数が制限された局所的なカットを求め，
+///   カット内の関数を BDD で表して確率を求める．
+///   カットの葉どうしは独立とみなすので，カット内の再収斂は正確に扱われるが
+///   カットの外の再収斂による相関は無視される．
+///
+/// どちらも計算をスレッドに分担させることができる．
+/// update() は前回の計算以降に変更されたノードの推移的ファンアウト
+/// のみを計算し直す．simulate() の後では前回と同じパタンで
+/// シミュレーションし直すので，それ以外のノードの結果は変わらない．
+//////////////////////////////////////////////////////////////////////
+class SigProbEngine
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] thread_num 計算に用いるスレッド数
+  explicit
+  SigProbEngine(ymuint thread_num = 1);
+
+  /// @brief デストラクタ
+  ~SigProbEngine();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // ネットワークの設定
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノード番号の最大値 + 1 を設定する．
+  /// @param[in] node_num ノード番号の最大値 + 1
+  /// @note 既存のノードの情報は保持される．
+  void
+  resize(ymuint node_num);
+
+  /// @brief ノードを削除する．
+  /// @param[in] id ノード番号
+  void
+  set_none(ymuint id);
+
+  /// @brief 入力ノードを設定する．
+  /// @param[in] id ノード番号
+  void
+  set_input(ymuint id);
+
+  /// @brief 論理ノードを設定する．
+  /// @param[in] id ノード番号
+  /// @param[in] fanin_list ファンインのノード番号のリスト
+  /// @param[in] func 関数を表す論理式
+  /// @note func の変数番号は fanin_list 中の位置を表す．
+  void
+  set_logic(ymuint id,
+	    const vector<ymuint>& fanin_list,
+	    const Expr& func);
+
+  /// @brief 入力の信号確率とトグル率を設定する．
+  /// @param[in] id 入力ノードのノード番号
+  /// @param[in] prob 値が 1 となる確率
+  /// @param[in] toggle トグル率
+  /// @note toggle は 2 * min(prob, 1 - prob) 以下に丸められる．
+  void
+  set_input_prob(ymuint id,
+		 double prob,
+		 double toggle);
+
+  /// @brief モンテカルロシミュレーションのパラメータを設定する．
+  /// @param[in] max_pattern パタン数の上限
+  /// @param[in] max_error 95% 信頼区間の半幅の目標値
+  /// @param[in] seed 乱数の種
+  void
+  set_mc_param(ymuint64 max_pattern,
+	       double max_error,
+	       ymuint32 seed);
+
+  /// @brief 局所カットのパラメータを設定する．
+  /// @param[in] cut_size カットの葉の数の上限
+  /// @param[in] cone_size カット内のノード数の上限
+  void
+  set_cut_param(ymuint cut_size,
+		ymuint cone_size);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 計算と結果の取得
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モンテカルロシミュレーションで求める．
+  void
+  simulate();
+
+  /// @brief 局所カットの BDD を用いて解析的に求める．
+  void
+  analyze();
+
+  /// @brief 前回と同じ方法で計算し直す．
+  /// @note 一度も計算していない場合には analyze() を行う．
+  /// @note simulate() の後ではパタン数は前回と同じとなる．
+  void
+  update();
+
+  /// @brief 結果がモンテカルロシミュレーションによるものの時 true を返す．
+  bool
+  is_simulated() const;
+
+  /// @brief シミュレーションしたパタン数を返す．
+  ymuint64
+  pattern_num() const;
+
+  /// @brief 信号確率を返す．
+  /// @param[in] id ノード番号
+  double
+  prob(ymuint id) const;
+
+  /// @brief トグル率を返す．
+  /// @param[in] id ノード番号
+  double
+  toggle(ymuint id) const;
+
+  /// @brief 信号確率の 95% 信頼区間の半幅を返す．
+  /// @param[in] id ノード番号
+  /// @note analyze() の結果の場合は 0 を返す．
+  double
+  prob_error(ymuint id) const;
+
+  /// @brief トグル率の 95% 信頼区間の半幅を返す．
+  /// @param[in] id ノード番号
+  /// @note analyze() の結果の場合は 0 を返す．
+  double
+  toggle_error(ymuint id) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードの種類
+  enum tType {
+    kNone,
+    kInput,
+    kLogic
+  };
+
+  // 計算方法
+  enum tMode {
+    kModeNone,
+    kModeSim,
+    kModeAnalyze
+  };
+
+  // ノードの情報
+  struct Node
+  {
+    // 種類
+    ymuint8 mType;
+
+    // ファンインのノード番号のリスト
+    vector<ymuint32> mFaninList;
+
+    // 関数
+    Expr mFunc;
+
+    // シミュレーション用に変換した関数
+    ExprCode mCode;
+
+    // レベル
+    ymuint32 mLevel;
+  };
+
+  // スレッドごとのシミュレーションの状態
+  struct SimState
+  {
+    // 入力ごとの乱数の状態
+    // キーはノード番号
+    vector<ymuint64> mRandState;
+
+    // ブロック内の値
+    // キーはノード番号 x ブロックのワード数 + ワード位置
+    vector<ymuint64> mVal;
+
+    // 直前のブロックの最後のワード
+    // キーはノード番号
+    vector<ymuint64> mLast;
+
+    // レーンのグループごとの 1 となったビット数
+    // キーはノード番号 x グループ数 + グループ番号
+    vector<ymuint64> mOneCount;
+
+    // レーンのグループごとの値が変化したビット数
+    // キーはノード番号 x グループ数 + グループ番号
+    vector<ymuint64> mToggleCount;
+
+    // ファンインの値を集める作業領域
+    vector<ymuint64> mFaninVal;
+
+    // ExprCode::eval() の中間結果用の作業領域
+    vector<ymuint64> mWork;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief レベル分けを行う．
+  void
+  levelize();
+
+  /// @brief 変更されたノードの推移的ファンアウトを求める．
+  /// @param[out] mark 対象のノードに true を立てる配列
+  /// @return 対象のノードがあれば true を返す．
+  bool
+  mark_tfo(vector<bool>& mark) const;
+
+  /// @brief 入力の遷移確率を求める．
+  void
+  init_sim_param();
+
+  /// @brief スレッドの状態を初期化する．
+  /// @param[in] state スレッドの状態
+  /// @param[in] thread_id スレッド番号
+  /// @note mSimList のノードの乱数と初期値を作り直し，
+  /// mCountList のノードの集計値をクリアする．
+  void
+  init_state(SimState* state,
+	     ymuint thread_id);
+
+  /// @brief 全スレッドでシミュレーションを行う．
+  /// @param[in] block_num スレッドごとのブロック数
+  void
+  run_sim(ymuint block_num);
+
+  /// @brief 変更のあったノードの推移的ファンアウトをシミュレーションし直す．
+  /// @param[in] mark 対象のノードに true を立てた配列
+  void
+  update_sim(const vector<bool>& mark);
+
+  /// @brief 1つのスレッドのシミュレーションを行う．
+  /// @param[in] state スレッドの状態
+  /// @param[in] block_num ブロック数
+  void
+  sim_blocks(SimState* state,
+	     ymuint block_num);
+
+  /// @brief 入力の1ワード分の値を作る．
+  /// @param[in] rand_state 入力の乱数の状態
+  /// @param[in] id 入力ノードのノード番号
+  /// @param[in] prev 直前の時刻の値
+  ymuint64
+  input_word(ymuint64& rand_state,
+	     ymuint id,
+	     ymuint64 prev) const;
+
+  /// @brief 論理ノードの値を計算する．
+  /// @param[in] state スレッドの状態
+  /// @param[in] id ノード番号
+  /// @param[in] val_top 値の配列
+  /// @param[in] wn ワード数
+  /// @note val_top はノード番号 x wn + ワード位置 で参照される．
+  void
+  eval_node(SimState* state,
+	    ymuint id,
+	    ymuint64* val_top,
+	    ymuint wn);
+
+  /// @brief mCountList のノードのシミュレーション結果を集計する．
+  /// @return 信頼区間の半幅の最大値を返す．
+  double
+  gather_sim();
+
+  /// @brief 変更のあったノードの推移的ファンアウトを解析する．
+  void
+  analyze_marked();
+
+  /// @brief ノードのリストを並列に解析する．
+  /// @param[in] node_list ノードのリスト
+  void
+  analyze_list(const vector<ymuint32>& node_list);
+
+  /// @brief ノードのリストの一部を解析する．
+  /// @param[in] node_list ノードのリスト
+  /// @param[in] begin 開始位置
+  /// @param[in] end 終了位置
+  /// @param[in] mgr 用いる BddMgr
+  void
+  analyze_range(const vector<ymuint32>* node_list,
+		ymuint begin,
+		ymuint end,
+		BddMgr* mgr);
+
+  /// @brief 1つのノードを解析する．
+  /// @param[in] id ノード番号
+  /// @param[in] mgr 用いる BddMgr
+  void
+  analyze_node(ymuint id,
+	       BddMgr& mgr);
+
+  /// @brief 局所カットを求める．
+  /// @param[in] id 根のノード番号
+  /// @param[out] leaf_list 葉のノード番号のリスト
+  /// @param[out] cone_list カット内のノード番号のリスト
+  /// @note cone_list はレベルの低い順に並ぶ．末尾は id となる．
+  void
+  find_cut(ymuint id,
+	   vector<ymuint32>& leaf_list,
+	   vector<ymuint32>& cone_list) const;
+
+  /// @brief 入力の信号確率とトグル率を丸めて返す．
+  /// @param[in] id 入力ノードのノード番号
+  /// @param[out] prob 信号確率
+  /// @param[out] toggle トグル率
+  void
+  input_param(ymuint id,
+	      double& prob,
+	      double& toggle) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // スレッド数
+  ymuint32 mThreadNum;
+
+  // ノードの配列
+  // キーはノード番号
+  vector<Node> mNodeArray;
+
+  // レベルごとのノードのリスト
+  // 0 番目は入力ノード
+  vector<vector<ymuint32> > mLevelList;
+
+  // mLevelList が正しくない時 true となるフラグ
+  bool mStructDirty;
+
+  // 入力の信号確率
+  // キーはノード番号
+  vector<double> mInputProb;
+
+  // 入力のトグル率
+  // キーはノード番号
+  vector<double> mInputToggle;
+
+  // パタン数の上限
+  ymuint64 mMaxPattern;
+
+  // 信頼区間の半幅の目標値
+  double mMaxError;
+
+  // 乱数の種
+  ymuint32 mSeed;
+
+  // 入力の信号確率
+  // 単位は 1 / 65536 でキーはノード番号
+  vector<ymuint32> mProbThr;
+
+  // 入力が 0 の時に次の時刻に 1 となる確率
+  // 単位は 1 / 65536 でキーはノード番号
+  vector<ymuint32> mRiseThr;
+
+  // 入力が 1 の時に次の時刻に 0 となる確率
+  // 単位は 1 / 65536 でキーはノード番号
+  vector<ymuint32> mFallThr;
+
+  // カットの葉の数の上限
+  ymuint32 mCutSize;
+
+  // カット内のノード数の上限
+  ymuint32 mConeSize;
+
+  // スレッドごとのシミュレーションの状態
+  vector<SimState*> mSimStateList;
+
+  // レベルごとのシミュレーションするノードのリスト
+  // 0 番目は入力ノード
+  vector<vector<ymuint32> > mSimList;
+
+  // シミュレーション結果を集計するノードのリスト
+  vector<ymuint32> mCountList;
+
+  // 解析に用いる BddMgr のリスト
+  // スレッドごとに1つ用いる．
+  vector<BddMgr*> mBddMgrList;
+
+  // 前回の計算方法
+  tMode mLastMode;
+
+  // 変更されたノードに true を立てる配列
+  // キーはノード番号
+  vector<bool> mChanged;
+
+  // すべて計算し直す必要がある時 true となるフラグ
+  bool mAllDirty;
+
+  // シミュレーションしたパタン数
+  ymuint64 mPatternNum;
+
+  // 信号確率
+  // キーはノード番号
+  vector<double> mProb;
+
+  // トグル率
+  // キーはノード番号
+  vector<double> mToggle;
+
+  // 信号確率の信頼区間の半幅
+  // キーはノード番号
+  vector<double> mProbError;
+
+  // トグル率の信頼区間の半幅
+  // キーはノード番号
+  vector<double> mToggleError;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 結果がモンテカルロシミュレーションによるものの時 true を返す．
+inline
+bool
+SigProbEngine::is_simulated() const
+{
+  return mLastMode == kModeSim;
+}
+
+// @brief シミュレーションしたパタン数を返す．
+inline
+ymuint64
+SigProbEngine::pattern_num() const
+{
+  return mPatternNum;
+}
+
+// @brief 信号確率を返す．
+inline
+double
+SigProbEngine::prob(ymuint id) const
+{
+  ASSERT_COND( id < mProb.size() );
+  return mProb[id];
+}
+
+// @brief トグル率を返す．
+inline
+double
+SigProbEngine::toggle(ymuint id) const
+{
+  ASSERT_COND( id < mToggle.size() );
+  return mToggle[id];
+}
+
+// @brief 信号確率の 95% 信頼区間の半幅を返す．
+inline
+double
+SigProbEngine::prob_error(ymuint id) const
+{
+  ASSERT_COND( id < mProbError.size() );
+  return mProbError[id];
+}
+
+// @brief トグル率の 95% 信頼区間の半幅を返す．
+inline
+double
+SigProbEngine::toggle_error(ymuint id) const
+{
+  ASSERT_COND( id < mToggleError.size() );
+  return mToggleError[id];
+}
+
+END_NAMESPACE_YM_NETWORKS
+
+#endif // SIGPROBENGINE_H
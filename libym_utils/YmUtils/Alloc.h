@@ -130,6 +130,33 @@ protected:
   free(ymuint64 n,
        void* blk);
 
+  /// @brief 確保したメモリ量を加算する．
+  /// @param[in] n 確保するメモリ量(単位はバイト)
+  /// @return 確保した総量が制限値を越える時は加算せずに false を返す．
+  ///
+  /// alloc() 以外の方法でメモリを確保する継承クラスが
+  /// allocated_size() などの統計情報を維持するために用いる．
+  bool
+  count_alloc(ymuint64 n);
+
+  /// @brief 確保したメモリ量を減算する．
+  /// @param[in] n 解放するメモリ量(単位はバイト)
+  void
+  count_free(ymuint64 n);
+
+  /// @brief put_memory() で減算した使用中のメモリ量を元に戻す．
+  /// @param[in] n 解放したメモリ量(単位はバイト)
+  ///
+  /// 他のオブジェクトで確保された領域を受け取った継承クラスが
+  /// その領域を確保した側に返す時に用いる．
+  void
+  restore_used_size(ymuint64 n);
+
+  /// @brief put_memory() を経ずに返された領域を使用中のメモリ量から減算する．
+  /// @param[in] n 解放されたメモリ量(単位はバイト)
+  void
+  reduce_used_size(ymuint64 n);
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -80,6 +80,22 @@ HashFunc<ymuint>
 };
 
 
+//////////////////////////////////////////////////////////////////////
+// HashFunc<ymuint64> の特殊化
+//////////////////////////////////////////////////////////////////////
+template<>
+struct
+HashFunc<ymuint64>
+{
+  ymuint
+  operator()(ymuint64 key) const
+  {
+    // 上位の32ビットも反映させる．
+    return static_cast<ymuint>(key ^ (key >> 32));
+  }
+};
+
+
 //////////////////////////////////////////////////////////////////////
 // HashFunc<string> の特殊化
 //////////////////////////////////////////////////////////////////////
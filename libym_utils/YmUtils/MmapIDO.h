@@ -0,0 +1,170 @@
+﻿#ifndef YMUTILS_MMAPIDO_H
+#define YMUTILS_MMAPIDO_H
+
+/// @file YmUtils/MmapIDO.h
+/// @brief MmapIDO のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmUtils/IDO.h"
+#include "YmUtils/FileInfo.h"
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class MmapIDO MmapIDO.h "YmUtils/MmapIDO.h"
+/// @ingroup YmUtils
+/// @brief ファイルをメモリにマップして用いる IDO の継承クラス
+///
+/// ファイル全体をアドレス空間にマップし，読み出し位置を自由に
+/// 移動できる．実際にページが読み込まれるのは参照された時なので
+/// 大きなファイルの一部だけを読む用途に向いている．
+/// mmap が使えない環境ではファイル全体をメモリに読み込む．
+//////////////////////////////////////////////////////////////////////
+class MmapIDO :
+  public IDO
+{
+public:
+
+  /// @brief コンストラクタ
+  MmapIDO();
+
+  /// @brief デストラクタ
+  virtual
+  ~MmapIDO();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // IDO の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み出し可能なら true を返す．
+  virtual
+  bool
+  is_ready() const;
+
+  /// @brief オープン中のファイル情報を得る．
+  virtual
+  const FileInfo&
+  file_info() const;
+
+  /// @brief 現在のファイル情報を書き換える．
+  /// @param[in] file_info 新しいファイル情報
+  /// @note プリプロセッサのプラグマなどで用いることを想定している．
+  /// @note 通常は使わないこと．
+  virtual
+  void
+  set_file_info(const FileInfo& file_info);
+
+  /// @brief データを読み込む．
+  /// @param[in] buff 読み込んだデータを格納する領域の先頭アドレス．
+  /// @param[in] n 読み込むデータサイズ
+  /// @return 実際に読み込んだ量を返す．
+  virtual
+  ymint64
+  read(ymuint8* buff,
+       ymuint64 n);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // MmapIDO の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを開く
+  /// @param[in] filename ファイル名
+  /// @note 他のファイルを開いていたら強制的に close する．
+  bool
+  open(const string& filename);
+
+  /// @brief ファイルを閉じる．
+  void
+  close();
+
+  /// @brief ファイルのサイズを返す．
+  ymuint64
+  size() const;
+
+  /// @brief 現在の読み出し位置を返す．
+  ymuint64
+  pos() const;
+
+  /// @brief 読み出し位置を設定する．
+  /// @param[in] pos 新しい読み出し位置 ( 0 <= pos <= size() )
+  void
+  seek(ymuint64 pos);
+
+  /// @brief 先頭のアドレスを返す．
+  const ymuint8*
+  data() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイル情報
+  FileInfo mFileInfo;
+
+  // 先頭のアドレス
+  ymuint8* mData;
+
+  // ファイルのサイズ
+  ymuint64 mSize;
+
+  // 現在の読み出し位置
+  ymuint64 mPos;
+
+  // mmap を用いている時 true となるフラグ
+  bool mMapped;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ファイルのサイズを返す．
+inline
+ymuint64
+MmapIDO::size() const
+{
+  return mSize;
+}
+
+// @brief 現在の読み出し位置を返す．
+inline
+ymuint64
+MmapIDO::pos() const
+{
+  return mPos;
+}
+
+// @brief 読み出し位置を設定する．
+// @param[in] pos 新しい読み出し位置 ( 0 <= pos <= size() )
+inline
+void
+MmapIDO::seek(ymuint64 pos)
+{
+  ASSERT_COND( pos <= mSize );
+  mPos = pos;
+}
+
+// @brief 先頭のアドレスを返す．
+inline
+const ymuint8*
+MmapIDO::data() const
+{
+  return mData;
+}
+
+END_NAMESPACE_YM
+
+#endif // YMUTILS_MMAPIDO_H
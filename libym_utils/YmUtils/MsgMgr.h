@@ -11,11 +11,11 @@
 
 #include "YmTools.h"
 #include "YmUtils/MsgType.h"
+#include "YmUtils/FileRegion.h"
 
 
 BEGIN_NAMESPACE_YM
 
-class FileRegion;
 class MsgHandler;
 
 //////////////////////////////////////////////////////////////////////
@@ -158,6 +158,67 @@ public:
   ymuint32
   debug_num();
 
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // スレッドごとの出力の抑制
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在のスレッドのメッセージ出力を抑制する．
+  /// @param[in] mute 抑制する時に true とする．
+  /// @note 抑制中のメッセージはハンドラに送られず，統計情報にも含まれない．
+  /// @note 抑制されたメッセージ数は 0 にリセットされる．
+  static
+  void
+  set_mute(bool mute);
+
+  /// @brief 現在のスレッドで抑制されたメッセージ数を得る．
+  static
+  ymuint32
+  muted_num();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // スレッドごとの出力の保留
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 出力を保留したメッセージ
+  struct DeferredMsg
+  {
+    // ソースファイル名
+    const char* mSrcFile;
+
+    // ソースの行番号
+    int mSrcLine;
+
+    // ファイル位置
+    FileRegion mFileLoc;
+
+    // メッセージの種類
+    MsgType mType;
+
+    // メッセージラベル
+    string mLabel;
+
+    // メッセージ本文
+    string mMsg;
+  };
+
+  /// @brief 現在のスレッドのメッセージ出力を保留する．
+  /// @param[in] msg_list 保留したメッセージを追加するリスト
+  /// @note nullptr を与えると保留を終了する．
+  /// @note 保留中のメッセージは統計情報にも含まれない．
+  static
+  void
+  set_defer(vector<DeferredMsg>* msg_list);
+
+  /// @brief 保留したメッセージを出力する．
+  /// @param[in] msg_list メッセージのリスト
+  static
+  void
+  put_deferred(const vector<DeferredMsg>& msg_list);
+
 };
 
 
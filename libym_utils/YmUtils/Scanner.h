@@ -59,6 +59,15 @@ public:
   void
   set_file_info(const FileInfo& file_info);
 
+  /// @brief 読み出しを開始する位置を設定する．
+  /// @param[in] line 行番号
+  /// @param[in] column コラム位置
+  /// @note ファイルの途中から切り出したデータを読む時に用いる．
+  /// @note 最初の文字を読み出す前に呼ぶ必要がある．
+  void
+  set_start_loc(ymuint line,
+		ymuint column);
+
 
 protected:
   //////////////////////////////////////////////////////////////////////
@@ -88,6 +88,14 @@ public:
   ymuint
   hash() const;
 
+  /// @brief 複数のスレッドから共有文字列を作る区間の開始/終了を指示する．
+  /// @param[in] flag 開始する時に true，終了する時に false とする．
+  /// @note 区間の中では文字列の登録が排他制御される．
+  /// 区間の外では排他制御を行わないので単一スレッドで使う必要がある．
+  static
+  void
+  set_multi_thread(bool flag);
+
   /// @brief ShString 関連でアロケートされたメモリサイズ
   static
   ymuint64
@@ -0,0 +1,355 @@
+﻿#ifndef YMUTILS_SLABALLOC_H
+#define YMUTILS_SLABALLOC_H
+
+/// @file YmUtils/SlabAlloc.h
+/// @brief SlabAlloc のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmUtils/Alloc.h"
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM
+
+class SlabPool;
+
+//////////////////////////////////////////////////////////////////////
+/// @class SlabAlloc SlabAlloc.h "YmUtils/SlabAlloc.h"
+/// @brief サイズクラスごとの空きリストを持つメモリアロケータ
+/// @sa SlabPool
+///
+/// 要求サイズを 8 バイト刻み(128 バイトまで)もしくは
+/// 2の巾乗の 1/4 刻みのサイズクラスに切り上げ，クラスごとの
+/// 空きリストで管理する．空きリストが空の時は SlabPool から得た
+/// スラブの先頭から順に切り出す．FragAlloc の2の巾乗への切り上げに比べて
+/// 無駄が少なく，ブロックの分割も行わない．
+///
+/// このクラス自体は排他制御を行わない．複数のスレッドで用いる場合は
+/// スレッドごとに SlabAlloc を作り，SlabPool を共有する．
+/// スラブのやり取りの時だけロックが必要になる．
+///
+/// ある SlabAlloc で確保した領域を，同じ SlabPool を共有する別のスレッドの
+/// SlabAlloc の put_memory() で解放してもよい．小さな領域はスラブの先頭に
+/// 記録された SlabAlloc に，大きな領域はヘッダに記録された SlabAlloc に
+/// 戻される．戻された領域は確保した SlabAlloc が次に get_memory() か
+/// put_memory() を呼んだ時(もしくは reclaim_remote() を呼んだ時)に
+/// 空きリストにつながれ，used_size() などの統計情報もその時に減る．
+/// 解放した側の統計情報は変わらない．
+///
+/// destroy() は個々の領域を解放せずにスラブをまとめて SlabPool に返す．
+//////////////////////////////////////////////////////////////////////
+class SlabAlloc :
+  public Alloc
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] max_size このオブジェクトが管理する最大サイズ
+  /// @param[in] huge_page スラブに huge page を用いる時 true にする．
+  ///
+  /// max_size を越えるメモリ領域は個別に確保する．
+  /// スラブは専用の SlabPool から確保する．
+  explicit
+  SlabAlloc(ymuint64 max_size = 4096,
+	    bool huge_page = false);
+
+  /// @brief 共有の SlabPool を用いるコンストラクタ
+  /// @param[in] pool スラブを供給する SlabPool
+  /// @param[in] max_size このオブジェクトが管理する最大サイズ
+  ///
+  /// max_size は pool のスラブサイズの 1/4 以下に制限される．
+  explicit
+  SlabAlloc(SlabPool& pool,
+	    ymuint64 max_size = 4096);
+
+  /// @brief デストラクタ
+  virtual
+  ~SlabAlloc();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 統計情報を返す関数
+  /// @{
+
+  /// @brief 他のスレッドから戻された領域を回収する．
+  ///
+  /// get_memory() と put_memory() の中でも呼ばれるので普通は呼ぶ必要はない．
+  /// 統計情報に他のスレッドで解放された分を反映させたい時に用いる．
+  /// このオブジェクトを使っているスレッドから呼ばなければならない．
+  void
+  reclaim_remote();
+
+  /// @brief サイズクラスの数を返す．
+  ymuint
+  class_num() const;
+
+  /// @brief サイズクラスの大きさを返す．
+  /// @param[in] cid サイズクラス番号 ( 0 <= cid < class_num() )
+  ymuint64
+  class_size(ymuint cid) const;
+
+  /// @brief サイズクラスの使用中の領域数を返す．
+  /// @param[in] cid サイズクラス番号 ( 0 <= cid < class_num() )
+  ymuint64
+  class_used_num(ymuint cid) const;
+
+  /// @brief サイズクラスの get_memory() の累積回数を返す．
+  /// @param[in] cid サイズクラス番号 ( 0 <= cid < class_num() )
+  ymuint64
+  class_alloc_num(ymuint cid) const;
+
+  /// @brief 使用中のスラブ数を返す．
+  ymuint64
+  slab_num() const;
+
+  /// @brief 個別に確保している大きな領域の数を返す．
+  /// @note 他のスレッドから戻されてまだ解放していない領域も含む．
+  ymuint64
+  large_num() const;
+
+  /// @brief サイズクラスごとの統計情報を出力する．
+  /// @param[in] s 出力先のストリーム
+  ///
+  /// 使用されたことのないサイズクラスは出力しない．
+  void
+  print_class_stats(ostream& s) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // Alloc の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief n バイトの領域を確保する．
+  /// @param[in] n 確保するメモリ量(単位はバイト)
+  virtual
+  void*
+  _get_memory(ymuint64 n);
+
+  /// @brief n バイトの領域を開放する．
+  /// @param[in] n 確保したメモリ量(単位はバイト)
+  /// @param[in] blk 開放するメモリ領域の先頭番地
+  virtual
+  void
+  _put_memory(ymuint64 n,
+	      void* blk);
+
+  /// @brief 今までに確保した全ての領域を破棄する．
+  /// 個々のオブジェクトのデストラクタなどは起動されない
+  /// ので使用には注意が必要
+  virtual
+  void
+  _destroy();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief サイズクラスを初期化する．
+  /// @param[in] max_size このオブジェクトが管理する最大サイズ
+  void
+  init_class(ymuint64 max_size);
+
+  /// @brief サイズからサイズクラス番号を求める．
+  /// @param[in] n サイズ ( n <= mMaxSize )
+  ymuint
+  size_to_class(ymuint64 n) const;
+
+  /// @brief スラブから領域を切り出す．
+  /// @param[in] size 切り出すサイズ
+  /// @return 制限値を越えた時は nullptr を返す．
+  char*
+  carve(ymuint64 size);
+
+  /// @brief 大きな領域を確保する．
+  /// @param[in] n 確保するメモリ量(単位はバイト)
+  void*
+  get_large(ymuint64 n);
+
+  /// @brief 大きな領域を解放する．
+  /// @param[in] n 確保したメモリ量(単位はバイト)
+  /// @param[in] blk 開放するメモリ領域の先頭番地
+  void
+  put_large(ymuint64 n,
+	    void* blk);
+
+  /// @brief 小さな領域を確保したオブジェクトを返す．
+  /// @param[in] blk 領域の先頭番地
+  SlabAlloc*
+  slab_owner(void* blk) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 空き領域を管理するための構造体
+  struct Block
+  {
+    // 次の要素を指すポインタ
+    Block* mLink;
+  };
+
+  // サイズクラスの情報
+  struct SizeClass
+  {
+    // 領域のサイズ
+    ymuint64 mSize;
+
+    // 空きリストの先頭
+    Block* mFreeTop;
+
+    // 使用中の領域数
+    ymuint64 mUsedNum;
+
+    // get_memory() の累積回数
+    ymuint64 mAllocNum;
+  };
+
+  // 大きな領域の先頭に置くヘッダ
+  // destroy() でまとめて解放するために双方向リストにしておく．
+  struct LargeHeader
+  {
+    // 前の要素
+    LargeHeader* mPrev;
+
+    // 次の要素
+    LargeHeader* mNext;
+
+    // ヘッダを含めたサイズ
+    ymuint64 mSize;
+
+    // 確保した SlabAlloc
+    SlabAlloc* mOwner;
+
+    // 他のスレッドから戻された領域のリストのリンク
+    LargeHeader* mRemoteLink;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // スラブを供給する SlabPool
+  SlabPool* mPool;
+
+  // mPool を自分で確保した時 true となるフラグ
+  bool mOwnPool;
+
+  // サイズクラスで管理する最大サイズ
+  ymuint64 mMaxSize;
+
+  // (サイズ + 7) / 8 をキーにしてサイズクラス番号を引く表
+  vector<ymuint8> mClassTable;
+
+  // サイズクラスの配列
+  vector<SizeClass> mClassArray;
+
+  // 現在切り出し中のスラブの空き領域の先頭
+  char* mCurPos;
+
+  // 現在切り出し中のスラブの末尾
+  char* mCurEnd;
+
+  // 使用中のスラブのリスト
+  vector<void*> mSlabList;
+
+  // 大きな領域のリストのダミーヘッダ
+  LargeHeader mLargeHead;
+
+  // 大きな領域の数
+  ymuint64 mLargeNum;
+
+  // 以下の3つは他のスレッドが追加するのでアトミックに操作する．
+
+  // 他のスレッドから戻された小さな領域のサイズクラスごとのリスト
+  std::atomic<Block*>* mRemoteBlock;
+
+  // 他のスレッドから戻された大きな領域のリスト
+  std::atomic<LargeHeader*> mRemoteFree;
+
+  // 他のスレッドから戻されてまだ used_size() に反映していないサイズ
+  std::atomic<ymuint64> mRemoteSize;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief サイズクラスの数を返す．
+inline
+ymuint
+SlabAlloc::class_num() const
+{
+  return mClassArray.size();
+}
+
+// @brief サイズクラスの大きさを返す．
+inline
+ymuint64
+SlabAlloc::class_size(ymuint cid) const
+{
+  ASSERT_COND( cid < class_num() );
+  return mClassArray[cid].mSize;
+}
+
+// @brief サイズクラスの使用中の領域数を返す．
+inline
+ymuint64
+SlabAlloc::class_used_num(ymuint cid) const
+{
+  ASSERT_COND( cid < class_num() );
+  return mClassArray[cid].mUsedNum;
+}
+
+// @brief サイズクラスの get_memory() の累積回数を返す．
+inline
+ymuint64
+SlabAlloc::class_alloc_num(ymuint cid) const
+{
+  ASSERT_COND( cid < class_num() );
+  return mClassArray[cid].mAllocNum;
+}
+
+// @brief 使用中のスラブ数を返す．
+inline
+ymuint64
+SlabAlloc::slab_num() const
+{
+  return mSlabList.size();
+}
+
+// @brief 個別に確保している大きな領域の数を返す．
+inline
+ymuint64
+SlabAlloc::large_num() const
+{
+  return mLargeNum;
+}
+
+// @brief サイズからサイズクラス番号を求める．
+inline
+ymuint
+SlabAlloc::size_to_class(ymuint64 n) const
+{
+  return mClassTable[(n + 7) >> 3];
+}
+
+END_NAMESPACE_YM
+
+#endif // YMUTILS_SLABALLOC_H
@@ -0,0 +1,195 @@
+﻿#ifndef YMUTILS_SLABPOOL_H
+#define YMUTILS_SLABPOOL_H
+
+/// @file YmUtils/SlabPool.h
+/// @brief SlabPool のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmTools.h"
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class SlabPool SlabPool.h "YmUtils/SlabPool.h"
+/// @brief SlabAlloc に固定サイズのスラブを供給するクラス
+/// @sa SlabAlloc
+///
+/// 複数のスレッドの SlabAlloc で共有できるように
+/// スラブのやり取りは mutex で保護されている．
+/// 返されたスラブは再利用のために保持しておき，trim() で OS に返す．
+///
+/// スラブのサイズは2の巾乗に切り上げ，スラブはそのサイズの境界に揃える．
+/// SlabAlloc は番地からスラブの先頭を求めて確保した SlabAlloc を調べる．
+///
+/// huge_page を指定した場合にはスラブのサイズを 2MB 単位に切り上げ，
+/// 境界に揃えた領域を mmap して huge page の利用を OS に依頼する．
+/// 大きなノードテーブルを持つマネージャ向けの機能である．
+//////////////////////////////////////////////////////////////////////
+class SlabPool
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] slab_size スラブのサイズ
+  /// @param[in] huge_page huge page を用いる時 true にする．
+  ///
+  /// slab_size は2の巾乗に切り上げられる．
+  explicit
+  SlabPool(ymuint64 slab_size = 64 * 1024,
+	   bool huge_page = false);
+
+  /// @brief デストラクタ
+  ///
+  /// 保持しているスラブを OS に返す．
+  /// 貸し出し中のスラブはそのままになる．
+  ~SlabPool();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // スラブの確保/解放を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スラブを一つ確保する．
+  /// @return スラブの先頭番地を返す．
+  void*
+  get_slab();
+
+  /// @brief スラブを返す．
+  /// @param[in] slab get_slab() で確保したスラブ
+  void
+  put_slab(void* slab);
+
+  /// @brief スラブに収まらない大きな領域を確保する．
+  /// @param[in] n 確保するメモリ量(単位はバイト)
+  ///
+  /// この領域は保持されずに put_large() で直接 OS に返される．
+  void*
+  get_large(ymuint64 n);
+
+  /// @brief get_large() で確保した領域を解放する．
+  /// @param[in] n 確保したメモリ量(単位はバイト)
+  /// @param[in] blk 解放する領域
+  void
+  put_large(ymuint64 n,
+	    void* blk);
+
+  /// @brief 保持しているスラブを OS に返す．
+  void
+  trim();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 情報を取得する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スラブのサイズを返す．
+  ymuint64
+  slab_size() const;
+
+  /// @brief huge page を用いている時 true を返す．
+  bool
+  huge_page() const;
+
+  /// @brief OS から確保しているスラブ数を返す．
+  ///
+  /// 貸し出し中のものと保持しているものの合計
+  ymuint64
+  slab_num() const;
+
+  /// @brief 再利用のために保持しているスラブ数を返す．
+  ymuint64
+  free_slab_num() const;
+
+  /// @brief slab_num() の今までの最大値を返す．
+  ymuint64
+  max_slab_num() const;
+
+  /// @brief 内部状態を出力する．
+  void
+  print_stats(ostream& s) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief OS から領域を確保する．
+  /// @param[in] n 確保するメモリ量(単位はバイト)
+  /// @param[in] huge huge page を用いる時 true にする．
+  /// @param[in] align 境界(2の巾乗)
+  static
+  void*
+  os_alloc(ymuint64 n,
+	   bool huge,
+	   ymuint64 align);
+
+  /// @brief os_alloc() で確保した領域を OS に返す．
+  /// @param[in] n 確保したメモリ量(単位はバイト)
+  /// @param[in] blk 解放する領域
+  /// @param[in] huge os_alloc() に与えた値
+  static
+  void
+  os_free(ymuint64 n,
+	  void* blk,
+	  bool huge);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // スラブのサイズ
+  ymuint64 mSlabSize;
+
+  // huge page を用いる時 true にするフラグ
+  bool mHugePage;
+
+  // 以下のメンバを保護する mutex
+  mutable
+  std::mutex mMutex;
+
+  // 再利用のために保持しているスラブのリスト
+  vector<void*> mFreeList;
+
+  // OS から確保しているスラブ数
+  ymuint64 mSlabNum;
+
+  // mSlabNum の最大値
+  ymuint64 mMaxSlabNum;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief スラブのサイズを返す．
+inline
+ymuint64
+SlabPool::slab_size() const
+{
+  return mSlabSize;
+}
+
+// @brief huge page を用いている時 true を返す．
+inline
+bool
+SlabPool::huge_page() const
+{
+  return mHugePage;
+}
+
+END_NAMESPACE_YM
+
+#endif // YMUTILS_SLABPOOL_H
@@ -24,7 +24,7 @@
 #include <algorithm>
 #include <functional>
 #define constexpr const
-#elif __GNUC__ >= 4 && __GNUC_MINOR__ >= 6
+#elif __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
 #include <ext/algorithm>
 #include <functional>
 #elif __GNUC__ >= 3
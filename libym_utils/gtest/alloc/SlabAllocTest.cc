@@ -0,0 +1,364 @@
+﻿
+/// @file SlabAllocTest.cc
+/// @brief SlabAlloc のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmUtils/SlabAlloc.h"
+#include "YmUtils/SlabPool.h"
+#include <thread>
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM
+
+class SlabAllocTest :
+  public testing::Test
+{
+public:
+
+  SlabAllocTest();
+
+  virtual
+  ~SlabAllocTest();
+
+
+public:
+
+  SlabAlloc mAlloc;
+
+};
+
+SlabAllocTest::SlabAllocTest()
+{
+}
+
+SlabAllocTest::~SlabAllocTest()
+{
+}
+
+BEGIN_NONAMESPACE
+
+// 共有の SlabPool を用いて確保と解放を繰り返す．
+void
+thread_body(SlabPool* pool,
+	    ymuint id,
+	    bool* ok)
+{
+  SlabAlloc alloc(*pool, 256);
+  vector<ymuint*> ptr_list;
+  for (ymuint i = 0; i < 10000; ++ i) {
+    ymuint size = ((i % 32) + 1) * 8;
+    ymuint* p = static_cast<ymuint*>(alloc.get_memory(size));
+    p[0] = id;
+    p[1] = size;
+    ptr_list.push_back(p);
+    if ( i % 3 == 2 ) {
+      ymuint* q = ptr_list[ptr_list.size() - 2];
+      if ( q[0] != id ) {
+	*ok = false;
+      }
+      alloc.put_memory(q[1], q);
+      ptr_list[ptr_list.size() - 2] = ptr_list.back();
+      ptr_list.pop_back();
+    }
+  }
+  for (vector<ymuint*>::iterator p = ptr_list.begin();
+       p != ptr_list.end(); ++ p) {
+    if ( (*p)[0] != id ) {
+      *ok = false;
+    }
+  }
+  alloc.destroy();
+}
+
+END_NONAMESPACE
+
+TEST_F( SlabAllocTest, Empty )
+{
+  // なにもしない．
+  // コンストラクタ/デストラクタでエラーがおきないことのテスト
+}
+
+TEST_F( SlabAllocTest, Alloc1 )
+{
+  void* p = mAlloc.get_memory(16);
+
+  EXPECT_TRUE( p != nullptr );
+  EXPECT_EQ( 1UL, mAlloc.slab_num() );
+}
+
+TEST_F( SlabAllocTest, SizeClass )
+{
+  // サイズクラスは単調増加で全て 8 の倍数
+  ymuint n = mAlloc.class_num();
+  for (ymuint i = 0; i < n; ++ i) {
+    EXPECT_EQ( 0UL, mAlloc.class_size(i) % 8 );
+    if ( i > 0 ) {
+      EXPECT_LT( mAlloc.class_size(i - 1), mAlloc.class_size(i) );
+    }
+  }
+  EXPECT_EQ( 4096UL, mAlloc.class_size(n - 1) );
+
+  // 同じクラスのサイズは同じ領域を再利用する．
+  void* p = mAlloc.get_memory(100);
+  mAlloc.put_memory(100, p);
+  void* q = mAlloc.get_memory(97);
+  EXPECT_EQ( p, q );
+}
+
+TEST_F( SlabAllocTest, Reuse )
+{
+  void* p1 = mAlloc.get_memory(24);
+  void* p2 = mAlloc.get_memory(24);
+  EXPECT_NE( p1, p2 );
+
+  mAlloc.put_memory(24, p1);
+  void* p3 = mAlloc.get_memory(24);
+  EXPECT_EQ( p1, p3 );
+}
+
+TEST_F( SlabAllocTest, BigAlloc )
+{
+  void* p = mAlloc.get_memory(16 * 1024);
+
+  EXPECT_TRUE( p != nullptr );
+  EXPECT_EQ( 0UL, mAlloc.slab_num() );
+  EXPECT_EQ( 1UL, mAlloc.large_num() );
+
+  mAlloc.put_memory(16 * 1024, p);
+
+  EXPECT_EQ( 0UL, mAlloc.large_num() );
+  EXPECT_EQ( 0UL, mAlloc.allocated_size() );
+}
+
+TEST_F( SlabAllocTest, RepeatAlloc )
+{
+  const ymuint SIZE1 = 1001;
+  const ymuint SIZE2 = 1024;
+
+  for (ymuint i = 0; i < 100000; ++ i) {
+    void* p = mAlloc.get_memory(SIZE1);
+
+    EXPECT_NE( nullptr, p ) << "p = mAlloc.get_memory(" << SIZE1 << ")";
+
+    void* q = mAlloc.get_memory(SIZE2);
+
+    EXPECT_NE( nullptr, q ) << "q = mAlloc.get_memory(" << SIZE2 << ")";
+
+    mAlloc.put_memory(SIZE1, p);
+
+    mAlloc.put_memory(SIZE2, q);
+
+    EXPECT_EQ( 0UL, mAlloc.used_size() ) << "mAlloc.used_size() != 0";
+  }
+  EXPECT_EQ( 1UL, mAlloc.slab_num() );
+}
+
+TEST_F( SlabAllocTest, Destroy )
+{
+  for (ymuint i = 0; i < 100000; ++ i) {
+    mAlloc.get_memory(40);
+  }
+  mAlloc.get_memory(10000);
+  mAlloc.get_memory(20000);
+
+  EXPECT_LT( 1UL, mAlloc.slab_num() );
+  EXPECT_EQ( 2UL, mAlloc.large_num() );
+
+  mAlloc.destroy();
+
+  EXPECT_EQ( 0UL, mAlloc.slab_num() );
+  EXPECT_EQ( 0UL, mAlloc.large_num() );
+  EXPECT_EQ( 0UL, mAlloc.used_size() );
+  EXPECT_EQ( 0UL, mAlloc.allocated_size() );
+
+  // destroy() 後も使える．
+  void* p = mAlloc.get_memory(40);
+  EXPECT_NE( nullptr, p );
+}
+
+TEST_F( SlabAllocTest, MemLimit )
+{
+  SlabPool pool(4096);
+  SlabAlloc alloc(pool, 1024);
+  alloc.set_mem_limit(4096 * 2 + 1);
+
+  // スラブ2つ分までは確保できる．
+  // スラブの先頭にはヘッダがあるので1つのスラブから7個とれる．
+  for (ymuint i = 0; i < 14; ++ i) {
+    EXPECT_NE( nullptr, alloc.get_memory(512) );
+  }
+  EXPECT_EQ( nullptr, alloc.get_memory(512) );
+  EXPECT_EQ( nullptr, alloc.get_memory(10000) );
+}
+
+TEST_F( SlabAllocTest, Stats )
+{
+  for (ymuint i = 0; i < 10; ++ i) {
+    mAlloc.get_memory(16);
+  }
+  void* p = mAlloc.get_memory(200);
+  mAlloc.put_memory(200, p);
+
+  ymuint n = mAlloc.class_num();
+  ymuint64 used = 0;
+  ymuint64 count = 0;
+  for (ymuint i = 0; i < n; ++ i) {
+    used += mAlloc.class_used_num(i);
+    count += mAlloc.class_alloc_num(i);
+  }
+  EXPECT_EQ( 10UL, used );
+  EXPECT_EQ( 11UL, count );
+  EXPECT_EQ( 10UL * 16, mAlloc.used_size() );
+}
+
+TEST_F( SlabAllocTest, SharedPool )
+{
+  SlabPool pool;
+  const ymuint n = 4;
+  bool ok_array[n];
+  vector<std::thread> thread_list;
+  for (ymuint i = 0; i < n; ++ i) {
+    ok_array[i] = true;
+    thread_list.push_back(std::thread(thread_body, &pool, i, &ok_array[i]));
+  }
+  for (ymuint i = 0; i < n; ++ i) {
+    thread_list[i].join();
+    EXPECT_TRUE( ok_array[i] ) << "thread#" << i;
+  }
+
+  // 全てのスラブは pool に返されている．
+  EXPECT_EQ( pool.slab_num(), pool.free_slab_num() );
+  EXPECT_LT( 0UL, pool.max_slab_num() );
+
+  pool.trim();
+  EXPECT_EQ( 0UL, pool.slab_num() );
+}
+
+TEST_F( SlabAllocTest, RemoteLargeFree )
+{
+  SlabPool pool;
+  SlabAlloc alloc1(pool, 1024);
+  SlabAlloc alloc2(pool, 1024);
+
+  const ymuint64 size = 10000;
+  void* p = alloc1.get_memory(size);
+  void* q = alloc1.get_memory(size);
+  EXPECT_EQ( 2UL, alloc1.large_num() );
+  EXPECT_EQ( 2 * size, alloc1.used_size() );
+  ymuint64 asize = alloc1.allocated_size();
+
+  // 別のスレッドで別の SlabAlloc から解放する．
+  std::thread th([&alloc2, p, q, size]() {
+      alloc2.put_memory(size, p);
+      alloc2.put_memory(size, q);
+    });
+  th.join();
+
+  // alloc2 のリストには入らず，alloc1 で解放されるまで数に残る．
+  EXPECT_EQ( 0UL, alloc2.large_num() );
+  EXPECT_EQ( 0UL, alloc2.allocated_size() );
+  EXPECT_EQ( 0UL, alloc2.used_size() );
+  EXPECT_EQ( 2UL, alloc1.large_num() );
+  EXPECT_EQ( asize, alloc1.allocated_size() );
+  EXPECT_EQ( 2 * size, alloc1.used_size() );
+
+  // 次に領域を扱う時に解放される．
+  void* r = alloc1.get_memory(size);
+  EXPECT_NE( nullptr, r );
+  EXPECT_EQ( 1UL, alloc1.large_num() );
+  EXPECT_EQ( asize / 2, alloc1.allocated_size() );
+  EXPECT_EQ( size, alloc1.used_size() );
+
+  // destroy() で戻された領域を二重に解放しない．
+  std::thread th2([&alloc2, r, size]() {
+      alloc2.put_memory(size, r);
+    });
+  th2.join();
+  alloc1.destroy();
+  EXPECT_EQ( 0UL, alloc1.large_num() );
+  EXPECT_EQ( 0UL, alloc1.allocated_size() );
+}
+
+TEST_F( SlabAllocTest, RemoteSmallFree )
+{
+  SlabPool pool;
+  SlabAlloc alloc1(pool, 1024);
+  SlabAlloc alloc2(pool, 1024);
+
+  const ymuint64 size = 24;
+  const ymuint n = 10;
+  vector<void*> ptr_list(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    ptr_list[i] = alloc1.get_memory(size);
+  }
+  ymuint cid = 0;
+  for ( ; alloc1.class_size(cid) < size; ++ cid) ;
+  EXPECT_EQ( n, alloc1.class_used_num(cid) );
+  EXPECT_EQ( n * size, alloc1.used_size() );
+
+  // 別のスレッドで別の SlabAlloc から解放する．
+  std::thread th([&alloc2, &ptr_list, size]() {
+      for (vector<void*>::iterator p = ptr_list.begin();
+	   p != ptr_list.end(); ++ p) {
+	alloc2.put_memory(size, *p);
+      }
+    });
+  th.join();
+
+  // alloc2 の数は変わらない．
+  EXPECT_EQ( 0UL, alloc2.used_size() );
+  EXPECT_EQ( 0UL, alloc2.class_used_num(cid) );
+  EXPECT_EQ( 0UL, alloc2.slab_num() );
+
+  // alloc1 で回収されるまで数に残る．
+  EXPECT_EQ( n, alloc1.class_used_num(cid) );
+  EXPECT_EQ( n * size, alloc1.used_size() );
+
+  alloc1.reclaim_remote();
+  EXPECT_EQ( 0UL, alloc1.class_used_num(cid) );
+  EXPECT_EQ( 0UL, alloc1.used_size() );
+
+  // 戻された領域は alloc1 で再利用される．
+  void* p = alloc1.get_memory(size);
+  EXPECT_TRUE( find(ptr_list.begin(), ptr_list.end(), p) != ptr_list.end() );
+  EXPECT_EQ( 1UL, alloc1.slab_num() );
+
+  // alloc2 の空きリストには入っていない．
+  void* q = alloc2.get_memory(size);
+  EXPECT_TRUE( find(ptr_list.begin(), ptr_list.end(), q) == ptr_list.end() );
+  EXPECT_EQ( 1UL, alloc2.slab_num() );
+  alloc2.put_memory(size, q);
+  EXPECT_EQ( 0UL, alloc2.used_size() );
+
+  // alloc1 の destroy() 後は戻された領域は残らない．
+  std::thread th2([&alloc2, p, size]() {
+      alloc2.put_memory(size, p);
+    });
+  th2.join();
+  alloc1.destroy();
+  EXPECT_EQ( 0UL, alloc1.used_size() );
+  EXPECT_EQ( 0UL, alloc1.class_used_num(cid) );
+  void* r = alloc1.get_memory(size);
+  EXPECT_NE( nullptr, r );
+  EXPECT_EQ( size, alloc1.used_size() );
+}
+
+TEST_F( SlabAllocTest, HugePage )
+{
+  SlabAlloc alloc(1024, true);
+  void* p = alloc.get_memory(64);
+  EXPECT_NE( nullptr, p );
+  void* q = alloc.get_memory(4 * 1024 * 1024);
+  EXPECT_NE( nullptr, q );
+  static_cast<char*>(q)[4 * 1024 * 1024 - 1] = 0;
+  alloc.put_memory(4 * 1024 * 1024, q);
+  EXPECT_EQ( 0UL, alloc.large_num() );
+}
+
+END_NAMESPACE_YM
@@ -82,12 +82,10 @@ Alloc::print_stats(ostream& s) const
 void*
 Alloc::alloc(ymuint64 n)
 {
-  if ( mMemLimit > 0 && mAllocSize + n >= mMemLimit ) {
+  if ( !count_alloc(n) ) {
     // 総量が制限値を越えた．
     return 0;
   }
-  mAllocSize += n;
-  ++ mAllocCount;
   return ::operator new(n);
 }
 
@@ -98,8 +96,46 @@ void
 Alloc::free(ymuint64 n,
 	    void* blk)
 {
-  mAllocSize -= n;
+  count_free(n);
   ::operator delete(blk);
 }
 
+// @brief 確保したメモリ量を加算する．
+// @param[in] n 確保するメモリ量(単位はバイト)
+// @return 確保した総量が制限値を越える時は加算せずに false を返す．
+bool
+Alloc::count_alloc(ymuint64 n)
+{
+  if ( mMemLimit > 0 && mAllocSize + n >= mMemLimit ) {
+    return false;
+  }
+  mAllocSize += n;
+  ++ mAllocCount;
+  return true;
+}
+
+// @brief 確保したメモリ量を減算する．
+// @param[in] n 解放するメモリ量(単位はバイト)
+void
+Alloc::count_free(ymuint64 n)
+{
+  mAllocSize -= n;
+}
+
+// @brief put_memory() で減算した使用中のメモリ量を元に戻す．
+// @param[in] n 解放したメモリ量(単位はバイト)
+void
+Alloc::restore_used_size(ymuint64 n)
+{
+  mUsedSize += n;
+}
+
+// @brief put_memory() を経ずに返された領域を使用中のメモリ量から減算する．
+// @param[in] n 解放されたメモリ量(単位はバイト)
+void
+Alloc::reduce_used_size(ymuint64 n)
+{
+  mUsedSize -= n;
+}
+
 END_NAMESPACE_YM
@@ -71,9 +71,10 @@ SimpleAlloc::_get_memory(ymuint64 n)
   page.mNextPos += alloc_size;
 
   // page の余りがなくなったら mUsedList に移す．
+  // page は p の指す要素への参照なので erase() してから
+  // 使ってはいけない．splice() なら要素はそのまま移動する．
   if ( page.mNextPos + align(1) > mPageSize ) {
-    mAvailList.erase(p);
-    mUsedList.push_back(page);
+    mUsedList.splice(mUsedList.end(), mAvailList, p);
   }
 
   return static_cast<void*>(s);
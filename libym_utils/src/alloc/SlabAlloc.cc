@@ -0,0 +1,408 @@
+﻿
+/// @file SlabAlloc.cc
+/// @brief SlabAlloc の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmUtils/SlabAlloc.h"
+#include "YmUtils/SlabPool.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// 専用の SlabPool を作る時のスラブサイズの下限
+const ymuint64 kMinSlabSize = 64 * 1024;
+
+// 8 バイト刻みのサイズクラスの上限
+const ymuint64 kSmallMax = 128;
+
+// 大きな領域の前に置くヘッダ(LargeHeader)の大きさ
+// 16 バイト境界に揃えておく．
+const ymuint64 kLargeHeadSize = 48;
+
+// スラブの先頭に置くヘッダの大きさ
+// 確保した SlabAlloc へのポインタを収める．
+const ymuint64 kSlabHeadSize = 16;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SlabAlloc
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] max_size このオブジェクトが管理する最大サイズ
+// @param[in] huge_page スラブに huge page を用いる時 true にする．
+SlabAlloc::SlabAlloc(ymuint64 max_size,
+		     bool huge_page) :
+  mPool(new SlabPool(max_size * 4 > kMinSlabSize ? max_size * 4 : kMinSlabSize,
+		     huge_page)),
+  mOwnPool(true),
+  mCurPos(nullptr),
+  mCurEnd(nullptr),
+  mLargeNum(0),
+  mRemoteBlock(nullptr),
+  mRemoteFree(nullptr),
+  mRemoteSize(0)
+{
+  init_class(max_size);
+}
+
+// @brief 共有の SlabPool を用いるコンストラクタ
+// @param[in] pool スラブを供給する SlabPool
+// @param[in] max_size このオブジェクトが管理する最大サイズ
+SlabAlloc::SlabAlloc(SlabPool& pool,
+		     ymuint64 max_size) :
+  mPool(&pool),
+  mOwnPool(false),
+  mCurPos(nullptr),
+  mCurEnd(nullptr),
+  mLargeNum(0),
+  mRemoteBlock(nullptr),
+  mRemoteFree(nullptr),
+  mRemoteSize(0)
+{
+  if ( max_size > pool.slab_size() / 4 ) {
+    max_size = pool.slab_size() / 4;
+  }
+  init_class(max_size);
+}
+
+// @brief デストラクタ
+SlabAlloc::~SlabAlloc()
+{
+  destroy();
+  delete [] mRemoteBlock;
+  if ( mOwnPool ) {
+    delete mPool;
+  }
+}
+
+// @brief サイズクラスごとの統計情報を出力する．
+// @param[in] s 出力先のストリーム
+void
+SlabAlloc::print_class_stats(ostream& s) const
+{
+  s << "slab num:          " << slab_num() << endl
+    << "large block num:   " << large_num() << endl;
+  for (vector<SizeClass>::const_iterator p = mClassArray.begin();
+       p != mClassArray.end(); ++ p) {
+    const SizeClass& sc = *p;
+    if ( sc.mAllocNum == 0 ) {
+      continue;
+    }
+    s << "  size " << setw(5) << sc.mSize
+      << ": used " << setw(8) << sc.mUsedNum
+      << ", allocated " << setw(10) << sc.mAllocNum << endl;
+  }
+  s << endl;
+}
+
+// @brief n バイトの領域を確保する．
+void*
+SlabAlloc::_get_memory(ymuint64 n)
+{
+  if ( mRemoteSize.load(std::memory_order_relaxed) != 0 ) {
+    reclaim_remote();
+  }
+
+  if ( n > mMaxSize ) {
+    return get_large(n);
+  }
+
+  SizeClass& sc = mClassArray[size_to_class(n)];
+  Block* b = sc.mFreeTop;
+  if ( b != nullptr ) {
+    sc.mFreeTop = b->mLink;
+  }
+  else {
+    b = reinterpret_cast<Block*>(carve(sc.mSize));
+    if ( b == nullptr ) {
+      return nullptr;
+    }
+  }
+  ++ sc.mUsedNum;
+  ++ sc.mAllocNum;
+  return static_cast<void*>(b);
+}
+
+// @brief n バイトの領域を開放する．
+//
+// 別の SlabAlloc で確保された領域の場合，その SlabAlloc の空きリストは
+// 他のスレッドが操作している可能性があるので触らずに mRemoteBlock に
+// 積んでおく．実際に空きリストに戻すのは確保した SlabAlloc の
+// reclaim_remote() で行う．
+void
+SlabAlloc::_put_memory(ymuint64 n,
+		       void* blk)
+{
+  if ( mRemoteSize.load(std::memory_order_relaxed) != 0 ) {
+    reclaim_remote();
+  }
+
+  if ( n > mMaxSize ) {
+    put_large(n, blk);
+    return;
+  }
+
+  Block* b = static_cast<Block*>(blk);
+  SlabAlloc* owner = slab_owner(blk);
+  if ( owner != this ) {
+    // 使用量は確保した側で減らす．
+    restore_used_size(n);
+    std::atomic<Block*>& top = owner->mRemoteBlock[owner->size_to_class(n)];
+    Block* old_top = top.load(std::memory_order_relaxed);
+    do {
+      b->mLink = old_top;
+    } while ( !top.compare_exchange_weak(old_top, b,
+					 std::memory_order_release,
+					 std::memory_order_relaxed) );
+    owner->mRemoteSize.fetch_add(n, std::memory_order_release);
+    return;
+  }
+
+  SizeClass& sc = mClassArray[size_to_class(n)];
+  b->mLink = sc.mFreeTop;
+  sc.mFreeTop = b;
+  -- sc.mUsedNum;
+}
+
+// @brief 今までに確保した全ての領域を破棄する．
+void
+SlabAlloc::_destroy()
+{
+  for (vector<SizeClass>::iterator p = mClassArray.begin();
+       p != mClassArray.end(); ++ p) {
+    SizeClass& sc = *p;
+    sc.mFreeTop = nullptr;
+    sc.mUsedNum = 0;
+  }
+
+  ymuint64 slab_size = mPool->slab_size();
+  for (vector<void*>::iterator p = mSlabList.begin();
+       p != mSlabList.end(); ++ p) {
+    mPool->put_slab(*p);
+    count_free(slab_size);
+  }
+  mSlabList.clear();
+  mCurPos = nullptr;
+  mCurEnd = nullptr;
+
+  // 他のスレッドから戻された小さな領域はスラブごと返したので捨てる．
+  for (ymuint i = 0; i < mClassArray.size(); ++ i) {
+    mRemoteBlock[i].store(nullptr, std::memory_order_relaxed);
+  }
+  mRemoteSize.store(0, std::memory_order_relaxed);
+
+  // 大きな領域はヘッダのリストをたどって解放する．
+  // 他のスレッドから戻された領域もまだリストに含まれている．
+  mRemoteFree.exchange(nullptr, std::memory_order_acquire);
+  for (LargeHeader* h = mLargeHead.mNext; h != &mLargeHead; ) {
+    LargeHeader* next = h->mNext;
+    ymuint64 size = h->mSize;
+    mPool->put_large(size, static_cast<void*>(h));
+    count_free(size);
+    h = next;
+  }
+  mLargeHead.mPrev = &mLargeHead;
+  mLargeHead.mNext = &mLargeHead;
+  mLargeNum = 0;
+}
+
+// @brief サイズクラスを初期化する．
+// @param[in] max_size このオブジェクトが管理する最大サイズ
+void
+SlabAlloc::init_class(ymuint64 max_size)
+{
+  ASSERT_COND( max_size > 0 );
+
+  // 128 バイトまでは 8 バイト刻み
+  // それ以降は 2の巾乗ごとに4つのクラスに分ける．
+  vector<ymuint64> size_list;
+  for (ymuint64 size = 8; size <= kSmallMax; size += 8) {
+    size_list.push_back(size);
+  }
+  for (ymuint64 base = kSmallMax; size_list.back() < max_size; base <<= 1) {
+    ymuint64 step = base / 4;
+    for (ymuint i = 1; i <= 4; ++ i) {
+      size_list.push_back(base + step * i);
+    }
+  }
+  ASSERT_COND( size_list.size() <= 256 );
+
+  // max_size を含むクラスまでで打ち切る．
+  mClassArray.clear();
+  for (vector<ymuint64>::iterator p = size_list.begin();
+       p != size_list.end(); ++ p) {
+    SizeClass sc;
+    sc.mSize = *p;
+    sc.mFreeTop = nullptr;
+    sc.mUsedNum = 0;
+    sc.mAllocNum = 0;
+    mClassArray.push_back(sc);
+    if ( *p >= max_size ) {
+      break;
+    }
+  }
+  mMaxSize = mClassArray.back().mSize;
+
+  ymuint64 n = (mMaxSize >> 3) + 1;
+  mClassTable.resize(n);
+  ymuint cid = 0;
+  for (ymuint64 i = 0; i < n; ++ i) {
+    while ( mClassArray[cid].mSize < (i << 3) ) {
+      ++ cid;
+    }
+    mClassTable[i] = cid;
+  }
+
+  mLargeHead.mPrev = &mLargeHead;
+  mLargeHead.mNext = &mLargeHead;
+
+  delete [] mRemoteBlock;
+  mRemoteBlock = new std::atomic<Block*>[mClassArray.size()];
+  for (ymuint i = 0; i < mClassArray.size(); ++ i) {
+    mRemoteBlock[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+// @brief スラブから領域を切り出す．
+// @param[in] size 切り出すサイズ
+// @return 制限値を越えた時は nullptr を返す．
+char*
+SlabAlloc::carve(ymuint64 size)
+{
+  if ( mCurPos + size > mCurEnd ) {
+    // スラブの残りは捨てる．
+    // 最大のクラスでもスラブの 1/4 以下なので無駄は少ない．
+    ymuint64 slab_size = mPool->slab_size();
+    if ( !count_alloc(slab_size) ) {
+      return nullptr;
+    }
+    void* slab = mPool->get_slab();
+    mSlabList.push_back(slab);
+    // 先頭に自分を記録しておく．
+    *static_cast<SlabAlloc**>(slab) = this;
+    mCurPos = static_cast<char*>(slab) + kSlabHeadSize;
+    mCurEnd = static_cast<char*>(slab) + slab_size;
+  }
+  char* ans = mCurPos;
+  mCurPos += size;
+  return ans;
+}
+
+// @brief 大きな領域を確保する．
+// @param[in] n 確保するメモリ量(単位はバイト)
+void*
+SlabAlloc::get_large(ymuint64 n)
+{
+  ymuint64 size = n + kLargeHeadSize;
+  if ( !count_alloc(size) ) {
+    return nullptr;
+  }
+  void* p = mPool->get_large(size);
+  LargeHeader* h = static_cast<LargeHeader*>(p);
+  h->mSize = size;
+  h->mOwner = this;
+  h->mRemoteLink = nullptr;
+  h->mPrev = &mLargeHead;
+  h->mNext = mLargeHead.mNext;
+  mLargeHead.mNext->mPrev = h;
+  mLargeHead.mNext = h;
+  ++ mLargeNum;
+  return static_cast<void*>(static_cast<char*>(p) + kLargeHeadSize);
+}
+
+// @brief 大きな領域を解放する．
+// @param[in] n 確保したメモリ量(単位はバイト)
+// @param[in] blk 開放するメモリ領域の先頭番地
+//
+// 別の SlabAlloc で確保された領域の場合，その SlabAlloc のリストは
+// 他のスレッドが操作している可能性があるので触らずに mRemoteFree に
+// 積んでおく．実際の解放は確保した SlabAlloc の reclaim_remote() で行う．
+void
+SlabAlloc::put_large(ymuint64 n,
+		     void* blk)
+{
+  LargeHeader* h = reinterpret_cast<LargeHeader*>(static_cast<char*>(blk) - kLargeHeadSize);
+  ASSERT_COND( h->mSize == n + kLargeHeadSize );
+
+  SlabAlloc* owner = h->mOwner;
+  if ( owner != this ) {
+    // 使用量は確保した側で減らす．
+    restore_used_size(n);
+    LargeHeader* top = owner->mRemoteFree.load(std::memory_order_relaxed);
+    do {
+      h->mRemoteLink = top;
+    } while ( !owner->mRemoteFree.compare_exchange_weak(top, h,
+							std::memory_order_release,
+							std::memory_order_relaxed) );
+    owner->mRemoteSize.fetch_add(n, std::memory_order_release);
+    return;
+  }
+
+  h->mPrev->mNext = h->mNext;
+  h->mNext->mPrev = h->mPrev;
+  -- mLargeNum;
+  ymuint64 size = h->mSize;
+  mPool->put_large(size, static_cast<void*>(h));
+  count_free(size);
+}
+
+// @brief 小さな領域を確保したオブジェクトを返す．
+// @param[in] blk 領域の先頭番地
+//
+// スラブはスラブサイズの境界に揃っているので先頭のヘッダを読む．
+SlabAlloc*
+SlabAlloc::slab_owner(void* blk) const
+{
+  ymuint64 mask = ~(mPool->slab_size() - 1);
+  ymuint64 top = reinterpret_cast<ymuint64>(blk) & mask;
+  return *reinterpret_cast<SlabAlloc**>(top);
+}
+
+// @brief 他のスレッドから戻された領域を回収する．
+//
+// 戻した側は領域をリストに積んでから mRemoteSize を増やすので，
+// mRemoteSize が 0 の時は何もしない．
+void
+SlabAlloc::reclaim_remote()
+{
+  ymuint64 size = mRemoteSize.exchange(0, std::memory_order_acquire);
+  if ( size == 0 ) {
+    return;
+  }
+  reduce_used_size(size);
+
+  for (ymuint i = 0; i < mClassArray.size(); ++ i) {
+    Block* b = mRemoteBlock[i].exchange(nullptr, std::memory_order_acquire);
+    SizeClass& sc = mClassArray[i];
+    while ( b != nullptr ) {
+      Block* next = b->mLink;
+      b->mLink = sc.mFreeTop;
+      sc.mFreeTop = b;
+      -- sc.mUsedNum;
+      b = next;
+    }
+  }
+
+  LargeHeader* h = mRemoteFree.exchange(nullptr, std::memory_order_acquire);
+  while ( h != nullptr ) {
+    LargeHeader* next = h->mRemoteLink;
+    h->mPrev->mNext = h->mNext;
+    h->mNext->mPrev = h->mPrev;
+    -- mLargeNum;
+    ymuint64 size = h->mSize;
+    mPool->put_large(size, static_cast<void*>(h));
+    count_free(size);
+    h = next;
+  }
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,258 @@
+﻿
+/// @file SlabPool.cc
+/// @brief SlabPool の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmUtils/SlabPool.h"
+
+#if defined(YM_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#include <cstdlib>
+#endif
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// huge page のサイズ
+const ymuint64 kHugePageSize = 2 * 1024 * 1024;
+
+// n を huge page のサイズの倍数に切り上げる．
+inline
+ymuint64
+huge_round(ymuint64 n)
+{
+  return ((n + kHugePageSize - 1) / kHugePageSize) * kHugePageSize;
+}
+
+// n を2の巾乗に切り上げる．
+inline
+ymuint64
+pow2_round(ymuint64 n)
+{
+  ymuint64 ans = 1;
+  while ( ans < n ) {
+    ans <<= 1;
+  }
+  return ans;
+}
+
+// 大きな領域の境界
+const ymuint64 kLargeAlign = 16;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SlabPool
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] slab_size スラブのサイズ
+// @param[in] huge_page huge page を用いる時 true にする．
+SlabPool::SlabPool(ymuint64 slab_size,
+		   bool huge_page) :
+  mSlabSize(slab_size),
+  mHugePage(huge_page),
+  mSlabNum(0),
+  mMaxSlabNum(0)
+{
+  ASSERT_COND( slab_size > 0 );
+
+#if defined(YM_WIN32)
+  mHugePage = false;
+#endif
+
+  if ( mHugePage ) {
+    mSlabSize = huge_round(mSlabSize);
+  }
+  mSlabSize = pow2_round(mSlabSize);
+}
+
+// @brief デストラクタ
+SlabPool::~SlabPool()
+{
+  trim();
+}
+
+// @brief スラブを一つ確保する．
+// @return スラブの先頭番地を返す．
+void*
+SlabPool::get_slab()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if ( !mFreeList.empty() ) {
+      void* slab = mFreeList.back();
+      mFreeList.pop_back();
+      return slab;
+    }
+    ++ mSlabNum;
+    if ( mMaxSlabNum < mSlabNum ) {
+      mMaxSlabNum = mSlabNum;
+    }
+  }
+  // OS からの確保はロックの外で行う．
+  return os_alloc(mSlabSize, mHugePage, mSlabSize);
+}
+
+// @brief スラブを返す．
+// @param[in] slab get_slab() で確保したスラブ
+void
+SlabPool::put_slab(void* slab)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mFreeList.push_back(slab);
+}
+
+// @brief スラブに収まらない大きな領域を確保する．
+// @param[in] n 確保するメモリ量(単位はバイト)
+void*
+SlabPool::get_large(ymuint64 n)
+{
+  // huge page 1つに満たない領域には用いない．
+  bool huge = mHugePage && n >= kHugePageSize;
+  return os_alloc(n, huge, huge ? kHugePageSize : kLargeAlign);
+}
+
+// @brief get_large() で確保した領域を解放する．
+// @param[in] n 確保したメモリ量(単位はバイト)
+// @param[in] blk 解放する領域
+void
+SlabPool::put_large(ymuint64 n,
+		    void* blk)
+{
+  os_free(n, blk, mHugePage && n >= kHugePageSize);
+}
+
+// @brief 保持しているスラブを OS に返す．
+void
+SlabPool::trim()
+{
+  vector<void*> tmp_list;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    tmp_list.swap(mFreeList);
+    mSlabNum -= tmp_list.size();
+  }
+  for (vector<void*>::iterator p = tmp_list.begin();
+       p != tmp_list.end(); ++ p) {
+    os_free(mSlabSize, *p, mHugePage);
+  }
+}
+
+// @brief OS から確保しているスラブ数を返す．
+ymuint64
+SlabPool::slab_num() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mSlabNum;
+}
+
+// @brief 再利用のために保持しているスラブ数を返す．
+ymuint64
+SlabPool::free_slab_num() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mFreeList.size();
+}
+
+// @brief slab_num() の今までの最大値を返す．
+ymuint64
+SlabPool::max_slab_num() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mMaxSlabNum;
+}
+
+// @brief 内部状態を出力する．
+void
+SlabPool::print_stats(ostream& s) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  s << "slab size:         " << mSlabSize
+    << (mHugePage ? " (huge page)" : "") << endl
+    << "slab num:          " << mSlabNum << endl
+    << "free slab num:     " << mFreeList.size() << endl
+    << "maximum slab num:  " << mMaxSlabNum << endl
+    << endl;
+}
+
+// @brief OS から領域を確保する．
+// @param[in] n 確保するメモリ量(単位はバイト)
+// @param[in] huge huge page を用いる時 true にする．
+// @param[in] align 境界(2の巾乗)
+void*
+SlabPool::os_alloc(ymuint64 n,
+		   bool huge,
+		   ymuint64 align)
+{
+#if defined(YM_WIN32)
+  void* p = _aligned_malloc(n, align);
+  if ( p == nullptr ) {
+    throw std::bad_alloc();
+  }
+  return p;
+#else
+  if ( huge ) {
+    // align 境界に揃えるために余分に確保して前後を切り捨てる．
+    // align は 2MB 以上になっている．
+    ymuint64 size = huge_round(n);
+    ymuint64 map_size = size + align;
+    void* p = mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ( p == MAP_FAILED ) {
+      throw std::bad_alloc();
+    }
+    char* top = static_cast<char*>(p);
+    ymuint64 top_val = reinterpret_cast<ymuint64>(top);
+    char* aligned = reinterpret_cast<char*>((top_val + align - 1) & ~(align - 1));
+    ymuint64 head = aligned - top;
+    if ( head > 0 ) {
+      munmap(top, head);
+    }
+    ymuint64 tail = map_size - head - size;
+    if ( tail > 0 ) {
+      munmap(aligned + size, tail);
+    }
+#if defined(MADV_HUGEPAGE)
+    madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+    return aligned;
+  }
+  void* p = nullptr;
+  if ( posix_memalign(&p, align, n) != 0 ) {
+    throw std::bad_alloc();
+  }
+  return p;
+#endif
+}
+
+// @brief os_alloc() で確保した領域を OS に返す．
+// @param[in] n 確保したメモリ量(単位はバイト)
+// @param[in] blk 解放する領域
+// @param[in] huge os_alloc() に与えた値
+void
+SlabPool::os_free(ymuint64 n,
+		  void* blk,
+		  bool huge)
+{
+#if defined(YM_WIN32)
+  _aligned_free(blk);
+#else
+  if ( huge ) {
+    munmap(blk, huge_round(n));
+    return;
+  }
+  ::free(blk);
+#endif
+}
+
+END_NAMESPACE_YM
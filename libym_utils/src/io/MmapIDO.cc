@@ -0,0 +1,183 @@
+﻿
+/// @file MmapIDO.cc
+/// @brief MmapIDO の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "YmUtils/MmapIDO.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(YM_WIN32)
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+// クラス MmapIDO
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MmapIDO::MmapIDO() :
+  mData(nullptr),
+  mSize(0),
+  mPos(0),
+  mMapped(false)
+{
+}
+
+// @brief デストラクタ
+MmapIDO::~MmapIDO()
+{
+  close();
+}
+
+// @brief 読み出し可能なら true を返す．
+bool
+MmapIDO::is_ready() const
+{
+  return mData != nullptr && mPos < mSize;
+}
+
+// @brief オープン中のファイル情報を得る．
+const FileInfo&
+MmapIDO::file_info() const
+{
+  return mFileInfo;
+}
+
+// @brief 現在のファイル情報を書き換える．
+// @param[in] file_info 新しいファイル情報
+// @note プリプロセッサのプラグマなどで用いることを想定している．
+// @note 通常は使わないこと．
+void
+MmapIDO::set_file_info(const FileInfo& file_info)
+{
+  mFileInfo = file_info;
+}
+
+// @brief データを読み込む．
+// @param[in] buff 読み込んだデータを格納する領域の先頭アドレス．
+// @param[in] n 読み込むデータサイズ
+// @return 実際に読み込んだ量を返す．
+ymint64
+MmapIDO::read(ymuint8* buff,
+	      ymuint64 n)
+{
+  if ( mData == nullptr ) {
+    return -1;
+  }
+  if ( mPos + n > mSize ) {
+    n = mSize - mPos;
+  }
+  memcpy(reinterpret_cast<void*>(buff),
+	 reinterpret_cast<const void*>(mData + mPos),
+	 n);
+  mPos += n;
+  return n;
+}
+
+// @brief ファイルを開く
+// @param[in] filename ファイル名
+// @note 他のファイルを開いていたら強制的に close する．
+bool
+MmapIDO::open(const string& filename)
+{
+  close();
+
+#if defined(YM_WIN32)
+  int fd = -1;
+  errno_t en = _sopen_s(&fd, filename.c_str(), O_RDONLY | O_BINARY,
+			_SH_DENYWR, 0);
+  if ( en != 0 ) {
+    return false;
+  }
+  struct _stat64 sbuf;
+  if ( _fstat64(fd, &sbuf) != 0 ) {
+    _close(fd);
+    return false;
+  }
+  mSize = sbuf.st_size;
+  mData = new ymuint8[mSize + 1];
+  ymuint64 count = 0;
+  while ( count < mSize ) {
+    int n = _read(fd, mData + count, static_cast<ymuint>(mSize - count));
+    if ( n <= 0 ) {
+      break;
+    }
+    count += n;
+  }
+  _close(fd);
+  if ( count < mSize ) {
+    delete [] mData;
+    mData = nullptr;
+    mSize = 0;
+    return false;
+  }
+  mMapped = false;
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    return false;
+  }
+  struct stat sbuf;
+  if ( fstat(fd, &sbuf) != 0 ) {
+    ::close(fd);
+    return false;
+  }
+  mSize = sbuf.st_size;
+  if ( mSize == 0 ) {
+    // 空のファイルはマップできない．
+    ::close(fd);
+    mData = new ymuint8[1];
+    mMapped = false;
+  }
+  else {
+    void* p = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if ( p == MAP_FAILED ) {
+      mSize = 0;
+      return false;
+    }
+    mData = reinterpret_cast<ymuint8*>(p);
+    mMapped = true;
+  }
+#endif
+
+  mPos = 0;
+  mFileInfo = FileInfo(filename);
+  return true;
+}
+
+// @brief ファイルを閉じる．
+void
+MmapIDO::close()
+{
+  if ( mData ) {
+#if !defined(YM_WIN32)
+    if ( mMapped ) {
+      munmap(reinterpret_cast<void*>(mData), mSize);
+    }
+    else {
+      delete [] mData;
+    }
+#else
+    delete [] mData;
+#endif
+  }
+  mData = nullptr;
+  mSize = 0;
+  mPos = 0;
+  mMapped = false;
+}
+
+END_NAMESPACE_YM
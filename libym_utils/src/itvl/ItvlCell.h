@@ -83,6 +83,7 @@ ItvlCell::ItvlCell(int start,
 		   int end) :
   mStart(start),
   mEnd(end),
+  mBalance(0),
   mLchd(nullptr),
   mRchd(nullptr)
 {
@@ -17,6 +17,34 @@ BEGIN_NONAMESPACE
 
 MsgMgrImpl gTheMgr;
 
+// 現在のスレッドのメッセージを抑制する時 true となるフラグ
+thread_local bool gMute = false;
+
+// 現在のスレッドで抑制されたメッセージ数
+thread_local ymuint32 gMutedNum = 0;
+
+// 現在のスレッドで保留したメッセージを追加するリスト
+thread_local vector<MsgMgr::DeferredMsg>* gDeferList = nullptr;
+
+// 保留するメッセージを追加する．
+void
+defer_msg(const char* src_file,
+	  int src_line,
+	  const FileRegion& file_loc,
+	  MsgType type,
+	  const char* label,
+	  const char* msg)
+{
+  gDeferList->push_back(MsgMgr::DeferredMsg());
+  MsgMgr::DeferredMsg& dmsg = gDeferList->back();
+  dmsg.mSrcFile = src_file;
+  dmsg.mSrcLine = src_line;
+  dmsg.mFileLoc = file_loc;
+  dmsg.mType = type;
+  dmsg.mLabel = label;
+  dmsg.mMsg = msg;
+}
+
 END_NONAMESPACE
 
 
@@ -81,6 +109,14 @@ MsgMgr::put_msg(const char* src_file,
 		const char* label,
 		const char* msg)
 {
+  if ( gMute ) {
+    ++ gMutedNum;
+    return;
+  }
+  if ( gDeferList ) {
+    defer_msg(src_file, src_line, file_loc, type, label, msg);
+    return;
+  }
   gTheMgr.put_msg(src_file, src_line, file_loc, type, label, msg);
 }
 
@@ -97,6 +133,14 @@ MsgMgr::put_msg(const char* src_file,
 		const char* label,
 		const char* msg)
 {
+  if ( gMute ) {
+    ++ gMutedNum;
+    return;
+  }
+  if ( gDeferList ) {
+    defer_msg(src_file, src_line, FileRegion(), type, label, msg);
+    return;
+  }
   gTheMgr.put_msg(src_file, src_line, type, label, msg);
 }
 
@@ -149,4 +193,42 @@ MsgMgr::debug_num()
   return gTheMgr.debug_num();
 }
 
+// @brief 現在のスレッドのメッセージ出力を抑制する．
+// @param[in] mute 抑制する時に true とする．
+void
+MsgMgr::set_mute(bool mute)
+{
+  gMute = mute;
+  gMutedNum = 0;
+}
+
+// @brief 現在のスレッドで抑制されたメッセージ数を得る．
+ymuint32
+MsgMgr::muted_num()
+{
+  return gMutedNum;
+}
+
+// @brief 現在のスレッドのメッセージ出力を保留する．
+// @param[in] msg_list 保留したメッセージを追加するリスト
+// @note nullptr を与えると保留を終了する．
+void
+MsgMgr::set_defer(vector<DeferredMsg>* msg_list)
+{
+  gDeferList = msg_list;
+}
+
+// @brief 保留したメッセージを出力する．
+// @param[in] msg_list メッセージのリスト
+void
+MsgMgr::put_deferred(const vector<DeferredMsg>& msg_list)
+{
+  for (vector<DeferredMsg>::const_iterator p = msg_list.begin();
+       p != msg_list.end(); ++ p) {
+    const DeferredMsg& dmsg = *p;
+    put_msg(dmsg.mSrcFile, dmsg.mSrcLine, dmsg.mFileLoc, dmsg.mType,
+	    dmsg.mLabel.c_str(), dmsg.mMsg.c_str());
+  }
+}
+
 END_NAMESPACE_YM
@@ -34,6 +34,21 @@ Scanner::~Scanner()
 {
 }
 
+// @brief 読み出しを開始する位置を設定する．
+// @param[in] line 行番号
+// @param[in] column コラム位置
+void
+Scanner::set_start_loc(ymuint line,
+		       ymuint column)
+{
+  mCurLine = line;
+  mCurColumn = column;
+  mFirstLine = line;
+  mFirstColumn = column;
+  mNextLine = line;
+  mNextColumn = column;
+}
+
 // @brief peek() の下請け関数
 void
 Scanner::update()
@@ -32,7 +32,8 @@ StrPool::hash_func(const char* str)
 
 // コンストラクタ
 StrPool::StrPool() :
-  mCellAlloc(4096)
+  mCellAlloc(4096),
+  mMtCount(0)
 {
   alloc_table(1024);
   mNum = 0;
@@ -47,6 +48,31 @@ StrPool::~StrPool()
 // 文字列を登録する．
 const char*
 StrPool::reg(const char* str)
+{
+  if ( mMtCount.load() > 0 ) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return _reg(str);
+  }
+  return _reg(str);
+}
+
+// @brief 複数のスレッドから reg() を呼び出す区間の開始/終了を指示する．
+// @param[in] flag 開始する時に true，終了する時に false とする．
+void
+StrPool::set_multi_thread(bool flag)
+{
+  if ( flag ) {
+    ++ mMtCount;
+  }
+  else {
+    ASSERT_COND( mMtCount.load() > 0 );
+    -- mMtCount;
+  }
+}
+
+// @brief reg() の本体
+const char*
+StrPool::_reg(const char* str)
 {
   if ( mTableSize == 0 ) {
     alloc_table(1024);
@@ -142,6 +168,14 @@ ShString::set(const char* str)
   mPtr = thePool.reg(str);
 }
 
+// @brief 複数のスレッドから共有文字列を作る区間の開始/終了を指示する．
+// @param[in] flag 開始する時に true，終了する時に false とする．
+void
+ShString::set_multi_thread(bool flag)
+{
+  thePool.set_multi_thread(flag);
+}
+
 // @brief ShString 関連でアロケートされたメモリサイズ
 ymuint64
 ShString::allocated_size()
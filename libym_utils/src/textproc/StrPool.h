@@ -10,6 +10,8 @@
 
 
 #include "YmUtils/SimpleAlloc.h"
+#include <atomic>
+#include <mutex>
 
 
 BEGIN_NAMESPACE_YM
@@ -44,9 +46,18 @@ public:
   /// @brief 文字列を登録する．
   /// @param[in] str 入力となる文字列
   /// @return カノニカライズされた文字列を返す．
+  /// @note 複数のスレッドから同時に呼び出す場合には
+  /// あらかじめ set_multi_thread(true) を呼んでおく必要がある．
   const char*
   reg(const char* str);
 
+  /// @brief 複数のスレッドから reg() を呼び出す区間の開始/終了を指示する．
+  /// @param[in] flag 開始する時に true，終了する時に false とする．
+  /// @note 入れ子にしてよい．
+  /// @note 区間の外では reg() は排他制御を行わない．
+  void
+  set_multi_thread(bool flag);
+
   /// @brief 確保した文字列領域の総量を得る．
   /// @return 確保した文字列領域の総量を得る．
   /// @note デバッグ/解析用 -- 通常は使わない．
@@ -71,6 +82,12 @@ private:
   ymuint32
   hash_func(const char* str);
 
+  /// @brief reg() の本体
+  /// @param[in] str 入力となる文字列
+  /// @return カノニカライズされた文字列を返す．
+  const char*
+  _reg(const char* str);
+
   /// @brief テーブルを確保して初期化する．
   /// @param[in] new_size 新しいテーブルサイズ
   void
@@ -121,6 +138,13 @@ private:
   // Cell を確保するためのアロケータ
   SimpleAlloc mCellAlloc;
 
+  // set_multi_thread(true) の入れ子の深さ
+  std::atomic<ymuint32> mMtCount;
+
+  // reg() を排他的に行うための mutex
+  // mMtCount が 0 でない時のみ用いる．
+  std::mutex mMutex;
+
 };
 
 END_NAMESPACE_YM
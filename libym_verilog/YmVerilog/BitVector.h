@@ -138,6 +138,11 @@ public:
   /// @param[in] src コピー元のオブジェクト
   BitVector(const BitVector& src);
 
+  /// @brief ムーブコンストラクタ
+  /// @param[in] src ムーブ元のオブジェクト
+  /// @note src の内容は不定になる．
+  BitVector(BitVector&& src);
+
   /// @brief ビット長の変換を行うコピーコンストラクタもどき
   /// @param[in] src 返還元ののビットベクタ
   /// @param[in] size 指定サイズ
@@ -161,12 +166,22 @@ public:
 	    bool is_signed,
 	    ymuint32 base);
 
+  /// @brief デストラクタ
+  ~BitVector();
+
   /// @brief 代入演算子
   /// @param[in] src コピー元のオブジェクト
   /// @return 自分自身
   const BitVector&
   operator=(const BitVector& src);
 
+  /// @brief ムーブ代入演算子
+  /// @param[in] src ムーブ元のオブジェクト
+  /// @return 自分自身
+  /// @note src の内容は不定になる．
+  const BitVector&
+  operator=(BitVector&& src);
+
   /// @brief 符号なし整数からの代入演算子
   /// @param[in] val 値
   /// @note 結果の型は
@@ -791,6 +806,15 @@ private:
   void
   resize(ymuint32 size);
 
+  // mVal0, mVal1 の領域を解放する．
+  void
+  free_buff();
+
+  // src の領域を自分のものにする．
+  // src は空になる．
+  void
+  move_buff(BitVector& src);
+
   // 属性(サイズの有無, 符号の有無, 基数)をセットする．
   void
   set_type(bool has_size,
@@ -895,6 +919,29 @@ private:
   mask(ymuint32 size);
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 定数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ymuint32 のビット長
+  static
+  const ymuint32 kBlockSize = sizeof(ymuint32) * 8;
+
+  /// @brief すべてが0のパタン
+  static
+  const ymuint32 kAll0 = 0x00000000;
+
+  /// @brief すべてが1のパタン
+  static
+  const ymuint32 kAll1 = 0xFFFFFFFF;
+
+  /// @brief mBuff に収めるブロック数
+  /// @note 128 ビットまでの値はヒープを使わない．
+  static
+  const ymuint32 kInlineBlockNum = 4;
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -909,26 +956,14 @@ private:
   // 値を保持するベクタ
   // サイズは block(mSize)
   // mVal0:Val1 の組み合わせで値を表す．
+  // ブロック数が kInlineBlockNum 以下の時は mBuff を指す．
+  // それ以外の時は mVal0 の領域の後半を mVal1 に用いる．
   ymuint32* mVal0;
   ymuint32* mVal1;
 
-
-private:
-  //////////////////////////////////////////////////////////////////////
-  // 定数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief ymuint32 のビット長
-  static
-  const ymuint32 kBlockSize = sizeof(ymuint32) * 8;
-
-  /// @brief すべてが0のパタン
-  static
-  const ymuint32 kAll0 = 0x00000000;
-
-  /// @brief すべてが1のパタン
-  static
-  const ymuint32 kAll1 = 0xFFFFFFFF;
+  // 小さな値を収める領域
+  // 前半を mVal0 に，後半を mVal1 に用いる．
+  ymuint32 mBuff[kInlineBlockNum * 2];
 
 };
 
@@ -1467,7 +1502,9 @@ inline
 BitVector
 operator-(const BitVector& src)
 {
-  return BitVector(src).complement();
+  BitVector ans(src);
+  ans.complement();
+  return ans;
 }
 
 // 加算
@@ -1476,7 +1513,9 @@ BitVector
 operator+(const BitVector& src1,
 	  const BitVector& src2)
 {
-  return BitVector(src1) += src2;
+  BitVector ans(src1);
+  ans += src2;
+  return ans;
 }
 
 // 減算
@@ -1485,7 +1524,9 @@ BitVector
 operator-(const BitVector& src1,
 	  const BitVector& src2)
 {
-  return BitVector(src1) -= src2;
+  BitVector ans(src1);
+  ans -= src2;
+  return ans;
 }
 
 // 乗算
@@ -1494,7 +1535,9 @@ BitVector
 operator*(const BitVector& src1,
 	  const BitVector& src2)
 {
-  return BitVector(src1) *= src2;
+  BitVector ans(src1);
+  ans *= src2;
+  return ans;
 }
 
 // 除算
@@ -1503,7 +1546,9 @@ BitVector
 operator/(const BitVector& src1,
 	  const BitVector& src2)
 {
-  return BitVector(src1) /= src2;
+  BitVector ans(src1);
+  ans /= src2;
+  return ans;
 }
 
 // 剰余算
@@ -1512,7 +1557,9 @@ BitVector
 operator%(const BitVector& src1,
 	  const BitVector& src2)
 {
-  return BitVector(src1) %= src2;
+  BitVector ans(src1);
+  ans %= src2;
+  return ans;
 }
 
 // 巾乗
@@ -1521,7 +1568,9 @@ BitVector
 power(const BitVector& src1,
       const BitVector& src2)
 {
-  return BitVector(src1).power(src2);
+  BitVector ans(src1);
+  ans.power(src2);
+  return ans;
 }
 
 // greater than 比較演算
@@ -1601,7 +1650,9 @@ inline
 BitVector
 operator~(const BitVector& src)
 {
-  return BitVector(src).negate();
+  BitVector ans(src);
+  ans.negate();
+  return ans;
 }
 
 // 論理積
@@ -1610,7 +1661,9 @@ BitVector
 operator&(const BitVector& src1,
 	  const BitVector& src2)
 {
-  return BitVector(src1) &= src2;
+  BitVector ans(src1);
+  ans &= src2;
+  return ans;
 }
 
 // 論理和
@@ -1619,7 +1672,9 @@ BitVector
 operator|(const BitVector& src1,
 	  const BitVector& src2)
 {
-  return BitVector(src1) |= src2;
+  BitVector ans(src1);
+  ans |= src2;
+  return ans;
 }
 
 // 排他的論理和
@@ -1628,7 +1683,9 @@ BitVector
 operator^(const BitVector& src1,
 	  const BitVector& src2)
 {
-  return BitVector(src1) ^= src2;
+  BitVector ans(src1);
+  ans ^= src2;
+  return ans;
 }
 
 // 論理左シフト
@@ -1637,7 +1694,9 @@ BitVector
 operator<<(const BitVector& src1,
 	   const BitVector& src2)
 {
-  return BitVector(src1) <<= src2;
+  BitVector ans(src1);
+  ans <<= src2;
+  return ans;
 }
 
 // 論理左シフト src2 が ymuint32 のバージョン
@@ -1646,7 +1705,9 @@ BitVector
 operator<<(const BitVector& src1,
 	   ymuint32 src2)
 {
-  return BitVector(src1) <<= src2;
+  BitVector ans(src1);
+  ans <<= src2;
+  return ans;
 }
 
 // 論理右シフト
@@ -1655,7 +1716,9 @@ BitVector
 operator>>(const BitVector& src1,
 	   const BitVector& src2)
 {
-  return BitVector(src1) >>= src2;
+  BitVector ans(src1);
+  ans >>= src2;
+  return ans;
 }
 
 // 論理右シフト src2 が ymuint32 のバージョン
@@ -1664,7 +1727,9 @@ BitVector
 operator>>(const BitVector& src1,
 	   ymuint32 src2)
 {
-  return BitVector(src1) >>= src2;
+  BitVector ans(src1);
+  ans >>= src2;
+  return ans;
 }
 
 // 算術左シフトつき代入
@@ -1712,7 +1777,9 @@ BitVector
 arshift(const BitVector& src1,
 	const BitVector& src2)
 {
-  return BitVector(src1).arshift(src2);
+  BitVector ans(src1);
+  ans.arshift(src2);
+  return ans;
 }
 
 // 算術右シフト src2 が ymuint32 のバージョン
@@ -1721,7 +1788,9 @@ BitVector
 arshift(const BitVector& src1,
 	ymuint32 src2)
 {
-  return BitVector(src1).arshift(src2);
+  BitVector ans(src1);
+  ans.arshift(src2);
+  return ans;
 }
 
 // @brief 型を返す．
@@ -62,6 +62,22 @@ public:
 	    const SearchPathList& searchpath = SearchPathList(),
 	    const list<VlLineWatcher*> watcher_list = list<VlLineWatcher*>());
 
+  /// @brief ライブラリファイルを読み込む．
+  /// @param[in] filename 読み込むファイル名
+  /// @param[in] searchpath サーチパス
+  /// @param[in] watcher_list 行番号ウォッチャーのリスト
+  /// @retval true 正常に終了した．
+  /// @retval false エラーが起こった．
+  /// @note ライブラリファイル中のモジュールと UDP は名前だけを登録しておき，
+  /// elaborate() の時にインスタンスとして参照されているものだけ
+  /// 本体を読み込む．そのためトップモジュールにはならない．
+  /// @note read_file() で読み込んだものと同名のものは用いられない．
+  /// 複数のライブラリに同名のものがある場合には先に読み込んだものが用いられる．
+  bool
+  read_library(const string& filename,
+	       const SearchPathList& searchpath = SearchPathList(),
+	       const list<VlLineWatcher*> watcher_list = list<VlLineWatcher*>());
+
   /// @brief 登録されているモジュールのリストを返す．
   /// @return 登録されているモジュールのリスト
   const list<const PtModule*>&
@@ -80,9 +96,11 @@ public:
 
   /// @brief エラボレーションを行う．
   /// @param[in] cell_library セルライブラリ
+  /// @param[in] thread_num phase2/phase3 の処理に用いるスレッド数
   /// @param[in] エラー数を返す．
   ymuint
-  elaborate(const CellLibrary* cell_library = nullptr);
+  elaborate(const CellLibrary* cell_library = nullptr,
+	    ymuint thread_num = 1);
 
   /// @brief UDP 定義のリストを返す．
   const list<const VlUdpDefn*>&
@@ -263,6 +281,18 @@ public:
   allocated_size() const;
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 参照されているライブラリモジュールの本体を読み込む．
+  /// @retval true 正常に終了した．
+  /// @retval false エラーが起こった．
+  bool
+  load_lib_modules();
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -271,6 +301,14 @@ private:
   // ここで生成するオブジェクト用のアロケータ
   SimpleAlloc mAlloc;
 
+  // ライブラリファイル名のリスト
+  // 添字がライブラリ番号となる．
+  vector<string> mLibFileList;
+
+  // ライブラリファイルのサーチパスのリスト
+  // 添字はライブラリ番号
+  vector<SearchPathList> mLibPathList;
+
   // Pt オブジェクトを管理するクラス
   PtMgr* mPtMgr;
 
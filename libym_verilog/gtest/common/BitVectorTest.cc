@@ -0,0 +1,392 @@
+﻿
+/// @file BitVectorTest.cc
+/// @brief BitVectorTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmVerilog/BitVector.h"
+#include <sstream>
+#include <iomanip>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// 多倍長整数を 32 ビットのブロックの配列(下位から)で表す．
+typedef vector<ymuint32> Limbs;
+
+// 簡単な擬似乱数
+ymuint64
+next_rand(ymuint64& seed)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+// n ブロックの乱数を作る．
+// 桁上がりの起きやすい値も混ぜる．
+Limbs
+rand_limbs(ymuint n,
+	   ymuint64& seed)
+{
+  Limbs ans(n);
+  ymuint mode = next_rand(seed) % 4;
+  for (ymuint i = 0; i < n; ++ i) {
+    switch ( mode ) {
+    case 0: ans[i] = 0xFFFFFFFFU; break;
+    case 1: ans[i] = (next_rand(seed) % 4) ? 0xFFFFFFFFU : 0U; break;
+    default: ans[i] = static_cast<ymuint32>(next_rand(seed)); break;
+    }
+  }
+  return ans;
+}
+
+// ブロックの配列から n ブロック分の BitVector を作る．
+BitVector
+to_bv(const Limbs& val,
+      ymuint n)
+{
+  ostringstream buf;
+  buf << hex << setfill('0');
+  for (ymuint i = n; i -- > 0; ) {
+    ymuint32 v = (i < val.size()) ? val[i] : 0U;
+    buf << setw(8) << v;
+  }
+  return BitVector(n * 32, false, 16, buf.str());
+}
+
+// BitVector の値をブロックの配列に変換する．
+// ビット長は 32 の倍数でなければならない．
+Limbs
+from_bv(const BitVector& bv)
+{
+  string str = bv.hex_str(false);
+  ymuint n = str.size() / 8;
+  Limbs ans(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    string tmp = str.substr((n - 1 - i) * 8, 8);
+    ans[i] = static_cast<ymuint32>(strtoul(tmp.c_str(), nullptr, 16));
+  }
+  return ans;
+}
+
+// 筆算による乗算
+Limbs
+ref_mult(const Limbs& a,
+	 const Limbs& b)
+{
+  Limbs ans(a.size() + b.size(), 0U);
+  for (ymuint i = 0; i < a.size(); ++ i) {
+    ymuint64 carry = 0;
+    for (ymuint j = 0; j < b.size(); ++ j) {
+      ymuint64 t = static_cast<ymuint64>(a[i]) * b[j] + ans[i + j] + carry;
+      ans[i + j] = static_cast<ymuint32>(t);
+      carry = t >> 32;
+    }
+    ans[i + b.size()] = static_cast<ymuint32>(carry);
+  }
+  return ans;
+}
+
+// a += b (a の方が長いとする)
+void
+ref_add(Limbs& a,
+	const Limbs& b)
+{
+  ymuint64 carry = 0;
+  for (ymuint i = 0; i < a.size(); ++ i) {
+    ymuint64 t = static_cast<ymuint64>(a[i]) + carry;
+    if ( i < b.size() ) {
+      t += b[i];
+    }
+    a[i] = static_cast<ymuint32>(t);
+    carry = t >> 32;
+  }
+}
+
+// a < b の時 true を返す．
+bool
+ref_lt(const Limbs& a,
+       const Limbs& b)
+{
+  ymuint n = a.size() > b.size() ? a.size() : b.size();
+  for (ymuint i = n; i -- > 0; ) {
+    ymuint32 av = i < a.size() ? a[i] : 0U;
+    ymuint32 bv = i < b.size() ? b[i] : 0U;
+    if ( av != bv ) {
+      return av < bv;
+    }
+  }
+  return false;
+}
+
+// 長さをそろえて比較する．
+::testing::AssertionResult
+limbs_eq(const Limbs& a,
+	 const Limbs& b)
+{
+  ymuint n = a.size() > b.size() ? a.size() : b.size();
+  for (ymuint i = 0; i < n; ++ i) {
+    ymuint32 av = i < a.size() ? a[i] : 0U;
+    ymuint32 bv = i < b.size() ? b[i] : 0U;
+    if ( av != bv ) {
+      return ::testing::AssertionFailure() << "differ at block#" << i
+					   << ": " << hex << av << " vs " << bv;
+    }
+  }
+  return ::testing::AssertionSuccess();
+}
+
+// n ブロックで u / v, u % v を計算し q * v + r == u かつ r < v を確かめる．
+void
+check_divmod(const Limbs& u,
+	     const Limbs& v,
+	     ymuint n)
+{
+  BitVector bu = to_bv(u, n);
+  BitVector bv = to_bv(v, n);
+  Limbs q = from_bv(bu / bv);
+  Limbs r = from_bv(bu % bv);
+  ASSERT_EQ( n, q.size() );
+  ASSERT_EQ( n, r.size() );
+
+  Limbs qv = ref_mult(q, v);
+  ref_add(qv, r);
+  EXPECT_TRUE( limbs_eq(u, qv) );
+  EXPECT_TRUE( ref_lt(r, v) );
+}
+
+// すべてのビットが X なら true を返す．
+bool
+is_all_x(const BitVector& bv)
+{
+  for (ymuint i = 0; i < bv.size(); ++ i) {
+    if ( !bv.value(i).is_x() ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
+
+TEST(BitVectorTest, mult_small)
+{
+  BitVector a(32, false, 16, "ffffffff");
+  EXPECT_EQ( string("00000001"), (a * a).hex_str(false) );
+
+  BitVector b(64, false, 16, "ffffffff");
+  EXPECT_EQ( string("FFFFFFFE00000001"), (b * b).hex_str(false) );
+
+  BitVector c(64, false, 16, "ffffffffffffffff");
+  EXPECT_EQ( string("0000000000000001"), (c * c).hex_str(false) );
+
+  EXPECT_EQ( -42, (BitVector(-6) * BitVector(7)).to_int() );
+  EXPECT_EQ( 42, (BitVector(-6) * BitVector(-7)).to_int() );
+}
+
+TEST(BitVectorTest, mult_low)
+{
+  // Karatsuba 法の閾値(32 ブロック)未満は下位ブロックのみを求める．
+  ymuint64 seed = 0x123456789ABCDEFULL;
+  ymuint n_list[] = { 1, 2, 3, 4, 5, 8, 17, 31 };
+  for (ymuint k = 0; k < sizeof(n_list) / sizeof(ymuint); ++ k) {
+    ymuint n = n_list[k];
+    for (ymuint c = 0; c < 20; ++ c) {
+      Limbs a = rand_limbs(n, seed);
+      Limbs b = rand_limbs(n, seed);
+      Limbs ans = from_bv(to_bv(a, n) * to_bv(b, n));
+      Limbs exp_ans = ref_mult(a, b);
+      exp_ans.resize(n);
+      EXPECT_TRUE( limbs_eq(exp_ans, ans) ) << "n = " << n;
+    }
+  }
+}
+
+TEST(BitVectorTest, mult_full)
+{
+  // オペランドを 2 倍の長さに拡張すると全桁の積が得られる．
+  // 2n が 32 以上なら Karatsuba 法が用いられる．
+  ymuint64 seed = 0xFEDCBA9876543210ULL;
+  ymuint n_list[] = { 15, 16, 17, 31, 32, 33, 47, 64, 95 };
+  for (ymuint k = 0; k < sizeof(n_list) / sizeof(ymuint); ++ k) {
+    ymuint n = n_list[k];
+    for (ymuint c = 0; c < 8; ++ c) {
+      Limbs a = rand_limbs(n, seed);
+      Limbs b = rand_limbs(n, seed);
+      Limbs exp_ans = ref_mult(a, b);
+
+      Limbs ans = from_bv(to_bv(a, n * 2) * to_bv(b, n * 2));
+      EXPECT_TRUE( limbs_eq(exp_ans, ans) ) << "n = " << n;
+
+      // 閾値以上で切り捨てる場合
+      Limbs ans2 = from_bv(to_bv(a, n) * to_bv(b, n));
+      Limbs exp_ans2(exp_ans.begin(), exp_ans.begin() + n);
+      EXPECT_TRUE( limbs_eq(exp_ans2, ans2) ) << "n = " << n;
+    }
+  }
+}
+
+TEST(BitVectorTest, divmod_small)
+{
+  EXPECT_EQ( 3, (BitVector(7) / BitVector(2)).to_int() );
+  EXPECT_EQ( 1, (BitVector(7) % BitVector(2)).to_int() );
+  // 符号付きの除算は 0 方向に丸め，余りの符号は被除数に従う．
+  EXPECT_EQ( -3, (BitVector(-7) / BitVector(2)).to_int() );
+  EXPECT_EQ( -1, (BitVector(-7) % BitVector(2)).to_int() );
+  EXPECT_EQ( -3, (BitVector(7) / BitVector(-2)).to_int() );
+  EXPECT_EQ( 1, (BitVector(7) % BitVector(-2)).to_int() );
+
+  // 1 ブロックの除数
+  BitVector u(128, false, 16, "0123456789abcdeffedcba9876543210");
+  BitVector v(128, false, 16, "10");
+  EXPECT_EQ( string("00123456789ABCDEFFEDCBA987654321"), (u / v).hex_str(false) );
+  EXPECT_EQ( string("00000000000000000000000000000000"), (u % v).hex_str(false) );
+
+  // 被除数の方が小さい
+  BitVector w(128, false, 16, "1000000000000000000000000");
+  BitVector x(128, false, 16, "ffffffffffffffffffffffff");
+  EXPECT_EQ( string("00000000000000000000000000000000"), (x / w).hex_str(false) );
+  EXPECT_EQ( x.hex_str(false), (x % w).hex_str(false) );
+}
+
+TEST(BitVectorTest, divmod_add_back)
+{
+  // 推定した商が 1 大きすぎて足し戻しが必要になる例
+  // (Hacker's Delight の divmnu64 のテストケース)
+  {
+    Limbs u(4);
+    u[0] = 0x00000000U; u[1] = 0x00000000U; u[2] = 0x80000000U; u[3] = 0x7FFFFFFFU;
+    Limbs v(3);
+    v[0] = 0x00000001U; v[1] = 0x00000000U; v[2] = 0x80000000U;
+    check_divmod(u, v, 4);
+    Limbs q = from_bv(to_bv(u, 4) / to_bv(v, 4));
+    EXPECT_EQ( 0xFFFFFFFEU, q[0] );
+    EXPECT_EQ( 0U, q[1] );
+  }
+  {
+    Limbs u(3);
+    u[0] = 0x00000003U; u[1] = 0x00000000U; u[2] = 0x80000000U;
+    Limbs v(3);
+    v[0] = 0x00000001U; v[1] = 0x00000000U; v[2] = 0x20000000U;
+    check_divmod(u, v, 3);
+    Limbs q = from_bv(to_bv(u, 3) / to_bv(v, 3));
+    EXPECT_EQ( 3U, q[0] );
+  }
+  {
+    Limbs u(4);
+    u[0] = 0x00000000U; u[1] = 0x00000000U; u[2] = 0x00008000U; u[3] = 0x00007FFFU;
+    Limbs v(3);
+    v[0] = 0x00000001U; v[1] = 0x00000000U; v[2] = 0x00008000U;
+    check_divmod(u, v, 4);
+  }
+}
+
+TEST(BitVectorTest, divmod_random)
+{
+  ymuint64 seed = 0x9E3779B97F4A7C15ULL;
+  ymuint n_list[] = { 1, 2, 3, 4, 5, 8, 33 };
+  for (ymuint k = 0; k < sizeof(n_list) / sizeof(ymuint); ++ k) {
+    ymuint n = n_list[k];
+    for (ymuint c = 0; c < 50; ++ c) {
+      Limbs u = rand_limbs(n, seed);
+      // 除数の長さも変える．
+      ymuint vn = 1 + next_rand(seed) % n;
+      Limbs v = rand_limbs(vn, seed);
+      if ( v[vn - 1] == 0U ) {
+	v[vn - 1] = 1U << (next_rand(seed) % 32);
+      }
+      check_divmod(u, v, n);
+    }
+  }
+}
+
+TEST(BitVectorTest, div_by_zero)
+{
+  ymuint size_list[] = { 8, 32, 100, 128, 129, 300 };
+  for (ymuint k = 0; k < sizeof(size_list) / sizeof(ymuint); ++ k) {
+    ymuint size = size_list[k];
+    BitVector a(size, false, 10, "12345");
+    BitVector z(size, false, 10, "0");
+    BitVector q = a / z;
+    BitVector r = a % z;
+    EXPECT_EQ( size, q.size() );
+    EXPECT_EQ( size, r.size() );
+    EXPECT_TRUE( is_all_x(q) ) << "size = " << size;
+    EXPECT_TRUE( is_all_x(r) ) << "size = " << size;
+  }
+
+  EXPECT_TRUE( is_all_x(BitVector(-5) / BitVector(0)) );
+  EXPECT_TRUE( is_all_x(BitVector(-5) % BitVector(0)) );
+}
+
+TEST(BitVectorTest, inline_buffer)
+{
+  // kInlineBlockNum (4 ブロック = 128 ビット) の前後で
+  // コピー，ムーブ，拡張を行う．
+  ymuint64 seed = 0x2545F4914F6CDD1DULL;
+  ymuint size_list[] = { 1, 31, 32, 33, 96, 127, 128, 129, 160, 256 };
+  const ymuint ns = sizeof(size_list) / sizeof(ymuint);
+  for (ymuint i = 0; i < ns; ++ i) {
+    ymuint size1 = size_list[i];
+    Limbs v1 = rand_limbs((size1 + 31) / 32, seed);
+    BitVector a = BitVector(to_bv(v1, (size1 + 31) / 32), size1);
+    string str1 = a.hex_str(false);
+
+    // コピーとムーブ
+    BitVector b(a);
+    EXPECT_EQ( str1, b.hex_str(false) );
+    BitVector c(std::move(b));
+    EXPECT_EQ( str1, c.hex_str(false) );
+    EXPECT_EQ( size1, c.size() );
+
+    for (ymuint j = 0; j < ns; ++ j) {
+      ymuint size2 = size_list[j];
+      Limbs v2 = rand_limbs((size2 + 31) / 32, seed);
+      BitVector d = BitVector(to_bv(v2, (size2 + 31) / 32), size2);
+      string str2 = d.hex_str(false);
+
+      // ムーブ代入
+      BitVector e(c);
+      e = std::move(d);
+      EXPECT_EQ( str2, e.hex_str(false) );
+      EXPECT_EQ( size2, e.size() );
+
+      // ムーブ元にも代入し直せる．
+      d = c;
+      EXPECT_EQ( str1, d.hex_str(false) );
+
+      // コピー代入で大きさが変わる．
+      e = c;
+      EXPECT_EQ( str1, e.hex_str(false) );
+      e = d = BitVector(to_bv(v2, (size2 + 31) / 32), size2);
+      EXPECT_EQ( str2, e.hex_str(false) );
+
+      // 長さの変換
+      BitVector f(c, size2);
+      EXPECT_EQ( size2, f.size() );
+      for (ymuint b = 0; b < size2; ++ b) {
+	VlScalarVal exp_val = b < size1 ? c.value(b) : VlScalarVal::zero();
+	EXPECT_EQ( exp_val, f.value(b) );
+      }
+
+      // 自分自身の拡張を伴う演算
+      if ( size1 < size2 ) {
+	BitVector g(c);
+	g *= BitVector(size2, false, 10, "1");
+	EXPECT_EQ( size2, g.size() );
+	EXPECT_EQ( f.hex_str(false), g.hex_str(false) );
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM_VERILOG
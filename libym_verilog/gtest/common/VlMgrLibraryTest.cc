@@ -0,0 +1,247 @@
+﻿
+/// @file VlMgrLibraryTest.cc
+/// @brief VlMgr::read_library() のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmVerilog/VlMgr.h"
+#include "YmVerilog/pt/PtModule.h"
+#include "YmVerilog/pt/PtUdp.h"
+#include "YmVerilog/vl/VlModule.h"
+#include <fstream>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// ファイルを書き出す．
+bool
+write_file(const string& filename,
+	   const char* text)
+{
+  ofstream ofs(filename.c_str());
+  if ( !ofs ) {
+    return false;
+  }
+  ofs << text;
+  return true;
+}
+
+// パース木のモジュール名のリストを得る．
+vector<string>
+pt_module_names(const VlMgr& mgr)
+{
+  vector<string> name_list;
+  const list<const PtModule*>& module_list = mgr.pt_module_list();
+  for (list<const PtModule*>::const_iterator p = module_list.begin();
+       p != module_list.end(); ++ p) {
+    name_list.push_back((*p)->name());
+  }
+  sort(name_list.begin(), name_list.end());
+  return name_list;
+}
+
+// パース木の UDP 名のリストを得る．
+vector<string>
+pt_udp_names(const VlMgr& mgr)
+{
+  vector<string> name_list;
+  const list<const PtUdp*>& udp_list = mgr.pt_udp_list();
+  for (list<const PtUdp*>::const_iterator p = udp_list.begin();
+       p != udp_list.end(); ++ p) {
+    name_list.push_back((*p)->name());
+  }
+  sort(name_list.begin(), name_list.end());
+  return name_list;
+}
+
+// トップモジュール名のリストを得る．
+vector<string>
+top_names(const VlMgr& mgr)
+{
+  vector<string> name_list;
+  const list<const VlModule*>& module_list = mgr.topmodule_list();
+  for (list<const VlModule*>::const_iterator p = module_list.begin();
+       p != module_list.end(); ++ p) {
+    name_list.push_back((*p)->def_name());
+  }
+  sort(name_list.begin(), name_list.end());
+  return name_list;
+}
+
+// 2つの入力を持つライブラリ
+const char* kLibText =
+  "(* keep = 1 *)\n"
+  "module lib_and(o, a, b);\n"
+  "  output o;\n"
+  "  input a, b;\n"
+  "  assign o = a & b;\n"
+  "endmodule\n"
+  "\n"
+  "(* keep = 1 *) (* dont_touch *)\n"
+  "module lib_unused(o, a);\n"
+  "  output o;\n"
+  "  input a;\n"
+  "  assign o = ~a;\n"
+  "endmodule\n"
+  "\n"
+  "(* dont_use *)\n"
+  "primitive lib_inv(y, a);\n"
+  "  output y;\n"
+  "  input a;\n"
+  "  table\n"
+  "    0 : 1 ;\n"
+  "    1 : 0 ;\n"
+  "  endtable\n"
+  "endprimitive\n"
+  "\n"
+  "(* dont_use *)\n"
+  "primitive lib_buf(y, a);\n"
+  "  output y;\n"
+  "  input a;\n"
+  "  table\n"
+  "    0 : 0 ;\n"
+  "    1 : 1 ;\n"
+  "  endtable\n"
+  "endprimitive\n"
+  "\n"
+  "module lib_mid(o, a, b);\n"
+  "  output o;\n"
+  "  input a, b;\n"
+  "  wire w;\n"
+  "  lib_and u0(w, a, b);\n"
+  "  lib_inv (o, w);\n"
+  "endmodule\n"
+  "\n"
+  "(* keep *)\n"
+  "module lib_wrap(o, a, b);\n"
+  "  output o;\n"
+  "  input a, b;\n"
+  "  lib_mid u0(o, a, b);\n"
+  "endmodule\n";
+
+END_NONAMESPACE
+
+
+// attribute instance の付いたライブラリモジュールを2回インスタンス化する．
+TEST(VlMgrLibraryTest, attr_module)
+{
+  string lib_file = ::testing::TempDir() + "VlMgrLibraryTest_lib1.v";
+  string top_file = ::testing::TempDir() + "VlMgrLibraryTest_top1.v";
+  ASSERT_TRUE( write_file(lib_file, kLibText) );
+  ASSERT_TRUE( write_file(top_file,
+			  "module top(o1, o2, a, b, c);\n"
+			  "  output o1, o2;\n"
+			  "  input a, b, c;\n"
+			  "  lib_and u1(o1, a, b);\n"
+			  "  lib_and u2(o2, b, c);\n"
+			  "endmodule\n") );
+
+  VlMgr mgr;
+  ASSERT_TRUE( mgr.read_library(lib_file) );
+  ASSERT_TRUE( mgr.read_file(top_file) );
+  // 名前を登録するだけなので本体は読み込まれない．
+  EXPECT_EQ( 1U, mgr.pt_module_list().size() );
+  EXPECT_EQ( 0U, mgr.pt_udp_list().size() );
+
+  EXPECT_EQ( 0U, mgr.elaborate() );
+
+  vector<string> module_names = pt_module_names(mgr);
+  ASSERT_EQ( 2U, module_names.size() );
+  EXPECT_EQ( "lib_and", module_names[0] );
+  EXPECT_EQ( "top", module_names[1] );
+  EXPECT_EQ( 0U, mgr.pt_udp_list().size() );
+
+  vector<string> tops = top_names(mgr);
+  ASSERT_EQ( 1U, tops.size() );
+  EXPECT_EQ( "top", tops[0] );
+
+  remove(lib_file.c_str());
+  remove(top_file.c_str());
+}
+
+// 何段にもわたって参照されるライブラリモジュール
+TEST(VlMgrLibraryTest, nested)
+{
+  string lib_file = ::testing::TempDir() + "VlMgrLibraryTest_lib2.v";
+  string top_file = ::testing::TempDir() + "VlMgrLibraryTest_top2.v";
+  ASSERT_TRUE( write_file(lib_file, kLibText) );
+  ASSERT_TRUE( write_file(top_file,
+			  "module top(o1, o2, a, b, c);\n"
+			  "  output o1, o2;\n"
+			  "  input a, b, c;\n"
+			  "  lib_wrap u1(o1, a, b);\n"
+			  "  lib_wrap u2(o2, b, c);\n"
+			  "endmodule\n") );
+
+  VlMgr mgr;
+  ASSERT_TRUE( mgr.read_library(lib_file) );
+  ASSERT_TRUE( mgr.read_file(top_file) );
+
+  EXPECT_EQ( 0U, mgr.elaborate() );
+
+  vector<string> module_names = pt_module_names(mgr);
+  ASSERT_EQ( 4U, module_names.size() );
+  EXPECT_EQ( "lib_and", module_names[0] );
+  EXPECT_EQ( "lib_mid", module_names[1] );
+  EXPECT_EQ( "lib_wrap", module_names[2] );
+  EXPECT_EQ( "top", module_names[3] );
+
+  vector<string> udp_names = pt_udp_names(mgr);
+  ASSERT_EQ( 1U, udp_names.size() );
+  EXPECT_EQ( "lib_inv", udp_names[0] );
+
+  vector<string> tops = top_names(mgr);
+  ASSERT_EQ( 1U, tops.size() );
+  EXPECT_EQ( "top", tops[0] );
+
+  remove(lib_file.c_str());
+  remove(top_file.c_str());
+}
+
+// read_file() で同名のモジュールが定義されている場合
+TEST(VlMgrLibraryTest, override)
+{
+  string lib_file = ::testing::TempDir() + "VlMgrLibraryTest_lib3.v";
+  string top_file = ::testing::TempDir() + "VlMgrLibraryTest_top3.v";
+  ASSERT_TRUE( write_file(lib_file, kLibText) );
+  ASSERT_TRUE( write_file(top_file,
+			  "module top(o1, a, b);\n"
+			  "  output o1;\n"
+			  "  input a, b;\n"
+			  "  lib_mid u1(o1, a, b);\n"
+			  "endmodule\n"
+			  "\n"
+			  "module lib_and(o, a, b);\n"
+			  "  output o;\n"
+			  "  input a, b;\n"
+			  "  assign o = a | b;\n"
+			  "endmodule\n") );
+
+  VlMgr mgr;
+  ASSERT_TRUE( mgr.read_library(lib_file) );
+  ASSERT_TRUE( mgr.read_file(top_file) );
+
+  EXPECT_EQ( 0U, mgr.elaborate() );
+
+  vector<string> module_names = pt_module_names(mgr);
+  ASSERT_EQ( 3U, module_names.size() );
+  EXPECT_EQ( "lib_and", module_names[0] );
+  EXPECT_EQ( "lib_mid", module_names[1] );
+  EXPECT_EQ( "top", module_names[2] );
+
+  vector<string> tops = top_names(mgr);
+  ASSERT_EQ( 1U, tops.size() );
+  EXPECT_EQ( "top", tops[0] );
+
+  remove(lib_file.c_str());
+  remove(top_file.c_str());
+}
+
+END_NAMESPACE_YM_VERILOG
@@ -0,0 +1,237 @@
+﻿
+/// @file ElaboratorTest.cc
+/// @brief Elaborator の並列処理のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "YmVerilog/VlMgr.h"
+#include "YmVerilog/vl/VlModule.h"
+#include "YmVerilog/vl/VlDecl.h"
+#include "YmVerilog/vl/VlContAssign.h"
+#include "YmVerilog/vl/VlExpr.h"
+#include "YmVerilog/vl/VlTaskFunc.h"
+#include "YmVerilog/vl/VlProcess.h"
+#include "YmUtils/MsgMgr.h"
+#include "YmUtils/MsgHandler.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// テスト用の設計
+// constant function を用いるモジュールのインスタンスを
+// 異なるパラメータで多数作る．
+// (constant function の評価は未実装なので値は範囲には使わない)
+const char* kDesignText =
+  "module leaf #(parameter W = 8) (a, y, z);\n"
+  "  input [W-1:0] a;\n"
+  "  output [W-1:0] y;\n"
+  "  output z;\n"
+  "  function integer twice;\n"
+  "    input integer v;\n"
+  "    twice = v * 2;\n"
+  "  endfunction\n"
+  "  function integer half;\n"
+  "    input integer v;\n"
+  "    half = twice(v) / 4;\n"
+  "  endfunction\n"
+  "  localparam L = half(W);\n"
+  "  wire [W:0] t;\n"
+  "  reg [W-1:0] r;\n"
+  "  assign t = a + 1;\n"
+  "  assign y = ~a;\n"
+  "  assign z = ^a;\n"
+  "  always @ ( a )\n"
+  "    r = a + 1;\n"
+  "endmodule\n"
+  "\n"
+  "module mid #(parameter N = 4) (a, y);\n"
+  "  input [N-1:0] a;\n"
+  "  output [N-1:0] y;\n"
+  "  wire [N-1:0] y1;\n"
+  "  wire z1, z2;\n"
+  "  leaf #(.W(N)) u1 (.a(a), .y(y1), .z(z1));\n"
+  "  leaf #(.W(N)) u2 (.a(y1), .y(y), .z(z2));\n"
+  "endmodule\n"
+  "\n"
+  "module top (in, out);\n"
+  "  input [79:0] in;\n"
+  "  output [79:0] out;\n"
+  "  genvar i;\n"
+  "  generate\n"
+  "    for (i = 0; i < 48; i = i + 1) begin : g\n"
+  "      wire [i+3:0] o;\n"
+  "      wire [3:0] o2;\n"
+  "      wire zz;\n"
+  "      leaf #(.W(i+4)) u (.a(in[i+3:0]), .y(o), .z(zz));\n"
+  "      mid #(.N(4)) m (.a(in[i+3:i]), .y(o2));\n"
+  "    end\n"
+  "  endgenerate\n"
+  "  assign out = in;\n"
+  "endmodule\n";
+
+// ファイルを書き出す．
+bool
+write_file(const string& filename,
+	   const char* text)
+{
+  ofstream ofs(filename.c_str());
+  if ( !ofs ) {
+    return false;
+  }
+  ofs << text;
+  return true;
+}
+
+// 宣言要素のリストを出力する．
+void
+dump_decls(ostream& s,
+	   const VlMgr& mgr,
+	   const VlNamedObj* scope,
+	   int tag,
+	   const char* label)
+{
+  vector<const VlDecl*> decl_list;
+  if ( mgr.find_decl_list(scope, tag, decl_list) ) {
+    for (vector<const VlDecl*>::iterator p = decl_list.begin();
+	 p != decl_list.end(); ++ p) {
+      const VlDecl* decl = *p;
+      s << "  " << label << " " << decl->name();
+      if ( decl->has_range() ) {
+	s << " [" << decl->left_range_val()
+	  << ":" << decl->right_range_val() << "]";
+      }
+      s << endl;
+    }
+  }
+}
+
+// スコープの内容を再帰的に出力する．
+void
+dump_scope(ostream& s,
+	   const VlMgr& mgr,
+	   const VlNamedObj* scope)
+{
+  s << "scope " << scope->full_name() << endl;
+
+  dump_decls(s, mgr, scope, vpiParameter, "parameter");
+  dump_decls(s, mgr, scope, vpiNet, "net");
+  dump_decls(s, mgr, scope, vpiReg, "reg");
+  dump_decls(s, mgr, scope, vpiVariables, "variable");
+
+  vector<const VlTaskFunc*> func_list;
+  if ( mgr.find_function_list(scope, func_list) ) {
+    for (vector<const VlTaskFunc*>::iterator p = func_list.begin();
+	 p != func_list.end(); ++ p) {
+      s << "  function " << (*p)->name() << endl;
+    }
+  }
+
+  vector<const VlContAssign*> ca_list;
+  if ( mgr.find_contassign_list(scope, ca_list) ) {
+    for (vector<const VlContAssign*>::iterator p = ca_list.begin();
+	 p != ca_list.end(); ++ p) {
+      const VlContAssign* ca = *p;
+      s << "  assign " << ca->lhs()->decompile()
+	<< " = " << ca->rhs()->decompile()
+	<< " (" << ca->bit_size() << ")" << endl;
+    }
+  }
+
+  vector<const VlProcess*> process_list;
+  if ( mgr.find_process_list(scope, process_list) ) {
+    s << "  process " << process_list.size() << endl;
+  }
+
+  vector<const VlNamedObj*> scope_list;
+  if ( mgr.find_internalscope_list(scope, scope_list) ) {
+    for (vector<const VlNamedObj*>::iterator p = scope_list.begin();
+	 p != scope_list.end(); ++ p) {
+      dump_scope(s, mgr, *p);
+    }
+  }
+
+  vector<const VlModule*> module_list;
+  if ( mgr.find_module_list(scope, module_list) ) {
+    for (vector<const VlModule*>::iterator p = module_list.begin();
+	 p != module_list.end(); ++ p) {
+      const VlModule* module = *p;
+      s << "module " << module->def_name()
+	<< " " << module->port_num() << endl;
+      dump_scope(s, mgr, module);
+    }
+  }
+}
+
+// 設計を読み込んで thread_num 個のスレッドでエラボレーションする．
+// 結果を文字列にして返す．
+// メッセージの順序はスレッドの実行順に依存するので結果には含めない．
+string
+elaborate(const string& filename,
+	  ymuint thread_num,
+	  ymuint& nerr)
+{
+  ostringstream msg_buf;
+  StreamMsgHandler handler(&msg_buf);
+  handler.delete_mask(kMsgDebug);
+  MsgMgr::reg_handler(&handler);
+
+  VlMgr mgr;
+  bool stat = mgr.read_file(filename);
+  EXPECT_TRUE( stat );
+  nerr = mgr.elaborate(nullptr, thread_num);
+
+  ostringstream buf;
+  const list<const VlModule*>& top_list = mgr.topmodule_list();
+  for (list<const VlModule*>::const_iterator p = top_list.begin();
+       p != top_list.end(); ++ p) {
+    const VlModule* module = *p;
+    buf << "top " << module->def_name() << endl;
+    dump_scope(buf, mgr, module);
+  }
+
+  MsgMgr::unreg_handler(&handler);
+  return buf.str();
+}
+
+END_NONAMESPACE
+
+
+TEST(ElaboratorTest, thread_num)
+{
+  string filename = ::testing::TempDir() + "ElaboratorTest.v";
+  ASSERT_TRUE( write_file(filename, kDesignText) );
+
+  ymuint nerr1 = 0;
+  string ref = elaborate(filename, 1, nerr1);
+  EXPECT_EQ( 0U, nerr1 );
+
+  // 手で確かめられる部分
+  EXPECT_NE( string::npos, ref.find("scope .top.g[0].u\n") );
+  EXPECT_NE( string::npos, ref.find("scope .top.g[47].m.u2\n") );
+  // i = 8 の時 W = 12
+  EXPECT_NE( string::npos, ref.find("scope .top.g[8].u\n"
+				    "  parameter W\n"
+				    "  parameter L\n"
+				    "  net t [12:0]\n"
+				    "  net a [11:0]\n") );
+
+  for (ymuint r = 0; r < 5; ++ r) {
+    ymuint nerr = 0;
+    string str = elaborate(filename, 4, nerr);
+    EXPECT_EQ( nerr1, nerr );
+    EXPECT_EQ( ref, str ) << "round #" << r;
+  }
+
+  remove(filename.c_str());
+}
+
+END_NAMESPACE_YM_VERILOG
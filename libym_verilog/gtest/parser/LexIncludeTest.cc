@@ -0,0 +1,260 @@
+﻿
+/// @file LexIncludeTest.cc
+/// @brief インクルードファイルのキャッシュのテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2015 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "Lex.h"
+#include "YmVerilog/VlLineWatcher.h"
+#include "YmUtils/FileRegion.h"
+#include "YmUtils/FileInfo.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_YM_VERILOG
+
+BEGIN_NONAMESPACE
+
+// インクルードガードを持つファイル
+const char* kGuardText =
+  "// guarded header\n"
+  "`ifndef GUARD_VH\n"
+  "`define GUARD_VH\n"
+  "`define W 8\n"
+  "\n"
+  "`endif // GUARD_VH\n";
+
+// インクルードガードを持たないファイル
+const char* kBodyText =
+  "  /* block\n"
+  "     comment */\n"
+  "  wire b0;\n"
+  "`ifdef GUARD_VH\n"
+  "  wire g;\n"
+  "`else\n"
+  "  wire ng;\n"
+  "`endif\n"
+  "  wire [`W-1:0] b1; // trailing\n";
+
+// トークンの情報
+struct TokenRec
+{
+  int mId;
+  string mStr;
+  string mFilename;
+  ymuint mStartLine;
+  ymuint mStartColumn;
+  ymuint mEndLine;
+  ymuint mEndColumn;
+  ymuint mParentLine;
+};
+
+// 行番号を記録するウォッチャー
+class LineRec :
+  public VlLineWatcher
+{
+public:
+
+  // 行番号のリスト
+  vector<int> mLineList;
+
+  void
+  event_proc(int line)
+  {
+    mLineList.push_back(line);
+  }
+
+};
+
+// ファイルを書き出す．
+bool
+write_file(const string& filename,
+	   const char* text)
+{
+  ofstream ofs(filename.c_str());
+  if ( !ofs ) {
+    return false;
+  }
+  ofs << text;
+  return true;
+}
+
+// ファイルを読み込んでトークンのリストを得る．
+void
+read_tokens(const string& filename,
+	    vector<TokenRec>& token_list,
+	    vector<int>& line_list)
+{
+  Lex lex;
+  LineRec watcher;
+  lex.reg_watcher(&watcher);
+  ASSERT_TRUE( lex.open_file(filename) );
+  for ( ; ; ) {
+    int id = lex.get_token();
+    if ( id == EOF ) {
+      break;
+    }
+    const FileRegion& loc = lex.cur_token_loc();
+    TokenRec rec;
+    rec.mId = id;
+    rec.mStr = lex.cur_string();
+    rec.mFilename = loc.start_file_info().filename();
+    rec.mStartLine = loc.start_line();
+    rec.mStartColumn = loc.start_column();
+    rec.mEndLine = loc.end_line();
+    rec.mEndColumn = loc.end_column();
+    FileLoc parent = loc.start_file_info().parent_loc();
+    rec.mParentLine = parent.is_valid() ? parent.line() : 0U;
+    token_list.push_back(rec);
+  }
+  lex.unreg_watcher(&watcher);
+  line_list = watcher.mLineList;
+}
+
+// 同じファイルを何度もインクルードした結果を，同じ内容の別のファイルを
+// インクルードした結果と比べる．
+// top_format 中の %1 は最初のインクルード，%2 は2回目以降のインクルードを表す．
+// 1回目の読み込みでは %2 も同じファイルなのでキャッシュが使われる．
+// 2回目の読み込みでは %2 ごとに別のファイルを読むのでキャッシュは使われない．
+// インクルードガードで読み飛ばされたファイルの行は行番号ウォッチャーに
+// 通知されないので，その行数を skip_lines で指定する．
+void
+check_include(const string& name,
+	      const char* text,
+	      const char* top_format,
+	      ymuint skip_lines = 0)
+{
+  string dir = ::testing::TempDir();
+  string inc1 = dir + name + "_1.vh";
+  string top1 = dir + name + "_top1.v";
+  string top2 = dir + name + "_top2.v";
+  ASSERT_TRUE( write_file(inc1, text) );
+
+  vector<string> inc2_list;
+  string top_text1;
+  string top_text2;
+  for (const char* p = top_format; *p; ++ p) {
+    if ( p[0] == '%' && p[1] == '1' ) {
+      top_text1 += inc1;
+      top_text2 += inc1;
+      ++ p;
+    }
+    else if ( p[0] == '%' && p[1] == '2' ) {
+      ostringstream buf;
+      buf << dir << name << "_2_" << inc2_list.size() << ".vh";
+      string inc2 = buf.str();
+      ASSERT_TRUE( write_file(inc2, text) );
+      inc2_list.push_back(inc2);
+      top_text1 += inc1;
+      top_text2 += inc2;
+      ++ p;
+    }
+    else {
+      top_text1 += *p;
+      top_text2 += *p;
+    }
+  }
+  ASSERT_TRUE( write_file(top1, top_text1.c_str()) );
+  ASSERT_TRUE( write_file(top2, top_text2.c_str()) );
+
+  vector<TokenRec> token_list1;
+  vector<int> line_list1;
+  read_tokens(top1, token_list1, line_list1);
+  vector<TokenRec> token_list2;
+  vector<int> line_list2;
+  read_tokens(top2, token_list2, line_list2);
+
+  // 2回目のファイル名を1回目のものに揃えておく．
+  for (ymuint i = 0; i < token_list2.size(); ++ i) {
+    string& filename = token_list2[i].mFilename;
+    if ( filename == top2 ) {
+      filename = top1;
+    }
+    else if ( find(inc2_list.begin(), inc2_list.end(), filename) != inc2_list.end() ) {
+      filename = inc1;
+    }
+  }
+
+  ASSERT_EQ( token_list2.size(), token_list1.size() );
+  for (ymuint i = 0; i < token_list1.size(); ++ i) {
+    const TokenRec& rec1 = token_list1[i];
+    const TokenRec& rec2 = token_list2[i];
+    EXPECT_EQ( rec2.mId, rec1.mId ) << "token#" << i;
+    EXPECT_EQ( rec2.mStr, rec1.mStr ) << "token#" << i;
+    EXPECT_EQ( rec2.mFilename, rec1.mFilename ) << "token#" << i;
+    EXPECT_EQ( rec2.mStartLine, rec1.mStartLine ) << "token#" << i;
+    EXPECT_EQ( rec2.mStartColumn, rec1.mStartColumn ) << "token#" << i;
+    EXPECT_EQ( rec2.mEndLine, rec1.mEndLine ) << "token#" << i;
+    EXPECT_EQ( rec2.mEndColumn, rec1.mEndColumn ) << "token#" << i;
+    EXPECT_EQ( rec2.mParentLine, rec1.mParentLine ) << "token#" << i;
+  }
+  if ( skip_lines == 0 ) {
+    EXPECT_EQ( line_list2, line_list1 );
+  }
+  else {
+    EXPECT_EQ( line_list2.size(), line_list1.size() + skip_lines );
+  }
+
+  remove(inc1.c_str());
+  for (ymuint i = 0; i < inc2_list.size(); ++ i) {
+    remove(inc2_list[i].c_str());
+  }
+  remove(top1.c_str());
+  remove(top2.c_str());
+}
+
+END_NONAMESPACE
+
+
+TEST(LexIncludeTest, guard)
+{
+  // 2回目のインクルードは読み飛ばされる．
+  check_include("guard", kGuardText,
+		"`include \"%1\"\n"
+		"module top(a, y);\n"
+		"  input a;\n"
+		"`include \"%2\"\n"
+		"  output [`W-1:0] y;\n"
+		"endmodule\n", 6);
+}
+
+TEST(LexIncludeTest, replay)
+{
+  // 2回目のインクルードはキャッシュを再生する．
+  check_include("body", kBodyText,
+		"module top(a, y);\n"
+		"`include \"%1\"\n"
+		"  input a;\n"
+		"`define W 4\n"
+		"`include \"%2\"\n"
+		"  output y; `include \"%2\"\n"
+		"endmodule\n");
+}
+
+TEST(LexIncludeTest, nested)
+{
+  // ガード付きのファイルとガードのないファイルを交互にインクルードする．
+  string dir = ::testing::TempDir();
+  string guard = dir + "nested_guard.vh";
+  ASSERT_TRUE( write_file(guard, kGuardText) );
+  ostringstream buf;
+  buf << "`include \"" << guard << "\"" << endl
+      << kBodyText
+      << "`include \"" << guard << "\"" << endl;
+  check_include("nested", buf.str().c_str(),
+		"module top(a, y);\n"
+		"`include \"%1\"\n"
+		"  input a;\n"
+		"`include \"%2\"\n"
+		"endmodule\n");
+  remove(guard.c_str());
+}
+
+END_NAMESPACE_YM_VERILOG
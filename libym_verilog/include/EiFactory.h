@@ -42,6 +42,13 @@ public:
   void
   dump_prof(ostream& s);
 
+  /// @brief 現在のスレッドで用いるアロケータを設定する．
+  /// @param[in] alloc アロケータ
+  /// @note nullptr を与えると本来のアロケータを用いる．
+  virtual
+  void
+  set_thread_alloc(Alloc* alloc);
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -1098,6 +1105,16 @@ public:
   new_AttrList(ymuint n);
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在のスレッドで用いるアロケータを返す．
+  Alloc&
+  alloc();
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -1106,6 +1123,11 @@ private:
   // メモリアロケータ
   Alloc& mAlloc;
 
+  // 現在のスレッドで用いるアロケータ
+  static
+  thread_local
+  Alloc* mThreadAlloc;
+
   ymuint32 mUdpDefnNum;
   ymuint32 mModuleArrayNum;
   ymuint32 mModule1Num;
@@ -1236,6 +1258,19 @@ private:
   ymuint32 mModuleInfoNum;
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 現在のスレッドで用いるアロケータを返す．
+inline
+Alloc&
+EiFactory::alloc()
+{
+  return mThreadAlloc ? *mThreadAlloc : mAlloc;
+}
+
 END_NAMESPACE_YM_VERILOG
 
 #endif // EIFACTORY_H
@@ -16,6 +16,7 @@
 
 #include "YmUtils/SimpleAlloc.h"
 #include "YmUtils/HashMap.h"
+#include "YmUtils/MsgMgr.h"
 
 #include "CfDict.h"
 #include "AttrDict.h"
@@ -23,6 +24,9 @@
 
 #include "ElbFwd.h"
 
+#include <atomic>
+#include <mutex>
+
 
 BEGIN_NAMESPACE_YM_VERILOG
 
@@ -45,6 +49,13 @@ class AttrGen;
 /// 基本的には 内部に状態を持たないファンクタークラス
 /// 実際には elaboration 途中でオブジェクトを保持しておくハッシュ表
 /// などを持つ．最終結果は引数の ElbMgr に格納される．
+///
+/// thread_num に 2 以上を指定すると phase2 と phase3 のスタブを
+/// 所有者のモジュールごとにまとめて並列に評価する．
+/// 一つのモジュールに属するスタブは一つのスレッドで逐次的に評価
+/// されるので各スコープの要素の順番は逐次処理の場合と変わらない．
+/// 評価中に出力されたメッセージは保留しておき，スタブを逐次的に
+/// 評価した場合と同じ順番で出力する．
 //////////////////////////////////////////////////////////////////////
 class Elaborator
 {
@@ -56,9 +67,11 @@ public:
   /// @param[in] elb_mgr Elbオブジェクトを管理するクラス
   /// @param[in] elb_factory Elbオブジェクトを生成するファクトリクラス
   /// @param[in] cell_library セルライブラリ
+  /// @param[in] thread_num phase2/phase3 の処理に用いるスレッド数
   Elaborator(ElbMgr& elb_mgr,
 	     ElbFactory& elb_factory,
-	     const CellLibrary* cell_library = nullptr);
+	     const CellLibrary* cell_library = nullptr,
+	     ymuint thread_num = 1);
 
   /// @brief デストラクタ
   ~Elaborator();
@@ -100,6 +113,49 @@ private:
   void
   add_phase3stub(ElbStub* stub);
 
+  /// @brief 以降に登録するスタブの所有者を設定する．
+  /// @param[in] owner 所有者のモジュール
+  /// @return 直前の所有者を返す．
+  const VlModule*
+  set_stub_owner(const VlModule* owner);
+
+  /// @brief ElbStub 用のアロケータを返す．
+  Alloc&
+  stub_alloc();
+
+  /// @brief スタブのリストを評価する．
+  /// @param[in] stub_list 対象のリスト
+  /// @note 評価中に stub_list に追加されたスタブも評価する．
+  /// @note 結果として stub_list は空になる．
+  void
+  eval_stubs(ElbStubList& stub_list);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 並列処理用の下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  // 同じモジュールに属するスタブのグループ
+  struct StubGroup;
+
+  /// @brief スタブのグループを並列に評価する．
+  /// @param[in] group_list グループのリスト
+  void
+  eval_groups(vector<StubGroup>& group_list);
+
+  /// @brief 個々のスレッドで実行される関数
+  /// @param[in] group_list グループのリスト
+  /// @param[in] next 次に処理するグループ番号
+  void
+  eval_worker(vector<StubGroup>* group_list,
+	      std::atomic<ymuint>* next);
+
+  /// @brief 並列処理中なら mMutex をロックする．
+  /// @note 並列処理中でなければロックしていない unique_lock を返す．
+  std::unique_lock<std::mutex>
+  mt_lock() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -122,6 +178,13 @@ private:
   find_constant_function(const VlNamedObj* parent,
 			 const char* name) const;
 
+  /// @brief constant function の検索と生成を排他制御するロックを得る．
+  /// @note 並列処理中でなければロックしていない unique_lock を返す．
+  /// @note 生成中に別の constant function を生成することがあるので
+  /// 同じスレッドが入れ子にロックしてもよい．
+  std::unique_lock<std::recursive_mutex>
+  cf_lock();
+
   /// @brief セルの探索
   /// @param[in] name セル名
   /// @return name という名のセルを返す．
@@ -129,6 +192,11 @@ private:
   const Cell*
   find_cell(const char* name) const;
 
+  /// @brief パース木の属性定義から属性リストを取り出す．
+  /// @param[in] pt_attr パース木の属性定義
+  ElbAttrList*
+  find_attr_list(const PtAttrInst* pt_attr) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -144,6 +212,13 @@ private:
 			const char* name,
 			ElbTaskFunc* func);
 
+  /// @brief 属性リストを登録する．
+  /// @param[in] pt_attr パース木の属性定義
+  /// @param[in] attr_list 属性リスト
+  void
+  reg_attr_list(const PtAttrInst* pt_attr,
+		ElbAttrList* attr_list);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -172,6 +247,24 @@ private:
     const PtDefParam* mPtDefparam;
   };
 
+  struct StubGroup
+  {
+    /// @brief 所有者のモジュール
+    const VlModule* mOwner;
+
+    /// @brief 評価するスタブのリスト
+    vector<ElbStub*> mStubList;
+
+    /// @brief 評価中に登録された phase2 のスタブのリスト
+    ElbStubList mPhase2StubList;
+
+    /// @brief 評価中に登録された phase3 のスタブのリスト
+    ElbStubList mPhase3StubList;
+
+    /// @brief 評価中に出力されたメッセージのリスト
+    vector<MsgMgr::DeferredMsg> mMsgList;
+  };
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -190,6 +283,34 @@ private:
   // ElbStub 用のメモリアロケータ
   SimpleAlloc mAlloc;
 
+  // スレッド数
+  ymuint mThreadNum;
+
+  // 並列処理時にスレッドごとに生成した ElbStub 用のアロケータのリスト
+  vector<SimpleAlloc*> mStubAllocList;
+
+  // 辞書を保護する mutex
+  mutable
+  std::mutex mMutex;
+
+  // constant function の検索と生成を保護する mutex
+  std::recursive_mutex mCfMutex;
+
+  // 以降に登録するスタブの所有者
+  static
+  thread_local
+  const VlModule* mCurOwner;
+
+  // 並列処理時に評価中のグループ
+  static
+  thread_local
+  StubGroup* mCurGroup;
+
+  // 並列処理時に用いる ElbStub 用のアロケータ
+  static
+  thread_local
+  Alloc* mCurStubAlloc;
+
   // UDP 生成用のオブジェクト
   UdpGen* mUdpGen;
 
@@ -42,6 +42,14 @@ public:
   void
   dump_prof(ostream& s) = 0;
 
+  /// @brief 現在のスレッドで用いるアロケータを設定する．
+  /// @param[in] alloc アロケータ
+  /// @note nullptr を与えると本来のアロケータを用いる．
+  /// @note 並列に生成を行う時にスレッドごとに呼び出す．
+  virtual
+  void
+  set_thread_alloc(Alloc* alloc) = 0;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
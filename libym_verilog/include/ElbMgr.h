@@ -12,6 +12,9 @@
 #include "YmVerilog/pt/PtP.h"
 #include "YmVerilog/vl/VlFwd.h"
 #include "YmUtils/Alloc.h"
+#include "YmUtils/SimpleAlloc.h"
+#include "YmUtils/SlabAlloc.h"
+#include "YmUtils/SlabPool.h"
 #include "YmUtils/HashMap.h"
 
 #include "TagDict.h"
@@ -24,12 +27,22 @@
 #include "ElbDecl.h"
 #include "ElbPrimitive.h"
 
+#include <atomic>
+#include <mutex>
+
 
 BEGIN_NAMESPACE_YM_VERILOG
 
 //////////////////////////////////////////////////////////////////////
 /// @class ElbMgr ElbMgr.h "ElbMgr.h"
 /// @brief ElbMgr の実装クラス
+///
+/// スコープ単位の辞書は親のスコープのアドレスで kShardNum 個に
+/// 分割してあり，個別の mutex で保護されている．
+/// そのため set_multi_thread(true) を呼んだ区間では異なるスレッドから
+/// 同時に reg_XXX()/find_XXX() を呼んでも構わない．
+/// 区間の外では排他制御を行わない．
+/// UDP，UserSystf の登録は並列に行ってはいけない．
 //////////////////////////////////////////////////////////////////////
 class ElbMgr
 {
@@ -369,6 +382,18 @@ public:
   ymuint
   allocated_size() const;
 
+  /// @brief スレッドごとに用いるアロケータを生成する．
+  /// @note 生成したアロケータは clear() もしくはデストラクタで破壊される．
+  Alloc&
+  new_thread_alloc();
+
+  /// @brief 複数のスレッドから reg_XXX()/find_XXX() を呼び出す区間の
+  /// 開始/終了を指示する．
+  /// @param[in] flag 開始する時に true，終了する時に false とする．
+  /// @note 入れ子にしてよい．
+  void
+  set_multi_thread(bool flag);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -383,6 +408,59 @@ private:
 		const VlNamedObj* ulimit);
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 辞書の分割数
+  static
+  const ymuint kShardNum = 16;
+
+  // 分割された辞書
+  struct Shard
+  {
+    // コンストラクタ
+    Shard();
+
+    // 辞書用のアロケータ
+    SimpleAlloc mAlloc;
+
+    // 名前をキーにしたオブジェクトの辞書
+    ObjDict mObjDict;
+
+    // タグをキーにした各スコープごとのオブジェクトのリストの辞書
+    TagDict mTagDict;
+
+    // モジュール名をキーにしたモジュールインスタンスの辞書
+    ModuleHash mModInstDict;
+
+    // 属性リストの辞書
+    AttrHash mAttrHash;
+
+    // 排他制御用の mutex
+    mutable
+    std::mutex mMutex;
+
+  };
+
+  /// @brief 複数のスレッドから呼び出す区間の中なら mutex をロックする．
+  /// @param[in] mutex 対象の mutex
+  /// @note 区間の外ではロックしていない unique_lock を返す．
+  std::unique_lock<std::mutex>
+  mt_lock(std::mutex& mutex) const;
+
+  /// @brief キーに対応する辞書を返す．
+  /// @param[in] key 親のスコープ(属性の場合は対象のオブジェクト)
+  Shard&
+  shard(const void* key);
+
+  /// @brief キーに対応する辞書を返す．
+  /// @param[in] key 親のスコープ(属性の場合は対象のオブジェクト)
+  const Shard&
+  shard(const void* key) const;
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -403,17 +481,21 @@ private:
   // UserSystf の辞書
   HashMap<string, const ElbUserSystf*> mSystfHash;
 
-  // 名前をキーにしたオブジェクトの辞書
-  ObjDict mObjDict;
+  // 分割された辞書の配列
+  Shard mShardArray[kShardNum];
+
+  // mTopmoduleList と mThreadAllocList を保護する mutex
+  mutable
+  std::mutex mMutex;
 
-  // タグをキーにした各スコープごとのオブジェクトのリストの辞書
-  TagDict mTagDict;
+  // set_multi_thread(true) の入れ子の深さ
+  std::atomic<ymuint> mMtCount;
 
-  // モジュール名をキーにしたモジュールインスタンスの辞書
-  ModuleHash mModInstDict;
+  // new_thread_alloc() で生成したアロケータにスラブを供給するプール
+  SlabPool mThreadPool;
 
-  // 属性リストの辞書
-  AttrHash mAttrHash;
+  // new_thread_alloc() で生成したアロケータのリスト
+  vector<SlabAlloc*> mThreadAllocList;
 
   // トップレベルスコープ
   const VlNamedObj* mTopLevel;
@@ -435,7 +517,9 @@ bool
 ElbMgr::find_internalscope_list(const VlNamedObj* parent,
 				vector<const VlNamedObj*>& scope_list) const
 {
-  return mTagDict.find_internalscope_list(parent, scope_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_internalscope_list(parent, scope_list);
 }
 
 // @brief スコープとタグから宣言要素を取り出す．
@@ -452,7 +536,9 @@ ElbMgr::find_decl_list(const VlNamedObj* parent,
 		       int tag,
 		       vector<const VlDecl*>& decl_list) const
 {
-  return mTagDict.find_decl_list(parent, tag, decl_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_decl_list(parent, tag, decl_list);
 }
 
 // @brief スコープとタグから宣言要素の配列を取り出す．
@@ -473,7 +559,9 @@ ElbMgr::find_declarray_list(const VlNamedObj* parent,
     // ちょっと汚い補正
     tag += 100;
   }
-  return mTagDict.find_declarray_list(parent, tag, declarray_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_declarray_list(parent, tag, declarray_list);
 }
 
 // @brief スコープに属する defparam のリストを取り出す．
@@ -486,7 +574,9 @@ bool
 ElbMgr::find_defparam_list(const VlNamedObj* parent,
 			   vector<const VlDefParam*>& defparam_list) const
 {
-  return mTagDict.find_defparam_list(parent, defparam_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_defparam_list(parent, defparam_list);
 }
 
 // @brief スコープに属する param assign のリストを取り出す．
@@ -499,7 +589,9 @@ bool
 ElbMgr::find_paramassign_list(const VlNamedObj* parent,
 			      vector<const VlParamAssign*>& paramassign_list) const
 {
-  return mTagDict.find_paramassign_list(parent, paramassign_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_paramassign_list(parent, paramassign_list);
 }
 
 // @brief スコープに属する module のリストを取り出す．
@@ -512,7 +604,9 @@ bool
 ElbMgr::find_module_list(const VlNamedObj* parent,
 			 vector<const VlModule*>& module_list) const
 {
-  return mTagDict.find_module_list(parent, module_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_module_list(parent, module_list);
 }
 
 // @brief スコープに属する module arrayのリストを取り出す．
@@ -525,7 +619,9 @@ bool
 ElbMgr::find_modulearray_list(const VlNamedObj* parent,
 			      vector<const VlModuleArray*>& modulearray_list) const
 {
-  return mTagDict.find_modulearray_list(parent, modulearray_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_modulearray_list(parent, modulearray_list);
 }
 
 // @brief スコープに属する primitive のリストを取り出す．
@@ -538,7 +634,9 @@ bool
 ElbMgr::find_primitive_list(const VlNamedObj* parent,
 			    vector<const VlPrimitive*>& primitive_list) const
 {
-  return mTagDict.find_primitive_list(parent, primitive_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_primitive_list(parent, primitive_list);
 }
 
 // @brief スコープに属する primitive array のリストを取り出す．
@@ -551,7 +649,9 @@ bool
 ElbMgr::find_primarray_list(const VlNamedObj* parent,
 			    vector<const VlPrimArray*>& primarray_list) const
 {
-  return mTagDict.find_primarray_list(parent, primarray_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_primarray_list(parent, primarray_list);
 }
 
 // @brief スコープに属する continuous assignment のリストを取り出す．
@@ -564,7 +664,9 @@ bool
 ElbMgr::find_contassign_list(const VlNamedObj* parent,
 			     vector<const VlContAssign*>& contassign_list) const
 {
-  return mTagDict.find_contassign_list(parent, contassign_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_contassign_list(parent, contassign_list);
 }
 
 // @brief スコープに属するタスクのリストを取り出す．
@@ -577,7 +679,9 @@ bool
 ElbMgr::find_task_list(const VlNamedObj* parent,
 		       vector<const VlTaskFunc*>& task_list) const
 {
-  return mTagDict.find_task_list(parent, task_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_task_list(parent, task_list);
 }
 
 // @brief スコープに属する関数のリストを取り出す．
@@ -590,7 +694,9 @@ bool
 ElbMgr::find_function_list(const VlNamedObj* parent,
 			   vector<const VlTaskFunc*>& func_list) const
 {
-  return mTagDict.find_function_list(parent, func_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_function_list(parent, func_list);
 }
 
 // @brief スコープに属する process のリストを取り出す．
@@ -603,7 +709,9 @@ bool
 ElbMgr::find_process_list(const VlNamedObj* parent,
 			  vector<const VlProcess*>& process_list) const
 {
-  return mTagDict.find_process_list(parent, process_list);
+  const Shard& sh = shard(parent);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mTagDict.find_process_list(parent, process_list);
 }
 
 // @brief 属性リストを得る．
@@ -614,7 +722,9 @@ ElbAttrList*
 ElbMgr::find_attr(const VlObj* obj,
 		  bool def) const
 {
-  return mAttrHash.find(obj, def);
+  const Shard& sh = shard(obj);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  return sh.mAttrHash.find(obj, def);
 }
 
 // @brief アロケータを取り出す．
@@ -625,6 +735,35 @@ ElbMgr::allocator()
   return mAlloc;
 }
 
+// @brief 複数のスレッドから呼び出す区間の中なら mutex をロックする．
+inline
+std::unique_lock<std::mutex>
+ElbMgr::mt_lock(std::mutex& mutex) const
+{
+  if ( mMtCount.load() > 0 ) {
+    return std::unique_lock<std::mutex>(mutex);
+  }
+  return std::unique_lock<std::mutex>();
+}
+
+// @brief キーに対応する辞書を返す．
+inline
+ElbMgr::Shard&
+ElbMgr::shard(const void* key)
+{
+  ympuint h = reinterpret_cast<ympuint>(key);
+  return mShardArray[((h >> 4) ^ (h >> 12)) % kShardNum];
+}
+
+// @brief キーに対応する辞書を返す．
+inline
+const ElbMgr::Shard&
+ElbMgr::shard(const void* key) const
+{
+  ympuint h = reinterpret_cast<ympuint>(key);
+  return mShardArray[((h >> 4) ^ (h >> 12)) % kShardNum];
+}
+
 END_NAMESPACE_YM_VERILOG
 
 #endif // ELBMGR_H
@@ -10,6 +10,7 @@
 
 
 #include "YmVerilog/verilog.h"
+#include "YmVerilog/vl/VlFwd.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -38,6 +39,16 @@ public:
   void
   eval() = 0;
 
+  /// @brief 所有者のモジュールを返す．
+  const VlModule*
+  owner() const;
+
+  /// @brief 所有者のモジュールを設定する．
+  /// @param[in] owner 所有者のモジュール
+  /// @note 同じ所有者を持つ stub は登録順に処理しなければならない．
+  void
+  set_owner(const VlModule* owner);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -47,6 +58,9 @@ private:
   // 次の要素を指すリンク
   ElbStub* mNextLink;
 
+  // 所有者のモジュール
+  const VlModule* mOwner;
+
 };
 
 
@@ -85,6 +99,12 @@ public:
   void
   eval();
 
+  /// @brief 要素を配列に移す．
+  /// @param[out] stub_list 要素を格納する配列
+  /// @note 結果としてリストは空になる．
+  void
+  move_to(vector<ElbStub*>& stub_list);
+
   /// @brief 内容を空にする．
   /// @note 中の要素のメモリは開放されない．
   void
@@ -330,7 +350,8 @@ private:
 // @brief コンストラクタ
 inline
 ElbStub::ElbStub() :
-  mNextLink(nullptr)
+  mNextLink(nullptr),
+  mOwner(nullptr)
 {
 }
 
@@ -340,6 +361,23 @@ ElbStub::~ElbStub()
 {
 }
 
+// @brief 所有者のモジュールを返す．
+inline
+const VlModule*
+ElbStub::owner() const
+{
+  return mOwner;
+}
+
+// @brief 所有者のモジュールを設定する．
+// @param[in] owner 所有者のモジュール
+inline
+void
+ElbStub::set_owner(const VlModule* owner)
+{
+  mOwner = owner;
+}
+
 // @brief コンストラクタ
 inline
 ElbStubList::ElbStubList() :
@@ -404,6 +442,20 @@ ElbStubList::eval()
   mTail = nullptr;
 }
 
+// @brief 要素を配列に移す．
+// @param[out] stub_list 要素を格納する配列
+// @note 結果としてリストは空になる．
+inline
+void
+ElbStubList::move_to(vector<ElbStub*>& stub_list)
+{
+  for (ElbStub* stub = mTop; stub; stub = stub->mNextLink) {
+    stub_list.push_back(stub);
+  }
+  mTop = nullptr;
+  mTail = nullptr;
+}
+
 // @brief 内容を空にする．
 // @note 中の要素のメモリは開放されない．
 inline
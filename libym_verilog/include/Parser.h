@@ -68,6 +68,23 @@ public:
 	    const SearchPathList& searchpath,
 	    const list<VlLineWatcher*>& watcher_list);
 
+  /// @brief ライブラリファイルを読み込む．
+  /// @param[in] filename 読み込むファイル名
+  /// @param[in] searchpath サーチパス
+  /// @param[in] watcher_list 行番号ウオッチャーのリスト
+  /// @param[in] lib_id ライブラリ番号
+  /// @param[in] load_set 本体を読み込むモジュール(UDP)名の集合
+  /// @retval true 正常に終了した．
+  /// @retval false エラーが起こった．
+  /// @note load_set に含まれないモジュールと UDP は本体を読み飛ばして
+  /// 名前だけを PtMgr に登録する．
+  bool
+  read_library(const string& filename,
+	       const SearchPathList& searchpath,
+	       const list<VlLineWatcher*>& watcher_list,
+	       ymuint lib_id,
+	       const HashSet<string>& load_set);
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -2324,6 +2341,22 @@ private:
   typedef PtrList<PtiDeclHead, const PtDeclHead> PtDeclHeadList;
   typedef PtrList<const PtItem, const PtItem> PtItemList;
 
+  // ライブラリモード時に先読みしたトークンの情報
+  struct TokenInfo
+  {
+    // トークン番号
+    int mId;
+
+    // 位置
+    FileRegion mLoc;
+
+    // 文字列値
+    string mStr;
+
+    // 整数値
+    ymuint32 mUint;
+  };
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -2351,6 +2384,33 @@ private:
   void
   pop_item_list(bool delete_top);
 
+  /// @brief ライブラリモードでトークンを先読みする．
+  /// @note 読み込む必要のないモジュール(UDP)は前置された
+  /// attribute instance ごと読み飛ばし，残りのトークンを
+  /// mTokenBuf に積む．
+  void
+  read_lib_tokens();
+
+  /// @brief 字句解析器の現在のトークンを mTokenBuf に積む．
+  /// @param[in] id トークン番号
+  void
+  push_token(int id);
+
+  /// @brief トークンを1つ読んで mTokenBuf に積む．
+  /// @return 読み込んだトークン番号を返す．
+  int
+  read_token();
+
+  /// @brief ライブラリのモジュール(UDP)の本体を読み飛ばす．
+  /// @param[in] id 先頭のキーワードのトークン
+  /// @param[in] head_loc 先頭のキーワードの位置
+  /// @return 読み飛ばした次のトークンを返す．
+  /// @note 現在のトークンはモジュール(UDP)名でなければならない．
+  /// @note 本体中でインスタンス化されている名前も記録する．
+  int
+  skip_lib_description(int id,
+		       const FileRegion& head_loc);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -2369,6 +2429,21 @@ private:
   // 字句解析を行うオブジェクト
   Lex* mLex;
 
+  // ライブラリファイルを読んでいる時 true となるフラグ
+  bool mLibMode;
+
+  // 読み込み中のライブラリ番号
+  ymuint32 mLibId;
+
+  // 本体を読み込むライブラリモジュール名の集合
+  const HashSet<string>* mLoadSet;
+
+  // ライブラリモード時に先読みしたトークンのバッファ
+  vector<TokenInfo> mTokenBuf;
+
+  // mTokenBuf 中の次に返すトークンの位置
+  ymuint32 mTokenPos;
+
   // PuList<> のメモリ確保用オブジェクト
   FragAlloc mTmpAlloc;
 
@@ -11,10 +11,35 @@
 
 #include "YmVerilog/pt/PtP.h"
 #include "YmUtils/HashSet.h"
+#include "YmUtils/HashMap.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
 
+//////////////////////////////////////////////////////////////////////
+/// @class PtLibModule PtMgr.h "PtMgr.h"
+/// @brief 本体を読み込んでいないライブラリモジュール(UDP)の情報
+//////////////////////////////////////////////////////////////////////
+struct PtLibModule
+{
+  /// @brief モジュール(UDP)名
+  string mName;
+
+  /// @brief ライブラリ番号
+  ymuint mLibId;
+
+  /// @brief UDP の時 true
+  bool mUdp;
+
+  /// @brief 本体中でインスタンス化されている名前のリスト
+  vector<string> mRefList;
+
+  /// @brief 本体中で '(' の直前に現れた名前のリスト
+  /// @note UDP 名の場合のみ参照とみなす．
+  vector<string> mCallRefList;
+};
+
+
 //////////////////////////////////////////////////////////////////////
 /// @class PtMgr PtMgr.h <YmVerilog/PtMgr.h>
 /// @ingroup PtMgr
@@ -54,6 +79,29 @@ public:
   bool
   check_def_name(const char* name) const;
 
+  /// @brief モジュールか UDP として定義されている名前かどうか調べる．
+  /// @param[in] name 調べる名前
+  /// @return 定義されていたら true を返す．
+  bool
+  check_defined_name(const char* name) const;
+
+  /// @brief 本体を読み込んでいないライブラリモジュールの数を返す．
+  ymuint
+  lib_module_num() const;
+
+  /// @brief 本体を読み込んでいないライブラリモジュールを返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < lib_module_num() )
+  const PtLibModule&
+  lib_module(ymuint pos) const;
+
+  /// @brief 名前からライブラリモジュールの位置番号を得る．
+  /// @param[in] name モジュール(UDP)名
+  /// @param[out] pos 位置番号
+  /// @return 見つからなければ false を返す．
+  bool
+  find_lib_module(const char* name,
+		  ymuint& pos) const;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -76,6 +124,20 @@ public:
   void
   reg_defname(const char* name);
 
+  /// @brief 本体を読み込んでいないライブラリモジュールを追加する．
+  /// @param[in] name モジュール(UDP)名
+  /// @param[in] lib_id ライブラリ番号
+  /// @param[in] is_udp UDP の時 true
+  /// @param[in] ref_list 本体中でインスタンス化されている名前のリスト
+  /// @param[in] call_ref_list 本体中で '(' の直前に現れた名前のリスト
+  /// @note すでに同名のものが登録されていたら何もしない．
+  void
+  reg_lib_module(const char* name,
+		 ymuint lib_id,
+		 bool is_udp,
+		 const vector<string>& ref_list,
+		 const vector<string>& call_ref_list);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -92,6 +154,16 @@ private:
   // たぶんモジュール名か UDP名のはず
   HashSet<string> mDefNames;
 
+  // 定義されているモジュール名と UDP 名
+  HashSet<string> mDefinedNames;
+
+  // 本体を読み込んでいないライブラリモジュールのリスト
+  vector<PtLibModule> mLibModuleList;
+
+  // ライブラリモジュール名をキーにして mLibModuleList 中の
+  // 位置番号を格納する辞書
+  HashMap<string, ymuint> mLibModuleDict;
+
 };
 
 END_NAMESPACE_YM_VERILOG
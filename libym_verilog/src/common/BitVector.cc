@@ -42,45 +42,280 @@ size_to_dec_str(ymuint32 val)
   return ans;
 }
 
-// @brief a * b の結果を2ワードで返す．
-// - <ret-val>.first が high-word
-// - <ret-val>.second が low-word
-pair<ymuint32, ymuint32>
-mult32(ymuint32 a,
-       ymuint32 b)
-{
-  ymuint32 al = a & 0xffff;
-  ymuint32 ah = a >> 16;
-  ymuint32 bl = b & 0xffff;
-  ymuint32 bh = b >> 16;
-
-  ymuint32 tmp_ll = al * bl;
-  ymuint32 tmp_lh = al * bh;
-  ymuint32 tmp_hl = ah * bl;
-  ymuint32 tmp_hh = ah * bh;
-
-  ymuint32 tmp_lll = tmp_ll & 0xffff;
-  ymuint32 tmp_llh = tmp_ll >> 16;
-  ymuint32 tmp_lhl = tmp_lh & 0xffff;
-  ymuint32 tmp_lhh = tmp_lh >> 16;
-  ymuint32 tmp_hll = tmp_hl & 0xffff;
-  ymuint32 tmp_hlh = tmp_hl >> 16;
-  ymuint32 tmp_hhl = tmp_hh & 0xffff;
-  ymuint32 tmp_hhh = tmp_hh >> 16;
-
-  ymuint32 c0 = tmp_lll;
-  ymuint32 c1 = tmp_llh + tmp_hll + tmp_lhl;
-  ymuint32 c1h = c1 >> 16;
-  c1 &= 0xffff;
-  ymuint32 c2 = c1h + tmp_hlh + tmp_lhh + tmp_hhl;
-  ymuint32 c2h = c2 >> 16;
-  c2 &= 0xffff;
-  ymuint32 c3 = c2h + tmp_hhh;
-
-  ymuint32 cl = (c1 << 16) + c0;
-  ymuint32 ch = (c3 << 16) + c2;
-
-  return make_pair(ch, cl);
+// ブロックのビット長
+const ymuint32 kBits = 32;
+
+// これ未満のブロック数の乗算は筆算で行う．
+const ymuint32 kKaratsubaThreshold = 32;
+
+// @brief r[0:rn - 1] に s[0:sn - 1] を足す．
+// @return 桁あふれを返す．
+// @note sn <= rn でなければならない．
+ymuint32
+add_to(ymuint32* r,
+       ymuint32 rn,
+       const ymuint32* s,
+       ymuint32 sn)
+{
+  ymuint64 carry = 0;
+  ymuint32 i = 0;
+  for ( ; i < sn; ++ i) {
+    ymuint64 t = static_cast<ymuint64>(r[i]) + s[i] + carry;
+    r[i] = static_cast<ymuint32>(t);
+    carry = t >> kBits;
+  }
+  for ( ; carry && i < rn; ++ i) {
+    ymuint64 t = static_cast<ymuint64>(r[i]) + carry;
+    r[i] = static_cast<ymuint32>(t);
+    carry = t >> kBits;
+  }
+  return static_cast<ymuint32>(carry);
+}
+
+// @brief r[0:rn - 1] から s[0:sn - 1] を引く．
+// @return 桁借りを返す．
+// @note sn <= rn でなければならない．
+ymuint32
+sub_from(ymuint32* r,
+	 ymuint32 rn,
+	 const ymuint32* s,
+	 ymuint32 sn)
+{
+  ymuint32 borrow = 0;
+  ymuint32 i = 0;
+  for ( ; i < sn; ++ i) {
+    ymuint64 t = static_cast<ymuint64>(r[i]) - s[i] - borrow;
+    r[i] = static_cast<ymuint32>(t);
+    borrow = static_cast<ymuint32>(t >> kBits) & 1U;
+  }
+  for ( ; borrow && i < rn; ++ i) {
+    ymuint64 t = static_cast<ymuint64>(r[i]) - borrow;
+    r[i] = static_cast<ymuint32>(t);
+    borrow = static_cast<ymuint32>(t >> kBits) & 1U;
+  }
+  return borrow;
+}
+
+// @brief a[0:n - 1] * b[0:n - 1] を r[0:2n - 1] に求める．
+// @note ブロック数が大きい時は Karatsuba 法を用いる．
+void
+mult_full(const ymuint32* a,
+	  const ymuint32* b,
+	  ymuint32 n,
+	  ymuint32* r)
+{
+  if ( n < kKaratsubaThreshold ) {
+    for (ymuint32 i = 0; i < n * 2; ++ i) {
+      r[i] = 0;
+    }
+    for (ymuint32 i = 0; i < n; ++ i) {
+      ymuint64 ai = a[i];
+      if ( ai == 0 ) {
+	continue;
+      }
+      ymuint64 carry = 0;
+      for (ymuint32 j = 0; j < n; ++ j) {
+	ymuint64 t = ai * b[j] + r[i + j] + carry;
+	r[i + j] = static_cast<ymuint32>(t);
+	carry = t >> kBits;
+      }
+      r[i + n] = static_cast<ymuint32>(carry);
+    }
+    return;
+  }
+
+  // a = a1 * B^m + a0, b = b1 * B^m + b0 と分割する．
+  ymuint32 m = n / 2;
+  ymuint32 h = n - m;
+
+  // r の下位に a0 * b0 を，上位に a1 * b1 を求める．
+  mult_full(a, b, m, r);
+  mult_full(a + m, b + m, h, r + m * 2);
+
+  // (a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1 を求める．
+  vector<ymuint32> sa(a + m, a + n);
+  vector<ymuint32> sb(b + m, b + n);
+  sa.push_back(0);
+  sb.push_back(0);
+  add_to(&sa[0], h + 1, a, m);
+  add_to(&sb[0], h + 1, b, m);
+  vector<ymuint32> z1((h + 1) * 2);
+  mult_full(&sa[0], &sb[0], h + 1, &z1[0]);
+  sub_from(&z1[0], z1.size(), r, m * 2);
+  sub_from(&z1[0], z1.size(), r + m * 2, h * 2);
+
+  // z1 の上位ブロックは 0 なので r からはみ出る部分は無視できる．
+  ymuint32 zn = n * 2 - m;
+  if ( zn > z1.size() ) {
+    zn = z1.size();
+  }
+  add_to(r + m, n * 2 - m, &z1[0], zn);
+}
+
+// @brief a[0:n - 1] * b[0:n - 1] の下位 n ブロックを r に求める．
+void
+mult_low(const ymuint32* a,
+	 const ymuint32* b,
+	 ymuint32 n,
+	 ymuint32* r)
+{
+  if ( n >= kKaratsubaThreshold ) {
+    vector<ymuint32> tmp(n * 2);
+    mult_full(a, b, n, &tmp[0]);
+    for (ymuint32 i = 0; i < n; ++ i) {
+      r[i] = tmp[i];
+    }
+    return;
+  }
+
+  // 下位 n ブロックに影響する部分積だけを計算する．
+  for (ymuint32 i = 0; i < n; ++ i) {
+    r[i] = 0;
+  }
+  for (ymuint32 i = 0; i < n; ++ i) {
+    ymuint64 ai = a[i];
+    if ( ai == 0 ) {
+      continue;
+    }
+    ymuint64 carry = 0;
+    for (ymuint32 j = 0; i + j < n; ++ j) {
+      ymuint64 t = ai * b[j] + r[i + j] + carry;
+      r[i + j] = static_cast<ymuint32>(t);
+      carry = t >> kBits;
+    }
+  }
+}
+
+// @brief val[0:n - 1] が 0 の時 true を返す．
+bool
+is_all0(const ymuint32* val,
+	ymuint32 n)
+{
+  for (ymuint32 i = 0; i < n; ++ i) {
+    if ( val[i] != 0 ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief u[0:n - 1] / v[0:n - 1] の商を q に，余りを r に求める．
+// @note v は 0 であってはならない．
+// @note Knuth の Algorithm D を用いる．
+void
+divmod(const ymuint32* u,
+       const ymuint32* v,
+       ymuint32 n,
+       ymuint32* q,
+       ymuint32* r)
+{
+  for (ymuint32 i = 0; i < n; ++ i) {
+    q[i] = 0;
+    r[i] = 0;
+  }
+
+  // 有効なブロック数を求める．
+  ymuint32 vn = n;
+  for ( ; vn > 0 && v[vn - 1] == 0; -- vn) { }
+  ASSERT_COND( vn > 0 );
+  ymuint32 un = n;
+  for ( ; un > 0 && u[un - 1] == 0; -- un) { }
+
+  if ( un < vn ) {
+    // 商は 0
+    for (ymuint32 i = 0; i < un; ++ i) {
+      r[i] = u[i];
+    }
+    return;
+  }
+
+  if ( vn == 1 ) {
+    // 除数が1ブロックの場合
+    ymuint64 d = v[0];
+    ymuint64 rem = 0;
+    for (ymuint32 i = un; i -- > 0; ) {
+      ymuint64 cur = (rem << kBits) | u[i];
+      q[i] = static_cast<ymuint32>(cur / d);
+      rem = cur % d;
+    }
+    r[0] = static_cast<ymuint32>(rem);
+    return;
+  }
+
+  // 除数の最上位ブロックの MSB が 1 になるように正規化する．
+  ymuint32 s = 0;
+  for (ymuint32 top = v[vn - 1]; (top & 0x80000000U) == 0; top <<= 1) {
+    ++ s;
+  }
+  vector<ymuint32> nv(vn);
+  vector<ymuint32> nu(un + 1);
+  if ( s > 0 ) {
+    for (ymuint32 i = vn - 1; i > 0; -- i) {
+      nv[i] = (v[i] << s) | (v[i - 1] >> (kBits - s));
+    }
+    nv[0] = v[0] << s;
+    nu[un] = u[un - 1] >> (kBits - s);
+    for (ymuint32 i = un - 1; i > 0; -- i) {
+      nu[i] = (u[i] << s) | (u[i - 1] >> (kBits - s));
+    }
+    nu[0] = u[0] << s;
+  }
+  else {
+    for (ymuint32 i = 0; i < vn; ++ i) {
+      nv[i] = v[i];
+    }
+    for (ymuint32 i = 0; i < un; ++ i) {
+      nu[i] = u[i];
+    }
+    nu[un] = 0;
+  }
+
+  const ymuint64 base = 1UL << kBits;
+  ymuint64 vtop = nv[vn - 1];
+  ymuint64 vnext = nv[vn - 2];
+  for (ymuint32 j = un - vn + 1; j -- > 0; ) {
+    // 商の1ブロックを推定する．
+    ymuint64 num = (static_cast<ymuint64>(nu[j + vn]) << kBits) | nu[j + vn - 1];
+    ymuint64 qhat = num / vtop;
+    ymuint64 rhat = num % vtop;
+    while ( qhat >= base || qhat * vnext > ((rhat << kBits) | nu[j + vn - 2]) ) {
+      -- qhat;
+      rhat += vtop;
+      if ( rhat >= base ) {
+	break;
+      }
+    }
+
+    // nu[j:j + vn] から qhat * nv を引く．
+    ymint64 borrow = 0;
+    ymint64 t;
+    for (ymuint32 i = 0; i < vn; ++ i) {
+      ymuint64 p = qhat * nv[i];
+      t = static_cast<ymint64>(nu[i + j]) - borrow - static_cast<ymint64>(p & 0xFFFFFFFFUL);
+      nu[i + j] = static_cast<ymuint32>(t);
+      borrow = static_cast<ymint64>(p >> kBits) - (t >> kBits);
+    }
+    t = static_cast<ymint64>(nu[j + vn]) - borrow;
+    nu[j + vn] = static_cast<ymuint32>(t);
+
+    q[j] = static_cast<ymuint32>(qhat);
+    if ( t < 0 ) {
+      // 引きすぎたので足し戻す．
+      -- q[j];
+      ymuint32 carry = add_to(&nu[j], vn, &nv[0], vn);
+      nu[j + vn] += carry;
+    }
+  }
+
+  // 余りは正規化を元に戻す．
+  for (ymuint32 i = 0; i < vn; ++ i) {
+    if ( s > 0 ) {
+      r[i] = (nu[i] >> s) | (nu[i + 1] << (kBits - s));
+    }
+    else {
+      r[i] = nu[i];
+    }
+  }
 }
 
 END_NONAMESPACE
@@ -581,28 +816,43 @@ BitVector::BitVector(const vector<BitVector>& src_list) :
 
 // コピーコンストラクタ
 BitVector::BitVector(const BitVector& src) :
-  mSize(src.mSize),
-  mFlags(src.mFlags)
+  mSize(0),
+  mFlags(src.mFlags),
+  mVal0(nullptr),
+  mVal1(nullptr)
 {
+  resize(src.mSize);
   ymuint32 n = block(mSize);
-  mVal0 = new ymuint32[n];
-  mVal1 = new ymuint32[n];
   for (ymuint32 i = 0; i < n; ++ i) {
     mVal0[i] = src.mVal0[i];
     mVal1[i] = src.mVal1[i];
   }
 }
 
+// ムーブコンストラクタ
+BitVector::BitVector(BitVector&& src) :
+  mSize(0),
+  mFlags(src.mFlags),
+  mVal0(nullptr),
+  mVal1(nullptr)
+{
+  move_buff(src);
+}
+
+// デストラクタ
+BitVector::~BitVector()
+{
+  free_buff();
+}
+
 // 代入演算子
 const BitVector&
 BitVector::operator=(const BitVector& src)
 {
   if ( &src != this ) {
-    mSize = src.mSize;
+    resize(src.mSize);
     mFlags = src.mFlags;
     ymuint32 n = block(mSize);
-    mVal0 = new ymuint32[n];
-    mVal1 = new ymuint32[n];
     for (ymuint32 i = 0; i < n; ++ i) {
       mVal0[i] = src.mVal0[i];
       mVal1[i] = src.mVal1[i];
@@ -611,6 +861,18 @@ BitVector::operator=(const BitVector& src)
   return *this;
 }
 
+// ムーブ代入演算子
+const BitVector&
+BitVector::operator=(BitVector&& src)
+{
+  if ( &src != this ) {
+    free_buff();
+    mFlags = src.mFlags;
+    move_buff(src);
+  }
+  return *this;
+}
+
 // ビット長の変換を行うコピーコンストラクタもどき
 BitVector::BitVector(const BitVector& src,
 		     ymuint32 size) :
@@ -1293,28 +1555,9 @@ BitVector::operator*=(const BitVector& src)
   set_type(ans_sized, ans_signed, ans_base);
 
   ymuint32 n = block(size());
-  ymuint32 carry = 0;
+  mult_low(tmp1.mVal1, tmp2.mVal1, n, mVal1);
   for (ymuint32 i = 0; i < n; ++ i) {
-    ymuint32 v = carry;
-    carry = 0;
-    for (ymuint32 j = 0; j <= i; ++ j) {
-      ymuint32 old_v = v;
-      pair<ymuint32, ymuint32> tmp = mult32(tmp1.mVal1[j], tmp2.mVal1[i - j]);
-      v += tmp.second;
-      if ( v < old_v ) {
-	++ carry;
-      }
-    }
-    for (ymuint32 j = 0; j < i; ++ j) {
-      ymuint32 old_v = v;
-      pair<ymuint32, ymuint32> tmp = mult32(tmp1.mVal1[j], tmp2.mVal1[i - j - 1]);
-      v += tmp.first;
-      if ( v < old_v ) {
-	++ carry;
-      }
-    }
-    mVal1[i] = v;
-    mVal0[i] = ~v;
+    mVal0[i] = ~mVal1[i];
   }
   // 上位ビットをマスクしておく
   ymuint32 m = mask(ans_size);
@@ -1358,24 +1601,22 @@ BitVector::operator/=(const BitVector& src)
   BitVector tmp2 = ans_signed && src.is_negative() ? - src : src;
   bool invert = ans_signed ? is_negative() ^ src.is_negative() : false;
 
-  set_type(ans_sized, ans_signed, ans_base);
-
-  tmp1.set_type(tmp1.is_sized(), false, tmp1.base());
-  tmp2.set_type(tmp2.is_sized(), false, tmp2.base());
+  ymuint32 n = block(ans_size);
+  if ( is_all0(tmp2.mVal1, n) ) {
+    // 0 での除算の結果は X となる．
+    return *this = BitVector::x(ans_size);
+  }
 
-  BitVector p(VlScalarVal::zero(), ans_size);
-  for (ymuint32 i = ans_size; i -- > 0; ) {
-    p <<= 1;
-    if ( tmp1.value(i).is_one() ) {
-      p.mVal0[0] &= ~1U;
-      p.mVal1[0] |= 1U;
-    }
-    if ( p >= tmp2 ) {
-      p -= tmp2;
-      mVal0[i] &= ~1U;
-      mVal1[i] |= 1U;
-    }
+  set_type(ans_sized, ans_signed, ans_base);
+  vector<ymuint32> q(n);
+  vector<ymuint32> r(n);
+  divmod(tmp1.mVal1, tmp2.mVal1, n, &q[0], &r[0]);
+  for (ymuint32 i = 0; i < n; ++ i) {
+    mVal1[i] = q[i];
+    mVal0[i] = ~q[i];
   }
+  ymuint32 m = mask(ans_size);
+  mVal0[n - 1] |= ~m;
 
   if ( invert ) {
     complement();
@@ -1414,21 +1655,22 @@ BitVector::operator%=(const BitVector& src)
   BitVector tmp2 = ans_signed && src.is_negative() ? - src : src;
   bool invert = ans_signed ? is_negative() : false;
 
-  tmp2.set_type(tmp2.is_sized(), false, tmp2.base());
+  ymuint32 n = block(ans_size);
+  if ( is_all0(tmp2.mVal1, n) ) {
+    // 0 での剰余算の結果は X となる．
+    return *this = BitVector::x(ans_size);
+  }
 
   set_type(ans_sized, ans_signed, ans_base);
-  *this = BitVector(VlScalarVal::zero(), ans_size);
-
-  for (ymuint32 i = ans_size; i -- > 0; ) {
-    operator<<=(1);
-    if ( tmp1.value(i).is_one() ) {
-      mVal0[0] &= ~1U;
-      mVal1[0] |= 1U;
-    }
-    if ( *this >= tmp2 ) {
-      operator-=(tmp2);
-    }
+  vector<ymuint32> q(n);
+  vector<ymuint32> r(n);
+  divmod(tmp1.mVal1, tmp2.mVal1, n, &q[0], &r[0]);
+  for (ymuint32 i = 0; i < n; ++ i) {
+    mVal1[i] = r[i];
+    mVal0[i] = ~r[i];
   }
+  ymuint32 m = mask(ans_size);
+  mVal0[n - 1] |= ~m;
 
   if ( invert ) {
     complement();
@@ -3104,6 +3346,16 @@ BitVector::set(const ymuint32* val0,
 	       bool has_sign,
 	       int base)
 {
+  if ( val0 == mVal0 && block(size) > block(mSize) ) {
+    // 自分自身の値を拡張する場合には resize() で領域が
+    // 解放される前にコピーしておく．
+    ymuint32 src_n = block(src_size);
+    vector<ymuint32> tmp0(val0, val0 + src_n);
+    vector<ymuint32> tmp1(val1, val1 + src_n);
+    set(tmp0, tmp1, src_size, size, has_size, has_sign, base);
+    return;
+  }
+
   resize(size);
   set_type(has_size, has_sign, base);
 
@@ -3216,15 +3468,56 @@ BitVector::set(const vector<ymuint32>& val0,
 void
 BitVector::resize(ymuint32 size)
 {
-  ymuint32 old_bsize = block(mSize);
+  ymuint32 old_bsize = mVal0 == mBuff ? kInlineBlockNum : block(mSize);
   mSize = size;
   ymuint32 new_bsize = block(mSize);
   if ( new_bsize > old_bsize ) {
+    free_buff();
+    if ( new_bsize <= kInlineBlockNum ) {
+      mVal0 = mBuff;
+      mVal1 = mBuff + kInlineBlockNum;
+    }
+    else {
+      mVal0 = new ymuint32[new_bsize * 2];
+      mVal1 = mVal0 + new_bsize;
+    }
+  }
+}
+
+// mVal0, mVal1 の領域を解放する．
+void
+BitVector::free_buff()
+{
+  if ( mVal0 != mBuff ) {
     delete [] mVal0;
-    delete [] mVal1;
-    mVal0 = new ymuint32[new_bsize];
-    mVal1 = new ymuint32[new_bsize];
   }
+  mVal0 = nullptr;
+  mVal1 = nullptr;
+}
+
+// src の領域を自分のものにする．
+// src は空になる．
+void
+BitVector::move_buff(BitVector& src)
+{
+  mSize = src.mSize;
+  if ( src.mVal0 == src.mBuff ) {
+    // 固定領域の場合はコピーするしかない．
+    mVal0 = mBuff;
+    mVal1 = mBuff + kInlineBlockNum;
+    ymuint32 n = block(mSize);
+    for (ymuint32 i = 0; i < n; ++ i) {
+      mVal0[i] = src.mVal0[i];
+      mVal1[i] = src.mVal1[i];
+    }
+  }
+  else {
+    mVal0 = src.mVal0;
+    mVal1 = src.mVal1;
+  }
+  src.mSize = 0;
+  src.mVal0 = nullptr;
+  src.mVal1 = nullptr;
 }
 
 // 属性(サイズの有無, 符号の有無,基数)をセットする．
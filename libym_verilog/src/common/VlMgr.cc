@@ -50,6 +50,8 @@ VlMgr::clear()
 {
   mPtMgr->clear();
   mElbMgr->clear();
+  mLibFileList.clear();
+  mLibPathList.clear();
   mAlloc.destroy();
 }
 
@@ -69,6 +71,114 @@ VlMgr::read_file(const string& filename,
   return parser.read_file(filename, searchpath, watcher_list);
 }
 
+// @brief ライブラリファイルを読み込む．
+// @param[in] filename 読み込むファイル名
+// @param[in] searchpath サーチパス
+// @param[in] watcher_list 行番号ウォッチャーのリスト
+// @retval true 正常に終了した．
+// @retval false エラーが起こった．
+bool
+VlMgr::read_library(const string& filename,
+		    const SearchPathList& searchpath,
+		    const list<VlLineWatcher*> watcher_list)
+{
+  ymuint lib_id = mLibFileList.size();
+  mLibFileList.push_back(filename);
+  mLibPathList.push_back(searchpath);
+
+  // ここでは名前を登録するだけ
+  Parser parser(*mPtMgr, mAlloc, *mPtiFactory);
+  HashSet<string> load_set;
+  return parser.read_library(filename, searchpath, watcher_list,
+			     lib_id, load_set);
+}
+
+BEGIN_NONAMESPACE
+
+// @brief 本体を読み込むライブラリモジュールを追加する．
+// @param[in] pt_mgr パース木を管理するクラス
+// @param[in] pos ライブラリモジュールの位置番号
+// @param[inout] done_set 追加済みのモジュール名の集合
+// @param[inout] queue 追加したライブラリモジュールの位置番号のリスト
+// @note すでに定義されているものと追加済みのものは無視する．
+void
+add_lib_module(const PtMgr& pt_mgr,
+	       ymuint pos,
+	       HashSet<string>& done_set,
+	       vector<ymuint>& queue)
+{
+  const PtLibModule& lib_module = pt_mgr.lib_module(pos);
+  const char* name = lib_module.mName.c_str();
+  if ( pt_mgr.check_defined_name(name) || done_set.check(name) ) {
+    return;
+  }
+  done_set.add(name);
+  queue.push_back(pos);
+}
+
+END_NONAMESPACE
+
+// @brief 参照されているライブラリモジュールの本体を読み込む．
+// @retval true 正常に終了した．
+// @retval false エラーが起こった．
+bool
+VlMgr::load_lib_modules()
+{
+  // 読み飛ばした時に記録しておいた参照関係をたどって本体の必要な
+  // ライブラリモジュールをまとめて求め，各ライブラリファイルは
+  // 1度だけ読み込むようにする．
+  // 参照関係は字句の並びから推定したものなので，読み込んだ本体で
+  // 新たに参照されたものがあれば繰り返す．
+  HashSet<string> done_set;
+  ymuint nl = mLibFileList.size();
+  for ( ; ; ) {
+    vector<ymuint> queue;
+    for (ymuint pos = 0; pos < mPtMgr->lib_module_num(); ++ pos) {
+      const PtLibModule& lib_module = mPtMgr->lib_module(pos);
+      if ( mPtMgr->check_def_name(lib_module.mName.c_str()) ) {
+	add_lib_module(*mPtMgr, pos, done_set, queue);
+      }
+    }
+    if ( queue.empty() ) {
+      break;
+    }
+
+    vector<HashSet<string> > load_set_array(nl);
+    for (ymuint rpos = 0; rpos < queue.size(); ++ rpos) {
+      const PtLibModule& lib_module = mPtMgr->lib_module(queue[rpos]);
+      load_set_array[lib_module.mLibId].add(lib_module.mName);
+      for (vector<string>::const_iterator p = lib_module.mRefList.begin();
+	   p != lib_module.mRefList.end(); ++ p) {
+	ymuint pos1;
+	if ( mPtMgr->find_lib_module(p->c_str(), pos1) ) {
+	  add_lib_module(*mPtMgr, pos1, done_set, queue);
+	}
+      }
+      for (vector<string>::const_iterator p = lib_module.mCallRefList.begin();
+	   p != lib_module.mCallRefList.end(); ++ p) {
+	ymuint pos1;
+	if ( mPtMgr->find_lib_module(p->c_str(), pos1) &&
+	     mPtMgr->lib_module(pos1).mUdp ) {
+	  add_lib_module(*mPtMgr, pos1, done_set, queue);
+	}
+      }
+    }
+
+    for (ymuint lib_id = 0; lib_id < nl; ++ lib_id) {
+      if ( load_set_array[lib_id].num() == 0 ) {
+	continue;
+      }
+      Parser parser(*mPtMgr, mAlloc, *mPtiFactory);
+      if ( !parser.read_library(mLibFileList[lib_id], mLibPathList[lib_id],
+				list<VlLineWatcher*>(), lib_id,
+				load_set_array[lib_id]) ) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
 // @brief 登録されているモジュールのリストを返す．
 // @return 登録されているモジュールのリスト
 const list<const PtModule*>&
@@ -87,11 +197,17 @@ VlMgr::pt_udp_list() const
 
 // @brief エラボレーションを行う．
 // @param[in] cell_library セルライブラリ
+// @param[in] thread_num phase2/phase3 の処理に用いるスレッド数
 // @param[in] エラー数を返す．
 ymuint
-VlMgr::elaborate(const CellLibrary* cell_library)
+VlMgr::elaborate(const CellLibrary* cell_library,
+		 ymuint thread_num)
 {
-  Elaborator elab(*mElbMgr, *mElbFactory, cell_library);
+  if ( !load_lib_modules() ) {
+    return 1;
+  }
+
+  Elaborator elab(*mElbMgr, *mElbFactory, cell_library, thread_num);
 
   return elab(*mPtMgr);
 }
@@ -324,7 +440,7 @@ VlMgr::find_attr(const VlObj* obj,
 ymuint
 VlMgr::allocated_size() const
 {
-  return mAlloc.allocated_size();
+  return mAlloc.allocated_size() + mElbMgr->allocated_size();
 }
 
 END_NAMESPACE_YM_VERILOG
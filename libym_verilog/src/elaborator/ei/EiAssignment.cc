@@ -40,12 +40,12 @@ EiFactory::new_Assignment(const VlNamedObj* parent,
 {
   ElbStmt* stmt = nullptr;
   if ( block ) {
-    void* p = mAlloc.get_memory(sizeof(EiAssignment));
+    void* p = alloc().get_memory(sizeof(EiAssignment));
     stmt = new (p) EiAssignment(parent, process, pt_stmt,
 				lhs, rhs, control);
   }
   else {
-    void* p = mAlloc.get_memory(sizeof(EiNbAssignment));
+    void* p = alloc().get_memory(sizeof(EiNbAssignment));
     stmt = new (p) EiNbAssignment(parent, process, pt_stmt,
 				  lhs, rhs, control);
   }
@@ -65,7 +65,7 @@ EiFactory::new_AssignStmt(const VlNamedObj* parent,
 			  ElbExpr* lhs,
 			  ElbExpr* rhs)
 {
-  void* p = mAlloc.get_memory(sizeof(EiAssignStmt));
+  void* p = alloc().get_memory(sizeof(EiAssignStmt));
   ElbStmt* stmt = new (p) EiAssignStmt(parent, process, pt_stmt,
 				      lhs, rhs);
 
@@ -83,7 +83,7 @@ EiFactory::new_DeassignStmt(const VlNamedObj* parent,
 			    const PtStmt* pt_stmt,
 			    ElbExpr* lhs)
 {
-  void* p = mAlloc.get_memory(sizeof(EiAssignStmt));
+  void* p = alloc().get_memory(sizeof(EiAssignStmt));
   ElbStmt* stmt = new (p) EiDeassignStmt(parent, process, pt_stmt,
 					lhs);
 
@@ -103,7 +103,7 @@ EiFactory::new_ForceStmt(const VlNamedObj* parent,
 			 ElbExpr* lhs,
 			 ElbExpr* rhs)
 {
-  void* p = mAlloc.get_memory(sizeof(EiForceStmt));
+  void* p = alloc().get_memory(sizeof(EiForceStmt));
   ElbStmt* stmt = new (p) EiForceStmt(parent, process, pt_stmt,
 				     lhs, rhs);
 
@@ -121,7 +121,7 @@ EiFactory::new_ReleaseStmt(const VlNamedObj* parent,
 			   const PtStmt* pt_stmt,
 			   ElbExpr* lhs)
 {
-  void* p = mAlloc.get_memory(sizeof(EiReleaseStmt));
+  void* p = alloc().get_memory(sizeof(EiReleaseStmt));
   ElbStmt* stmt = new (p) EiReleaseStmt(parent, process, pt_stmt,
 				       lhs);
 
@@ -25,10 +25,10 @@ BEGIN_NAMESPACE_YM_VERILOG
 ElbAttrList*
 EiFactory::new_AttrList(ymuint n)
 {
-  void* q = mAlloc.get_memory(sizeof(EiAttribute) * n);
+  void* q = alloc().get_memory(sizeof(EiAttribute) * n);
   EiAttribute* array = new (q) EiAttribute[n];
 
-  void* p = mAlloc.get_memory(sizeof(EiAttrList));
+  void* p = alloc().get_memory(sizeof(EiAttrList));
   EiAttrList* attr_list = new (p) EiAttrList(n, array);
 
   return attr_list;
@@ -37,7 +37,7 @@ EiFactory::new_BinaryOp(const PtExpr* pt_expr,
   case kVlBitOrOp:
   case kVlBitXNorOp:
   case kVlBitXorOp:
-    p = mAlloc.get_memory(sizeof(EiBinaryBitOp));
+    p = alloc().get_memory(sizeof(EiBinaryBitOp));
     expr = new (p) EiBinaryBitOp(pt_expr, opr0, opr1);
     break;
 
@@ -46,12 +46,12 @@ EiFactory::new_BinaryOp(const PtExpr* pt_expr,
   case kVlMultOp:
   case kVlDivOp:
   case kVlModOp:
-    p = mAlloc.get_memory(sizeof(EiBinaryArithOp));
+    p = alloc().get_memory(sizeof(EiBinaryArithOp));
     expr = new (p) EiBinaryArithOp(pt_expr, opr0, opr1);
     break;
 
   case kVlPowerOp:
-    p = mAlloc.get_memory(sizeof(EiPowerOp));
+    p = alloc().get_memory(sizeof(EiPowerOp));
     expr = new (p) EiPowerOp(pt_expr, opr0, opr1);
     break;
 
@@ -59,13 +59,13 @@ EiFactory::new_BinaryOp(const PtExpr* pt_expr,
   case kVlRShiftOp:
   case kVlArithLShiftOp:
   case kVlArithRShiftOp:
-    p = mAlloc.get_memory(sizeof(EiShiftOp));
+    p = alloc().get_memory(sizeof(EiShiftOp));
     expr = new (p) EiShiftOp(pt_expr, opr0, opr1);
     break;
 
   case kVlLogAndOp:
   case kVlLogOrOp:
-    p = mAlloc.get_memory(sizeof(EiBinaryLogOp));
+    p = alloc().get_memory(sizeof(EiBinaryLogOp));
     expr = new (p) EiBinaryLogOp(pt_expr, opr0, opr1);
     break;
 
@@ -77,7 +77,7 @@ EiFactory::new_BinaryOp(const PtExpr* pt_expr,
   case kVlGtOp:
   case kVlLeOp:
   case kVlLtOp:
-    p = mAlloc.get_memory(sizeof(EiCompareOp));
+    p = alloc().get_memory(sizeof(EiCompareOp));
     expr = new (p) EiCompareOp(pt_expr, opr0, opr1);
     break;
 
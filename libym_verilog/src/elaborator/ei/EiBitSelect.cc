@@ -33,7 +33,7 @@ EiFactory::new_BitSelect(const PtExpr* pt_expr,
 			 const PtExpr* index_expr,
 			 int index_val)
 {
-  void* p = mAlloc.get_memory(sizeof(EiConstBitSelect));
+  void* p = alloc().get_memory(sizeof(EiConstBitSelect));
   return new (p) EiConstBitSelect(pt_expr, base_expr,
 				  index_expr, index_val);
 }
@@ -47,7 +47,7 @@ EiFactory::new_BitSelect(const PtExpr* pt_expr,
 			 ElbExpr* base_expr,
 			 int index_val)
 {
-  void* p = mAlloc.get_memory(sizeof(EiConstBitSelect));
+  void* p = alloc().get_memory(sizeof(EiConstBitSelect));
   return new (p) EiConstBitSelect(pt_expr, base_expr, nullptr, index_val);
 }
 
@@ -60,7 +60,7 @@ EiFactory::new_BitSelect(const PtExpr* pt_expr,
 			 ElbExpr* base_expr,
 			 ElbExpr* index_expr)
 {
-  void* p = mAlloc.get_memory(sizeof(EiVarBitSelect));
+  void* p = alloc().get_memory(sizeof(EiVarBitSelect));
   return new (p) EiVarBitSelect(pt_expr, base_expr, index_expr);
 }
 
@@ -33,7 +33,7 @@ EiFactory::new_Begin(const VlNamedObj* parent,
 		     ElbStmt** stmt_list)
 {
   ymuint stmt_num = pt_stmt->stmt_array().size();
-  void* p = mAlloc.get_memory(sizeof(EiBegin));
+  void* p = alloc().get_memory(sizeof(EiBegin));
   EiBegin* stmt = new (p) EiBegin(parent, process, pt_stmt,
 				  stmt_num, stmt_list);
 
@@ -52,7 +52,7 @@ EiFactory::new_Fork(const VlNamedObj* parent,
 		    ElbStmt** stmt_list)
 {
   ymuint stmt_num = pt_stmt->stmt_array().size();
-  void* p = mAlloc.get_memory(sizeof(EiFork));
+  void* p = alloc().get_memory(sizeof(EiFork));
   EiFork* stmt = new (p) EiFork(parent, process, pt_stmt,
 				stmt_num, stmt_list);
 
@@ -71,7 +71,7 @@ EiFactory::new_NamedBegin(const VlNamedObj* block,
 			  ElbStmt** stmt_list)
 {
   ymuint stmt_num = pt_stmt->stmt_array().size();
-  void* p = mAlloc.get_memory(sizeof(EiNamedBegin));
+  void* p = alloc().get_memory(sizeof(EiNamedBegin));
   EiNamedBegin* stmt = new (p) EiNamedBegin(block, process,
 					    stmt_num, stmt_list);
 
@@ -90,7 +90,7 @@ EiFactory::new_NamedFork(const VlNamedObj* block,
 			 ElbStmt** stmt_list)
 {
   ymuint stmt_num = pt_stmt->stmt_array().size();
-  void* p = mAlloc.get_memory(sizeof(EiNamedFork));
+  void* p = alloc().get_memory(sizeof(EiNamedFork));
   EiNamedFork* stmt = new (p) EiNamedFork(block, process,
 					  stmt_num, stmt_list);
 
@@ -35,7 +35,7 @@ EiFactory::new_WhileStmt(const VlNamedObj* parent,
 			 ElbExpr* cond,
 			 ElbStmt* stmt)
 {
-  void* p = mAlloc.get_memory(sizeof(EiWhileStmt));
+  void* p = alloc().get_memory(sizeof(EiWhileStmt));
   ElbStmt* stmt1 = new (p) EiWhileStmt(parent, process, pt_stmt,
 				       cond, stmt);
 
@@ -55,7 +55,7 @@ EiFactory::new_RepeatStmt(const VlNamedObj* parent,
 			  ElbExpr* cond,
 			  ElbStmt* stmt)
 {
-  void* p = mAlloc.get_memory(sizeof(EiRepeatStmt));
+  void* p = alloc().get_memory(sizeof(EiRepeatStmt));
   ElbStmt* stmt1 = new (p) EiRepeatStmt(parent, process, pt_stmt,
 					cond, stmt);
 
@@ -75,7 +75,7 @@ EiFactory::new_WaitStmt(const VlNamedObj* parent,
 			ElbExpr* cond,
 			ElbStmt* stmt)
 {
-  void* p = mAlloc.get_memory(sizeof(EiWaitStmt));
+  void* p = alloc().get_memory(sizeof(EiWaitStmt));
   ElbStmt* stmt1 = new (p) EiWaitStmt(parent, process, pt_stmt,
 				      cond, stmt);
 
@@ -99,7 +99,7 @@ EiFactory::new_ForStmt(const VlNamedObj* parent,
 		       ElbStmt* inc_stmt,
 		       ElbStmt* stmt)
 {
-  void* p = mAlloc.get_memory(sizeof(EiForStmt));
+  void* p = alloc().get_memory(sizeof(EiForStmt));
   ElbStmt* stmt1 = new (p) EiForStmt(parent, process, pt_stmt,
 				     cond, init_stmt, inc_stmt, stmt);
 
@@ -117,7 +117,7 @@ EiFactory::new_ForeverStmt(const VlNamedObj* parent,
 			   const PtStmt* pt_stmt,
 			   ElbStmt* stmt)
 {
-  void* p = mAlloc.get_memory(sizeof(EiForeverStmt));
+  void* p = alloc().get_memory(sizeof(EiForeverStmt));
   ElbStmt* stmt1 = new (p) EiForeverStmt(parent, process, pt_stmt,
 					 stmt);
 
@@ -142,12 +142,12 @@ EiFactory::new_IfStmt(const VlNamedObj* parent,
 {
   ElbStmt* stmt1;
   if ( else_stmt ) {
-    void* p = mAlloc.get_memory(sizeof(EiIfElseStmt));
+    void* p = alloc().get_memory(sizeof(EiIfElseStmt));
     stmt1 = new (p) EiIfElseStmt(parent, process, pt_stmt,
 				 cond, stmt, else_stmt);
   }
   else {
-    void* p = mAlloc.get_memory(sizeof(EiIfStmt));
+    void* p = alloc().get_memory(sizeof(EiIfStmt));
     stmt1 = new (p) EiIfStmt(parent, process, pt_stmt,
 			     cond, stmt);
   }
@@ -167,10 +167,10 @@ EiFactory::new_CaseStmt(const VlNamedObj* parent,
 {
   ymuint caseitem_num = pt_stmt->caseitem_num();
 
-  void* q = mAlloc.get_memory(sizeof(EiCaseItem) * caseitem_num);
+  void* q = alloc().get_memory(sizeof(EiCaseItem) * caseitem_num);
   EiCaseItem* array = new (q) EiCaseItem[caseitem_num];
 
-  void* p = mAlloc.get_memory(sizeof(EiCaseStmt));
+  void* p = alloc().get_memory(sizeof(EiCaseStmt));
   EiCaseStmt* stmt1 = new (p) EiCaseStmt(parent, process, pt_stmt,
 					 expr,
 					 caseitem_num, array);
@@ -32,7 +32,7 @@ EiFactory::new_Constant(const PtExpr* pt_expr)
   switch ( const_type ) {
   case kVpiIntConst:
     if ( pt_expr->const_str() == nullptr ) {
-      void* p = mAlloc.get_memory(sizeof(EiIntConst));
+      void* p = alloc().get_memory(sizeof(EiIntConst));
       return new (p) EiIntConst(pt_expr, pt_expr->const_uint());
     }
     break;
@@ -63,13 +63,13 @@ EiFactory::new_Constant(const PtExpr* pt_expr)
 
   case kVpiRealConst:
     {
-      void* p = mAlloc.get_memory(sizeof(EiRealConst));
+      void* p = alloc().get_memory(sizeof(EiRealConst));
       return new (p) EiRealConst(pt_expr, pt_expr->const_real());
     }
 
   case kVpiStringConst:
     {
-      void* p = mAlloc.get_memory(sizeof(EiStringConst));
+      void* p = alloc().get_memory(sizeof(EiStringConst));
       return new (p) EiStringConst(pt_expr, pt_expr->const_str());
     }
 
@@ -79,7 +79,7 @@ EiFactory::new_Constant(const PtExpr* pt_expr)
   }
 
   // ここに来たということはビットベクタ型
-  void* p = mAlloc.get_memory(sizeof(EiBitVectorConst));
+  void* p = alloc().get_memory(sizeof(EiBitVectorConst));
   return new (p) EiBitVectorConst(pt_expr, const_type,
 				  BitVector(size, is_signed, base,
 					    pt_expr->const_str()));
@@ -92,7 +92,7 @@ ElbExpr*
 EiFactory::new_GenvarConstant(const PtExpr* pt_primary,
 			      int val)
 {
-  void* p = mAlloc.get_memory(sizeof(EiIntConst));
+  void* p = alloc().get_memory(sizeof(EiIntConst));
   return new (p) EiIntConst(pt_primary, val);
 }
 
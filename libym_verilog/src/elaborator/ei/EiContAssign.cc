@@ -34,11 +34,11 @@ EiFactory::new_CaHead(const VlModule* module,
 {
   EiCaHead* head = nullptr;
   if ( delay ) {
-    void* p = mAlloc.get_memory(sizeof(EiCaHeadD));
+    void* p = alloc().get_memory(sizeof(EiCaHeadD));
     head = new (p) EiCaHeadD(module, pt_head, delay);
   }
   else {
-    void* p = mAlloc.get_memory(sizeof(EiCaHead));
+    void* p = alloc().get_memory(sizeof(EiCaHead));
     head = new (p) EiCaHead(module, pt_head);
   }
   return head;
@@ -55,7 +55,7 @@ EiFactory::new_ContAssign(ElbCaHead* head,
 			  ElbExpr* lhs,
 			  ElbExpr* rhs)
 {
-  void* p = mAlloc.get_memory(sizeof(EiContAssign1));
+  void* p = alloc().get_memory(sizeof(EiContAssign1));
   EiContAssign* cont_assign = new (p) EiContAssign1(head, pt_obj, lhs, rhs);
 
   return cont_assign;
@@ -72,7 +72,7 @@ EiFactory::new_ContAssign(const VlModule* module,
 			  ElbExpr* lhs,
 			  ElbExpr* rhs)
 {
-  void* p = mAlloc.get_memory(sizeof(EiContAssign2));
+  void* p = alloc().get_memory(sizeof(EiContAssign2));
   EiContAssign* cont_assign = new (p) EiContAssign2(module, pt_obj, lhs, rhs);
 
   return cont_assign;
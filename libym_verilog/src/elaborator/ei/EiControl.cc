@@ -27,7 +27,7 @@ ElbControl*
 EiFactory::new_DelayControl(const PtControl* pt_control,
 			    ElbExpr* delay)
 {
-  void* p = mAlloc.get_memory(sizeof(EiDelayControl));
+  void* p = alloc().get_memory(sizeof(EiDelayControl));
   EiDelayControl* control = new (p) EiDelayControl(pt_control, delay);
 
   return control;
@@ -42,7 +42,7 @@ EiFactory::new_EventControl(const PtControl* pt_control,
 			    ymuint event_num,
 			    ElbExpr** event_list)
 {
-  void* p = mAlloc.get_memory(sizeof(EiEventControl));
+  void* p = alloc().get_memory(sizeof(EiEventControl));
   EiEventControl* control = new (p) EiEventControl(pt_control,
 						   event_num, event_list);
 
@@ -60,7 +60,7 @@ EiFactory::new_RepeatControl(const PtControl* pt_control,
 			     ymuint event_num,
 			     ElbExpr** event_list)
 {
-  void* p = mAlloc.get_memory(sizeof(EiRepeatControl));
+  void* p = alloc().get_memory(sizeof(EiRepeatControl));
   EiRepeatControl* control = new (p) EiRepeatControl(pt_control, rep,
 						     event_num, event_list);
 
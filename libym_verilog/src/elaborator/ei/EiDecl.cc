@@ -39,11 +39,11 @@ EiFactory::new_Decl(ElbDeclHead* head,
   case kVpiNet:
     if ( head->bit_size() == 1 ) {
       if ( init ) {
-	void* p = mAlloc.get_memory(sizeof(EiDeclIS));
+	void* p = alloc().get_memory(sizeof(EiDeclIS));
 	decl = new (p) EiDeclIS(head, pt_item, init);
       }
       else {
-	void* p = mAlloc.get_memory(sizeof(EiDeclS));
+	void* p = alloc().get_memory(sizeof(EiDeclS));
 	decl = new (p) EiDeclS(head, pt_item);
       }
       break;
@@ -53,22 +53,22 @@ EiFactory::new_Decl(ElbDeclHead* head,
   case kVpiIntegerVar:
   case kVpiTimeVar:
     if ( init ) {
-      void* p = mAlloc.get_memory(sizeof(EiDeclIV));
+      void* p = alloc().get_memory(sizeof(EiDeclIV));
       decl = new (p) EiDeclIV(head, pt_item, init);
     }
     else {
-      void* p = mAlloc.get_memory(sizeof(EiDeclV));
+      void* p = alloc().get_memory(sizeof(EiDeclV));
       decl = new (p) EiDeclV(head, pt_item);
     }
     break;
 
   case kVpiRealVar:
     if ( init ) {
-      void* p = mAlloc.get_memory(sizeof(EiDeclIR));
+      void* p = alloc().get_memory(sizeof(EiDeclIR));
       decl = new (p) EiDeclIR(head, pt_item, init);
     }
     else {
-      void* p = mAlloc.get_memory(sizeof(EiDeclR));
+      void* p = alloc().get_memory(sizeof(EiDeclR));
       decl = new (p) EiDeclR(head, pt_item);
     }
     break;
@@ -76,7 +76,7 @@ EiFactory::new_Decl(ElbDeclHead* head,
   case kVpiNamedEvent:
     ASSERT_COND(init == nullptr );
     {
-      void* p = mAlloc.get_memory(sizeof(EiDeclN));
+      void* p = alloc().get_memory(sizeof(EiDeclN));
       decl = new (p) EiDeclN(head, pt_item);
     }
     break;
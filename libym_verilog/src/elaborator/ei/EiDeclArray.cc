@@ -34,7 +34,7 @@ EiFactory::new_DeclArray(ElbDeclHead* head,
 			 const vector<ElbRangeSrc>& range_src)
 {
   ymuint dim_size = range_src.size();
-  void* q = mAlloc.get_memory(sizeof(EiRange) * dim_size);
+  void* q = alloc().get_memory(sizeof(EiRange) * dim_size);
   EiRange* range_array = new (q) EiRange[dim_size];
   ymuint elem_size = 1;
   for (ymuint i = 0; i < dim_size; ++ i) {
@@ -49,9 +49,9 @@ EiFactory::new_DeclArray(ElbDeclHead* head,
   case kVpiReg:
   case kVpiNet:
     if ( head->bit_size() == 1 ) {
-      r = mAlloc.get_memory(sizeof(VlScalarVal) * elem_size);
+      r = alloc().get_memory(sizeof(VlScalarVal) * elem_size);
       VlScalarVal* varray = new (r) VlScalarVal[elem_size];
-      p = mAlloc.get_memory(sizeof(EiDeclArrayS));
+      p = alloc().get_memory(sizeof(EiDeclArrayS));
       decl = new (p) EiDeclArrayS(head, pt_item, dim_size, range_array,
 				  varray);
       break;
@@ -61,9 +61,9 @@ EiFactory::new_DeclArray(ElbDeclHead* head,
   case kVpiIntegerVar:
   case kVpiTimeVar:
     {
-      r = mAlloc.get_memory(sizeof(BitVector) * elem_size);
+      r = alloc().get_memory(sizeof(BitVector) * elem_size);
       BitVector* varray = new (r) BitVector[elem_size];
-      p = mAlloc.get_memory(sizeof(EiDeclArrayV));
+      p = alloc().get_memory(sizeof(EiDeclArrayV));
       decl = new (p) EiDeclArrayV(head, pt_item, dim_size, range_array,
 				  varray);
     }
@@ -71,16 +71,16 @@ EiFactory::new_DeclArray(ElbDeclHead* head,
 
   case kVpiRealVar:
     {
-      r = mAlloc.get_memory(sizeof(double) * elem_size);
+      r = alloc().get_memory(sizeof(double) * elem_size);
       double* varray = new (r) double[elem_size];
-      p = mAlloc.get_memory(sizeof(EiDeclArrayR));
+      p = alloc().get_memory(sizeof(EiDeclArrayR));
       decl = new (p) EiDeclArrayR(head, pt_item, dim_size, range_array,
 				  varray);
     }
     break;
 
   case kVpiNamedEvent:
-    p = mAlloc.get_memory(sizeof(EiDeclArrayN));
+    p = alloc().get_memory(sizeof(EiDeclArrayN));
     decl = new (p) EiDeclArrayN(head, pt_item, dim_size, range_array);
     break;
 
@@ -40,13 +40,13 @@ EiFactory::new_DeclHead(const VlNamedObj* parent,
 
   EiDeclHead* head = nullptr;
   if ( delay ) {
-    void* p = mAlloc.get_memory(sizeof(EiDeclHeadPtVD));
+    void* p = alloc().get_memory(sizeof(EiDeclHeadPtVD));
     head = new (p) EiDeclHeadPtVD(parent, pt_head,
 				  left, right,
 				  left_val, right_val);
   }
   else {
-    void* p = mAlloc.get_memory(sizeof(EiDeclHeadPtV));
+    void* p = alloc().get_memory(sizeof(EiDeclHeadPtV));
     head = new (p) EiDeclHeadPtV(parent, pt_head,
 				 left, right,
 				 left_val, right_val);
@@ -65,11 +65,11 @@ EiFactory::new_DeclHead(const VlNamedObj* parent,
 {
   EiDeclHead* head = nullptr;
   if ( delay ) {
-    void* p = mAlloc.get_memory(sizeof(EiDeclHeadPtD));
+    void* p = alloc().get_memory(sizeof(EiDeclHeadPtD));
     head = new (p) EiDeclHeadPtD(parent, pt_head);
   }
   else {
-    void* p = mAlloc.get_memory(sizeof(EiDeclHeadPt));
+    void* p = alloc().get_memory(sizeof(EiDeclHeadPt));
     head = new (p) EiDeclHeadPt(parent, pt_head);
   }
   return head;
@@ -94,7 +94,7 @@ EiFactory::new_DeclHead(const VlNamedObj* parent,
 {
   ASSERT_COND( left != nullptr && right != nullptr );
 
-  void* p = mAlloc.get_memory(sizeof(EiDeclHeadPt2V));
+  void* p = alloc().get_memory(sizeof(EiDeclHeadPt2V));
   EiDeclHead* head = new (p) EiDeclHeadPt2V(parent, pt_head, aux_type,
 					    left, right,
 					    left_val, right_val);
@@ -110,7 +110,7 @@ EiFactory::new_DeclHead(const VlNamedObj* parent,
 			const PtIOHead* pt_head,
 			tVpiAuxType aux_type)
 {
-  void* p = mAlloc.get_memory(sizeof(EiDeclHeadPt2));
+  void* p = alloc().get_memory(sizeof(EiDeclHeadPt2));
   EiDeclHead* head = new (p) EiDeclHeadPt2(parent, pt_head, aux_type);
   return head;
 }
@@ -132,7 +132,7 @@ EiFactory::new_DeclHead(const VlNamedObj* parent,
 {
   ASSERT_COND( left != nullptr && right != nullptr );
 
-  void* p = mAlloc.get_memory(sizeof(EiDeclHeadPt3V));
+  void* p = alloc().get_memory(sizeof(EiDeclHeadPt3V));
   EiDeclHead* head = new (p) EiDeclHeadPt3V(parent, pt_item,
 					    left, right,
 					    left_val, right_val);
@@ -146,7 +146,7 @@ ElbDeclHead*
 EiFactory::new_DeclHead(const VlNamedObj* parent,
 			const PtItem* pt_item)
 {
-  void* p = mAlloc.get_memory(sizeof(EiDeclHeadPt3));
+  void* p = alloc().get_memory(sizeof(EiDeclHeadPt3));
   EiDeclHead* head = new (p) EiDeclHeadPt3(parent, pt_item);
   return head;
 }
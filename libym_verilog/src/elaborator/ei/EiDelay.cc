@@ -29,7 +29,7 @@ EiFactory::new_Delay(const PtBase* pt_obj,
 		     ymuint elem_num,
 		     ElbExpr** expr_list)
 {
-  void* p = mAlloc.get_memory(sizeof(EiDelay));
+  void* p = alloc().get_memory(sizeof(EiDelay));
   EiDelay* delay = new (p) EiDelay(pt_obj, elem_num, expr_list);
 
   return delay;
@@ -20,6 +20,10 @@ BEGIN_NAMESPACE_YM_VERILOG
 // クラス EiFactory
 //////////////////////////////////////////////////////////////////////
 
+// 現在のスレッドで用いるアロケータ
+thread_local
+Alloc* EiFactory::mThreadAlloc = nullptr;
+
 // @brief コンストラクタ
 // @param[in] alloc メモリ確保用のアロケータ
 EiFactory::EiFactory(Alloc& alloc) :
@@ -38,12 +42,21 @@ EiFactory::dump_prof(ostream& s)
 {
 }
 
+// @brief 現在のスレッドで用いるアロケータを設定する．
+// @param[in] alloc アロケータ
+// @note nullptr を与えると本来のアロケータを用いる．
+void
+EiFactory::set_thread_alloc(Alloc* alloc)
+{
+  mThreadAlloc = alloc;
+}
+
 // @brief ステートメントの配列を生成する．
 // @param[in] stmt_num 要素数
 ElbStmt**
 EiFactory::new_StmtList(ymuint stmt_num)
 {
-  void* q = mAlloc.get_memory(sizeof(ElbStmt*) * stmt_num);
+  void* q = alloc().get_memory(sizeof(ElbStmt*) * stmt_num);
   ElbStmt** array = new (q) ElbStmt*[stmt_num];
 
   return array;
@@ -54,7 +67,7 @@ EiFactory::new_StmtList(ymuint stmt_num)
 ElbExpr**
 EiFactory::new_ExprList(ymuint elem_num)
 {
-  void* p = mAlloc.get_memory(sizeof(ElbExpr*) * elem_num);
+  void* p = alloc().get_memory(sizeof(ElbExpr*) * elem_num);
   ElbExpr** expr_array = new (p) ElbExpr*[elem_num];
 
   return expr_array;
@@ -30,7 +30,7 @@ EiFactory::new_FuncCall(const PtExpr* pt_expr,
 			ymuint arg_size,
 			ElbExpr** arg_list)
 {
-  void* p = mAlloc.get_memory(sizeof(EiFuncCall));
+  void* p = alloc().get_memory(sizeof(EiFuncCall));
   EiFuncCall* expr = new (p) EiFuncCall(pt_expr, func,
 					arg_size, arg_list);
 
@@ -48,7 +48,7 @@ EiFactory::new_SysFuncCall(const PtExpr* pt_expr,
 			   ymuint arg_size,
 			   ElbExpr** arg_list)
 {
-  void* p = mAlloc.get_memory(sizeof(EiSysFuncCall));
+  void* p = alloc().get_memory(sizeof(EiSysFuncCall));
   EiSysFuncCall* expr = new (p) EiSysFuncCall(pt_expr, user_systf,
 					      arg_size, arg_list);
 
@@ -25,7 +25,7 @@ ElbScope*
 EiFactory::new_GenBlock(const VlNamedObj* parent,
 			const PtItem* pt_item)
 {
-  void* p = mAlloc.get_memory(sizeof(EiGenBlock));
+  void* p = alloc().get_memory(sizeof(EiGenBlock));
   EiGenBlock* scope = new (p) EiGenBlock(parent, pt_item);
 
   return scope;
@@ -36,7 +36,7 @@ ElbGfRoot*
 EiFactory::new_GfRoot(const VlNamedObj* parent,
 		      const PtItem* pt_item)
 {
-  void* p = mAlloc.get_memory(sizeof(EiGfRoot));
+  void* p = alloc().get_memory(sizeof(EiGfRoot));
   EiGfRoot* gfroot = new (p) EiGfRoot(parent, pt_item);
 
   return gfroot;
@@ -51,7 +51,7 @@ EiFactory::new_GfBlock(const VlNamedObj* parent,
 		       const PtItem* pt_item,
 		       int gvi)
 {
-  void* p = mAlloc.get_memory(sizeof(EiGfBlock));
+  void* p = alloc().get_memory(sizeof(EiGfBlock));
   EiGfBlock* scope = new (p) EiGfBlock(parent, pt_item, gvi);
 
   return scope;
@@ -30,7 +30,7 @@ ElbIOHead*
 EiFactory::new_ModIOHead(ElbModule* module,
 			 const PtIOHead* pt_header)
 {
-  void* p = mAlloc.get_memory(sizeof(EiModIOHead));
+  void* p = alloc().get_memory(sizeof(EiModIOHead));
   EiIOHead* head = new (p) EiModIOHead(module, pt_header);
   return head;
 }
@@ -42,7 +42,7 @@ ElbIOHead*
 EiFactory::new_TaskIOHead(ElbTaskFunc* task,
 			  const PtIOHead* pt_header)
 {
-  void* p = mAlloc.get_memory(sizeof(EiTaskIOHead));
+  void* p = alloc().get_memory(sizeof(EiTaskIOHead));
   EiIOHead* head = new (p) EiTaskIOHead(task, pt_header);
   return head;
 }
@@ -54,7 +54,7 @@ ElbIOHead*
 EiFactory::new_FunctionIOHead(ElbTaskFunc* func,
 			      const PtIOHead* pt_header)
 {
-  void* p = mAlloc.get_memory(sizeof(EiFunctionIOHead));
+  void* p = alloc().get_memory(sizeof(EiFunctionIOHead));
   EiIOHead* head = new (p) EiFunctionIOHead(func, pt_header);
   return head;
 }
@@ -26,7 +26,7 @@ EiFactory::new_ImpNet(const VlNamedObj* parent,
 		      const PtExpr* pt_expr,
 		      tVpiNetType net_type)
 {
-  void* p = mAlloc.get_memory(sizeof(EiImpNet));
+  void* p = alloc().get_memory(sizeof(EiImpNet));
   EiImpNet* decl = new (p) EiImpNet(parent, pt_expr, net_type);
 
   return decl;
@@ -30,7 +30,7 @@ EiFactory::new_Lhs(const PtExpr* pt_expr,
 		   ymuint lhs_elem_num,
 		   ElbExpr** lhs_elem_array)
 {
-  void* p = mAlloc.get_memory(sizeof(EiLhs));
+  void* p = alloc().get_memory(sizeof(EiLhs));
   return new (p) EiLhs(pt_expr, opr_size, opr_array,
 		       lhs_elem_num, lhs_elem_array);
 }
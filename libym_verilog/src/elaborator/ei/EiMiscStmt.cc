@@ -36,7 +36,7 @@ EiFactory::new_EventStmt(const VlNamedObj* parent,
 			 const PtStmt* pt_stmt,
 			 ElbExpr* named_event)
 {
-  void* p = mAlloc.get_memory(sizeof(EiEventStmt));
+  void* p = alloc().get_memory(sizeof(EiEventStmt));
   ElbStmt* stmt = new (p) EiEventStmt(parent, process, pt_stmt,
 				      named_event);
 
@@ -52,7 +52,7 @@ EiFactory::new_NullStmt(const VlNamedObj* parent,
 			ElbProcess* process,
 			const PtStmt* pt_stmt)
 {
-  void* p = mAlloc.get_memory(sizeof(EiNullStmt));
+  void* p = alloc().get_memory(sizeof(EiNullStmt));
   ElbStmt* stmt = new (p) EiNullStmt(parent, process, pt_stmt);
 
   return stmt;
@@ -72,7 +72,7 @@ EiFactory::new_TaskCall(const VlNamedObj* parent,
 			ElbExpr** arg_array)
 {
   ymuint n = pt_stmt->arg_num();
-  void* p = mAlloc.get_memory(sizeof(EiTaskCall));
+  void* p = alloc().get_memory(sizeof(EiTaskCall));
   EiTaskCall* stmt = new (p) EiTaskCall(parent, process, pt_stmt,
 					task, n, arg_array);
 
@@ -93,7 +93,7 @@ EiFactory::new_SysTaskCall(const VlNamedObj* parent,
 			   ElbExpr** arg_array)
 {
   ymuint n = pt_stmt->arg_num();
-  void* p = mAlloc.get_memory(sizeof(EiSysTaskCall));
+  void* p = alloc().get_memory(sizeof(EiSysTaskCall));
   EiSysTaskCall* stmt = new (p) EiSysTaskCall(parent, process, pt_stmt,
 					      user_systf, n, arg_array);
 
@@ -111,7 +111,7 @@ EiFactory::new_DisableStmt(const VlNamedObj* parent,
 			   const PtStmt* pt_stmt,
 			   const VlNamedObj* target)
 {
-  void* p = mAlloc.get_memory(sizeof(EiDisableStmt));
+  void* p = alloc().get_memory(sizeof(EiDisableStmt));
   ElbStmt* stmt = new (p) EiDisableStmt(parent, process, pt_stmt,
 					target);
 
@@ -131,7 +131,7 @@ EiFactory::new_CtrlStmt(const VlNamedObj* parent,
 			ElbControl* control,
 			ElbStmt* stmt)
 {
-  void* p = mAlloc.get_memory(sizeof(EiCtrlStmt));
+  void* p = alloc().get_memory(sizeof(EiCtrlStmt));
   ElbStmt* stmt1 = new (p) EiCtrlStmt(parent, process, pt_stmt,
 				      control, stmt);
 
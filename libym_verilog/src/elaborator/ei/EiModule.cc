@@ -35,18 +35,18 @@ EiFactory::new_Module(const VlNamedObj* parent,
 		      const PtItem* pt_head,
 		      const PtInst* pt_inst)
 {
-  void* p = mAlloc.get_memory(sizeof(EiModule2));
+  void* p = alloc().get_memory(sizeof(EiModule2));
   EiModule2* module = new (p) EiModule2(parent,
 					pt_module,
 					pt_head,
 					pt_inst);
 
   ymuint port_num = pt_module->port_num();
-  void* q = mAlloc.get_memory(sizeof(EiPort) * port_num);
+  void* q = alloc().get_memory(sizeof(EiPort) * port_num);
   EiPort* port_array = new (q) EiPort[port_num];
 
   ymuint io_num = pt_module->iodecl_num();
-  void* r = mAlloc.get_memory(sizeof(EiIODecl) * io_num);
+  void* r = alloc().get_memory(sizeof(EiIODecl) * io_num);
   EiIODecl* io_array = new (r) EiIODecl[io_num];
 
   module->init(port_array, io_array);
@@ -77,10 +77,10 @@ EiFactory::new_ModuleArray(const VlNamedObj* parent,
   range.set(left, right, left_val, right_val);
 
   ymuint n = range.size();
-  void* q = mAlloc.get_memory(sizeof(EiModule1) * n);
+  void* q = alloc().get_memory(sizeof(EiModule1) * n);
   EiModule1* array = new (q) EiModule1[n];
 
-  void* p = mAlloc.get_memory(sizeof(EiModuleArray));
+  void* p = alloc().get_memory(sizeof(EiModuleArray));
   EiModuleArray* module_array = new (p) EiModuleArray(parent,
 						      pt_module,
 						      pt_head,
@@ -92,10 +92,10 @@ EiFactory::new_ModuleArray(const VlNamedObj* parent,
   ymuint io_num = pt_module->iodecl_num();
 
   for (ymuint i = 0; i < n; ++ i) {
-    void* r = mAlloc.get_memory(sizeof(EiPort) * port_num);
+    void* r = alloc().get_memory(sizeof(EiPort) * port_num);
     EiPort* port_array = new (r) EiPort[port_num];
 
-    void* s = mAlloc.get_memory(sizeof(EiIODecl) * io_num);
+    void* s = alloc().get_memory(sizeof(EiIODecl) * io_num);
     EiIODecl* io_array = new (s) EiIODecl[io_num];
 
     int index = module_array->mRange.index(i);
@@ -36,7 +36,7 @@ EiFactory::new_ParamAssign(const VlModule* module,
 			   const PtExpr* rhs_expr,
 			   const VlValue& rhs_value)
 {
-  void* p = mAlloc.get_memory(sizeof(EiParamAssign2));
+  void* p = alloc().get_memory(sizeof(EiParamAssign2));
   return new (p) EiParamAssign(module, pt_obj, param, rhs_expr, rhs_value);
 }
 
@@ -53,7 +53,7 @@ EiFactory::new_NamedParamAssign(const VlModule* module,
 				const PtExpr* rhs_expr,
 				const VlValue& rhs_value)
 {
-  void* p = mAlloc.get_memory(sizeof(EiParamAssign));
+  void* p = alloc().get_memory(sizeof(EiParamAssign));
   return new (p) EiParamAssign2(module, pt_obj, param, rhs_expr, rhs_value);
 }
 
@@ -72,7 +72,7 @@ EiFactory::new_DefParam(const VlModule* module,
 			const PtExpr* rhs_expr,
 			const VlValue& rhs_value)
 {
-  void* p = mAlloc.get_memory(sizeof(EiDefParam));
+  void* p = alloc().get_memory(sizeof(EiDefParam));
   return new (p) EiDefParam(module, pt_header, pt_defparam,
 			    param, rhs_expr, rhs_value);
 }
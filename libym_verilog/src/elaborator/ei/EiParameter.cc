@@ -30,7 +30,7 @@ ElbParamHead*
 EiFactory::new_ParamHead(const VlNamedObj* parent,
 			 const PtDeclHead* pt_head)
 {
-  void* p = mAlloc.get_memory(sizeof(EiParamHead));
+  void* p = alloc().get_memory(sizeof(EiParamHead));
   EiParamHead* head = new (p) EiParamHead(parent, pt_head);
   return head;
 }
@@ -51,7 +51,7 @@ EiFactory::new_ParamHead(const VlNamedObj* parent,
   ASSERT_COND( left != nullptr );
   ASSERT_COND( right != nullptr );
 
-  void* p = mAlloc.get_memory(sizeof(EiParamHeadV));
+  void* p = alloc().get_memory(sizeof(EiParamHeadV));
   EiParamHead* head = new (p) EiParamHeadV(parent, pt_head,
 					   left, right,
 					   left_val, right_val);
@@ -74,11 +74,11 @@ EiFactory::new_Parameter(ElbParamHead* head,
   case kVpiParameter:
   case kVpiSpecParam:
     if ( is_local ) {
-      void* p = mAlloc.get_memory(sizeof(EiLocalParam));
+      void* p = alloc().get_memory(sizeof(EiLocalParam));
       param = new (p) EiLocalParam(head, pt_item);
     }
     else {
-      void* p = mAlloc.get_memory(sizeof(EiParameter));
+      void* p = alloc().get_memory(sizeof(EiParameter));
       param = new (p) EiParameter(head, pt_item);
     }
     break;
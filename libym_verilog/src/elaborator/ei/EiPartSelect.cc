@@ -33,7 +33,7 @@ EiFactory::new_PartSelect(const PtExpr* pt_expr,
 			  int index1_val,
 			  int index2_val)
 {
-  void* p = mAlloc.get_memory(sizeof(EiConstPartSelect));
+  void* p = alloc().get_memory(sizeof(EiConstPartSelect));
   ElbExpr* expr = new (p) EiConstPartSelect(pt_expr, parent_expr,
 					    index1, index2,
 					    index1_val, index2_val);
@@ -51,7 +51,7 @@ EiFactory::new_PartSelect(const PtExpr* pt_expr,
 			  int index1,
 			  int index2)
 {
-  void* p = mAlloc.get_memory(sizeof(EiConstPartSelect));
+  void* p = alloc().get_memory(sizeof(EiConstPartSelect));
   ElbExpr* expr = new (p) EiConstPartSelect(pt_expr, parent_expr,
 					    nullptr, nullptr,
 					    index1, index2);
@@ -72,7 +72,7 @@ EiFactory::new_PlusPartSelect(const PtExpr* pt_expr,
 			      const PtExpr* range,
 			      int range_val)
 {
-  void* p = mAlloc.get_memory(sizeof(EiPlusPartSelect));
+  void* p = alloc().get_memory(sizeof(EiPlusPartSelect));
   ElbExpr* expr = new (p) EiPlusPartSelect(pt_expr, parent_expr,
 					   base, range, range_val);
 
@@ -92,7 +92,7 @@ EiFactory::new_MinusPartSelect(const PtExpr* pt_expr,
 			       const PtExpr* range,
 			       int range_val)
 {
-  void* p = mAlloc.get_memory(sizeof(EiMinusPartSelect));
+  void* p = alloc().get_memory(sizeof(EiMinusPartSelect));
   ElbExpr* expr = new (p) EiMinusPartSelect(pt_expr, parent_expr,
 					    base, range, range_val);
 
@@ -30,7 +30,7 @@ ElbExpr*
 EiFactory::new_Primary(const PtExpr* pt_expr,
 		       ElbDecl* obj)
 {
-  void* p = mAlloc.get_memory(sizeof(EiPrimary));
+  void* p = alloc().get_memory(sizeof(EiPrimary));
   return new (p) EiPrimary(pt_expr, obj);
 }
 
@@ -41,7 +41,7 @@ ElbExpr*
 EiFactory::new_Primary(const PtDeclItem* pt_item,
 		       ElbDecl* obj)
 {
-  void* p = mAlloc.get_memory(sizeof(EiDeclPrimary));
+  void* p = alloc().get_memory(sizeof(EiDeclPrimary));
   return new (p) EiDeclPrimary(pt_item, obj);
 }
 
@@ -52,7 +52,7 @@ ElbExpr*
 EiFactory::new_Primary(const PtExpr* pt_expr,
 		       ElbParameter* obj)
 {
-  void* p = mAlloc.get_memory(sizeof(EiParamPrimary));
+  void* p = alloc().get_memory(sizeof(EiParamPrimary));
   return new (p) EiParamPrimary(pt_expr, obj);
 }
 
@@ -66,12 +66,12 @@ EiFactory::new_Primary(const PtExpr* pt_expr,
 		       const vector<ElbExpr*>& index_list)
 {
   ymuint n = index_list.size();
-  void* q = mAlloc.get_memory(sizeof(ElbExpr*) * n);
+  void* q = alloc().get_memory(sizeof(ElbExpr*) * n);
   ElbExpr** index_array = new (q) ElbExpr*[n];
   for (ymuint i = 0; i < n; ++ i) {
     index_array[i] = index_list[i];
   }
-  void* p = mAlloc.get_memory(sizeof(EiArrayElemPrimary));
+  void* p = alloc().get_memory(sizeof(EiArrayElemPrimary));
   return new (p) EiArrayElemPrimary(pt_expr, obj, n, index_array);
 }
 
@@ -84,7 +84,7 @@ EiFactory::new_Primary(const PtExpr* pt_expr,
 		       ElbDeclArray* obj,
 		       ymuint offset)
 {
-  void* p = mAlloc.get_memory(sizeof(EiConstArrayElemPrimary));
+  void* p = alloc().get_memory(sizeof(EiConstArrayElemPrimary));
   return new (p) EiConstArrayElemPrimary(pt_expr, obj, offset);
 }
 
@@ -95,7 +95,7 @@ ElbExpr*
 EiFactory::new_ArgHandle(const PtExpr* pt_expr,
 			 const VlNamedObj* arg)
 {
-  void* p = mAlloc.get_memory(sizeof(EiScopePrimary));
+  void* p = alloc().get_memory(sizeof(EiScopePrimary));
   return new (p) EiScopePrimary(pt_expr, arg);
 }
 
@@ -106,7 +106,7 @@ ElbExpr*
 EiFactory::new_ArgHandle(const PtExpr* pt_expr,
 			 ElbPrimitive* arg)
 {
-  void* p = mAlloc.get_memory(sizeof(EiPrimitivePrimary));
+  void* p = alloc().get_memory(sizeof(EiPrimitivePrimary));
   return new (p) EiPrimitivePrimary(pt_expr, arg);
 }
 
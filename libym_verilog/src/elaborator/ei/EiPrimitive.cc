@@ -36,11 +36,11 @@ EiFactory::new_PrimHead(const VlNamedObj* parent,
 {
   EiPrimHead* head = nullptr;
   if ( has_delay ) {
-    void* p = mAlloc.get_memory(sizeof(EiPrimHeadD));
+    void* p = alloc().get_memory(sizeof(EiPrimHeadD));
     head = new (p) EiPrimHeadD(parent, pt_header);
   }
   else {
-    void* p = mAlloc.get_memory(sizeof(EiPrimHead));
+    void* p = alloc().get_memory(sizeof(EiPrimHead));
     head = new (p) EiPrimHead(parent, pt_header);
   }
   return head;
@@ -59,11 +59,11 @@ EiFactory::new_UdpHead(const VlNamedObj* parent,
 {
   EiPrimHead* head = nullptr;
   if ( has_delay ) {
-    void* p = mAlloc.get_memory(sizeof(EiPrimHeadUD));
+    void* p = alloc().get_memory(sizeof(EiPrimHeadUD));
     head = new (p) EiPrimHeadUD(parent, pt_header, udp);
   }
   else {
-    void* p = mAlloc.get_memory(sizeof(EiPrimHeadU));
+    void* p = alloc().get_memory(sizeof(EiPrimHeadU));
     head = new (p) EiPrimHeadU(parent, pt_header, udp);
   }
   return head;
@@ -79,7 +79,7 @@ EiFactory::new_CellHead(const VlNamedObj* parent,
 			const Cell* cell)
 {
   EiPrimHead* head = nullptr;
-  void* p = mAlloc.get_memory(sizeof(EiPrimHeadC));
+  void* p = alloc().get_memory(sizeof(EiPrimHeadC));
   head = new (p) EiPrimHeadC(parent, pt_header, cell);
   return head;
 }
@@ -92,10 +92,10 @@ EiFactory::new_Primitive(ElbPrimHead* head,
 			 const PtInst* pt_inst)
 {
   ymuint port_num = pt_inst->port_num();
-  void* q = mAlloc.get_memory(sizeof(EiPrimTerm) * port_num);
+  void* q = alloc().get_memory(sizeof(EiPrimTerm) * port_num);
   EiPrimTerm* term_array = new (q) EiPrimTerm[port_num];
 
-  void* p = mAlloc.get_memory(sizeof(EiPrimitive2));
+  void* p = alloc().get_memory(sizeof(EiPrimitive2));
   EiPrimitive* prim = new (p) EiPrimitive2(head, pt_inst, term_array);
 
   return prim;
@@ -119,14 +119,14 @@ EiFactory::new_PrimitiveArray(ElbPrimHead* head,
   EiRangeImpl range;
   range.set(left, right, left_val, right_val);
   ymuint n = range.size();
-  void* q = mAlloc.get_memory(sizeof(EiPrimitive1) * n);
+  void* q = alloc().get_memory(sizeof(EiPrimitive1) * n);
   EiPrimitive1* array = new (q) EiPrimitive1[n];
 
   ymuint nt = n * pt_inst->port_num();
-  void* r = mAlloc.get_memory(sizeof(EiPrimTerm) * nt);
+  void* r = alloc().get_memory(sizeof(EiPrimTerm) * nt);
   EiPrimTerm* term_array = new (r) EiPrimTerm[nt];
 
-  void* p = mAlloc.get_memory(sizeof(EiPrimArray));
+  void* p = alloc().get_memory(sizeof(EiPrimArray));
   EiPrimArray* prim_array = new (p) EiPrimArray(head, pt_inst, range,
 						array, term_array);
 
@@ -27,7 +27,7 @@ ElbProcess*
 EiFactory::new_Process(const VlNamedObj* parent,
 		       const PtItem* pt_item)
 {
-  void* p = mAlloc.get_memory(sizeof(EiProcess));
+  void* p = alloc().get_memory(sizeof(EiProcess));
   EiProcess* process = new (p) EiProcess(parent, pt_item);
 
   return process;
@@ -24,7 +24,7 @@ BEGIN_NAMESPACE_YM_VERILOG
 ElbRange*
 EiFactory::new_RangeArray(ymuint dim_size)
 {
-  void* p = mAlloc.get_memory(sizeof(EiRange) * dim_size);
+  void* p = alloc().get_memory(sizeof(EiRange) * dim_size);
   EiRange* range_array = new (p) EiRange[dim_size];
 
   return range_array;
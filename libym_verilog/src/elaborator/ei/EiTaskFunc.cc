@@ -45,10 +45,10 @@ EiFactory::new_Function(const VlNamedObj* parent,
 
   // IO数を数え配列を初期化する．
   ymuint io_num = pt_item->ioitem_num();
-  void* q = mAlloc.get_memory(sizeof(EiIODecl) * io_num);
+  void* q = alloc().get_memory(sizeof(EiIODecl) * io_num);
   EiIODecl* io_array = new (q) EiIODecl[io_num];
 
-  void* p = mAlloc.get_memory(sizeof(EiFunctionV));
+  void* p = alloc().get_memory(sizeof(EiFunctionV));
   EiFunction* func = new (p) EiFunctionV(parent, pt_item, io_num, io_array,
 					 left, right, left_val, right_val);
 
@@ -64,10 +64,10 @@ EiFactory::new_Function(const VlNamedObj* parent,
 {
   // IO数を数え配列を初期化する．
   ymuint io_num = pt_item->ioitem_num();
-  void* q = mAlloc.get_memory(sizeof(EiIODecl) * io_num);
+  void* q = alloc().get_memory(sizeof(EiIODecl) * io_num);
   EiIODecl* io_array = new (q) EiIODecl[io_num];
 
-  void* p = mAlloc.get_memory(sizeof(EiFunction));
+  void* p = alloc().get_memory(sizeof(EiFunction));
   EiFunction* func = new (p) EiFunction(parent, pt_item, io_num, io_array);
 
   return func;
@@ -82,10 +82,10 @@ EiFactory::new_Task(const VlNamedObj* parent,
 {
   // IO数を数え配列を初期化する．
   ymuint io_num = pt_item->ioitem_num();
-  void* q = mAlloc.get_memory(sizeof(EiIODecl) * io_num);
+  void* q = alloc().get_memory(sizeof(EiIODecl) * io_num);
   EiIODecl* io_array = new (q) EiIODecl[io_num];
 
-  void* p = mAlloc.get_memory(sizeof(EiTask));
+  void* p = alloc().get_memory(sizeof(EiTask));
   EiTask* task = new (p) EiTask(parent, pt_item, io_num, io_array);
   return task;
 }
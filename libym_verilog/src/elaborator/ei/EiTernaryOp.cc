@@ -36,12 +36,12 @@ EiFactory::new_TernaryOp(const PtExpr* pt_expr,
   void* p;
   switch ( op_type ) {
   case kVlConditionOp:
-    p = mAlloc.get_memory(sizeof(EiConditionOp));
+    p = alloc().get_memory(sizeof(EiConditionOp));
     expr = new (p) EiConditionOp(pt_expr, opr0, opr1, opr2);
     break;
 
   case kVlMinTypMaxOp:
-    p = mAlloc.get_memory(sizeof(EiMinTypMaxOp));
+    p = alloc().get_memory(sizeof(EiMinTypMaxOp));
     expr = new (p) EiMinTypMaxOp(pt_expr, opr0, opr1, opr2);
     break;
 
@@ -24,7 +24,7 @@ BEGIN_NAMESPACE_YM_VERILOG
 const VlNamedObj*
 EiFactory::new_Toplevel()
 {
-  void* p = mAlloc.get_memory(sizeof(EiToplevel));
+  void* p = alloc().get_memory(sizeof(EiToplevel));
   EiToplevel* toplevel = new (p) EiToplevel();
 
   return toplevel;
@@ -31,11 +31,11 @@ EiFactory::new_UdpDefn(const PtUdp* pt_udp,
 		       bool is_protected)
 {
   ymuint port_num = pt_udp->port_num();
-  void* q = mAlloc.get_memory(sizeof(EiUdpIO) * port_num);
+  void* q = alloc().get_memory(sizeof(EiUdpIO) * port_num);
   EiUdpIO* iodecl = new (q) EiUdpIO[port_num];
 
   ymuint table_size = pt_udp->table_array().size();
-  void* r = mAlloc.get_memory(sizeof(EiTableEntry) * table_size);
+  void* r = alloc().get_memory(sizeof(EiTableEntry) * table_size);
   EiTableEntry* table = new (r) EiTableEntry[table_size];
 
   ymuint row_size = port_num;
@@ -43,10 +43,10 @@ EiFactory::new_UdpDefn(const PtUdp* pt_udp,
     ++ row_size;
   }
   ymuint vsize = row_size * table_size;
-  void* s = mAlloc.get_memory(sizeof(VlUdpVal) * vsize);
+  void* s = alloc().get_memory(sizeof(VlUdpVal) * vsize);
   VlUdpVal* val_array = new (s) VlUdpVal[vsize];
 
-  void* p = mAlloc.get_memory(sizeof(EiUdpDefn));
+  void* p = alloc().get_memory(sizeof(EiUdpDefn));
   EiUdpDefn* udp = new (p) EiUdpDefn(pt_udp, is_protected,
 				     port_num, iodecl,
 				     table_size, table,
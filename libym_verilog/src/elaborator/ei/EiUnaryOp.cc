@@ -33,18 +33,18 @@ EiFactory::new_UnaryOp(const PtExpr* pt_expr,
   switch ( op_type ) {
   case kVlPosedgeOp:
   case kVlNegedgeOp:
-    p = mAlloc.get_memory(sizeof(EiEventEdgeOp));
+    p = alloc().get_memory(sizeof(EiEventEdgeOp));
     expr = new (p) EiEventEdgeOp(pt_expr, opr1);
     break;
 
   case kVlBitNegOp:
-    p = mAlloc.get_memory(sizeof(EiBitNegOp));
+    p = alloc().get_memory(sizeof(EiBitNegOp));
     expr = new (p) EiBitNegOp(pt_expr, opr1);
     break;
 
   case kVlPlusOp:
   case kVlMinusOp:
-    p = mAlloc.get_memory(sizeof(EiUnaryArithOp));
+    p = alloc().get_memory(sizeof(EiUnaryArithOp));
     expr = new (p) EiUnaryArithOp(pt_expr, opr1);
     break;
 
@@ -54,12 +54,12 @@ EiFactory::new_UnaryOp(const PtExpr* pt_expr,
   case kVlUnaryNorOp:
   case kVlUnaryXorOp:
   case kVlUnaryXNorOp:
-    p = mAlloc.get_memory(sizeof(EiReductionOp));
+    p = alloc().get_memory(sizeof(EiReductionOp));
     expr = new (p) EiReductionOp(pt_expr, opr1);
     break;
 
   case kVlNotOp:
-    p = mAlloc.get_memory(sizeof(EiNotOp));
+    p = alloc().get_memory(sizeof(EiNotOp));
     expr = new (p) EiNotOp(pt_expr, opr1);
     break;
 
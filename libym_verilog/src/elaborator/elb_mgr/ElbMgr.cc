@@ -47,16 +47,14 @@ BEGIN_NAMESPACE_YM_VERILOG
 // @param[in] alloc メモリ確保用のオブジェクト
 ElbMgr::ElbMgr(Alloc& alloc) :
   mAlloc(alloc),
-  mObjDict(alloc),
-  mTagDict(alloc),
-  mModInstDict(alloc),
-  mAttrHash(alloc)
+  mMtCount(0)
 {
 }
 
 // @brief デストラクタ
 ElbMgr::~ElbMgr()
 {
+  clear();
 }
 
 // @brief 内容をクリアする．
@@ -67,10 +65,19 @@ ElbMgr::clear()
   mUdpHash.clear();
   mTopmoduleList.clear();
   mSystfHash.clear();
-  mTagDict.clear();
-  mObjDict.clear();
-  mModInstDict.clear();
-  mAttrHash.clear();
+  for (ymuint i = 0; i < kShardNum; ++ i) {
+    Shard& sh = mShardArray[i];
+    sh.mTagDict.clear();
+    sh.mObjDict.clear();
+    sh.mModInstDict.clear();
+    sh.mAttrHash.clear();
+  }
+  for (vector<SlabAlloc*>::iterator p = mThreadAllocList.begin();
+       p != mThreadAllocList.end(); ++ p) {
+    delete *p;
+  }
+  mThreadAllocList.clear();
+  mThreadPool.trim();
   mTopLevel = nullptr;
 }
 
@@ -150,6 +157,9 @@ ElbMgr::reg_user_systf(const ElbUserSystf* systf)
 void
 ElbMgr::reg_internalscope(ElbScope* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_internalscope( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -158,8 +168,8 @@ ElbMgr::reg_internalscope(ElbScope* obj)
 	 << "] )" << endl
 	 << endl;
   }
-  mObjDict.add(obj);
-  mTagDict.add_internalscope(obj);
+  sh.mObjDict.add(obj);
+  sh.mTagDict.add_internalscope(obj);
 }
 
 // @brief 宣言要素を登録する．
@@ -169,6 +179,9 @@ void
 ElbMgr::reg_decl(int tag,
 		 ElbDecl* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_decl( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -176,9 +189,9 @@ ElbMgr::reg_decl(int tag,
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
   }
-  mObjDict.add(obj);
+  sh.mObjDict.add(obj);
   if ( tag ) {
-    mTagDict.add_decl(tag, obj);
+    sh.mTagDict.add_decl(tag, obj);
   }
 }
 
@@ -189,6 +202,9 @@ void
 ElbMgr::reg_declarray(int tag,
 		      ElbDeclArray* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_declarray( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -196,13 +212,13 @@ ElbMgr::reg_declarray(int tag,
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
   }
-  mObjDict.add(obj);
+  sh.mObjDict.add(obj);
   if ( tag ) {
     if ( tag == vpiVariables ) {
       // ちょっと汚い補正
       tag += 100;
     }
-    mTagDict.add_declarray(tag, obj);
+    sh.mTagDict.add_declarray(tag, obj);
   }
 }
 
@@ -213,6 +229,9 @@ void
 ElbMgr::reg_parameter(int tag,
 		      ElbParameter* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_decl( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -220,9 +239,9 @@ ElbMgr::reg_parameter(int tag,
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
   }
-  mObjDict.add(obj);
+  sh.mObjDict.add(obj);
   if ( tag ) {
-    mTagDict.add_parameter(tag, obj);
+    sh.mTagDict.add_parameter(tag, obj);
   }
 }
 
@@ -231,7 +250,10 @@ ElbMgr::reg_parameter(int tag,
 void
 ElbMgr::reg_defparam(ElbDefParam* obj)
 {
-  mTagDict.add_defparam(obj);
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
+  sh.mTagDict.add_defparam(obj);
 }
 
 // @brief paramassign を登録する．
@@ -239,7 +261,10 @@ ElbMgr::reg_defparam(ElbDefParam* obj)
 void
 ElbMgr::reg_paramassign(ElbParamAssign* obj)
 {
-  mTagDict.add_paramassign(obj);
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
+  sh.mTagDict.add_paramassign(obj);
 }
 
 // @brief モジュール配列を登録する．
@@ -247,6 +272,9 @@ ElbMgr::reg_paramassign(ElbParamAssign* obj)
 void
 ElbMgr::reg_modulearray(ElbModuleArray* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_modulearray( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -254,14 +282,17 @@ ElbMgr::reg_modulearray(ElbModuleArray* obj)
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
   }
-  mObjDict.add(obj);
-  mTagDict.add_modulearray(obj);
+  sh.mObjDict.add(obj);
+  sh.mTagDict.add_modulearray(obj);
 }
 
 // @brief モジュールを登録する．
 void
 ElbMgr::reg_module(ElbModule* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_module( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -269,10 +300,11 @@ ElbMgr::reg_module(ElbModule* obj)
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
   }
-  mObjDict.add(obj);
-  mModInstDict.add(obj);
-  mTagDict.add_module(obj);
+  sh.mObjDict.add(obj);
+  sh.mModInstDict.add(obj);
+  sh.mTagDict.add_module(obj);
   if ( obj->parent() == mTopLevel ) {
+    std::unique_lock<std::mutex> top_lock = mt_lock(mMutex);
     mTopmoduleList.push_back(obj);
   }
 }
@@ -282,6 +314,9 @@ ElbMgr::reg_module(ElbModule* obj)
 void
 ElbMgr::reg_primarray(ElbPrimArray* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( obj->name() != nullptr ) {
     if ( debug & debug_objdict ) {
       dout << "reg_primarray( " << obj->name() << " @ "
@@ -290,9 +325,9 @@ ElbMgr::reg_primarray(ElbPrimArray* obj)
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
     }
-    mObjDict.add(obj);
+    sh.mObjDict.add(obj);
   }
-  mTagDict.add_primarray(obj);
+  sh.mTagDict.add_primarray(obj);
 }
 
 // @brief プリミティブを登録する．
@@ -300,6 +335,9 @@ ElbMgr::reg_primarray(ElbPrimArray* obj)
 void
 ElbMgr::reg_primitive(ElbPrimitive* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( obj->name() != nullptr ) {
     if ( debug & debug_objdict ) {
       dout << "reg_primitive( " << obj->name() << " @ "
@@ -308,9 +346,9 @@ ElbMgr::reg_primitive(ElbPrimitive* obj)
 	   << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	   << "] )" << endl << endl;
     }
-    mObjDict.add(obj);
+    sh.mObjDict.add(obj);
   }
-  mTagDict.add_primitive(obj);
+  sh.mTagDict.add_primitive(obj);
 }
 
 // @brief タスクを登録する．
@@ -318,6 +356,9 @@ ElbMgr::reg_primitive(ElbPrimitive* obj)
 void
 ElbMgr::reg_task(ElbTaskFunc* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_task( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -325,8 +366,8 @@ ElbMgr::reg_task(ElbTaskFunc* obj)
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
   }
-  mObjDict.add(obj);
-  mTagDict.add_task(obj);
+  sh.mObjDict.add(obj);
+  sh.mTagDict.add_task(obj);
 }
 
 // @brief 関数を登録する．
@@ -334,6 +375,9 @@ ElbMgr::reg_task(ElbTaskFunc* obj)
 void
 ElbMgr::reg_function(ElbTaskFunc* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_function( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -341,8 +385,8 @@ ElbMgr::reg_function(ElbTaskFunc* obj)
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
   }
-  mObjDict.add(obj);
-  mTagDict.add_function(obj);
+  sh.mObjDict.add(obj);
+  sh.mTagDict.add_function(obj);
 }
 
 // @brief continuous assignment を登録する．
@@ -350,7 +394,10 @@ ElbMgr::reg_function(ElbTaskFunc* obj)
 void
 ElbMgr::reg_contassign(ElbContAssign* obj)
 {
-  mTagDict.add_contassign(obj);
+  Shard& sh = shard(obj->module());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
+  sh.mTagDict.add_contassign(obj);
 }
 
 // @brief process を登録する．
@@ -358,7 +405,10 @@ ElbMgr::reg_contassign(ElbContAssign* obj)
 void
 ElbMgr::reg_process(ElbProcess* obj)
 {
-  mTagDict.add_process(obj);
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
+  sh.mTagDict.add_process(obj);
 }
 
 // @brief gfroot を登録する．
@@ -366,6 +416,9 @@ ElbMgr::reg_process(ElbProcess* obj)
 void
 ElbMgr::reg_gfroot(ElbGfRoot* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_gfroot( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -373,7 +426,7 @@ ElbMgr::reg_gfroot(ElbGfRoot* obj)
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
   }
-  mObjDict.add(obj);
+  sh.mObjDict.add(obj);
 }
 
 // @brief genvar を登録する．
@@ -381,6 +434,9 @@ ElbMgr::reg_gfroot(ElbGfRoot* obj)
 void
 ElbMgr::reg_genvar(ElbGenvar* obj)
 {
+  Shard& sh = shard(obj->parent());
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+
   if ( debug & debug_objdict ) {
     dout << "reg_genvar( " << obj->name() << " @ "
 	 << obj->parent()->full_name()
@@ -388,7 +444,7 @@ ElbMgr::reg_genvar(ElbGenvar* obj)
 	 << hex << reinterpret_cast<ympuint>(obj->parent()) << dec
 	 << "] )" << endl << endl;
   }
-  mObjDict.add(obj);
+  sh.mObjDict.add(obj);
 }
 
 // @brief 属性リストを登録する．
@@ -400,7 +456,9 @@ ElbMgr::reg_attr(const VlObj* obj,
 		 bool def,
 		 ElbAttrList* attr_list)
 {
-  mAttrHash.add(obj, def, attr_list);
+  Shard& sh = shard(obj);
+  std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+  sh.mAttrHash.add(obj, def, attr_list);
 }
 
 // @brief スコープと名前から名前付き要素を取り出す．
@@ -420,7 +478,12 @@ ElbMgr::find_obj(const VlNamedObj* scope,
 	 << "] )" << endl << endl;
   }
 
-  ElbObjHandle* handle = mObjDict.find(scope, name);
+  ElbObjHandle* handle = nullptr;
+  {
+    const Shard& sh = shard(scope);
+    std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+    handle = sh.mObjDict.find(scope, name);
+  }
 
   if ( handle == nullptr ) {
     if ( debug & debug_find_scope ) {
@@ -518,7 +581,9 @@ ElbMgr::find_scope_up(const VlNamedObj* base_scope,
     }
     else if ( !name_branch->has_index() ) {
       // モジュール定義名として探す．
-      top_scope = mModInstDict.find(cur_scope, top_name);
+      const Shard& sh = shard(cur_scope);
+      std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+      top_scope = sh.mModInstDict.find(cur_scope, top_name);
     }
     if ( top_scope == nullptr) {
       // cur_scope が上限もしくは cur_scope の親がいなければ
@@ -560,10 +625,62 @@ ElbMgr::find_scope_up(const VlNamedObj* base_scope,
 ymuint
 ElbMgr::allocated_size() const
 {
-  return mTagDict.allocated_size()
-    + mObjDict.allocated_size()
-    + mModInstDict.allocated_size()
-    + mAttrHash.allocated_size();
+  ymuint size = 0;
+  for (ymuint i = 0; i < kShardNum; ++ i) {
+    const Shard& sh = mShardArray[i];
+    std::unique_lock<std::mutex> lock = mt_lock(sh.mMutex);
+    size += sh.mTagDict.allocated_size()
+      + sh.mObjDict.allocated_size()
+      + sh.mModInstDict.allocated_size()
+      + sh.mAttrHash.allocated_size();
+  }
+  std::unique_lock<std::mutex> lock = mt_lock(mMutex);
+  for (vector<SlabAlloc*>::const_iterator p = mThreadAllocList.begin();
+       p != mThreadAllocList.end(); ++ p) {
+    size += (*p)->allocated_size();
+  }
+  return size;
+}
+
+// @brief スレッドごとに用いるアロケータを生成する．
+// @note 生成したアロケータは clear() もしくはデストラクタで破壊される．
+Alloc&
+ElbMgr::new_thread_alloc()
+{
+  SlabAlloc* alloc = new SlabAlloc(mThreadPool, 4096);
+  std::lock_guard<std::mutex> lock(mMutex);
+  mThreadAllocList.push_back(alloc);
+  return *alloc;
+}
+
+// @brief 複数のスレッドから reg_XXX()/find_XXX() を呼び出す区間の
+// 開始/終了を指示する．
+// @param[in] flag 開始する時に true，終了する時に false とする．
+void
+ElbMgr::set_multi_thread(bool flag)
+{
+  if ( flag ) {
+    ++ mMtCount;
+  }
+  else {
+    ASSERT_COND( mMtCount.load() > 0 );
+    -- mMtCount;
+  }
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス ElbMgr::Shard
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+ElbMgr::Shard::Shard() :
+  mAlloc(4096),
+  mObjDict(mAlloc),
+  mTagDict(mAlloc),
+  mModInstDict(mAlloc),
+  mAttrHash(mAlloc)
+{
 }
 
 END_NAMESPACE_YM_VERILOG
@@ -26,21 +26,40 @@
 #include "ElbModule.h"
 
 #include "YmUtils/MsgMgr.h"
+#include "YmUtils/ShString.h"
+
+#include "ElbMgr.h"
+#include "ElbFactory.h"
+
+#include <thread>
 
 
 BEGIN_NAMESPACE_YM_VERILOG
 
+// スレッドごとの状態
+thread_local
+const VlModule* Elaborator::mCurOwner = nullptr;
+
+thread_local
+Elaborator::StubGroup* Elaborator::mCurGroup = nullptr;
+
+thread_local
+Alloc* Elaborator::mCurStubAlloc = nullptr;
+
 // @brief コンストラクタ
 // @param[in] elb_mgr Elbオブジェクトを管理するクラス
 // @param[in] elb_factory Elbオブジェクトを生成するファクトリクラス
 // @param[in] cell_library セルライブラリ
+// @param[in] thread_num phase2/phase3 の処理に用いるスレッド数
 Elaborator::Elaborator(ElbMgr& elb_mgr,
 		       ElbFactory& elb_factory,
-		       const CellLibrary* cell_library) :
+		       const CellLibrary* cell_library,
+		       ymuint thread_num) :
   mMgr(elb_mgr),
   mFactory(elb_factory),
   mCellLibrary(cell_library),
-  mAlloc(4096)
+  mAlloc(4096),
+  mThreadNum(thread_num)
 {
   mAllowEmptyIORange = true;
 
@@ -189,7 +208,21 @@ Elaborator::operator()(const PtMgr& pt_mgr)
 	break;
       }
       mPhase1StubList2.move(mPhase1StubList1);
-      mPhase1StubList2.eval();
+      // defparam の適用順が変わるので phase1 は並列化しない．
+      for ( ; ; ) {
+	vector<ElbStub*> stub_list;
+	mPhase1StubList2.move_to(stub_list);
+	if ( stub_list.empty() ) {
+	  break;
+	}
+	for (vector<ElbStub*>::iterator p = stub_list.begin();
+	     p != stub_list.end(); ++ p) {
+	  ElbStub* stub = *p;
+	  mCurOwner = stub->owner();
+	  stub->eval();
+	}
+      }
+      mCurOwner = nullptr;
     }
     // 適用できなかった defparam 文のチェック
     for (list<DefParamStub>::iterator p = mDefParamStubList.begin();
@@ -214,7 +247,7 @@ Elaborator::operator()(const PtMgr& pt_mgr)
 		    "ELAB",
 		    "Phase 2 starts.");
 
-    mPhase2StubList.eval();
+    eval_stubs(mPhase2StubList);
 
     // Phase 3
     // 名前の解決(リンク)を行う．
@@ -224,7 +257,7 @@ Elaborator::operator()(const PtMgr& pt_mgr)
 		    "ELAB",
 		    "Phase 3 starts.");
 
-    mPhase3StubList.eval();
+    eval_stubs(mPhase3StubList);
 
   }
 
@@ -236,6 +269,11 @@ Elaborator::operator()(const PtMgr& pt_mgr)
   mPhase2StubList.clear();
   mPhase3StubList.clear();
   mAlloc.destroy();
+  for (vector<SimpleAlloc*>::iterator p = mStubAllocList.begin();
+       p != mStubAllocList.end(); ++ p) {
+    delete *p;
+  }
+  mStubAllocList.clear();
 
   return nerr;
 }
@@ -256,6 +294,10 @@ Elaborator::add_defparamstub(const VlModule* module,
 void
 Elaborator::add_phase1stub(ElbStub* stub)
 {
+  // phase1 のスタブは phase1 の処理中にしか登録されない．
+  ASSERT_COND( mCurGroup == nullptr );
+
+  stub->set_owner(mCurOwner);
   mPhase1StubList1.push_back(stub);
 }
 
@@ -264,14 +306,194 @@ Elaborator::add_phase1stub(ElbStub* stub)
 void
 Elaborator::add_phase2stub(ElbStub* stub)
 {
-  mPhase2StubList.push_back(stub);
+  stub->set_owner(mCurOwner);
+  if ( mCurGroup ) {
+    mCurGroup->mPhase2StubList.push_back(stub);
+  }
+  else {
+    mPhase2StubList.push_back(stub);
+  }
 }
 
 // phase3 で行う処理を登録する．
 void
 Elaborator::add_phase3stub(ElbStub* stub)
 {
-  mPhase3StubList.push_back(stub);
+  stub->set_owner(mCurOwner);
+  if ( mCurGroup ) {
+    mCurGroup->mPhase3StubList.push_back(stub);
+  }
+  else {
+    mPhase3StubList.push_back(stub);
+  }
+}
+
+// @brief 以降に登録するスタブの所有者を設定する．
+// @param[in] owner 所有者のモジュール
+// @return 直前の所有者を返す．
+const VlModule*
+Elaborator::set_stub_owner(const VlModule* owner)
+{
+  const VlModule* old_owner = mCurOwner;
+  mCurOwner = owner;
+  return old_owner;
+}
+
+// @brief ElbStub 用のアロケータを返す．
+Alloc&
+Elaborator::stub_alloc()
+{
+  if ( mCurStubAlloc ) {
+    return *mCurStubAlloc;
+  }
+  return mAlloc;
+}
+
+// @brief スタブのリストを評価する．
+// @param[in] stub_list 対象のリスト
+// @note 評価中に stub_list に追加されたスタブも評価する．
+// @note 結果として stub_list は空になる．
+void
+Elaborator::eval_stubs(ElbStubList& stub_list)
+{
+  for ( ; ; ) {
+    vector<ElbStub*> tmp_list;
+    stub_list.move_to(tmp_list);
+    if ( tmp_list.empty() ) {
+      break;
+    }
+
+    if ( mThreadNum <= 1 ) {
+      // 逐次処理
+      for (vector<ElbStub*>::iterator p = tmp_list.begin();
+	   p != tmp_list.end(); ++ p) {
+	ElbStub* stub = *p;
+	mCurOwner = stub->owner();
+	stub->eval();
+      }
+      mCurOwner = nullptr;
+      continue;
+    }
+
+    // 所有者ごとにグループ分けする．
+    // グループは所有者が最初に現れた順に並べる．
+    vector<StubGroup> group_list;
+    HashMap<ympuint, ymuint> group_map;
+    for (vector<ElbStub*>::iterator p = tmp_list.begin();
+	 p != tmp_list.end(); ++ p) {
+      ElbStub* stub = *p;
+      ympuint key = reinterpret_cast<ympuint>(stub->owner());
+      ymuint id;
+      if ( !group_map.find(key, id) ) {
+	id = group_list.size();
+	group_map.add(key, id);
+	group_list.push_back(StubGroup());
+	group_list.back().mOwner = stub->owner();
+      }
+      group_list[id].mStubList.push_back(stub);
+    }
+
+    eval_groups(group_list);
+
+    // 評価中に登録されたスタブとメッセージを逐次処理と同じ順番で
+    // 書き戻す．
+    for (vector<StubGroup>::iterator p = group_list.begin();
+	 p != group_list.end(); ++ p) {
+      StubGroup& group = *p;
+      MsgMgr::put_deferred(group.mMsgList);
+
+      vector<ElbStub*> stub2_list;
+      group.mPhase2StubList.move_to(stub2_list);
+      for (vector<ElbStub*>::iterator q = stub2_list.begin();
+	   q != stub2_list.end(); ++ q) {
+	mPhase2StubList.push_back(*q);
+      }
+
+      vector<ElbStub*> stub3_list;
+      group.mPhase3StubList.move_to(stub3_list);
+      for (vector<ElbStub*>::iterator q = stub3_list.begin();
+	   q != stub3_list.end(); ++ q) {
+	mPhase3StubList.push_back(*q);
+      }
+    }
+  }
+}
+
+// @brief スタブのグループを並列に評価する．
+// @param[in] group_list グループのリスト
+void
+Elaborator::eval_groups(vector<StubGroup>& group_list)
+{
+  ymuint n = mThreadNum;
+  if ( n > group_list.size() ) {
+    n = group_list.size();
+  }
+
+  std::atomic<ymuint> next(0);
+  vector<std::thread> thread_list;
+  thread_list.reserve(n);
+  ShString::set_multi_thread(true);
+  mMgr.set_multi_thread(true);
+  for (ymuint i = 0; i < n; ++ i) {
+    thread_list.push_back(std::thread(&Elaborator::eval_worker, this,
+				      &group_list, &next));
+  }
+  for (vector<std::thread>::iterator p = thread_list.begin();
+       p != thread_list.end(); ++ p) {
+    p->join();
+  }
+  mMgr.set_multi_thread(false);
+  ShString::set_multi_thread(false);
+}
+
+// @brief 個々のスレッドで実行される関数
+// @param[in] group_list グループのリスト
+// @param[in] next 次に処理するグループ番号
+void
+Elaborator::eval_worker(vector<StubGroup>* group_list,
+			std::atomic<ymuint>* next)
+{
+  // アロケータはスレッドごとに用意する．
+  SimpleAlloc* stub_alloc = new SimpleAlloc(4096);
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStubAllocList.push_back(stub_alloc);
+  }
+  mCurStubAlloc = stub_alloc;
+  mFactory.set_thread_alloc(&mMgr.new_thread_alloc());
+
+  for ( ; ; ) {
+    ymuint id = (*next) ++;
+    if ( id >= group_list->size() ) {
+      break;
+    }
+    StubGroup& group = (*group_list)[id];
+    mCurGroup = &group;
+    MsgMgr::set_defer(&group.mMsgList);
+    for (vector<ElbStub*>::iterator p = group.mStubList.begin();
+	 p != group.mStubList.end(); ++ p) {
+      ElbStub* stub = *p;
+      mCurOwner = stub->owner();
+      stub->eval();
+    }
+    MsgMgr::set_defer(nullptr);
+  }
+
+  mCurOwner = nullptr;
+  mCurGroup = nullptr;
+  mCurStubAlloc = nullptr;
+  mFactory.set_thread_alloc(nullptr);
+}
+
+// @brief 並列処理中なら mMutex をロックする．
+std::unique_lock<std::mutex>
+Elaborator::mt_lock() const
+{
+  // mCurGroup はワーカースレッドの中でだけ設定されている．
+  if ( mCurGroup ) {
+    return std::unique_lock<std::mutex>(mMutex);
+  }
+  return std::unique_lock<std::mutex>();
 }
 
 // @brief 名前からモジュール定義を取り出す．
@@ -297,9 +519,20 @@ const ElbTaskFunc*
 Elaborator::find_constant_function(const VlNamedObj* parent,
 				   const char* name) const
 {
+  std::unique_lock<std::mutex> lock = mt_lock();
   return mCfDict.find(parent, name);
 }
 
+// @brief constant function の検索と生成を排他制御するロックを得る．
+std::unique_lock<std::recursive_mutex>
+Elaborator::cf_lock()
+{
+  if ( mCurGroup ) {
+    return std::unique_lock<std::recursive_mutex>(mCfMutex);
+  }
+  return std::unique_lock<std::recursive_mutex>();
+}
+
 // @brief constant function を登録する．
 // @param[in] parent 親のスコープ
 // @param[in] name 名前
@@ -309,9 +542,30 @@ Elaborator::reg_constant_function(const VlNamedObj* parent,
 				  const char* name,
 				  ElbTaskFunc* func)
 {
+  std::unique_lock<std::mutex> lock = mt_lock();
   mCfDict.add(parent, name, func);
 }
 
+// @brief パース木の属性定義から属性リストを取り出す．
+// @param[in] pt_attr パース木の属性定義
+ElbAttrList*
+Elaborator::find_attr_list(const PtAttrInst* pt_attr) const
+{
+  std::unique_lock<std::mutex> lock = mt_lock();
+  return mAttrDict.find(pt_attr);
+}
+
+// @brief 属性リストを登録する．
+// @param[in] pt_attr パース木の属性定義
+// @param[in] attr_list 属性リスト
+void
+Elaborator::reg_attr_list(const PtAttrInst* pt_attr,
+			  ElbAttrList* attr_list)
+{
+  std::unique_lock<std::mutex> lock = mt_lock();
+  mAttrDict.add(pt_attr, attr_list);
+}
+
 // @brief セルの探索
 // @param[in] name セル名
 // @return name という名のセルを返す．
@@ -133,6 +133,12 @@ protected:
   find_constant_function(const VlNamedObj* parent,
 			 const char* name) const;
 
+  /// @brief constant function の検索と生成を排他制御するロックを得る．
+  /// @note find_constant_function() で見つからなかった関数を
+  /// instantiate_constant_function() で生成するまでロックしておく．
+  std::unique_lock<std::recursive_mutex>
+  cf_lock();
+
   /// @brief パース木の属性定義から属性リストを取り出す．
   /// @param[in] pt_attr パース木の属性定義
   ElbAttrList*
@@ -308,6 +314,12 @@ protected:
   void
   add_phase3stub(ElbStub* stub);
 
+  /// @brief 以降に登録するスタブの所有者を設定する．
+  /// @param[in] owner 所有者のモジュール
+  /// @return 直前の所有者を返す．
+  const VlModule*
+  set_stub_owner(const VlModule* owner);
+
   /// @brief 1引数版の ElbStub を作る．
   template<typename T,
 	   typename A>
@@ -943,6 +955,14 @@ ElbProxy::find_constant_function(const VlNamedObj* parent,
   return mElaborator.find_constant_function(parent, name);
 }
 
+// @brief constant function の検索と生成を排他制御するロックを得る．
+inline
+std::unique_lock<std::recursive_mutex>
+ElbProxy::cf_lock()
+{
+  return mElaborator.cf_lock();
+}
+
 // @brief constant function を登録する．
 // @param[in] parent 親のスコープ
 // @param[in] name 名前
@@ -962,7 +982,7 @@ inline
 ElbAttrList*
 ElbProxy::find_attr_list(const PtAttrInst* pt_attr) const
 {
-  return mElaborator.mAttrDict.find(pt_attr);
+  return mElaborator.find_attr_list(pt_attr);
 }
 
 // @brief 属性リストを登録する．
@@ -973,7 +993,7 @@ void
 ElbProxy::reg_attr_list(const PtAttrInst* pt_attr,
 			ElbAttrList* attr_list)
 {
-  return mElaborator.mAttrDict.add(pt_attr, attr_list);
+  mElaborator.reg_attr_list(pt_attr, attr_list);
 }
 
 // @brief 属性リストを登録する．
@@ -1027,6 +1047,16 @@ ElbProxy::add_phase3stub(ElbStub* stub)
   mElaborator.add_phase3stub(stub);
 }
 
+// @brief 以降に登録するスタブの所有者を設定する．
+// @param[in] owner 所有者のモジュール
+// @return 直前の所有者を返す．
+inline
+const VlModule*
+ElbProxy::set_stub_owner(const VlModule* owner)
+{
+  return mElaborator.set_stub_owner(owner);
+}
+
 // @brief ファクトリオブジェクトを得る．
 inline
 ElbFactory&
@@ -1049,7 +1079,7 @@ ElbProxy::make_stub(T* obj,
 		    void (T::*memfunc)(A),
 		    A a)
 {
-  void* p = mElaborator.mAlloc.get_memory(sizeof(ElbStubT1<T, A>));
+  void* p = mElaborator.stub_alloc().get_memory(sizeof(ElbStubT1<T, A>));
   return new (p) ElbStubT1<T, A>(obj, memfunc, a);
 }
 
@@ -1064,7 +1094,7 @@ ElbProxy::make_stub(T* obj,
 		    A a,
 		    B b)
 {
-  void* p = mElaborator.mAlloc.get_memory(sizeof(ElbStubT2<T, A, B>));
+  void* p = mElaborator.stub_alloc().get_memory(sizeof(ElbStubT2<T, A, B>));
   return new (p) ElbStubT2<T, A, B>(obj, memfunc, a, b);
 }
 
@@ -1081,7 +1111,7 @@ ElbProxy::make_stub(T* obj,
 		    B b,
 		    C c)
 {
-  void* p = mElaborator.mAlloc.get_memory(sizeof(ElbStubT3<T, A, B, C>));
+  void* p = mElaborator.stub_alloc().get_memory(sizeof(ElbStubT3<T, A, B, C>));
   return new (p) ElbStubT3<T, A, B, C>(obj, memfunc, a, b, c);
 }
 
@@ -1100,7 +1130,7 @@ ElbProxy::make_stub(T* obj,
 		    C c,
 		    D d)
 {
-  void* p = mElaborator.mAlloc.get_memory(sizeof(ElbStubT4<T, A, B, C, D>));
+  void* p = mElaborator.stub_alloc().get_memory(sizeof(ElbStubT4<T, A, B, C, D>));
   return new (p) ElbStubT4<T, A, B, C, D>(obj, memfunc, a, b, c, d);
 }
 
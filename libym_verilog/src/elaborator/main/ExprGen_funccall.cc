@@ -65,6 +65,25 @@ put_value_type(ostream& s,
   }
 }
 
+// 生成中の constant function のリスト
+// 同じモジュール定義の異なるインスタンスが別のスレッドで処理される
+// ことがあるのでパース木のフラグではなくスレッドごとに持つ．
+thread_local
+vector<const PtItem*> cf_in_use_list;
+
+// 生成中の constant function の時 true を返す．
+bool
+cf_in_use(const PtItem* pt_func)
+{
+  for (vector<const PtItem*>::const_iterator p = cf_in_use_list.begin();
+       p != cf_in_use_list.end(); ++ p) {
+    if ( *p == pt_func ) {
+      return true;
+    }
+  }
+  return false;
+}
+
 END_NONAMESPACE
 
 // @brief PtFuncCall から ElbExpr を生成する．
@@ -99,17 +118,20 @@ ExprGen::instantiate_funccall(const VlNamedObj* parent,
       return nullptr;
     }
 
-    if ( pt_func->is_in_use() ) {
+    if ( cf_in_use(pt_func) ) {
       error_uses_itself(pt_expr);
       return nullptr;
     }
 
+    // 検索と生成の間に他のスレッドが同じ関数を生成しないように
+    // ロックしておく．
+    std::unique_lock<std::recursive_mutex> lock = cf_lock();
     child_func = find_constant_function(module, name);
     if ( child_func == nullptr ) {
-      pt_func->set_in_use();
+      cf_in_use_list.push_back(pt_func);
       // なかったので作る．
       child_func = instantiate_constant_function(parent, pt_func);
-      pt_func->clear_in_use();
+      cf_in_use_list.pop_back();
     }
     if ( !child_func ) {
       error_not_a_constant_function(pt_expr);
@@ -260,19 +282,25 @@ ExprGen::evaluate_funccall(const VlNamedObj* parent,
     return VlValue();
   }
 
-  if ( pt_func->is_in_use() ) {
+  if ( cf_in_use(pt_func) ) {
     if ( put_error ) {
       error_uses_itself(pt_expr);
     }
     return VlValue();
   }
 
-  const ElbTaskFunc* child_func = find_constant_function(module, name);
-  if ( child_func == nullptr ) {
-    pt_func->set_in_use();
-    // なかったので作る．
-    child_func = instantiate_constant_function(parent, pt_func);
-    pt_func->clear_in_use();
+  const ElbTaskFunc* child_func = nullptr;
+  {
+    // 検索と生成の間に他のスレッドが同じ関数を生成しないように
+    // ロックしておく．
+    std::unique_lock<std::recursive_mutex> lock = cf_lock();
+    child_func = find_constant_function(module, name);
+    if ( child_func == nullptr ) {
+      cf_in_use_list.push_back(pt_func);
+      // なかったので作る．
+      child_func = instantiate_constant_function(parent, pt_func);
+      cf_in_use_list.pop_back();
+    }
   }
   if ( !child_func ) {
     if ( put_error ) {
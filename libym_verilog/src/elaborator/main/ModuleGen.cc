@@ -103,6 +103,9 @@ ModuleGen::phase1_module_item(ElbModule* module,
 			      const PtModule* pt_module,
 			      const ElbParamCon* param_con)
 {
+  // ここで登録されるスタブはこのモジュールに属する．
+  const VlModule* old_owner = set_stub_owner(module);
+
   // ループチェック用のフラグを立てる．
   pt_module->set_in_use();
 
@@ -208,6 +211,8 @@ ModuleGen::phase1_module_item(ElbModule* module,
 
   // ループチェック用のフラグを下ろす．
   pt_module->reset_in_use();
+
+  set_stub_owner(old_owner);
 }
 
 // @brief module の中身のインスタンス化を行う．
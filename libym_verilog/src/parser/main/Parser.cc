@@ -47,6 +47,10 @@ Parser::Parser(PtMgr& ptmgr,
   mAlloc(alloc),
   mFactory(ptifactory),
   mLex(new Lex),
+  mLibMode(false),
+  mLibId(0),
+  mLoadSet(nullptr),
+  mTokenPos(0),
   mTmpAlloc(4096),
   mCellAlloc(sizeof(PtrList<void>::Cell), 1024),
   mPortList(mCellAlloc),
@@ -118,6 +122,35 @@ Parser::read_file(const string& filename,
   return (stat == 0);
 }
 
+// @brief ライブラリファイルを読み込む．
+// @param[in] filename 読み込むファイル名
+// @param[in] searchpath サーチパス
+// @param[in] watcher_list 行番号ウオッチャーのリスト
+// @param[in] lib_id ライブラリ番号
+// @param[in] load_set 本体を読み込むモジュール(UDP)名の集合
+// @retval true 正常に終了した．
+// @retval false エラーが起こった．
+bool
+Parser::read_library(const string& filename,
+		     const SearchPathList& searchpath,
+		     const list<VlLineWatcher*>& watcher_list,
+		     ymuint lib_id,
+		     const HashSet<string>& load_set)
+{
+  mLibMode = true;
+  mLibId = lib_id;
+  mLoadSet = &load_set;
+
+  bool stat = read_file(filename, searchpath, watcher_list);
+
+  mLibMode = false;
+  mLoadSet = nullptr;
+  mTokenBuf.clear();
+  mTokenPos = 0;
+
+  return stat;
+}
+
 // @brief yylex とのインターフェイス
 // @param[out] lvalp 値を格納する変数
 // @param[out] llocp 位置情報を格納する変数
@@ -126,8 +159,37 @@ int
 Parser::yylex(YYSTYPE& lval,
 	      FileRegion& lloc)
 {
-  int id = lex().get_token();
+  if ( mLibMode ) {
+    if ( mTokenPos == mTokenBuf.size() ) {
+      read_lib_tokens();
+    }
+    const TokenInfo& token = mTokenBuf[mTokenPos];
+    ++ mTokenPos;
+    switch ( token.mId ) {
+    case IDENTIFIER:
+    case SYS_IDENTIFIER:
+    case STRING:
+    case UNUMBER:
+    case UNUM_BIG:
+      lval.strtype = mFactory.new_string(token.mStr.c_str());
+      break;
+
+    case UNUM_INT:
+      lval.uinttype = token.mUint;
+      break;
+
+    case RNUMBER:
+      lval.dbltype = strtod(token.mStr.c_str(), static_cast<char**>(nullptr));
+      break;
+
+    default:
+      break;
+    }
+    lloc = token.mLoc;
+    return token.mId;
+  }
 
+  int id = lex().get_token();
   switch ( id ) {
   case IDENTIFIER:
   case SYS_IDENTIFIER:
@@ -152,6 +214,139 @@ Parser::yylex(YYSTYPE& lval,
   return id;
 }
 
+// @brief ライブラリモードでトークンを先読みする．
+void
+Parser::read_lib_tokens()
+{
+  mTokenPos = 0;
+
+  // ライブラリファイル中の参照されていないモジュールと UDP は
+  // 構文解析せずに読み飛ばす．
+  // 前置された attribute instance はモジュール名がわかるまで
+  // バッファに溜めておき，読み飛ばす時には一緒に捨てる．
+  int id = lex().get_token();
+  for ( ; ; ) {
+    mTokenBuf.clear();
+    push_token(id);
+    FileRegion head_loc = lex().cur_token_loc();
+    while ( id == PRSTAR ) {
+      do {
+	id = read_token();
+      } while ( id != STARPR && id != EOF );
+      if ( id == EOF ) {
+	return;
+      }
+      id = read_token();
+    }
+    if ( id != MODULE && id != MACROMODULE && id != PRIMITIVE ) {
+      return;
+    }
+
+    int id1 = read_token();
+    if ( id1 != IDENTIFIER || mLoadSet->check(lex().cur_string()) ) {
+      // 普通に読み込む．
+      return;
+    }
+    id = skip_lib_description(id, head_loc);
+  }
+}
+
+// @brief 字句解析器の現在のトークンを mTokenBuf に積む．
+// @param[in] id トークン番号
+void
+Parser::push_token(int id)
+{
+  mTokenBuf.push_back(TokenInfo());
+  TokenInfo& token = mTokenBuf.back();
+  token.mId = id;
+  token.mLoc = lex().cur_token_loc();
+  token.mUint = 0;
+  switch ( id ) {
+  case IDENTIFIER:
+  case SYS_IDENTIFIER:
+  case STRING:
+  case UNUMBER:
+  case UNUM_BIG:
+  case RNUMBER:
+    token.mStr = lex().cur_string();
+    break;
+
+  case UNUM_INT:
+    token.mUint = lex().cur_uint();
+    break;
+
+  default:
+    break;
+  }
+}
+
+// @brief トークンを1つ読んで mTokenBuf に積む．
+// @return 読み込んだトークン番号を返す．
+int
+Parser::read_token()
+{
+  int id = lex().get_token();
+  push_token(id);
+  return id;
+}
+
+// @brief ライブラリのモジュール(UDP)の本体を読み飛ばす．
+// @param[in] id 先頭のキーワードのトークン
+// @param[in] head_loc 先頭のキーワードの位置
+// @return 読み飛ばした次のトークンを返す．
+//
+// 本体中で
+//  - 識別子の直後に識別子か '#' が続くもの (モジュールインスタンス)
+//  - 識別子の直後に '(' が続くもの (名前のない UDP インスタンスかもしれない)
+// を参照している名前として記録しておく．
+// 後者は関数呼び出しやポート接続も含むので UDP 名のみが対象となる．
+int
+Parser::skip_lib_description(int id,
+			     const FileRegion& head_loc)
+{
+  string name = lex().cur_string();
+  bool is_udp = ( id == PRIMITIVE );
+  vector<string> ref_list;
+  vector<string> call_ref_list;
+
+  int end_id = is_udp ? ENDPRIMITIVE : ENDMODULE;
+  int prev_id = 0;
+  string prev_name;
+  int id1 = 0;
+  for ( ; ; ) {
+    id1 = lex().get_token();
+    if ( id1 == end_id || id1 == EOF ) {
+      break;
+    }
+    if ( prev_id == IDENTIFIER ) {
+      if ( id1 == IDENTIFIER || id1 == '#' ) {
+	ref_list.push_back(prev_name);
+      }
+      else if ( id1 == '(' ) {
+	call_ref_list.push_back(prev_name);
+      }
+    }
+    prev_id = id1;
+    if ( id1 == IDENTIFIER ) {
+      prev_name = lex().cur_string();
+    }
+  }
+
+  mPtMgr.reg_lib_module(name.c_str(), mLibId, is_udp, ref_list, call_ref_list);
+
+  if ( id1 == EOF ) {
+    // 閉じていない記述のエラーは本体を読み込む時に報告される．
+    return EOF;
+  }
+
+  if ( debug ) {
+    dout << "skipped " << FileRegion(head_loc, lex().cur_token_loc())
+	 << endl;
+  }
+
+  return lex().get_token();
+}
+
 // @brief 使用されているモジュール名を登録する．
 // @param[in] name 登録する名前
 void
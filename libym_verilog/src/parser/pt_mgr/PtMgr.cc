@@ -8,6 +8,8 @@
 
 
 #include "PtMgr.h"
+#include "YmVerilog/pt/PtModule.h"
+#include "YmVerilog/pt/PtUdp.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -34,6 +36,9 @@ PtMgr::clear()
   mUdpList.clear();
   mModuleList.clear();
   mDefNames.clear();
+  mDefinedNames.clear();
+  mLibModuleList.clear();
+  mLibModuleDict.clear();
 }
 
 // @brief 登録されているモジュールのリストを返す．
@@ -61,12 +66,49 @@ PtMgr::check_def_name(const char* name) const
   return mDefNames.check(name);
 }
 
+// @brief モジュールか UDP として定義されている名前かどうか調べる．
+// @param[in] name 調べる名前
+// @return 定義されていたら true を返す．
+bool
+PtMgr::check_defined_name(const char* name) const
+{
+  return mDefinedNames.check(name);
+}
+
+// @brief 本体を読み込んでいないライブラリモジュールの数を返す．
+ymuint
+PtMgr::lib_module_num() const
+{
+  return mLibModuleList.size();
+}
+
+// @brief 本体を読み込んでいないライブラリモジュールを返す．
+// @param[in] pos 位置番号 ( 0 <= pos < lib_module_num() )
+const PtLibModule&
+PtMgr::lib_module(ymuint pos) const
+{
+  ASSERT_COND( pos < lib_module_num() );
+  return mLibModuleList[pos];
+}
+
+// @brief 名前からライブラリモジュールの位置番号を得る．
+// @param[in] name モジュール(UDP)名
+// @param[out] pos 位置番号
+// @return 見つからなければ false を返す．
+bool
+PtMgr::find_lib_module(const char* name,
+		       ymuint& pos) const
+{
+  return mLibModuleDict.find(name, pos);
+}
+
 // UDP の登録
 // @param udp 登録する UDP
 void
 PtMgr::reg_udp(const PtUdp* udp)
 {
   mUdpList.push_back(udp);
+  mDefinedNames.add(udp->name());
 }
 
 // モジュールの登録
@@ -75,6 +117,7 @@ void
 PtMgr::reg_module(const PtModule* module)
 {
   mModuleList.push_back(module);
+  mDefinedNames.add(module->name());
 }
 
 // @brief インスタンス定義名を追加する．
@@ -84,4 +127,33 @@ PtMgr::reg_defname(const char* name)
   mDefNames.add(name);
 }
 
+// @brief 本体を読み込んでいないライブラリモジュールを追加する．
+// @param[in] name モジュール(UDP)名
+// @param[in] lib_id ライブラリ番号
+// @param[in] is_udp UDP の時 true
+// @param[in] ref_list 本体中でインスタンス化されている名前のリスト
+// @param[in] call_ref_list 本体中で '(' の直前に現れた名前のリスト
+// @note すでに同名のものが登録されていたら何もしない．
+void
+PtMgr::reg_lib_module(const char* name,
+		      ymuint lib_id,
+		      bool is_udp,
+		      const vector<string>& ref_list,
+		      const vector<string>& call_ref_list)
+{
+  ymuint dummy;
+  if ( mLibModuleDict.find(name, dummy) ) {
+    return;
+  }
+
+  mLibModuleDict.add(name, mLibModuleList.size());
+  mLibModuleList.push_back(PtLibModule());
+  PtLibModule& lib_module = mLibModuleList.back();
+  lib_module.mName = name;
+  lib_module.mLibId = lib_id;
+  lib_module.mUdp = is_udp;
+  lib_module.mRefList = ref_list;
+  lib_module.mCallRefList = call_ref_list;
+}
+
 END_NAMESPACE_YM_VERILOG
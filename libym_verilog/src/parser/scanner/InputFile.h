@@ -44,6 +44,7 @@ private:
   InputFile(RawLex& lex);
 
   /// @brief デストラクタ
+  virtual
   ~InputFile();
 
 
@@ -8,10 +8,13 @@
 
 
 #include "InputMgr.h"
+#include "TokenInfo.h"
 
 #include "YmUtils/FileIDO.h"
 #include "YmUtils/FileInfo.h"
 
+#include "parser_common.h"
+
 
 // ファイル末尾に改行がなくても warning としない時に 1
 #define ALLOW_EOF_WITHOUT_NL 1
@@ -19,6 +22,96 @@
 
 BEGIN_NAMESPACE_YM_VERILOG
 
+BEGIN_NONAMESPACE
+
+// 空白とコメント以外の次のトークンを返す．
+const TokenInfo*
+next_token(const TokenInfo* token)
+{
+  for ( ; token; token = token->next()) {
+    switch ( token->id() ) {
+    case SPACE:
+    case NL:
+    case COMMENT1:
+    case COMMENT2:
+      break;
+
+    default:
+      return token;
+    }
+  }
+  return nullptr;
+}
+
+// トークンが name という compiler directive の時 true を返す．
+inline
+bool
+is_directive(const TokenInfo* token,
+	     const char* name)
+{
+  return token->id() == CD_SYMBOL && strcmp(token->str() + 1, name) == 0;
+}
+
+// ファイル全体が `ifndef NAME ... `endif で囲まれていたら NAME を返す．
+// そうでなければ空文字列を返す．
+string
+find_guard(const TokenList& token_list)
+{
+  const TokenInfo* token = next_token(token_list.top());
+  if ( token == nullptr || !is_directive(token, "ifndef") ) {
+    return string();
+  }
+  const TokenInfo* name_token = next_token(token->next());
+  if ( name_token == nullptr || name_token->id() != IDENTIFIER ) {
+    return string();
+  }
+
+  // 先頭の `ifndef に対応する `endif を探す．
+  ymuint level = 1;
+  for (token = next_token(name_token->next());
+       token && token->id() != EOF; token = next_token(token->next())) {
+    if ( is_directive(token, "ifdef") || is_directive(token, "ifndef") ) {
+      ++ level;
+    }
+    else if ( is_directive(token, "endif") ) {
+      -- level;
+      if ( level == 0 ) {
+	break;
+      }
+    }
+    else if ( level == 1 &&
+	      (is_directive(token, "else") || is_directive(token, "elsif")) ) {
+      // 先頭の `ifndef に else 節がある．
+      return string();
+    }
+  }
+  if ( token == nullptr || token->id() == EOF ) {
+    return string();
+  }
+
+  // `endif の後ろは EOF でなければならない．
+  token = next_token(token->next());
+  if ( token == nullptr || token->id() != EOF ) {
+    return string();
+  }
+
+  return name_token->str();
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// InputMgr::FileCache
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+InputMgr::FileCache::FileCache() :
+  mComplete(false)
+{
+}
+
+
 //////////////////////////////////////////////////////////////////////
 // InputMgr のパブリックなメンバ関数
 //////////////////////////////////////////////////////////////////////
@@ -26,8 +119,7 @@ BEGIN_NAMESPACE_YM_VERILOG
 // @brief コンストラクタ
 // @param[in] lex 親の Lex
 InputMgr::InputMgr(RawLex& lex) :
-  mLex(lex),
-  mCurFile(nullptr)
+  mLex(lex)
 {
 }
 
@@ -43,13 +135,17 @@ InputMgr::~InputMgr()
 void
 InputMgr::clear()
 {
-  delete_file(mCurFile);
-  mCurFile = nullptr;
-  for (vector<InputFile*>::iterator p = mFileStack.begin();
-       p != mFileStack.end(); ++ p) {
-    delete_file(*p);
+  for (vector<InputSource>::iterator p = mSourceStack.begin();
+       p != mSourceStack.end(); ++ p) {
+    delete_source(*p);
+  }
+  mSourceStack.clear();
+
+  for (HashMapIterator<string, FileCache*> p = mCacheDict.begin();
+       p != mCacheDict.end(); ++ p) {
+    delete p.value();
   }
-  mFileStack.clear();
+  mCacheDict.clear();
 }
 
 
@@ -92,15 +188,46 @@ InputMgr::open_file(const string& filename,
   // 本当のパス名
   string realname = pathname.str();
 
+  InputSource src;
+  src.mFile = nullptr;
+  src.mCache = nullptr;
+  src.mNext = nullptr;
+  src.mLine = 1;
+
+  // キャッシュはインクルードファイルのみを対象とする．
+  // 生のトークンはコンテキストに依存するので通常のコンテキスト
+  // で読み始めた場合に限る．
+  if ( parent_file.is_valid() && mLex.context() == RawLex::kNormal ) {
+    FileCache* cache = nullptr;
+    if ( mCacheDict.find(realname, cache) ) {
+      if ( cache->mComplete ) {
+	if ( cache->mGuardName != string() &&
+	     mLex.is_macro_defined(cache->mGuardName.c_str()) ) {
+	  // 読み込んでも何も残らない．
+	  return true;
+	}
+	src.mCache = cache;
+	src.mNext = cache->mTokenList.top();
+	src.mFileInfo = FileInfo(realname, parent_file);
+	mSourceStack.push_back(src);
+	return true;
+      }
+      // 記録途中のキャッシュは使わない．
+    }
+    else {
+      cache = new FileCache;
+      mCacheDict.add(realname, cache);
+      src.mCache = cache;
+    }
+  }
+
   InputFile* new_file = new InputFile(mLex);
   if ( !new_file->open(realname, parent_file) ) {
+    delete new_file;
     return false;
   }
-
-  if ( mCurFile ) {
-    mFileStack.push_back(mCurFile);
-  }
-  mCurFile = new_file;
+  src.mFile = new_file;
+  mSourceStack.push_back(src);
 
   return true;
 }
@@ -117,12 +244,13 @@ InputMgr::set_file_loc(const char* new_filename,
 		       ymuint line,
 		       ymuint level)
 {
-  if ( mCurFile == nullptr ) {
+  if ( mSourceStack.empty() ) {
     // ないと思うけど念のため
     return;
   }
 
-  FileInfo cur_fi = mCurFile->file_info();
+  InputSource& src = mSourceStack.back();
+  FileInfo cur_fi = file_info(src);
   switch ( level ) {
   case 0: // レベルの変化無し
     if ( cur_fi.filename() != new_filename ) {
@@ -134,7 +262,9 @@ InputMgr::set_file_loc(const char* new_filename,
 
   case 1: // 新しいインクルードファイル．
     {
-      FileLoc parent_loc(cur_fi, cur_file()->cur_loc().end_line(), 1);
+      ymuint end_line = src.mFile ? src.mFile->cur_loc().end_line() :
+	src.mLastLoc.end_line();
+      FileLoc parent_loc(cur_fi, end_line, 1);
       cur_fi = FileInfo(new_filename, parent_loc);
     }
     break;
@@ -148,21 +278,45 @@ InputMgr::set_file_loc(const char* new_filename,
     }
     break;
   }
-  mCurFile->set_file_info(cur_fi);
+  if ( src.mFile ) {
+    src.mFile->set_file_info(cur_fi);
+  }
+  else {
+    src.mFileInfo = cur_fi;
+  }
 }
 
-// @brief 現在のファイルを返す．
-InputFile*
-InputMgr::cur_file() const
+// @brief 現在のファイルからトークンを読み出す．
+// @param[out] buff 結果の文字列を格納するバッファ
+// @param[out] token_loc トークンの位置情報
+// @return トークン番号を返す．
+int
+InputMgr::read_token(StrBuff& buff,
+		     FileRegion& token_loc)
 {
-  return mCurFile;
+  InputSource& src = mSourceStack.back();
+  if ( src.mFile == nullptr ) {
+    return replay_token(src, buff, token_loc);
+  }
+
+  int id = src.mFile->read_token(buff, token_loc);
+  FileCache* cache = src.mCache;
+  if ( cache ) {
+    cache->mTokenList.add(token_loc, id, buff.c_str());
+    if ( id == EOF ) {
+      cache->mComplete = true;
+      cache->mGuardName = find_guard(cache->mTokenList);
+      src.mCache = nullptr;
+    }
+  }
+  return id;
 }
 
 // @brief 現在のファイル名を返す．
 string
 InputMgr::cur_filename() const
 {
-  return mCurFile->file_info().filename();
+  return file_info(mSourceStack.back()).filename();
 }
 
 // @brief 現在の InputFile が EOF を返したときの処理
@@ -171,20 +325,21 @@ bool
 InputMgr::wrap_up()
 {
   for ( ; ; ) {
-    delete_file(mCurFile);
-    if ( mFileStack.empty() ) {
+    delete_source(mSourceStack.back());
+    mSourceStack.pop_back();
+    if ( mSourceStack.empty() ) {
       // もうファイルが残っていない．
-      mCurFile = nullptr;
       return false;
     }
 
-    mCurFile = mFileStack.back();
-    mFileStack.pop_back();
-
-    int c = mCurFile->peek();
-    if ( c != EOF ) {
+    if ( !is_eof(mSourceStack.back()) ) {
       return true;
     }
+
+    // 記録中のキャッシュを完結させるために EOF を読んでおく．
+    StrBuff buff;
+    FileRegion loc;
+    read_token(buff, loc);
   }
 }
 
@@ -195,23 +350,76 @@ InputMgr::wrap_up()
 bool
 InputMgr::check_file(const char* name) const
 {
-  if ( cur_filename() == name ) {
-    return true;
-  }
-  for (vector<InputFile*>::const_iterator p = mFileStack.begin();
-       p != mFileStack.end(); ++ p) {
-    if ( (*p)->file_info().filename() == name ) {
+  for (vector<InputSource>::const_iterator p = mSourceStack.begin();
+       p != mSourceStack.end(); ++ p) {
+    if ( file_info(*p).filename() == name ) {
       return true;
     }
   }
   return false;
 }
 
-// @brief InputFile を削除する．
+// @brief キャッシュを再生しているソースからトークンを読み出す．
+// @param[in] src 対象のソース
+// @param[out] buff 結果の文字列を格納するバッファ
+// @param[out] token_loc トークンの位置情報
+// @return トークン番号を返す．
+int
+InputMgr::replay_token(InputSource& src,
+		       StrBuff& buff,
+		       FileRegion& token_loc)
+{
+  const TokenInfo* token = src.mNext;
+  const FileRegion& loc = token->loc();
+  int id = token->id();
+
+  // 位置情報は今回のインクルードのファイル情報で作り直す．
+  token_loc = FileRegion(src.mFileInfo,
+			 loc.start_line(), loc.start_column(),
+			 loc.end_line(), loc.end_column());
+  buff = token->str();
+  src.mLastLoc = token_loc;
+
+  // ファイルから読んだ時と同じく改行ごとに行番号ウォッチャーを起動する．
+  ymuint end_line = (id == NL) ? loc.start_line() + 1 : loc.end_line();
+  for ( ; src.mLine < end_line; ++ src.mLine) {
+    mLex.check_line(src.mLine);
+  }
+
+  if ( id != EOF ) {
+    src.mNext = token->next();
+  }
+  return id;
+}
+
+// @brief ソースの現在のファイル情報を返す．
+// @param[in] src 対象のソース
+FileInfo
+InputMgr::file_info(const InputSource& src) const
+{
+  if ( src.mFile ) {
+    return src.mFile->file_info();
+  }
+  return src.mFileInfo;
+}
+
+// @brief ソースが末尾に達しているか調べる．
+// @param[in] src 対象のソース
+bool
+InputMgr::is_eof(InputSource& src)
+{
+  if ( src.mFile ) {
+    return src.mFile->peek() == EOF;
+  }
+  return src.mNext->id() == EOF;
+}
+
+// @brief ソースを削除する．
+// @param[in] src 対象のソース
 void
-InputMgr::delete_file(InputFile* file)
+InputMgr::delete_source(InputSource& src)
 {
-  delete file;
+  delete src.mFile;
 }
 
 END_NAMESPACE_YM_VERILOG
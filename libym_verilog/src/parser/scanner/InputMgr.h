@@ -13,10 +13,12 @@
 
 #include "YmUtils/File.h"
 #include "YmUtils/FileRegion.h"
+#include "YmUtils/HashMap.h"
 #include "YmUtils/MsgHandler.h"
 #include "YmUtils/StrBuff.h"
 
 #include "InputFile.h"
+#include "TokenList.h"
 
 
 BEGIN_NAMESPACE_YM_VERILOG
@@ -27,6 +29,13 @@ class RawLex;
 /// @class InputMgr InputMgr.h "InputMgr.h"
 /// @ingroup VlParser
 /// @brief 入力ファイルを管理するクラス
+///
+/// インクルードされたファイルから読み出した生のトークンは
+/// ファイルごとに TokenList に記録しておき，同じファイルが再び
+/// インクルードされた時にはファイルを読まずにそれを再生する．
+/// また，ファイル全体が `ifndef NAME ... `endif で囲まれている
+/// (インクルードガードを持つ)場合には NAME が定義済みならば
+/// ファイルそのものを読み飛ばす．
 /// @sa InputFile FileInfo
 //////////////////////////////////////////////////////////////////////
 class InputMgr
@@ -69,6 +78,7 @@ public:
   /// @param[in] parent_file インクルード元のファイル情報
   /// @retval true オープンに成功した．
   /// @retval false ファイルが開けなかった
+  /// @note インクルードガードによって読み飛ばされた場合も true を返す．
   bool
   open_file(const string& filename,
 	    const FileLoc& parent_file = FileLoc());
@@ -92,9 +102,13 @@ public:
 	       ymuint line,
 	       ymuint level);
 
-  /// @brief 現在のファイルを返す．
-  InputFile*
-  cur_file() const;
+  /// @brief 現在のファイルからトークンを読み出す．
+  /// @param[out] buff 結果の文字列を格納するバッファ
+  /// @param[out] token_loc トークンの位置情報
+  /// @return トークン番号を返す．
+  int
+  read_token(StrBuff& buff,
+	     FileRegion& token_loc);
 
   /// @brief 現在のファイル名を返す．
   string
@@ -109,14 +123,85 @@ public:
   //////////////////////////////////////////////////////////////////////
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief インクルードファイルのトークンのキャッシュ
+  struct FileCache
+  {
+    /// @brief コンストラクタ
+    FileCache();
+
+    // 生のトークンのリスト
+    // 末尾は EOF となる．
+    TokenList mTokenList;
+
+    // 末尾まで記録し終わった時 true となるフラグ
+    bool mComplete;
+
+    // インクルードガードのマクロ名
+    // インクルードガードを持たない場合は空
+    string mGuardName;
+
+  };
+
+  /// @brief 読み込み中のファイルを表す構造体
+  struct InputSource
+  {
+    // 実際のファイル
+    // キャッシュを再生している時は nullptr
+    InputFile* mFile;
+
+    // トークンを記録するキャッシュ
+    // mFile が nullptr の時は再生するキャッシュ
+    FileCache* mCache;
+
+    // 次に再生するトークン
+    const TokenInfo* mNext;
+
+    // 再生時のファイル情報
+    FileInfo mFileInfo;
+
+    // 再生時の最後のトークンの位置
+    FileRegion mLastLoc;
+
+    // 再生時に行番号ウォッチャーに通知していない最初の行番号
+    ymuint mLine;
+
+  };
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる下請け関数
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief InputFile を削除する．
+  /// @brief キャッシュを再生しているソースからトークンを読み出す．
+  /// @param[in] src 対象のソース
+  /// @param[out] buff 結果の文字列を格納するバッファ
+  /// @param[out] token_loc トークンの位置情報
+  /// @return トークン番号を返す．
+  int
+  replay_token(InputSource& src,
+	       StrBuff& buff,
+	       FileRegion& token_loc);
+
+  /// @brief ソースの現在のファイル情報を返す．
+  /// @param[in] src 対象のソース
+  FileInfo
+  file_info(const InputSource& src) const;
+
+  /// @brief ソースが末尾に達しているか調べる．
+  /// @param[in] src 対象のソース
+  bool
+  is_eof(InputSource& src);
+
+  /// @brief ソースを削除する．
+  /// @param[in] src 対象のソース
   void
-  delete_file(InputFile* file);
+  delete_source(InputSource& src);
 
 
 private:
@@ -130,11 +215,13 @@ private:
   // サーチパス
   SearchPathList mSearchPathList;
 
-  // 現在のファイル情報
-  InputFile* mCurFile;
+  // 読み込み中のファイルのスタック
+  // 末尾が現在のファイルとなる．
+  vector<InputSource> mSourceStack;
 
-  // ファイル情報のスタック
-  vector<InputFile*> mFileStack;
+  // インクルードファイルのキャッシュ
+  // キーは実際のパス名
+  HashMap<string, FileCache*> mCacheDict;
 
 };
 
@@ -289,8 +289,7 @@ RawLex::get_raw_token()
 
   // 通常の読み込み
  LOOP:
-  InputFile* input_file = mInputMgr->cur_file();
-  int id = input_file->read_token(mStringBuff, mCurPos);
+  int id = mInputMgr->read_token(mStringBuff, mCurPos);
   mCurString = mStringBuff.c_str();
 
   switch ( id ) {